@@ -347,9 +347,10 @@ void QCanDump::onSocketError(QAbstractSocket::SocketError teSocketErrorV)
 //--------------------------------------------------------------------------------------------------------------------//
 void QCanDump::onSocketReceive(void)
 {
-   QCanFrame      clCanFrameT;
+   QCanFrame      aclCanFrameT[64];
    QString        clCanStringT;
    uint32_t       ulFrameCountT = 0;
+   uint32_t       ulFrameIdxT;
 
    //---------------------------------------------------------------------------------------------------
    // debug information
@@ -363,14 +364,17 @@ void QCanDump::onSocketReceive(void)
       clActivityTimerP.start(static_cast< int>(ulQuitTimeP));
    }
    
-   ulFrameCountT = clCanSocketP.framesAvailable();
-   while (ulFrameCountT)
+   //---------------------------------------------------------------------------------------------------
+   // read the available frames in blocks
+   //
+   do
    {
-      if (clCanSocketP.read(clCanFrameT) == true)
+      ulFrameCountT = clCanSocketP.readFrames(&aclCanFrameT[0], 64);
+      for (ulFrameIdxT = 0; ulFrameIdxT < ulFrameCountT; ulFrameIdxT++)
       {
-         if (clFilterListP.filter(clCanFrameT) == false)
+         if (clFilterListP.filter(aclCanFrameT[ulFrameIdxT]) == false)
          {
-            clCanStringT = clCanFrameT.toString(btTimeStampP);
+            clCanStringT = aclCanFrameT[ulFrameIdxT].toString(btTimeStampP);
             fprintf(stdout, "%s\n", qPrintable(clCanStringT));
             ulQuitCountP--;
             if (ulQuitCountP == 0)
@@ -379,8 +383,7 @@ void QCanDump::onSocketReceive(void)
             }
          }
       }
-      ulFrameCountT--;
-   }
+   } while (ulFrameCountT == 64);
 }
 
 
@@ -0,0 +1,640 @@
+//====================================================================================================================//
+// File:          qcan_server_daemon.cpp                                                                              //
+// Description:   CANpie FD Server without GUI                                                                        //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTimer>
+
+#include "qcan_server_daemon.hpp"
+
+#ifdef   Q_OS_UNIX
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------------------------------
+// Version information is controlled via cmake project file, the following defintions are only
+// placeholders
+//
+#ifndef  VERSION_MAJOR
+#define  VERSION_MAJOR                       1
+#endif
+
+#ifndef  VERSION_MINOR
+#define  VERSION_MINOR                       0
+#endif
+
+#ifndef  VERSION_BUILD
+#define  VERSION_BUILD                       0
+#endif
+
+//------------------------------------------------------------------------------------------------------
+// name of the internal virtual CAN bus, see QCanInterfaceWidget of the CANpie FD Server dialog
+//
+#define  QCAN_IF_VCAN_NAME                   "Virtual CAN bus"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Static variables                                                                                                   **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+int QCanServerDaemon::aslSignalFdS[2] = { -1, -1 };
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// main()                                                                                                             //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+int main(int argc, char *argv[])
+{
+   QCoreApplication clAppT(argc, argv);
+   QCoreApplication::setApplicationName("canpie-server");
+
+   //---------------------------------------------------------------------------------------------------
+   // get application version (defined in cmake file)
+   //
+   QString clVersionT = "version ";
+   clVersionT += QString("%1.").arg(VERSION_MAJOR);
+   clVersionT += QString("%1.").arg(VERSION_MINOR, 2, 10, QLatin1Char('0'));
+   clVersionT += QString("%1").arg(VERSION_BUILD, 2, 10, QLatin1Char('0'));
+   QCoreApplication::setApplicationVersion(clVersionT);
+
+   //---------------------------------------------------------------------------------------------------
+   // SIGINT and SIGTERM stop the server in a controlled way
+   //
+   if (QCanServerDaemon::installSignalHandler() == false)
+   {
+      QCanServerDaemon::logMessage(QCan::eLOG_LEVEL_WARN, "Warning: signal handler could not be installed");
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // create the main class
+   //
+   QCanServerDaemon clMainT;
+
+   //---------------------------------------------------------------------------------------------------
+   // connect the signals between QCoreApplication and the main class
+   //
+   QObject::connect(&clAppT,  &QCoreApplication::aboutToQuit, &clMainT, &QCanServerDaemon::aboutToQuitApp);
+
+   //---------------------------------------------------------------------------------------------------
+   // This code will start the messaging engine in QT and in 10 ms it will start the execution of the
+   // clMainT.runCommandParser() routine.
+   //
+   QTimer::singleShot(10, &clMainT, SLOT(runCommandParser()));
+
+   return (clAppT.exec());
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerDaemon()                                                                                                 //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanServerDaemon::QCanServerDaemon(QObject *parent) :
+                  QObject(parent)
+{
+   //---------------------------------------------------------------------------------------------------
+   // get the instance of the main application
+   //
+   pclApplicationP = QCoreApplication::instance();
+
+   pclCanServerP   = nullptr;
+   pclLoggerP      = nullptr;
+
+   //---------------------------------------------------------------------------------------------------
+   // the notifier is only created if the signal handler has been installed
+   //
+   if (aslSignalFdS[1] >= 0)
+   {
+      pclSignalNotifierP = new QSocketNotifier(aslSignalFdS[1], QSocketNotifier::Read, this);
+      connect(pclSignalNotifierP, &QSocketNotifier::activated, this, &QCanServerDaemon::onSignalReceived);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerDaemon::aboutToQuitApp()                                                                                 //
+// shortly after quit is called the CoreApplication will signal this routine: delete objects / clean up               //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServerDaemon::aboutToQuitApp()
+{
+   //---------------------------------------------------------------------------------------------------
+   // the logger writes all pending messages before the networks are removed
+   //
+   if (pclLoggerP != nullptr)
+   {
+      delete (pclLoggerP);
+      pclLoggerP = nullptr;
+   }
+
+   if (pclCanServerP != nullptr)
+   {
+      delete (pclCanServerP);
+      pclCanServerP = nullptr;
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerDaemon::configureNetworks()                                                                              //
+// the keys are the same as used by the CANpie FD Server dialog                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServerDaemon::configureNetworks(QSettings & clSettingsR)
+{
+   QCanNetwork *  pclNetworkT;
+   QString        clInterfaceT;
+
+   for (uint8_t ubNetworkIdxT = 0; ubNetworkIdxT < pclCanServerP->maximumNetwork(); ubNetworkIdxT++)
+   {
+      pclNetworkT = pclCanServerP->network(ubNetworkIdxT);
+      clSettingsR.beginGroup("CAN_" + QString("%1").arg(ubNetworkIdxT + 1));
+
+      pclLoggerP->setLogLevel(static_cast< QCan::CAN_Channel_e >(ubNetworkIdxT + 1),
+                              static_cast< QCan::LogLevel_e > (clSettingsR.value("loglevel",
+                                                                                 QCan::eLOG_LEVEL_INFO).toInt()));
+
+      pclNetworkT->setSocketLimit(        clSettingsR.value("socketLimit"         , 0).toUInt());
+      pclNetworkT->setNetworkEnabled(     clSettingsR.value("enabled"             , 1).toBool());
+      pclNetworkT->setErrorFrameEnabled(  clSettingsR.value("errorFrameEnabled"   , 0).toBool());
+      pclNetworkT->setFlexibleDataEnabled(clSettingsR.value("flexibleDataEnabled" , 0).toBool());
+      pclNetworkT->setListenOnlyEnabled(  clSettingsR.value("listenOnlyEnabled"   , 0).toBool());
+      pclNetworkT->setBitrate(            clSettingsR.value("bitrateNominal"      , 500000).toInt(),
+                                          clSettingsR.value("bitrateData"         , QCan::eCAN_BITRATE_NONE).toInt());
+
+      pclNetworkT->setMulticast(QHostAddress(clSettingsR.value("multicastGroup", "").toString()),
+                                static_cast< uint16_t >(clSettingsR.value("multicastPort",
+                                                                          QCAN_MULTICAST_DEFAULT_PORT).toUInt()),
+                                clSettingsR.value("multicastInterface", "").toString());
+
+      clInterfaceT = clSettingsR.value("interfaceName", "").toString();
+      clSettingsR.endGroup();
+
+      //-------------------------------------------------------------------------------------------
+      // the plug-ins are only loaded if a physical CAN interface is configured
+      //
+      if ((clInterfaceT.isEmpty() == false) && (clInterfaceT != QString(QCAN_IF_VCAN_NAME)))
+      {
+         if (setInterface(pclNetworkT, clInterfaceT) == false)
+         {
+            logMessage(QCan::eLOG_LEVEL_WARN, QString("CAN %1: interface '%2' not found, use %3")
+                                              .arg(ubNetworkIdxT + 1).arg(clInterfaceT, QCAN_IF_VCAN_NAME));
+         }
+      }
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerDaemon::configureServer()                                                                                //
+// the keys are the same as used by the CANpie FD Server dialog                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServerDaemon::configureServer(QSettings & clSettingsR)
+{
+   clSettingsR.beginGroup("Server");
+
+   pclCanServerP->setServerAddress(QHostAddress(clSettingsR.value("hostAddress", "127.0.0.1").toString()));
+
+   pclCanServerP->allowBitrateChange(  clSettingsR.value("allowBitrateChange"  , 0).toBool());
+   pclCanServerP->allowBusOffRecovery( clSettingsR.value("allowBusOffRecovery" , 0).toBool());
+   pclCanServerP->allowModeChange(     clSettingsR.value("allowModeChange"     , 0).toBool());
+
+   pclCanServerP->setMetricsPort(static_cast< uint16_t >(clSettingsR.value("metricsPort", 0).toUInt()));
+
+   pclCanServerP->setTcpNoDelay(clSettingsR.value("tcpNoDelay", 1).toBool());
+   pclCanServerP->setTcpPort(static_cast< uint16_t >(clSettingsR.value("tcpPort", 0).toUInt()));
+
+   pclLoggerP->setRotation(clSettingsR.value("logRotateSize"     , 0).toUInt(),
+                           clSettingsR.value("logRotateInterval" , 0).toUInt(),
+                           static_cast< uint8_t >(clSettingsR.value("logRotateBackup", 0).toUInt()));
+
+   clSettingsR.endGroup();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerDaemon::installSignalHandler()                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanServerDaemon::installSignalHandler(void)
+{
+   bool  btResultT = false;
+
+   #ifdef Q_OS_UNIX
+   struct sigaction  tsActionT;
+
+   if (::socketpair(AF_UNIX, SOCK_STREAM, 0, aslSignalFdS) == 0)
+   {
+      tsActionT.sa_handler = QCanServerDaemon::onUnixSignal;
+      sigemptyset(&tsActionT.sa_mask);
+      tsActionT.sa_flags = SA_RESTART;
+
+      if ((sigaction(SIGINT, &tsActionT, nullptr) == 0) && (sigaction(SIGTERM, &tsActionT, nullptr) == 0))
+      {
+         btResultT = true;
+      }
+   }
+   #endif
+
+   return (btResultT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerDaemon::logMessage()                                                                                     //
+// all messages of the daemon are passed to the Qt message handler                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServerDaemon::logMessage(const QCan::LogLevel_e teLogLevelV, const QString & clMessageR)
+{
+   switch (teLogLevelV)
+   {
+      case QCan::eLOG_LEVEL_FATAL:
+      case QCan::eLOG_LEVEL_ERROR:
+         qCritical().noquote() << clMessageR;
+         break;
+
+      case QCan::eLOG_LEVEL_WARN:
+         qWarning().noquote() << clMessageR;
+         break;
+
+      default:
+         qInfo().noquote() << clMessageR;
+         break;
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerDaemon::onSignalReceived()                                                                               //
+// a signal has been received by onUnixSignal()                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServerDaemon::onSignalReceived(void)
+{
+   #ifdef Q_OS_UNIX
+   char  szSignalT;
+
+   pclSignalNotifierP->setEnabled(false);
+   if (::read(aslSignalFdS[1], &szSignalT, sizeof(szSignalT)) > 0)
+   {
+      logMessage(QCan::eLOG_LEVEL_INFO, "Stop CANpie FD Server");
+      quit(0);
+   }
+   pclSignalNotifierP->setEnabled(true);
+   #endif
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerDaemon::onUnixSignal()                                                                                   //
+// signal handler: only async-signal-safe functions are allowed here                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServerDaemon::onUnixSignal(int slSignalV)
+{
+   #ifdef Q_OS_UNIX
+   char  szSignalT = static_cast< char >(slSignalV);
+
+   if (::write(aslSignalFdS[0], &szSignalT, sizeof(szSignalT)) < 0)
+   {
+      return;
+   }
+   #else
+   Q_UNUSED(slSignalV);
+   #endif
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerDaemon::quit()                                                                                           //
+// call this routine to quit the application                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServerDaemon::quit(const int32_t slExitCodeV)
+{
+   if (pclApplicationP.isNull() == false)
+   {
+      pclApplicationP->exit(slExitCodeV);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerDaemon::runCommandParser()                                                                               //
+// 10ms after the application starts this method will parse all commands                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServerDaemon::runCommandParser()
+{
+   //---------------------------------------------------------------------------------------------------
+   // setup command line parser, options are added in alphabetical order
+   //
+   clCommandParserP.setApplicationDescription(tr("CANpie FD Server without GUI"));
+
+   //---------------------------------------------------------------------------------------------------
+   // command line option: -c, --clean
+   //
+   QCommandLineOption clOptCleanT(QStringList() << "c" << "clean",
+         tr("Start in clean mode"));
+   clCommandParserP.addOption(clOptCleanT);
+
+   //---------------------------------------------------------------------------------------------------
+   // command line option: -f, --config <file>
+   //
+   QCommandLineOption clOptConfigT(QStringList() << "f" << "config",
+         tr("Read the settings from <file>"),
+         tr("file"));
+   clCommandParserP.addOption(clOptConfigT);
+
+   //---------------------------------------------------------------------------------------------------
+   // command line option: --cpus <list>
+   //
+   QCommandLineOption clOptCpusT("cpus",
+         tr("Run the dispatch thread on the CPUs <list>, e.g. 2,3"),
+         tr("list"));
+   clCommandParserP.addOption(clOptCpusT);
+
+   //---------------------------------------------------------------------------------------------------
+   // command line option: -h, --help
+   //
+   clCommandParserP.addHelpOption();
+
+   //---------------------------------------------------------------------------------------------------
+   // command line option: -H, --host <host>
+   //
+   QCommandLineOption clOptHostT(QStringList() << "H" << "host",
+         tr("Accept connections on address <host>"),
+         tr("host"));
+   clCommandParserP.addOption(clOptHostT);
+
+   //---------------------------------------------------------------------------------------------------
+   // command line option: --metrics-port <port>
+   //
+   QCommandLineOption clOptMetricsPortT("metrics-port",
+         tr("Serve the OpenMetrics endpoint on <port>, 0 disables the endpoint"),
+         tr("port"));
+   clCommandParserP.addOption(clOptMetricsPortT);
+
+   //---------------------------------------------------------------------------------------------------
+   // command line option: -n, --networks <count>
+   //
+   QCommandLineOption clOptNetworksT(QStringList() << "n" << "networks",
+         tr("Number of CAN networks"),
+         tr("count"));
+   clCommandParserP.addOption(clOptNetworksT);
+
+   //---------------------------------------------------------------------------------------------------
+   // command line option: -p, --plugins <directory>
+   //
+   QCommandLineOption clOptPluginsT(QStringList() << "p" << "plugins",
+         tr("Load CAN interface plug-ins from <directory>"),
+         tr("directory"));
+   clCommandParserP.addOption(clOptPluginsT);
+
+   //---------------------------------------------------------------------------------------------------
+   // command line option: --policy <policy>
+   //
+   QCommandLineOption clOptPolicyT("policy",
+         tr("Scheduling policy of the dispatch thread: other, fifo or rr"),
+         tr("policy"));
+   clCommandParserP.addOption(clOptPolicyT);
+
+   //---------------------------------------------------------------------------------------------------
+   // command line option: --priority <value>
+   //
+   QCommandLineOption clOptPriorityT("priority",
+         tr("Priority of the real-time scheduling policy"),
+         tr("value"));
+   clCommandParserP.addOption(clOptPriorityT);
+
+   //---------------------------------------------------------------------------------------------------
+   // command line option: --tcp-port <port>
+   //
+   QCommandLineOption clOptTcpPortT("tcp-port",
+         tr("Accept raw TCP connections on <port>, 0 disables the TCP server"),
+         tr("port"));
+   clCommandParserP.addOption(clOptTcpPortT);
+
+   //---------------------------------------------------------------------------------------------------
+   // command line option: -v, --version
+   //
+   clCommandParserP.addVersionOption();
+
+   //---------------------------------------------------------------------------------------------------
+   // Process the actual command line arguments given by the user
+   //
+   clCommandParserP.process(*pclApplicationP);
+
+   //---------------------------------------------------------------------------------------------------
+   // select the settings: the file given by --config or the settings of the CANpie FD Server dialog
+   //
+   QSettings * pclSettingsT;
+   if (clCommandParserP.isSet(clOptConfigT))
+   {
+      QString clFileT = clCommandParserP.value(clOptConfigT);
+      if (QFileInfo::exists(clFileT) == false)
+      {
+         logMessage(QCan::eLOG_LEVEL_ERROR, tr("Error: Configuration file not found:") + " " + clFileT);
+         quit(1);
+         return;
+      }
+      pclSettingsT = new QSettings(clFileT, QSettings::IniFormat, this);
+   }
+   else
+   {
+      pclSettingsT = new QSettings(QSettings::IniFormat, QSettings::UserScope,
+                                   "microcontrol.net", "CANpieServer", this);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // number of networks
+   //
+   uint32_t ulNetworkNumT = pclSettingsT->value("Server/networkCount", QCAN_NETWORK_MAX).toUInt();
+   if (clCommandParserP.isSet(clOptNetworksT))
+   {
+      ulNetworkNumT = clCommandParserP.value(clOptNetworksT).toUInt();
+   }
+
+   if ((ulNetworkNumT == 0) || (ulNetworkNumT > QCAN_NETWORK_LIMIT))
+   {
+      logMessage(QCan::eLOG_LEVEL_ERROR, tr("Error: Number of CAN networks out of range") +
+                                         QString(" 1 .. %1").arg(QCAN_NETWORK_LIMIT));
+      quit(1);
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // plug-in directory: default is the directory "plugins" next to the binary
+   //
+   if (clCommandParserP.isSet(clOptPluginsT))
+   {
+      QCanPluginRegistry::instance().setPluginPath(QDir(clCommandParserP.value(clOptPluginsT)));
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // create the server, only one server can run on a machine
+   //
+   pclCanServerP = new QCanServer(nullptr, QCAN_WEB_SOCKET_DEFAULT_PORT, static_cast< uint8_t >(ulNetworkNumT),
+                                  clCommandParserP.isSet(clOptCleanT));
+   if (pclCanServerP->state() == QCanServer::eERROR_ACTIVE)
+   {
+      logMessage(QCan::eLOG_LEVEL_ERROR, tr("Error: CANpie FD Server is already running"));
+      delete (pclCanServerP);
+      pclCanServerP = nullptr;
+      quit(1);
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // logging must be attached before the networks are configured
+   //
+   pclLoggerP = new QCanServerLogger(pclCanServerP);
+
+   configureServer(*pclSettingsT);
+
+   //---------------------------------------------------------------------------------------------------
+   // the command line options override the settings
+   //
+   if (clCommandParserP.isSet(clOptHostT))
+   {
+      QHostAddress clHostAddressT(clCommandParserP.value(clOptHostT));
+      if (clHostAddressT.isNull())
+      {
+         logMessage(QCan::eLOG_LEVEL_ERROR, tr("Error: No valid host address"));
+         quit(1);
+         return;
+      }
+      pclCanServerP->setServerAddress(clHostAddressT);
+   }
+
+   if (clCommandParserP.isSet(clOptMetricsPortT))
+   {
+      pclCanServerP->setMetricsPort(static_cast< uint16_t >(clCommandParserP.value(clOptMetricsPortT).toUInt()));
+   }
+
+   if (clCommandParserP.isSet(clOptTcpPortT))
+   {
+      pclCanServerP->setTcpPort(static_cast< uint16_t >(clCommandParserP.value(clOptTcpPortT).toUInt()));
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // CPU affinity and scheduling policy of the dispatch thread
+   //
+   QString clCpusT     = pclSettingsT->value("Server/dispatchCpus", "").toString();
+   QString clPolicyT   = pclSettingsT->value("Server/dispatchPolicy", "").toString();
+   int32_t slPriorityT = pclSettingsT->value("Server/dispatchPriority", 1).toInt();
+
+   if (clCommandParserP.isSet(clOptCpusT))
+   {
+      clCpusT = clCommandParserP.value(clOptCpusT);
+   }
+
+   if (clCommandParserP.isSet(clOptPolicyT))
+   {
+      clPolicyT = clCommandParserP.value(clOptPolicyT);
+   }
+
+   if (clCommandParserP.isSet(clOptPriorityT))
+   {
+      slPriorityT = clCommandParserP.value(clOptPriorityT).toInt();
+   }
+
+   QCanThreadScheduling             clSchedulingT;
+   QList<int32_t>                   aslCpuListT;
+   QCanThreadScheduling::Policy_e   tePolicyT;
+
+   if ((QCanThreadScheduling::parseCpuList(clCpusT, aslCpuListT) == false) ||
+       (QCanThreadScheduling::parsePolicy(clPolicyT, tePolicyT) == false))
+   {
+      logMessage(QCan::eLOG_LEVEL_ERROR, tr("Error: No valid CPU list or scheduling policy"));
+      quit(1);
+      return;
+   }
+
+   clSchedulingT.setCpuList(aslCpuListT);
+   clSchedulingT.setPolicy(tePolicyT, slPriorityT);
+   if (clSchedulingT.isDefault() == false)
+   {
+      if (pclCanServerP->setDispatchScheduling(clSchedulingT) == false)
+      {
+         logMessage(QCan::eLOG_LEVEL_WARN, tr("Warning: Scheduling of the dispatch thread not fully applied"));
+      }
+      logMessage(QCan::eLOG_LEVEL_INFO, "Dispatch thread: " + pclCanServerP->dispatchScheduling().report());
+   }
+
+   configureNetworks(*pclSettingsT);
+   delete (pclSettingsT);
+
+   logMessage(QCan::eLOG_LEVEL_INFO, QString("CANpie FD Server %1: %2 CAN networks")
+                                     .arg(QCoreApplication::applicationVersion())
+                                     .arg(pclCanServerP->maximumNetwork()));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerDaemon::setInterface()                                                                                   //
+// connect physical CAN interface to network                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanServerDaemon::setInterface(QCanNetwork * pclNetworkV, const QString & clNameR)
+{
+   //---------------------------------------------------------------------------------------------------
+   // only the plug-in which provides the interface is instantiated
+   //
+   QCanInterface * pclInterfaceT = QCanPluginRegistry::instance().findInterface(clNameR);
+   if (pclInterfaceT == nullptr)
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the interface is started only if the network is enabled
+   //
+   if (pclNetworkV->addInterface(pclInterfaceT) == false)
+   {
+      return (false);
+   }
+
+   if (pclNetworkV->isNetworkEnabled())
+   {
+      pclNetworkV->startInterface();
+   }
+
+   return (true);
+}
@@ -0,0 +1,149 @@
+//====================================================================================================================//
+// File:          qcan_server_daemon.hpp                                                                              //
+// Description:   CANpie FD Server without GUI                                                                        //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDir>
+#include <QtCore/QPointer>
+#include <QtCore/QSettings>
+#include <QtCore/QSocketNotifier>
+
+#include "qcan_namespace.hpp"
+
+#include <QCanPluginRegistry>
+#include <QCanServer>
+#include <QCanServerLogger>
+
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \anchor canpie-server
+** \class QCanServerDaemon
+** \brief Command line tool - CANpie FD Server without GUI
+**
+** The QCanServerDaemon class runs a QCanServer on a QCoreApplication, it does not depend on the Qt GUI
+** libraries. The server is configured by the INI file of the CANpie FD Server dialog (or by the file
+** given with the option \c --config), the command line options override the settings of the file.
+** The settings are only read, the file is never written.
+** <p>
+** The group \c [Server] holds the server settings (\c networkCount, \c hostAddress, \c tcpPort,
+** \c metricsPort, \c dispatchCpus, \c dispatchPolicy, \c dispatchPriority, ...), the groups
+** \c [CAN_1] to \c [CAN_n] hold the settings of each network. A physical CAN interface is selected
+** by the key \c interfaceName, the interface is searched in the plug-ins of the plug-in directory.
+** <p>
+** The daemon terminates on SIGINT and SIGTERM, so it can be run as a service.
+*/
+class QCanServerDaemon : public QObject
+{
+   Q_OBJECT
+
+public:
+   QCanServerDaemon(QObject *parent = nullptr);
+
+   QCanServerDaemon(const QCanServerDaemon&) = delete;               // no copy constructor
+   QCanServerDaemon& operator=(const QCanServerDaemon&) = delete;    // no assignment operator
+   QCanServerDaemon(QCanServerDaemon&&) = delete;                    // no move constructor
+   QCanServerDaemon& operator=(QCanServerDaemon&&) = delete;         // no move operator
+
+   //----------------------------------------------------------------------------------------------
+   /*!
+   ** The function installs the handler for SIGINT and SIGTERM, it must be called before the
+   ** event loop is started.
+   */
+   static bool installSignalHandler(void);
+
+   //----------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  teLogLevelV     - Log level
+   ** \param[in]  clMessageR      - Log message
+   **
+   ** The function writes a message of the daemon. Errors and warnings are passed to qCritical()
+   ** and qWarning(), all other messages to qInfo(). So the output of the daemon can be formatted by
+   ** \c QT_MESSAGE_PATTERN or redirected by a message handler of the application.
+   */
+   static void logMessage(const QCan::LogLevel_e teLogLevelV, const QString & clMessageR);
+
+public slots:
+   void  aboutToQuitApp(void);
+
+private slots:
+
+   //----------------------------------------------------------------------------------------------
+   /*!
+   ** The function evaluates the command parameters and starts the server.
+   */
+   void  runCommandParser(void);
+
+   void  onSignalReceived(void);
+
+private:
+
+   //----------------------------------------------------------------------------------------------
+   // configure the server and the networks from the settings
+   //
+   void  configureNetworks(QSettings & clSettingsR);
+   void  configureServer(QSettings & clSettingsR);
+
+   //----------------------------------------------------------------------------------------------
+   // connect the CAN interface with the name clNameR to the network pclNetworkV
+   //
+   bool  setInterface(QCanNetwork * pclNetworkV, const QString & clNameR);
+
+   void  quit(const int32_t slExitCodeV);
+
+   static void    onUnixSignal(int slSignalV);
+
+   QPointer<QCoreApplication>    pclApplicationP;
+
+   //----------------------------------------------------------------------------------------------
+   // Command line parser
+   //
+   QCommandLineParser            clCommandParserP;
+
+   //----------------------------------------------------------------------------------------------
+   // CAN server and logging
+   //
+   QCanServer *                  pclCanServerP;
+   QCanServerLogger *            pclLoggerP;
+
+   //----------------------------------------------------------------------------------------------
+   // the signal handler writes the signal number to a socket pair, the notifier quits the
+   // application from the event loop
+   //
+   static int                    aslSignalFdS[2];
+   QPointer<QSocketNotifier>     pclSignalNotifierP;
+};
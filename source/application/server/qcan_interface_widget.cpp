@@ -37,7 +37,6 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
-#include <QtCore/QPluginLoader>
 #include <QtCore/QPoint>
 
 #include <QtGui/QPainter>
@@ -46,6 +45,8 @@
 
 #include <QtWidgets/QMessageBox>
 
+#include <QCanPluginRegistry>
+
 
 /*--------------------------------------------------------------------------------------------------------------------*\
 ** Class methods                                                                                                      **
@@ -64,32 +65,16 @@ QCanInterfaceWidget::QCanInterfaceWidget(uint8_t ubIdxV)
    pclQCanInterfaceP = nullptr;
 
    //---------------------------------------------------------------------------------------------------
-   // check there are any plugins available
+   // debug information
    //
-   QDir clPluginsDirT(qApp->applicationDirPath());
-   #if defined(Q_OS_WIN)
-   clPluginsDirT.setPath(clPluginsDirT.path() + "/plugins");
-   #elif defined(Q_OS_LINUX)
-   clPluginsDirT.setPath(clPluginsDirT.path() + "/plugins");
-   #elif defined(Q_OS_MAC)
-   if(clPluginsDirT.dirName() == "MacOS")
-   {
-      clPluginsDirT.cdUp();
-      clPluginsDirT.setPath(clPluginsDirT.path() + "/Plugins");
-   }
-   #else
-   #error OS is not supported
+   #ifndef QT_NO_DEBUG_OUTPUT
+   qDebug() << QString("QCanInterfaceWidget::QCanInterfaceWidget("+QString::number(ubIdxV) +","+
+                       QCanPluginRegistry::instance().pluginPath().absolutePath()+")");
    #endif
-   clPluginPathP = clPluginsDirT;
 
    //---------------------------------------------------------------------------------------------------
-   // debug information
+   // the plug-ins are loaded by QCanPluginRegistry on demand, see setInterface()
    //
-   #ifndef QT_NO_DEBUG_OUTPUT
-   qDebug() << QString("QCanInterfaceWidget::QCanInterfaceWidget("+QString::number(ubIdxV) +","+ clPluginPathP.absolutePath()+")");
-   #endif
-   
-   loadPlugin();
 }
 
 
@@ -103,11 +88,22 @@ void QCanInterfaceWidget::mousePressEvent(QMouseEvent * pclEventV)
    QPoint         clPosT(this->mapFromParent(QCursor::pos()));
    QMenu          clContextMenuT(tr("CAN interface selection"), this);
    QMenu *        pclPluginMenuT;
-   QCanInterface *pclInterfaceT;
+   QAction *      pclRefreshT;
+   int32_t        slPluginT;
 
-   if (!loadPlugin())
+   //---------------------------------------------------------------------------------------------------
+   // the menu is built from the names in the cache of the registry, only a plug-in which is not part
+   // of the cache is instantiated here
+   //
+   QCanPluginRegistry & clRegistryT = QCanPluginRegistry::instance();
+   if (clRegistryT.isCacheComplete() == false)
    {
-      qCritical() << "QCanInterfaceWidget::QCanInterfaceWidget() ERROR: Could not load any plugins!";
+      clRegistryT.refresh();
+   }
+
+   if (clRegistryT.pluginCount() == 0)
+   {
+      qWarning() << "QCanInterfaceWidget::mousePressEvent() WARNING: No plugins have been found!";
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -118,27 +114,30 @@ void QCanInterfaceWidget::mousePressEvent(QMouseEvent * pclEventV)
    clContextMenuT.addAction(pclActionT);
 
    //---------------------------------------------------------------------------------------------------
-   // create menus for each plugin with corresponding interfaces
+   // create menus for each plugin with corresponding interfaces, the interface is instantiated by
+   // setInterface() after the selection
    //
-   foreach (QCanPlugin *pclPluginT, apclQCanPluginP)
+   for (slPluginT = 0; slPluginT < clRegistryT.pluginCount(); slPluginT++)
    {
-      pclPluginMenuT = clContextMenuT.addMenu(pclPluginT->name());
-      pclPluginMenuT->setIcon(pclPluginT->icon());
-
-      for (uint8_t ubIfCntT = 0; ubIfCntT < pclPluginT->interfaceCount(); ubIfCntT++)
+      if (clRegistryT.pluginName(slPluginT).isEmpty())
       {
-         pclInterfaceT = pclPluginT->getInterface(ubIfCntT);
+         continue;
+      }
 
-         //-----------------------------------------------------------------------------------
-         // at this point interface could be used by an other client
-         // don't put it in to the list as available
-         //
-         pclActionT = new QAction(pclInterfaceT->name(), this);
-         pclActionT->setIcon(QIcon(pclInterfaceT->icon()));
+      pclPluginMenuT = clContextMenuT.addMenu(clRegistryT.pluginName(slPluginT));
+      foreach (QString clInterfaceT, clRegistryT.interfaceNames(slPluginT))
+      {
+         pclActionT = new QAction(clInterfaceT, this);
          pclPluginMenuT->addAction(pclActionT);
       }
    }
 
+   //---------------------------------------------------------------------------------------------------
+   // the plug-in directory is only scanned again on request
+   //
+   clContextMenuT.addSeparator();
+   pclRefreshT = clContextMenuT.addAction(tr("Refresh plug-ins"));
+
    //---------------------------------------------------------------------------------------------------
    // evaluate click operation
    //
@@ -155,7 +154,11 @@ void QCanInterfaceWidget::mousePressEvent(QMouseEvent * pclEventV)
          //-----------------------------------------------------------------------------------
          // evaluate selection
          //
-         if (pclActionT != nullptr)
+         if (pclActionT == pclRefreshT)
+         {
+            clRegistryT.refresh();
+         }
+         else if (pclActionT != nullptr)
          {
             //---------------------------------------------------------------------------
             // debug information
@@ -176,79 +179,6 @@ void QCanInterfaceWidget::mousePressEvent(QMouseEvent * pclEventV)
 }
 
 
-//--------------------------------------------------------------------------------------------------------------------//
-// QCanInterfaceWidget::loadPlugin()                                                                                  //
-//                                                                                                                    //
-//--------------------------------------------------------------------------------------------------------------------//
-bool QCanInterfaceWidget::loadPlugin()
-{
-   QCanPlugin    *pclQCanPluginT;
-
-   //---------------------------------------------------------------------------------------------------
-   // reset list of plug-ins
-   //
-   apclQCanPluginP.clear();
-
-   //---------------------------------------------------------------------------------------------------
-   // check plug-in path
-   //
-   if (!clPluginPathP.exists())
-   {
-      #ifndef QT_NO_DEBUG_OUTPUT
-      qDebug() << "QCanInterfaceWidget::loadPlugin() WARNING: plugin path does not exist!";
-      #endif
-      return false;
-   }
-
-   //---------------------------------------------------------------------------------------------------
-   // create a list of plug-ins
-   //
-   foreach (QString clFileNameT, clPluginPathP.entryList(QDir::Files))
-   {
-      if (QLibrary::isLibrary(clPluginPathP.absoluteFilePath(clFileNameT)))
-      {
-         QPluginLoader clPluginLoaderT(clPluginPathP.absoluteFilePath(clFileNameT));
-         QObject *pclPluginT = clPluginLoaderT.instance();
-         if (pclPluginT)
-         {
-            pclQCanPluginT = qobject_cast<QCanPlugin *>(pclPluginT);
-            if (pclQCanPluginT)
-            {
-               qInfo() << "QCanInterfaceWidget::loadPlugin() INFO: found" << clPluginPathP.absoluteFilePath(clFileNameT) << "plugin, which contains" << QString::number(pclQCanPluginT->interfaceCount()) << " interfaces.";
-
-               apclQCanPluginP.append(pclQCanPluginT);
-            }
-         }
-         else
-         {
-            #ifndef QT_NO_DEBUG_OUTPUT
-            qDebug() << "QCanInterfaceWidget::loadPlugin() WARNING: plugin" << clPluginPathP.absoluteFilePath(clFileNameT) << "could NOT be loaded or the root component object could NOT be instantiated!";
-            #endif
-         }
-      }
-      else
-      {
-         #ifndef QT_NO_DEBUG_OUTPUT
-         qDebug() << "QCanInterfaceWidget::loadPlugin() WARNING: plugin" << clPluginPathP.absoluteFilePath(clFileNameT) << "is NOT a library!";
-         #endif
-      }
-   }
-
-   //---------------------------------------------------------------------------------------------------
-   // check list of plugins
-   //
-   if (apclQCanPluginP.isEmpty())
-   {
-      qWarning() << "QCanInterfaceWidget::loadPlugin() WARNING: No plugins have been found!";
-      return false;
-   }
-
-   qInfo() << "QCanInterfaceWidget::loadPlugin() INFO: found" << QString::number(apclQCanPluginP.length(),10) << "available plugins.";
-
-   return true;
-}
-
-
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanInterfaceWidget::paintEvent()                                                                                  //
 //                                                                                                                    //
@@ -334,7 +264,6 @@ void QCanInterfaceWidget::setIcon(QIcon clIconR, QIcon::Mode teModeV)
 bool QCanInterfaceWidget::setInterface(QString clNameV)
 {
    QString clInterfaceNameT;
-   QCanInterface *pclInterfaceT;
 
 
    pclQCanInterfaceP = nullptr;
@@ -351,36 +280,14 @@ bool QCanInterfaceWidget::setInterface(QString clNameV)
       emit addLogMessage(QCan::CAN_Channel_e (QCan::eCAN_CHANNEL_1 + ubInterfaceIdxP),
                          "Search CAN interface ... : " + clNameV, QCan::eLOG_LEVEL_DEBUG);
 
-      foreach (QCanPlugin * pclPluginT, apclQCanPluginP)
+      pclQCanInterfaceP = QCanPluginRegistry::instance().findInterface(clNameV);
+      if (pclQCanInterfaceP != nullptr)
       {
-         //-----------------------------------------------------------------------------------
-         // if an interface has been found quit here
-         //
-         if (pclQCanInterfaceP != nullptr)
-         {
-            break;
-         }
-
-         //-----------------------------------------------------------------------------------
-         // check all interfaces of selected plug-in
-         //
-         for (uint8_t ubIfCntT = 0; ubIfCntT < pclPluginT->interfaceCount(); ubIfCntT++)
-         {
-            pclInterfaceT = pclPluginT->getInterface(ubIfCntT);
-            clInterfaceNameT = pclInterfaceT->name();
-            emit addLogMessage(QCan::CAN_Channel_e (QCan::eCAN_CHANNEL_1 + ubInterfaceIdxP),
-                               "Found CAN interface .... : " + clInterfaceNameT, QCan::eLOG_LEVEL_DEBUG);
-            if (clNameV == clInterfaceNameT)
-            {
-               emit addLogMessage(QCan::CAN_Channel_e (QCan::eCAN_CHANNEL_1 + ubInterfaceIdxP),
-                                  "Connect CAN interface .. : " + clInterfaceNameT);
-               pclQCanInterfaceP = pclInterfaceT;
-               break;
-            }
-         }
+         clInterfaceNameT = pclQCanInterfaceP->name();
+         emit addLogMessage(QCan::CAN_Channel_e (QCan::eCAN_CHANNEL_1 + ubInterfaceIdxP),
+                            "Connect CAN interface .. : " + clInterfaceNameT);
       }
-
-      if (pclQCanInterfaceP == nullptr)
+      else
       {
          emit addLogMessage(QCan::CAN_Channel_e (QCan::eCAN_CHANNEL_1 + ubInterfaceIdxP),
                             "Search CAN interface ... : Not found");
@@ -97,7 +97,6 @@ private:
 
    uint8_t  ubInterfaceIdxP;
    QIcon    clIconP;
-   QDir     clPluginPathP;
 
    /*!
     * \brief qCanInterfaceP
@@ -106,13 +105,9 @@ private:
     */
    QCanInterface *pclQCanInterfaceP;
 
-
-   QList<QCanPlugin *> apclQCanPluginP;
-
 protected:
    void mousePressEvent(QMouseEvent *event) override;
    void paintEvent(QPaintEvent *event) override;
-   bool loadPlugin(void);
 
 private slots:
 
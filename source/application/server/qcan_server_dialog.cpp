@@ -127,19 +127,20 @@ QCanServerDialog::QCanServerDialog(QWidget * parent)
    //
    pclTbxNetworkP = new QToolBox(ui.pclTabConfigNetworkM);
    pclTbxNetworkP->setGeometry(QRect(0, 0, 101, 361));
-   for(ubNetworkIdxT = 0; ubNetworkIdxT < QCAN_NETWORK_MAX; ubNetworkIdxT++)
+   clCanIfWidgetListP.resize(pclCanServerP->maximumNetwork());
+   for(ubNetworkIdxT = 0; ubNetworkIdxT < pclCanServerP->maximumNetwork(); ubNetworkIdxT++)
    {
-      apclCanIfWidgetP[ubNetworkIdxT]  = new QCanInterfaceWidget(ubNetworkIdxT);
-      apclCanIfWidgetP[ubNetworkIdxT]->setGeometry(QRect(0, 0, 101, 145));
-      apclCanIfWidgetP[ubNetworkIdxT]->setToolTip("Click to change CAN interface");
-      pclTbxNetworkP->addItem(apclCanIfWidgetP[ubNetworkIdxT], 
+      clCanIfWidgetListP[ubNetworkIdxT]  = new QCanInterfaceWidget(ubNetworkIdxT);
+      clCanIfWidgetListP[ubNetworkIdxT]->setGeometry(QRect(0, 0, 101, 145));
+      clCanIfWidgetListP[ubNetworkIdxT]->setToolTip("Click to change CAN interface");
+      pclTbxNetworkP->addItem(clCanIfWidgetListP[ubNetworkIdxT], 
                               ("CAN " + QString::number(ubNetworkIdxT+1,10)));
 
       pclTbxNetworkP->setItemToolTip(ubNetworkIdxT,(QString(tr("Click to select CAN ")) +
                                                    QString::number(ubNetworkIdxT + 1,10)) +
                                                    QString(tr(" network settings")));
 
-      connect( apclCanIfWidgetP[ubNetworkIdxT],
+      connect( clCanIfWidgetListP[ubNetworkIdxT],
                &QCanInterfaceWidget::interfaceChanged,
                this,
                &QCanServerDialog::onInterfaceChange);
@@ -189,6 +190,60 @@ QCanServerDialog::QCanServerDialog(QWidget * parent)
    pclCanServerP->allowBusOffRecovery( pclSettingsP->value("allowBusOffRecovery" , 0).toBool());
    pclCanServerP->allowModeChange(     pclSettingsP->value("allowModeChange"     , 0).toBool());
 
+   pclCanServerP->setMetricsPort(static_cast< uint16_t >(pclSettingsP->value("metricsPort", 0).toUInt()));
+
+   pclCanServerP->setTcpNoDelay(pclSettingsP->value("tcpNoDelay", 1).toBool());
+   pclCanServerP->setTcpPort(static_cast< uint16_t >(pclSettingsP->value("tcpPort", 0).toUInt()));
+
+   pclLoggerP->setRotation(pclSettingsP->value("logRotateSize"     , 0).toUInt(),
+                           pclSettingsP->value("logRotateInterval" , 0).toUInt(),
+                           static_cast< uint8_t >(pclSettingsP->value("logRotateBackup", 0).toUInt()));
+
+   //---------------------------------------------------------------------------------------------------
+   // CPU affinity and scheduling policy of the dispatch thread, there are no widgets for these
+   // settings, they are edited in the settings file. The dispatch thread is the GUI thread here, so
+   // a real-time policy is refused, it is only available for the server daemon (canpie-server).
+   // The messages are written to the log of the first CAN network.
+   //
+   QCanThreadScheduling             clSchedulingT;
+   QList<int32_t>                   aslCpuListT;
+   QCanThreadScheduling::Policy_e   tePolicyT;
+   QString                          clCpusT   = pclSettingsP->value("dispatchCpus", "").toString();
+   QString                          clPolicyT = pclSettingsP->value("dispatchPolicy", "").toString();
+
+   if (QCanThreadScheduling::parseCpuList(clCpusT, aslCpuListT) == false)
+   {
+      pclLoggerP->appendMessage(QCan::eCAN_CHANNEL_1,
+                                "Dispatch thread ........ : invalid CPU list '" + clCpusT + "' ignored",
+                                QCan::eLOG_LEVEL_WARN);
+      aslCpuListT.clear();
+   }
+
+   if (QCanThreadScheduling::parsePolicy(clPolicyT, tePolicyT) == false)
+   {
+      pclLoggerP->appendMessage(QCan::eCAN_CHANNEL_1,
+                                "Dispatch thread ........ : invalid policy '" + clPolicyT + "' ignored",
+                                QCan::eLOG_LEVEL_WARN);
+      tePolicyT = QCanThreadScheduling::ePOLICY_OTHER;
+   }
+   else if (tePolicyT != QCanThreadScheduling::ePOLICY_OTHER)
+   {
+      pclLoggerP->appendMessage(QCan::eCAN_CHANNEL_1,
+                                "Dispatch thread ........ : policy '" + clPolicyT + "' requires canpie-server",
+                                QCan::eLOG_LEVEL_WARN);
+      tePolicyT = QCanThreadScheduling::ePOLICY_OTHER;
+   }
+
+   clSchedulingT.setCpuList(aslCpuListT);
+   clSchedulingT.setPolicy(tePolicyT, pclSettingsP->value("dispatchPriority", 1).toInt());
+
+   if (clSchedulingT.isDefault() == false)
+   {
+      pclCanServerP->setDispatchScheduling(clSchedulingT);
+      pclLoggerP->appendMessage(QCan::eCAN_CHANNEL_1,
+                                "Dispatch thread ........ : " + pclCanServerP->dispatchScheduling().report());
+   }
+
    pclSettingsP->endGroup();
 
    //---------------------------------------------------------------------------------------------------
@@ -203,6 +258,8 @@ QCanServerDialog::QCanServerDialog(QWidget * parent)
       pclLoggerP->setLogLevel(static_cast< QCan::CAN_Channel_e >(ubNetworkIdxT + 1),
                               static_cast< QCan::LogLevel_e > (pclSettingsP->value("loglevel", QCan::eLOG_LEVEL_INFO).toInt()));
 
+      pclNetworkT->setSocketLimit(        pclSettingsP->value("socketLimit"         , 0).toUInt());
+
       pclNetworkT->setNetworkEnabled(     pclSettingsP->value("enabled"             , 1).toBool());
 
       pclNetworkT->setErrorFrameEnabled(  pclSettingsP->value("errorFrameEnabled"   , 0).toBool());
@@ -214,7 +271,12 @@ QCanServerDialog::QCanServerDialog(QWidget * parent)
       pclNetworkT->setBitrate(            pclSettingsP->value("bitrateNominal"   , 500000).toInt(),
                                           pclSettingsP->value("bitrateData"      , QCan::eCAN_BITRATE_NONE).toInt());
 
-      apclCanIfWidgetP[ubNetworkIdxT]->setInterface(pclSettingsP->value("interfaceName","").toString());
+      pclNetworkT->setMulticast(QHostAddress(pclSettingsP->value("multicastGroup", "").toString()),
+                                static_cast< uint16_t >(pclSettingsP->value("multicastPort",
+                                                                            QCAN_MULTICAST_DEFAULT_PORT).toUInt()),
+                                pclSettingsP->value("multicastInterface", "").toString());
+
+      clCanIfWidgetListP[ubNetworkIdxT]->setInterface(pclSettingsP->value("interfaceName","").toString());
 
       pclSettingsP->endGroup();
 
@@ -333,7 +395,7 @@ QCanServerDialog::~QCanServerDialog()
    //---------------------------------------------------------------------------------------------------
    // store network settings
    //
-   for(ubNetworkIdxT = 0; ubNetworkIdxT < QCAN_NETWORK_MAX; ubNetworkIdxT++)
+   for(ubNetworkIdxT = 0; ubNetworkIdxT < pclCanServerP->maximumNetwork(); ubNetworkIdxT++)
    {
       //-------------------------------------------------------------------------------------------
       // settings for network
@@ -348,7 +410,11 @@ QCanServerDialog::~QCanServerDialog()
       pclSettingsP->setValue("flexibleDataEnabled" , pclNetworkT->isFlexibleDataEnabled());
       pclSettingsP->setValue("listenOnlyEnabled"   , pclNetworkT->isListenOnlyEnabled());
       pclSettingsP->setValue("loglevel"            , pclLoggerP->logLevel(static_cast<QCan::CAN_Channel_e>(ubNetworkIdxT+1)));
-      pclSettingsP->setValue("interfaceName"       , apclCanIfWidgetP[ubNetworkIdxT]->name());
+      pclSettingsP->setValue("interfaceName"       , clCanIfWidgetListP[ubNetworkIdxT]->name());
+      pclSettingsP->setValue("multicastGroup"      , pclNetworkT->multicastGroup().toString());
+      pclSettingsP->setValue("multicastPort"       , pclNetworkT->multicastPort());
+      pclSettingsP->setValue("multicastInterface"  , pclNetworkT->multicastInterface());
+      pclSettingsP->setValue("socketLimit"         , pclNetworkT->socketLimit());
 
       pclSettingsP->endGroup();
    }
@@ -359,10 +425,14 @@ QCanServerDialog::~QCanServerDialog()
    pclSettingsP->beginGroup("Server");
 
    pclSettingsP->setValue("hostAddress",         pclCanServerP->serverAddress().toString());
+   pclSettingsP->setValue("networkCount",        pclCanServerP->maximumNetwork());
 
    pclSettingsP->setValue("allowBitrateChange",  pclCanServerP->isBitrateChangeAllowed());
    pclSettingsP->setValue("allowBusOffRecovery", pclCanServerP->isBusOffRecoveryAllowed());
    pclSettingsP->setValue("allowModeChange",     pclCanServerP->isModeChangeAllowed());
+   pclSettingsP->setValue("metricsPort",         pclCanServerP->metricsPort());
+   pclSettingsP->setValue("tcpNoDelay",          pclCanServerP->tcpNoDelay());
+   pclSettingsP->setValue("tcpPort",             pclCanServerP->tcpPort());
    pclSettingsP->endGroup();
 
    delete(pclSettingsP);
@@ -564,7 +634,7 @@ void QCanServerDialog::onInterfaceChange( const QCan::CAN_Channel_e & ubChannelR
          // Remove physical CAN interface:
          // We use the internal VCAN again, the icon is updated.
          //
-         apclCanIfWidgetP[ubIndexV]->setIcon(QIcon(QCAN_IF_VCAN_ICON));
+         clCanIfWidgetListP[ubIndexV]->setIcon(QIcon(QCAN_IF_VCAN_ICON));
 
          //-----------------------------------------------------------------------------------
          // Update the CAN information tree view:
@@ -593,7 +663,7 @@ void QCanServerDialog::onInterfaceChange( const QCan::CAN_Channel_e & ubChannelR
 
             if (pclNetworkT->isNetworkEnabled())
             {
-               apclCanIfWidgetP[ubIndexV]->setIcon(pclInterfaceV->icon());
+               clCanIfWidgetListP[ubIndexV]->setIcon(pclInterfaceV->icon());
                pclNetworkT->startInterface();
 
                //-----------------------------------------------------------------------------
@@ -620,7 +690,7 @@ void QCanServerDialog::onInterfaceChange( const QCan::CAN_Channel_e & ubChannelR
             #endif
 
             pclLoggerP->appendMessage(ubChannelR, tr("Failed to add CAN interface"), QCan::eLOG_LEVEL_ERROR);
-            apclCanIfWidgetP[ubIndexV]->setIcon(QIcon(QCAN_IF_VCAN_ICON));
+            clCanIfWidgetListP[ubIndexV]->setIcon(QIcon(QCAN_IF_VCAN_ICON));
          }
       }
 
@@ -645,7 +715,7 @@ void QCanServerDialog::onInterfaceStateChange(const QCan::CAN_Channel_e & ubChan
       //
       case QCanInterface::FailureState:
 
-         apclCanIfWidgetP[ubChannelR - 1]->setIcon(QIcon(QCAN_IF_VCAN_ICON));
+         clCanIfWidgetListP[ubChannelR - 1]->setIcon(QIcon(QCAN_IF_VCAN_ICON));
 
          if ( (pclIconTrayP != nullptr) && (ui.pclChkDisableNotificationM->isChecked() == false) )
          {
@@ -1136,7 +1206,17 @@ void QCanServerDialog::setIcon(void)
 //--------------------------------------------------------------------------------------------------------------------//
 void QCanServerDialog::setupNetworks(void)
 {
-   pclCanServerP = new QCanServer(this, QCAN_WEB_SOCKET_DEFAULT_PORT, QCAN_NETWORK_MAX, true);
+   //---------------------------------------------------------------------------------------------------
+   // the number of networks is fixed during run-time, so it is read before the settings are loaded
+   //
+   QSettings clSettingsT(QSettings::IniFormat, QSettings::UserScope, "microcontrol.net", "CANpieServer");
+   uint32_t  ulNetworkNumT = clSettingsT.value("Server/networkCount", QCAN_NETWORK_MAX).toUInt();
+   if ((ulNetworkNumT == 0) || (ulNetworkNumT > QCAN_NETWORK_LIMIT))
+   {
+      ulNetworkNumT = QCAN_NETWORK_MAX;
+   }
+
+   pclCanServerP = new QCanServer(this, QCAN_WEB_SOCKET_DEFAULT_PORT, static_cast< uint8_t >(ulNetworkNumT), true);
    if (pclCanServerP->state() == QCanServer::eERROR_ACTIVE)
    {
       QMessageBox::warning(nullptr, "CANpie FD Server", "CANpie Server is already running.");
@@ -39,6 +39,7 @@
 
 
 #include <QtCore/QSettings>
+#include <QtCore/QVector>
 #if QT_VERSION >= 0x060000
 #include <QAction>
 #else
@@ -155,7 +156,7 @@ private:
    int32_t                 slNetworkTabIndexP;
 
    QToolBox *              pclTbxNetworkP;
-   QCanInterfaceWidget *   apclCanIfWidgetP[QCAN_NETWORK_MAX];
+   QVector<QCanInterfaceWidget *> clCanIfWidgetListP;
    QCanServerLoggerView *  pclLoggerP;
 
 };
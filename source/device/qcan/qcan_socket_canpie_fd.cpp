@@ -38,6 +38,7 @@
 #include "qcan_socket_canpie_fd.hpp"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QHash>
 #include <QtCore/QTimer>
 
 
@@ -87,8 +88,16 @@ static QCoreApplication *  pclApplicationS = nullptr;
 
 
 //------------------------------------------------------------------------------------------------------
+// The sockets are created by CpCoreDriverInit(), so only the initialised CAN channels allocate a
+// socket. A socket exists until the process terminates.
 //
-static QCanSocketCpFD      aclCanSockListS[QCAN_NETWORK_MAX];
+static QCanSocketCpFD *    apclCanSockListS[QCAN_NETWORK_LIMIT] = { };
+
+
+//------------------------------------------------------------------------------------------------------
+// host addresses set by CpSocketSetHostAddress() before the socket of the CAN channel is created
+//
+static QHash<uint8_t, QHostAddress> clHostAddressListS;
 
 
 /*--------------------------------------------------------------------------------------------------------------------*\
@@ -97,6 +106,53 @@ static QCanSocketCpFD      aclCanSockListS[QCAN_NETWORK_MAX];
 \*--------------------------------------------------------------------------------------------------------------------*/
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// CanSocket()                                                                                                        //
+// get pointer to CANpie socket class, returns nullptr if the CAN channel is not initialised                          //
+//--------------------------------------------------------------------------------------------------------------------//
+static QCanSocketCpFD * CanSocket(const uint32_t ulPhyIfV)
+{
+   QCanSocketCpFD *  pclSockT = nullptr;
+
+   if ((ulPhyIfV > eCP_CHANNEL_NONE) && (ulPhyIfV <= QCAN_NETWORK_LIMIT))
+   {
+      pclSockT = apclCanSockListS[ulPhyIfV - 1];
+   }
+
+   return (pclSockT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// CanSocketCreate()                                                                                                  //
+// get pointer to CANpie socket class, the socket is created on first use                                             //
+//--------------------------------------------------------------------------------------------------------------------//
+static QCanSocketCpFD * CanSocketCreate(const uint32_t ulPhyIfV)
+{
+   QCanSocketCpFD *  pclSockT = nullptr;
+
+   if ((ulPhyIfV > eCP_CHANNEL_NONE) && (ulPhyIfV <= QCAN_NETWORK_LIMIT))
+   {
+      if (apclCanSockListS[ulPhyIfV - 1] == nullptr)
+      {
+         pclSockT = new QCanSocketCpFD();
+
+         //-----------------------------------------------------------------------------------
+         // apply a host address which has been set before the socket was created
+         //
+         if (clHostAddressListS.contains(static_cast< uint8_t >(ulPhyIfV)))
+         {
+            pclSockT->setHostAddress(clHostAddressListS.value(static_cast< uint8_t >(ulPhyIfV)));
+         }
+         apclCanSockListS[ulPhyIfV - 1] = pclSockT;
+      }
+      pclSockT = apclCanSockListS[ulPhyIfV - 1];
+   }
+
+   return (pclSockT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // CheckParam()                                                                                                       //
 // check valid port, buffer number and driver state                                                                   //
@@ -160,7 +216,7 @@ CpStatus_tv CP_API(CpCoreBitrate)( CpPort_ts * ptsPortV, int32_t slNomBitRateV,
    //
    if (ptsPortV != nullptr)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
+      if (CanSocket(ptsPortV->ubPhyIf) != nullptr)
       {
          //----------------------------------------------------------------------------------------
          // This function does not modify the bitrate settings of the CANpie FD server, because
@@ -195,10 +251,7 @@ CpStatus_tv CP_API(CpCoreBufferConfig)(CpPort_ts * ptsPortV, uint8_t   ubBufferI
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -275,10 +328,7 @@ CpStatus_tv CP_API(CpCoreBufferGetData)( CpPort_ts * ptsPortV, uint8_t   ubBuffe
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -330,10 +380,7 @@ CpStatus_tv CP_API(CpCoreBufferGetDlc)(CpPort_ts * ptsPortV, uint8_t ubBufferIdx
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -371,10 +418,7 @@ CpStatus_tv CP_API(CpCoreBufferRelease)( CpPort_ts * ptsPortV, uint8_t ubBufferI
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -418,10 +462,7 @@ CpStatus_tv CP_API(CpCoreBufferSend)(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -503,10 +544,7 @@ CpStatus_tv CP_API(CpCoreBufferSetData)( CpPort_ts * ptsPortV, uint8_t ubBufferI
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -558,10 +596,7 @@ CpStatus_tv CP_API(CpCoreBufferSetDlc)( CpPort_ts * ptsPortV, uint8_t ubBufferId
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -607,10 +642,7 @@ CpStatus_tv CP_API(CpCoreCanMode)(CpPort_ts * ptsPortV, uint8_t ubModeV)
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -680,10 +712,7 @@ CpStatus_tv CP_API(CpCoreCanState)(CpPort_ts * ptsPortV, CpState_ts * ptsStateV)
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
 
@@ -757,18 +786,18 @@ CpStatus_tv CP_API(CpCoreDriverInit)(uint8_t ubPhyIfV, CpPort_ts * ptsPortV, uin
 
 
    //---------------------------------------------------------------------------------------------------
-   // test parameter
+   // test parameter, the socket of the CAN channel is created here
    //
-   if ((ubPhyIfV > QCAN_NETWORK_MAX) || (ubPhyIfV == QCan::eCAN_CHANNEL_NONE))
+   pclSockT = CanSocketCreate(ubPhyIfV);
+   if (pclSockT == nullptr)
    {
       tvStatusT = eCP_ERR_CHANNEL;
    }
    else
    {
       //-------------------------------------------------------------------------------------------
-      // Get access to socket and check if it is already connected
+      // check if the socket is already connected
       //
-      pclSockT = &aclCanSockListS[ubPhyIfV - 1];
       if (pclSockT->isConnected() == false)
       {
          pclSockT->connectNetwork((QCan::CAN_Channel_e) ubPhyIfV);
@@ -874,10 +903,7 @@ CpStatus_tv CP_API(CpCoreDriverRelease)(CpPort_ts * ptsPortV)
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    CpCoreCanMode(ptsPortV, eCP_MODE_INIT);
@@ -926,10 +952,7 @@ CpStatus_tv CP_API(CpCoreFifoConfig)(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -967,10 +990,7 @@ CpStatus_tv CP_API(CpCoreFifoRead)(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV, C
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -1027,10 +1047,7 @@ CpStatus_tv CP_API(CpCoreFifoRelease)(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -1069,10 +1086,7 @@ CpStatus_tv CP_API(CpCoreFifoWrite)(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -1130,10 +1144,7 @@ CpStatus_tv CP_API(CpCoreHDI)(CpPort_ts *ptsPortV, CpHdi_ts *ptsHdiV)
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -1184,10 +1195,7 @@ CpStatus_tv CP_API(CpCoreIntFunctions)(CpPort_ts * ptsPortV,
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
 
@@ -1229,10 +1237,7 @@ CpStatus_tv CP_API(CpCoreStatistic)(CpPort_ts * ptsPortV, CpStatistic_ts * ptsSt
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
 
@@ -1274,10 +1279,7 @@ CpStatus_tv CP_API(CpCoreStatisticClear)(CpPort_ts *ptsPortV)
    //
    if (tvStatusT == eCP_ERR_NONE)
    {
-      if ( ((ptsPortV->ubPhyIf) > eCP_CHANNEL_NONE) && ((ptsPortV->ubPhyIf) <= QCAN_NETWORK_MAX) )
-      {
-         pclSockT  = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-      }
+      pclSockT = CanSocket(ptsPortV->ubPhyIf);
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -1297,7 +1299,7 @@ CpStatus_tv CP_API(CpCoreStatisticClear)(CpPort_ts *ptsPortV)
 
 //--------------------------------------------------------------------------------------------------------------------//
 // CpSocketConnectSlots()                                                                                             //
-//                                                                                                                    //
+// the CAN channel must be initialised by CpCoreDriverInit()                                                          //
 //--------------------------------------------------------------------------------------------------------------------//
 CpStatus_tv CpSocketConnectSlots(uint8_t ubPhyIfV, QObject * pclDestObjectV,
                                  const char * pubSockConnectV, const char * pubSockDisconnectV,
@@ -1315,17 +1317,12 @@ CpStatus_tv CpSocketConnectSlots(uint8_t ubPhyIfV, QObject * pclDestObjectV,
    //---------------------------------------------------------------------------------------------------
    // test parameter
    //
-   if ((ubPhyIfV > QCAN_NETWORK_MAX) || (ubPhyIfV == QCan::eCAN_CHANNEL_NONE))
+   pclSockT = CanSocket(ubPhyIfV);
+   if (pclSockT == nullptr)
    {
-      return(eCP_ERR_CHANNEL);
+      return(eCP_ERR_INIT_MISSING);
    }
 
-   
-   //-----------------------------------------------------------------------------------
-   // get pointer to CANpie socket class
-   //
-   pclSockT  = &aclCanSockListS[ubPhyIfV - 1];
-
    if(pubSockConnectV != nullptr)
    {
       QObject::connect( pclSockT, SIGNAL(connected()),
@@ -1350,7 +1347,7 @@ CpStatus_tv CpSocketConnectSlots(uint8_t ubPhyIfV, QObject * pclDestObjectV,
 
 //--------------------------------------------------------------------------------------------------------------------//
 // CpSocketInstance()                                                                                                 //
-//                                                                                                                    //
+// returns nullptr if the CAN channel is not initialised by CpCoreDriverInit()                                        //
 //--------------------------------------------------------------------------------------------------------------------//
 QCanSocket * CpSocketInstance(uint8_t ubPhyIfV)
 {
@@ -1359,10 +1356,7 @@ QCanSocket * CpSocketInstance(uint8_t ubPhyIfV)
    //---------------------------------------------------------------------------------------------------
    // test parameter
    //
-   if ((ubPhyIfV < QCAN_NETWORK_MAX) && (ubPhyIfV > QCan::eCAN_CHANNEL_NONE))
-   {
-      pclSockT = static_cast< QCanSocket * >(&aclCanSockListS[ubPhyIfV - 1]);
-   }
+   pclSockT = static_cast< QCanSocket * >(CanSocket(ubPhyIfV));
 
    return (pclSockT);
 }
@@ -1392,15 +1386,18 @@ CpStatus_tv CpSocketSetHostAddress(uint8_t ubPhyIfV, QHostAddress clHostAddressV
    //---------------------------------------------------------------------------------------------------
    // test parameter
    //
-   if ( (ubPhyIfV > QCan::eCAN_CHANNEL_NONE) && (ubPhyIfV <= QCAN_NETWORK_MAX) )
+   if (ubPhyIfV > eCP_CHANNEL_NONE)
    {
-
       //-------------------------------------------------------------------------------------------
-      // get pointer to CANpie socket class
+      // the address is stored for a socket which is created later by CpCoreDriverInit()
       //
-      pclSockT  = &aclCanSockListS[ubPhyIfV - 1];
+      clHostAddressListS.insert(ubPhyIfV, clHostAddressV);
 
-      pclSockT->setHostAddress(clHostAddressV);
+      pclSockT = CanSocket(ubPhyIfV);
+      if (pclSockT != nullptr)
+      {
+         pclSockT->setHostAddress(clHostAddressV);
+      }
       tvStatusT = eCP_ERR_NONE;
    }
 
@@ -1810,6 +1807,25 @@ CpNrlDriver_ts tsNrlDriverG = {
 };
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// NrlCoreData()                                                                                                      //
+// get pointer to NRL core data of a CAN channel                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+static CpNrlCoreData_ts * NrlCoreData(const uint32_t ulPhyIfV)
+{
+   CpNrlCoreData_ts *   ptsNrlCoreDataT = (CpNrlCoreData_ts *) nullptr;
+   QCanSocketCpFD *     pclSockT;
+
+   pclSockT = CanSocket(ulPhyIfV);
+   if (pclSockT != nullptr)
+   {
+      ptsNrlCoreDataT = pclSockT->ptsNrlCoreDataM;
+   }
+
+   return (ptsNrlCoreDataT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // CpNrlFaultSimulation()                                                                                             //
 //                                                                                                                    //
@@ -1826,12 +1842,12 @@ void CpNrlFaultSimulation(uint8_t ubNrlChannelV, enum CpNrlFault_e teFaultV)
       switch (teFaultV)
       {
          case eCP_NRL_FAULT_NONE:
-            pclSockT  = &aclCanSockListS[ubNrlChannelV - 1];
+            pclSockT  = CanSocket(ubNrlChannelV);
             if (pclSockT != nullptr)
             {
                pclSockT->simulateFault(false);
             }
-            pclSockT  = &aclCanSockListS[ubNrlChannelV];
+            pclSockT  = CanSocket(ubNrlChannelV + 1U);
             if (pclSockT != nullptr)
             {
                pclSockT->simulateFault(false);
@@ -1839,12 +1855,12 @@ void CpNrlFaultSimulation(uint8_t ubNrlChannelV, enum CpNrlFault_e teFaultV)
             break;
 
          case eCP_NRL_FAULT_DISCONNECT_DCL:
-            pclSockT  = &aclCanSockListS[ubNrlChannelV - 1];
+            pclSockT  = CanSocket(ubNrlChannelV);
             if (pclSockT != nullptr)
             {
                pclSockT->simulateFault(true);
             }
-            pclSockT  = &aclCanSockListS[ubNrlChannelV];
+            pclSockT  = CanSocket(ubNrlChannelV + 1U);
             if (pclSockT != nullptr)
             {
                pclSockT->simulateFault(false);
@@ -1852,12 +1868,12 @@ void CpNrlFaultSimulation(uint8_t ubNrlChannelV, enum CpNrlFault_e teFaultV)
             break;
 
          case eCP_NRL_FAULT_DISCONNECT_RCL:
-            pclSockT  = &aclCanSockListS[ubNrlChannelV - 1];
+            pclSockT  = CanSocket(ubNrlChannelV);
             if (pclSockT != nullptr)
             {
                pclSockT->simulateFault(false);
             }
-            pclSockT  = &aclCanSockListS[ubNrlChannelV];
+            pclSockT  = CanSocket(ubNrlChannelV + 1U);
             if (pclSockT != nullptr)
             {
                pclSockT->simulateFault(true);
@@ -1865,12 +1881,12 @@ void CpNrlFaultSimulation(uint8_t ubNrlChannelV, enum CpNrlFault_e teFaultV)
             break;
 
          case eCP_NRL_FAULT_DISCONNECT_ALL:
-            pclSockT  = &aclCanSockListS[ubNrlChannelV - 1];
+            pclSockT  = CanSocket(ubNrlChannelV);
             if (pclSockT != nullptr)
             {
                pclSockT->simulateFault(true);
             }
-            pclSockT  = &aclCanSockListS[ubNrlChannelV];
+            pclSockT  = CanSocket(ubNrlChannelV + 1U);
             if (pclSockT != nullptr)
             {
                pclSockT->simulateFault(true);
@@ -1893,7 +1909,7 @@ bool_t CpNrlMboxCounterEvent(uint8_t ubPhyIfV, uint8_t ubBufferIdxV)
    uint8_t              ubLineIndexT  = eCP_NRL_LINE_NONE;
    CpNrlCoreData_ts *   ptsNrlCoreDataT;
 
-   ptsNrlCoreDataT = aclCanSockListS[ubPhyIfV - 1].ptsNrlCoreDataM;
+   ptsNrlCoreDataT = NrlCoreData(ubPhyIfV);
 
    if (ptsNrlCoreDataT != (CpNrlCoreData_ts *) nullptr)
    {
@@ -1951,11 +1967,11 @@ bool_t CpNrlMboxFlush(CpPort_ts * ptsPortV)
    CpNrlCoreData_ts *   ptsNrlCoreDataT = (CpNrlCoreData_ts *) nullptr;
 
 
-   pclSockT = &aclCanSockListS[(ptsPortV->ubPhyIf) - 1];
-   ptsNrlCoreDataT = aclCanSockListS[(ptsPortV->ubPhyIf) - 1].ptsNrlCoreDataM;
+   pclSockT = CanSocket(ptsPortV->ubPhyIf);
 
    if (pclSockT != nullptr)
    {
+      ptsNrlCoreDataT = pclSockT->ptsNrlCoreDataM;
       pclSockT->flushReceiveMailbox(ptsNrlCoreDataT);
    }
 
@@ -2016,7 +2032,7 @@ bool_t CpNrlMboxTickLoad(uint8_t ubPhyIfV, uint8_t ubBufferIdxV)
    uint8_t              ubLineIndexT  = eCP_NRL_LINE_NONE;
    CpNrlCoreData_ts *   ptsNrlCoreDataT;
 
-   ptsNrlCoreDataT = aclCanSockListS[ubPhyIfV - 1].ptsNrlCoreDataM;
+   ptsNrlCoreDataT = NrlCoreData(ubPhyIfV);
 
    if (ptsNrlCoreDataT != (CpNrlCoreData_ts *) nullptr)
    {
@@ -2049,9 +2065,11 @@ bool_t CpNrlMboxTickLoad(uint8_t ubPhyIfV, uint8_t ubBufferIdxV)
 //--------------------------------------------------------------------------------------------------------------------//
 void CpNrlMboxTickEvent(void)
 {
-   if (aclCanSockListS[0].ptsNrlCoreDataM != (CpNrlCoreData_ts *) nullptr)
+   CpNrlCoreData_ts *   ptsNrlCoreDataT = NrlCoreData(eCP_CHANNEL_1);
+
+   if (ptsNrlCoreDataT != (CpNrlCoreData_ts *) nullptr)
    {
-      CpNrlMboxTickDecrement(aclCanSockListS[0].ptsNrlCoreDataM);
+      CpNrlMboxTickDecrement(ptsNrlCoreDataT);
    }
 }
 
@@ -0,0 +1,541 @@
+//====================================================================================================================//
+// File:          qcan_bridge.cpp                                                                                     //
+// Description:   QCAN classes - Bridge link to the CAN network of a remote server                                    //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include "qcan_bridge.hpp"
+
+#include <QtCore/QDebug>
+#include <QtCore/QUuid>
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------------------------------
+// Maximum number of CAN frames of a batch, a batch is sent earlier when control returns to the
+// event loop
+//
+constexpr uint32_t   BRIDGE_BATCH_FRAMES     = 256;
+
+//------------------------------------------------------------------------------------------------------
+// Delay in milliseconds before the connection to the remote server is established again
+//
+constexpr int32_t    BRIDGE_RECONNECT_TIME   = 1000;
+
+//------------------------------------------------------------------------------------------------------
+// Maximum size of the resend window in CAN frames
+//
+constexpr uint32_t   BRIDGE_WINDOW_MAX       = 0x00100000;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge()                                                                                                       //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanBridge::QCanBridge(QObject * pclParentV)
+   : QObject(pclParentV)
+{
+   uwHostPortP     = QCAN_TCP_SOCKET_DEFAULT_PORT;
+   clLinkIdP       = QUuid::createUuid().toByteArray();
+
+   pclSocketP.clear();
+   btActiveP       = false;
+   btHandshakeP    = false;
+   btConnectedP    = false;
+
+   //---------------------------------------------------------------------------------------------------
+   // The flush timer sends the pending CAN frames when control returns to the event loop, the
+   // reconnect timer delays a new connection attempt.
+   //
+   clFlushTimerP.setSingleShot(true);
+   clFlushTimerP.setInterval(0);
+   connect(&clFlushTimerP, &QTimer::timeout, this, &QCanBridge::onFlushTimeout);
+
+   clReconnectTimerP.setSingleShot(true);
+   clReconnectTimerP.setInterval(BRIDGE_RECONNECT_TIME);
+   connect(&clReconnectTimerP, &QTimer::timeout, this, &QCanBridge::onReconnectTimeout);
+
+   clSyncTimeP.start();
+
+   ulWindowSizeP   = 0;
+   ulWindowMaskP   = 0;
+   ulSeqAckP       = 0;
+   ulSeqSentP      = 0;
+   ulSeqNextP      = 0;
+   setWindowSize(QCAN_BRIDGE_WINDOW_DEFAULT);
+
+   resetCounter();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// ~QCanBridge()                                                                                                      //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanBridge::~QCanBridge()
+{
+   stop();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::fromJson()                                                                                             //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanBridge::fromJson(const QJsonObject & clJsonR)
+{
+   QCanRoute   clRouteT;
+
+   //---------------------------------------------------------------------------------------------------
+   // The keys "handle", "source", "target" and "host" are mandatory. The route is not valid if source
+   // and target have the same value, so the result of QCanRoute::fromJson() is not evaluated.
+   //
+   if ( (clJsonR.contains("handle") == false) || (clJsonR.contains("source") == false) ||
+        (clJsonR.contains("target") == false) || (clJsonR.contains("host") == false) )
+   {
+      return (false);
+   }
+
+   clRouteT.fromJson(clJsonR);
+   setRoute(clRouteT);
+   setRemoteHost(QHostAddress(clJsonR.value("host").toString()),
+                 static_cast< uint16_t >(clJsonR.value("port").toInt(QCAN_TCP_SOCKET_DEFAULT_PORT)));
+   setWindowSize(static_cast< uint32_t >(clJsonR.value("window").toInt(QCAN_BRIDGE_WINDOW_DEFAULT)));
+
+   return (isValid());
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::isValid()                                                                                              //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanBridge::isValid(void) const
+{
+   bool  btResultT = false;
+
+   if ( (clRouteP.sourceChannel() > QCan::eCAN_CHANNEL_NONE) && (clRouteP.sourceChannel() <= QCAN_NETWORK_LIMIT) &&
+        (clRouteP.targetChannel() > QCan::eCAN_CHANNEL_NONE) && (clRouteP.targetChannel() <= QCAN_NETWORK_LIMIT) &&
+        (clHostAddrP.isNull() == false) && (uwHostPortP > 0) )
+   {
+      btResultT = true;
+   }
+
+   return (btResultT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::onFlushTimeout()                                                                                       //
+// send pending CAN frames                                                                                            //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::onFlushTimeout(void)
+{
+   sendPending();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::onReconnectTimeout()                                                                                   //
+// connect to remote server                                                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::onReconnectTimeout(void)
+{
+   if ((btActiveP == false) || (pclSocketP.isNull() == false))
+   {
+      return;
+   }
+
+   #ifndef QT_NO_DEBUG_OUTPUT
+   qDebug() << "QCanBridge::onReconnectTimeout() -" << clHostAddrP << uwHostPortP;
+   #endif
+
+   pclSocketP   = new QTcpSocket(this);
+   btHandshakeP = true;
+
+   connect( pclSocketP, &QTcpSocket::connected,          this, &QCanBridge::onSocketConnect);
+   connect( pclSocketP, &QTcpSocket::disconnected,       this, &QCanBridge::onSocketDisconnect);
+   #if QT_VERSION > QT_VERSION_CHECK(5, 15, 0)
+   connect( pclSocketP, &QTcpSocket::errorOccurred,      this, &QCanBridge::onSocketError);
+   #else
+   connect( pclSocketP, QOverload<QAbstractSocket::SocketError>::of(&QTcpSocket::error),
+            this, &QCanBridge::onSocketError);
+   #endif
+   connect( pclSocketP, &QTcpSocket::readyRead,          this, &QCanBridge::onSocketReceive);
+
+   pclSocketP->connectToHost(clHostAddrP, uwHostPortP);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::onSocketConnect()                                                                                      //
+// send handshake to remote server                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::onSocketConnect(void)
+{
+   pclSocketP->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+   pclSocketP->write("CAN " + QByteArray::number(static_cast< int32_t >(clRouteP.targetChannel())) +
+                     " BRIDGE " + clLinkIdP + "\n");
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::onSocketDisconnect()                                                                                   //
+// connection to remote server lost                                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::onSocketDisconnect(void)
+{
+   #ifndef QT_NO_DEBUG_OUTPUT
+   qDebug() << "QCanBridge::onSocketDisconnect()";
+   #endif
+
+   //---------------------------------------------------------------------------------------------------
+   // The function is called for the signal disconnected() and for socket errors, the socket is
+   // deleted only once. Unacknowledged CAN frames are sent again after the next handshake.
+   //
+   if (pclSocketP.isNull() == false)
+   {
+      disconnect(pclSocketP, nullptr, this, nullptr);
+      pclSocketP->abort();
+      pclSocketP->deleteLater();
+      pclSocketP.clear();
+   }
+
+   btHandshakeP = false;
+   btConnectedP = false;
+   clFlushTimerP.stop();
+
+   if (btActiveP && (clReconnectTimerP.isActive() == false))
+   {
+      clReconnectTimerP.start();
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::onSocketError()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::onSocketError(QAbstractSocket::SocketError teSocketErrorV)
+{
+   #ifndef QT_NO_DEBUG_OUTPUT
+   qDebug() << "QCanBridge::onSocketError() -" << teSocketErrorV;
+   #else
+   Q_UNUSED(teSocketErrorV);
+   #endif
+
+   //---------------------------------------------------------------------------------------------------
+   // a failed connection attempt does not emit disconnected()
+   //
+   onSocketDisconnect();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::onSocketReceive()                                                                                      //
+// evaluate handshake and acknowledge messages                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::onSocketReceive(void)
+{
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+   QByteArray  clLineT;
+   uint32_t    ulSeqAckT;
+   uint32_t    ulCountT;
+   uint64_t    uqSyncTimeT;
+
+   //---------------------------------------------------------------------------------------------------
+   // The remote server answers the handshake with "OK <channel>". All CAN frames which have not been
+   // acknowledged yet are sent again, the remote network drops the CAN frames it already knows.
+   //
+   if (btHandshakeP)
+   {
+      if (pclSocketP->canReadLine() == false)
+      {
+         if (pclSocketP->bytesAvailable() >= QCAN_TCP_HANDSHAKE_SIZE)
+         {
+            onSocketDisconnect();
+         }
+         return;
+      }
+
+      clLineT = pclSocketP->readLine(QCAN_TCP_HANDSHAKE_SIZE).trimmed();
+      if (clLineT.startsWith("OK") == false)
+      {
+         #ifndef QT_NO_DEBUG_OUTPUT
+         qDebug() << "QCanBridge::onSocketReceive() -" << clLineT;
+         #endif
+
+         onSocketDisconnect();
+         return;
+      }
+
+      btHandshakeP    = false;
+      btConnectedP    = true;
+      ulConnectCountP++;
+      ulResendCountP += (ulSeqSentP - ulSeqAckP);
+      ulSeqSentP      = ulSeqAckP;
+      sendPending();
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // The remote network sends only acknowledge messages to a bridge link, the parameter holds the
+   // sequence number of the last CAN frame which has been processed.
+   //
+   while ((pclSocketP.isNull() == false) && (pclSocketP->bytesAvailable() >= QCAN_FRAME_ARRAY_SIZE))
+   {
+      if (pclSocketP->read(reinterpret_cast< char * >(&aubDataT[0]), QCAN_FRAME_ARRAY_SIZE) != QCAN_FRAME_ARRAY_SIZE)
+      {
+         break;
+      }
+
+      if (QCanBridgeSequence::parseAcknowledge(&aubDataT[0], ulSeqAckT, uqSyncTimeT) == false)
+      {
+         continue;
+      }
+
+      ulCountT  = ulSeqAckT + 1 - ulSeqAckP;
+      if ((ulCountT > 0) && (ulCountT <= (ulSeqSentP - ulSeqAckP)))
+      {
+         ulAckCountP += ulCountT;
+         ulSeqAckP    = ulSeqAckT + 1;
+      }
+
+      clLatencyP.record(static_cast< uint64_t >(clSyncTimeP.nsecsElapsed()) - uqSyncTimeT);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::process()                                                                                              //
+// store CAN frame in resend window                                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::process(const QCanFrame & clFrameR, const uint64_t uqTimeV)
+{
+   QCanFrame   clFrameT = clFrameR;
+   uint8_t *   pubSlotT;
+
+   if (clRouteP.process(clFrameT, uqTimeV) == false)
+   {
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // If the resend window is full, the oldest CAN frame is dropped even if it has not been sent yet.
+   //
+   if ((ulSeqNextP - ulSeqAckP) >= ulWindowSizeP)
+   {
+      if (ulSeqSentP == ulSeqAckP)
+      {
+         ulSeqSentP++;
+      }
+      ulSeqAckP++;
+      ulLostCountP++;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the sequence number is placed in the sequence part of the delivery stamp
+   //
+   pubSlotT = reinterpret_cast< uint8_t * >(clWindowP.data()) + ((ulSeqNextP & ulWindowMaskP) * QCAN_FRAME_ARRAY_SIZE);
+   clFrameT.toRawData(pubSlotT);
+   QCanBridgeSequence::setSequence(pubSlotT, ulSeqNextP);
+   ulSeqNextP++;
+
+   if (btConnectedP)
+   {
+      if ((ulSeqNextP - ulSeqSentP) >= BRIDGE_BATCH_FRAMES)
+      {
+         sendPending();
+      }
+      else if (clFlushTimerP.isActive() == false)
+      {
+         clFlushTimerP.start();
+      }
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::resetCounter()                                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::resetCounter(void)
+{
+   ulSentCountP    = 0;
+   ulAckCountP     = 0;
+   ulResendCountP  = 0;
+   ulLostCountP    = 0;
+   ulConnectCountP = 0;
+   clRouteP.resetCounter();
+   clLatencyP.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::sendPending()                                                                                          //
+// send batch of CAN frames to remote server                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::sendPending(void)
+{
+   uint32_t    ulPosT;
+   uint32_t    ulCountT;
+
+   if ((btConnectedP == false) || (pclSocketP.isNull()) || (ulSeqSentP == ulSeqNextP))
+   {
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // The CAN frames are written directly from the resend window, at most two blocks are required
+   // if the sequence numbers wrap around the end of the window. The socket is not flushed, so the
+   // batch is sent in as few segments as possible.
+   //
+   while (ulSeqSentP != ulSeqNextP)
+   {
+      ulPosT   = ulSeqSentP & ulWindowMaskP;
+      ulCountT = qMin(ulSeqNextP - ulSeqSentP, ulWindowSizeP - ulPosT);
+      pclSocketP->write(clWindowP.constData() + (ulPosT * QCAN_FRAME_ARRAY_SIZE),
+                        static_cast< int64_t >(ulCountT) * QCAN_FRAME_ARRAY_SIZE);
+      ulSeqSentP   += ulCountT;
+      ulSentCountP += ulCountT;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the batch is terminated by the sync message, which is returned by the remote network
+   //
+   pclSocketP->write(QCanBridgeSequence::sync(ulSeqSentP - 1, static_cast< uint64_t >(clSyncTimeP.nsecsElapsed())));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::setRemoteHost()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::setRemoteHost(const QHostAddress & clHostAddrR, const uint16_t uwPortV)
+{
+   clHostAddrP = clHostAddrR;
+   uwHostPortP = uwPortV;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::setRoute()                                                                                             //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::setRoute(const QCanRoute & clRouteR)
+{
+   clRouteP = clRouteR;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::setWindowSize()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::setWindowSize(const uint32_t ulSizeV)
+{
+   uint32_t ulSizeT = 1;
+
+   //---------------------------------------------------------------------------------------------------
+   // round up to next power of 2, so the position inside the window can be masked
+   //
+   while ((ulSizeT < ulSizeV) && (ulSizeT < BRIDGE_WINDOW_MAX))
+   {
+      ulSizeT = ulSizeT << 1;
+   }
+
+   clWindowP.resize(static_cast< int32_t >(ulSizeT * QCAN_FRAME_ARRAY_SIZE));
+   ulWindowSizeP = ulSizeT;
+   ulWindowMaskP = ulSizeT - 1;
+
+   //---------------------------------------------------------------------------------------------------
+   // the sequence number continues, so the remote network does not drop the following CAN frames
+   //
+   ulSeqAckP     = ulSeqNextP;
+   ulSeqSentP    = ulSeqNextP;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::start()                                                                                                //
+// connect to remote server                                                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::start(void)
+{
+   btActiveP = true;
+   onReconnectTimeout();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::stop()                                                                                                 //
+// close connection to remote server                                                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridge::stop(void)
+{
+   btActiveP = false;
+   clReconnectTimerP.stop();
+   onSocketDisconnect();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridge::toJson()                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QJsonObject QCanBridge::toJson(void) const
+{
+   QJsonObject clJsonT = clRouteP.toJson();
+
+   clJsonT["host"]         = clHostAddrP.toString();
+   clJsonT["port"]         = static_cast< int32_t >(uwHostPortP);
+   clJsonT["window"]       = static_cast< int32_t >(ulWindowSizeP);
+   clJsonT["connected"]    = btConnectedP;
+   clJsonT["pending"]      = static_cast< int32_t >(ulSeqNextP - ulSeqAckP);
+   clJsonT["sentCount"]    = static_cast< int32_t >(ulSentCountP);
+   clJsonT["ackCount"]     = static_cast< int32_t >(ulAckCountP);
+   clJsonT["resendCount"]  = static_cast< int32_t >(ulResendCountP);
+   clJsonT["lostCount"]    = static_cast< int32_t >(ulLostCountP);
+   clJsonT["connectCount"] = static_cast< int32_t >(ulConnectCountP);
+   clJsonT["latency"]      = clLatencyP.toJson();
+
+   return (clJsonT);
+}
@@ -0,0 +1,357 @@
+//====================================================================================================================//
+// File:          qcan_bridge.hpp                                                                                     //
+// Description:   QCAN classes - Bridge link to the CAN network of a remote server                                    //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_BRIDGE_HPP_
+#define QCAN_BRIDGE_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+
+#include <QtNetwork/QHostAddress>
+#include <QtNetwork/QTcpSocket>
+
+#include "qcan_bridge_sequence.hpp"
+#include "qcan_latency_histogram.hpp"
+#include "qcan_route.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_BRIDGE_WINDOW_DEFAULT
+**
+** Default number of CAN frames which are kept by a QCanBridge until the remote server has
+** acknowledged them (see QCanBridge::setWindowSize()).
+*/
+#define  QCAN_BRIDGE_WINDOW_DEFAULT          4096
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanBridge
+** \brief   Bridge link to the CAN network of a remote server
+**
+** The QCanBridge class mirrors the CAN frames of a local QCanNetwork into a CAN network of a remote
+** QCanServer. The link uses the raw TCP transport of the remote server (see QCanServer::setTcpPort()),
+** the handshake line "CAN <channel> BRIDGE <link-id>" marks the connection as bridge link:
+** <ul>
+** <li>The CAN frames are selected and translated by a QCanRoute (see setRoute()), the source channel
+** of the route is the local network, the target channel is the network of the remote server.
+** <li>The CAN frames are sent in batches, each CAN frame carries a sequence number in the sequence
+** part of the delivery stamp. A batch is terminated by the control message
+** #QCAN_CONTROL_BRIDGE_SYNC, which is returned by the remote network as #QCAN_CONTROL_BRIDGE_ACK.
+** <li>All CAN frames are kept in a resend window until they have been acknowledged. After a
+** connection loss the bridge reconnects automatically and sends all unacknowledged CAN frames
+** again, the remote network drops CAN frames it has already received. If the window is full, the
+** oldest CAN frame is dropped and counted as lost (see lostCount()).
+** <li>The round trip time of the acknowledge is recorded in a latency histogram (see latency()).
+** </ul>
+** CAN frames which have been received from a bridge link are not forwarded to other bridge links, this
+** avoids loops between servers. A bridge is managed by the QCanServer (see QCanServer::addBridge()),
+** the JSON representation (see fromJson()) is used by the settings WebSocket of the server.
+*/
+class QCanBridge : public QObject
+{
+   Q_OBJECT
+
+public:
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclParentV     Pointer to QObject parent class
+   **
+   ** Create new QCanBridge object, the link is not connected.
+   */
+   QCanBridge(QObject * pclParentV = nullptr);
+
+   ~QCanBridge() override;
+
+   QCanBridge(const QCanBridge&) = delete;                  // no copy constructor
+   QCanBridge& operator=(const QCanBridge&) = delete;       // no assignment operator
+   QCanBridge(QCanBridge&&) = delete;                       // no move constructor
+   QCanBridge& operator=(QCanBridge&&) = delete;            // no move operator
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of CAN frames acknowledged by the remote server
+   */
+   inline uint32_t      ackCount(void) const       { return (ulAckCountP);                              }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of connections established to the remote server
+   */
+   inline uint32_t      connectCount(void) const   { return (ulConnectCountP);                          }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clJsonR        JSON object
+   ** \return     \c true if the JSON object describes a valid bridge
+   ** \see        toJson()
+   **
+   ** Configure the bridge from a JSON object which has the following format, the keys "handle",
+   ** "source", "target" and "host" are mandatory:
+   ** \code
+   ** {
+   **    "handle": 1,
+   **    "source": 1,
+   **    "target": 3,
+   **    "host": "192.168.1.20",
+   **    "port": 55661,
+   **    "window": 4096
+   ** }
+   ** \endcode
+   ** All keys of QCanRoute::fromJson() can be used for the selection of CAN frames.
+   */
+   bool                 fromJson(const QJsonObject & clJsonR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Handle of bridge
+   */
+   inline uint32_t      handle(void) const         { return (clRouteP.handle());                        }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if the remote server has accepted the link
+   */
+   inline bool          isConnected(void) const    { return (btConnectedP);                             }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if local channel, remote channel and remote host are valid
+   */
+   bool                 isValid(void) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Round trip time of the acknowledge in nanoseconds
+   */
+   inline const QCanLatencyHistogram & latency(void) const  { return (clLatencyP);                      }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Local channel
+   */
+   inline QCan::CAN_Channel_e localChannel(void) const     { return (clRouteP.sourceChannel());         }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of CAN frames dropped because the resend window was full
+   ** \see        setWindowSize()
+   */
+   inline uint32_t      lostCount(void) const      { return (ulLostCountP);                             }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clFrameR       CAN frame
+   ** \param[in]  uqTimeV        Actual time in milliseconds
+   **
+   ** The function is called by the local QCanNetwork for each CAN frame. If the CAN frame is
+   ** selected by the route, it is stored in the resend window and sent with the next batch.
+   */
+   void                 process(const QCanFrame & clFrameR, const uint64_t uqTimeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Remote host address
+   */
+   inline QHostAddress  remoteAddress(void) const  { return (clHostAddrP);                              }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Remote channel
+   */
+   inline QCan::CAN_Channel_e remoteChannel(void) const    { return (clRouteP.targetChannel());         }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     TCP port of the remote server
+   */
+   inline uint16_t      remotePort(void) const     { return (uwHostPortP);                              }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of CAN frames which have been sent again after a connection loss
+   */
+   inline uint32_t      resendCount(void) const    { return (ulResendCountP);                           }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Set all counters and the latency histogram to 0.
+   */
+   void                 resetCounter(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Routing rule of the bridge
+   */
+   inline const QCanRoute & route(void) const      { return (clRouteP);                                 }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clHostAddrR    Host address of the remote server
+   ** \param[in]  uwPortV        TCP port of the remote server
+   **
+   ** Define the remote server, the value takes effect on the next connection.
+   */
+   void                 setRemoteHost(const QHostAddress & clHostAddrR,
+                                      const uint16_t uwPortV = QCAN_TCP_SOCKET_DEFAULT_PORT);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clRouteR       Routing rule
+   **
+   ** Define the handle, the local channel (source), the remote channel (target) and the selection of
+   ** CAN frames of the bridge. Contrary to a route between local networks, source and target may
+   ** have the same channel number.
+   */
+   void                 setRoute(const QCanRoute & clRouteR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulSizeV        Number of CAN frames
+   **
+   ** Define the size of the resend window, the value is rounded up to the next power of 2 and limited
+   ** to 1048576. Unacknowledged CAN frames are discarded.
+   */
+   void                 setWindowSize(const uint32_t ulSizeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of CAN frames sent to the remote server, including resent CAN frames
+   */
+   inline uint32_t      sentCount(void) const      { return (ulSentCountP);                             }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        stop()
+   **
+   ** Connect to the remote server, the connection is established again after a connection loss
+   ** until stop() is called.
+   */
+   void                 start(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        start()
+   **
+   ** Close the connection to the remote server. CAN frames are still stored in the resend window.
+   */
+   void                 stop(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     JSON object
+   ** \see        fromJson()
+   **
+   ** The function returns the configuration of the bridge as JSON object, the object also contains
+   ** the connection state ("connected"), the counter values ("sentCount", "ackCount", "resendCount",
+   ** "lostCount", "connectCount"), the number of unacknowledged CAN frames ("pending") and the
+   ** round trip time ("latency", see QCanLatencyHistogram::toJson()).
+   */
+   QJsonObject          toJson(void) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Size of resend window
+   ** \see        setWindowSize()
+   */
+   inline uint32_t      windowSize(void) const     { return (ulWindowSizeP);                            }
+
+private slots:
+
+   void  onSocketConnect(void);
+   void  onSocketDisconnect(void);
+   void  onSocketError(QAbstractSocket::SocketError teSocketErrorV);
+   void  onSocketReceive(void);
+   void  onFlushTimeout(void);
+   void  onReconnectTimeout(void);
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // send all CAN frames from ulSeqSentP to ulSeqNextP, followed by a sync message
+   //
+   void                 sendPending(void);
+
+   QCanRoute            clRouteP;
+   QHostAddress         clHostAddrP;
+   uint16_t             uwHostPortP;
+
+   //---------------------------------------------------------------------------------------------------
+   // The link identifier is created for each bridge object, so the remote network can detect a
+   // restart of the bridge and resets its sequence number.
+   //
+   QByteArray           clLinkIdP;
+
+   QPointer<QTcpSocket> pclSocketP;
+   bool                 btActiveP;
+   bool                 btHandshakeP;
+   bool                 btConnectedP;
+   QTimer               clFlushTimerP;
+   QTimer               clReconnectTimerP;
+   QElapsedTimer        clSyncTimeP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Resend window: the CAN frame with sequence number n is stored at position (n & ulWindowMaskP).
+   // ulSeqAckP is the oldest unacknowledged, ulSeqSentP the next CAN frame to send and ulSeqNextP
+   // the sequence number of the next CAN frame stored in the window.
+   //
+   QByteArray           clWindowP;
+   uint32_t             ulWindowSizeP;
+   uint32_t             ulWindowMaskP;
+   uint32_t             ulSeqAckP;
+   uint32_t             ulSeqSentP;
+   uint32_t             ulSeqNextP;
+
+   uint32_t             ulSentCountP;
+   uint32_t             ulAckCountP;
+   uint32_t             ulResendCountP;
+   uint32_t             ulLostCountP;
+   uint32_t             ulConnectCountP;
+   QCanLatencyHistogram clLatencyP;
+};
+
+#endif   // QCAN_BRIDGE_HPP_
@@ -0,0 +1,165 @@
+//====================================================================================================================//
+// File:          qcan_bridge_sequence.cpp                                                                            //
+// Description:   QCAN classes - Sequence numbers of bridge links                                                     //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QtEndian>
+
+#include "qcan_bridge_sequence.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------------------------------
+// position of the sequence number inside the raw CAN frame, the sequence part of the delivery stamp
+//
+constexpr uint32_t   BRIDGE_SEQUENCE_POS  = QCAN_FRAME_DELIVERY_STAMP_POS + 4;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridgeSequence::acknowledge()                                                                                  //
+// convert sync message into acknowledge                                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+QByteArray QCanBridgeSequence::acknowledge(const uint8_t * pubSyncV)
+{
+   QByteArray clAckT(reinterpret_cast< const char * >(pubSyncV), QCAN_FRAME_ARRAY_SIZE);
+
+   clAckT[0] = static_cast< char >(QCAN_CONTROL_BRIDGE_ACK);
+
+   return (clAckT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridgeSequence::clear()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridgeSequence::clear(void)
+{
+   clSequenceP.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridgeSequence::isDuplicate()                                                                                  //
+// check sequence number of bridge link                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanBridgeSequence::isDuplicate(const QByteArray & clLinkIdR, const uint8_t * pubSockDataV)
+{
+   QHash<QByteArray, uint32_t>::iterator  clSequenceT;
+   uint32_t                               ulSequenceT;
+
+   ulSequenceT = sequence(pubSockDataV);
+   clSequenceT = clSequenceP.find(clLinkIdR);
+   if (clSequenceT == clSequenceP.end())
+   {
+      clSequenceP.insert(clLinkIdR, ulSequenceT + 1);
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the difference is evaluated signed, so the comparison is valid when the sequence number wraps
+   //
+   if (static_cast< int32_t >(ulSequenceT - clSequenceT.value()) < 0)
+   {
+      return (true);
+   }
+
+   clSequenceT.value() = ulSequenceT + 1;
+   return (false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridgeSequence::parseAcknowledge()                                                                             //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanBridgeSequence::parseAcknowledge(const uint8_t * pubDataV, uint32_t & ulSequenceR, uint64_t & uqTimeR)
+{
+   if ((pubDataV[QCAN_FRAME_ARRAY_SIZE - 1] != QCAN_CONTROL_MARKER) || (pubDataV[0] != QCAN_CONTROL_BRIDGE_ACK))
+   {
+      return (false);
+   }
+
+   ulSequenceR = qFromBigEndian<uint32_t>(pubDataV + 4);
+   uqTimeR     = qFromBigEndian<uint64_t>(pubDataV + 8);
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridgeSequence::sequence()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanBridgeSequence::sequence(const uint8_t * pubSockDataV)
+{
+   return (qFromBigEndian<uint32_t>(pubSockDataV + BRIDGE_SEQUENCE_POS));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridgeSequence::setSequence()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanBridgeSequence::setSequence(uint8_t * pubSockDataV, const uint32_t ulSequenceV)
+{
+   qToBigEndian<uint32_t>(ulSequenceV, pubSockDataV + BRIDGE_SEQUENCE_POS);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanBridgeSequence::sync()                                                                                         //
+// create sync message                                                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+QByteArray QCanBridgeSequence::sync(const uint32_t ulSequenceV, const uint64_t uqTimeV)
+{
+   QByteArray  clSyncT(QCAN_FRAME_ARRAY_SIZE, 0);
+
+   clSyncT[0]  = static_cast< char >(QCAN_CONTROL_BRIDGE_SYNC);
+   qToBigEndian<uint32_t>(ulSequenceV, reinterpret_cast< uint8_t * >(clSyncT.data()) + 4);
+   qToBigEndian<uint64_t>(uqTimeV, reinterpret_cast< uint8_t * >(clSyncT.data()) + 8);
+   clSyncT[94] = static_cast< char >(0xCA);
+   clSyncT[95] = static_cast< char >(QCAN_CONTROL_MARKER);
+
+   return (clSyncT);
+}
@@ -0,0 +1,152 @@
+//====================================================================================================================//
+// File:          qcan_bridge_sequence.hpp                                                                            //
+// Description:   QCAN classes - Sequence numbers of bridge links                                                     //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_BRIDGE_SEQUENCE_HPP_
+#define QCAN_BRIDGE_SEQUENCE_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QHash>
+
+#include "qcan_frame.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanBridgeSequence
+** \brief   Sequence numbers of bridge links
+**
+** The QCanBridgeSequence class handles the sequence numbers of the bridge links between servers
+** (see QCanBridge). The sending side stores the sequence number of each CAN frame in the sequence
+** part of the delivery stamp (see setSequence()) and terminates a batch of CAN frames by the sync
+** message created by sync(). The receiving network drops CAN frames which have been sent again
+** after a connection loss (see isDuplicate()) and returns the sync message as acknowledge (see
+** acknowledge()), which is evaluated by the sending side with parseAcknowledge().
+** <p>
+** The class is not thread-safe, the owner must serialise the access.
+*/
+class QCanBridgeSequence
+{
+public:
+
+   QCanBridgeSequence() = default;
+
+   ~QCanBridgeSequence() = default;
+
+   QCanBridgeSequence(const QCanBridgeSequence&) = delete;                  // no copy constructor
+   QCanBridgeSequence& operator=(const QCanBridgeSequence&) = delete;       // no assignment operator
+   QCanBridgeSequence(QCanBridgeSequence&&) = delete;                       // no move constructor
+   QCanBridgeSequence& operator=(QCanBridgeSequence&&) = delete;            // no move operator
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubSyncV       Pointer to sync message (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \return     Acknowledge message
+   **
+   ** The function returns the sync message \a pubSyncV as #QCAN_CONTROL_BRIDGE_ACK, all other
+   ** bytes of the message are not modified.
+   */
+   static QByteArray    acknowledge(const uint8_t * pubSyncV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Remove the sequence numbers of all bridge links.
+   */
+   void                 clear(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clLinkIdR      Link identifier of the bridge link
+   ** \param[in]  pubSockDataV   Pointer to raw CAN frame (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \return     \c true if the CAN frame has already been received
+   **
+   ** The function compares the sequence number of the CAN frame \a pubSockDataV with the next
+   ** expected sequence number of the bridge link \a clLinkIdR. A gap is accepted, the CAN frames
+   ** have been dropped by the sending side (see QCanBridge::lostCount()). The first CAN frame of an
+   ** unknown link identifier is always accepted.
+   */
+   bool                 isDuplicate(const QByteArray & clLinkIdR, const uint8_t * pubSockDataV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubDataV       Pointer to received message (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \param[out] ulSequenceR    Sequence number of the last acknowledged CAN frame
+   ** \param[out] uqTimeR        Send time of the sync message
+   ** \return     \c true if the message is an acknowledge
+   */
+   static bool          parseAcknowledge(const uint8_t * pubDataV, uint32_t & ulSequenceR, uint64_t & uqTimeR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubSockDataV   Pointer to raw CAN frame (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \return     Sequence number of the CAN frame
+   */
+   static uint32_t      sequence(const uint8_t * pubSockDataV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubSockDataV   Pointer to raw CAN frame (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \param[in]  ulSequenceV    Sequence number
+   **
+   ** The function stores the sequence number \a ulSequenceV in the sequence part of the delivery
+   ** stamp of the CAN frame \a pubSockDataV.
+   */
+   static void          setSequence(uint8_t * pubSockDataV, const uint32_t ulSequenceV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulSequenceV    Sequence number of the last CAN frame of the batch
+   ** \param[in]  uqTimeV        Send time in nanoseconds
+   ** \return     Sync message
+   **
+   ** The function creates the control message #QCAN_CONTROL_BRIDGE_SYNC, which terminates a batch
+   ** of CAN frames.
+   */
+   static QByteArray    sync(const uint32_t ulSequenceV, const uint64_t uqTimeV);
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // next expected sequence number of each link identifier
+   //
+   QHash<QByteArray, uint32_t>   clSequenceP;
+};
+
+#endif   // QCAN_BRIDGE_SEQUENCE_HPP_
@@ -0,0 +1,169 @@
+//====================================================================================================================//
+// File:          qcan_change_filter.cpp                                                                              //
+// Description:   QCAN classes - Forwarding of changed CAN frames                                                     //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QtEndian>
+
+#include <cstring>
+
+#include "qcan_change_filter.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Static variables                                                                                                   **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------------------------------
+// number of 32-bit words which must be compared for a DLC value, CAN FD data size rounded up
+//
+static const uint8_t  aubDlc2WordCount[] = { 0,  1,  1,  1,  1,  2,  2,  2,
+                                             2,  3,  4,  5,  6,  8, 12, 16  };
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanChangeFilter()                                                                                                 //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanChangeFilter::QCanChangeFilter(const uint32_t ulMaxSilenceV)
+{
+   ulMaxSilenceP = ulMaxSilenceV;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanChangeFilter::accept()                                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanChangeFilter::accept(const uint8_t * pubDataV, const uint64_t uqTimeV)
+{
+   uint32_t aulDataT[QCAN_MSG_DATA_MAX / 4];
+   uint32_t ulWordCntT;
+   uint32_t ulWordT;
+   int32_t  slIndexT;
+   uint8_t  ubDlcT;
+   uint8_t  ubCtrlT;
+   bool     btChangedT;
+
+   //---------------------------------------------------------------------------------------------------
+   // error frames are always forwarded
+   //
+   if ((pubDataV[0] & 0xE0) != 0x00)
+   {
+      return (true);
+   }
+
+   ubDlcT   = pubDataV[4] & 0x0F;
+   ubCtrlT  = pubDataV[5];
+   slIndexT = clIndexP.insert(qFromBigEndian<uint32_t>(pubDataV) & QCAN_FRAME_ID_MASK_EXT, ((ubCtrlT & 0x01) > 0));
+   if (slIndexT < 0)
+   {
+      return (true);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the payload is copied to an aligned buffer, only the words covered by the data size of the
+   // CAN frame are compared (Classic CAN: maximum 8 bytes, remote frame: no data)
+   //
+   memcpy(&aulDataT[0], pubDataV + 6, QCAN_MSG_DATA_MAX);
+
+   ulWordCntT = aubDlc2WordCount[ubDlcT];
+   if ((ubCtrlT & 0x02) == 0)
+   {
+      if (ulWordCntT > 2)
+      {
+         ulWordCntT = 2;
+      }
+      if ((ubCtrlT & 0x04) > 0)
+      {
+         ulWordCntT = 0;
+      }
+   }
+
+   if (slIndexT == atsValueP.size())
+   {
+      //-------------------------------------------------------------------------------------------
+      // first CAN frame of this identifier
+      //
+      atsValueP.append(LastValue_ts());
+      btChangedT = true;
+   }
+   else
+   {
+      LastValue_ts & tsValueR = atsValueP[slIndexT];
+
+      btChangedT = (tsValueR.ubDlc != ubDlcT) || (tsValueR.ubCtrl != ubCtrlT);
+      for (ulWordT = 0; (ulWordT < ulWordCntT) && (btChangedT == false); ulWordT++)
+      {
+         btChangedT = (tsValueR.aulData[ulWordT] != aulDataT[ulWordT]);
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // refresh of unchanged values after the maximum silence time
+      //
+      if ((btChangedT == false) && (ulMaxSilenceP > 0))
+      {
+         btChangedT = ((uqTimeV - tsValueR.uqTime) >= ulMaxSilenceP);
+      }
+   }
+
+   if (btChangedT)
+   {
+      LastValue_ts & tsValueR = atsValueP[slIndexT];
+
+      memcpy(&tsValueR.aulData[0], &aulDataT[0], ulWordCntT * 4);
+      tsValueR.uqTime = uqTimeV;
+      tsValueR.ubDlc  = ubDlcT;
+      tsValueR.ubCtrl = ubCtrlT;
+   }
+
+   return (btChangedT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanChangeFilter::clear()                                                                                          //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanChangeFilter::clear(void)
+{
+   clIndexP.clear();
+   atsValueP.clear();
+}
@@ -0,0 +1,139 @@
+//====================================================================================================================//
+// File:          qcan_change_filter.hpp                                                                              //
+// Description:   QCAN classes - Forwarding of changed CAN frames                                                     //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_CHANGE_FILTER_HPP_
+#define QCAN_CHANGE_FILTER_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include "qcan_id_index.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanChangeFilter
+** \brief   Forwarding of changed CAN frames
+**
+** The QCanChangeFilter class decides for a single client of a QCanNetwork if a CAN frame is
+** forwarded: a CAN data frame is only forwarded if its DLC, frame format or payload differs from
+** the last CAN frame with the same identifier which has been forwarded to the client. Optionally a
+** CAN frame is also forwarded if the last forwarded CAN frame of this identifier is older than a
+** maximum silence time, so the client gets a periodic refresh of unchanged values.
+** <p>
+** Error frames are always forwarded. If the table can not hold further identifiers, the CAN
+** frames of new identifiers are forwarded without filtering.
+** <p>
+** The class is not thread-safe, the owner of the filter must serialise the access.
+*/
+class QCanChangeFilter
+{
+public:
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulMaxSilenceV  Maximum silence time in milliseconds, 0 for no refresh
+   **
+   ** Create a filter with the maximum silence time \a ulMaxSilenceV.
+   */
+   QCanChangeFilter(const uint32_t ulMaxSilenceV = 0);
+
+   ~QCanChangeFilter() = default;
+
+   QCanChangeFilter(const QCanChangeFilter&) = delete;                  // no copy constructor
+   QCanChangeFilter& operator=(const QCanChangeFilter&) = delete;       // no assignment operator
+   QCanChangeFilter(QCanChangeFilter&&) = delete;                       // no move constructor
+   QCanChangeFilter& operator=(QCanChangeFilter&&) = delete;            // no move operator
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubDataV       Pointer to CAN frame in raw format (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \param[in]  uqTimeV        Actual time in milliseconds
+   ** \return     \c true if the CAN frame shall be forwarded
+   **
+   ** The function checks if the CAN frame \a pubDataV has changed compared to the last CAN frame
+   ** forwarded with the same identifier. If the function returns \c true, the CAN frame is stored
+   ** as last forwarded value.
+   */
+   bool           accept(const uint8_t * pubDataV, const uint64_t uqTimeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Remove all stored CAN frames, the next CAN frame of each identifier is forwarded.
+   */
+   void           clear(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Maximum silence time in milliseconds
+   ** \see        setMaxSilence()
+   **
+   ** Returns the maximum time between two forwarded CAN frames with the same identifier.
+   */
+   inline uint32_t maxSilence(void) const    { return (ulMaxSilenceP);  }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulMaxSilenceV  Maximum silence time in milliseconds, 0 for no refresh
+   ** \see        maxSilence()
+   **
+   ** Set the maximum time between two forwarded CAN frames with the same identifier.
+   */
+   inline void    setMaxSilence(const uint32_t ulMaxSilenceV)
+                                             { ulMaxSilenceP = ulMaxSilenceV;  }
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // last forwarded CAN frame of an identifier: the payload is stored as 32-bit words for comparison
+   //
+   typedef struct LastValue_s {
+      uint32_t    aulData[QCAN_MSG_DATA_MAX / 4];
+      uint64_t    uqTime;
+      uint8_t     ubDlc;
+      uint8_t     ubCtrl;
+   } LastValue_ts;
+
+   QCanIdIndex             clIndexP;
+   QVector<LastValue_ts>   atsValueP;
+   uint32_t                ulMaxSilenceP;
+};
+
+#endif   // QCAN_CHANGE_FILTER_HPP_
@@ -0,0 +1,357 @@
+//====================================================================================================================//
+// File:          qcan_cyclic_table.cpp                                                                               //
+// Description:   QCAN classes - Cyclic transmit table                                                                //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include "qcan_cyclic_table.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------------------------------
+// Number of slots of the timer wheel, the value must be a power of 2. Each slot covers 1 ms.
+//
+constexpr int32_t    WHEEL_SLOT_MAX    = 256;
+constexpr uint64_t   WHEEL_SLOT_MASK   = WHEEL_SLOT_MAX - 1;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanCyclicTable()                                                                                                  //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanCyclicTable::QCanCyclicTable()
+{
+   //---------------------------------------------------------------------------------------------------
+   // all entries are allocated here, they are chained in the free list by clear()
+   //
+   atsEntryP.resize(QCAN_CYCLIC_FRAME_MAX);
+   aslWheelP.resize(WHEEL_SLOT_MAX);
+   clHandleMapP.reserve(QCAN_CYCLIC_FRAME_MAX);
+
+   clear();
+
+   uqWheelTimeP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanCyclicTable::addFrame()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanCyclicTable::addFrame(const uint32_t ulHandleV, const QCanFrame & clFrameR, const uint32_t ulPeriodV,
+                               const int32_t slCounterPosV, const uint64_t uqTimeV)
+{
+   int32_t  slEntryT;
+
+   if (ulPeriodV == 0)
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // an existing entry with the same handle is replaced
+   //
+   removeFrame(ulHandleV);
+
+   if (slFreeListP < 0)
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the timer wheel is not advanced while the table is empty, synchronise it to the actual time
+   //
+   if (clHandleMapP.isEmpty())
+   {
+      uqWheelTimeP = uqTimeV;
+   }
+
+   slEntryT    = slFreeListP;
+   slFreeListP = atsEntryP[slEntryT].slNext;
+
+   CyclicEntry_ts & tsEntryR = atsEntryP[slEntryT];
+   tsEntryR.clFrame      = clFrameR;
+   tsEntryR.uqDueTime    = uqWheelTimeP + 1;
+   tsEntryR.ulHandle     = ulHandleV;
+   tsEntryR.ulPeriod     = ulPeriodV;
+   tsEntryR.ulTrmCount   = 0;
+   tsEntryR.slCounterPos = -1;
+   if ((slCounterPosV >= 0) && (slCounterPosV < clFrameR.dataSize()))
+   {
+      tsEntryR.slCounterPos = slCounterPosV;
+   }
+
+   clHandleMapP.insert(ulHandleV, slEntryT);
+   linkEntry(slEntryT);
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanCyclicTable::clear()                                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanCyclicTable::clear(void)
+{
+   int32_t  slEntryT;
+
+   //---------------------------------------------------------------------------------------------------
+   // clear the timer wheel and chain all entries in the free list again
+   //
+   for (slEntryT = 0; slEntryT < QCAN_CYCLIC_FRAME_MAX; slEntryT++)
+   {
+      atsEntryP[slEntryT].slNext = slEntryT + 1;
+   }
+   atsEntryP[QCAN_CYCLIC_FRAME_MAX - 1].slNext = -1;
+   slFreeListP = 0;
+
+   aslWheelP.fill(-1);
+   clHandleMapP.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanCyclicTable::linkEntry()                                                                                       //
+// insert entry into the slot of the timer wheel defined by its due time                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanCyclicTable::linkEntry(const int32_t slEntryV)
+{
+   int32_t  slSlotT = static_cast< int32_t >(atsEntryP[slEntryV].uqDueTime & WHEEL_SLOT_MASK);
+
+   atsEntryP[slEntryV].slNext = aslWheelP[slSlotT];
+   aslWheelP[slSlotT]         = slEntryV;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanCyclicTable::process()                                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanCyclicTable::process(const uint64_t uqTimeV, QVector<QCanFrame> & clFrameListR)
+{
+   uint32_t ulCountT = 0;
+   int32_t  slSlotT;
+   int32_t  slEntryT;
+   int32_t  slNextT;
+   uint8_t  ubCounterT;
+
+   if (clHandleMapP.isEmpty())
+   {
+      uqWheelTimeP = uqTimeV;
+      return (0);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // One revolution of the wheel visits every entry, so there is no need to step through a longer
+   // period of time.
+   //
+   if (uqTimeV > (uqWheelTimeP + WHEEL_SLOT_MAX))
+   {
+      uqWheelTimeP = uqTimeV - WHEEL_SLOT_MAX;
+   }
+
+   while (uqWheelTimeP < uqTimeV)
+   {
+      uqWheelTimeP++;
+
+      //-------------------------------------------------------------------------------------------
+      // Take the list of the actual slot, entries which are not due yet (cycle time longer than
+      // one revolution) are linked again.
+      //
+      slSlotT  = static_cast< int32_t >(uqWheelTimeP & WHEEL_SLOT_MASK);
+      slEntryT = aslWheelP[slSlotT];
+      aslWheelP[slSlotT] = -1;
+
+      while (slEntryT >= 0)
+      {
+         CyclicEntry_ts & tsEntryR = atsEntryP[slEntryT];
+         slNextT = tsEntryR.slNext;
+
+         if (tsEntryR.uqDueTime <= uqWheelTimeP)
+         {
+            clFrameListR.append(tsEntryR.clFrame);
+            tsEntryR.ulTrmCount++;
+            ulCountT++;
+
+            //-----------------------------------------------------------------------------------
+            // update rolling counter
+            //
+            if (tsEntryR.slCounterPos >= 0)
+            {
+               ubCounterT = tsEntryR.clFrame.data(static_cast< uint8_t >(tsEntryR.slCounterPos));
+               ubCounterT++;
+               tsEntryR.clFrame.setData(static_cast< uint8_t >(tsEntryR.slCounterPos), ubCounterT);
+            }
+
+            //-----------------------------------------------------------------------------------
+            // calculate next transmission time, missed transmissions are skipped but the phase
+            // of the entry is kept
+            //
+            tsEntryR.uqDueTime += tsEntryR.ulPeriod;
+            if (tsEntryR.uqDueTime <= uqTimeV)
+            {
+               tsEntryR.uqDueTime += (((uqTimeV - tsEntryR.uqDueTime) / tsEntryR.ulPeriod) + 1) *
+                                     tsEntryR.ulPeriod;
+            }
+         }
+
+         linkEntry(slEntryT);
+         slEntryT = slNextT;
+      }
+   }
+
+   return (ulCountT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanCyclicTable::removeFrame()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanCyclicTable::removeFrame(const uint32_t ulHandleV)
+{
+   int32_t  slEntryT;
+   int32_t  slSlotT;
+   int32_t  slPrevT;
+   int32_t  slIdxT;
+
+   if (clHandleMapP.contains(ulHandleV) == false)
+   {
+      return (false);
+   }
+
+   slEntryT = clHandleMapP.take(ulHandleV);
+
+   //---------------------------------------------------------------------------------------------------
+   // unlink the entry from its slot of the timer wheel
+   //
+   slSlotT = static_cast< int32_t >(atsEntryP[slEntryT].uqDueTime & WHEEL_SLOT_MASK);
+   slPrevT = -1;
+   slIdxT  = aslWheelP[slSlotT];
+   while ((slIdxT >= 0) && (slIdxT != slEntryT))
+   {
+      slPrevT = slIdxT;
+      slIdxT  = atsEntryP[slIdxT].slNext;
+   }
+
+   if (slIdxT == slEntryT)
+   {
+      if (slPrevT < 0)
+      {
+         aslWheelP[slSlotT] = atsEntryP[slEntryT].slNext;
+      }
+      else
+      {
+         atsEntryP[slPrevT].slNext = atsEntryP[slEntryT].slNext;
+      }
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // return entry to free list
+   //
+   atsEntryP[slEntryT].slNext = slFreeListP;
+   slFreeListP = slEntryT;
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanCyclicTable::transmitCount()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanCyclicTable::transmitCount(const uint32_t ulHandleV) const
+{
+   uint32_t ulCountT = 0;
+
+   if (clHandleMapP.contains(ulHandleV))
+   {
+      ulCountT = atsEntryP.at(clHandleMapP.value(ulHandleV)).ulTrmCount;
+   }
+
+   return (ulCountT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanCyclicTable::updateFrame()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanCyclicTable::updateFrame(const uint32_t ulHandleV, const QCanFrame & clFrameR)
+{
+   int32_t  slEntryT;
+   uint8_t  ubCounterT;
+
+   if (clHandleMapP.contains(ulHandleV) == false)
+   {
+      return (false);
+   }
+
+   slEntryT = clHandleMapP.value(ulHandleV);
+   CyclicEntry_ts & tsEntryR = atsEntryP[slEntryT];
+
+   if (tsEntryR.slCounterPos >= 0)
+   {
+      //-------------------------------------------------------------------------------------------
+      // keep the actual value of the rolling counter, the counter is dropped if the new frame
+      // is too short
+      //
+      ubCounterT        = tsEntryR.clFrame.data(static_cast< uint8_t >(tsEntryR.slCounterPos));
+      tsEntryR.clFrame  = clFrameR;
+      if (tsEntryR.slCounterPos < clFrameR.dataSize())
+      {
+         tsEntryR.clFrame.setData(static_cast< uint8_t >(tsEntryR.slCounterPos), ubCounterT);
+      }
+      else
+      {
+         tsEntryR.slCounterPos = -1;
+      }
+   }
+   else
+   {
+      tsEntryR.clFrame  = clFrameR;
+   }
+
+   return (true);
+}
+
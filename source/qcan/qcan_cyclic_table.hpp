@@ -0,0 +1,184 @@
+//====================================================================================================================//
+// File:          qcan_cyclic_table.hpp                                                                               //
+// Description:   QCAN classes - Cyclic transmit table                                                                //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_CYCLIC_TABLE_HPP_
+#define QCAN_CYCLIC_TABLE_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+
+#include "qcan_frame.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanCyclicTable
+** \brief   Table of cyclic CAN frames
+**
+** The QCanCyclicTable class holds CAN frames which are transmitted periodically by a QCanNetwork. Each
+** entry is identified by a handle value which is defined by the client. The cycle time of an entry is
+** defined in milliseconds, the maximum number of entries is limited by #QCAN_CYCLIC_FRAME_MAX.
+** <p>
+** The entries are sorted into a hashed timer wheel with a resolution of 1 ms, so the effort of the
+** periodic call of process() does not depend on the number of entries in the table. The time base
+** is supplied by the caller, the transmission times are aligned to the initial start time and do not
+** drift.
+** <p>
+** The class is not thread-safe, the owner of the table must serialise the access.
+*/
+class QCanCyclicTable
+{
+public:
+
+   QCanCyclicTable();
+
+   ~QCanCyclicTable() = default;
+
+   QCanCyclicTable(const QCanCyclicTable&) = delete;                  // no copy constructor
+   QCanCyclicTable& operator=(const QCanCyclicTable&) = delete;       // no assignment operator
+   QCanCyclicTable(QCanCyclicTable&&) = delete;                       // no move constructor
+   QCanCyclicTable& operator=(QCanCyclicTable&&) = delete;            // no move operator
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV      Handle of entry
+   ** \param[in]  clFrameR       CAN frame
+   ** \param[in]  ulPeriodV      Cycle time in milliseconds
+   ** \param[in]  slCounterPosV  Position of counter byte, -1 if not used
+   ** \param[in]  uqTimeV        Actual time in milliseconds
+   ** \return     \c true if the entry has been added
+   ** \see        removeFrame()
+   **
+   ** Add the CAN frame \a clFrameR with the cycle time \a ulPeriodV to the table. The first
+   ** transmission takes place with the next call of process() 1 ms later. If an entry with the
+   ** handle \a ulHandleV already exists, it is replaced.
+   ** <p>
+   ** If \a slCounterPosV is in the range of the data size of \a clFrameR, the data byte at this
+   ** position is incremented after each transmission (rolling counter).
+   ** <p>
+   ** The function returns \c false if the cycle time is 0 or if the table is full.
+   */
+   bool           addFrame(const uint32_t ulHandleV, const QCanFrame & clFrameR, const uint32_t ulPeriodV,
+                           const int32_t slCounterPosV, const uint64_t uqTimeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Remove all entries from the table.
+   */
+   void           clear(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of entries
+   **
+   ** Returns the number of entries in the table.
+   */
+   inline uint32_t count(void) const         { return (static_cast< uint32_t >(clHandleMapP.size()));  }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  uqTimeV        Actual time in milliseconds
+   ** \param[out] clFrameListR   List of CAN frames which are due for transmission
+   ** \return     Number of CAN frames
+   **
+   ** The function advances the timer wheel up to the time \a uqTimeV and appends all CAN frames which
+   ** are due for transmission to \a clFrameListR. If the function was not called for more than one
+   ** cycle time of an entry, the missed transmissions are skipped.
+   */
+   uint32_t       process(const uint64_t uqTimeV, QVector<QCanFrame> & clFrameListR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV      Handle of entry
+   ** \return     \c true if the entry has been removed
+   ** \see        addFrame()
+   **
+   ** Remove the entry with the handle \a ulHandleV from the table.
+   */
+   bool           removeFrame(const uint32_t ulHandleV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV      Handle of entry
+   ** \return     Number of transmissions
+   **
+   ** Returns how often the CAN frame of the entry \a ulHandleV has been transmitted.
+   */
+   uint32_t       transmitCount(const uint32_t ulHandleV) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV      Handle of entry
+   ** \param[in]  clFrameR       CAN frame
+   ** \return     \c true if the entry has been updated
+   **
+   ** Replace the CAN frame of the entry \a ulHandleV, the cycle time and the transmission time
+   ** are not changed. If a counter is configured for the entry, the current counter value is kept.
+   */
+   bool           updateFrame(const uint32_t ulHandleV, const QCanFrame & clFrameR);
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // an entry of the table, entries with the same slot of the timer wheel are linked by slNextP
+   //
+   typedef struct CyclicEntry_s {
+      QCanFrame   clFrame;
+      uint64_t    uqDueTime;
+      uint32_t    ulHandle;
+      uint32_t    ulPeriod;
+      uint32_t    ulTrmCount;
+      int32_t     slCounterPos;
+      int32_t     slNext;
+   } CyclicEntry_ts;
+
+   void           linkEntry(const int32_t slEntryV);
+
+   QVector<CyclicEntry_ts>    atsEntryP;
+   QVector<int32_t>           aslWheelP;
+   QHash<uint32_t, int32_t>   clHandleMapP;
+   int32_t                    slFreeListP;
+   uint64_t                   uqWheelTimeP;
+};
+
+#endif   // QCAN_CYCLIC_TABLE_HPP_
@@ -84,16 +84,297 @@
 */
 #define  QCAN_LOCAL_SOCKET_MAX              64
 
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_TCP_SOCKET_DEFAULT_PORT
+** \ingroup QCAN_NW
+** \brief   Default port for raw TCP server
+**
+** This symbol defines the default port of the raw TCP server. A client selects the CAN channel by
+** sending the line "CAN <channel>\n", the server answers "OK <channel>\n" and the connection carries
+** the stream of CAN frames (#QCAN_FRAME_ARRAY_SIZE bytes each) afterwards. On failure the server
+** answers "ERR <reason>\n" and closes the connection. A QCanBridge appends "BRIDGE <link-id>" to the
+** handshake line. The line "MUX <channel> <channel> ...\n" selects a multiplexed connection to several
+** CAN networks (see QCanMuxSocket), "MUX *\n" selects all CAN networks.
+*/
+#define  QCAN_TCP_SOCKET_DEFAULT_PORT       55661
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_TCP_SOCKET_MAX
+** \ingroup QCAN_NW
+** \brief   Maximum number of TCP sockets
+**
+** This symbol defines the maximum number of raw TCP sockets connected to a CAN network.
+*/
+#define  QCAN_TCP_SOCKET_MAX                64
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_SOCKET_LIMIT_MAX
+** \ingroup QCAN_NW
+** \brief   Upper limit of sockets per type
+**
+** This symbol defines the highest number of sockets of each type which can be selected by
+** QCanNetwork::setSocketLimit(). The statistic inside the shared memory of the server holds an entry
+** for each local socket, WebSocket and raw TCP socket up to this limit.
+*/
+#define  QCAN_SOCKET_LIMIT_MAX              256
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_TCP_HANDSHAKE_SIZE
+** \ingroup QCAN_NW
+** \brief   Maximum size of TCP handshake
+**
+** This symbol defines the maximum size of the handshake line of a raw TCP socket in bytes.
+*/
+#define  QCAN_TCP_HANDSHAKE_SIZE            64
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_MULTICAST_DEFAULT_PORT
+** \ingroup QCAN_NW
+** \brief   Default port for UDP multicast
+**
+** This symbol defines the default UDP port of the multicast publication of a CAN network (see
+** QCanNetwork::setMulticast()). A datagram starts with a header of #QCAN_MULTICAST_HEADER_SIZE bytes:
+** <ul>
+** <li>byte 0: marker 0xCA</li>
+** <li>byte 1: version of the datagram format, currently 1</li>
+** <li>byte 2: CAN channel</li>
+** <li>byte 3: number of CAN frames inside the datagram</li>
+** <li>byte 4 .. 7: sequence number of the first CAN frame (big-endian)</li>
+** </ul>
+** The header is followed by the CAN frames (#QCAN_FRAME_ARRAY_SIZE bytes each). The sequence number
+** is incremented for each CAN frame, so a receiver can detect the number of lost CAN frames.
+*/
+#define  QCAN_MULTICAST_DEFAULT_PORT        55662
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_MULTICAST_HEADER_SIZE
+** \ingroup QCAN_NW
+** \brief   Size of multicast datagram header
+**
+** This symbol defines the size of the header of a multicast datagram in bytes.
+*/
+#define  QCAN_MULTICAST_HEADER_SIZE         8
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_MULTICAST_FRAME_MAX
+** \ingroup QCAN_NW
+** \brief   Maximum number of CAN frames per multicast datagram
+**
+** This symbol defines the maximum number of CAN frames inside a multicast datagram. The default
+** value keeps the datagram inside a single Ethernet frame.
+*/
+#define  QCAN_MULTICAST_FRAME_MAX           14
+
 //------------------------------------------------------------------------------------------------------
 /*!
 ** \def     QCAN_NETWORK_MAX
 ** \ingroup QCAN_NW
-** \brief   Maximum number of networks
+** \brief   Default number of networks
 **
-** This symbol defines the maximum number of networks.
+** This symbol defines the default number of networks of a QCanServer. The number of networks can be
+** raised up to #QCAN_NETWORK_LIMIT when the server is created.
 */
 #define  QCAN_NETWORK_MAX                   8
 
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_NETWORK_LIMIT
+** \ingroup QCAN_NW
+** \brief   Upper limit for the number of networks
+**
+** This symbol defines the upper limit for the number of networks of a QCanServer. The value is
+** given by the 8-bit channel number which is used to address a network.
+*/
+#define  QCAN_NETWORK_LIMIT                 255
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_SOCKET_RCV_FIFO_SIZE
+** \ingroup QCAN_NW
+** \brief   Default size of socket receive FIFO
+**
+** This symbol defines the default number of CAN frames which can be stored in the receive FIFO of a
+** QCanSocket. The value must be a power of 2, it can be changed during run-time by calling
+** QCanSocket::setReceiveFifoSize().
+*/
+#define  QCAN_SOCKET_RCV_FIFO_SIZE          4096
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_CYCLIC_FRAME_MAX
+** \ingroup QCAN_NW
+** \brief   Maximum number of cyclic CAN frames
+**
+** This symbol defines the maximum number of cyclic CAN frames which can be transmitted by a
+** QCanNetwork (see QCanNetwork::addCyclicFrame()).
+*/
+#define  QCAN_CYCLIC_FRAME_MAX              256
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_TRANSMIT_QUEUE_SIZE
+** \ingroup QCAN_NW
+** \brief   Size of network transmit queue
+**
+** This symbol defines the number of CAN frames which can be stored by a QCanNetwork if the CAN
+** interface is not able to accept them immediately (see QCanTransmitQueue).
+*/
+#define  QCAN_TRANSMIT_QUEUE_SIZE           1024
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_TRANSMIT_DEADLINE_DEFAULT
+** \ingroup QCAN_NW
+** \brief   Default deadline of network transmit queue
+**
+** This symbol defines the default time in milliseconds a CAN frame is kept in the transmit queue
+** of a QCanNetwork, it can be changed during run-time by calling QCanNetwork::setTransmitDeadline().
+*/
+#define  QCAN_TRANSMIT_DEADLINE_DEFAULT     100
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_ID_TABLE_EXT_MAX
+** \ingroup QCAN_NW
+** \brief   Size of hash table for extended identifiers
+**
+** This symbol defines the size of the hash table for extended CAN identifiers which is used by the
+** tables per CAN identifier of a QCanNetwork (see QCanIdIndex). The value must be a power of 2,
+** the table is filled up to 75 % of this value.
+*/
+#define  QCAN_ID_TABLE_EXT_MAX              4096
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_CONTROL_MARKER
+** \ingroup QCAN_NW
+** \brief   Marker of control messages
+**
+** Control messages are exchanged between a QCanSocket and a QCanNetwork in the same raw format as
+** CAN frames (#QCAN_FRAME_ARRAY_SIZE bytes), the last byte holds this value instead of 0x01. The
+** first byte holds the command (QCAN_CONTROL_xxx), byte 4 .. 7 hold a parameter (MSB first).
+** Implementations which do not know control messages discard them as invalid CAN frames.
+*/
+#define  QCAN_CONTROL_MARKER                0x02
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_CONTROL_SNAPSHOT_REQUEST
+** \ingroup QCAN_NW
+** \brief   Request snapshot of frame cache
+**
+** A QCanSocket requests the most recent CAN frame of each identifier from the QCanNetwork.
+*/
+#define  QCAN_CONTROL_SNAPSHOT_REQUEST      0x01
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_CONTROL_SNAPSHOT_BEGIN
+** \ingroup QCAN_NW
+** \brief   Begin of snapshot
+**
+** The QCanNetwork starts the snapshot, the parameter holds the number of CAN frames which follow.
+*/
+#define  QCAN_CONTROL_SNAPSHOT_BEGIN        0x02
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_CONTROL_SNAPSHOT_END
+** \ingroup QCAN_NW
+** \brief   End of snapshot
+**
+** The QCanNetwork finished the snapshot, all following CAN frames are live data.
+*/
+#define  QCAN_CONTROL_SNAPSHOT_END          0x03
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_CONTROL_FORWARD_MODE
+** \ingroup QCAN_NW
+** \brief   Select forwarding mode
+**
+** A QCanSocket selects which CAN frames are forwarded by the QCanNetwork: byte 1 holds the mode
+** (0 = all CAN frames, 1 = changed CAN frames only), the parameter holds the maximum silence time
+** in milliseconds (see QCanChangeFilter).
+*/
+#define  QCAN_CONTROL_FORWARD_MODE          0x04
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_CONTROL_BRIDGE_SYNC
+** \ingroup QCAN_NW
+** \brief   Synchronisation of a bridge link
+**
+** A QCanBridge terminates a batch of CAN frames by this message, the parameter holds the sequence
+** number of the last CAN frame, byte 8 .. 15 hold the send time (MSB first). The QCanNetwork
+** returns the unmodified message as #QCAN_CONTROL_BRIDGE_ACK after all previous CAN frames have
+** been processed.
+*/
+#define  QCAN_CONTROL_BRIDGE_SYNC           0x05
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_CONTROL_BRIDGE_ACK
+** \ingroup QCAN_NW
+** \brief   Acknowledge of a bridge link
+**
+** The QCanNetwork acknowledges the reception of all CAN frames up to the sequence number given by
+** the parameter (see #QCAN_CONTROL_BRIDGE_SYNC).
+*/
+#define  QCAN_CONTROL_BRIDGE_ACK            0x06
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_CONTROL_CHANNEL_SELECT
+** \ingroup QCAN_NW
+** \brief   Select channel of a multiplexed connection
+**
+** The parameter holds the CAN channel of all following CAN frames on a multiplexed connection (see
+** QCanMuxSocket), the message is sent in both directions.
+*/
+#define  QCAN_CONTROL_CHANNEL_SELECT        0x07
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_DELIVERY_STAMP_NONE
+** \ingroup QCAN_NW
+** \brief   No delivery stamp
+**
+** The QCanNetwork does not modify byte 86 .. 93 of the raw CAN frame (see
+** QCanNetwork::setDeliveryStamp()).
+*/
+#define  QCAN_DELIVERY_STAMP_NONE           0
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_DELIVERY_STAMP_TIME
+** \ingroup QCAN_NW
+** \brief   Delivery stamp with dispatch time
+**
+** The QCanNetwork writes the lower 32 bits of the monotonic clock in nanoseconds at the time of
+** dispatching into byte 86 .. 89 of the raw CAN frame (MSB first), byte 90 .. 93 are set to 0.
+*/
+#define  QCAN_DELIVERY_STAMP_TIME           1
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_DELIVERY_STAMP_SEQUENCE
+** \ingroup QCAN_NW
+** \brief   Delivery stamp with dispatch time and sequence number
+**
+** In addition to #QCAN_DELIVERY_STAMP_TIME the QCanNetwork writes a sequence number into byte
+** 90 .. 93 of the raw CAN frame (MSB first). The sequence number is counted for each socket, so
+** a gap denotes a CAN frame which has been lost on the connection.
+*/
+#define  QCAN_DELIVERY_STAMP_SEQUENCE       2
+
 
 //------------------------------------------------------------------------------------------------------
 /*!
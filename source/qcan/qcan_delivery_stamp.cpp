@@ -0,0 +1,121 @@
+//====================================================================================================================//
+// File:          qcan_delivery_stamp.cpp                                                                             //
+// Description:   QCAN classes - Delivery stamp of dispatched CAN frames                                              //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QtEndian>
+
+#include <cstring>
+
+#include "qcan_delivery_stamp.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------------------------------
+// position of the sequence number inside the raw CAN frame, the sequence part of the delivery stamp
+//
+constexpr uint32_t   DELIVERY_SEQUENCE_POS   = QCAN_FRAME_DELIVERY_STAMP_POS + 4;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanDeliveryStamp::clear()                                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanDeliveryStamp::clear(void)
+{
+   clSequenceP.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanDeliveryStamp::remove()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanDeliveryStamp::remove(const QObject * pclSocketV)
+{
+   clSequenceP.remove(pclSocketV);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanDeliveryStamp::sequence()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanDeliveryStamp::sequence(const uint8_t * pubSockDataV)
+{
+   return (qFromBigEndian<uint32_t>(pubSockDataV + DELIVERY_SEQUENCE_POS));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanDeliveryStamp::setTime()                                                                                       //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanDeliveryStamp::setTime(uint8_t * pubSockDataV, const uint32_t ulTimeV)
+{
+   qToBigEndian<uint32_t>(ulTimeV, pubSockDataV + QCAN_FRAME_DELIVERY_STAMP_POS);
+   qToBigEndian<uint32_t>(0, pubSockDataV + DELIVERY_SEQUENCE_POS);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanDeliveryStamp::stamp()                                                                                         //
+// copy CAN frame and write sequence number of the socket                                                             //
+//--------------------------------------------------------------------------------------------------------------------//
+const uint8_t * QCanDeliveryStamp::stamp(const QObject * pclSocketV, const uint8_t * pubSockDataV)
+{
+   memcpy(aubDataP, pubSockDataV, QCAN_FRAME_ARRAY_SIZE);
+   qToBigEndian<uint32_t>(clSequenceP[pclSocketV]++, aubDataP + DELIVERY_SEQUENCE_POS);
+
+   return (aubDataP);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanDeliveryStamp::time()                                                                                          //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanDeliveryStamp::time(const uint8_t * pubSockDataV)
+{
+   return (qFromBigEndian<uint32_t>(pubSockDataV + QCAN_FRAME_DELIVERY_STAMP_POS));
+}
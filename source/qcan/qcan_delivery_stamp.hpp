@@ -0,0 +1,143 @@
+//====================================================================================================================//
+// File:          qcan_delivery_stamp.hpp                                                                             //
+// Description:   QCAN classes - Delivery stamp of dispatched CAN frames                                              //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_DELIVERY_STAMP_HPP_
+#define QCAN_DELIVERY_STAMP_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+
+#include "qcan_frame.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanDeliveryStamp
+** \brief   Delivery stamp of dispatched CAN frames
+**
+** The QCanDeliveryStamp class writes the delivery stamp (see #QCAN_DELIVERY_STAMP_TIME) into the
+** raw CAN frames dispatched by QCanNetwork. The dispatch time is written once into the CAN frame
+** (see setTime()), the sequence number is counted for each socket and written into a copy of the
+** CAN frame (see stamp()). The CAN frame itself is passed unchanged to the other consumers like
+** the multicast datagram, routes and bridge links.
+** <p>
+** The class is not thread-safe, the owner must serialise the access.
+*/
+class QCanDeliveryStamp
+{
+public:
+
+   QCanDeliveryStamp() = default;
+
+   ~QCanDeliveryStamp() = default;
+
+   QCanDeliveryStamp(const QCanDeliveryStamp&) = delete;                    // no copy constructor
+   QCanDeliveryStamp& operator=(const QCanDeliveryStamp&) = delete;         // no assignment operator
+   QCanDeliveryStamp(QCanDeliveryStamp&&) = delete;                         // no move constructor
+   QCanDeliveryStamp& operator=(QCanDeliveryStamp&&) = delete;              // no move operator
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Remove the sequence numbers of all sockets, the next CAN frame of each socket starts with
+   ** the sequence number 0.
+   */
+   void                 clear(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclSocketV     Pointer to socket
+   **
+   ** Remove the sequence number of the socket \a pclSocketV, the function is called when the
+   ** socket is disconnected.
+   */
+   void                 remove(const QObject * pclSocketV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubSockDataV   Pointer to raw CAN frame (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \return     Sequence number of the delivery stamp
+   */
+   static uint32_t      sequence(const uint8_t * pubSockDataV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubSockDataV   Pointer to raw CAN frame (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \param[in]  ulTimeV        Dispatch time, lower 32 bits of the monotonic clock
+   **
+   ** The function writes the dispatch time \a ulTimeV into the delivery stamp of the CAN frame
+   ** \a pubSockDataV and clears the sequence number.
+   */
+   static void          setTime(uint8_t * pubSockDataV, const uint32_t ulTimeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclSocketV     Pointer to socket
+   ** \param[in]  pubSockDataV   Pointer to raw CAN frame (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \return     Pointer to stamped copy of the CAN frame
+   **
+   ** The function copies the CAN frame \a pubSockDataV into an internal buffer and writes the next
+   ** sequence number of the socket \a pclSocketV into the copy. The CAN frame \a pubSockDataV is
+   ** not modified. The returned pointer is valid until the next call of this function.
+   */
+   const uint8_t *      stamp(const QObject * pclSocketV, const uint8_t * pubSockDataV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubSockDataV   Pointer to raw CAN frame (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \return     Dispatch time of the delivery stamp
+   */
+   static uint32_t      time(const uint8_t * pubSockDataV);
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // stamped copy of the CAN frame
+   //
+   uint8_t                             aubDataP[QCAN_FRAME_ARRAY_SIZE];
+
+   //---------------------------------------------------------------------------------------------------
+   // next sequence number of each socket, the key is the QLocalSocket, QWebSocket or QTcpSocket
+   //
+   QHash<const QObject *, uint32_t>    clSequenceP;
+};
+
+#endif   // QCAN_DELIVERY_STAMP_HPP_
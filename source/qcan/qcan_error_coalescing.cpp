@@ -0,0 +1,170 @@
+//====================================================================================================================//
+// File:          qcan_error_coalescing.cpp                                                                           //
+// Description:   QCAN classes - Coalescing of error frames                                                           //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include "qcan_error_coalescing.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanErrorCoalescing::QCanErrorCoalescing()                                                                         //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanErrorCoalescing::QCanErrorCoalescing()
+{
+   ulWindowP      = 0;
+   btRunP         = false;
+   ulRepeatP      = 0;
+   uqIngressP     = 0;
+   uqWindowStartP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanErrorCoalescing::isWindowElapsed()                                                                             //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanErrorCoalescing::isWindowElapsed(const uint64_t uqTimeV) const
+{
+   return ((uqTimeV - uqWindowStartP) >= (static_cast< uint64_t >(ulWindowP) * 1000000));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanErrorCoalescing::merge()                                                                                       //
+// merge error frame into the active run                                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanErrorCoalescing::merge(const QCanFrame & clErrorFrameR, const uint64_t uqIngressTimeV)
+{
+   //---------------------------------------------------------------------------------------------------
+   // an error frame which is identical to the last one is merged into the current run
+   //
+   if ((btRunP == true)                                                                &&
+       (clErrorFrameR.errorState()           == clErrorFrameP.errorState())           &&
+       (clErrorFrameR.errorType()            == clErrorFrameP.errorType())            &&
+       (clErrorFrameR.errorCounterReceive()  == clErrorFrameP.errorCounterReceive())  &&
+       (clErrorFrameR.errorCounterTransmit() == clErrorFrameP.errorCounterTransmit()))
+   {
+      if (ulRepeatP == 0)
+      {
+         clTimeFirstP = clErrorFrameR.timeStamp();
+      }
+      ulRepeatP++;
+      clErrorFrameP = clErrorFrameR;
+      uqIngressP    = uqIngressTimeV;
+
+      return (true);
+   }
+
+   return (false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanErrorCoalescing::restartWindow()                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanErrorCoalescing::restartWindow(const uint64_t uqTimeV)
+{
+   uqWindowStartP = uqTimeV;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanErrorCoalescing::setWindow()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanErrorCoalescing::setWindow(const uint32_t ulWindowV)
+{
+   ulWindowP = ulWindowV;
+   if (ulWindowP == 0)
+   {
+      stop();
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanErrorCoalescing::start()                                                                                       //
+// start a new run                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanErrorCoalescing::start(const QCanFrame & clErrorFrameR, const uint64_t uqIngressTimeV)
+{
+   btRunP         = true;
+   clErrorFrameP  = clErrorFrameR;
+   ulRepeatP      = 0;
+   uqIngressP     = uqIngressTimeV;
+   uqWindowStartP = uqIngressTimeV;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanErrorCoalescing::stop()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanErrorCoalescing::stop(void)
+{
+   btRunP    = false;
+   ulRepeatP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanErrorCoalescing::takeMerged()                                                                                  //
+// return merged error frame                                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanErrorCoalescing::takeMerged(QCanFrame & clErrorFrameR, uint64_t & uqIngressTimeR)
+{
+   if ((btRunP == false) || (ulRepeatP == 0))
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the last error frame of the run carries the number of merged frames and the time stamp of the
+   // first one
+   //
+   clErrorFrameR = clErrorFrameP;
+   clErrorFrameR.setErrorRepeatCount(ulRepeatP);
+   clErrorFrameR.setErrorTimeStampFirst(clTimeFirstP);
+   uqIngressTimeR = uqIngressP;
+   ulRepeatP      = 0;
+
+   return (true);
+}
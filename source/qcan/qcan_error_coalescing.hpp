@@ -0,0 +1,179 @@
+//====================================================================================================================//
+// File:          qcan_error_coalescing.hpp                                                                           //
+// Description:   QCAN classes - Coalescing of error frames                                                           //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_ERROR_COALESCING_HPP_
+#define QCAN_ERROR_COALESCING_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include "qcan_frame.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanErrorCoalescing
+** \brief   Coalescing of error frames
+**
+** The QCanErrorCoalescing class merges identical error frames received from a CAN interface (see
+** QCanNetwork::setErrorFrameCoalescing()). The first error frame of a run is dispatched by the
+** caller and starts the run (see start()). Following error frames with the same error state, error
+** type and error counters are merged into the run (see merge()), all other error frames end the run
+** and are dispatched immediately. The merged error frames are dispatched once per window as a single
+** error frame, which is returned by takeMerged().
+** <p>
+** The class is not thread-safe, the owner must serialise the access.
+*/
+class QCanErrorCoalescing
+{
+public:
+
+   QCanErrorCoalescing();
+
+   ~QCanErrorCoalescing() = default;
+
+   QCanErrorCoalescing(const QCanErrorCoalescing&) = delete;                // no copy constructor
+   QCanErrorCoalescing& operator=(const QCanErrorCoalescing&) = delete;     // no assignment operator
+   QCanErrorCoalescing(QCanErrorCoalescing&&) = delete;                     // no move constructor
+   QCanErrorCoalescing& operator=(QCanErrorCoalescing&&) = delete;          // no move operator
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if a run of error frames is active
+   */
+   inline bool          isRunning(void) const      { return (btRunP);                  }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  uqTimeV        Current time in nanoseconds
+   ** \return     \c true if the window of the run has elapsed
+   */
+   bool                 isWindowElapsed(const uint64_t uqTimeV) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clErrorFrameR  Error frame
+   ** \param[in]  uqIngressTimeV Ingress time in nanoseconds
+   ** \return     \c true if the error frame has been merged
+   **
+   ** The function merges the error frame \a clErrorFrameR into the active run, if it is identical
+   ** to the last error frame of the run. The function returns \c false without modification of the
+   ** run otherwise, the caller ends the run and dispatches the error frame immediately.
+   */
+   bool                 merge(const QCanFrame & clErrorFrameR, const uint64_t uqIngressTimeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of error frames merged since the last call of takeMerged()
+   */
+   inline uint32_t      pendingCount(void) const   { return (ulRepeatP);               }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  uqTimeV        Current time in nanoseconds
+   **
+   ** The function starts a new window of the active run at \a uqTimeV.
+   */
+   void                 restartWindow(const uint64_t uqTimeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulWindowV      Coalescing window in milliseconds
+   ** \see        window()
+   **
+   ** The value 0 disables the coalescing, the active run is stopped.
+   */
+   void                 setWindow(const uint32_t ulWindowV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clErrorFrameR  Error frame
+   ** \param[in]  uqIngressTimeV Ingress time in nanoseconds
+   **
+   ** The function starts a new run with the error frame \a clErrorFrameR, which is dispatched by the
+   ** caller. The window of the run starts at \a uqIngressTimeV.
+   */
+   void                 start(const QCanFrame & clErrorFrameR, const uint64_t uqIngressTimeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Stop the active run, merged error frames which have not been taken are discarded.
+   */
+   void                 stop(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[out] clErrorFrameR  Merged error frame
+   ** \param[out] uqIngressTimeR Ingress time of the last merged error frame in nanoseconds
+   ** \return     \c true if error frames have been merged
+   **
+   ** The function returns the last merged error frame, which carries the number of merged error
+   ** frames (see QCanFrame::errorRepeatCount()) and the time stamp of the first merged error frame
+   ** (see QCanFrame::errorTimeStampFirst()). The number of merged error frames is reset, the run is
+   ** not stopped.
+   */
+   bool                 takeMerged(QCanFrame & clErrorFrameR, uint64_t & uqIngressTimeR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Coalescing window in milliseconds
+   ** \see        setWindow()
+   */
+   inline uint32_t      window(void) const         { return (ulWindowP);               }
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // coalescing window in milliseconds, 0 if disabled
+   //
+   uint32_t                ulWindowP;
+
+   //---------------------------------------------------------------------------------------------------
+   // clErrorFrameP is the last error frame of the active run, the run holds ulRepeatP merged frames
+   // since the last call of takeMerged()
+   //
+   bool                    btRunP;
+   QCanFrame               clErrorFrameP;
+   uint32_t                ulRepeatP;
+   QCanTimeStamp           clTimeFirstP;
+   uint64_t                uqIngressP;
+   uint64_t                uqWindowStartP;
+};
+
+#endif   // QCAN_ERROR_COALESCING_HPP_
@@ -34,6 +34,10 @@
 
 #include <QCanFrame>
 
+#include <QtCore/QtEndian>
+
+#include <cstring>
+
 //----------------------------------------------------------------------------------------------------------------
 // These three files are included with an absolute file path to ensure that the correct platform definition is
 // passed to the CANpie structures and settings. The definitions for the CANpie message structure are done
@@ -370,6 +374,23 @@ uint8_t QCanFrame::errorCounterTransmit(void) const
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrame::errorRepeatCount()                                                                                      //
+// use data byte 4 .. 7 for storage                                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanFrame::errorRepeatCount(void) const
+{
+   uint32_t ulCountT = 0;
+
+   if ((frameType() == eFRAME_TYPE_ERROR) && ((ubMsgCtrlP & QCAN_FRAME_ERROR_REPEAT_FLAG) > 0))
+   {
+      ulCountT = qFromBigEndian<uint32_t>(&aubByteP[4]);
+   }
+
+   return (ulCountT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanFrame::errorState()                                                                                            //
 // use data byte 0 for storage                                                                                        //
@@ -407,6 +428,24 @@ bool QCanFrame::errorStateIndicator(void) const
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrame::errorTimeStampFirst()                                                                                   //
+// use data byte 8 .. 15 for storage                                                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanTimeStamp QCanFrame::errorTimeStampFirst(void) const
+{
+   QCanTimeStamp clTimeStampT;
+
+   if ((frameType() == eFRAME_TYPE_ERROR) && ((ubMsgCtrlP & QCAN_FRAME_ERROR_REPEAT_FLAG) > 0))
+   {
+      clTimeStampT.setSeconds(qFromBigEndian<uint32_t>(&aubByteP[8]));
+      clTimeStampT.setNanoSeconds(qFromBigEndian<uint32_t>(&aubByteP[12]));
+   }
+
+   return (clTimeStampT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanFrame::errorType()                                                                                             //
 // use data byte 1 for storage                                                                                        //
@@ -465,91 +504,65 @@ bool QCanFrame::fromByteArray(const QByteArray &clByteArrayR)
    bool btResultT = false;
 
    //---------------------------------------------------------------------------------------------------
-   // test size of byte array and marker at the end
+   // test size of byte array, the marker at the end is checked by fromRawData()
    //
-   if ( (clByteArrayR.size() == QCAN_FRAME_ARRAY_SIZE) && 
-        (static_cast< uint8_t >(clByteArrayR[94]) == 0xCA)           && 
-        (static_cast< uint8_t >(clByteArrayR[95]) == 0x01) )
+   if (clByteArrayR.size() == QCAN_FRAME_ARRAY_SIZE)
    {
-      //---------------------------------------------------------------------------------------------------
-      // structure seems to be valid, now start copying the contents,
-      // start with the identifier value
-      //---------------------------------------------------------------------------------------------------
+      btResultT = fromRawData(reinterpret_cast< const uint8_t * >(clByteArrayR.constData()));
+   }
+
+   return (btResultT);
+}
+
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrame::fromRawData()                                                                                           //
+// Convert raw data to a QCanFrame object, multi-byte fields are read as unaligned big-endian words                   //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanFrame::fromRawData(const uint8_t * pubDataV)
+{
+   bool btResultT = false;
+
+   //---------------------------------------------------------------------------------------------------
+   // test pointer and marker at the end
+   //
+   if ( (pubDataV != nullptr) && (pubDataV[94] == 0xCA) && (pubDataV[95] == 0x01) )
+   {
       //---------------------------------------------------------------------------------------------------
       // set identifier field from byte 0 .. 3, MSB first
       //
-      ulIdentifierP = static_cast< uint8_t >(clByteArrayR[0]);
-      ulIdentifierP = ulIdentifierP << 8;
-      ulIdentifierP = ulIdentifierP + static_cast< uint8_t >(clByteArrayR[1]);
-      ulIdentifierP = ulIdentifierP << 8;
-      ulIdentifierP = ulIdentifierP + static_cast< uint8_t >(clByteArrayR[2]);
-      ulIdentifierP = ulIdentifierP << 8;
-      ulIdentifierP = ulIdentifierP + static_cast< uint8_t >(clByteArrayR[3]);
+      ulIdentifierP = qFromBigEndian<uint32_t>(pubDataV + 0);
 
       //---------------------------------------------------------------------------------------------------
       // set DLC field from byte 4
       //
-      ubMsgDlcP = static_cast< uint8_t >(clByteArrayR[4]);
+      ubMsgDlcP = pubDataV[4];
 
       //---------------------------------------------------------------------------------------------------
       // set message control field from byte 5
       //
-      ubMsgCtrlP = static_cast< uint8_t >(clByteArrayR[5]);
+      ubMsgCtrlP = pubDataV[5];
 
       //---------------------------------------------------------------------------------------------------
       // set message data field from byte 6 .. 69
       //
-      for (uint8_t ubPosT = 0; ubPosT < QCAN_MSG_DATA_MAX; ubPosT++)
-      {
-         aubByteP[ubPosT] = static_cast< uint8_t >(clByteArrayR[6 + ubPosT]);
-      }
+      memcpy(&aubByteP[0], pubDataV + 6, QCAN_MSG_DATA_MAX);
 
       //---------------------------------------------------------------------------------------------------
       // set message time-stamp field from byte 70 .. 77, MSB first
       //
-      uint32_t ulTimeValT = 0;
-
-      ulTimeValT  = static_cast< uint8_t >(clByteArrayR[70]);
-      ulTimeValT  = ulTimeValT << 8;
-      ulTimeValT += static_cast< uint8_t >(clByteArrayR[71]);
-      ulTimeValT  = ulTimeValT << 8;
-      ulTimeValT += static_cast< uint8_t >(clByteArrayR[72]);
-      ulTimeValT  = ulTimeValT << 8;
-      ulTimeValT += static_cast< uint8_t >(clByteArrayR[73]);
-      clMsgTimeP.setSeconds(ulTimeValT);
-
-      ulTimeValT  = 0;
-      ulTimeValT  = static_cast< uint8_t >(clByteArrayR[74]);
-      ulTimeValT  = ulTimeValT << 8;
-      ulTimeValT += static_cast< uint8_t >(clByteArrayR[75]);
-      ulTimeValT  = ulTimeValT << 8;
-      ulTimeValT += static_cast< uint8_t >(clByteArrayR[76]);
-      ulTimeValT  = ulTimeValT << 8;
-      ulTimeValT += static_cast< uint8_t >(clByteArrayR[77]);
-      clMsgTimeP.setNanoSeconds(ulTimeValT);
+      clMsgTimeP.setSeconds(qFromBigEndian<uint32_t>(pubDataV + 70));
+      clMsgTimeP.setNanoSeconds(qFromBigEndian<uint32_t>(pubDataV + 74));
 
       //---------------------------------------------------------------------------------------------------
       // set message user field from byte 78 .. 81, MSB first
       //
-      ulMsgUserP  = static_cast< uint8_t >(clByteArrayR[78]);
-      ulMsgUserP  = ulMsgUserP << 8;
-      ulMsgUserP += static_cast< uint8_t >(clByteArrayR[79]);
-      ulMsgUserP  = ulMsgUserP << 8;
-      ulMsgUserP += static_cast< uint8_t >(clByteArrayR[80]);
-      ulMsgUserP  = ulMsgUserP << 8;
-      ulMsgUserP += static_cast< uint8_t >(clByteArrayR[81]);
+      ulMsgUserP   = qFromBigEndian<uint32_t>(pubDataV + 78);
 
       //---------------------------------------------------------------------------------------------------
       // set message marker field from byte 82 .. 85, MSB first
       //
-      ulMsgMarkerP   = static_cast< uint8_t >(clByteArrayR[82]);
-      ulMsgMarkerP   = ulMsgMarkerP << 8;
-      ulMsgMarkerP  += static_cast< uint8_t >(clByteArrayR[83]);
-      ulMsgMarkerP   = ulMsgMarkerP << 8;
-      ulMsgMarkerP  += static_cast< uint8_t >(clByteArrayR[84]);
-      ulMsgMarkerP   = ulMsgMarkerP << 8;
-      ulMsgMarkerP  += static_cast< uint8_t >(clByteArrayR[85]);
+      ulMsgMarkerP = qFromBigEndian<uint32_t>(pubDataV + 82);
 
       btResultT = true;
    }
@@ -945,6 +958,20 @@ void QCanFrame::setErrorCounterTransmit(const uint8_t &ubErrorCntR)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrame::setErrorRepeatCount()                                                                                   //
+// use data byte 4 .. 7 for storage                                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanFrame::setErrorRepeatCount(const uint32_t ulCountV)
+{
+   if (frameType() == eFRAME_TYPE_ERROR)
+   {
+      qToBigEndian<uint32_t>(ulCountV, &aubByteP[4]);
+      ubMsgCtrlP |= QCAN_FRAME_ERROR_REPEAT_FLAG;
+   }
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanFrame::setErrorState()                                                                                         //
 // use data byte 0 for storage                                                                                        //
@@ -975,6 +1002,20 @@ void QCanFrame::setErrorStateIndicator(const bool &btEsiR)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrame::setErrorTimeStampFirst()                                                                                //
+// use data byte 8 .. 15 for storage                                                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanFrame::setErrorTimeStampFirst(const QCanTimeStamp & clTimeStampR)
+{
+   if (frameType() == eFRAME_TYPE_ERROR)
+   {
+      qToBigEndian<uint32_t>(clTimeStampR.seconds(),     &aubByteP[8]);
+      qToBigEndian<uint32_t>(clTimeStampR.nanoSeconds(), &aubByteP[12]);
+   }
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanFrame::setErrorType()                                                                                          //
 // use data byte 1 for storage                                                                                        //
@@ -1060,6 +1101,7 @@ void QCanFrame::setFrameType(const FrameType_e &ubTypeR)
    }
 
    memset(&aubByteP[0], 0x00, QCAN_MSG_DATA_MAX);
+   ubMsgCtrlP &= (~QCAN_FRAME_ERROR_REPEAT_FLAG);
 }
 
 
@@ -1131,80 +1173,73 @@ void QCanFrame::setUser(const uint32_t &ulUserValueR)
 QByteArray QCanFrame::toByteArray() const
 {
    //----------------------------------------------------------------
-   // setup a defined length and clear contents
+   // setup a defined length and fill contents
    //
    QByteArray clByteArrayT(QCAN_FRAME_ARRAY_SIZE, 0x00);
 
+   toRawData(reinterpret_cast< uint8_t * >(clByteArrayT.data()));
+
+   return (clByteArrayT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrame::toRawData()                                                                                             //
+// multi-byte fields are written as unaligned big-endian words                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanFrame::toRawData(uint8_t * pubDataV) const
+{
+   if (pubDataV == nullptr)
+   {
+      return;
+   }
+
    //----------------------------------------------------------------
    // place identifier field in byte 0 .. 3, MSB first
    //
-   clByteArrayT[0] = static_cast< char >(ulIdentifierP >> 24);
-   clByteArrayT[1] = static_cast< char >(ulIdentifierP >> 16);
-   clByteArrayT[2] = static_cast< char >(ulIdentifierP >> 8);
-   clByteArrayT[3] = static_cast< char >(ulIdentifierP >> 0);
+   qToBigEndian<uint32_t>(ulIdentifierP, pubDataV + 0);
 
    //----------------------------------------------------------------
    // place message DLC field in byte 4
    //
-   clByteArrayT[4] = static_cast< char >(ubMsgDlcP);
+   pubDataV[4] = ubMsgDlcP;
 
    //----------------------------------------------------------------
    // place message control field in byte 5
    //
-   clByteArrayT[5] = static_cast< char >(ubMsgCtrlP);
+   pubDataV[5] = ubMsgCtrlP;
 
    //----------------------------------------------------------------
    // place message data field in byte 6 .. 69
    //
-   for (uint8_t ubPosT = 0; ubPosT < QCAN_MSG_DATA_MAX; ubPosT++)
-   {
-      clByteArrayT[6 + ubPosT] = static_cast< char >(aubByteP[ubPosT]);
-   }
+   memcpy(pubDataV + 6, &aubByteP[0], QCAN_MSG_DATA_MAX);
 
    //----------------------------------------------------------------
    // place message timestamp field in byte 70 .. 77, MSB first
    //
-   uint32_t ulTimeValT = 0;
-
-   ulTimeValT = clMsgTimeP.seconds();
-   clByteArrayT[70] = static_cast< char >(ulTimeValT >> 24);
-   clByteArrayT[71] = static_cast< char >(ulTimeValT >> 16);
-   clByteArrayT[72] = static_cast< char >(ulTimeValT >> 8);
-   clByteArrayT[73] = static_cast< char >(ulTimeValT >> 0);
-
-   ulTimeValT = clMsgTimeP.nanoSeconds();
-   clByteArrayT[74] = static_cast< char >(ulTimeValT >> 24);
-   clByteArrayT[75] = static_cast< char >(ulTimeValT >> 16);
-   clByteArrayT[76] = static_cast< char >(ulTimeValT >> 8);
-   clByteArrayT[77] = static_cast< char >(ulTimeValT >> 0);
+   qToBigEndian<uint32_t>(clMsgTimeP.seconds(),     pubDataV + 70);
+   qToBigEndian<uint32_t>(clMsgTimeP.nanoSeconds(), pubDataV + 74);
 
    //----------------------------------------------------------------
    // place message user field in byte 78 .. 81, MSB first
    //
-   clByteArrayT[78] = static_cast< char >(ulMsgUserP >> 24);
-   clByteArrayT[79] = static_cast< char >(ulMsgUserP >> 16);
-   clByteArrayT[80] = static_cast< char >(ulMsgUserP >> 8);
-   clByteArrayT[81] = static_cast< char >(ulMsgUserP >> 0);
+   qToBigEndian<uint32_t>(ulMsgUserP,   pubDataV + 78);
 
    //----------------------------------------------------------------
    // place message marker field in byte 82 .. 85, MSB first
    //
-   clByteArrayT[82] = static_cast< char >(ulMsgMarkerP >> 24);
-   clByteArrayT[83] = static_cast< char >(ulMsgMarkerP >> 16);
-   clByteArrayT[84] = static_cast< char >(ulMsgMarkerP >> 8);
-   clByteArrayT[85] = static_cast< char >(ulMsgMarkerP >> 0);
+   qToBigEndian<uint32_t>(ulMsgMarkerP, pubDataV + 82);
 
    //----------------------------------------------------------------
    // byte 86 .. 93 (i.e. 8 bytes) are not used, set to 0
-   //----------------------------------------------------------------
+   //
+   memset(pubDataV + 86, 0x00, 8);
 
    //----------------------------------------------------------------
    // set marker at end of byte array
    //
-   clByteArrayT[94] = static_cast< char > (0xCA);
-   clByteArrayT[95] = static_cast< char > (0x01);
-
-   return (clByteArrayT);
+   pubDataV[94] = 0xCA;
+   pubDataV[95] = 0x01;
 }
 
 
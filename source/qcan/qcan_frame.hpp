@@ -93,6 +93,24 @@ constexpr uint8_t    QCAN_MSG_DATA_MAX    = 64;
 
 #define  QCAN_FRAME_TIME_STAMP_POS   70
 
+//----------------------------------------------------------------------------------------------------------------
+// Position of the delivery stamp inside the byte array (see #QCAN_DELIVERY_STAMP_TIME), the bytes are
+// not used by QCanFrame
+//
+#define  QCAN_FRAME_DELIVERY_STAMP_POS 86
+
+//----------------------------------------------------------------------------------------------------------------
+// Position of the repeat count of an error frame inside the byte array (see QCanFrame::errorRepeatCount()),
+// the value is stored in data byte 4 .. 7 and only valid if #QCAN_FRAME_ERROR_REPEAT_FLAG is set
+//
+#define  QCAN_FRAME_ERROR_REPEAT_POS   10
+
+//----------------------------------------------------------------------------------------------------------------
+// Flag inside the message control field (byte 5 of the byte array), which marks an error frame coalesced by
+// the server (see QCanFrame::setErrorRepeatCount()), the bit is not used by the CANpie message control field
+//
+#define  QCAN_FRAME_ERROR_REPEAT_FLAG  0x20
+
 //----------------------------------------------------------------------------------------------------------------
 // Define a forward reference to the structure CpCanMsg_s, which is defined inside the header canpie.h
 //
@@ -153,6 +171,20 @@ struct CpCanMsg_s;
 ** clErrorFrameT.setErrorCounterReceive(32);
 ** clErrorFrameT.setErrorCounterTransmit(64);
 ** \endcode
+**
+** The data bytes of an error frame are used as follows:
+** <ul>
+** <li>data byte 0: error state</li>
+** <li>data byte 1: error type</li>
+** <li>data byte 2: receive error counter</li>
+** <li>data byte 3: transmit error counter</li>
+** <li>data byte 4 .. 7: number of coalesced error frames (errorRepeatCount())</li>
+** <li>data byte 8 .. 15: time stamp of the first coalesced error frame (errorTimeStampFirst())</li>
+** </ul>
+** The data bytes 4 .. 15 are only evaluated for an error frame which has been coalesced by the server
+** (see QCanNetwork::setErrorFrameCoalescing()), such an error frame is marked by the flag
+** #QCAN_FRAME_ERROR_REPEAT_FLAG inside the message control field. The data bytes 4 .. 15 of other error
+** frames are not interpreted.
 ** <p>
 */
 class QCanFrame
@@ -394,6 +426,19 @@ public:
    uint8_t     errorCounterTransmit(void) const;
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of coalesced error frames
+   ** \see        setErrorRepeatCount(), errorTimeStampFirst()
+   **
+   ** The function returns the number of identical error frames which are represented by this error
+   ** frame (frame type QCanFrame::eFRAME_TYPE_ERROR). The value is 0 for an error frame which has not
+   ** been coalesced by the server (see QCanNetwork::setErrorFrameCoalescing()) and for a data frame,
+   ** the data bytes 4 .. 7 of such frames are not evaluated.
+   */
+   uint32_t    errorRepeatCount(void) const;
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return     Current error state
@@ -415,6 +460,18 @@ public:
    bool        errorStateIndicator(void) const;
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Time stamp of the first coalesced error frame
+   ** \see        errorRepeatCount()
+   **
+   ** The function returns the time stamp of the first error frame which is represented by this error
+   ** frame, the time stamp of the last error frame is given by timeStamp(). The value is only valid
+   ** if errorRepeatCount() is not 0.
+   */
+   QCanTimeStamp  errorTimeStampFirst(void) const;
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return     Error type
@@ -456,6 +513,19 @@ public:
    bool        fromByteArray(const QByteArray & clByteArrayR);
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubDataV       Pointer to CAN frame data
+   ** \return     Conversion result
+   ** \see        toRawData()
+   **
+   ** The function converts #QCAN_FRAME_ARRAY_SIZE bytes of raw data to a QCanFrame object, the data
+   ** has the same layout as the byte array used by fromByteArray(). The pointer \a pubDataV does not
+   ** require any alignment. On success, the function returns \c true, otherwise \c false.
+   */
+   bool        fromRawData(const uint8_t * pubDataV);
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  ptsCanMsgV   Pointer to CANpie message structure
@@ -632,6 +702,29 @@ public:
    void        setErrorType(ErrorType_e ubTypeV);
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulCountV       Number of coalesced error frames
+   ** \see        errorRepeatCount()
+   **
+   ** This functions sets the number of identical error frames which are represented by this error
+   ** frame and marks the error frame as coalesced (#QCAN_FRAME_ERROR_REPEAT_FLAG). For a data frame
+   ** the function has no impact.
+   */
+   void        setErrorRepeatCount(const uint32_t ulCountV);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clTimeStampR   Time stamp of the first coalesced error frame
+   ** \see        errorTimeStampFirst()
+   **
+   ** This functions sets the time stamp of the first error frame which is represented by this error
+   ** frame. For a data frame the function has no impact.
+   */
+   void        setErrorTimeStampFirst(const QCanTimeStamp & clTimeStampR);
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  btEsiR         Value of ESI bit
@@ -748,6 +841,18 @@ public:
    QByteArray  toByteArray(void) const;
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[out] pubDataV       Pointer to CAN frame data
+   ** \see        fromRawData()
+   **
+   ** The function converts a QCanFrame object to raw data with the same layout as the byte array
+   ** returned by toByteArray(). The buffer \a pubDataV must provide space for #QCAN_FRAME_ARRAY_SIZE
+   ** bytes, it does not require any alignment.
+   */
+   void        toRawData(uint8_t * pubDataV) const;
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  ptsCanMsgV   Pointer to CANpie message structure
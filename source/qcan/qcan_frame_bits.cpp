@@ -0,0 +1,468 @@
+//====================================================================================================================//
+// File:          qcan_frame_bits.cpp                                                                                 //
+// Description:   QCAN classes - Bit length of CAN frames                                                             //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QtEndian>
+
+#include "qcan_frame_bits.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------------------------------
+// Number of bits after the CRC field which are not subject to bit stuffing: CRC delimiter (1),
+// ACK slot (1), ACK delimiter (1), end of frame (7) and intermission (3)
+//
+constexpr uint32_t   FRAME_TRAILER_BITS   = 13;
+
+//------------------------------------------------------------------------------------------------------
+// CRC-15 polynomial for Classic CAN: x^15 + x^14 + x^10 + x^8 + x^7 + x^4 + x^3 + 1
+//
+constexpr uint16_t   CRC15_POLYNOMIAL     = 0x4599;
+
+//------------------------------------------------------------------------------------------------------
+// Bit stuffing is described by a state value: bit 3 holds the value of the last bit on the bus,
+// bit 0 .. 2 hold the number of consecutive bits with this value (0 .. 4). The initial state is 0.
+//
+constexpr uint8_t    STUFF_STATE_MAX      = 16;
+constexpr uint8_t    STUFF_STATE_MASK     = 0x0F;
+constexpr uint8_t    STUFF_COUNT_SHIFT    = 4;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Static variables                                                                                                   **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+static const uint8_t  aubDlc2DataSize[] = { 0,  1,  2,  3,  4,  5,  6,  7,
+                                            8, 12, 16, 20, 24, 32, 48, 64  };
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Static functions                                                                                                   **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//--------------------------------------------------------------------------------------------------------------------//
+// stuffBit()                                                                                                         //
+// process one bit, return 1 if a stuff bit is inserted                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+static constexpr uint8_t stuffBit(uint8_t & ubStateR, const uint8_t ubBitV)
+{
+   uint8_t  ubValueT = (ubStateR >> 3) & 0x01;
+   uint8_t  ubRunT   = ubStateR & 0x07;
+   uint8_t  ubStuffT = 0;
+
+   if ((ubRunT > 0) && (ubBitV == ubValueT))
+   {
+      ubRunT++;
+   }
+   else
+   {
+      ubValueT = ubBitV;
+      ubRunT   = 1;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // after 5 consecutive bits of the same value a bit of the opposite value is inserted, this bit
+   // is the first bit of the next sequence
+   //
+   if (ubRunT == 5)
+   {
+      ubStuffT = 1;
+      ubValueT = ubValueT ^ 0x01;
+      ubRunT   = 1;
+   }
+
+   ubStateR = static_cast< uint8_t >((ubValueT << 3) | ubRunT);
+
+   return (ubStuffT);
+}
+
+
+//------------------------------------------------------------------------------------------------------
+// Lookup table for bit stuffing: for each state and each byte value the table holds the new state
+// (bit 0 .. 3) and the number of inserted stuff bits (bit 4 .. 5)
+//
+typedef struct StuffTable_s {
+   uint8_t  aubEntry[STUFF_STATE_MAX][256];
+} StuffTable_ts;
+
+//--------------------------------------------------------------------------------------------------------------------//
+// buildStuffTable()                                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+static constexpr StuffTable_ts buildStuffTable(void)
+{
+   StuffTable_ts  tsTableT = { };
+
+   for (uint32_t ulStateT = 0; ulStateT < STUFF_STATE_MAX; ulStateT++)
+   {
+      for (uint32_t ulByteT = 0; ulByteT < 256; ulByteT++)
+      {
+         uint8_t  ubStateT = static_cast< uint8_t >(ulStateT);
+         uint8_t  ubCountT = 0;
+
+         for (int32_t slBitT = 7; slBitT >= 0; slBitT--)
+         {
+            ubCountT += stuffBit(ubStateT, static_cast< uint8_t >((ulByteT >> slBitT) & 0x01));
+         }
+         tsTableT.aubEntry[ulStateT][ulByteT] = static_cast< uint8_t >((ubCountT << STUFF_COUNT_SHIFT) |
+                                                                        ubStateT);
+      }
+   }
+
+   return (tsTableT);
+}
+
+static constexpr StuffTable_ts tsStuffTableS = buildStuffTable();
+
+
+//------------------------------------------------------------------------------------------------------
+// Lookup table for the CRC-15 calculation, one byte per step
+//
+typedef struct Crc15Table_s {
+   uint16_t auwEntry[256];
+} Crc15Table_ts;
+
+//--------------------------------------------------------------------------------------------------------------------//
+// buildCrc15Table()                                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+static constexpr Crc15Table_ts buildCrc15Table(void)
+{
+   Crc15Table_ts  tsTableT = { };
+
+   for (uint32_t ulByteT = 0; ulByteT < 256; ulByteT++)
+   {
+      uint16_t uwCrcT = static_cast< uint16_t >(ulByteT << 7);
+
+      for (int32_t slBitT = 0; slBitT < 8; slBitT++)
+      {
+         if ((uwCrcT & 0x4000) > 0)
+         {
+            uwCrcT = static_cast< uint16_t >((uwCrcT << 1) ^ CRC15_POLYNOMIAL);
+         }
+         else
+         {
+            uwCrcT = static_cast< uint16_t >(uwCrcT << 1);
+         }
+      }
+      tsTableT.auwEntry[ulByteT] = uwCrcT & 0x7FFF;
+   }
+
+   return (tsTableT);
+}
+
+static constexpr Crc15Table_ts tsCrc15TableS = buildCrc15Table();
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// crc15Bits()                                                                                                        //
+// CRC-15 over the ulNumV least significant bits of uqBitsV, MSB first                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+static uint16_t crc15Bits(uint16_t uwCrcV, const uint64_t uqBitsV, const uint32_t ulNumV)
+{
+   for (int32_t slBitT = static_cast< int32_t >(ulNumV) - 1; slBitT >= 0; slBitT--)
+   {
+      uint16_t uwNextT = static_cast< uint16_t >(((uqBitsV >> slBitT) & 0x01) ^ ((uwCrcV >> 14) & 0x01));
+
+      uwCrcV = static_cast< uint16_t >((uwCrcV << 1) & 0x7FFF);
+      if (uwNextT > 0)
+      {
+         uwCrcV = uwCrcV ^ CRC15_POLYNOMIAL;
+      }
+   }
+
+   return (uwCrcV);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// crc15Bytes()                                                                                                       //
+// CRC-15 over a byte array                                                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+static uint16_t crc15Bytes(uint16_t uwCrcV, const uint8_t * pubDataV, const uint32_t ulSizeV)
+{
+   for (uint32_t ulIdxT = 0; ulIdxT < ulSizeV; ulIdxT++)
+   {
+      uwCrcV = static_cast< uint16_t >(((uwCrcV << 8) ^
+                                        tsCrc15TableS.auwEntry[((uwCrcV >> 7) ^ pubDataV[ulIdxT]) & 0xFF]) & 0x7FFF);
+   }
+
+   return (uwCrcV);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// stuffBits()                                                                                                        //
+// stuff bits for the ulNumV least significant bits of uqBitsV, MSB first                                             //
+//--------------------------------------------------------------------------------------------------------------------//
+static uint32_t stuffBits(uint8_t & ubStateR, const uint64_t uqBitsV, uint32_t ulNumV)
+{
+   uint32_t ulCountT = 0;
+   uint8_t  ubEntryT;
+
+   while (ulNumV >= 8)
+   {
+      ulNumV   = ulNumV - 8;
+      ubEntryT = tsStuffTableS.aubEntry[ubStateR][(uqBitsV >> ulNumV) & 0xFF];
+      ulCountT = ulCountT + (ubEntryT >> STUFF_COUNT_SHIFT);
+      ubStateR = ubEntryT & STUFF_STATE_MASK;
+   }
+
+   while (ulNumV > 0)
+   {
+      ulNumV   = ulNumV - 1;
+      ulCountT = ulCountT + stuffBit(ubStateR, static_cast< uint8_t >((uqBitsV >> ulNumV) & 0x01));
+   }
+
+   return (ulCountT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// stuffBytes()                                                                                                       //
+// stuff bits for a byte array                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+static uint32_t stuffBytes(uint8_t & ubStateR, const uint8_t * pubDataV, const uint32_t ulSizeV)
+{
+   uint32_t ulCountT = 0;
+   uint8_t  ubEntryT;
+
+   for (uint32_t ulIdxT = 0; ulIdxT < ulSizeV; ulIdxT++)
+   {
+      ubEntryT = tsStuffTableS.aubEntry[ubStateR][pubDataV[ulIdxT]];
+      ulCountT = ulCountT + (ubEntryT >> STUFF_COUNT_SHIFT);
+      ubStateR = ubEntryT & STUFF_STATE_MASK;
+   }
+
+   return (ulCountT);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrameBits::busTime()                                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint64_t QCanFrameBits::busTime(const QCanFrame & clFrameR, const int32_t slNomBitRateV,
+                                const int32_t slDatBitRateV)
+{
+   uint8_t  aubDataT[QCAN_FRAME_ARRAY_SIZE];
+   uint32_t ulNomBitsT;
+   uint32_t ulDatBitsT;
+
+   clFrameR.toRawData(&aubDataT[0]);
+   count(&aubDataT[0], ulNomBitsT, ulDatBitsT);
+
+   return (busTime(ulNomBitsT, ulDatBitsT, slNomBitRateV, slDatBitRateV));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrameBits::busTime()                                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint64_t QCanFrameBits::busTime(const uint64_t uqNomBitsV, const uint64_t uqDatBitsV,
+                                const int32_t slNomBitRateV, const int32_t slDatBitRateV)
+{
+   uint64_t uqTimeT;
+
+   if (slNomBitRateV <= 0)
+   {
+      return (0);
+   }
+
+   uqTimeT = (uqNomBitsV * 1000000000ULL) / static_cast< uint64_t >(slNomBitRateV);
+   if (slDatBitRateV > 0)
+   {
+      uqTimeT = uqTimeT + ((uqDatBitsV * 1000000000ULL) / static_cast< uint64_t >(slDatBitRateV));
+   }
+   else
+   {
+      uqTimeT = uqTimeT + ((uqDatBitsV * 1000000000ULL) / static_cast< uint64_t >(slNomBitRateV));
+   }
+
+   return (uqTimeT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrameBits::count()                                                                                             //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanFrameBits::count(const uint8_t * pubDataV, uint32_t & ulNomBitsR, uint32_t & ulDatBitsR)
+{
+   uint64_t uqHeaderT;
+   uint32_t ulHeaderBitsT;
+   uint32_t ulIdentifierT;
+   uint32_t ulDataSizeT;
+   uint32_t ulStuffT;
+   uint16_t uwCrcT;
+   uint8_t  ubCtrlT;
+   uint8_t  ubDlcT;
+   uint8_t  ubStateT = 0;
+
+   ulNomBitsR = 0;
+   ulDatBitsR = 0;
+
+   //---------------------------------------------------------------------------------------------------
+   // only data frames are evaluated
+   //
+   if ((pubDataV[0] & 0xE0) != 0x00)
+   {
+      return (0);
+   }
+
+   ulIdentifierT = qFromBigEndian<uint32_t>(pubDataV) & QCAN_FRAME_ID_MASK_EXT;
+   ubDlcT        = pubDataV[4] & 0x0F;
+   ubCtrlT       = pubDataV[5];
+
+   if ((ubCtrlT & 0x02) == 0)
+   {
+      //-------------------------------------------------------------------------------------------
+      // Classic CAN: a remote frame has no data field, the DLC is limited to 8 bytes
+      //
+      ulDataSizeT = ubDlcT;
+      if (ulDataSizeT > 8)
+      {
+         ulDataSizeT = 8;
+      }
+      if ((ubCtrlT & 0x04) > 0)
+      {
+         ulDataSizeT = 0;
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // header from SOF up to DLC
+      // standard: SOF, ID(11), RTR, IDE, r0, DLC(4)
+      // extended: SOF, ID(28..18), SRR, IDE, ID(17..0), RTR, r1, r0, DLC(4)
+      //
+      if ((ubCtrlT & 0x01) == 0)
+      {
+         uqHeaderT     = static_cast< uint64_t >(ulIdentifierT & QCAN_FRAME_ID_MASK_STD) << 7;
+         uqHeaderT    |= static_cast< uint64_t >((ubCtrlT >> 2) & 0x01) << 6;
+         uqHeaderT    |= ubDlcT;
+         ulHeaderBitsT = 19;
+      }
+      else
+      {
+         uqHeaderT     = static_cast< uint64_t >(ulIdentifierT >> 18) << 27;
+         uqHeaderT    |= static_cast< uint64_t >(0x03) << 25;
+         uqHeaderT    |= static_cast< uint64_t >(ulIdentifierT & 0x0003FFFF) << 7;
+         uqHeaderT    |= static_cast< uint64_t >((ubCtrlT >> 2) & 0x01) << 6;
+         uqHeaderT    |= ubDlcT;
+         ulHeaderBitsT = 39;
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // the CRC-15 is calculated over the unstuffed bits, it is subject to bit stuffing itself
+      //
+      uwCrcT   = crc15Bits(0, uqHeaderT, ulHeaderBitsT);
+      uwCrcT   = crc15Bytes(uwCrcT, pubDataV + 6, ulDataSizeT);
+
+      ulStuffT = stuffBits(ubStateT, uqHeaderT, ulHeaderBitsT);
+      ulStuffT = ulStuffT + stuffBytes(ubStateT, pubDataV + 6, ulDataSizeT);
+      ulStuffT = ulStuffT + stuffBits(ubStateT, uwCrcT, 15);
+
+      ulNomBitsR = ulHeaderBitsT + (ulDataSizeT * 8) + 15 + ulStuffT + FRAME_TRAILER_BITS;
+   }
+   else
+   {
+      ulDataSizeT = aubDlc2DataSize[ubDlcT];
+
+      //-------------------------------------------------------------------------------------------
+      // arbitration phase from SOF up to BRS
+      // standard: SOF, ID(11), RRS, IDE, FDF, res, BRS
+      // extended: SOF, ID(28..18), SRR, IDE, ID(17..0), RRS, FDF, res, BRS
+      //
+      if ((ubCtrlT & 0x01) == 0)
+      {
+         uqHeaderT     = static_cast< uint64_t >(ulIdentifierT & QCAN_FRAME_ID_MASK_STD) << 5;
+         uqHeaderT    |= static_cast< uint64_t >(0x01) << 2;
+         uqHeaderT    |= static_cast< uint64_t >((ubCtrlT >> 6) & 0x01);
+         ulHeaderBitsT = 17;
+      }
+      else
+      {
+         uqHeaderT     = static_cast< uint64_t >(ulIdentifierT >> 18) << 24;
+         uqHeaderT    |= static_cast< uint64_t >(0x03) << 22;
+         uqHeaderT    |= static_cast< uint64_t >(ulIdentifierT & 0x0003FFFF) << 4;
+         uqHeaderT    |= static_cast< uint64_t >(0x01) << 2;
+         uqHeaderT    |= static_cast< uint64_t >((ubCtrlT >> 6) & 0x01);
+         ulHeaderBitsT = 36;
+      }
+
+      ulStuffT   = stuffBits(ubStateT, uqHeaderT, ulHeaderBitsT);
+      ulNomBitsR = ulHeaderBitsT + ulStuffT + FRAME_TRAILER_BITS;
+
+      //-------------------------------------------------------------------------------------------
+      // data phase: ESI, DLC(4) and data field with dynamic stuff bits, followed by the stuff
+      // count (4), the CRC-17 / CRC-21 and the fixed stuff bits
+      //
+      uqHeaderT  = (static_cast< uint64_t >((ubCtrlT >> 7) & 0x01) << 4) | ubDlcT;
+      ulStuffT   = stuffBits(ubStateT, uqHeaderT, 5);
+      ulStuffT   = ulStuffT + stuffBytes(ubStateT, pubDataV + 6, ulDataSizeT);
+
+      ulDatBitsR = 5 + (ulDataSizeT * 8) + ulStuffT + 4;
+      if (ulDataSizeT <= 16)
+      {
+         ulDatBitsR = ulDatBitsR + 17 + 6;
+      }
+      else
+      {
+         ulDatBitsR = ulDatBitsR + 21 + 7;
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // without bit rate switch all bits are transmitted with the nominal bit rate
+      //
+      if ((ubCtrlT & 0x40) == 0)
+      {
+         ulNomBitsR = ulNomBitsR + ulDatBitsR;
+         ulDatBitsR = 0;
+      }
+   }
+
+   return (ulNomBitsR + ulDatBitsR);
+}
@@ -0,0 +1,112 @@
+//====================================================================================================================//
+// File:          qcan_frame_bits.hpp                                                                                 //
+// Description:   QCAN classes - Bit length of CAN frames                                                             //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_FRAME_BITS_HPP_
+#define QCAN_FRAME_BITS_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include "qcan_frame.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanFrameBits
+** \brief   Bit length of CAN frames on the bus
+**
+** The QCanFrameBits class calculates the exact number of bits a CAN frame occupies on the bus, from the
+** start of frame bit up to the end of the intermission field. The stuff bits are calculated from the
+** actual identifier and payload, for Classic CAN frames the CRC-15 is calculated because it is also
+** subject to bit stuffing. For CAN FD frames the stuff count field, the CRC-17 / CRC-21 and the fixed
+** stuff bits are considered.
+** <p>
+** CAN FD frames with bit rate switch (BRS) are split into bits of the arbitration phase, transmitted
+** with the nominal bit rate, and bits of the data phase, transmitted with the data bit rate. The data
+** phase starts with the ESI bit and ends with the last bit of the CRC field.
+** <p>
+** The class only provides static methods.
+*/
+class QCanFrameBits
+{
+public:
+
+   QCanFrameBits() = delete;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clFrameR       CAN frame
+   ** \param[in]  slNomBitRateV  Nominal bit rate in bit/s
+   ** \param[in]  slDatBitRateV  Data bit rate in bit/s
+   ** \return     Time on the bus in nanoseconds
+   **
+   ** The function returns the time the CAN frame \a clFrameR occupies the bus. If \a slDatBitRateV
+   ** is not valid (e.g. QCan::eCAN_BITRATE_NONE), the nominal bit rate is used for the data phase.
+   ** If \a slNomBitRateV is not valid, the function returns 0.
+   */
+   static uint64_t   busTime(const QCanFrame & clFrameR, const int32_t slNomBitRateV,
+                             const int32_t slDatBitRateV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  uqNomBitsV     Number of bits in arbitration phase
+   ** \param[in]  uqDatBitsV     Number of bits in data phase
+   ** \param[in]  slNomBitRateV  Nominal bit rate in bit/s
+   ** \param[in]  slDatBitRateV  Data bit rate in bit/s
+   ** \return     Time on the bus in nanoseconds
+   **
+   ** The function converts the bit counts calculated by count() into a time value.
+   */
+   static uint64_t   busTime(const uint64_t uqNomBitsV, const uint64_t uqDatBitsV,
+                             const int32_t slNomBitRateV, const int32_t slDatBitRateV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubDataV       Pointer to frame data, see QCanFrame::toRawData()
+   ** \param[out] ulNomBitsR     Number of bits in arbitration phase
+   ** \param[out] ulDatBitsR     Number of bits in data phase
+   ** \return     Total number of bits
+   **
+   ** The function calculates the number of bits of a CAN frame which is supplied in the byte array
+   ** format of QCanFrame::toRawData(). For error frames the function returns 0.
+   */
+   static uint32_t   count(const uint8_t * pubDataV, uint32_t & ulNomBitsR, uint32_t & ulDatBitsR);
+};
+
+#endif   // QCAN_FRAME_BITS_HPP_
@@ -0,0 +1,124 @@
+//====================================================================================================================//
+// File:          qcan_frame_cache.cpp                                                                                //
+// Description:   QCAN classes - Cache of latest CAN frame per identifier                                             //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QtEndian>
+
+#include <cstring>
+
+#include "qcan_frame_cache.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrameCache()                                                                                                   //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanFrameCache::QCanFrameCache()
+{
+   clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrameCache::clear()                                                                                            //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanFrameCache::clear(void)
+{
+   clIndexP.clear();
+   clFrameDataP.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrameCache::frame()                                                                                            //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanFrameCache::frame(const uint32_t ulIdentifierV, const bool btExtendedV, QCanFrame & clFrameR) const
+{
+   int32_t  slIndexT = clIndexP.find(ulIdentifierV, btExtendedV);
+
+   if (slIndexT < 0)
+   {
+      return (false);
+   }
+
+   return (clFrameR.fromRawData(reinterpret_cast< const uint8_t * >(clFrameDataP.constData()) +
+                                (slIndexT * static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE))));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanFrameCache::update()                                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanFrameCache::update(const uint8_t * pubDataV)
+{
+   int32_t  slIndexT;
+
+   //---------------------------------------------------------------------------------------------------
+   // only data frames are stored
+   //
+   if ((pubDataV[0] & 0xE0) != 0x00)
+   {
+      return (false);
+   }
+
+   slIndexT = clIndexP.insert(qFromBigEndian<uint32_t>(pubDataV) & QCAN_FRAME_ID_MASK_EXT, ((pubDataV[5] & 0x01) > 0));
+   if (slIndexT < 0)
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // a new identifier is appended at the end of the buffer, otherwise the frame is replaced
+   //
+   if ((slIndexT * static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE)) == clFrameDataP.size())
+   {
+      clFrameDataP.append(reinterpret_cast< const char * >(pubDataV), QCAN_FRAME_ARRAY_SIZE);
+   }
+   else
+   {
+      memcpy(clFrameDataP.data() + (slIndexT * static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE)), pubDataV,
+             QCAN_FRAME_ARRAY_SIZE);
+   }
+
+   return (true);
+}
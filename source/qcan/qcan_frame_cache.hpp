@@ -0,0 +1,128 @@
+//====================================================================================================================//
+// File:          qcan_frame_cache.hpp                                                                                //
+// Description:   QCAN classes - Cache of latest CAN frame per identifier                                             //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_FRAME_CACHE_HPP_
+#define QCAN_FRAME_CACHE_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QByteArray>
+
+#include "qcan_id_index.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanFrameCache
+** \brief   Cache of latest CAN frame per identifier
+**
+** The QCanFrameCache class keeps the most recent CAN data frame of each CAN identifier which has
+** been received by a QCanNetwork. The CAN frames are stored in raw format (#QCAN_FRAME_ARRAY_SIZE
+** bytes) in a contiguous buffer, in order of the first reception of the identifier. So a snapshot
+** of the cache can be written to a socket in one block (see data()).
+** <p>
+** The class is not thread-safe, the owner of the cache must serialise the access.
+*/
+class QCanFrameCache
+{
+public:
+
+   QCanFrameCache();
+
+   ~QCanFrameCache() = default;
+
+   QCanFrameCache(const QCanFrameCache&) = delete;                  // no copy constructor
+   QCanFrameCache& operator=(const QCanFrameCache&) = delete;       // no assignment operator
+   QCanFrameCache(QCanFrameCache&&) = delete;                       // no move constructor
+   QCanFrameCache& operator=(QCanFrameCache&&) = delete;            // no move operator
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Remove all CAN frames from the cache.
+   */
+   void              clear(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of CAN frames
+   **
+   ** Returns the number of CAN frames inside the cache.
+   */
+   inline uint32_t   count(void) const       { return (clIndexP.count());  }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     CAN frames in raw format
+   **
+   ** Returns the content of the cache: count() CAN frames in raw format with #QCAN_FRAME_ARRAY_SIZE
+   ** bytes each. The returned object is an implicitly shared copy, it is not changed by a following
+   ** call of update().
+   */
+   inline QByteArray data(void) const        { return (clFrameDataP);      }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulIdentifierV  CAN identifier
+   ** \param[in]  btExtendedV    \c true for extended identifier
+   ** \param[out] clFrameR       CAN frame
+   ** \return     \c true if a CAN frame is present
+   **
+   ** The function returns the most recent CAN frame with the identifier \a ulIdentifierV.
+   */
+   bool              frame(const uint32_t ulIdentifierV, const bool btExtendedV, QCanFrame & clFrameR) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubDataV       Pointer to CAN frame in raw format (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \return     \c true if the CAN frame has been stored
+   **
+   ** Store the CAN frame \a pubDataV as most recent value of its identifier. Error frames are not
+   ** stored. The function returns \c false if the cache can not hold further identifiers.
+   */
+   bool              update(const uint8_t * pubDataV);
+
+private:
+
+   QCanIdIndex       clIndexP;
+   QByteArray        clFrameDataP;
+};
+
+#endif   // QCAN_FRAME_CACHE_HPP_
@@ -0,0 +1,206 @@
+//====================================================================================================================//
+// File:          qcan_id_index.cpp                                                                                   //
+// Description:   QCAN classes - Index of CAN identifiers                                                             //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include "qcan_id_index.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------------------------------
+// Number of entries for standard identifiers (11 bit)
+//
+constexpr int32_t    STD_ENTRY_MAX     = 2048;
+
+//------------------------------------------------------------------------------------------------------
+// The hash table for extended identifiers is filled up to 75 %, so the probe sequences stay short.
+// The hash value is calculated by multiplication with the golden ratio, the upper bits of the
+// product are used as index.
+//
+constexpr uint32_t   EXT_ENTRY_MASK    = QCAN_ID_TABLE_EXT_MAX - 1;
+constexpr uint32_t   EXT_ENTRY_LIMIT   = (QCAN_ID_TABLE_EXT_MAX / 4) * 3;
+constexpr uint32_t   EXT_HASH_FACTOR   = 0x9E3779B1;
+
+static_assert((QCAN_ID_TABLE_EXT_MAX & EXT_ENTRY_MASK) == 0, "QCAN_ID_TABLE_EXT_MAX must be a power of 2");
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Static functions                                                                                                   **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//--------------------------------------------------------------------------------------------------------------------//
+// hashShift()                                                                                                        //
+// number of bits to shift the product of the hash calculation                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+static constexpr uint32_t hashShift(void)
+{
+   uint32_t ulShiftT = 32;
+   uint32_t ulSizeT  = QCAN_ID_TABLE_EXT_MAX;
+
+   while (ulSizeT > 1)
+   {
+      ulSizeT  = ulSizeT >> 1;
+      ulShiftT = ulShiftT - 1;
+   }
+
+   return (ulShiftT);
+}
+
+constexpr uint32_t   EXT_HASH_SHIFT    = hashShift();
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanIdIndex()                                                                                                      //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanIdIndex::QCanIdIndex()
+{
+   aslStdIndexP.resize(STD_ENTRY_MAX);
+   atsExtIndexP.resize(QCAN_ID_TABLE_EXT_MAX);
+
+   clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanIdIndex::clear()                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanIdIndex::clear(void)
+{
+   ExtEntry_ts tsEmptyT = { 0, -1 };
+
+   aslStdIndexP.fill(-1);
+   atsExtIndexP.fill(tsEmptyT);
+
+   ulStdCountP = 0;
+   ulExtCountP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanIdIndex::extSlot()                                                                                             //
+// search the slot of an extended identifier, linear probing                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanIdIndex::extSlot(const uint32_t ulIdentifierV) const
+{
+   uint32_t ulSlotT = ((ulIdentifierV & QCAN_FRAME_ID_MASK_EXT) * EXT_HASH_FACTOR) >> EXT_HASH_SHIFT;
+
+   //---------------------------------------------------------------------------------------------------
+   // the search stops at the matching entry or at the first unused entry, the table is never full
+   //
+   while ((atsExtIndexP.at(static_cast< int32_t >(ulSlotT)).slIndex >= 0) &&
+          (atsExtIndexP.at(static_cast< int32_t >(ulSlotT)).ulIdentifier != ulIdentifierV))
+   {
+      ulSlotT = (ulSlotT + 1) & EXT_ENTRY_MASK;
+   }
+
+   return (ulSlotT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanIdIndex::find()                                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+int32_t QCanIdIndex::find(const uint32_t ulIdentifierV, const bool btExtendedV) const
+{
+   if (btExtendedV == false)
+   {
+      return (aslStdIndexP.at(static_cast< int32_t >(ulIdentifierV & QCAN_FRAME_ID_MASK_STD)));
+   }
+
+   return (atsExtIndexP.at(static_cast< int32_t >(extSlot(ulIdentifierV & QCAN_FRAME_ID_MASK_EXT))).slIndex);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanIdIndex::insert()                                                                                              //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+int32_t QCanIdIndex::insert(const uint32_t ulIdentifierV, const bool btExtendedV)
+{
+   int32_t  slIndexT;
+   uint32_t ulSlotT;
+
+   if (btExtendedV == false)
+   {
+      slIndexT = aslStdIndexP.at(static_cast< int32_t >(ulIdentifierV & QCAN_FRAME_ID_MASK_STD));
+      if (slIndexT < 0)
+      {
+         slIndexT = static_cast< int32_t >(count());
+         aslStdIndexP[static_cast< int32_t >(ulIdentifierV & QCAN_FRAME_ID_MASK_STD)] = slIndexT;
+         ulStdCountP++;
+      }
+   }
+   else
+   {
+      ulSlotT  = extSlot(ulIdentifierV & QCAN_FRAME_ID_MASK_EXT);
+      slIndexT = atsExtIndexP.at(static_cast< int32_t >(ulSlotT)).slIndex;
+      if (slIndexT < 0)
+      {
+         if (ulExtCountP >= EXT_ENTRY_LIMIT)
+         {
+            return (-1);
+         }
+
+         slIndexT = static_cast< int32_t >(count());
+         atsExtIndexP[static_cast< int32_t >(ulSlotT)].ulIdentifier = ulIdentifierV & QCAN_FRAME_ID_MASK_EXT;
+         atsExtIndexP[static_cast< int32_t >(ulSlotT)].slIndex      = slIndexT;
+         ulExtCountP++;
+      }
+   }
+
+   return (slIndexT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanIdIndex::size()                                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanIdIndex::size(void)
+{
+   return (STD_ENTRY_MAX + EXT_ENTRY_LIMIT);
+}
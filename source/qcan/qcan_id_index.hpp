@@ -0,0 +1,140 @@
+//====================================================================================================================//
+// File:          qcan_id_index.hpp                                                                                   //
+// Description:   QCAN classes - Index of CAN identifiers                                                             //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_ID_INDEX_HPP_
+#define QCAN_ID_INDEX_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QVector>
+
+#include "qcan_defs.hpp"
+#include "qcan_frame.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanIdIndex
+** \brief   Index of CAN identifiers
+**
+** The QCanIdIndex class assigns a dense index value (0, 1, 2, ...) to each CAN identifier in the
+** order of insertion. The index is used by tables which keep a value per CAN identifier
+** (e.g. QCanIdStatistic or QCanFrameCache) in a contiguous array.
+** <p>
+** Standard identifiers are looked up in a direct-indexed table with 2048 entries. Extended
+** identifiers are looked up in an open-addressing hash table with #QCAN_ID_TABLE_EXT_MAX entries,
+** which is filled up to 75 %.
+** <p>
+** The class is not thread-safe, the owner of the index must serialise the access.
+*/
+class QCanIdIndex
+{
+public:
+
+   QCanIdIndex();
+
+   ~QCanIdIndex() = default;
+
+   QCanIdIndex(const QCanIdIndex&) = delete;                  // no copy constructor
+   QCanIdIndex& operator=(const QCanIdIndex&) = delete;       // no assignment operator
+   QCanIdIndex(QCanIdIndex&&) = delete;                       // no move constructor
+   QCanIdIndex& operator=(QCanIdIndex&&) = delete;            // no move operator
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Remove all identifiers from the index.
+   */
+   void           clear(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of identifiers
+   **
+   ** Returns the number of CAN identifiers inside the index, this is also the next index value.
+   */
+   inline uint32_t count(void) const         { return (ulStdCountP + ulExtCountP);  }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulIdentifierV  CAN identifier
+   ** \param[in]  btExtendedV    \c true for extended identifier
+   ** \return     Index value or -1 if not found
+   **
+   ** The function searches the CAN identifier \a ulIdentifierV.
+   */
+   int32_t        find(const uint32_t ulIdentifierV, const bool btExtendedV) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulIdentifierV  CAN identifier
+   ** \param[in]  btExtendedV    \c true for extended identifier
+   ** \return     Index value or -1 if the index is full
+   **
+   ** The function returns the index value of the CAN identifier \a ulIdentifierV. If the identifier
+   ** is not present, it is inserted with the index value count(), so the caller can append the
+   ** corresponding value to its own table.
+   */
+   int32_t        insert(const uint32_t ulIdentifierV, const bool btExtendedV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Maximum number of identifiers
+   **
+   ** Returns the maximum number of CAN identifiers the index can hold.
+   */
+   static uint32_t size(void);
+
+private:
+
+   typedef struct ExtEntry_s {
+      uint32_t    ulIdentifier;
+      int32_t     slIndex;
+   } ExtEntry_ts;
+
+   uint32_t       extSlot(const uint32_t ulIdentifierV) const;
+
+   QVector<int32_t>     aslStdIndexP;
+   QVector<ExtEntry_ts> atsExtIndexP;
+   uint32_t             ulStdCountP;
+   uint32_t             ulExtCountP;
+};
+
+#endif   // QCAN_ID_INDEX_HPP_
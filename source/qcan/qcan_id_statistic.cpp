@@ -0,0 +1,235 @@
+//====================================================================================================================//
+// File:          qcan_id_statistic.cpp                                                                               //
+// Description:   QCAN classes - Statistic per CAN identifier                                                         //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+#include <cmath>
+
+#include "qcan_id_statistic.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanIdStatistic()                                                                                                  //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanIdStatistic::QCanIdStatistic()
+{
+   atsEntryP.reserve(static_cast< int32_t >(QCanIdIndex::size()));
+
+   clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanIdStatistic::appendJson()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanIdStatistic::appendJson(QJsonArray & clArrayR, const IdEntry_ts & tsEntryR, const uint64_t uqTimeV) const
+{
+   QJsonObject clJsonEntryT;
+   double      dJitterT = 0.0;
+
+   if (tsEntryR.ulCount > 2)
+   {
+      dJitterT = std::sqrt(tsEntryR.dPeriodM2 / static_cast< double >(tsEntryR.ulCount - 2));
+   }
+
+   clJsonEntryT["id"]         = static_cast< int32_t >(tsEntryR.ulIdentifier);
+   clJsonEntryT["extended"]   = tsEntryR.btExtended;
+   clJsonEntryT["count"]      = static_cast< double >(tsEntryR.ulCount);
+   clJsonEntryT["dlc"]        = static_cast< int32_t >(tsEntryR.ubDlc);
+   clJsonEntryT["age"]        = static_cast< double >(uqTimeV - tsEntryR.uqTimeLast) / 1000000.0;
+   clJsonEntryT["periodMean"] = tsEntryR.dPeriodMean / 1000.0;
+   clJsonEntryT["periodMin"]  = static_cast< double >(tsEntryR.uqPeriodMin) / 1000.0;
+   clJsonEntryT["periodMax"]  = static_cast< double >(tsEntryR.uqPeriodMax) / 1000.0;
+   clJsonEntryT["jitter"]     = dJitterT / 1000.0;
+
+   clArrayR.append(clJsonEntryT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanIdStatistic::clear()                                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanIdStatistic::clear(void)
+{
+   clIndexP.clear();
+   atsEntryP.clear();
+
+   ulOverflowCountP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanIdStatistic::toJson()                                                                                          //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QJsonArray QCanIdStatistic::toJson(const uint64_t uqTimeV) const
+{
+   QJsonArray        clArrayT;
+   QVector<int32_t>  aslOrderT;
+   int32_t           slIdxT;
+
+   //---------------------------------------------------------------------------------------------------
+   // the entries are stored in order of reception, sort them: standard identifiers first
+   //
+   aslOrderT.resize(atsEntryP.size());
+   for (slIdxT = 0; slIdxT < atsEntryP.size(); slIdxT++)
+   {
+      aslOrderT[slIdxT] = slIdxT;
+   }
+
+   std::sort(aslOrderT.begin(), aslOrderT.end(),
+             [this](const int32_t slLeftV, const int32_t slRightV)
+             {
+                const IdEntry_ts & tsLeftR  = atsEntryP.at(slLeftV);
+                const IdEntry_ts & tsRightR = atsEntryP.at(slRightV);
+
+                if (tsLeftR.btExtended != tsRightR.btExtended)
+                {
+                   return (tsRightR.btExtended);
+                }
+                return (tsLeftR.ulIdentifier < tsRightR.ulIdentifier);
+             });
+
+   for (slIdxT = 0; slIdxT < aslOrderT.size(); slIdxT++)
+   {
+      appendJson(clArrayT, atsEntryP.at(aslOrderT.at(slIdxT)), uqTimeV);
+   }
+
+   return (clArrayT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanIdStatistic::update()                                                                                          //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanIdStatistic::update(const uint8_t * pubDataV, const uint64_t uqTimeV)
+{
+   IdEntry_ts  tsEntryT = { };
+   int32_t     slIndexT;
+
+   //---------------------------------------------------------------------------------------------------
+   // only data frames are evaluated
+   //
+   if ((pubDataV[0] & 0xE0) != 0x00)
+   {
+      return;
+   }
+
+   tsEntryT.ulIdentifier = qFromBigEndian<uint32_t>(pubDataV) & QCAN_FRAME_ID_MASK_EXT;
+   tsEntryT.btExtended   = ((pubDataV[5] & 0x01) > 0);
+
+   slIndexT = clIndexP.insert(tsEntryT.ulIdentifier, tsEntryT.btExtended);
+   if (slIndexT < 0)
+   {
+      ulOverflowCountP++;
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // a new identifier gets the next index value
+   //
+   if (slIndexT == atsEntryP.size())
+   {
+      if (tsEntryT.btExtended == false)
+      {
+         tsEntryT.ulIdentifier = tsEntryT.ulIdentifier & QCAN_FRAME_ID_MASK_STD;
+      }
+      atsEntryP.append(tsEntryT);
+   }
+
+   updateEntry(atsEntryP[slIndexT], pubDataV[4] & 0x0F, uqTimeV);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanIdStatistic::updateEntry()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanIdStatistic::updateEntry(IdEntry_ts & tsEntryR, const uint8_t ubDlcV, const uint64_t uqTimeV)
+{
+   uint64_t uqPeriodT;
+   double   dDeltaT;
+
+   //---------------------------------------------------------------------------------------------------
+   // the period can be calculated starting with the second CAN frame
+   //
+   if (tsEntryR.ulCount > 0)
+   {
+      uqPeriodT = uqTimeV - tsEntryR.uqTimeLast;
+
+      if (tsEntryR.ulCount == 1)
+      {
+         tsEntryR.uqPeriodMin = uqPeriodT;
+         tsEntryR.uqPeriodMax = uqPeriodT;
+      }
+      else
+      {
+         if (uqPeriodT < tsEntryR.uqPeriodMin)
+         {
+            tsEntryR.uqPeriodMin = uqPeriodT;
+         }
+         if (uqPeriodT > tsEntryR.uqPeriodMax)
+         {
+            tsEntryR.uqPeriodMax = uqPeriodT;
+         }
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // running mean and sum of squared differences, the number of periods is ulCount
+      //
+      dDeltaT               = static_cast< double >(uqPeriodT) - tsEntryR.dPeriodMean;
+      tsEntryR.dPeriodMean += dDeltaT / static_cast< double >(tsEntryR.ulCount);
+      tsEntryR.dPeriodM2   += dDeltaT * (static_cast< double >(uqPeriodT) - tsEntryR.dPeriodMean);
+   }
+
+   if (tsEntryR.ulCount < UINT32_MAX)
+   {
+      tsEntryR.ulCount++;
+   }
+   tsEntryR.uqTimeLast = uqTimeV;
+   tsEntryR.ubDlc      = ubDlcV;
+}
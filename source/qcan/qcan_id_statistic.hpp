@@ -0,0 +1,164 @@
+//====================================================================================================================//
+// File:          qcan_id_statistic.hpp                                                                               //
+// Description:   QCAN classes - Statistic per CAN identifier                                                         //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_ID_STATISTIC_HPP_
+#define QCAN_ID_STATISTIC_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QVector>
+
+#include "qcan_id_index.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanIdStatistic
+** \brief   Statistic per CAN identifier
+**
+** The QCanIdStatistic class collects statistic values for each CAN identifier received by a
+** QCanNetwork: number of frames, time of last reception, mean / minimum / maximum period, jitter
+** (standard deviation of the period) and last DLC. The values are updated incrementally for each
+** CAN frame, a snapshot of the table is provided by toJson().
+** <p>
+** The entries are looked up by a QCanIdIndex: standard identifiers are direct-indexed, extended
+** identifiers are stored in a hash table. If the hash table is filled up, further extended
+** identifiers are not recorded and counted by overflowCount().
+** <p>
+** The class is not thread-safe, the owner of the table must serialise the access.
+*/
+class QCanIdStatistic
+{
+public:
+
+   QCanIdStatistic();
+
+   ~QCanIdStatistic() = default;
+
+   QCanIdStatistic(const QCanIdStatistic&) = delete;                  // no copy constructor
+   QCanIdStatistic& operator=(const QCanIdStatistic&) = delete;       // no assignment operator
+   QCanIdStatistic(QCanIdStatistic&&) = delete;                       // no move constructor
+   QCanIdStatistic& operator=(QCanIdStatistic&&) = delete;            // no move operator
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Remove all entries from the table.
+   */
+   void           clear(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of identifiers
+   **
+   ** Returns the number of different CAN identifiers inside the table.
+   */
+   inline uint32_t count(void) const         { return (clIndexP.count());  }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of frames not recorded
+   **
+   ** Returns the number of CAN frames with an extended identifier which have not been recorded
+   ** because the hash table is full.
+   */
+   inline uint32_t overflowCount(void) const { return (ulOverflowCountP);  }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  uqTimeV        Actual time in nanoseconds
+   ** \return     Array of JSON objects
+   **
+   ** The function returns a snapshot of the table, sorted by identifier. Each entry has the following
+   ** format, all periods are given in microseconds and the age of the last reception (relative to
+   ** \a uqTimeV) is given in milliseconds:
+   ** \code
+   ** {
+   **    "id": 291,
+   **    "extended": false,
+   **    "count": 1250,
+   **    "dlc": 8,
+   **    "age": 4.2,
+   **    "periodMean": 10000.3,
+   **    "periodMin": 9870.0,
+   **    "periodMax": 10130.5,
+   **    "jitter": 22.7
+   ** }
+   ** \endcode
+   */
+   QJsonArray     toJson(const uint64_t uqTimeV) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubDataV       Pointer to CAN frame in raw format (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \param[in]  uqTimeV        Actual time in nanoseconds
+   **
+   ** Update the entry of the CAN identifier of the frame \a pubDataV, the time \a uqTimeV is the
+   ** reception time. Error frames are not evaluated.
+   */
+   void           update(const uint8_t * pubDataV, const uint64_t uqTimeV);
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // an entry of the table, the period values are evaluated with Welford's algorithm
+   typedef struct IdEntry_s {
+      uint64_t    uqTimeLast;
+      uint64_t    uqPeriodMin;
+      uint64_t    uqPeriodMax;
+      double      dPeriodMean;
+      double      dPeriodM2;
+      uint32_t    ulIdentifier;
+      uint32_t    ulCount;
+      uint8_t     ubDlc;
+      bool        btExtended;
+   } IdEntry_ts;
+
+   void           appendJson(QJsonArray & clArrayR, const IdEntry_ts & tsEntryR, const uint64_t uqTimeV) const;
+
+   void           updateEntry(IdEntry_ts & tsEntryR, const uint8_t ubDlcV, const uint64_t uqTimeV);
+
+   QCanIdIndex          clIndexP;
+   QVector<IdEntry_ts>  atsEntryP;
+   uint32_t             ulOverflowCountP;
+};
+
+#endif   // QCAN_ID_STATISTIC_HPP_
@@ -188,6 +188,13 @@ public:
    */
    #ifndef QCAN_NO_QT_GUI
    virtual QIcon icon(void) = 0;
+   #else
+   //---------------------------------------------------------------------------------------------------
+   // Placeholder for icon(): it keeps the layout of the virtual table, so an application without Qt
+   // GUI support can use plug-ins which have been compiled with Qt GUI support. The function must
+   // not be called.
+   //
+   virtual void  iconReserved(void) { }
    #endif
 
 
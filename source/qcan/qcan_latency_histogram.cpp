@@ -0,0 +1,196 @@
+//====================================================================================================================//
+// File:          qcan_latency_histogram.cpp                                                                          //
+// Description:   QCAN classes - Latency histogram                                                                    //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QtAlgorithms>
+
+#include <cstring>
+
+#include "qcan_latency_histogram.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLatencyHistogram()                                                                                             //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanLatencyHistogram::QCanLatencyHistogram()
+{
+   clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLatencyHistogram::bucketIndex()                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+int32_t QCanLatencyHistogram::bucketIndex(const uint64_t uqLatencyV)
+{
+   uint64_t uqValueT = uqLatencyV;
+   int32_t  slExponentT;
+
+   //---------------------------------------------------------------------------------------------------
+   // values beyond the range are recorded in the last bucket
+   //
+   if (uqValueT >= (1ULL << QCAN_LATENCY_VALUE_BITS))
+   {
+      uqValueT = (1ULL << QCAN_LATENCY_VALUE_BITS) - 1;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // small values have a bucket of their own
+   //
+   if (uqValueT < static_cast< uint64_t >(2 * slSubCountP))
+   {
+      return (static_cast< int32_t >(uqValueT));
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the exponent selects the power of two, the following QCAN_LATENCY_SUB_BITS bits below the
+   // most significant bit select the bucket inside it
+   //
+   slExponentT = 63 - static_cast< int32_t >(qCountLeadingZeroBits(static_cast< quint64 >(uqValueT)));
+
+   return (((slExponentT - QCAN_LATENCY_SUB_BITS) * slSubCountP) +
+           static_cast< int32_t >(uqValueT >> (slExponentT - QCAN_LATENCY_SUB_BITS)));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLatencyHistogram::bucketLimit()                                                                                //
+// return largest value of a bucket                                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+uint64_t QCanLatencyHistogram::bucketLimit(const int32_t slBucketV)
+{
+   int32_t  slExponentT;
+   uint64_t uqMantissaT;
+
+   if (slBucketV < (2 * slSubCountP))
+   {
+      return (static_cast< uint64_t >(slBucketV));
+   }
+
+   slExponentT = (slBucketV / slSubCountP) + QCAN_LATENCY_SUB_BITS - 1;
+   uqMantissaT = static_cast< uint64_t >((slBucketV % slSubCountP) + slSubCountP);
+
+   return (((uqMantissaT + 1) << (slExponentT - QCAN_LATENCY_SUB_BITS)) - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLatencyHistogram::clear()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanLatencyHistogram::clear(void)
+{
+   memset(&aulBucketP[0], 0, sizeof(aulBucketP));
+   uqCountP   = 0;
+   uqMaximumP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLatencyHistogram::percentile()                                                                                 //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint64_t QCanLatencyHistogram::percentile(const uint32_t ulPercentV) const
+{
+   uint64_t uqRankT;
+   uint64_t uqSumT = 0;
+   int32_t  slBucketT;
+
+   if (uqCountP == 0)
+   {
+      return (0);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // rank of the requested value (rounded up), the buckets are summed up until the rank is reached
+   //
+   uqRankT = ((uqCountP * qMin(ulPercentV, static_cast< uint32_t >(100))) + 99) / 100;
+   if (uqRankT == 0)
+   {
+      uqRankT = 1;
+   }
+
+   for (slBucketT = 0; slBucketT < slBucketCountP; slBucketT++)
+   {
+      uqSumT = uqSumT + aulBucketP[slBucketT];
+      if (uqSumT >= uqRankT)
+      {
+         break;
+      }
+   }
+
+   return (qMin(bucketLimit(slBucketT), uqMaximumP));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLatencyHistogram::record()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanLatencyHistogram::record(const uint64_t uqLatencyV)
+{
+   aulBucketP[bucketIndex(uqLatencyV)]++;
+   uqCountP++;
+
+   if (uqLatencyV > uqMaximumP)
+   {
+      uqMaximumP = uqLatencyV;
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLatencyHistogram::toJson()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QJsonObject QCanLatencyHistogram::toJson(void) const
+{
+   QJsonObject clJsonT;
+
+   clJsonT["count"] = static_cast< double >(uqCountP);
+   clJsonT["p50"]   = static_cast< double >(percentile(50)) / 1000.0;
+   clJsonT["p99"]   = static_cast< double >(percentile(99)) / 1000.0;
+   clJsonT["max"]   = static_cast< double >(uqMaximumP) / 1000.0;
+
+   return (clJsonT);
+}
+
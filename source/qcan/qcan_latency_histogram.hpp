@@ -0,0 +1,167 @@
+//====================================================================================================================//
+// File:          qcan_latency_histogram.hpp                                                                          //
+// Description:   QCAN classes - Latency histogram                                                                    //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_LATENCY_HISTOGRAM_HPP_
+#define QCAN_LATENCY_HISTOGRAM_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QJsonObject>
+
+#include <cstdint>
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_LATENCY_SUB_BITS
+**
+** Number of bits used for the linear sub-division of each power of two inside a QCanLatencyHistogram.
+** The value 3 results in 8 buckets per power of two, i.e. a maximum relative error of 12.5 %.
+*/
+#define  QCAN_LATENCY_SUB_BITS               3
+
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_LATENCY_VALUE_BITS
+**
+** Number of bits of the largest latency value recorded by a QCanLatencyHistogram, larger values
+** are recorded in the last bucket. The value 32 covers latencies up to 4.29 seconds.
+*/
+#define  QCAN_LATENCY_VALUE_BITS             32
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanLatencyHistogram
+** \brief   Latency histogram
+**
+** The QCanLatencyHistogram class records latency values in nanoseconds inside log-bucketed
+** counters: values below 2^(#QCAN_LATENCY_SUB_BITS + 1) have a bucket of their own, each further
+** power of two is divided into 2^#QCAN_LATENCY_SUB_BITS buckets of equal width. Recording a value
+** takes a constant time without memory allocation, the percentiles are evaluated on request.
+** <p>
+** The class is not thread-safe, the owner of the histogram must serialise the access.
+*/
+class QCanLatencyHistogram
+{
+public:
+
+   QCanLatencyHistogram();
+
+   ~QCanLatencyHistogram() = default;
+
+   QCanLatencyHistogram(const QCanLatencyHistogram&) = delete;                  // no copy constructor
+   QCanLatencyHistogram& operator=(const QCanLatencyHistogram&) = delete;       // no assignment operator
+   QCanLatencyHistogram(QCanLatencyHistogram&&) = delete;                       // no move constructor
+   QCanLatencyHistogram& operator=(QCanLatencyHistogram&&) = delete;            // no move operator
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Remove all recorded values.
+   */
+   void           clear(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of recorded values
+   */
+   inline uint64_t count(void) const         { return (uqCountP);          }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Maximum latency in nanoseconds
+   **
+   ** Returns the exact maximum of all recorded values, the value is 0 if the histogram is empty.
+   */
+   inline uint64_t maximum(void) const       { return (uqMaximumP);        }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulPercentV     Percentile in the range from 1 to 100
+   ** \return     Latency in nanoseconds
+   **
+   ** Returns the upper bound of the bucket which holds the percentile \a ulPercentV, limited to the
+   ** maximum recorded value. The value is 0 if the histogram is empty.
+   */
+   uint64_t       percentile(const uint32_t ulPercentV) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  uqLatencyV     Latency in nanoseconds
+   **
+   ** Record the latency value \a uqLatencyV.
+   */
+   void           record(const uint64_t uqLatencyV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     JSON object
+   **
+   ** The function returns a summary of the histogram, all latencies are given in microseconds:
+   ** \code
+   ** {
+   **    "count": 125000,
+   **    "p50": 18.4,
+   **    "p99": 61.4,
+   **    "max": 412.9
+   ** }
+   ** \endcode
+   */
+   QJsonObject    toJson(void) const;
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // number of buckets: the first 2^(SUB_BITS + 1) values are stored directly, followed by
+   // 2^SUB_BITS buckets for each further power of two
+   //
+   static constexpr int32_t   slSubCountP    = (1 << QCAN_LATENCY_SUB_BITS);
+   static constexpr int32_t   slBucketCountP = (QCAN_LATENCY_VALUE_BITS - QCAN_LATENCY_SUB_BITS + 1) * slSubCountP;
+
+   static int32_t    bucketIndex(const uint64_t uqLatencyV);
+
+   static uint64_t   bucketLimit(const int32_t slBucketV);
+
+   uint32_t          aulBucketP[slBucketCountP];
+   uint64_t          uqCountP;
+   uint64_t          uqMaximumP;
+};
+
+#endif   // QCAN_LATENCY_HISTOGRAM_HPP_
@@ -0,0 +1,406 @@
+//====================================================================================================================//
+// File:          qcan_log_writer.cpp                                                                                 //
+// Description:   QCAN classes - Asynchronous log writer                                                              //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QDateTime>
+
+#include "qcan_log_writer.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+static_assert((QCAN_LOG_RING_SIZE & (QCAN_LOG_RING_SIZE - 1)) == 0, "QCAN_LOG_RING_SIZE must be a power of two");
+
+constexpr uint32_t   LOG_RING_MASK  = QCAN_LOG_RING_SIZE - 1;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLogWriter()                                                                                                    //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanLogWriter::QCanLogWriter(QObject * pclParentV)
+   : QThread(pclParentV)
+{
+   for (uint32_t ulSlotT = 0; ulSlotT < QCAN_LOG_RING_SIZE; ulSlotT++)
+   {
+      atsRingP[ulSlotT].ulSequence.store(ulSlotT, std::memory_order_relaxed);
+      atsRingP[ulSlotT].ubFile = 0;
+   }
+   ulHeadP.store(0, std::memory_order_relaxed);
+   ulTailP = 0;
+
+   btRunP.store(true);
+   ulDropCountP.store(0);
+   ulFileCountP.store(0);
+
+   for (uint8_t ubFileT = 0; ubFileT < QCAN_NETWORK_LIMIT; ubFileT++)
+   {
+      aulFileDropP[ubFileT].store(0);
+      apclLogFileP[ubFileT]   = nullptr;
+      asqRotateTimeP[ubFileT] = 0;
+   }
+
+   ulRotateSizeP     = 0;
+   ulRotateIntervalP = 0;
+   ubRotateBackupP   = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// ~QCanLogWriter()                                                                                                   //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanLogWriter::~QCanLogWriter()
+{
+   stop();
+
+   for (uint8_t ubFileT = 0; ubFileT < QCAN_NETWORK_LIMIT; ubFileT++)
+   {
+      if (apclLogFileP[ubFileT] != nullptr)
+      {
+         apclLogFileP[ubFileT]->flush();
+         apclLogFileP[ubFileT]->close();
+         delete (apclLogFileP[ubFileT]);
+      }
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLogWriter::append()                                                                                            //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanLogWriter::append(const uint8_t ubFileV, const QByteArray & clRecordR)
+{
+   if (ubFileV >= ulFileCountP.load(std::memory_order_acquire))
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // reserve an entry of the ring: the entry is free if its sequence equals the enqueue position,
+   // a smaller value means the ring is full
+   //
+   LogSlot_ts * ptsSlotT;
+   uint32_t     ulPosT = ulHeadP.load(std::memory_order_relaxed);
+
+   for (;;)
+   {
+      ptsSlotT = &atsRingP[ulPosT & LOG_RING_MASK];
+
+      int32_t slDiffT = static_cast< int32_t >(ptsSlotT->ulSequence.load(std::memory_order_acquire) - ulPosT);
+      if (slDiffT == 0)
+      {
+         if (ulHeadP.compare_exchange_weak(ulPosT, ulPosT + 1, std::memory_order_relaxed))
+         {
+            break;
+         }
+      }
+      else if (slDiffT < 0)
+      {
+         ulDropCountP.fetch_add(1, std::memory_order_relaxed);
+         aulFileDropP[ubFileV].fetch_add(1, std::memory_order_relaxed);
+         return (false);
+      }
+      else
+      {
+         ulPosT = ulHeadP.load(std::memory_order_relaxed);
+      }
+   }
+
+   ptsSlotT->ubFile   = ubFileV;
+   ptsSlotT->clRecord = clRecordR;
+   ptsSlotT->ulSequence.store(ulPosT + 1, std::memory_order_release);
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLogWriter::dequeue()                                                                                           //
+// only called by the writer thread                                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanLogWriter::dequeue(uint8_t & ubFileR, QByteArray & clRecordR)
+{
+   LogSlot_ts * ptsSlotT = &atsRingP[ulTailP & LOG_RING_MASK];
+
+   if (ptsSlotT->ulSequence.load(std::memory_order_acquire) != (ulTailP + 1))
+   {
+      return (false);
+   }
+
+   ubFileR = ptsSlotT->ubFile;
+   clRecordR.swap(ptsSlotT->clRecord);
+   ptsSlotT->clRecord.clear();
+   ptsSlotT->ulSequence.store(ulTailP + QCAN_LOG_RING_SIZE, std::memory_order_release);
+   ulTailP++;
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLogWriter::rotate()                                                                                            //
+// the caller must hold clFileMutexP                                                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanLogWriter::rotate(const uint8_t ubFileV)
+{
+   QFile * pclLogFileT = apclLogFileP[ubFileV];
+
+   if (pclLogFileT == nullptr)
+   {
+      return;
+   }
+
+   pclLogFileT->close();
+
+   //---------------------------------------------------------------------------------------------------
+   // shift the backup files: "name.(n-1)" becomes "name.n", the log file becomes "name.1"
+   //
+   if (ubRotateBackupP > 0)
+   {
+      QString clFileNameT = pclLogFileT->fileName();
+
+      QFile::remove(clFileNameT + QString(".%1").arg(ubRotateBackupP));
+      for (int32_t slBackupT = ubRotateBackupP - 1; slBackupT > 0; slBackupT--)
+      {
+         QFile::rename(clFileNameT + QString(".%1").arg(slBackupT), clFileNameT + QString(".%1").arg(slBackupT + 1));
+      }
+      QFile::rename(clFileNameT, clFileNameT + ".1");
+   }
+
+   if (pclLogFileT->open(QIODevice::ReadWrite | QIODevice::Truncate | QIODevice::Text) == false)
+   {
+      delete (pclLogFileT);
+      apclLogFileP[ubFileV] = nullptr;
+   }
+
+   asqRotateTimeP[ubFileV] = QDateTime::currentMSecsSinceEpoch();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLogWriter::run()                                                                                               //
+// writer thread                                                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanLogWriter::run(void)
+{
+   QByteArray  aclBatchT[QCAN_NETWORK_LIMIT];
+   QByteArray  clRecordT;
+   uint8_t     ubFileT;
+   bool        btPendingT;
+
+   do
+   {
+      //-------------------------------------------------------------------------------------------
+      // the stop request is read before the ring is emptied, so no record is lost on exit
+      //
+      bool btRunT = btRunP.load(std::memory_order_acquire);
+
+      btPendingT = false;
+      while (dequeue(ubFileT, clRecordT) == true)
+      {
+         aclBatchT[ubFileT].append(clRecordT);
+         btPendingT = true;
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // append a notice about dropped records
+      //
+      uint32_t ulFileCountT = ulFileCountP.load(std::memory_order_acquire);
+      for (ubFileT = 0; ubFileT < ulFileCountT; ubFileT++)
+      {
+         uint32_t ulDropT = aulFileDropP[ubFileT].exchange(0, std::memory_order_relaxed);
+         if (ulDropT > 0)
+         {
+            aclBatchT[ubFileT].append(QDateTime::currentDateTime().toString("hh:mm:ss.zzz - ").toLatin1());
+            aclBatchT[ubFileT].append(QByteArray::number(ulDropT) + " log records dropped\n");
+            btPendingT = true;
+         }
+      }
+
+      writeBatch(aclBatchT);
+
+      if (btRunT == false)
+      {
+         break;
+      }
+
+      if (btPendingT == false)
+      {
+         QThread::msleep(QCAN_LOG_WRITER_PERIOD);
+      }
+   } while (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLogWriter::setFileName()                                                                                       //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanLogWriter::setFileName(const uint8_t ubFileV, const QString & clFileNameR)
+{
+   bool btResultT = false;
+
+   if (ubFileV < QCAN_NETWORK_LIMIT)
+   {
+      clFileMutexP.lock();
+
+      if (ubFileV >= ulFileCountP.load(std::memory_order_relaxed))
+      {
+         ulFileCountP.store(ubFileV + 1U, std::memory_order_release);
+      }
+
+      if (apclLogFileP[ubFileV] == nullptr)
+      {
+         apclLogFileP[ubFileV] = new QFile();
+      }
+      else
+      {
+         //-------------------------------------------------------------------------------------------
+         // make sure the file is closed in case it was used before
+         //
+         apclLogFileP[ubFileV]->close();
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // open the new file in rw mode for text files, existing contents is truncated
+      //
+      apclLogFileP[ubFileV]->setFileName(clFileNameR);
+      if (apclLogFileP[ubFileV]->open(QIODevice::ReadWrite | QIODevice::Truncate | QIODevice::Text) == true)
+      {
+         asqRotateTimeP[ubFileV] = QDateTime::currentMSecsSinceEpoch();
+         btResultT = true;
+      }
+      else
+      {
+         delete (apclLogFileP[ubFileV]);
+         apclLogFileP[ubFileV] = nullptr;
+      }
+
+      clFileMutexP.unlock();
+   }
+
+   return (btResultT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLogWriter::setRotation()                                                                                       //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanLogWriter::setRotation(const uint32_t ulSizeV, const uint32_t ulIntervalV, const uint8_t ubBackupV)
+{
+   clFileMutexP.lock();
+   ulRotateSizeP     = ulSizeV;
+   ulRotateIntervalP = ulIntervalV;
+   ubRotateBackupP   = ubBackupV;
+   clFileMutexP.unlock();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLogWriter::stop()                                                                                              //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanLogWriter::stop(void)
+{
+   btRunP.store(false, std::memory_order_release);
+   if (isRunning())
+   {
+      wait();
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // allow a restart of the writer thread by start()
+   //
+   btRunP.store(true, std::memory_order_release);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanLogWriter::writeBatch()                                                                                        //
+// write the collected records to the log files, only called by the writer thread                                     //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanLogWriter::writeBatch(QByteArray * pclBatchV)
+{
+   int64_t sqCurrentMSecsT = QDateTime::currentMSecsSinceEpoch();
+
+   clFileMutexP.lock();
+
+   uint32_t ulFileCountT = ulFileCountP.load(std::memory_order_relaxed);
+   for (uint8_t ubFileT = 0; ubFileT < ulFileCountT; ubFileT++)
+   {
+      QFile * pclLogFileT = apclLogFileP[ubFileT];
+
+      if (pclLogFileT == nullptr)
+      {
+         pclBatchV[ubFileT].clear();
+         continue;
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // time based rotation is checked also without new records
+      //
+      if ((ulRotateIntervalP > 0) &&
+          ((sqCurrentMSecsT - asqRotateTimeP[ubFileT]) >= (static_cast< int64_t >(ulRotateIntervalP) * 1000)))
+      {
+         rotate(ubFileT);
+         pclLogFileT = apclLogFileP[ubFileT];
+      }
+
+      if ((pclLogFileT != nullptr) && (pclBatchV[ubFileT].isEmpty() == false))
+      {
+         pclLogFileT->write(pclBatchV[ubFileT]);
+         pclLogFileT->flush();
+
+         if ((ulRotateSizeP > 0) && (pclLogFileT->size() >= static_cast< int64_t >(ulRotateSizeP)))
+         {
+            rotate(ubFileT);
+         }
+      }
+      pclBatchV[ubFileT].clear();
+   }
+
+   clFileMutexP.unlock();
+}
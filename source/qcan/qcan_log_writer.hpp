@@ -0,0 +1,205 @@
+//====================================================================================================================//
+// File:          qcan_log_writer.hpp                                                                                 //
+// Description:   QCAN classes - Asynchronous log writer                                                              //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_LOG_WRITER_HPP_
+#define QCAN_LOG_WRITER_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+
+#include <atomic>
+#include <cstdint>
+
+#include "qcan_defs.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_LOG_RING_SIZE
+**
+** Number of log records inside the ring of a QCanLogWriter, the value must be a power of two.
+*/
+#define  QCAN_LOG_RING_SIZE                  4096
+
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_LOG_WRITER_PERIOD
+**
+** Time in milliseconds the writer thread of a QCanLogWriter sleeps while the ring is empty.
+*/
+#define  QCAN_LOG_WRITER_PERIOD              50
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanLogWriter
+** \brief   Asynchronous log writer
+**
+** The QCanLogWriter class writes log records to up to #QCAN_NETWORK_LIMIT log files. The records are
+** pushed into a lock-free ring by append(), which never blocks the caller and never accesses a
+** file. A background thread removes the records from the ring and writes them in batches, the
+** files are flushed once per batch.
+** <p>
+** A record is dropped if the ring is full, the writer appends a notice with the number of
+** dropped records to the affected log file. The log files can be rotated by size and by time,
+** see setRotation().
+*/
+class QCanLogWriter : public QThread
+{
+   Q_OBJECT
+
+public:
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclParentV     Pointer to QObject parent class
+   **
+   ** Create new QCanLogWriter object, the writer thread is started by start().
+   */
+   QCanLogWriter(QObject * pclParentV = nullptr);
+
+   ~QCanLogWriter() override;
+
+   QCanLogWriter(const QCanLogWriter&) = delete;                  // no copy constructor
+   QCanLogWriter& operator=(const QCanLogWriter&) = delete;       // no assignment operator
+   QCanLogWriter(QCanLogWriter&&) = delete;                       // no move constructor
+   QCanLogWriter& operator=(QCanLogWriter&&) = delete;            // no move operator
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ubFileV        File index, starting with 0
+   ** \param[in]  clRecordR      Preformatted log record
+   ** \return     \c false if the record has been dropped
+   **
+   ** The function pushes the log record \a clRecordR for the file \a ubFileV into the ring. The
+   ** function is lock-free and may be called from any thread.
+   */
+   bool           append(const uint8_t ubFileV, const QByteArray & clRecordR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of dropped log records
+   **
+   ** The function returns the number of log records which have been dropped because the ring
+   ** was full.
+   */
+   inline uint32_t dropCount(void) const     { return (ulDropCountP.load(std::memory_order_relaxed)); }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ubFileV        File index, starting with 0
+   ** \param[in]  clFileNameR    Log file name
+   ** \return     \c true if file could be opened, otherwise \c false
+   **
+   ** The function opens the log file \a clFileNameR for the file index \a ubFileV, existing
+   ** contents is truncated.
+   */
+   bool           setFileName(const uint8_t ubFileV, const QString & clFileNameR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulSizeV        Maximum file size in bytes, 0 disables the size based rotation
+   ** \param[in]  ulIntervalV    Rotation interval in seconds, 0 disables the time based rotation
+   ** \param[in]  ubBackupV      Number of backup files
+   **
+   ** The function configures the rotation of the log files. A rotated log file is renamed by
+   ** appending the suffix ".1", existing backup files are shifted up to the suffix \a ubBackupV.
+   ** If \a ubBackupV is 0 the log file is truncated. The rotation is disabled by default.
+   */
+   void           setRotation(const uint32_t ulSizeV, const uint32_t ulIntervalV, const uint8_t ubBackupV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** The function writes all pending records and stops the writer thread, the thread can be
+   ** restarted by start().
+   */
+   void           stop(void);
+
+protected:
+
+   void           run(void) override;
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // entry of the ring: the value of ulSequence equals the enqueue position if the entry is free
+   // and the enqueue position + 1 if it holds a record
+   //
+   typedef struct LogSlot_s {
+      std::atomic<uint32_t>   ulSequence;
+      uint8_t                 ubFile;
+      QByteArray              clRecord;
+   } LogSlot_ts;
+
+   bool           dequeue(uint8_t & ubFileR, QByteArray & clRecordR);
+   void           rotate(const uint8_t ubFileV);
+   void           writeBatch(QByteArray * pclBatchV);
+
+   LogSlot_ts              atsRingP[QCAN_LOG_RING_SIZE];
+   std::atomic<uint32_t>   ulHeadP;
+   uint32_t                ulTailP;
+
+   std::atomic<bool>       btRunP;
+   std::atomic<uint32_t>   ulDropCountP;
+   std::atomic<uint32_t>   aulFileDropP[QCAN_NETWORK_LIMIT];
+
+   //---------------------------------------------------------------------------------------------------
+   // number of file indices in use, the value only grows: records for a higher file index are
+   // rejected and the writer thread does not scan the unused indices
+   //
+   std::atomic<uint32_t>   ulFileCountP;
+
+   //---------------------------------------------------------------------------------------------------
+   // the log files are used by the writer thread, the mutex protects them against changes by
+   // setFileName() and setRotation()
+   //
+   QMutex                  clFileMutexP;
+   QFile *                 apclLogFileP[QCAN_NETWORK_LIMIT];
+   int64_t                 asqRotateTimeP[QCAN_NETWORK_LIMIT];
+   uint32_t                ulRotateSizeP;
+   uint32_t                ulRotateIntervalP;
+   uint8_t                 ubRotateBackupP;
+};
+
+#endif   // QCAN_LOG_WRITER_HPP_
@@ -0,0 +1,518 @@
+//====================================================================================================================//
+// File:          qcan_metrics_server.cpp                                                                             //
+// Description:   QCAN classes - OpenMetrics endpoint of CAN server                                                   //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QDebug>
+
+#include "qcan_metrics_server.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------------------------------------------
+// content type of the OpenMetrics text format
+//
+#define  METRICS_CONTENT_TYPE    "application/openmetrics-text; version=1.0.0; charset=utf-8"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Static variables                                                                                                   **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------------------------------------------
+// label values of the latency paths, the order matches QCanNetwork::LatencyPath_e
+//
+static const char * const apszLatencyPath[QCAN_MEMORY_LATENCY_PATH_MAX] = { "canInterface",
+                                                                             "localSocket",
+                                                                             "webSocket",
+                                                                             "tcpSocket",
+                                                                             "muxSocket"     };
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Static functions                                                                                                   **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//--------------------------------------------------------------------------------------------------------------------//
+// appendFamily()                                                                                                     //
+// TYPE and HELP line of a metric family                                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+static void appendFamily(QByteArray & clTextR, const char * pszNameV, const char * pszTypeV, const char * pszHelpV)
+{
+   clTextR.append("# TYPE ");
+   clTextR.append(pszNameV);
+   clTextR.append(' ');
+   clTextR.append(pszTypeV);
+   clTextR.append("\n# HELP ");
+   clTextR.append(pszNameV);
+   clTextR.append(' ');
+   clTextR.append(pszHelpV);
+   clTextR.append('\n');
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// appendSample()                                                                                                     //
+// sample line of a metric, clLabelR holds the label set without braces                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+static void appendSample(QByteArray & clTextR, const char * pszNameV, const QByteArray & clLabelR,
+                         const QByteArray & clValueR)
+{
+   clTextR.append(pszNameV);
+   clTextR.append('{');
+   clTextR.append(clLabelR);
+   clTextR.append("} ");
+   clTextR.append(clValueR);
+   clTextR.append('\n');
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// seconds()                                                                                                          //
+// convert nanoseconds to seconds                                                                                     //
+//--------------------------------------------------------------------------------------------------------------------//
+static QByteArray seconds(const uint64_t uqNanoSecondsV)
+{
+   return (QByteArray::number(static_cast< double >(uqNanoSecondsV) / 1.0e9, 'g', 9));
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMetricsServer()                                                                                                //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanMetricsServer::QCanMetricsServer(QObject * pclParentV)
+   : QObject(pclParentV)
+{
+   connect(&clTcpServerP, &QTcpServer::newConnection, this, &QCanMetricsServer::onClientConnect);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// ~QCanMetricsServer()                                                                                               //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanMetricsServer::~QCanMetricsServer()
+{
+   stop();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMetricsServer::onClientConnect()                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanMetricsServer::onClientConnect(void)
+{
+   while (clTcpServerP.hasPendingConnections())
+   {
+      QTcpSocket * pclSocketT = clTcpServerP.nextPendingConnection();
+
+      clRequestP.insert(pclSocketT, QByteArray());
+
+      connect(pclSocketT, &QTcpSocket::readyRead, this, &QCanMetricsServer::onClientReadyRead);
+      connect(pclSocketT, &QTcpSocket::disconnected, this, &QCanMetricsServer::onClientDisconnect);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMetricsServer::onClientDisconnect()                                                                            //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanMetricsServer::onClientDisconnect(void)
+{
+   QTcpSocket * pclSocketT = qobject_cast<QTcpSocket *>(sender());
+
+   if (pclSocketT != nullptr)
+   {
+      clRequestP.remove(pclSocketT);
+      pclSocketT->deleteLater();
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMetricsServer::onClientReadyRead()                                                                             //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanMetricsServer::onClientReadyRead(void)
+{
+   QTcpSocket * pclSocketT = qobject_cast<QTcpSocket *>(sender());
+
+   if ((pclSocketT == nullptr) || (clRequestP.contains(pclSocketT) == false))
+   {
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // collect the request header, a client sending an oversized header is disconnected
+   //
+   QByteArray & clRequestR = clRequestP[pclSocketT];
+   clRequestR.append(pclSocketT->readAll());
+
+   if (clRequestR.indexOf("\r\n\r\n") < 0)
+   {
+      if (clRequestR.size() > QCAN_METRICS_REQUEST_MAX)
+      {
+         clRequestP.remove(pclSocketT);
+         pclSocketT->abort();
+      }
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // evaluate the request line: only GET is supported, the query part of the path is ignored
+   //
+   QList<QByteArray> clRequestLineT = clRequestR.left(clRequestR.indexOf("\r\n")).split(' ');
+   clRequestP.remove(pclSocketT);
+
+   if (clRequestLineT.size() != 3)
+   {
+      sendResponse(pclSocketT, "400 Bad Request", QByteArray("Bad Request\n"), "text/plain");
+   }
+   else if ((clRequestLineT.at(0) != "GET") && (clRequestLineT.at(0) != "HEAD"))
+   {
+      sendResponse(pclSocketT, "405 Method Not Allowed", QByteArray("Method Not Allowed\n"), "text/plain");
+   }
+   else if (clRequestLineT.at(1).split('?').at(0) != "/metrics")
+   {
+      sendResponse(pclSocketT, "404 Not Found", QByteArray("Not Found\n"), "text/plain");
+   }
+   else
+   {
+      sendResponse(pclSocketT, "200 OK",
+                   (clRequestLineT.at(0) == "GET") ? render() : QByteArray(), METRICS_CONTENT_TYPE);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMetricsServer::port()                                                                                          //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint16_t QCanMetricsServer::port(void) const
+{
+   if (clTcpServerP.isListening())
+   {
+      return (clTcpServerP.serverPort());
+   }
+
+   return (0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMetricsServer::render()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QByteArray QCanMetricsServer::render(void) const
+{
+   QByteArray  clTextT;
+   QByteArray  clLabelT;
+   int32_t     slNetIdxT;
+
+   clTextT.reserve(4096 + (clStatisticListP.size() * 2048));
+
+   //---------------------------------------------------------------------------------------------------
+   // counters and gauges of the CAN networks
+   //
+   appendFamily(clTextT, "canpie_frames", "counter", "Number of CAN frames.");
+   for (slNetIdxT = 0; slNetIdxT < clStatisticListP.size(); slNetIdxT++)
+   {
+      clLabelT = "network=\"" + QByteArray::number(slNetIdxT + 1) + "\"";
+      appendSample(clTextT, "canpie_frames_total", clLabelT,
+                   QByteArray::number(clStatisticListP.at(slNetIdxT).ulFrameCount));
+   }
+
+   appendFamily(clTextT, "canpie_error_frames", "counter", "Number of CAN error frames.");
+   for (slNetIdxT = 0; slNetIdxT < clStatisticListP.size(); slNetIdxT++)
+   {
+      clLabelT = "network=\"" + QByteArray::number(slNetIdxT + 1) + "\"";
+      appendSample(clTextT, "canpie_error_frames_total", clLabelT,
+                   QByteArray::number(clStatisticListP.at(slNetIdxT).ulErrorCount));
+   }
+
+   appendFamily(clTextT, "canpie_bus_load_percent", "gauge", "Bus load in percent.");
+   for (slNetIdxT = 0; slNetIdxT < clStatisticListP.size(); slNetIdxT++)
+   {
+      clLabelT = "network=\"" + QByteArray::number(slNetIdxT + 1) + "\"";
+      appendSample(clTextT, "canpie_bus_load_percent", clLabelT,
+                   QByteArray::number(clStatisticListP.at(slNetIdxT).ubBusLoad));
+   }
+
+   appendFamily(clTextT, "canpie_frames_per_second", "gauge", "Number of CAN frames per second.");
+   for (slNetIdxT = 0; slNetIdxT < clStatisticListP.size(); slNetIdxT++)
+   {
+      clLabelT = "network=\"" + QByteArray::number(slNetIdxT + 1) + "\"";
+      appendSample(clTextT, "canpie_frames_per_second", clLabelT,
+                   QByteArray::number(clStatisticListP.at(slNetIdxT).ulFramesPerSecond));
+   }
+
+   appendFamily(clTextT, "canpie_transmit_queue_frames", "gauge", "Number of CAN frames inside the transmit queue.");
+   for (slNetIdxT = 0; slNetIdxT < clStatisticListP.size(); slNetIdxT++)
+   {
+      clLabelT = "network=\"" + QByteArray::number(slNetIdxT + 1) + "\"";
+      appendSample(clTextT, "canpie_transmit_queue_frames", clLabelT,
+                   QByteArray::number(clStatisticListP.at(slNetIdxT).ulTransmitQueueDepth));
+   }
+
+   appendFamily(clTextT, "canpie_transmit_dropped_frames", "counter",
+                "Number of CAN frames dropped by the transmit queue.");
+   for (slNetIdxT = 0; slNetIdxT < clStatisticListP.size(); slNetIdxT++)
+   {
+      clLabelT = "network=\"" + QByteArray::number(slNetIdxT + 1) + "\"";
+      appendSample(clTextT, "canpie_transmit_dropped_frames_total", clLabelT,
+                   QByteArray::number(clStatisticListP.at(slNetIdxT).ulTransmitDropCount));
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // sockets: the number of clients is given per socket type, drops and queue depth are summed up
+   // over all sockets of a CAN network
+   //
+   appendFamily(clTextT, "canpie_clients", "gauge", "Number of connected sockets.");
+   for (slNetIdxT = 0; slNetIdxT < clStatisticListP.size(); slNetIdxT++)
+   {
+      const CanServerNetworkStatistic_ts & tsStatisticR = clStatisticListP.at(slNetIdxT);
+      uint32_t ulLocalCountT = 0;
+      uint32_t ulTcpCountT   = 0;
+
+      for (uint32_t ulSockIdxT = 0; ulSockIdxT < tsStatisticR.ulSocketCount; ulSockIdxT++)
+      {
+         if (tsStatisticR.atsSocket[ulSockIdxT].ubType == QCAN_MEMORY_SOCKET_LOCAL)
+         {
+            ulLocalCountT++;
+         }
+         else if (tsStatisticR.atsSocket[ulSockIdxT].ubType == QCAN_MEMORY_SOCKET_TCP)
+         {
+            ulTcpCountT++;
+         }
+      }
+
+      clLabelT = "network=\"" + QByteArray::number(slNetIdxT + 1) + "\"";
+      appendSample(clTextT, "canpie_clients", clLabelT + ",type=\"local\"", QByteArray::number(ulLocalCountT));
+      appendSample(clTextT, "canpie_clients", clLabelT + ",type=\"web\"",
+                   QByteArray::number(tsStatisticR.ulSocketCount - ulLocalCountT - ulTcpCountT));
+      appendSample(clTextT, "canpie_clients", clLabelT + ",type=\"tcp\"", QByteArray::number(ulTcpCountT));
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the drop counter of a socket is removed when the socket disconnects, so the sum is a gauge which
+   // decreases at disconnect and the family name does not use the counter naming
+   //
+   appendFamily(clTextT, "canpie_client_dropped_frames_current", "gauge",
+                "Number of CAN frames which could not be written to the connected sockets, "
+                "the value decreases when a socket disconnects.");
+   for (slNetIdxT = 0; slNetIdxT < clStatisticListP.size(); slNetIdxT++)
+   {
+      const CanServerNetworkStatistic_ts & tsStatisticR = clStatisticListP.at(slNetIdxT);
+      uint64_t uqDropCountT = 0;
+
+      for (uint32_t ulSockIdxT = 0; ulSockIdxT < tsStatisticR.ulSocketCount; ulSockIdxT++)
+      {
+         uqDropCountT += tsStatisticR.atsSocket[ulSockIdxT].ulDropCount;
+      }
+
+      clLabelT = "network=\"" + QByteArray::number(slNetIdxT + 1) + "\"";
+      appendSample(clTextT, "canpie_client_dropped_frames_current", clLabelT,
+                   QByteArray::number(static_cast< qulonglong >(uqDropCountT)));
+   }
+
+   appendFamily(clTextT, "canpie_client_queue_frames", "gauge",
+                "Number of CAN frames pending inside the write buffer of the connected sockets.");
+   for (slNetIdxT = 0; slNetIdxT < clStatisticListP.size(); slNetIdxT++)
+   {
+      const CanServerNetworkStatistic_ts & tsStatisticR = clStatisticListP.at(slNetIdxT);
+      uint64_t uqQueueDepthT = 0;
+
+      for (uint32_t ulSockIdxT = 0; ulSockIdxT < tsStatisticR.ulSocketCount; ulSockIdxT++)
+      {
+         uqQueueDepthT += tsStatisticR.atsSocket[ulSockIdxT].ulQueueDepth;
+      }
+
+      clLabelT = "network=\"" + QByteArray::number(slNetIdxT + 1) + "\"";
+      appendSample(clTextT, "canpie_client_queue_frames", clLabelT,
+                   QByteArray::number(static_cast< qulonglong >(uqQueueDepthT)));
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // latency summaries per path, the maximum is given as separate gauge
+   //
+   const char * apszFamilyT[2]    = { "canpie_dispatch_latency_seconds", "canpie_egress_latency_seconds" };
+   const char * apszCountT[2]     = { "canpie_dispatch_latency_seconds_count", "canpie_egress_latency_seconds_count" };
+   const char * apszMaxT[2]       = { "canpie_dispatch_latency_max_seconds", "canpie_egress_latency_max_seconds" };
+   const char * apszHelpT[2]      = { "Latency from reception to dispatch of a CAN frame, per source.",
+                                      "Latency from reception to delivery of a CAN frame, per destination." };
+   const char * apszMaxHelpT[2]   = { "Maximum latency from reception to dispatch of a CAN frame, per source.",
+                                      "Maximum latency from reception to delivery of a CAN frame, per destination." };
+
+   for (int32_t slKindT = 0; slKindT < 2; slKindT++)
+   {
+      appendFamily(clTextT, apszFamilyT[slKindT], "summary", apszHelpT[slKindT]);
+      for (slNetIdxT = 0; slNetIdxT < clStatisticListP.size(); slNetIdxT++)
+      {
+         const CanServerNetworkStatistic_ts & tsStatisticR = clStatisticListP.at(slNetIdxT);
+
+         for (int32_t slPathT = 0; slPathT < QCAN_MEMORY_LATENCY_PATH_MAX; slPathT++)
+         {
+            const CanServerLatency_ts & tsLatencyR = (slKindT == 0) ? tsStatisticR.atsLatencyDispatch[slPathT] :
+                                                                      tsStatisticR.atsLatencyEgress[slPathT];
+
+            clLabelT = "network=\"" + QByteArray::number(slNetIdxT + 1) + "\",path=\"" +
+                       apszLatencyPath[slPathT] + "\"";
+            appendSample(clTextT, apszFamilyT[slKindT], clLabelT + ",quantile=\"0.5\"", seconds(tsLatencyR.uqP50));
+            appendSample(clTextT, apszFamilyT[slKindT], clLabelT + ",quantile=\"0.99\"", seconds(tsLatencyR.uqP99));
+            appendSample(clTextT, apszCountT[slKindT], clLabelT,
+                         QByteArray::number(static_cast< qulonglong >(tsLatencyR.uqCount)));
+         }
+      }
+
+      appendFamily(clTextT, apszMaxT[slKindT], "gauge", apszMaxHelpT[slKindT]);
+      for (slNetIdxT = 0; slNetIdxT < clStatisticListP.size(); slNetIdxT++)
+      {
+         const CanServerNetworkStatistic_ts & tsStatisticR = clStatisticListP.at(slNetIdxT);
+
+         for (int32_t slPathT = 0; slPathT < QCAN_MEMORY_LATENCY_PATH_MAX; slPathT++)
+         {
+            const CanServerLatency_ts & tsLatencyR = (slKindT == 0) ? tsStatisticR.atsLatencyDispatch[slPathT] :
+                                                                      tsStatisticR.atsLatencyEgress[slPathT];
+
+            clLabelT = "network=\"" + QByteArray::number(slNetIdxT + 1) + "\",path=\"" +
+                       apszLatencyPath[slPathT] + "\"";
+            appendSample(clTextT, apszMaxT[slKindT], clLabelT, seconds(tsLatencyR.uqMax));
+         }
+      }
+   }
+
+   clTextT.append("# EOF\n");
+
+   return (clTextT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMetricsServer::sendResponse()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanMetricsServer::sendResponse(QTcpSocket * pclSocketV, const char * pszStatusV,
+                                     const QByteArray & clBodyR, const char * pszContentTypeV)
+{
+   QByteArray clHeaderT;
+
+   clHeaderT.append("HTTP/1.1 ");
+   clHeaderT.append(pszStatusV);
+   clHeaderT.append("\r\nContent-Type: ");
+   clHeaderT.append(pszContentTypeV);
+   clHeaderT.append("\r\nContent-Length: ");
+   clHeaderT.append(QByteArray::number(clBodyR.size()));
+   clHeaderT.append("\r\nConnection: close\r\n\r\n");
+
+   pclSocketV->write(clHeaderT);
+   pclSocketV->write(clBodyR);
+   pclSocketV->disconnectFromHost();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMetricsServer::setStatistic()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanMetricsServer::setStatistic(const int32_t slNetworkV, const CanServerNetworkStatistic_ts & tsStatisticR)
+{
+   if ((slNetworkV < 0) || (slNetworkV >= QCAN_NETWORK_LIMIT))
+   {
+      return;
+   }
+
+   if (slNetworkV >= clStatisticListP.size())
+   {
+      clStatisticListP.resize(slNetworkV + 1);
+   }
+   clStatisticListP[slNetworkV] = tsStatisticR;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMetricsServer::start()                                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanMetricsServer::start(const QHostAddress & clHostAddressR, const uint16_t uwPortV)
+{
+   stop();
+
+   if (clTcpServerP.listen(clHostAddressR, uwPortV) == false)
+   {
+      #ifndef QT_NO_DEBUG_OUTPUT
+      qDebug() << "QCanMetricsServer::start() - failed to listen on port" << uwPortV << ":"
+               << clTcpServerP.errorString();
+      #endif
+      return (false);
+   }
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMetricsServer::stop()                                                                                          //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanMetricsServer::stop(void)
+{
+   if (clTcpServerP.isListening())
+   {
+      clTcpServerP.close();
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // close all connections, the sockets are deleted by onClientDisconnect()
+   //
+   const QList<QTcpSocket *> clSocketListT = clRequestP.keys();
+   for (QTcpSocket * pclSocketT : clSocketListT)
+   {
+      pclSocketT->abort();
+   }
+   clRequestP.clear();
+}
@@ -0,0 +1,180 @@
+//====================================================================================================================//
+// File:          qcan_metrics_server.hpp                                                                             //
+// Description:   QCAN classes - OpenMetrics endpoint of CAN server                                                   //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_METRICS_SERVER_HPP_
+#define QCAN_METRICS_SERVER_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+
+#include <QtNetwork/QHostAddress>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+#include "qcan_server_memory.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_METRICS_REQUEST_MAX
+**
+** Maximum size of a HTTP request header in bytes, a client sending a larger request is disconnected.
+*/
+#define  QCAN_METRICS_REQUEST_MAX            4096
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanMetricsServer
+** \brief   OpenMetrics endpoint
+**
+** The QCanMetricsServer class serves the statistic of the CAN networks in the OpenMetrics text
+** format via HTTP, the path of the endpoint is \c /metrics. The statistic is supplied by the
+** QCanServer via setStatistic() as a copy, so a scrape request never accesses a QCanNetwork and
+** does not delay the dispatching of CAN frames.
+** <p>
+** Counters are reported with the suffix \c _total. The number of CAN frames dropped by the
+** sockets (\c canpie_client_dropped_frames_current) is the sum over the connected sockets, it is
+** a gauge because the value of a socket is removed when the socket disconnects.
+** <p>
+** The endpoint is disabled by default, it is started by QCanServer::setMetricsPort().
+*/
+class QCanMetricsServer : public QObject
+{
+   Q_OBJECT
+
+public:
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclParentV     Pointer to QObject parent class
+   **
+   ** Create new QCanMetricsServer object, the endpoint is not active.
+   */
+   QCanMetricsServer(QObject * pclParentV = nullptr);
+
+   ~QCanMetricsServer() override;
+
+   QCanMetricsServer(const QCanMetricsServer&) = delete;                  // no copy constructor
+   QCanMetricsServer& operator=(const QCanMetricsServer&) = delete;       // no assignment operator
+   QCanMetricsServer(QCanMetricsServer&&) = delete;                       // no move constructor
+   QCanMetricsServer& operator=(QCanMetricsServer&&) = delete;            // no move operator
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if the endpoint is active
+   */
+   inline bool    isActive(void) const      { return (clTcpServerP.isListening());  }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Port number of the endpoint
+   **
+   ** The function returns the port number of the endpoint, the value is 0 if the endpoint is not
+   ** active.
+   */
+   uint16_t       port(void) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     OpenMetrics text
+   **
+   ** The function renders the stored statistic of all CAN networks in the OpenMetrics text format.
+   */
+   QByteArray     render(void) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  slNetworkV     Network index, starting with 0
+   ** \param[in]  tsStatisticR   Statistic of the CAN network
+   **
+   ** The function stores a copy of the statistic of the CAN network \a slNetworkV, which is used for
+   ** the following scrape requests.
+   */
+   void           setStatistic(const int32_t slNetworkV, const CanServerNetworkStatistic_ts & tsStatisticR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clHostAddressR Host address
+   ** \param[in]  uwPortV        Port number
+   ** \return     \c true if the endpoint has been started
+   ** \see        stop()
+   **
+   ** The function starts the endpoint on the address \a clHostAddressR and port \a uwPortV, an
+   ** active endpoint is stopped first.
+   */
+   bool           start(const QHostAddress & clHostAddressR, const uint16_t uwPortV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        start()
+   **
+   ** The function stops the endpoint and closes all connections.
+   */
+   void           stop(void);
+
+private slots:
+
+   void           onClientConnect(void);
+   void           onClientDisconnect(void);
+   void           onClientReadyRead(void);
+
+private:
+
+   void           sendResponse(QTcpSocket * pclSocketV, const char * pszStatusV,
+                               const QByteArray & clBodyR, const char * pszContentTypeV);
+
+   QTcpServer                             clTcpServerP;
+
+   //---------------------------------------------------------------------------------------------------
+   // pending request data of every connected client
+   //
+   QHash<QTcpSocket *, QByteArray>        clRequestP;
+
+   //---------------------------------------------------------------------------------------------------
+   // copy of the network statistic, index 0 is the first network
+   //
+   QVector<CanServerNetworkStatistic_ts>  clStatisticListP;
+};
+
+#endif   // QCAN_METRICS_SERVER_HPP_
@@ -0,0 +1,154 @@
+//====================================================================================================================//
+// File:          qcan_multicast_datagram.cpp                                                                         //
+// Description:   QCAN classes - Datagram of multicast publication                                                    //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QtEndian>
+
+#include "qcan_multicast_datagram.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------------------------------
+// marker and version in byte 0 and 1 of the header
+//
+constexpr uint8_t    MULTICAST_MARKER     = 0xCA;
+constexpr uint8_t    MULTICAST_VERSION    = 1;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMulticastDatagram()                                                                                            //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanMulticastDatagram::QCanMulticastDatagram()
+{
+   clDataP.reserve(static_cast< int32_t >(QCAN_MULTICAST_HEADER_SIZE +
+                                          (QCAN_MULTICAST_FRAME_MAX * QCAN_FRAME_ARRAY_SIZE)));
+   ubCountP    = 0;
+   ulSequenceP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMulticastDatagram::append()                                                                                    //
+// pack CAN frame into datagram                                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+uint8_t * QCanMulticastDatagram::append(const uint8_t ubChannelV, const uint8_t * pubSockDataV)
+{
+   uint8_t * pubDataT;
+
+   //---------------------------------------------------------------------------------------------------
+   // the header of a new datagram holds the sequence number of its first CAN frame
+   //
+   if (ubCountP == 0)
+   {
+      clDataP.resize(QCAN_MULTICAST_HEADER_SIZE);
+      pubDataT    = reinterpret_cast< uint8_t * >(clDataP.data());
+      pubDataT[0] = MULTICAST_MARKER;
+      pubDataT[1] = MULTICAST_VERSION;
+      pubDataT[2] = ubChannelV;
+      qToBigEndian<uint32_t>(ulSequenceP, pubDataT + 4);
+   }
+
+   clDataP.append(reinterpret_cast< const char * >(pubSockDataV), QCAN_FRAME_ARRAY_SIZE);
+   ubCountP++;
+   ulSequenceP++;
+
+   //---------------------------------------------------------------------------------------------------
+   // the number of CAN frames is updated with each CAN frame, so data() is always complete
+   //
+   pubDataT    = reinterpret_cast< uint8_t * >(clDataP.data());
+   pubDataT[3] = ubCountP;
+
+   return (pubDataT + clDataP.size() - QCAN_FRAME_ARRAY_SIZE);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMulticastDatagram::clear()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanMulticastDatagram::clear(void)
+{
+   clDataP.clear();
+   ubCountP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMulticastDatagram::parse()                                                                                     //
+// check header of received datagram                                                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanMulticastDatagram::parse(const uint8_t * pubDataV, const int64_t sqSizeV, const uint8_t ubChannelV,
+                                  uint32_t & ulCountR, uint32_t & ulSequenceR)
+{
+   uint32_t ulCountT;
+
+   if ((pubDataV == nullptr) || (sqSizeV < QCAN_MULTICAST_HEADER_SIZE))
+   {
+      return (false);
+   }
+
+   ulCountT = pubDataV[3];
+   if ((pubDataV[0] != MULTICAST_MARKER) || (pubDataV[1] != MULTICAST_VERSION) || (pubDataV[2] != ubChannelV) ||
+       (sqSizeV != static_cast< int64_t >(QCAN_MULTICAST_HEADER_SIZE + (ulCountT * QCAN_FRAME_ARRAY_SIZE))))
+   {
+      return (false);
+   }
+
+   ulCountR    = ulCountT;
+   ulSequenceR = qFromBigEndian<uint32_t>(pubDataV + 4);
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMulticastDatagram::reset()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanMulticastDatagram::reset(void)
+{
+   clear();
+   ulSequenceP = 0;
+}
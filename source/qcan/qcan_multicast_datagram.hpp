@@ -0,0 +1,146 @@
+//====================================================================================================================//
+// File:          qcan_multicast_datagram.hpp                                                                         //
+// Description:   QCAN classes - Datagram of multicast publication                                                    //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_MULTICAST_DATAGRAM_HPP_
+#define QCAN_MULTICAST_DATAGRAM_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include "qcan_frame.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanMulticastDatagram
+** \brief   Datagram of the multicast publication
+**
+** The QCanMulticastDatagram class packs CAN frames into the datagram format of the multicast
+** publication (see #QCAN_MULTICAST_DEFAULT_PORT): a header of #QCAN_MULTICAST_HEADER_SIZE bytes is
+** followed by up to #QCAN_MULTICAST_FRAME_MAX CAN frames. The sender (QCanNetwork) appends the CAN
+** frames with append() and sends data() when the datagram is full or control returns to the event
+** loop. The receiver (QCanSocket) checks a datagram with the static function parse().
+** <p>
+** The sequence number is counted per CAN frame, it continues when the datagram is cleared.
+*/
+class QCanMulticastDatagram
+{
+public:
+
+   QCanMulticastDatagram();
+
+   ~QCanMulticastDatagram() = default;
+
+   QCanMulticastDatagram(const QCanMulticastDatagram&) = delete;                  // no copy constructor
+   QCanMulticastDatagram& operator=(const QCanMulticastDatagram&) = delete;       // no assignment operator
+   QCanMulticastDatagram(QCanMulticastDatagram&&) = delete;                       // no move constructor
+   QCanMulticastDatagram& operator=(QCanMulticastDatagram&&) = delete;            // no move operator
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ubChannelV     CAN channel of the publishing network
+   ** \param[in]  pubSockDataV   Pointer to raw CAN frame (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \return     Pointer to the copy of the CAN frame inside the datagram
+   **
+   ** The function appends the CAN frame \a pubSockDataV to the datagram, the header is written with
+   ** the first CAN frame. The caller may modify the returned copy (e.g. the delivery stamp). The
+   ** datagram must not be full (see isFull()).
+   */
+   uint8_t *            append(const uint8_t ubChannelV, const uint8_t * pubSockDataV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Remove all CAN frames from the datagram, the sequence number is not changed.
+   */
+   void                 clear(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of CAN frames inside the datagram
+   */
+   inline uint8_t       count(void) const          { return (ubCountP);                                 }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Datagram including the header, empty if no CAN frame has been appended
+   */
+   inline const QByteArray & data(void) const      { return (clDataP);                                  }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if the datagram holds #QCAN_MULTICAST_FRAME_MAX CAN frames
+   */
+   inline bool          isFull(void) const         { return (ubCountP >= QCAN_MULTICAST_FRAME_MAX);     }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubDataV       Pointer to received datagram
+   ** \param[in]  sqSizeV        Size of received datagram in bytes
+   ** \param[in]  ubChannelV     Expected CAN channel
+   ** \param[out] ulCountR       Number of CAN frames inside the datagram
+   ** \param[out] ulSequenceR    Sequence number of the first CAN frame
+   ** \return     \c true if the datagram is valid
+   **
+   ** The function checks the header of the datagram \a pubDataV: marker, version and CAN channel
+   ** must match and the size must be consistent with the number of CAN frames. The first CAN frame
+   ** starts at offset #QCAN_MULTICAST_HEADER_SIZE.
+   */
+   static bool          parse(const uint8_t * pubDataV, const int64_t sqSizeV, const uint8_t ubChannelV,
+                              uint32_t & ulCountR, uint32_t & ulSequenceR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Remove all CAN frames from the datagram and restart the sequence number with 0.
+   */
+   void                 reset(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Sequence number of the next CAN frame
+   */
+   inline uint32_t      sequence(void) const       { return (ulSequenceP);                              }
+
+private:
+
+   QByteArray           clDataP;
+   uint8_t              ubCountP;
+   uint32_t             ulSequenceP;
+};
+
+#endif   // QCAN_MULTICAST_DATAGRAM_HPP_
@@ -0,0 +1,123 @@
+//====================================================================================================================//
+// File:          qcan_mux_channel.cpp                                                                                //
+// Description:   QCAN classes - Channel selection of multiplexed connection                                          //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QtEndian>
+
+#include <cstring>
+
+#include "qcan_mux_channel.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMuxChannel()                                                                                                   //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanMuxChannel::QCanMuxChannel()
+{
+   clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMuxChannel::clear()                                                                                            //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanMuxChannel::clear(void)
+{
+   ubTrmChannelP = 0;
+   ubRcvChannelP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMuxChannel::receiveControl()                                                                                   //
+// evaluate channel select message                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanMuxChannel::receiveControl(const uint8_t * pubSockDataV, const uint32_t ulChannelMaxV)
+{
+   uint32_t ulChannelT;
+
+   if ((pubSockDataV[QCAN_FRAME_ARRAY_SIZE - 1] != QCAN_CONTROL_MARKER) ||
+       (pubSockDataV[0] != QCAN_CONTROL_CHANNEL_SELECT))
+   {
+      return (false);
+   }
+
+   ulChannelT    = qFromBigEndian<uint32_t>(pubSockDataV + 4);
+   ubRcvChannelP = (ulChannelT <= ulChannelMaxV) ? static_cast< uint8_t >(ulChannelT) : 0;
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMuxChannel::selectMessage()                                                                                    //
+// create channel select message                                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanMuxChannel::selectMessage(const uint8_t ubChannelV, uint8_t * pubDataV)
+{
+   memset(pubDataV, 0, QCAN_FRAME_ARRAY_SIZE);
+   pubDataV[0]  = QCAN_CONTROL_CHANNEL_SELECT;
+   qToBigEndian<uint32_t>(ubChannelV, pubDataV + 4);
+   pubDataV[94] = 0xCA;
+   pubDataV[95] = QCAN_CONTROL_MARKER;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMuxChannel::transmitSelect()                                                                                   //
+// check if channel select message is required                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanMuxChannel::transmitSelect(const uint8_t ubChannelV, uint8_t * pubSelectV)
+{
+   //---------------------------------------------------------------------------------------------------
+   // the channel select message is only required if the channel changes
+   //
+   if (ubChannelV == ubTrmChannelP)
+   {
+      return (false);
+   }
+
+   selectMessage(ubChannelV, pubSelectV);
+   ubTrmChannelP = ubChannelV;
+
+   return (true);
+}
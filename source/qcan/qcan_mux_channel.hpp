@@ -0,0 +1,124 @@
+//====================================================================================================================//
+// File:          qcan_mux_channel.hpp                                                                                //
+// Description:   QCAN classes - Channel selection of multiplexed connection                                          //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_MUX_CHANNEL_HPP_
+#define QCAN_MUX_CHANNEL_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include "qcan_frame.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanMuxChannel
+** \brief   Channel selection of a multiplexed connection
+**
+** The QCanMuxChannel class holds the channel selection of both directions of a multiplexed
+** connection (see QCanMuxSocket). The control message #QCAN_CONTROL_CHANNEL_SELECT defines the
+** channel of all following CAN frames, it is only sent when the channel changes. The channel value
+** 0 denotes no channel, CAN frames without a valid channel are discarded by the receiver.
+*/
+class QCanMuxChannel
+{
+public:
+
+   QCanMuxChannel();
+
+   ~QCanMuxChannel() = default;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Reset the channel of both directions to 0, so the next CAN frame is preceded by a channel
+   ** select message.
+   */
+   void                 clear(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Channel of the received CAN frames, 0 for no channel
+   */
+   inline uint8_t       receiveChannel(void) const    { return (ubRcvChannelP);                         }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pubSockDataV   Pointer to received control message (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \param[in]  ulChannelMaxV  Highest valid channel
+   ** \return     \c true if the message is a channel select message
+   **
+   ** The function evaluates the control message \a pubSockDataV. A channel select message with a
+   ** channel above \a ulChannelMaxV selects no channel.
+   */
+   bool                 receiveControl(const uint8_t * pubSockDataV, const uint32_t ulChannelMaxV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ubChannelV     Channel value
+   ** \param[out] pubDataV       Buffer of #QCAN_FRAME_ARRAY_SIZE bytes
+   **
+   ** The function creates the channel select message for the channel \a ubChannelV.
+   */
+   static void          selectMessage(const uint8_t ubChannelV, uint8_t * pubDataV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Channel of the transmitted CAN frames, 0 for no channel
+   */
+   inline uint8_t       transmitChannel(void) const   { return (ubTrmChannelP);                         }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ubChannelV     Channel of the next CAN frame
+   ** \param[out] pubSelectV     Buffer of #QCAN_FRAME_ARRAY_SIZE bytes for the channel select message
+   ** \return     \c true if the channel select message must be sent in front of the CAN frame
+   **
+   ** The function checks if the channel \a ubChannelV differs from the channel of the previous CAN
+   ** frame. In this case the channel select message is written to \a pubSelectV and the channel is
+   ** taken as selected.
+   */
+   bool                 transmitSelect(const uint8_t ubChannelV, uint8_t * pubSelectV);
+
+private:
+
+   uint8_t              ubTrmChannelP;
+   uint8_t              ubRcvChannelP;
+};
+
+#endif   // QCAN_MUX_CHANNEL_HPP_
@@ -0,0 +1,252 @@
+//====================================================================================================================//
+// File:          qcan_mux_socket.cpp                                                                                 //
+// Description:   QCAN classes - Multiplexed TCP connection to several CAN networks                                   //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QDebug>
+
+#include "qcan_mux_socket.hpp"
+#include "qcan_network.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------------------------------
+// Size of receive buffer in CAN frames
+//
+constexpr uint32_t   MUX_RCV_BUFFER_FRAMES   = 256;
+
+//------------------------------------------------------------------------------------------------------
+// Maximum number of CAN frames inside the write buffer of the socket, further CAN frames are dropped
+//
+constexpr int64_t    MUX_WRITE_FRAMES        = 8192;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMuxSocket()                                                                                                    //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanMuxSocket::QCanMuxSocket(QTcpSocket * pclSocketV, QObject * pclParentV)
+   : QObject(pclParentV)
+{
+   pclSocketP    = pclSocketV;
+   pclSocketP->setParent(this);
+
+   ulDropCountP  = 0;
+
+   clReceiveDataP.resize(static_cast< int32_t >(MUX_RCV_BUFFER_FRAMES * QCAN_FRAME_ARRAY_SIZE));
+
+   connect(pclSocketP, &QTcpSocket::readyRead,     this, &QCanMuxSocket::onSocketReceive);
+   connect(pclSocketP, &QTcpSocket::disconnected,  this, &QCanMuxSocket::onSocketDisconnect);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// ~QCanMuxSocket()                                                                                                   //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanMuxSocket::~QCanMuxSocket()
+{
+   for (int32_t slNetIdxT = 0; slNetIdxT < apclNetworkP.size(); slNetIdxT++)
+   {
+      if (apclNetworkP.at(slNetIdxT).isNull() == false)
+      {
+         apclNetworkP.at(slNetIdxT)->detachMuxSocket(this);
+      }
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMuxSocket::addNetwork()                                                                                        //
+// attach connection to CAN network                                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanMuxSocket::addNetwork(QCanNetwork * pclNetworkV)
+{
+   int32_t  slNetIdxT;
+
+   if (pclNetworkV == nullptr)
+   {
+      return (false);
+   }
+
+   slNetIdxT = static_cast< int32_t >(pclNetworkV->id()) - 1;
+   if ((slNetIdxT < 0) || (slNetIdxT >= QCAN_NETWORK_LIMIT))
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the list only grows up to the highest attached channel
+   //
+   if (slNetIdxT >= apclNetworkP.size())
+   {
+      apclNetworkP.resize(slNetIdxT + 1);
+   }
+
+   if (apclNetworkP.at(slNetIdxT).isNull() == false)
+   {
+      return (false);
+   }
+
+   if (pclNetworkV->attachMuxSocket(this) == false)
+   {
+      return (false);
+   }
+
+   apclNetworkP[slNetIdxT] = pclNetworkV;
+
+   //---------------------------------------------------------------------------------------------------
+   // CAN frames which have been sent by the client directly after the handshake are already inside
+   // the read buffer, the readyRead() signal is not emitted again for them
+   //
+   if (pclSocketP->bytesAvailable() > 0)
+   {
+      QMetaObject::invokeMethod(this, "onSocketReceive", Qt::QueuedConnection);
+   }
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMuxSocket::onSocketDisconnect()                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanMuxSocket::onSocketDisconnect(void)
+{
+   #ifndef QT_NO_DEBUG_OUTPUT
+   qDebug() << "QCanMuxSocket::onSocketDisconnect()";
+   #endif
+
+   //---------------------------------------------------------------------------------------------------
+   // the networks are detached by the destructor
+   //
+   disconnect(pclSocketP, nullptr, this, nullptr);
+   deleteLater();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMuxSocket::onSocketReceive()                                                                                   //
+// read CAN frames and pass them to the selected network                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanMuxSocket::onSocketReceive(void)
+{
+   int64_t     sqSizeT;
+   int64_t     sqPosT;
+   uint8_t *   pubDataT;
+   uint8_t     ubChannelT;
+
+   if (pclSocketP.isNull())
+   {
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // Read all complete frames in blocks into the receive buffer, a partial frame remains inside the
+   // socket until the next readyRead() signal. CAN frames for a channel which has not been selected
+   // during the handshake are discarded.
+   //
+   sqSizeT = (pclSocketP->bytesAvailable() / QCAN_FRAME_ARRAY_SIZE) * QCAN_FRAME_ARRAY_SIZE;
+   while (sqSizeT > 0)
+   {
+      sqSizeT  = qMin(sqSizeT, static_cast< int64_t >(clReceiveDataP.size()));
+      sqSizeT  = pclSocketP->read(clReceiveDataP.data(), sqSizeT);
+      if (sqSizeT <= 0)
+      {
+         break;
+      }
+
+      pubDataT = reinterpret_cast< uint8_t * >(clReceiveDataP.data());
+      for (sqPosT = 0; (sqPosT + QCAN_FRAME_ARRAY_SIZE) <= sqSizeT; sqPosT += QCAN_FRAME_ARRAY_SIZE)
+      {
+         if (pubDataT[sqPosT + QCAN_FRAME_ARRAY_SIZE - 1] == QCAN_CONTROL_MARKER)
+         {
+            clChannelP.receiveControl(pubDataT + sqPosT, static_cast< uint32_t >(apclNetworkP.size()));
+         }
+         else
+         {
+            ubChannelT = clChannelP.receiveChannel();
+            if ((ubChannelT > 0) && (apclNetworkP.at(ubChannelT - 1).isNull() == false))
+            {
+               apclNetworkP.at(ubChannelT - 1)->receiveMuxFrame(this, pubDataT + sqPosT);
+            }
+         }
+      }
+
+      if (pclSocketP.isNull())
+      {
+         break;
+      }
+      sqSizeT = (pclSocketP->bytesAvailable() / QCAN_FRAME_ARRAY_SIZE) * QCAN_FRAME_ARRAY_SIZE;
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanMuxSocket::write()                                                                                             //
+// write CAN frame of a network                                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanMuxSocket::write(const uint8_t ubChannelV, const uint8_t * pubSockDataV)
+{
+   uint8_t  aubSelectT[QCAN_FRAME_ARRAY_SIZE];
+
+   if ( (pclSocketP.isNull()) ||
+        (pclSocketP->bytesToWrite() >= (MUX_WRITE_FRAMES * static_cast< int64_t >(QCAN_FRAME_ARRAY_SIZE))) )
+   {
+      ulDropCountP++;
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the channel select message is only required if the channel changes
+   //
+   if (clChannelP.transmitSelect(ubChannelV, &aubSelectT[0]))
+   {
+      pclSocketP->write(reinterpret_cast< const char * >(&aubSelectT[0]), QCAN_FRAME_ARRAY_SIZE);
+   }
+
+   pclSocketP->write(reinterpret_cast< const char * >(pubSockDataV), QCAN_FRAME_ARRAY_SIZE);
+
+   return (true);
+}
@@ -0,0 +1,155 @@
+//====================================================================================================================//
+// File:          qcan_mux_socket.hpp                                                                                 //
+// Description:   QCAN classes - Multiplexed TCP connection to several CAN networks                                   //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_MUX_SOCKET_HPP_
+#define QCAN_MUX_SOCKET_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QVector>
+
+#include <QtNetwork/QTcpSocket>
+
+#include "qcan_defs.hpp"
+#include "qcan_mux_channel.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Referenced classes                                                                                                 **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+class QCanNetwork;
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanMuxSocket
+** \brief   Multiplexed TCP connection to several CAN networks
+**
+** The QCanMuxSocket class carries the CAN frames of several CAN networks over one raw TCP connection.
+** It is created by the QCanServer when a client sends the handshake line "MUX <channel> <channel> ..."
+** (see #QCAN_TCP_SOCKET_DEFAULT_PORT) and attached to each selected QCanNetwork.
+** <p>
+** The connection carries the usual stream of CAN frames (#QCAN_FRAME_ARRAY_SIZE bytes each) in both
+** directions. The control message #QCAN_CONTROL_CHANNEL_SELECT defines the channel of all following
+** CAN frames, it is only sent when the channel changes. Other control messages are not evaluated on
+** a multiplexed connection.
+** <p>
+** CAN frames are appended to the write buffer of the TCP socket without flushing it, so all CAN
+** frames of all networks dispatched within one pass of the event loop are sent in a single segment.
+*/
+class QCanMuxSocket : public QObject
+{
+   Q_OBJECT
+
+public:
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclSocketV     Pointer to TCP socket, the handshake must have been completed
+   ** \param[in]  pclParentV     Pointer to QObject parent class
+   **
+   ** Create new QCanMuxSocket object, the object takes over the ownership of \a pclSocketV and
+   ** deletes itself when the connection has been closed.
+   */
+   QCanMuxSocket(QTcpSocket * pclSocketV, QObject * pclParentV = nullptr);
+
+   ~QCanMuxSocket() override;
+
+   QCanMuxSocket(const QCanMuxSocket&) = delete;                  // no copy constructor
+   QCanMuxSocket& operator=(const QCanMuxSocket&) = delete;       // no assignment operator
+   QCanMuxSocket(QCanMuxSocket&&) = delete;                       // no move constructor
+   QCanMuxSocket& operator=(QCanMuxSocket&&) = delete;            // no move operator
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclNetworkV    Pointer to CAN network
+   ** \return     \c true if the network has accepted the connection
+   **
+   ** Attach the connection to the CAN network \a pclNetworkV, see QCanNetwork::attachMuxSocket().
+   */
+   bool                 addNetwork(QCanNetwork * pclNetworkV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of CAN frames dropped because the client did not keep up
+   */
+   inline uint32_t      dropCount(void) const      { return (ulDropCountP);                             }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Pointer to TCP socket
+   */
+   inline QTcpSocket *  socket(void) const         { return (pclSocketP);                               }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ubChannelV     Channel of the CAN frame
+   ** \param[in]  pubSockDataV   Pointer to raw CAN frame (#QCAN_FRAME_ARRAY_SIZE bytes)
+   ** \return     \c true if the CAN frame has been written
+   **
+   ** The function is called by the QCanNetwork for each dispatched CAN frame. A channel select
+   ** message is written in front of the CAN frame if the channel differs from the previous CAN
+   ** frame. The CAN frame is dropped if the write buffer of the socket exceeds its limit.
+   */
+   bool                 write(const uint8_t ubChannelV, const uint8_t * pubSockDataV);
+
+private slots:
+
+   void  onSocketDisconnect(void);
+   void  onSocketReceive(void);
+
+private:
+
+   QPointer<QTcpSocket> pclSocketP;
+
+   //---------------------------------------------------------------------------------------------------
+   // apclNetworkP holds the attached networks, the index is the channel - 1
+   //
+   QVector<QPointer<QCanNetwork>> apclNetworkP;
+
+   //---------------------------------------------------------------------------------------------------
+   // channel of the last CAN frame written to and read from the socket
+   //
+   QCanMuxChannel       clChannelP;
+
+   QByteArray           clReceiveDataP;
+   uint32_t             ulDropCountP;
+};
+
+#endif   // QCAN_MUX_SOCKET_HPP_
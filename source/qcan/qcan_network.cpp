@@ -33,12 +33,20 @@
 **                                                                                                                    **
 \*--------------------------------------------------------------------------------------------------------------------*/
 
+#include <QtCore/QDeadlineTimer>
 #include <QtCore/QDebug>
 
+#include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QtEndian>
+
+#include <QtNetwork/QNetworkInterface>
+
+#include <cstring>
 
 #include "qcan_defs.hpp"
+#include "qcan_frame_bits.hpp"
 #include "qcan_interface.hpp"
 #include "qcan_network.hpp"
 
@@ -55,6 +63,33 @@
 //
 #define  REFRESH_TIMER_CYCLE_PERIOD          500
 
+//------------------------------------------------------------------------------------------------------
+// Number of CAN frames which are read from a local socket with a single call
+//
+constexpr int32_t    LOCAL_SOCKET_RCV_FRAMES = 256;
+
+//------------------------------------------------------------------------------------------------------
+// Maximum number of CAN frames pending inside the write buffer of a TCP socket, further CAN frames
+// are dropped until the client has caught up
+//
+#define  TCP_SOCKET_WRITE_FRAMES             4096
+
+//------------------------------------------------------------------------------------------------------
+// Time to live of multicast datagrams, the datagrams do not leave the local network
+//
+#define  MULTICAST_TTL                       1
+
+//------------------------------------------------------------------------------------------------------
+// Defines the cycle time of the onCyclicTimerEvent() method, this is the resolution of the cyclic
+// transmit table
+//
+#define  CYCLIC_TIMER_PERIOD                 1
+
+//------------------------------------------------------------------------------------------------------
+// Defines the retry period in milliseconds for CAN frames inside the transmit queue
+//
+#define  TRANSMIT_TIMER_PERIOD               1
+
 
 
 /*--------------------------------------------------------------------------------------------------------------------*\
@@ -63,8 +98,6 @@
 \*--------------------------------------------------------------------------------------------------------------------*/
 uint8_t  QCanNetwork::ubNetIdP = 0;
 
-static uint32_t   aulDlc2Bitlength[] = { 0,  8,  16,  24,  32,  40,  48,  56,
-                                        64, 96, 128, 160, 192, 256, 384, 512  };
 
 /*--------------------------------------------------------------------------------------------------------------------*\
 ** Static functions                                                                                                   **
@@ -183,16 +216,19 @@ QCanNetwork::QCanNetwork(QObject * pclParentV)
    pclLocalSrvP = new QLocalServer();
 
    //---------------------------------------------------------------------------------------------------
-   // configure initial local socket list
+   // the number of sockets is limited by socketMax(), the socket lists and the receive buffer are
+   // allocated by allocateResources()
    //
-   clLocalSockListP.reserve(QCAN_LOCAL_SOCKET_MAX);
-
+   ulSocketLimitP = 0;
 
    //---------------------------------------------------------------------------------------------------
-   // configure initial WebSocket list for CAN frames and settings
+   // multicast publication is disabled by default, the pending datagram is sent by a zero timer
    //
-   clWebSockListP.reserve(QCAN_WEB_SOCKET_MAX);
-   clSettingsListP.reserve(QCAN_WEB_SOCKET_MAX);
+   pclMulticastSocketP  = nullptr;
+   uwMulticastPortP     = QCAN_MULTICAST_DEFAULT_PORT;
+   clMulticastTimerP.setSingleShot(true);
+   clMulticastTimerP.setInterval(0);
+   connect(&clMulticastTimerP, &QTimer::timeout, this, &QCanNetwork::onMulticastTimeout);
 
 
    //---------------------------------------------------------------------------------------------------
@@ -200,9 +236,11 @@ QCanNetwork::QCanNetwork(QObject * pclParentV)
    //
    ulCntFrameCanP = 0;
    ulCntFrameErrP = 0;
-   ulCntBitCurP   = 0;
+   uqCntBitNomP   = 0;
+   uqCntBitDatP   = 0;
 
    ulFramePerSecMaxP = 0;
+   ulFramePerSecP    = 0;
    ulFrameCntSaveP   = 0;
 
    ubBusLoadP = 0;
@@ -218,6 +256,13 @@ QCanNetwork::QCanNetwork(QObject * pclParentV)
    btFlexibleDataEnabledP  = false;
    btBitrateChangeEnabledP = false;
    btTimeStampEnabledP     = true;
+   ubDeliveryStampP        = QCAN_DELIVERY_STAMP_NONE;
+
+   //---------------------------------------------------------------------------------------------------
+   // coalescing of error frames is disabled by default
+   //
+   clErrorCoalesceTimerP.setSingleShot(true);
+   connect(&clErrorCoalesceTimerP, &QTimer::timeout, this, &QCanNetwork::onErrorCoalesceTimeout);
 
    //---------------------------------------------------------------------------------------------------
    // setup default bit-rate
@@ -239,6 +284,27 @@ QCanNetwork::QCanNetwork(QObject * pclParentV)
    clRefreshTimerP.setInterval(REFRESH_TIMER_CYCLE_PERIOD);
    clRefreshTimerP.start();
 
+   //---------------------------------------------------------------------------------------------------
+   // configure the timer for cyclic CAN frames, it is only running if the cyclic transmit table
+   // contains entries
+   //
+   clCyclicFrameListP.reserve(QCAN_CYCLIC_FRAME_MAX);
+   clCyclicTimerP.setTimerType(Qt::PreciseTimer);
+   clCyclicTimerP.setInterval(CYCLIC_TIMER_PERIOD);
+   connect(&clCyclicTimerP, &QTimer::timeout, this, &QCanNetwork::onCyclicTimerEvent);
+   clCyclicTimeP.start();
+
+   //---------------------------------------------------------------------------------------------------
+   // configure the timer for the transmit queue, it is only running if the queue is not empty
+   //
+   clTrmQueueTimerP.setTimerType(Qt::PreciseTimer);
+   clTrmQueueTimerP.setInterval(TRANSMIT_TIMER_PERIOD);
+   connect(&clTrmQueueTimerP, &QTimer::timeout, this, &QCanNetwork::onTransmitTimerEvent);
+   clTrmQueueTimeP.start();
+
+   clRouteTimeP.start();
+
+   clFrameTimeP.start();
 }
 
 
@@ -258,12 +324,17 @@ QCanNetwork::~QCanNetwork()
    }
 
    //---------------------------------------------------------------------------------------------------
-   // clear list for local socket and web socket
+   // clear list for local socket, web socket, TCP socket and multiplexed connections
    //
    clLocalSockListP.clear();
    clWebSockListP.clear();
+   clTcpSockListP.clear();
+   clMuxSockListP.clear();
    clSettingsListP.clear();
 
+   qDeleteAll(clChangeFilterP);
+   clChangeFilterP.clear();
+
    //---------------------------------------------------------------------------------------------------
    // close local server
    //
@@ -281,6 +352,60 @@ QCanNetwork::~QCanNetwork()
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::addBridge()                                                                                           //
+// add bridge link to remote server                                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::addBridge(QCanBridge * pclBridgeV)
+{
+   if ((pclBridgeV == nullptr) || (clBridgeListP.contains(pclBridgeV)))
+   {
+      return;
+   }
+
+   clBridgeListP.append(pclBridgeV);
+
+   emit addLogMessage(QCan::CAN_Channel_e (id()),
+                      QString("Add bridge %1 to %2:%3, CAN %4").arg(pclBridgeV->handle())
+                                                               .arg(pclBridgeV->remoteAddress().toString())
+                                                               .arg(pclBridgeV->remotePort())
+                                                               .arg(pclBridgeV->remoteChannel()),
+                      QCan::eLOG_LEVEL_INFO);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::addCyclicFrame()                                                                                      //
+// add CAN frame to cyclic transmit table                                                                             //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanNetwork::addCyclicFrame(const uint32_t ulHandleV, const QCanFrame & clFrameR, const uint32_t ulPeriodV,
+                                 const int32_t slCounterPosV)
+{
+   bool  btResultT;
+
+   clCyclicMutexP.lock();
+   btResultT = clCyclicTableP.addFrame(ulHandleV, clFrameR, ulPeriodV, slCounterPosV,
+                                       static_cast< uint64_t >(clCyclicTimeP.elapsed()));
+   clCyclicMutexP.unlock();
+
+   if (btResultT)
+   {
+      emit addLogMessage(QCan::CAN_Channel_e (id()),
+                         QString("Start cyclic frame %1, ID 0x%2, period %3 ms").arg(ulHandleV)
+                                                                              .arg(clFrameR.identifier(), 0, 16)
+                                                                              .arg(ulPeriodV),
+                         QCan::eLOG_LEVEL_INFO);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the timer is controlled inside the thread of the network
+   //
+   QMetaObject::invokeMethod(this, "onCyclicTimerUpdate", Qt::AutoConnection);
+
+   return (btResultT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetwork::addInterface()                                                                                        //
 // add physical CAN interface (plug-in)                                                                               //
@@ -325,11 +450,167 @@ bool QCanNetwork::addInterface(QCanInterface * pclCanIfV)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::addRoute()                                                                                            //
+// add routing rule to other network                                                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanNetwork::addRoute(const QCanRoute & clRouteR, QCanNetwork * pclTargetV)
+{
+   Route_ts tsRouteT;
+
+   if ((pclTargetV == nullptr) || (pclTargetV == this) || (clRouteR.isValid() == false))
+   {
+      return (false);
+   }
+
+   removeRoute(clRouteR.handle());
+
+   tsRouteT.clRoute   = clRouteR;
+   tsRouteT.pclTarget = pclTargetV;
+   atsRouteP.append(tsRouteT);
+
+   emit addLogMessage(QCan::CAN_Channel_e (id()),
+                      QString("Add route %1 to CAN %2").arg(clRouteR.handle()).arg(pclTargetV->id()),
+                      QCan::eLOG_LEVEL_INFO);
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::allocateResources()                                                                                   //
+// allocate receive buffer and socket lists                                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::allocateResources(void)
+{
+   if (clLocalSockDataP.isEmpty() == false)
+   {
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the receive buffer for local sockets and TCP sockets is allocated only once
+   //
+   clLocalSockDataP.resize(static_cast< int32_t >(LOCAL_SOCKET_RCV_FRAMES * QCAN_FRAME_ARRAY_SIZE));
+
+   //---------------------------------------------------------------------------------------------------
+   // configure initial socket lists
+   //
+   clLocalSockMutexP.lock();
+   clLocalSockListP.reserve(static_cast< int32_t >(socketMax(QCAN_LOCAL_SOCKET_MAX)));
+   clLocalSockMutexP.unlock();
+
+   clWebSockMutexP.lock();
+   clWebSockListP.reserve(static_cast< int32_t >(socketMax(QCAN_WEB_SOCKET_MAX)));
+   clSettingsListP.reserve(static_cast< int32_t >(socketMax(QCAN_WEB_SOCKET_MAX)));
+   clWebSockMutexP.unlock();
+
+   clTcpSockMutexP.lock();
+   clTcpSockListP.reserve(static_cast< int32_t >(socketMax(QCAN_TCP_SOCKET_MAX)));
+   clTcpSockMutexP.unlock();
+
+   clMuxSockMutexP.lock();
+   clMuxSockListP.reserve(static_cast< int32_t >(socketMax(QCAN_TCP_SOCKET_MAX)));
+   clMuxSockMutexP.unlock();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::appendMulticast()                                                                                     //
+// pack CAN frame into pending multicast datagram                                                                     //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::appendMulticast(const uint8_t * pubSockDataV)
+{
+   //---------------------------------------------------------------------------------------------------
+   // the datagram is sent when control returns to the event loop at the latest
+   //
+   if (clMulticastDatagramP.count() == 0)
+   {
+      clMulticastTimerP.start();
+   }
+
+   clMulticastDatagramP.append(static_cast< uint8_t >(channel()), pubSockDataV);
+
+   if (clMulticastDatagramP.isFull())
+   {
+      flushMulticast();
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::attachMuxSocket()                                                                                     //
+// attach multiplexed connection                                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanNetwork::attachMuxSocket(QCanMuxSocket * pclSocketV)
+{
+   bool  btAppendT;
+
+   allocateResources();
+   clMuxSockMutexP.lock();
+   btAppendT = clMuxSockListP.append(pclSocketV, socketMax(QCAN_TCP_SOCKET_MAX));
+   clMuxSockMutexP.unlock();
+
+   if (btAppendT == false)
+   {
+      return (false);
+   }
+
+   logSocketState("Open MuxSocket    -");
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::attachTcpSocket()                                                                                     //
+// attach TCP socket to list                                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanNetwork::attachTcpSocket(QTcpSocket * pclSocketV, const QByteArray & clBridgeIdR)
+{
+   //---------------------------------------------------------------------------------------------------
+   // add this socket to the the socket list
+   //
+   allocateResources();
+   clTcpSockMutexP.lock();
+   if (clTcpSockListP.append(pclSocketV, socketMax(QCAN_TCP_SOCKET_MAX)) == false)
+   {
+      clTcpSockMutexP.unlock();
+      return (false);
+   }
+   clTcpSockMutexP.unlock();
+
+   if (clBridgeIdR.isEmpty() == false)
+   {
+      clBridgeLinkP.insert(pclSocketV, clBridgeIdR);
+   }
+
+   logSocketState("Open TcpSocket    -");
+
+   //---------------------------------------------------------------------------------------------------
+   // Add slots that handle data reception and disconnection of the socket from the server
+   //
+   connect(pclSocketV, &QTcpSocket::readyRead,     this, &QCanNetwork::onTcpSocketNewData);
+   connect(pclSocketV, &QTcpSocket::disconnected,  this, &QCanNetwork::onTcpSocketDisconnect);
+
+   //---------------------------------------------------------------------------------------------------
+   // CAN frames which have been sent by the client directly after the handshake are already inside
+   // the read buffer, the readyRead() signal is not emitted again for them
+   //
+   if (pclSocketV->bytesAvailable() > 0)
+   {
+      QMetaObject::invokeMethod(pclSocketV, "readyRead", Qt::QueuedConnection);
+   }
+
+   return (true);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetwork::attachWebSocket()                                                                                     //
 // attach web socket to list                                                                                          //
 //--------------------------------------------------------------------------------------------------------------------//
-void QCanNetwork::attachWebSocket(QWebSocket * pclSocketV, const enum SocketType_e teSocketTypeV)
+bool QCanNetwork::attachWebSocket(QWebSocket * pclSocketV, const enum SocketType_e teSocketTypeV)
 {
 
    if (teSocketTypeV == eSOCKET_TYPE_CAN_FRAME)
@@ -338,7 +619,11 @@ void QCanNetwork::attachWebSocket(QWebSocket * pclSocketV, const enum SocketType
       // add this socket to the the socket list
       //
       clWebSockMutexP.lock();
-      clWebSockListP.append(pclSocketV);
+      if (clWebSockListP.append(pclSocketV, socketMax(QCAN_WEB_SOCKET_MAX)) == false)
+      {
+         clWebSockMutexP.unlock();
+         return (false);
+      }
       clWebSockMutexP.unlock();
 
       //-------------------------------------------------------------------------------------------
@@ -376,8 +661,119 @@ void QCanNetwork::attachWebSocket(QWebSocket * pclSocketV, const enum SocketType
       connect(pclSocketV, &QWebSocket::disconnected,           this, &QCanNetwork::onWebSocketDisconnect);
       sendNetworkSettings();
    }
-   
 
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::clearCyclicFrames()                                                                                   //
+// remove all CAN frames from cyclic transmit table                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::clearCyclicFrames(void)
+{
+   clCyclicMutexP.lock();
+   clCyclicTableP.clear();
+   clCyclicMutexP.unlock();
+
+   QMetaObject::invokeMethod(this, "onCyclicTimerUpdate", Qt::AutoConnection);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::clearFrameCache()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::clearFrameCache(void)
+{
+   clFrameCacheP.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::clearIdStatistic()                                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::clearIdStatistic(void)
+{
+   clIdStatisticP.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::clearLatency()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::clearLatency(void)
+{
+   int32_t  slPathT;
+
+   for (slPathT = 0; slPathT < eLATENCY_PATH_MAX; slPathT++)
+   {
+      aclLatencyDispatchP[slPathT].clear();
+      aclLatencyEgressP[slPathT].clear();
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::clearRoutes()                                                                                         //
+// remove all routing rules                                                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::clearRoutes(void)
+{
+   atsRouteP.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::coalesceErrorFrame()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanNetwork::coalesceErrorFrame(const QCanFrame & clErrorFrameR, const uint64_t uqIngressTimeV)
+{
+   //---------------------------------------------------------------------------------------------------
+   // an error frame which is identical to the last one is merged into the current run
+   //
+   if (clErrorCoalescingP.merge(clErrorFrameR, uqIngressTimeV))
+   {
+      //-------------------------------------------------------------------------------------------
+      // the window is also checked here, the timer is delayed while the interface delivers a
+      // continuous stream of CAN frames
+      //
+      if (clErrorCoalescingP.isWindowElapsed(uqIngressTimeV))
+      {
+         flushErrorFrames(false);
+      }
+      return (true);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // a different error frame ends the current run and starts a new one, it is dispatched
+   // immediately by the caller
+   //
+   flushErrorFrames(true);
+
+   clErrorCoalescingP.start(clErrorFrameR, uqIngressTimeV);
+   clErrorCoalesceTimerP.start(static_cast< int >(clErrorCoalescingP.window()));
+
+   return (false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::cyclicFrameCount()                                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanNetwork::cyclicFrameCount(void)
+{
+   uint32_t ulCountT;
+
+   clCyclicMutexP.lock();
+   ulCountT = clCyclicTableP.count();
+   clCyclicMutexP.unlock();
+
+   return (ulCountT);
 }
 
 
@@ -418,66 +814,382 @@ QString QCanNetwork::dataBitrateString(void) const
 
 
 //--------------------------------------------------------------------------------------------------------------------//
-// QCanNetwork::hasErrorFrameSupport()                                                                                //
-// Check if the CAN interface has error frame support                                                                 //
+// QCanNetwork::detachMuxSocket()                                                                                     //
+// detach multiplexed connection                                                                                      //
 //--------------------------------------------------------------------------------------------------------------------//
-bool QCanNetwork::hasErrorFrameSupport(void) const
+void QCanNetwork::detachMuxSocket(QCanMuxSocket * pclSocketV)
 {
-   bool btResultT;
+   bool  btRemoveT;
 
-   //---------------------------------------------------------------------------------------------------
-   // If no physical CAN interface is connected, the virtual CAN network can support error frames.
-   // Hence the default is TRUE.
-   //
-   btResultT = true;
+   clMuxSockMutexP.lock();
+   btRemoveT = clMuxSockListP.remove(pclSocketV);
+   clMuxSockMutexP.unlock();
 
-   //---------------------------------------------------------------------------------------------------
-   // Check supported features of physical CAN interface.
-   //
-   if (!pclInterfaceP.isNull())
+   if (btRemoveT)
    {
-      if (pclInterfaceP->supportedFeatures() & QCAN_IF_SUPPORT_ERROR_FRAMES)
-      {
-         btResultT = true;
-      }
-      else
-      {
-         btResultT = false;
-      }
+      clTrmQueueP.removeOrigin(pclSocketV);
+      logSocketState("Close MuxSocket   -");
    }
-
-   return(btResultT);
 }
 
 
 //--------------------------------------------------------------------------------------------------------------------//
-// QCanNetwork::hasFlexibleDataSupport()                                                                              //
-// Check if the CAN interface has CAN FD support                                                                      //
+// QCanNetwork::dispatchCanFrame()                                                                                    //
+// write CAN frame to all clients, update statistic and forward it to other networks                                  //
 //--------------------------------------------------------------------------------------------------------------------//
-bool QCanNetwork::hasFlexibleDataSupport(void) const
+bool  QCanNetwork::dispatchCanFrame(enum FrameSource_e teFrameSrcV, const QObject * pclSockSrcV,
+                                    uint8_t * pubSockDataV, const uint64_t uqIngressTimeV)
 {
-   bool btResultT;
+   int32_t           slSockIdxT;
+   uint32_t          ulBitCountNomT;
+   uint32_t          ulBitCountDatT;
+   bool              btResultT = false;
+   bool              btWrittenT;
+   const uint8_t *   pubDataT;
+   QLocalSocket *    pclLocalSockT;
+   QWebSocket *      pclWebSockT;
+   QTcpSocket *      pclTcpSockT;
+
+   //---------------------------------------------------------------------------------------------------
+   // The delivery stamp holds the lower 32 bits of the monotonic clock, so a client on the same host
+   // is able to calculate the delivery latency. The sequence number is written into a copy of the
+   // CAN frame for each socket below, so the CAN frame passed to the other consumers keeps the
+   // sequence number 0.
+   //
+   if (ubDeliveryStampP != QCAN_DELIVERY_STAMP_NONE)
+   {
+      QCanDeliveryStamp::setTime(pubSockDataV,
+                                 static_cast< uint32_t >(QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs()));
+   }
 
    //---------------------------------------------------------------------------------------------------
-   // If no physical CAN interface is connected, the virtual CAN
-   // network can support FD frames. Hence the default is TRUE.
+   // check all open local sockets and write CAN frame, the list is copied without allocation
    //
-   btResultT = true;
+   clLocalSockMutexP.lock();
+   const QVector<QLocalSocket *> clLocalSockListT = clLocalSockListP.list();
+   clLocalSockMutexP.unlock();
 
-   //---------------------------------------------------------------------------------------------------
-   // Check supported features of physical CAN interface.
-   //
-   if (!pclInterfaceP.isNull())
+   btWrittenT = false;
+   for (slSockIdxT = 0; slSockIdxT < clLocalSockListT.size(); slSockIdxT++)
    {
-      if (pclInterfaceP->supportedFeatures() & QCAN_IF_SUPPORT_CAN_FD)
+      //-------------------------------------------------------------------------------------------
+      // If the socket is the source of the frame: don't copy message
+      //
+      pclLocalSockT = clLocalSockListT.at(slSockIdxT);
+      if (pclLocalSockT == pclSockSrcV)
       {
-         btResultT = true;
+         //-----------------------------------------------------------------------------------
+         // do not copy data back to source
+         //
       }
       else
       {
-         btResultT = false;
-      }
-   }
+         //-----------------------------------------------------------------------------------
+         // copy data to socket
+         //
+         if (isForwarded(pclLocalSockT, pubSockDataV, uqIngressTimeV / 1000000))
+         {
+            pubDataT = pubSockDataV;
+            if (ubDeliveryStampP == QCAN_DELIVERY_STAMP_SEQUENCE)
+            {
+               pubDataT = clDeliveryStampP.stamp(pclLocalSockT, pubSockDataV);
+            }
+            if (pclLocalSockT->write(reinterpret_cast< const char * >(pubDataT),
+                                     QCAN_FRAME_ARRAY_SIZE) != QCAN_FRAME_ARRAY_SIZE)
+            {
+               clSocketDropP[pclLocalSockT]++;
+            }
+            btWrittenT = true;
+         }
+         btResultT = true;
+      }
+   }
+
+   if (btWrittenT)
+   {
+      aclLatencyEgressP[eLATENCY_PATH_LOCAL_SOCKET].record(static_cast< uint64_t >(clFrameTimeP.nsecsElapsed()) -
+                                                           uqIngressTimeV);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // check all open web sockets and write CAN frame, the byte array refers to the frame data without
+   // copying it
+   //
+   clWebSockMutexP.lock();
+   const QVector<QWebSocket *> clWebSockListT = clWebSockListP.list();
+   clWebSockMutexP.unlock();
+
+   btWrittenT = false;
+   for (slSockIdxT = 0; slSockIdxT < clWebSockListT.size(); slSockIdxT++)
+   {
+      //-------------------------------------------------------------------------------------------
+      // If the socket is the source of the frame: don't copy message
+      //
+      pclWebSockT = clWebSockListT.at(slSockIdxT);
+      if (pclWebSockT == pclSockSrcV)
+      {
+         //-----------------------------------------------------------------------------------
+         // do not copy data back to source
+         //
+      }
+      else
+      {
+         //-----------------------------------------------------------------------------------
+         // copy data to socket
+         //
+         if (isForwarded(pclWebSockT, pubSockDataV, uqIngressTimeV / 1000000))
+         {
+            pubDataT = pubSockDataV;
+            if (ubDeliveryStampP == QCAN_DELIVERY_STAMP_SEQUENCE)
+            {
+               pubDataT = clDeliveryStampP.stamp(pclWebSockT, pubSockDataV);
+            }
+            const QByteArray clSockDataT = QByteArray::fromRawData(reinterpret_cast< const char * >(pubDataT),
+                                                                   QCAN_FRAME_ARRAY_SIZE);
+            if (pclWebSockT->sendBinaryMessage(clSockDataT) != QCAN_FRAME_ARRAY_SIZE)
+            {
+               clSocketDropP[pclWebSockT]++;
+            }
+            pclWebSockT->flush();
+            btWrittenT = true;
+         }
+         btResultT = true;
+      }
+   }
+
+   if (btWrittenT)
+   {
+      aclLatencyEgressP[eLATENCY_PATH_WEB_SOCKET].record(static_cast< uint64_t >(clFrameTimeP.nsecsElapsed()) -
+                                                         uqIngressTimeV);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // check all open TCP sockets and write CAN frame: the CAN frame is appended to the write buffer
+   // without flushing it, the write buffer is sent when control returns to the event loop
+   //
+   clTcpSockMutexP.lock();
+   const QVector<QTcpSocket *> clTcpSockListT = clTcpSockListP.list();
+   clTcpSockMutexP.unlock();
+
+   btWrittenT = false;
+   for (slSockIdxT = 0; slSockIdxT < clTcpSockListT.size(); slSockIdxT++)
+   {
+      //-------------------------------------------------------------------------------------------
+      // If the socket is the source of the frame: don't copy message
+      //
+      pclTcpSockT = clTcpSockListT.at(slSockIdxT);
+      if (pclTcpSockT == pclSockSrcV)
+      {
+         //-----------------------------------------------------------------------------------
+         // do not copy data back to source
+         //
+      }
+      else if ((clBridgeLinkP.isEmpty() == false) && (clBridgeLinkP.contains(pclTcpSockT)))
+      {
+         //-----------------------------------------------------------------------------------
+         // a bridge link of a remote server only receives acknowledge messages
+         //
+      }
+      else
+      {
+         //-----------------------------------------------------------------------------------
+         // copy data to socket, the CAN frame is dropped if the client does not keep up
+         //
+         if (isForwarded(pclTcpSockT, pubSockDataV, uqIngressTimeV / 1000000))
+         {
+            pubDataT = pubSockDataV;
+            if (ubDeliveryStampP == QCAN_DELIVERY_STAMP_SEQUENCE)
+            {
+               pubDataT = clDeliveryStampP.stamp(pclTcpSockT, pubSockDataV);
+            }
+            if ((pclTcpSockT->bytesToWrite() >= (TCP_SOCKET_WRITE_FRAMES * QCAN_FRAME_ARRAY_SIZE)) ||
+                (pclTcpSockT->write(reinterpret_cast< const char * >(pubDataT),
+                                    QCAN_FRAME_ARRAY_SIZE) != QCAN_FRAME_ARRAY_SIZE))
+            {
+               clSocketDropP[pclTcpSockT]++;
+            }
+            btWrittenT = true;
+         }
+         btResultT = true;
+      }
+   }
+
+   if (btWrittenT)
+   {
+      aclLatencyEgressP[eLATENCY_PATH_TCP_SOCKET].record(static_cast< uint64_t >(clFrameTimeP.nsecsElapsed()) -
+                                                         uqIngressTimeV);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // multiplexed connections: the connection writes the channel select message if required, change
+   // filter and delivery stamp are not supported
+   //
+   clMuxSockMutexP.lock();
+   const QVector<QCanMuxSocket *> clMuxSockListT = clMuxSockListP.list();
+   clMuxSockMutexP.unlock();
+
+   btWrittenT = false;
+   for (slSockIdxT = 0; slSockIdxT < clMuxSockListT.size(); slSockIdxT++)
+   {
+      if (clMuxSockListT.at(slSockIdxT) != pclSockSrcV)
+      {
+         clMuxSockListT.at(slSockIdxT)->write(ubIdP, pubSockDataV);
+         btWrittenT = true;
+         btResultT  = true;
+      }
+   }
+
+   if (btWrittenT)
+   {
+      aclLatencyEgressP[eLATENCY_PATH_MUX_SOCKET].record(static_cast< uint64_t >(clFrameTimeP.nsecsElapsed()) -
+                                                         uqIngressTimeV);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // publish the CAN frame to the multicast group
+   //
+   if (pclMulticastSocketP != nullptr)
+   {
+      appendMulticast(pubSockDataV);
+   }
+
+
+   //---------------------------------------------------------------------------------------------------
+   // count frame, a coalesced error frame is counted with the number of merged error frames, the
+   // repeat count of other error frames is not evaluated
+   //
+   if ((pubSockDataV[0] & 0x20) > 0)
+   {
+      if ((pubSockDataV[5] & QCAN_FRAME_ERROR_REPEAT_FLAG) > 0)
+      {
+         ulCntFrameErrP += qMax(qFromBigEndian<uint32_t>(pubSockDataV + QCAN_FRAME_ERROR_REPEAT_POS),
+                                static_cast< uint32_t >(1));
+      }
+      else
+      {
+         ulCntFrameErrP++;
+      }
+   }
+   else
+   {
+      ulCntFrameCanP++;
+   }
+   QCanFrameBits::count(pubSockDataV, ulBitCountNomT, ulBitCountDatT);
+   uqCntBitNomP = uqCntBitNomP + ulBitCountNomT;
+   uqCntBitDatP = uqCntBitDatP + ulBitCountDatT;
+   clIdStatisticP.update(pubSockDataV, uqIngressTimeV);
+   clFrameCacheP.update(pubSockDataV);
+
+   //---------------------------------------------------------------------------------------------------
+   // Forward the frame to other networks. The frame is converted only once, each route works on its
+   // own copy because the identifier may be translated. Frames which have been received via a route
+   // are not forwarded again.
+   //
+   if ((atsRouteP.isEmpty() == false) && (teFrameSrcV != eFRAME_SOURCE_ROUTE))
+   {
+      QCanFrame   clRouteFrameT;
+      int32_t     slRouteIdxT;
+      uint64_t    uqTimeT = static_cast< uint64_t >(clRouteTimeP.elapsed());
+
+      clCanFrameRouteP.fromRawData(pubSockDataV);
+      for (slRouteIdxT = 0; slRouteIdxT < atsRouteP.size(); slRouteIdxT++)
+      {
+         Route_ts & tsRouteR = atsRouteP[slRouteIdxT];
+         if (tsRouteR.pclTarget.isNull() == false)
+         {
+            clRouteFrameT = clCanFrameRouteP;
+            if (tsRouteR.clRoute.process(clRouteFrameT, uqTimeT))
+            {
+               tsRouteR.pclTarget->routeCanFrame(clRouteFrameT);
+            }
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // Mirror the frame to remote servers. Frames which have been received from the bridge link of a
+   // remote server are not mirrored again.
+   //
+   if ((clBridgeListP.isEmpty() == false) && (clBridgeLinkP.contains(pclSockSrcV) == false))
+   {
+      int32_t     slBridgeIdxT;
+      uint64_t    uqTimeT = static_cast< uint64_t >(clRouteTimeP.elapsed());
+
+      clCanFrameRouteP.fromRawData(pubSockDataV);
+      for (slBridgeIdxT = 0; slBridgeIdxT < clBridgeListP.size(); slBridgeIdxT++)
+      {
+         if (clBridgeListP.at(slBridgeIdxT).isNull() == false)
+         {
+            clBridgeListP.at(slBridgeIdxT)->process(clCanFrameRouteP, uqTimeT);
+         }
+      }
+   }
+
+   return (btResultT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::hasErrorFrameSupport()                                                                                //
+// Check if the CAN interface has error frame support                                                                 //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanNetwork::hasErrorFrameSupport(void) const
+{
+   bool btResultT;
+
+   //---------------------------------------------------------------------------------------------------
+   // If no physical CAN interface is connected, the virtual CAN network can support error frames.
+   // Hence the default is TRUE.
+   //
+   btResultT = true;
+
+   //---------------------------------------------------------------------------------------------------
+   // Check supported features of physical CAN interface.
+   //
+   if (!pclInterfaceP.isNull())
+   {
+      if (pclInterfaceP->supportedFeatures() & QCAN_IF_SUPPORT_ERROR_FRAMES)
+      {
+         btResultT = true;
+      }
+      else
+      {
+         btResultT = false;
+      }
+   }
+
+   return(btResultT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::hasFlexibleDataSupport()                                                                              //
+// Check if the CAN interface has CAN FD support                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanNetwork::hasFlexibleDataSupport(void) const
+{
+   bool btResultT;
+
+   //---------------------------------------------------------------------------------------------------
+   // If no physical CAN interface is connected, the virtual CAN
+   // network can support FD frames. Hence the default is TRUE.
+   //
+   btResultT = true;
+
+   //---------------------------------------------------------------------------------------------------
+   // Check supported features of physical CAN interface.
+   //
+   if (!pclInterfaceP.isNull())
+   {
+      if (pclInterfaceP->supportedFeatures() & QCAN_IF_SUPPORT_CAN_FD)
+      {
+         btResultT = true;
+      }
+      else
+      {
+         btResultT = false;
+      }
+   }
 
    return(btResultT);
 }
@@ -535,59 +1247,73 @@ bool QCanNetwork::hasSpecificConfigurationSupport(void) const
 
 
 //--------------------------------------------------------------------------------------------------------------------//
-// QCanNetwork::frameSize()                                                                                           //
+// QCanNetwork::frameCache()                                                                                          //
+// snapshot of frame cache                                                                                            //
+//--------------------------------------------------------------------------------------------------------------------//
+QVector<QCanFrame> QCanNetwork::frameCache(void) const
+{
+   QVector<QCanFrame>   clFrameListT;
+   QByteArray           clDataT = clFrameCacheP.data();
+   const uint8_t *      pubDataT = reinterpret_cast< const uint8_t * >(clDataT.constData());
+   int32_t              slPosT;
+
+   clFrameListT.resize(static_cast< int32_t >(clFrameCacheP.count()));
+   for (slPosT = 0; slPosT < clFrameListT.size(); slPosT++)
+   {
+      clFrameListT[slPosT].fromRawData(pubDataT + (slPosT * static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE)));
+   }
+
+   return (clFrameListT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::flushErrorFrames()                                                                                    //
 //                                                                                                                    //
 //--------------------------------------------------------------------------------------------------------------------//
-uint32_t QCanNetwork::frameSize(const QByteArray & clSockDataR)
+void QCanNetwork::flushErrorFrames(const bool btEndRunV)
 {
-   uint32_t ulBitCountT = 0;
+   QCanFrame   clErrorFrameT;
+   uint64_t    uqIngressTimeT;
+   uint8_t     aubSockDataT[QCAN_FRAME_ARRAY_SIZE];
 
    //---------------------------------------------------------------------------------------------------
-   // test for CAN data frame
+   // dispatch the merged error frames: the last error frame of the run carries the number of merged
+   // frames and the time stamp of the first one
    //
-   if ((clSockDataR.at(0) & 0xE0) == 0x00)
+   if (clErrorCoalescingP.takeMerged(clErrorFrameT, uqIngressTimeT))
    {
-      //-------------------------------------------------------------------------------------------
-      // check the DLC value and convert to the number of data bits inside this frame
-      //
-      ulBitCountT = aulDlc2Bitlength[(clSockDataR.at(4) & 0x0F)];
-
-      //-------------------------------------------------------------------------------------------
-      // add the number of bits for the protocol header, including possible stuff bits
-      //
-      switch (clSockDataR.at(5) & 0x03)
-      {
-         //------------------------------------------------
-         // classic CAN, Standard Frame
-         //
-         case 0:
-            ulBitCountT = ulBitCountT + 66;
-            break;
+      clErrorFrameT.toRawData(&aubSockDataT[0]);
+      handleCanFrame(eFRAME_SOURCE_CAN_IF, nullptr, &aubSockDataT[0], uqIngressTimeT);
+   }
 
-         //------------------------------------------------
-         // classic CAN, Extended Frame
-         //
-         case 1:
-            ulBitCountT = ulBitCountT + 90;
-            break;
+   if (btEndRunV == true)
+   {
+      clErrorCoalescingP.stop();
+      clErrorCoalesceTimerP.stop();
+   }
+   else
+   {
+      clErrorCoalescingP.restartWindow(static_cast< uint64_t >(clFrameTimeP.nsecsElapsed()));
+      clErrorCoalesceTimerP.start(static_cast< int >(clErrorCoalescingP.window()));
+   }
+}
 
-         //------------------------------------------------
-         // CAN FD, Standard Frame
-         //
-         case 2:
-            ulBitCountT = ulBitCountT + 66;
-            break;
 
-         //------------------------------------------------
-         // CAN FD, Extended Frame
-         //
-         case 3:
-            ulBitCountT = ulBitCountT + 90;
-            break;
-      }
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::flushMulticast()                                                                                      //
+// send pending multicast datagram                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::flushMulticast(void)
+{
+   if ((clMulticastDatagramP.count() == 0) || (pclMulticastSocketP == nullptr))
+   {
+      return;
    }
 
-   return (ulBitCountT);
+   clMulticastTimerP.stop();
+   pclMulticastSocketP->writeDatagram(clMulticastDatagramP.data(), clMulticastGroupP, uwMulticastPortP);
+   clMulticastDatagramP.clear();
 }
 
 
@@ -595,20 +1321,53 @@ uint32_t QCanNetwork::frameSize(const QByteArray & clSockDataR)
 // QCanNetwork::handleCanFrame()                                                                                      //
 //                                                                                                                    //
 //--------------------------------------------------------------------------------------------------------------------//
-bool  QCanNetwork::handleCanFrame(enum FrameSource_e teFrameSrcV, const int32_t slSockSrcV, QByteArray clSockDataV)
+bool  QCanNetwork::handleCanFrame(enum FrameSource_e teFrameSrcV, const QObject * pclSockSrcV,
+                                  uint8_t * pubSockDataV, const uint64_t uqIngressTimeV)
 {
-   int32_t        slSockIdxT;
-   bool           btResultT = false;
-   QLocalSocket * pclLocalSockT;
-   QWebSocket *   pclWebSockT;
+   uint64_t       uqLatencyT;
+   bool           btErrorFrameT;
+   QCanInterface::InterfaceError_e  teIfErrorT;
+   QCanTransmitQueue::Origin_ts     tsOriginT;
+
+   //---------------------------------------------------------------------------------------------------
+   // latency between reception and processing of the CAN frame, frames created by the network
+   // itself (cyclic transmission, routing) have no ingress
+   //
+   uqLatencyT = static_cast< uint64_t >(clFrameTimeP.nsecsElapsed()) - uqIngressTimeV;
+   switch (teFrameSrcV)
+   {
+      case eFRAME_SOURCE_CAN_IF:
+         aclLatencyDispatchP[eLATENCY_PATH_CAN_IF].record(uqLatencyT);
+         break;
+
+      case eFRAME_SOURCE_LOCAL_SOCKET:
+         aclLatencyDispatchP[eLATENCY_PATH_LOCAL_SOCKET].record(uqLatencyT);
+         break;
+
+      case eFRAME_SOURCE_WEB_SOCKET:
+         aclLatencyDispatchP[eLATENCY_PATH_WEB_SOCKET].record(uqLatencyT);
+         break;
+
+      case eFRAME_SOURCE_TCP_SOCKET:
+         aclLatencyDispatchP[eLATENCY_PATH_TCP_SOCKET].record(uqLatencyT);
+         break;
+
+      case eFRAME_SOURCE_MUX_SOCKET:
+         aclLatencyDispatchP[eLATENCY_PATH_MUX_SOCKET].record(uqLatencyT);
+         break;
+
+      default:
+         break;
+   }
 
    //---------------------------------------------------------------------------------------------------
    // If a local time-stamp shall be set, do this here
    //
    if (btTimeStampEnabledP)
    {
-      QByteArray clLocalTimeStampT = QCanTimeStamp::now().toByteArray();
-      clSockDataV.replace(QCAN_FRAME_TIME_STAMP_POS, 8, clLocalTimeStampT);
+      QCanTimeStamp clLocalTimeStampT = QCanTimeStamp::now();
+      qToBigEndian<uint32_t>(clLocalTimeStampT.seconds(),     pubSockDataV + QCAN_FRAME_TIME_STAMP_POS);
+      qToBigEndian<uint32_t>(clLocalTimeStampT.nanoSeconds(), pubSockDataV + QCAN_FRAME_TIME_STAMP_POS + 4);
    }  
 
    //---------------------------------------------------------------------------------------------------
@@ -617,87 +1376,207 @@ bool  QCanNetwork::handleCanFrame(enum FrameSource_e teFrameSrcV, const int32_t
    //
    if ((pclInterfaceP.isNull() == false) && (teFrameSrcV != eFRAME_SOURCE_CAN_IF))
    {
-      clCanFrameOutP.fromByteArray(clSockDataV);
+      clCanFrameOutP.fromRawData(pubSockDataV);
+
+      //-------------------------------------------------------------------------------------------
+      // If the transmit queue is empty the CAN message is written directly. Error frames are not
+      // subject to bus arbitration, they are never queued.
+      //
+      btErrorFrameT = (clCanFrameOutP.frameType() == QCanFrame::eFRAME_TYPE_ERROR);
+      if (clTrmQueueP.isEmpty() || btErrorFrameT)
+      {
+         teIfErrorT = pclInterfaceP->write(clCanFrameOutP);
+      }
+      else
+      {
+         teIfErrorT = QCanInterface::eERROR_FIFO_TRM_FULL;
+      }
 
       //-------------------------------------------------------------------------------------------
-      // Check if it was possible to write the CAN message, if not we return immediately here.
+      // If the CAN interface is busy the CAN message is stored in the transmit queue. Check if it
+      // was possible to write or queue the CAN message, if not we return immediately here. A
+      // queued CAN message is dispatched to the clients when it is written to the CAN interface
+      // by processTransmitQueue(), so the clients never see a CAN message before it is on the bus.
       //
-      if (pclInterfaceP->write(clCanFrameOutP) != QCanInterface::eERROR_NONE)
+      if ((teIfErrorT == QCanInterface::eERROR_FIFO_TRM_FULL) && (btErrorFrameT == false))
+      {
+         tsOriginT.pclSocket     = pclSockSrcV;
+         tsOriginT.uqIngressTime = uqIngressTimeV;
+         tsOriginT.slSource      = teFrameSrcV;
+         if (clTrmQueueP.enqueue(clCanFrameOutP, static_cast< uint64_t >(clTrmQueueTimeP.elapsed()),
+                                 tsOriginT) == false)
+         {
+            return (false);
+         }
+         processTransmitQueue();
+         return (true);
+      }
+      else if (teIfErrorT != QCanInterface::eERROR_NONE)
       {
          return (false);
       }
+      else
+      {
+         aclLatencyEgressP[eLATENCY_PATH_CAN_IF].record(static_cast< uint64_t >(clFrameTimeP.nsecsElapsed()) -
+                                                        uqIngressTimeV);
+      }
 
    }
 
+   return (dispatchCanFrame(teFrameSrcV, pclSockSrcV, pubSockDataV, uqIngressTimeV));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::handleControl()                                                                                       //
+// handle control message from socket                                                                                 //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::handleControl(QIODevice * pclStreamSockV, QWebSocket * pclWebSockV, const uint8_t * pubSockDataV)
+{
+   QByteArray           clBeginT(QCAN_FRAME_ARRAY_SIZE, 0);
+   QByteArray           clEndT(QCAN_FRAME_ARRAY_SIZE, 0);
+   QByteArray           clCacheT;
+   QCanChangeFilter *   pclFilterT;
+   const QObject *      pclSocketT;
+   uint64_t             uqTimeT;
+   int32_t              slPosT;
+
+   if (pclStreamSockV != nullptr)
+   {
+      pclSocketT = pclStreamSockV;
+   }
+   else
+   {
+      pclSocketT = pclWebSockV;
+   }
 
    //---------------------------------------------------------------------------------------------------
-   // check all open local sockets and write CAN frame
+   // Selection of forwarding mode: a change filter is created for mode 1, an existing filter keeps
+   // its values and only takes over the new maximum silence time
    //
-   for (slSockIdxT = 0; slSockIdxT < clLocalSockListP.size(); slSockIdxT++)
+   if (pubSockDataV[0] == QCAN_CONTROL_FORWARD_MODE)
    {
-      //-------------------------------------------------------------------------------------------
-      // If the frame source is a local socket AND the socket source value is equal to the socket
-      // index: don't copy message
-      //
-      if ( (teFrameSrcV == eFRAME_SOURCE_LOCAL_SOCKET) && (slSockIdxT == slSockSrcV))
+      if (pubSockDataV[1] == 1)
       {
-         //-----------------------------------------------------------------------------------
-         // do not copy data back to source
-         //
+         pclFilterT = clChangeFilterP.value(pclSocketT, nullptr);
+         if (pclFilterT == nullptr)
+         {
+            pclFilterT = new QCanChangeFilter();
+            clChangeFilterP.insert(pclSocketT, pclFilterT);
+         }
+         pclFilterT->setMaxSilence(qFromBigEndian<uint32_t>(pubSockDataV + 4));
       }
       else
       {
-         //-----------------------------------------------------------------------------------
-         // copy data to socket
-         //
-         pclLocalSockT = clLocalSockListP.at(slSockIdxT);
-         pclLocalSockT->write(clSockDataV);
-         btResultT = true;
+         removeChangeFilter(pclSocketT);
       }
+      return;
    }
 
    //---------------------------------------------------------------------------------------------------
-   // check all open web sockets and write CAN frame
+   // The sync message of a bridge link is returned as acknowledge. All previous CAN frames of the
+   // stream have been dispatched already, so the acknowledge covers them.
    //
-   for (slSockIdxT = 0; slSockIdxT < clWebSockListP.size(); slSockIdxT++)
+   if (pubSockDataV[0] == QCAN_CONTROL_BRIDGE_SYNC)
    {
-      //-------------------------------------------------------------------------------------------
-      // If the frame source is a web socket AND the socket source value is equal to the socket
-      // index: don't copy message
-      //
-      if ( (teFrameSrcV == eFRAME_SOURCE_WEB_SOCKET) && (slSockIdxT == slSockSrcV))
+      if (pclStreamSockV != nullptr)
       {
-         //-----------------------------------------------------------------------------------
-         // do not copy data back to source
-         //
-      }
-      else
-      {
-         //-----------------------------------------------------------------------------------
-         // copy data to socket
-         //
-         pclWebSockT = clWebSockListP.at(slSockIdxT);
-         pclWebSockT->sendBinaryMessage(clSockDataV);
-         pclWebSockT->flush();
-         btResultT = true;
+         pclStreamSockV->write(QCanBridgeSequence::acknowledge(pubSockDataV));
       }
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // only the snapshot request is evaluated further
+   //
+   if (pubSockDataV[0] != QCAN_CONTROL_SNAPSHOT_REQUEST)
+   {
+      return;
    }
 
+   //---------------------------------------------------------------------------------------------------
+   // The snapshot is enclosed by a begin and an end message. All CAN frames are handled in the same
+   // thread, so the snapshot is written to the socket without any live CAN frame in between: the
+   // client continues seamlessly with the live stream after the end message.
+   //
+   clCacheT = clFrameCacheP.data();
+
+   clBeginT[0]  = static_cast< char >(QCAN_CONTROL_SNAPSHOT_BEGIN);
+   qToBigEndian<uint32_t>(clFrameCacheP.count(), reinterpret_cast< uint8_t * >(clBeginT.data()) + 4);
+   clBeginT[94] = static_cast< char >(0xCA);
+   clBeginT[95] = static_cast< char >(QCAN_CONTROL_MARKER);
+
+   clEndT[0]    = static_cast< char >(QCAN_CONTROL_SNAPSHOT_END);
+   clEndT[94]   = static_cast< char >(0xCA);
+   clEndT[95]   = static_cast< char >(QCAN_CONTROL_MARKER);
 
    //---------------------------------------------------------------------------------------------------
-   // count frame
+   // the CAN frames of the snapshot are the last values forwarded to a socket with change filter
    //
-   if ((clSockDataV.at(0) & 0x20) > 0)
+   pclFilterT = clChangeFilterP.value(pclSocketT, nullptr);
+   if (pclFilterT != nullptr)
    {
-      ulCntFrameErrP++;
+      uqTimeT = static_cast< uint64_t >(clFrameTimeP.elapsed());
+      for (slPosT = 0; slPosT < clCacheT.size(); slPosT += static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE))
+      {
+         pclFilterT->accept(reinterpret_cast< const uint8_t * >(clCacheT.constData()) + slPosT, uqTimeT);
+      }
    }
-   else
+
+   if (pclStreamSockV != nullptr)
    {
-      ulCntFrameCanP++;
+      pclStreamSockV->write(clBeginT + clCacheT + clEndT);
    }
-   ulCntBitCurP = ulCntBitCurP + frameSize(clSockDataV);
 
-   return (btResultT);
+   if (pclWebSockV != nullptr)
+   {
+      pclWebSockV->sendBinaryMessage(clBeginT);
+      for (slPosT = 0; slPosT < clCacheT.size(); slPosT += static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE))
+      {
+         pclWebSockV->sendBinaryMessage(clCacheT.mid(slPosT, QCAN_FRAME_ARRAY_SIZE));
+      }
+      pclWebSockV->sendBinaryMessage(clEndT);
+      pclWebSockV->flush();
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::idStatistic()                                                                                         //
+// snapshot of statistic per CAN identifier                                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+QJsonArray QCanNetwork::idStatistic(void) const
+{
+   return (clIdStatisticP.toJson(static_cast< uint64_t >(clFrameTimeP.nsecsElapsed())));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::latency()                                                                                             //
+// summary of latency histograms                                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+QJsonObject QCanNetwork::latency(void) const
+{
+   QJsonObject clJsonDispatchT;
+   QJsonObject clJsonEgressT;
+   QJsonObject clJsonLatencyT;
+
+   clJsonDispatchT["canInterface"] = aclLatencyDispatchP[eLATENCY_PATH_CAN_IF].toJson();
+   clJsonDispatchT["localSocket"]  = aclLatencyDispatchP[eLATENCY_PATH_LOCAL_SOCKET].toJson();
+   clJsonDispatchT["webSocket"]    = aclLatencyDispatchP[eLATENCY_PATH_WEB_SOCKET].toJson();
+   clJsonDispatchT["tcpSocket"]    = aclLatencyDispatchP[eLATENCY_PATH_TCP_SOCKET].toJson();
+   clJsonDispatchT["muxSocket"]    = aclLatencyDispatchP[eLATENCY_PATH_MUX_SOCKET].toJson();
+
+   clJsonEgressT["canInterface"]   = aclLatencyEgressP[eLATENCY_PATH_CAN_IF].toJson();
+   clJsonEgressT["localSocket"]    = aclLatencyEgressP[eLATENCY_PATH_LOCAL_SOCKET].toJson();
+   clJsonEgressT["webSocket"]      = aclLatencyEgressP[eLATENCY_PATH_WEB_SOCKET].toJson();
+   clJsonEgressT["tcpSocket"]      = aclLatencyEgressP[eLATENCY_PATH_TCP_SOCKET].toJson();
+   clJsonEgressT["muxSocket"]      = aclLatencyEgressP[eLATENCY_PATH_MUX_SOCKET].toJson();
+
+   clJsonLatencyT["dispatch"]      = clJsonDispatchT;
+   clJsonLatencyT["egress"]        = clJsonEgressT;
+
+   return (clJsonLatencyT);
 }
 
 
@@ -713,11 +1592,23 @@ void QCanNetwork::reset(void)
    //
    ulCntFrameCanP = 0;
    ulCntFrameErrP = 0;
-   ulCntBitCurP   = 0;
+   uqCntBitNomP   = 0;
+   uqCntBitDatP   = 0;
 
    ulFramePerSecMaxP = 0;
+   ulFramePerSecP    = 0;
    ulFrameCntSaveP   = 0;
 
+   clIdStatisticP.clear();
+   clearLatency();
+
+   //--------------------------------------------------------------------------------------
+   // pending CAN frames are discarded
+   //
+   clTrmQueueP.clear();
+   clTrmQueueP.resetDropCount();
+   clTrmQueueTimerP.stop();
+
 
    //--------------------------------------------------------------------------------------
    // the initial network state depends if it is enabled or not
@@ -728,18 +1619,44 @@ void QCanNetwork::reset(void)
    }
    else
    {
-      setCanState(QCan::eCAN_STATE_STOPPED);
+      setCanState(QCan::eCAN_STATE_STOPPED);
+   }
+
+
+   //--------------------------------------------------------------------------------------
+   // If there is a physical CAN interface attached: reset it also
+   //
+   if (pclInterfaceP.isNull() == false)
+   {
+      pclInterfaceP->reset();
+   }
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::isForwarded()                                                                                         //
+// check change filter of socket                                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanNetwork::isForwarded(const QObject * pclSocketV, const uint8_t * pubSockDataV, const uint64_t uqTimeV)
+{
+   QCanChangeFilter *   pclFilterT;
+
+   //---------------------------------------------------------------------------------------------------
+   // in most cases no socket has a change filter, avoid the lookup
+   //
+   if (clChangeFilterP.isEmpty())
+   {
+      return (true);
    }
 
-
-   //--------------------------------------------------------------------------------------
-   // If there is a physical CAN interface attached: reset it also
-   //
-   if (pclInterfaceP.isNull() == false)
+   pclFilterT = clChangeFilterP.value(pclSocketV, nullptr);
+   if (pclFilterT == nullptr)
    {
-      pclInterfaceP->reset();
+      return (true);
    }
 
+   return (pclFilterT->accept(pubSockDataV, uqTimeV));
 }
 
 
@@ -749,12 +1666,36 @@ void QCanNetwork::reset(void)
 //--------------------------------------------------------------------------------------------------------------------//
 void QCanNetwork::logSocketState(const QString & clInfoR)
 {
-   uint32_t ulLocalSocketNumT = static_cast< uint32_t>(clLocalSockListP.size());
-   uint32_t ulWebSocketNumT   = static_cast< uint32_t>(clWebSockListP.size());
+   uint32_t ulLocalSocketNumT;
+   uint32_t ulWebSocketNumT;
+   uint32_t ulTcpSocketNumT;
+   uint32_t ulMuxSocketNumT;
+
+   //---------------------------------------------------------------------------------------------------
+   // the lists may be modified by another thread
+   //
+   clLocalSockMutexP.lock();
+   ulLocalSocketNumT = static_cast< uint32_t>(clLocalSockListP.size());
+   clLocalSockMutexP.unlock();
+
+   clWebSockMutexP.lock();
+   ulWebSocketNumT   = static_cast< uint32_t>(clWebSockListP.size());
+   clWebSockMutexP.unlock();
+
+   clTcpSockMutexP.lock();
+   ulTcpSocketNumT   = static_cast< uint32_t>(clTcpSockListP.size());
+   clTcpSockMutexP.unlock();
 
-   QString clSockOpenT = QString(" total open: %1").arg(ulLocalSocketNumT + ulWebSocketNumT, 2);
+   clMuxSockMutexP.lock();
+   ulMuxSocketNumT   = static_cast< uint32_t>(clMuxSockListP.size());
+   clMuxSockMutexP.unlock();
+
+   QString clSockOpenT = QString(" total open: %1").arg(ulLocalSocketNumT + ulWebSocketNumT + ulTcpSocketNumT +
+                                                       ulMuxSocketNumT, 2);
    clSockOpenT += QString(" -  Local socket: %1").arg(ulLocalSocketNumT, 2);
    clSockOpenT += QString(" -  WebSocket: %1").arg(ulWebSocketNumT, 2);
+   clSockOpenT += QString(" -  TcpSocket: %1").arg(ulTcpSocketNumT, 2);
+   clSockOpenT += QString(" -  MuxSocket: %1").arg(ulMuxSocketNumT, 2);
    emit addLogMessage(channel(), clInfoR + clSockOpenT, QCan::eLOG_LEVEL_DEBUG);
 }
 
@@ -793,6 +1734,75 @@ QString QCanNetwork::nominalBitrateString(void) const
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::onCyclicTimerEvent()                                                                                  //
+// transmit CAN frames of cyclic transmit table                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::onCyclicTimerEvent(void)
+{
+   uint8_t  aubSockDataT[QCAN_FRAME_ARRAY_SIZE];
+   int32_t  slFrameIdxT;
+
+   //---------------------------------------------------------------------------------------------------
+   // Collect the frames which are due. The frames are copied while the mutex is locked, hence an
+   // update of the payload by updateCyclicFrame() is always transmitted as a whole.
+   //
+   clCyclicFrameListP.clear();
+   clCyclicMutexP.lock();
+   clCyclicTableP.process(static_cast< uint64_t >(clCyclicTimeP.elapsed()), clCyclicFrameListP);
+   clCyclicMutexP.unlock();
+
+   if (btNetworkEnabledP == false)
+   {
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // pass the frames to the central message handler, they are sent to the CAN interface and to all
+   // sockets
+   //
+   for (slFrameIdxT = 0; slFrameIdxT < clCyclicFrameListP.size(); slFrameIdxT++)
+   {
+      clCyclicFrameListP.at(slFrameIdxT).toRawData(&aubSockDataT[0]);
+      handleCanFrame(eFRAME_SOURCE_CYCLIC, nullptr, &aubSockDataT[0],
+                     static_cast< uint64_t >(clFrameTimeP.nsecsElapsed()));
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::onCyclicTimerUpdate()                                                                                 //
+// start or stop the timer for cyclic CAN frames                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::onCyclicTimerUpdate(void)
+{
+   if (cyclicFrameCount() > 0)
+   {
+      if (clCyclicTimerP.isActive() == false)
+      {
+         clCyclicTimerP.start();
+      }
+   }
+   else
+   {
+      clCyclicTimerP.stop();
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::onErrorCoalesceTimeout()                                                                              //
+// dispatch merged error frames at the end of the window                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::onErrorCoalesceTimeout(void)
+{
+   //---------------------------------------------------------------------------------------------------
+   // the run continues as long as identical error frames are received
+   //
+   flushErrorFrames(clErrorCoalescingP.pendingCount() == 0);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetwork::onInterfaceConnectionChanged()                                                                        //
 // handle connection states of a physical CAN interface                                                               //
@@ -835,7 +1845,8 @@ void QCanNetwork::onInterfaceLogMessage(QString clMessageV, QCan::LogLevel_e teL
 void QCanNetwork::onInterfaceNewData(void)
 {
    QCanFrame      clCanFrameT;
-   QByteArray     clSockDataT;
+   uint8_t        aubSockDataT[QCAN_FRAME_ARRAY_SIZE];
+   uint64_t       uqIngressTimeT;
 
    //---------------------------------------------------------------------------------------------------
    // read messages from active CAN interface
@@ -845,13 +1856,19 @@ void QCanNetwork::onInterfaceNewData(void)
       QCanInterface::InterfaceError_e teInterfaceStatusT = pclInterfaceP->read(clCanFrameT);
       while (teInterfaceStatusT == QCanInterface::eERROR_NONE)
       {
+         uqIngressTimeT = static_cast< uint64_t >(clFrameTimeP.nsecsElapsed());
+
          //----------------------------------------------------------------------------------------
-         // Convert QCanFrame to a byte array and pass this to the central message handler.
+         // Convert QCanFrame to raw data and pass this to the central message handler.
          // Make sure that the frame source is marked as "CAN interface", the parameter
          // "socket source" does not matter in this case, so we set it to 0 here.
          //
-         clSockDataT = clCanFrameT.toByteArray();
-         handleCanFrame(eFRAME_SOURCE_CAN_IF, 0, clSockDataT);
+         if ((clErrorCoalescingP.window() == 0) || (clCanFrameT.frameType() != QCanFrame::eFRAME_TYPE_ERROR) ||
+             (coalesceErrorFrame(clCanFrameT, uqIngressTimeT) == false))
+         {
+            clCanFrameT.toRawData(&aubSockDataT[0]);
+            handleCanFrame(eFRAME_SOURCE_CAN_IF, nullptr, &aubSockDataT[0], uqIngressTimeT);
+         }
 
          teInterfaceStatusT = pclInterfaceP->read(clCanFrameT);
       }
@@ -934,8 +1951,24 @@ void QCanNetwork::onLocalSocketConnect(void)
    // Get next pending connect and add this socket to the the socket list
    //
    pclSocketT =  pclLocalSrvP->nextPendingConnection();
+   if (pclSocketT == nullptr)
+   {
+      return;
+   }
+
    clLocalSockMutexP.lock();
-   clLocalSockListP.append(pclSocketT);
+   if (clLocalSockListP.append(pclSocketT, socketMax(QCAN_LOCAL_SOCKET_MAX)) == false)
+   {
+      clLocalSockMutexP.unlock();
+
+      //-------------------------------------------------------------------------------------------
+      // the limit of local sockets has been reached, the connection is closed again
+      //
+      emit addLogMessage(QCan::CAN_Channel_e (id()), "Reject LocalSocket - limit reached", QCan::eLOG_LEVEL_WARN);
+      pclSocketT->abort();
+      pclSocketT->deleteLater();
+      return;
+   }
    clLocalSockMutexP.unlock();
 
    //---------------------------------------------------------------------------------------------------
@@ -967,8 +2000,6 @@ void QCanNetwork::onLocalSocketConnect(void)
 //--------------------------------------------------------------------------------------------------------------------//
 void QCanNetwork::onLocalSocketDisconnect(void)
 {
-   int32_t        slSockIdxT;
-   QLocalSocket * pclSockT;
    QLocalSocket * pclSenderT;
 
 
@@ -986,17 +2017,14 @@ void QCanNetwork::onLocalSocketDisconnect(void)
    // remove sender from socket list
    //
    clLocalSockMutexP.lock();
-   for(slSockIdxT = 0; slSockIdxT < clLocalSockListP.size(); slSockIdxT++)
-   {
-      pclSockT = clLocalSockListP.at(slSockIdxT);
-      if (pclSockT == pclSenderT)
-      {
-         clLocalSockListP.remove(slSockIdxT);
-         break;
-      }
-   }
+   clLocalSockListP.remove(pclSenderT);
    clLocalSockMutexP.unlock();
 
+   removeChangeFilter(pclSenderT);
+   clDeliveryStampP.remove(pclSenderT);
+   clSocketDropP.remove(pclSenderT);
+   clTrmQueueP.removeOrigin(pclSenderT);
+
    //---------------------------------------------------------------------------------------------------
    // Prepare log message and send it
    //
@@ -1015,77 +2043,210 @@ void QCanNetwork::onLocalSocketNewData(void)
 {
    QLocalSocket *    pclLocalSockT = qobject_cast<QLocalSocket *>(sender());
    int32_t           slSockIdxT;
-   int32_t           slListSizeT;
-   uint32_t          ulFrameMaxT;
-   QByteArray        clSockDataT;
+   int64_t           sqSizeT;
+   int64_t           sqPosT;
+   uint64_t          uqIngressTimeT;
+   uint8_t *         pubDataT;
 
 
    //---------------------------------------------------------------------------------------------------
-   // lock socket list
+   // get the index of the socket, the mutex is not held during the dispatch
    //
    clLocalSockMutexP.lock();
+   slSockIdxT = clLocalSockListP.indexOf(pclLocalSockT);
+   clLocalSockMutexP.unlock();
 
+   if (slSockIdxT < 0)
+   {
+      return;
+   }
 
    //---------------------------------------------------------------------------------------------------
-   // check all open local sockets and read messages
+   // Read all complete frames in blocks into the receive buffer and handle them in place. A partial
+   // frame remains inside the local socket until the next readyRead() signal.
    //
-   slListSizeT = static_cast< int32_t>(clLocalSockListP.size());
-   for(slSockIdxT = 0; slSockIdxT < slListSizeT; slSockIdxT++)
+   sqSizeT = (pclLocalSockT->bytesAvailable() / QCAN_FRAME_ARRAY_SIZE) * QCAN_FRAME_ARRAY_SIZE;
+   while (sqSizeT > 0)
    {
-      if (pclLocalSockT == clLocalSockListP.at(slSockIdxT))
+      sqSizeT  = qMin(sqSizeT, static_cast< int64_t >(clLocalSockDataP.size()));
+      sqSizeT  = pclLocalSockT->read(clLocalSockDataP.data(), sqSizeT);
+      if (sqSizeT <= 0)
       {
-         ulFrameMaxT = static_cast< uint32_t>(pclLocalSockT->bytesAvailable()) / QCAN_FRAME_ARRAY_SIZE;
-         while (ulFrameMaxT > 0)
-         {
-            clSockDataT = pclLocalSockT->read(QCAN_FRAME_ARRAY_SIZE);
-            handleCanFrame(eFRAME_SOURCE_LOCAL_SOCKET, slSockIdxT, clSockDataT);
+         break;
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // all frames of the block share the same reception time
+      //
+      uqIngressTimeT = static_cast< uint64_t >(clFrameTimeP.nsecsElapsed());
 
-            ulFrameMaxT = static_cast< uint32_t>(pclLocalSockT->bytesAvailable()) / QCAN_FRAME_ARRAY_SIZE;
+      pubDataT = reinterpret_cast< uint8_t * >(clLocalSockDataP.data());
+      for (sqPosT = 0; (sqPosT + QCAN_FRAME_ARRAY_SIZE) <= sqSizeT; sqPosT += QCAN_FRAME_ARRAY_SIZE)
+      {
+         if (pubDataT[sqPosT + QCAN_FRAME_ARRAY_SIZE - 1] == QCAN_CONTROL_MARKER)
+         {
+            handleControl(pclLocalSockT, nullptr, pubDataT + sqPosT);
+         }
+         else
+         {
+            handleCanFrame(eFRAME_SOURCE_LOCAL_SOCKET, pclLocalSockT, pubDataT + sqPosT, uqIngressTimeT);
          }
       }
+
+      sqSizeT = (pclLocalSockT->bytesAvailable() / QCAN_FRAME_ARRAY_SIZE) * QCAN_FRAME_ARRAY_SIZE;
    }
+}
+
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::onMulticastTimeout()                                                                                  //
+// send pending multicast datagram                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::onMulticastTimeout(void)
+{
+   flushMulticast();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// onTcpSocketDisconnect()                                                                                            //
+// remove TCP socket from list                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::onTcpSocketDisconnect(void)
+{
+   QTcpSocket *   pclSenderT;
+
 
    //---------------------------------------------------------------------------------------------------
-   // unlock mutex
+   // get sender of signal
    //
-   clLocalSockMutexP.unlock();
-}
+   pclSenderT = static_cast< QTcpSocket* >(QObject::sender());
+
+   //---------------------------------------------------------------------------------------------------
+   // Disconnect everything connected to the sender
+   //
+   disconnect(pclSenderT, nullptr, nullptr, nullptr);
+
+   //---------------------------------------------------------------------------------------------------
+   // remove sender from socket list
+   //
+   clTcpSockMutexP.lock();
+   clTcpSockListP.remove(pclSenderT);
+   clTcpSockMutexP.unlock();
+
+   removeChangeFilter(pclSenderT);
+   clDeliveryStampP.remove(pclSenderT);
+   clSocketDropP.remove(pclSenderT);
+   clTrmQueueP.removeOrigin(pclSenderT);
+   clBridgeLinkP.remove(pclSenderT);
+
+   //---------------------------------------------------------------------------------------------------
+   // the socket has been accepted by the QCanServer, the network is its owner from now on
+   //
+   pclSenderT->deleteLater();
 
+   logSocketState("Close TcpSocket   -");
+}
 
 
 //--------------------------------------------------------------------------------------------------------------------//
-// QCanNetwork::onWebSocketBinaryData()                                                                               //
-// handle reception of new data on web socket                                                                         //
+// onTcpSocketNewData()                                                                                               //
+// handle reception of new data on TCP socket                                                                         //
 //--------------------------------------------------------------------------------------------------------------------//
-void QCanNetwork::onWebSocketBinaryData(const QByteArray &clMessageR)
+void QCanNetwork::onTcpSocketNewData(void)
 {
+   QTcpSocket *      pclTcpSockT = qobject_cast<QTcpSocket *>(sender());
+   int32_t           slSockIdxT;
+   int64_t           sqSizeT;
+   int64_t           sqPosT;
+   uint64_t          uqIngressTimeT;
+   uint8_t *         pubDataT;
+   QByteArray        clLinkIdT = clBridgeLinkP.value(pclTcpSockT);
 
-   QWebSocket *   pclSocketT = qobject_cast<QWebSocket *>(sender());
-   int32_t        slListSizeT;
 
    //---------------------------------------------------------------------------------------------------
-   // lock web socket mutex
+   // get the index of the socket, the mutex is not held during the dispatch
    //
-   clWebSockMutexP.lock();
+   clTcpSockMutexP.lock();
+   slSockIdxT = clTcpSockListP.indexOf(pclTcpSockT);
+   clTcpSockMutexP.unlock();
+
+   if (slSockIdxT < 0)
+   {
+      return;
+   }
 
    //---------------------------------------------------------------------------------------------------
-   // check all open web sockets and get socket index
+   // Read all complete frames in blocks into the receive buffer and handle them in place. A partial
+   // frame remains inside the TCP socket until the next readyRead() signal.
    //
-   slListSizeT = static_cast< int32_t>(clWebSockListP.size());
-   for(int32_t slSockIdxT = 0; slSockIdxT < slListSizeT; slSockIdxT++)
+   sqSizeT = (pclTcpSockT->bytesAvailable() / QCAN_FRAME_ARRAY_SIZE) * QCAN_FRAME_ARRAY_SIZE;
+   while (sqSizeT > 0)
    {
-      if (clWebSockListP.at(slSockIdxT) == pclSocketT)
+      sqSizeT  = qMin(sqSizeT, static_cast< int64_t >(clLocalSockDataP.size()));
+      sqSizeT  = pclTcpSockT->read(clLocalSockDataP.data(), sqSizeT);
+      if (sqSizeT <= 0)
       {
-         handleCanFrame(eFRAME_SOURCE_WEB_SOCKET, slSockIdxT, clMessageR);
          break;
       }
+
+      //-------------------------------------------------------------------------------------------
+      // all frames of the block share the same reception time
+      //
+      uqIngressTimeT = static_cast< uint64_t >(clFrameTimeP.nsecsElapsed());
+
+      pubDataT = reinterpret_cast< uint8_t * >(clLocalSockDataP.data());
+      for (sqPosT = 0; (sqPosT + QCAN_FRAME_ARRAY_SIZE) <= sqSizeT; sqPosT += QCAN_FRAME_ARRAY_SIZE)
+      {
+         if (pubDataT[sqPosT + QCAN_FRAME_ARRAY_SIZE - 1] == QCAN_CONTROL_MARKER)
+         {
+            handleControl(pclTcpSockT, nullptr, pubDataT + sqPosT);
+         }
+         else if (clLinkIdT.isEmpty() || (clBridgeSequenceP.isDuplicate(clLinkIdT, pubDataT + sqPosT) == false))
+         {
+            handleCanFrame(eFRAME_SOURCE_TCP_SOCKET, pclTcpSockT, pubDataT + sqPosT, uqIngressTimeT);
+         }
+      }
+
+      sqSizeT = (pclTcpSockT->bytesAvailable() / QCAN_FRAME_ARRAY_SIZE) * QCAN_FRAME_ARRAY_SIZE;
    }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::onWebSocketBinaryData()                                                                               //
+// handle reception of new data on web socket                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::onWebSocketBinaryData(const QByteArray &clMessageR)
+{
+
+   QWebSocket *   pclSocketT = qobject_cast<QWebSocket *>(sender());
+   int32_t        slSockIdxT;
+   uint64_t       uqIngressTimeT = static_cast< uint64_t >(clFrameTimeP.nsecsElapsed());
 
    //---------------------------------------------------------------------------------------------------
-   // unlock web socket mutex
+   // get the index of the socket, the mutex is not held during the dispatch
    //
+   clWebSockMutexP.lock();
+   slSockIdxT = clWebSockListP.indexOf(pclSocketT);
    clWebSockMutexP.unlock();
 
+   //---------------------------------------------------------------------------------------------------
+   // the message is copied to a buffer because the time-stamp may be modified
+   //
+   if ((slSockIdxT >= 0) && (clMessageR.size() == QCAN_FRAME_ARRAY_SIZE))
+   {
+      memcpy(&aubWebSockDataP[0], clMessageR.constData(), QCAN_FRAME_ARRAY_SIZE);
+      if (aubWebSockDataP[QCAN_FRAME_ARRAY_SIZE - 1] == QCAN_CONTROL_MARKER)
+      {
+         handleControl(nullptr, pclSocketT, &aubWebSockDataP[0]);
+      }
+      else
+      {
+         handleCanFrame(eFRAME_SOURCE_WEB_SOCKET, pclSocketT, &aubWebSockDataP[0], uqIngressTimeT);
+      }
+   }
 }
 
 //--------------------------------------------------------------------------------------------------------------------//
@@ -1094,8 +2255,6 @@ void QCanNetwork::onWebSocketBinaryData(const QByteArray &clMessageR)
 //--------------------------------------------------------------------------------------------------------------------//
 void QCanNetwork::onWebSocketDisconnect(void)
 {
-   int32_t      slSockIdxT;
-   QWebSocket * pclSockT;
    QWebSocket * pclSenderT;
 
 
@@ -1105,17 +2264,14 @@ void QCanNetwork::onWebSocketDisconnect(void)
    pclSenderT = static_cast< QWebSocket* >(QObject::sender());
 
    clWebSockMutexP.lock();
-   for(slSockIdxT = 0; slSockIdxT < clWebSockListP.size(); slSockIdxT++)
-   {
-      pclSockT = clWebSockListP.at(slSockIdxT);
-      if(pclSockT == pclSenderT)
-      {
-         clWebSockListP.remove(slSockIdxT);
-         break;
-      }
-   }
+   clWebSockListP.remove(pclSenderT);
    clWebSockMutexP.unlock();
 
+   removeChangeFilter(pclSenderT);
+   clDeliveryStampP.remove(pclSenderT);
+   clSocketDropP.remove(pclSenderT);
+   clTrmQueueP.removeOrigin(pclSenderT);
+
    //---------------------------------------------------------------------------------------------------
    // Prepare log message and send it
    //
@@ -1198,22 +2354,195 @@ void QCanNetwork::onWebSocketTextData(const QString &clMessageR)
                setListenOnlyEnabled(true);
                break;
 
-            case QCan::eCAN_MODE_SLEEP:
-            case QCan::eCAN_MODE_SELF_TEST:
+            case QCan::eCAN_MODE_SLEEP:
+            case QCan::eCAN_MODE_SELF_TEST:
+
+               break;
+
+         }
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for "reset" inside JSON object
+      //
+      if (clJsonDocumentT.object().contains("reset"))
+      {
+         if (clJsonDocumentT.object().value("reset").toBool())
+         {
+            reset();
+         }
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for "frameCacheClear" inside JSON object
+      //
+      if (clJsonDocumentT.object().contains("frameCacheClear"))
+      {
+         if (clJsonDocumentT.object().value("frameCacheClear").toBool())
+         {
+            clearFrameCache();
+         }
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for "frameCache" inside JSON object: the CAN frames are sent Base64 encoded to the
+      // requesting WebSocket only
+      //
+      if (clJsonDocumentT.object().contains("frameCache"))
+      {
+         QWebSocket * pclSocketT = qobject_cast<QWebSocket *>(sender());
+
+         if ((clJsonDocumentT.object().value("frameCache").toBool()) && (pclSocketT != nullptr))
+         {
+            QVector<QCanFrame>   clFrameListT = frameCache();
+            QJsonArray           clJsonArrayT;
+            QJsonObject          clJsonCacheT;
+
+            for (int32_t slIndexT = 0; slIndexT < clFrameListT.size(); slIndexT++)
+            {
+               clJsonArrayT.append(QString::fromLatin1(clFrameListT.at(slIndexT).toByteArray().toBase64()));
+            }
+
+            clJsonCacheT["apiVersion"]  = "1.0";
+            clJsonCacheT["channel"]     = static_cast< int32_t >(this->channel());
+            clJsonCacheT["frameCache"]  = clJsonArrayT;
+
+            pclSocketT->sendTextMessage(QJsonDocument(clJsonCacheT).toJson(QJsonDocument::Compact));
+         }
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for "idStatisticClear" inside JSON object
+      //
+      if (clJsonDocumentT.object().contains("idStatisticClear"))
+      {
+         if (clJsonDocumentT.object().value("idStatisticClear").toBool())
+         {
+            clearIdStatistic();
+         }
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for "idStatistic" inside JSON object: the snapshot is only sent to the requesting
+      // WebSocket, because it might be large
+      //
+      if (clJsonDocumentT.object().contains("idStatistic"))
+      {
+         QWebSocket * pclSocketT = qobject_cast<QWebSocket *>(sender());
+
+         if ((clJsonDocumentT.object().value("idStatistic").toBool()) && (pclSocketT != nullptr))
+         {
+            QJsonObject clJsonStatisticT;
+
+            clJsonStatisticT["apiVersion"]  = "1.0";
+            clJsonStatisticT["channel"]     = static_cast< int32_t >(this->channel());
+            clJsonStatisticT["idStatistic"] = idStatistic();
+
+            pclSocketT->sendTextMessage(QJsonDocument(clJsonStatisticT).toJson(QJsonDocument::Compact));
+         }
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for "latencyClear" inside JSON object
+      //
+      if (clJsonDocumentT.object().contains("latencyClear"))
+      {
+         if (clJsonDocumentT.object().value("latencyClear").toBool())
+         {
+            clearLatency();
+         }
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for "deliveryStamp" inside JSON object
+      //
+      if (clJsonDocumentT.object().contains("deliveryStamp"))
+      {
+         setDeliveryStamp(static_cast< uint8_t >(clJsonDocumentT.object().value("deliveryStamp").toInt()));
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for "errorFrameCoalescing" inside JSON object
+      //
+      if (clJsonDocumentT.object().contains("errorFrameCoalescing"))
+      {
+         setErrorFrameCoalescing(static_cast< uint32_t >(
+                                 clJsonDocumentT.object().value("errorFrameCoalescing").toInt()));
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for "transmitDeadline" inside JSON object
+      //
+      if (clJsonDocumentT.object().contains("transmitDeadline"))
+      {
+         setTransmitDeadline(static_cast< uint32_t >(clJsonDocumentT.object().value("transmitDeadline").toInt()));
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for "cyclicClear" inside JSON object, this is evaluated before new entries are added
+      //
+      if (clJsonDocumentT.object().contains("cyclicClear"))
+      {
+         if (clJsonDocumentT.object().value("cyclicClear").toBool())
+         {
+            clearCyclicFrames();
+         }
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for "cyclicStop" inside JSON object: array of handles
+      //
+      if (clJsonDocumentT.object().contains("cyclicStop"))
+      {
+         QJsonArray clJsonArrayT = clJsonDocumentT.object().value("cyclicStop").toArray();
+         int32_t    slIndexT;
+
+         for (slIndexT = 0; slIndexT < clJsonArrayT.size(); slIndexT++)
+         {
+            removeCyclicFrame(static_cast< uint32_t >(clJsonArrayT.at(slIndexT).toInt()));
+         }
+      }
 
-               break;
+      //-------------------------------------------------------------------------------------------
+      // Check for "cyclicStart" inside JSON object: array of objects with "handle", "period",
+      // "counter" (optional) and "frame" (Base64 encoded QCanFrame)
+      //
+      if (clJsonDocumentT.object().contains("cyclicStart"))
+      {
+         QJsonArray  clJsonArrayT = clJsonDocumentT.object().value("cyclicStart").toArray();
+         QJsonObject clJsonEntryT;
+         QCanFrame   clFrameT;
+         int32_t     slIndexT;
 
+         for (slIndexT = 0; slIndexT < clJsonArrayT.size(); slIndexT++)
+         {
+            clJsonEntryT = clJsonArrayT.at(slIndexT).toObject();
+            if (clFrameT.fromByteArray(QByteArray::fromBase64(clJsonEntryT.value("frame").toString().toLatin1())))
+            {
+               addCyclicFrame(static_cast< uint32_t >(clJsonEntryT.value("handle").toInt()), clFrameT,
+                              static_cast< uint32_t >(clJsonEntryT.value("period").toInt()),
+                              clJsonEntryT.value("counter").toInt(-1));
+            }
          }
       }
 
       //-------------------------------------------------------------------------------------------
-      // Check for "reset" inside JSON object
+      // Check for "cyclicUpdate" inside JSON object: array of objects with "handle" and "frame"
       //
-      if (clJsonDocumentT.object().contains("reset"))
+      if (clJsonDocumentT.object().contains("cyclicUpdate"))
       {
-         if (clJsonDocumentT.object().value("reset").toBool())
+         QJsonArray  clJsonArrayT = clJsonDocumentT.object().value("cyclicUpdate").toArray();
+         QJsonObject clJsonEntryT;
+         QCanFrame   clFrameT;
+         int32_t     slIndexT;
+
+         for (slIndexT = 0; slIndexT < clJsonArrayT.size(); slIndexT++)
          {
-            reset();
+            clJsonEntryT = clJsonArrayT.at(slIndexT).toObject();
+            if (clFrameT.fromByteArray(QByteArray::fromBase64(clJsonEntryT.value("frame").toString().toLatin1())))
+            {
+               updateCyclicFrame(static_cast< uint32_t >(clJsonEntryT.value("handle").toInt()), clFrameT);
+            }
          }
       }
 
@@ -1230,6 +2559,7 @@ void QCanNetwork::onTimerEvent(void)
 {
    uint32_t       ulMsgPerSecT;
    uint32_t       ulElapsedTimeT;
+   uint64_t       uqBusLoadT;
 
 
    //---------------------------------------------------------------------------------------------------
@@ -1252,21 +2582,25 @@ void QCanNetwork::onTimerEvent(void)
       ulMsgPerSecT = ulMsgPerSecT / ulElapsedTimeT;
 
       //--------------------------------------------------------------------------------------
-      // calculate bus load
+      // calculate bus load: the bus time of all frames (nominal and data phase weighted by their
+      // bit rate) relative to the elapsed time
       //
-      ulCntBitCurP = ulCntBitCurP * 100;
-      ulCntBitCurP = ulCntBitCurP / static_cast< uint32_t >(slNomBitRateP);
-      if(ulCntBitCurP > 100)
+      uqBusLoadT = QCanFrameBits::busTime(uqCntBitNomP, uqCntBitDatP, slNomBitRateP, slDatBitRateP);
+      uqBusLoadT = uqBusLoadT * 100;
+      uqBusLoadT = uqBusLoadT / (static_cast< uint64_t >(ulElapsedTimeT) * 1000000ULL);
+      if(uqBusLoadT > 100)
       {
-         ulCntBitCurP = 100;
+         uqBusLoadT = 100;
       }
 
       //--------------------------------------------------------------------------------------
       // signal bus load and msg/sec
       //
-      ubBusLoadP = static_cast< uint8_t >(ulCntBitCurP);
+      ubBusLoadP     = static_cast< uint8_t >(uqBusLoadT);
+      ulFramePerSecP = ulMsgPerSecT;
       showLoad(QCan::CAN_Channel_e (id()), ubBusLoadP, ulMsgPerSecT);
-      ulCntBitCurP = 0;
+      uqCntBitNomP = 0;
+      uqCntBitDatP = 0;
 
       //--------------------------------------------------------------------------------------
       // store actual frame counter value
@@ -1282,6 +2616,150 @@ void QCanNetwork::onTimerEvent(void)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::onTransmitTimerEvent()                                                                                //
+// retry transmission of queued CAN frames                                                                            //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::onTransmitTimerEvent(void)
+{
+   processTransmitQueue();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::processTransmitQueue()                                                                                //
+// write CAN frames from transmit queue to CAN interface                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::processTransmitQueue(void)
+{
+   const QCanFrame *                pclFrameT;
+   uint64_t                         uqTimeT;
+   uint8_t                          aubSockDataT[QCAN_FRAME_ARRAY_SIZE];
+   QCanInterface::InterfaceError_e  teIfErrorT;
+   QCanTransmitQueue::Origin_ts     tsOriginT;
+
+   if (pclInterfaceP.isNull() == false)
+   {
+      //-------------------------------------------------------------------------------------------
+      // Write the frames in order of their priority until the CAN interface is busy. Frames which
+      // exceeded the deadline are discarded by head().
+      //
+      uqTimeT = static_cast< uint64_t >(clTrmQueueTimeP.elapsed());
+      while ((pclFrameT = clTrmQueueP.head(uqTimeT, &tsOriginT)) != nullptr)
+      {
+         teIfErrorT = pclInterfaceP->write(*pclFrameT);
+         if (teIfErrorT == QCanInterface::eERROR_FIFO_TRM_FULL)
+         {
+            break;
+         }
+
+         //-----------------------------------------------------------------------------------
+         // the frame is also removed if the CAN interface reports any other error, otherwise
+         // it would block the queue. The frame is copied before, because the dispatch may add
+         // new frames to the queue.
+         //
+         pclFrameT->toRawData(&aubSockDataT[0]);
+         clTrmQueueP.pop();
+
+         //-----------------------------------------------------------------------------------
+         // the frame is on the bus now: dispatch it to the clients
+         //
+         if (teIfErrorT == QCanInterface::eERROR_NONE)
+         {
+            aclLatencyEgressP[eLATENCY_PATH_CAN_IF].record(static_cast< uint64_t >(clFrameTimeP.nsecsElapsed()) -
+                                                           tsOriginT.uqIngressTime);
+            dispatchCanFrame(static_cast< FrameSource_e >(tsOriginT.slSource), tsOriginT.pclSocket,
+                             &aubSockDataT[0], tsOriginT.uqIngressTime);
+         }
+      }
+   }
+   else
+   {
+      clTrmQueueP.clear();
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the retry timer is only running as long as there are pending frames
+   //
+   if (clTrmQueueP.isEmpty())
+   {
+      clTrmQueueTimerP.stop();
+   }
+   else if (clTrmQueueTimerP.isActive() == false)
+   {
+      clTrmQueueTimerP.start();
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::receiveMuxFrame()                                                                                     //
+// dispatch CAN frame from multiplexed connection                                                                     //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::receiveMuxFrame(QCanMuxSocket * pclSocketV, uint8_t * pubSockDataV)
+{
+   int32_t  slSockIdxT;
+
+   //---------------------------------------------------------------------------------------------------
+   // get the index of the connection, the mutex is not held during the dispatch
+   //
+   clMuxSockMutexP.lock();
+   slSockIdxT = clMuxSockListP.indexOf(pclSocketV);
+   clMuxSockMutexP.unlock();
+
+   if (slSockIdxT >= 0)
+   {
+      handleCanFrame(eFRAME_SOURCE_MUX_SOCKET, pclSocketV, pubSockDataV,
+                     static_cast< uint64_t >(clFrameTimeP.nsecsElapsed()));
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::removeBridge()                                                                                        //
+// remove bridge link to remote server                                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::removeBridge(QCanBridge * pclBridgeV)
+{
+   clBridgeListP.removeAll(pclBridgeV);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::removeChangeFilter()                                                                                  //
+// forward all CAN frames to socket                                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::removeChangeFilter(const QObject * pclSocketV)
+{
+   delete (clChangeFilterP.take(pclSocketV));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::removeCyclicFrame()                                                                                   //
+// remove CAN frame from cyclic transmit table                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanNetwork::removeCyclicFrame(const uint32_t ulHandleV)
+{
+   bool  btResultT;
+
+   clCyclicMutexP.lock();
+   btResultT = clCyclicTableP.removeFrame(ulHandleV);
+   clCyclicMutexP.unlock();
+
+   if (btResultT)
+   {
+      emit addLogMessage(QCan::CAN_Channel_e (id()),
+                         QString("Stop cyclic frame %1").arg(ulHandleV),
+                         QCan::eLOG_LEVEL_INFO);
+   }
+
+   QMetaObject::invokeMethod(this, "onCyclicTimerUpdate", Qt::AutoConnection);
+
+   return (btResultT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // removeInterface()                                                                                                  //
 // remove physical CAN interface (plug-in)                                                                            //
@@ -1297,6 +2775,69 @@ void QCanNetwork::removeInterface(void)
 
       pclInterfaceP.clear();
    }
+
+   //---------------------------------------------------------------------------------------------------
+   // CAN frames which are still in the transmit queue can not be sent any more
+   //
+   clTrmQueueP.clear();
+   clTrmQueueTimerP.stop();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::removeRoute()                                                                                         //
+// remove routing rule                                                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanNetwork::removeRoute(const uint32_t ulHandleV)
+{
+   int32_t  slRouteIdxT;
+
+   for (slRouteIdxT = 0; slRouteIdxT < atsRouteP.size(); slRouteIdxT++)
+   {
+      if (atsRouteP.at(slRouteIdxT).clRoute.handle() == ulHandleV)
+      {
+         atsRouteP.remove(slRouteIdxT);
+         return (true);
+      }
+   }
+
+   return (false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::routeCanFrame()                                                                                       //
+// dispatch CAN frame from other network                                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::routeCanFrame(const QCanFrame & clFrameR)
+{
+   uint8_t  aubSockDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   if (btNetworkEnabledP)
+   {
+      clFrameR.toRawData(&aubSockDataT[0]);
+      handleCanFrame(eFRAME_SOURCE_ROUTE, nullptr, &aubSockDataT[0],
+                     static_cast< uint64_t >(clFrameTimeP.nsecsElapsed()));
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::routes()                                                                                              //
+// return copy of routing rules                                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+QVector<QCanRoute> QCanNetwork::routes(void) const
+{
+   QVector<QCanRoute>   clRouteListT;
+   int32_t              slRouteIdxT;
+
+   clRouteListT.reserve(atsRouteP.size());
+   for (slRouteIdxT = 0; slRouteIdxT < atsRouteP.size(); slRouteIdxT++)
+   {
+      clRouteListT.append(atsRouteP.at(slRouteIdxT).clRoute);
+   }
+
+   return (clRouteListT);
 }
 
 
@@ -1317,17 +2858,25 @@ void  QCanNetwork::sendNetworkSettings(uint32_t flags)
    clJsonNetworkT["channel"]              = static_cast< int32_t >(this->channel());
    clJsonNetworkT["bitrateData"]          = static_cast< int32_t >(this->dataBitrate());
    clJsonNetworkT["bitrateNominal"]       = static_cast< int32_t >(this->nominalBitrate());
+   clJsonNetworkT["cyclicCount"]          = static_cast< int32_t >(this->cyclicFrameCount());
+   clJsonNetworkT["deliveryStamp"]        = static_cast< int32_t >(this->deliveryStamp());
    clJsonNetworkT["enabled"]              = static_cast< bool >(this->isNetworkEnabled());
+   clJsonNetworkT["errorFrameCoalescing"] = static_cast< int32_t >(this->errorFrameCoalescing());
    clJsonNetworkT["errorFrameEnabled"]    = static_cast< bool >(this->isErrorFrameEnabled());
    clJsonNetworkT["errorFrameSupport"]    = static_cast< bool >(this->hasErrorFrameSupport());
    clJsonNetworkT["flexibleDataEnabled"]  = static_cast< bool >(this->isFlexibleDataEnabled());
    clJsonNetworkT["flexibleDataSupport"]  = static_cast< bool >(this->hasFlexibleDataSupport());
+   clJsonNetworkT["frameCacheCount"]      = static_cast< int32_t >(this->frameCacheCount());
    clJsonNetworkT["frameCount"]           = static_cast< int32_t >(this->frameCount());
    clJsonNetworkT["frameCountError"]      = static_cast< int32_t >(this->frameCountError());
+   clJsonNetworkT["idStatisticCount"]     = static_cast< int32_t >(this->idStatisticCount());
+   clJsonNetworkT["latency"]              = this->latency();
    clJsonNetworkT["listenOnlyEnabled"]    = static_cast< bool >(this->isErrorFrameEnabled());
    clJsonNetworkT["listenOnlySupport"]    = static_cast< bool >(this->isListenOnlyEnabled());
    clJsonNetworkT["name"]                 = static_cast< QString >(this->name());
    clJsonNetworkT["state"]                = static_cast< int32_t >(this->state());
+   clJsonNetworkT["transmitDeadline"]     = static_cast< int32_t >(this->transmitDeadline());
+   clJsonNetworkT["transmitDropCount"]    = static_cast< int32_t >(this->transmitDropCount());
 
    if (pclInterfaceP.isNull() == false)
    {
@@ -1458,6 +3007,54 @@ void QCanNetwork::setCanState(QCan::CAN_State_e teStateV)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::setDeliveryStamp()                                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::setDeliveryStamp(const uint8_t ubModeV)
+{
+   uint8_t  ubModeT = ubModeV;
+
+   if (ubModeT > QCAN_DELIVERY_STAMP_SEQUENCE)
+   {
+      ubModeT = QCAN_DELIVERY_STAMP_NONE;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the sequence numbers start again at 0 for all sockets
+   //
+   if (ubModeT != ubDeliveryStampP)
+   {
+      ubDeliveryStampP = ubModeT;
+      clDeliveryStampP.clear();
+      addLogMessage(QCan::CAN_Channel_e (id()),
+                    QString("Delivery stamp mode %1").arg(ubDeliveryStampP),
+                    QCan::eLOG_LEVEL_INFO);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::setErrorFrameCoalescing()                                                                             //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::setErrorFrameCoalescing(const uint32_t ulWindowV)
+{
+   //---------------------------------------------------------------------------------------------------
+   // dispatch pending error frames before the window is changed
+   //
+   flushErrorFrames(true);
+
+   if (ulWindowV != clErrorCoalescingP.window())
+   {
+      clErrorCoalescingP.setWindow(ulWindowV);
+      addLogMessage(QCan::CAN_Channel_e (id()),
+                    QString("Error frame coalescing window %1 ms").arg(clErrorCoalescingP.window()),
+                    QCan::eLOG_LEVEL_INFO);
+   }
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetwork::setErrorFrameEnabled()                                                                                //
 //                                                                                                                    //
@@ -1605,6 +3202,81 @@ void QCanNetwork::setListenOnlyEnabled(bool btEnableV)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::setMulticast()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanNetwork::setMulticast(const QHostAddress & clGroupR, const uint16_t uwPortV, const QString & clInterfaceR)
+{
+   QNetworkInterface clInterfaceT;
+   QHostAddress      clBindAddressT(QHostAddress::AnyIPv4);
+
+   //---------------------------------------------------------------------------------------------------
+   // the pending datagram is sent to the previous multicast group
+   //
+   flushMulticast();
+   if (pclMulticastSocketP != nullptr)
+   {
+      delete (pclMulticastSocketP);
+      pclMulticastSocketP = nullptr;
+   }
+   clMulticastGroupP.clear();
+   clMulticastInterfaceP.clear();
+
+   if (clGroupR.isNull())
+   {
+      return (true);
+   }
+
+   if (clGroupR.isMulticast() == false)
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // The socket is bound to an arbitrary port, the socket options require a valid socket. The
+   // loopback option makes the datagrams available to receivers on the local host.
+   //
+   if (clGroupR.protocol() == QAbstractSocket::IPv6Protocol)
+   {
+      clBindAddressT = QHostAddress(QHostAddress::AnyIPv6);
+   }
+
+   pclMulticastSocketP = new QUdpSocket(this);
+   if (pclMulticastSocketP->bind(clBindAddressT, 0) == false)
+   {
+      delete (pclMulticastSocketP);
+      pclMulticastSocketP = nullptr;
+      return (false);
+   }
+   pclMulticastSocketP->setSocketOption(QAbstractSocket::MulticastLoopbackOption, 1);
+   pclMulticastSocketP->setSocketOption(QAbstractSocket::MulticastTtlOption, MULTICAST_TTL);
+
+   if (clInterfaceR.isEmpty() == false)
+   {
+      clInterfaceT = QNetworkInterface::interfaceFromName(clInterfaceR);
+      if (clInterfaceT.isValid() == false)
+      {
+         delete (pclMulticastSocketP);
+         pclMulticastSocketP = nullptr;
+         return (false);
+      }
+      pclMulticastSocketP->setMulticastInterface(clInterfaceT);
+   }
+
+   clMulticastGroupP     = clGroupR;
+   clMulticastInterfaceP = clInterfaceR;
+   uwMulticastPortP      = uwPortV;
+   clMulticastDatagramP.reset();
+
+   QString clLogMessageT = QString("Publish CAN frames to multicast group %1:%2").arg(clGroupR.toString())
+                                                                                 .arg(uwPortV);
+   addLogMessage(channel(), clLogMessageT, QCan::eLOG_LEVEL_INFO);
+
+   return (true);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetwork::setNetworkEnabled()                                                                                   //
 // start / stop the server                                                                                            //
@@ -1614,10 +3286,12 @@ void QCanNetwork::setNetworkEnabled(bool btEnableV)
 
    if ((btEnableV == true) && (btNetworkEnabledP == false))
    {
+      allocateResources();
+
       //-------------------------------------------------------------------------------------------
       // limit the number of connections for local server
       //
-      pclLocalSrvP->setMaxPendingConnections(QCAN_LOCAL_SOCKET_MAX);
+      pclLocalSrvP->setMaxPendingConnections(static_cast< int32_t >(socketMax(QCAN_LOCAL_SOCKET_MAX)));
       pclLocalSrvP->setSocketOptions(QLocalServer::WorldAccessOption);
       if(!pclLocalSrvP->listen(QString("CANpieServerChannel%1").arg(ubIdP)))
       {
@@ -1693,6 +3367,98 @@ void QCanNetwork::setNetworkEnabled(bool btEnableV)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::setSocketLimit()                                                                                      //
+// set maximum number of sockets of each type                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::setSocketLimit(const uint32_t ulLimitV)
+{
+   ulSocketLimitP = qMin(ulLimitV, static_cast< uint32_t >(QCAN_SOCKET_LIMIT_MAX));
+   if (ulSocketLimitP != ulLimitV)
+   {
+      addLogMessage(QCan::CAN_Channel_e (id()),
+                    QString("Socket limit %1 reduced to %2").arg(ulLimitV).arg(ulSocketLimitP),
+                    QCan::eLOG_LEVEL_WARN);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::setTransmitDeadline()                                                                                 //
+// set deadline of transmit queue                                                                                     //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetwork::setTransmitDeadline(const uint32_t ulDeadlineV)
+{
+   if (ulDeadlineV != clTrmQueueP.deadline())
+   {
+      clTrmQueueP.setDeadline(ulDeadlineV);
+      addLogMessage(QCan::CAN_Channel_e (id()),
+                    QString("Transmit queue deadline %1 ms").arg(ulDeadlineV),
+                    QCan::eLOG_LEVEL_INFO);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::socketStatistic()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanNetwork::socketStatistic(SocketStatistic_ts * ptsBufferV, const uint32_t ulMaxV) const
+{
+   uint32_t ulCountT = 0;
+   int32_t  slSockIdxT;
+
+   if (ptsBufferV == nullptr)
+   {
+      return (0);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the mutex of a list is held while its sockets are evaluated, so a socket can not be removed
+   //
+   clLocalSockMutexP.lock();
+   for (slSockIdxT = 0; (slSockIdxT < clLocalSockListP.size()) && (ulCountT < ulMaxV); slSockIdxT++)
+   {
+      const QLocalSocket * pclLocalSockT = clLocalSockListP.list().at(slSockIdxT);
+
+      ptsBufferV[ulCountT].ulDropCount  = clSocketDropP.value(pclLocalSockT, 0);
+      ptsBufferV[ulCountT].ulQueueDepth = static_cast< uint32_t >(pclLocalSockT->bytesToWrite() /
+                                                                  QCAN_FRAME_ARRAY_SIZE);
+      ptsBufferV[ulCountT].teTransport  = eSOCKET_TRANSPORT_LOCAL;
+      ulCountT++;
+   }
+   clLocalSockMutexP.unlock();
+
+   clWebSockMutexP.lock();
+   for (slSockIdxT = 0; (slSockIdxT < clWebSockListP.size()) && (ulCountT < ulMaxV); slSockIdxT++)
+   {
+      const QWebSocket * pclWebSockT = clWebSockListP.list().at(slSockIdxT);
+
+      ptsBufferV[ulCountT].ulDropCount  = clSocketDropP.value(pclWebSockT, 0);
+      ptsBufferV[ulCountT].ulQueueDepth = static_cast< uint32_t >(pclWebSockT->bytesToWrite() /
+                                                                  QCAN_FRAME_ARRAY_SIZE);
+      ptsBufferV[ulCountT].teTransport  = eSOCKET_TRANSPORT_WEB;
+      ulCountT++;
+   }
+   clWebSockMutexP.unlock();
+
+   clTcpSockMutexP.lock();
+   for (slSockIdxT = 0; (slSockIdxT < clTcpSockListP.size()) && (ulCountT < ulMaxV); slSockIdxT++)
+   {
+      const QTcpSocket * pclTcpSockT = clTcpSockListP.list().at(slSockIdxT);
+
+      ptsBufferV[ulCountT].ulDropCount  = clSocketDropP.value(pclTcpSockT, 0);
+      ptsBufferV[ulCountT].ulQueueDepth = static_cast< uint32_t >(pclTcpSockT->bytesToWrite() /
+                                                                  QCAN_FRAME_ARRAY_SIZE);
+      ptsBufferV[ulCountT].teTransport  = eSOCKET_TRANSPORT_TCP;
+      ulCountT++;
+   }
+   clTcpSockMutexP.unlock();
+
+   return (ulCountT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // startInterface()                                                                                                   //
 //                                                                                                                    //
@@ -1765,3 +3531,19 @@ bool QCanNetwork::stopInterface(void)
 
    return (btResultT);
 }
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetwork::updateCyclicFrame()                                                                                   //
+// replace CAN frame in cyclic transmit table                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanNetwork::updateCyclicFrame(const uint32_t ulHandleV, const QCanFrame & clFrameR)
+{
+   bool  btResultT;
+
+   clCyclicMutexP.lock();
+   btResultT = clCyclicTableP.updateFrame(ulHandleV, clFrameR);
+   clCyclicMutexP.unlock();
+
+   return (btResultT);
+}
@@ -39,17 +39,34 @@
 
 #include <QtCore/QDateTime>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QMutex>
 #include <QtCore/QPointer>
 #include <QtCore/QTimer>
 
 #include <QtNetwork/QLocalServer>
 #include <QtNetwork/QLocalSocket>
+#include <QtNetwork/QTcpSocket>
+#include <QtNetwork/QUdpSocket>
 
 #include <QtWebSockets/QWebSocket>
 
+#include "qcan_change_filter.hpp"
+#include "qcan_bridge.hpp"
+#include "qcan_bridge_sequence.hpp"
+#include "qcan_cyclic_table.hpp"
+#include "qcan_delivery_stamp.hpp"
+#include "qcan_error_coalescing.hpp"
 #include "qcan_frame.hpp"
+#include "qcan_frame_cache.hpp"
+#include "qcan_id_statistic.hpp"
 #include "qcan_interface.hpp"
+#include "qcan_latency_histogram.hpp"
+#include "qcan_multicast_datagram.hpp"
+#include "qcan_mux_socket.hpp"
+#include "qcan_route.hpp"
+#include "qcan_socket_list.hpp"
+#include "qcan_transmit_queue.hpp"
 
 
 /*--------------------------------------------------------------------------------------------------------------------*\
@@ -70,9 +87,13 @@
 ** interfaces (sockets).
 ** <p>
 ** <h2>Sockets</h2>
-** Clients can connect to a QCanNetwork via the QCanSocket class, either via a local socket or a WebSocket. The
-** maximum number of available sockets is defined by #QCAN_LOCAL_SOCKET_MAX and #QCAN_WEB_SOCKET_MAX.
+** Clients can connect to a QCanNetwork via the QCanSocket class, either via a local socket, a WebSocket or a raw
+** TCP socket. The maximum number of available sockets is defined by #QCAN_LOCAL_SOCKET_MAX, #QCAN_WEB_SOCKET_MAX
+** and #QCAN_TCP_SOCKET_MAX, it can be changed at run-time by setSocketLimit().
 ** It is only possible to connect to a network when it is enabled (see setNetworkEnabled() and isNetworkEnabled()).
+** <p>
+** In addition all CAN frames of the network can be published to a UDP multicast group (see setMulticast()), so
+** any number of remote receivers is served by a single datagram.
 **
 **
 ** <p>
@@ -112,6 +133,61 @@ public:
       eSOCKET_TYPE_SETTINGS  = 2
    };
 
+   //---------------------------------------------------------------------------------------------------
+   // Source and destination types of CAN frames for the latency measurement
+   //
+   enum LatencyPath_e {
+      eLATENCY_PATH_CAN_IF = 0,
+      eLATENCY_PATH_LOCAL_SOCKET,
+      eLATENCY_PATH_WEB_SOCKET,
+      eLATENCY_PATH_TCP_SOCKET,
+      eLATENCY_PATH_MUX_SOCKET,
+      eLATENCY_PATH_MAX
+   };
+
+   //---------------------------------------------------------------------------------------------------
+   // Transport of a socket for CAN frames
+   //
+   enum SocketTransport_e {
+      eSOCKET_TRANSPORT_LOCAL = 0,
+      eSOCKET_TRANSPORT_WEB,
+      eSOCKET_TRANSPORT_TCP
+   };
+
+   //---------------------------------------------------------------------------------------------------
+   // Statistic of a socket for CAN frames, see socketStatistic()
+   //
+   typedef struct SocketStatistic_s {
+      uint32_t          ulDropCount;   // CAN frames which could not be written to the socket
+      uint32_t          ulQueueDepth;  // CAN frames pending inside the write buffer of the socket
+      SocketTransport_e teTransport;   // QLocalSocket, QWebSocket or QTcpSocket
+   } SocketStatistic_ts;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV      Handle of cyclic CAN frame
+   ** \param[in]  clFrameR       CAN frame
+   ** \param[in]  ulPeriodV      Cycle time in milliseconds
+   ** \param[in]  slCounterPosV  Position of rolling counter inside data field, -1 if not used
+   ** \return     \c true if the cyclic CAN frame has been added
+   ** \see        removeCyclicFrame(), updateCyclicFrame()
+   **
+   ** The function adds the CAN frame \a clFrameR to the cyclic transmit table of the network. The
+   ** network transmits the CAN frame every \a ulPeriodV milliseconds to the CAN interface and to all
+   ** connected sockets. The handle \a ulHandleV is used to identify the entry, an existing entry
+   ** with the same handle is replaced. The maximum number of entries is defined by
+   ** #QCAN_CYCLIC_FRAME_MAX.
+   ** <p>
+   ** If \a slCounterPosV is a valid data position, the data byte at this position is incremented
+   ** after each transmission.
+   ** <p>
+   ** The function can be called from any thread, it can also be controlled via the settings
+   ** WebSocket of the network (see QCanNetworkSettings::addCyclicFrame()).
+   */
+   bool addCyclicFrame(const uint32_t ulHandleV, const QCanFrame & clFrameR, const uint32_t ulPeriodV,
+                       const int32_t slCounterPosV = -1);
+
+
    //---------------------------------------------------------------------------------------------------
 	/*!
    ** \param[in]  pclCanIfV     Pointer to CAN interface class
@@ -128,16 +204,97 @@ public:
 	bool addInterface(QCanInterface * pclCanIfV);
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clRouteR       Routing rule
+   ** \param[in]  pclTargetV     Pointer to target network
+   ** \return     \c true if the route has been added
+   ** \see        removeRoute()
+   **
+   ** The function adds a routing rule to the network: all CAN frames which are dispatched by this
+   ** network and which match \a clRouteR are forwarded to the network \a pclTargetV. The frames are
+   ** passed directly to the dispatcher of the target network, there is no socket involved. CAN
+   ** frames which have been received via a route are not forwarded again, this avoids loops between
+   ** networks. An existing route with the same handle is replaced.
+   ** <p>
+   ** Routes are managed by the QCanServer (see QCanServer::addRoute()), the function must be called
+   ** from the thread of the network.
+   */
+   bool addRoute(const QCanRoute & clRouteR, QCanNetwork * pclTargetV);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclBridgeV     Pointer to bridge link
+   ** \see        removeBridge()
+   **
+   ** The function adds a bridge link to a remote server: all CAN frames which are dispatched by this
+   ** network are passed to QCanBridge::process(). CAN frames which have been received from a bridge
+   ** link of another server are not passed, this avoids loops between servers.
+   ** <p>
+   ** Bridge links are managed by the QCanServer (see QCanServer::addBridge()), the network does not
+   ** take over the ownership.
+   */
+   void addBridge(QCanBridge * pclBridgeV);
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  pclSocketV     Pointer to WebSocket 
    ** \param[in]  teSocketTypeV  WebSocket type
    **
+   ** \return     \c true if the WebSocket has been attached
+   **
    ** This function attaches a WebSocket to the CAN network. The WebSocket can either be used to
    ** exchange CAN frames or to retrieve and alter the CAN network settings. The WebSocket type is
-   ** defined by the parameter \a teSocketTypeV.
+   ** defined by the parameter \a teSocketTypeV. The function returns \c false if the limit of
+   ** WebSockets for CAN frames has been reached (see setSocketLimit()).
+   */
+   bool  attachWebSocket(QWebSocket * pclSocketV, const enum SocketType_e teSocketTypeV = eSOCKET_TYPE_CAN_FRAME);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclSocketV     Pointer to TCP socket
+   ** \return     \c true if the TCP socket has been attached
+   **
+   ** This function attaches a raw TCP socket to the CAN network, the handshake (see
+   ** #QCAN_TCP_SOCKET_DEFAULT_PORT) must be completed by the caller. The socket exchanges CAN frames
+   ** as a stream of #QCAN_FRAME_ARRAY_SIZE bytes. CAN frames are appended to the write buffer of the
+   ** socket without flushing it, so all CAN frames dispatched within one pass of the event loop are
+   ** sent in a single segment. The function returns \c false if #QCAN_TCP_SOCKET_MAX sockets are
+   ** already attached.
+   ** <p>
+   ** If \a clBridgeIdR is not empty, the socket is the bridge link of a remote server (see QCanBridge):
+   ** the network drops CAN frames with a sequence number it has already received for this link
+   ** identifier, it answers #QCAN_CONTROL_BRIDGE_SYNC and it does not write CAN frames to the socket.
+   */
+   bool  attachTcpSocket(QTcpSocket * pclSocketV, const QByteArray & clBridgeIdR = QByteArray());
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclSocketV     Pointer to multiplexed connection
+   ** \return     \c true if the connection has been attached
+   ** \see        detachMuxSocket()
+   **
+   ** This function attaches a multiplexed connection to the CAN network, it is called by
+   ** QCanMuxSocket::addNetwork(). The network writes all dispatched CAN frames to the connection,
+   ** CAN frames received on the connection are passed by receiveMuxFrame(). The function returns
+   ** \c false if #QCAN_TCP_SOCKET_MAX multiplexed connections are already attached.
    */
-   void  attachWebSocket(QWebSocket * pclSocketV, const enum SocketType_e teSocketTypeV = eSOCKET_TYPE_CAN_FRAME);
+   bool  attachMuxSocket(QCanMuxSocket * pclSocketV);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclSocketV     Pointer to multiplexed connection
+   ** \see        attachMuxSocket()
+   **
+   ** This function detaches a multiplexed connection from the CAN network, it is called by the
+   ** destructor of QCanMuxSocket.
+   */
+   void  detachMuxSocket(QCanMuxSocket * pclSocketV);
 
 
    //---------------------------------------------------------------------------------------------------
@@ -166,6 +323,71 @@ public:
 
    inline QCan::CAN_Channel_e channel() const      { return (static_cast< QCan::CAN_Channel_e >(ubIdP)); }
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Bus load in percent
+   ** \see        framesPerSecond()
+   **
+   ** This function returns the bus load of the network, the value is updated once per second.
+   */
+   inline uint8_t busLoad(void) const              { return (ubBusLoadP);               }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        addCyclicFrame()
+   **
+   ** The function removes all entries from the cyclic transmit table of the network.
+   */
+   void clearCyclicFrames(void);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        frameCache()
+   **
+   ** The function removes all CAN frames from the frame cache of the network.
+   */
+   void clearFrameCache(void);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        idStatistic()
+   **
+   ** The function removes all entries from the identifier statistic of the network.
+   */
+   void clearIdStatistic(void);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        latency()
+   **
+   ** The function removes all values from the latency histograms of the network.
+   */
+   void clearLatency(void);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        addRoute()
+   **
+   ** The function removes all routing rules of the network.
+   */
+   void clearRoutes(void);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of cyclic CAN frames
+   ** \see        addCyclicFrame()
+   **
+   ** This function returns the number of entries in the cyclic transmit table of the network.
+   */
+   uint32_t cyclicFrameCount(void);
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return     Bit rate value for data bit-timing
@@ -192,6 +414,54 @@ public:
 	QString dataBitrateString(void) const;
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Delivery stamp mode
+   ** \see        setDeliveryStamp()
+   **
+   ** This function returns the delivery stamp mode of the network.
+   */
+   inline uint8_t deliveryStamp(void) const        { return (ubDeliveryStampP);         }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Coalescing window for error frames in milliseconds
+   ** \see        setErrorFrameCoalescing()
+   **
+   ** This function returns the coalescing window for error frames, the value 0 denotes that error
+   ** frames are not coalesced.
+   */
+   inline uint32_t errorFrameCoalescing(void) const { return (clErrorCoalescingP.window()); }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  teSourceV      Source type of the CAN frames
+   ** \return     Latency histogram
+   ** \see        egressLatency(), latency()
+   **
+   ** This function returns the histogram of the time between the reception of a CAN frame from a
+   ** source of type \a teSourceV (ingress) and the start of its processing by the network (dispatch).
+   */
+   inline const QCanLatencyHistogram & dispatchLatency(const LatencyPath_e teSourceV) const
+                                                   { return (aclLatencyDispatchP[teSourceV]);  }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  teTargetV      Destination type of the CAN frames
+   ** \return     Latency histogram
+   ** \see        dispatchLatency(), latency()
+   **
+   ** This function returns the histogram of the time between the reception of a CAN frame (ingress)
+   ** and the completion of the write to all destinations of type \a teTargetV (egress). CAN frames
+   ** which are delayed by the transmit queue are not recorded for the CAN interface.
+   */
+   inline const QCanLatencyHistogram & egressLatency(const LatencyPath_e teTargetV) const
+                                                   { return (aclLatencyEgressP[teTargetV]);    }
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return     Number of CAN frames
@@ -212,6 +482,81 @@ public:
 	uint32_t frameCountError(void) const            { return (ulCntFrameErrP);          }
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of CAN frames per second
+   ** \see        busLoad()
+   **
+   ** This function returns the number of CAN frames per second, the value is updated once per
+   ** second.
+   */
+   inline uint32_t framesPerSecond(void) const     { return (ulFramePerSecP);           }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     List of CAN frames
+   ** \see        clearFrameCache()
+   **
+   ** This function returns the most recent CAN data frame of each CAN identifier which has been
+   ** transmitted via the network, in order of the first appearance of the identifier. A client
+   ** connected via QCanSocket can request the same snapshot with QCanSocket::requestSnapshot(),
+   ** which is synchronised with the live stream of CAN frames.
+   */
+   QVector<QCanFrame> frameCache(void) const;
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of CAN frames
+   ** \see        frameCache()
+   **
+   ** This function returns the number of CAN frames inside the frame cache.
+   */
+   inline uint32_t frameCacheCount(void) const     { return (clFrameCacheP.count());    }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Array of JSON objects
+   ** \see        clearIdStatistic()
+   **
+   ** This function returns a snapshot of the statistic per CAN identifier: number of CAN frames,
+   ** age of the last reception, mean / minimum / maximum period, jitter and last DLC. The format
+   ** of the entries is described in QCanIdStatistic::toJson().
+   */
+   QJsonArray idStatistic(void) const;
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of CAN identifiers
+   ** \see        idStatistic()
+   **
+   ** This function returns the number of different CAN identifiers inside the identifier statistic.
+   */
+   inline uint32_t idStatisticCount(void) const    { return (clIdStatisticP.count());   }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     JSON object
+   ** \see        clearLatency(), dispatchLatency(), egressLatency()
+   **
+   ** This function returns a summary of all latency histograms of the network, the format of the
+   ** entries is described in QCanLatencyHistogram::toJson():
+   ** \code
+   ** {
+   **    "dispatch": { "canInterface": { ... }, "localSocket": { ... }, "webSocket": { ... }, "tcpSocket": { ... },
+   **                  "muxSocket": { ... } },
+   **    "egress":   { "canInterface": { ... }, "localSocket": { ... }, "webSocket": { ... }, "tcpSocket": { ... },
+   **                  "muxSocket": { ... } }
+   ** }
+   ** \endcode
+   */
+   QJsonObject latency(void) const;
+
+
 
    //---------------------------------------------------------------------------------------------------
    /*!
@@ -294,10 +639,54 @@ public:
    bool isNetworkEnabled(void) const               { return (btNetworkEnabledP);       }
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Multicast group
+   ** \see        setMulticast()
+   **
+   ** This function returns the multicast group of the network, the address is null if the
+   ** multicast publication is disabled.
+   */
+   inline QHostAddress multicastGroup(void) const  { return (clMulticastGroupP);       }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Name of network interface used for multicast publication
+   ** \see        setMulticast()
+   **
+   ** This function returns the name of the network interface, the name is empty if the operating
+   ** system selects the interface.
+   */
+   inline QString multicastInterface(void) const   { return (clMulticastInterfaceP);   }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     UDP port of multicast group
+   ** \see        setMulticast()
+   **
+   ** This function returns the UDP port of the multicast publication.
+   */
+   inline uint16_t multicastPort(void) const       { return (uwMulticastPortP);        }
+
+
 	QString  name() const                           { return(clNetNameP);               }
 
 	void reset(void);
 
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV      Handle of cyclic CAN frame
+   ** \return     \c true if the cyclic CAN frame has been removed
+   ** \see        addCyclicFrame()
+   **
+   ** The function removes the entry \a ulHandleV from the cyclic transmit table of the network.
+   */
+   bool removeCyclicFrame(const uint32_t ulHandleV);
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \see     addInterface()
@@ -307,6 +696,49 @@ public:
 	void removeInterface(void);
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV      Handle of route
+   ** \return     \c true if the route has been removed
+   ** \see        addRoute()
+   **
+   ** The function removes the routing rule \a ulHandleV from the network.
+   */
+   bool removeRoute(const uint32_t ulHandleV);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclBridgeV     Pointer to bridge link
+   ** \see        addBridge()
+   **
+   ** The function removes the bridge link \a pclBridgeV from the network.
+   */
+   void removeBridge(QCanBridge * pclBridgeV);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclSocketV     Pointer to multiplexed connection
+   ** \param[in]  pubSockDataV   Pointer to raw CAN frame (#QCAN_FRAME_ARRAY_SIZE bytes)
+   **
+   ** The function dispatches a CAN frame which has been received on the multiplexed connection
+   ** \a pclSocketV for this network, the CAN frame is not written back to \a pclSocketV.
+   */
+   void receiveMuxFrame(QCanMuxSocket * pclSocketV, uint8_t * pubSockDataV);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     List of routes
+   ** \see        addRoute()
+   **
+   ** The function returns a copy of all routing rules of the network, including the actual values
+   ** of the frame counters.
+   */
+   QVector<QCanRoute> routes(void) const;
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  slNomBitRateV  Nominal bit rate value
@@ -325,6 +757,22 @@ public:
 	void setBitrate(const int32_t slNomBitRateV, const int32_t slDatBitRateV = QCan::eCAN_BITRATE_NONE);
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulWindowV      Coalescing window in milliseconds
+   ** \see        errorFrameCoalescing()
+   **
+   ** This function configures the coalescing of error frames received from the CAN interface, the
+   ** value 0 disables the coalescing (default). An error frame which differs from the previous one
+   ** in error state, error type or error counters is dispatched immediately, so a state transition
+   ** is never delayed. Identical error frames which follow are merged: once per window a single
+   ** error frame is dispatched, which carries the number of merged frames and the time stamp of the
+   ** first merged frame (see QCanFrame::errorRepeatCount() and QCanFrame::errorTimeStampFirst()).
+   ** The error frame counter (see frameCountError()) includes the merged frames.
+   */
+   void setErrorFrameCoalescing(const uint32_t ulWindowV);
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  btEnableV      Enable / disable error frames
@@ -336,6 +784,23 @@ public:
    void setErrorFrameEnabled(const bool btEnableV = true);
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ubModeV        Delivery stamp mode
+   ** \see        deliveryStamp()
+   **
+   ** This function selects if the network writes a delivery stamp into the unused bytes of each CAN
+   ** frame which is dispatched to the sockets:
+   ** - #QCAN_DELIVERY_STAMP_NONE: the bytes are not modified (default)
+   ** - #QCAN_DELIVERY_STAMP_TIME: dispatch time
+   ** - #QCAN_DELIVERY_STAMP_SEQUENCE: dispatch time and sequence number per socket
+   **
+   ** The stamp is evaluated by QCanSocket, refer to QCanSocket::setDeliveryMonitor(). The size of
+   ** the CAN frames on the wire is not changed.
+   */
+   void setDeliveryStamp(const uint8_t ubModeV);
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  btEnableV      Enable / disable CAN FD mode
@@ -357,6 +822,25 @@ public:
    void setListenOnlyEnabled(const bool btEnableV = true);
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clGroupR       Multicast group, a null address disables the publication
+   ** \param[in]  uwPortV        UDP port
+   ** \param[in]  clInterfaceR   Name of network interface, e.g. "lo"
+   ** \return     \c true if the multicast publication has been configured
+   ** \see        multicastGroup()
+   **
+   ** This function publishes all CAN frames of the network to the multicast group \a clGroupR. Up to
+   ** #QCAN_MULTICAST_FRAME_MAX CAN frames are packed into one datagram, the datagram is sent when it
+   ** is full or when control returns to the event loop (see #QCAN_MULTICAST_DEFAULT_PORT for the
+   ** format). If \a clInterfaceR is empty, the operating system selects the network interface. The
+   ** datagrams are also delivered to receivers on the local host. The publication is disabled by
+   ** default.
+   */
+   bool setMulticast(const QHostAddress & clGroupR, const uint16_t uwPortV = QCAN_MULTICAST_DEFAULT_PORT,
+                     const QString & clInterfaceR = QString());
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  btEnableV      Enable / disable network
@@ -368,6 +852,54 @@ public:
    void setNetworkEnabled(const bool btEnableV = true);
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulLimitV       Maximum number of sockets of each type, 0 for the default values
+   ** \see        socketLimit()
+   **
+   ** This function defines how many local sockets, WebSockets, raw TCP sockets and multiplexed
+   ** connections may be connected to the CAN network at the same time, further connections are
+   ** rejected. The value 0 selects the compile-time limits #QCAN_LOCAL_SOCKET_MAX,
+   ** #QCAN_WEB_SOCKET_MAX and #QCAN_TCP_SOCKET_MAX. Sockets which are already connected are not
+   ** affected by a lower limit. A value above #QCAN_SOCKET_LIMIT_MAX is reduced to this limit, so
+   ** the statistic of the server (see socketStatistic()) covers all sockets.
+   */
+   void setSocketLimit(const uint32_t ulLimitV);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulDeadlineV    Deadline in milliseconds
+   ** \see        transmitDeadline()
+   **
+   ** CAN frames which can not be written to the CAN interface immediately are kept in a transmit
+   ** queue, ordered by their arbitration priority. This function defines how long a CAN frame may
+   ** wait inside the queue before it is discarded. A value of 0 disables the deadline.
+   */
+   void setTransmitDeadline(const uint32_t ulDeadlineV);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ptsBufferV     Pointer to array of statistic entries
+   ** \param[in]  ulMaxV         Size of the array \a ptsBufferV
+   ** \return     Number of entries written to \a ptsBufferV
+   **
+   ** The function copies the statistic of the sockets for CAN frames to \a ptsBufferV, the local
+   ** sockets are followed by the WebSockets. No memory is allocated, so the function is suitable
+   ** for frequent sampling.
+   */
+   uint32_t socketStatistic(SocketStatistic_ts * ptsBufferV, const uint32_t ulMaxV) const;
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Maximum number of sockets of each type, 0 for the default values
+   ** \see        setSocketLimit()
+   */
+   inline uint32_t socketLimit(void) const         { return (ulSocketLimitP);           }
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return     \c true if CAN interface is started
@@ -400,6 +932,52 @@ public:
    */
    inline QCan::CAN_State_e state(void) const      { return (teCanStateP);   }
 
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Deadline in milliseconds
+   ** \see        setTransmitDeadline()
+   **
+   ** The function returns the maximum time a CAN frame is kept inside the transmit queue.
+   */
+   inline uint32_t transmitDeadline(void) const    { return (clTrmQueueP.deadline());   }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of discarded CAN frames
+   ** \see        setTransmitDeadline()
+   **
+   ** The function returns the number of CAN frames which have been discarded by the transmit queue,
+   ** either because the queue was full or because the deadline was exceeded. The counter is cleared
+   ** by reset().
+   */
+   inline uint32_t transmitDropCount(void) const   { return (clTrmQueueP.dropCount());  }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of CAN frames
+   ** \see        transmitDropCount()
+   **
+   ** The function returns the number of CAN frames which are waiting inside the transmit queue.
+   */
+   inline uint32_t transmitQueueCount(void) const  { return (clTrmQueueP.count());      }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV      Handle of cyclic CAN frame
+   ** \param[in]  clFrameR       CAN frame
+   ** \return     \c true if the cyclic CAN frame has been updated
+   ** \see        addCyclicFrame()
+   **
+   ** The function replaces the CAN frame of the entry \a ulHandleV in the cyclic transmit table. The
+   ** frame is replaced as a whole, so a transmission never contains a mix of old and new data. The
+   ** cycle time and the value of a rolling counter are not changed.
+   */
+   bool updateCyclicFrame(const uint32_t ulHandleV, const QCanFrame & clFrameR);
+
 signals:
 
    //---------------------------------------------------------------------------------------------------
@@ -471,6 +1049,12 @@ signals:
 
 private slots:
 
+   void  onCyclicTimerEvent(void);
+
+   void  onCyclicTimerUpdate(void);
+
+   void  onErrorCoalesceTimeout(void);
+
    void  onInterfaceConnectionChanged(const QCanInterface::ConnectionState_e & teConnectionStateR);
 
    void  onInterfaceLogMessage(QString clMessageV, QCan::LogLevel_e teLogLevelV);
@@ -479,6 +1063,8 @@ private slots:
 
    void  onInterfaceStateChange(QCan::CAN_State_e teStateV);
 
+   void  onMulticastTimeout(void);
+
    /*!
    ** This slot is called upon local socket connection.
    */
@@ -494,6 +1080,16 @@ private slots:
    */
    void onLocalSocketNewData(void);
 
+   /*!
+   ** This slot is called upon TCP socket disconnection.
+   */
+   void onTcpSocketDisconnect(void);
+
+   /*!
+   ** This slot is called when new data is available on any open TCP socket.
+   */
+   void onTcpSocketNewData(void);
+
    /*!
    ** This slot is called when new data is available on any open web socket.
    */
@@ -511,6 +1107,8 @@ private slots:
 
    void onTimerEvent(void);
 
+   void onTransmitTimerEvent(void);
+
 
 
 private:
@@ -521,17 +1119,70 @@ private:
    enum FrameSource_e {
       eFRAME_SOURCE_CAN_IF = 1,
       eFRAME_SOURCE_LOCAL_SOCKET,
-      eFRAME_SOURCE_WEB_SOCKET
+      eFRAME_SOURCE_WEB_SOCKET,
+      eFRAME_SOURCE_TCP_SOCKET,
+      eFRAME_SOURCE_MUX_SOCKET,
+      eFRAME_SOURCE_CYCLIC,
+      eFRAME_SOURCE_ROUTE
    };
 
    //---------------------------------------------------------------------------------------------------
-   // returns number of bits inside a data frame for static calculations
+   // central message handler, pubSockDataV points to #QCAN_FRAME_ARRAY_SIZE bytes of frame data
+   // which may be modified (time-stamp), uqIngressTimeV is the reception time of the frame in [ns]
+   // based on clFrameTimeP, pclSockSrcV is the source socket (nullptr if the source is no socket).
+   // dispatchCanFrame() writes the frame to the clients, it is called by handleCanFrame() or by
+   // processTransmitQueue() when a queued frame has been written to the CAN interface.
+   //
+   bool     handleCanFrame(enum FrameSource_e teFrameSrcV, const QObject * pclSockSrcV, uint8_t * pubSockDataV,
+                           const uint64_t uqIngressTimeV);
+   bool     dispatchCanFrame(enum FrameSource_e teFrameSrcV, const QObject * pclSockSrcV, uint8_t * pubSockDataV,
+                             const uint64_t uqIngressTimeV);
+
+   //---------------------------------------------------------------------------------------------------
+   // coalescing of error frames from the CAN interface: coalesceErrorFrame() returns true if the
+   // error frame has been merged, flushErrorFrames() dispatches the merged error frame and ends the
+   // run of identical error frames if btEndRunV is true
+   //
+   bool     coalesceErrorFrame(const QCanFrame & clErrorFrameR, const uint64_t uqIngressTimeV);
+   void     flushErrorFrames(const bool btEndRunV);
+
+   //---------------------------------------------------------------------------------------------------
+   // handler for control messages (see #QCAN_CONTROL_MARKER) received from a stream socket (local
+   // socket or TCP socket) or a WebSocket, one of the socket pointers is nullptr
    //
-   uint32_t frameSize(const QByteArray & clSockDataR);
+   void     handleControl(QIODevice * pclStreamSockV, QWebSocket * pclWebSockV, const uint8_t * pubSockDataV);
+
+   //---------------------------------------------------------------------------------------------------
+   // allocate the receive buffer and the socket lists, this is done when the network is enabled or
+   // a socket is attached, so a server with many networks only pays for the networks in use
+   //
+   void     allocateResources(void);
+
+   //---------------------------------------------------------------------------------------------------
+   // returns true if the CAN frame is forwarded to the socket pclSocketV, uqTimeV is given in [ms]
+   //
+   bool     isForwarded(const QObject * pclSocketV, const uint8_t * pubSockDataV, const uint64_t uqTimeV);
+
+   void     removeChangeFilter(const QObject * pclSocketV);
 
-   bool     handleCanFrame(enum FrameSource_e teFrameSrcV, const int32_t slSockSrcV, QByteArray clSockDataV);
+   //---------------------------------------------------------------------------------------------------
+   // multicast publication: appendMulticast() packs the CAN frame into the pending datagram,
+   // flushMulticast() sends the pending datagram
+   //
+   void     appendMulticast(const uint8_t * pubSockDataV);
+   void     flushMulticast(void);
 
    void     logSocketState(const QString & clInfoR);
+
+   //---------------------------------------------------------------------------------------------------
+   // write CAN frames from the transmit queue to the CAN interface as long as it accepts them
+   //
+   void     processTransmitQueue(void);
+
+   //---------------------------------------------------------------------------------------------------
+   // dispatch a CAN frame which has been forwarded by a route of another network
+   //
+   void     routeCanFrame(const QCanFrame & clFrameR);
    
    void     sendNetworkSettings(uint32_t flags = 0);
 
@@ -555,27 +1206,83 @@ private:
    QPointer<QCanInterface> pclInterfaceP;
 
    //---------------------------------------------------------------------------------------------------
-   // Management of local sockets:  a QLocalServer (pclLocalSrvP) is used to handle a fixed number of 
-   // QLocalSockets (pclLocalSockListP)
+   // Management of client sockets: each socket list has an index for the lookup of the sender of a
+   // signal (see QCanSocketList). The mutex of a list is only held while the list is modified, copied
+   // or evaluated for the statistic: the CAN frames are dispatched to an implicitly shared copy of
+   // the list, which is not affected by a socket that connects or disconnects during the dispatch.
+   //
+   inline uint32_t socketMax(const uint32_t ulDefaultV) const
+                                                   { return ((ulSocketLimitP > 0) ? ulSocketLimitP : ulDefaultV); }
+
+   uint32_t                ulSocketLimitP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Management of local sockets:  a QLocalServer (pclLocalSrvP) is used to handle the QLocalSockets
+   // (pclLocalSockListP)
    //
    QPointer<QLocalServer>  pclLocalSrvP;
-   QVector<QLocalSocket*>  clLocalSockListP;
-   QMutex                  clLocalSockMutexP;
+   QCanSocketList<QLocalSocket>  clLocalSockListP;
+   mutable QMutex          clLocalSockMutexP;
+   QByteArray              clLocalSockDataP;
 
    //---------------------------------------------------------------------------------------------------
-   // Management of WebSockets for CAN frames: a fixed number of QWebSockets (pclWebSockListP) is kept 
-   // in a list
+   // Management of WebSockets for CAN frames: the QWebSockets (pclWebSockListP) are kept in a list
    //
-   QVector<QWebSocket *>   clWebSockListP;
-   QMutex                  clWebSockMutexP;
+   QCanSocketList<QWebSocket>    clWebSockListP;
+   mutable QMutex          clWebSockMutexP;
+   uint8_t                 aubWebSockDataP[QCAN_FRAME_ARRAY_SIZE];
 
    //---------------------------------------------------------------------------------------------------
    // Management of WebSockets for network settings 
    //
    QVector<QWebSocket *>   clSettingsListP;
 
+   //---------------------------------------------------------------------------------------------------
+   // Management of raw TCP sockets for CAN frames: the sockets are accepted by the QCanServer, the
+   // receive buffer clLocalSockDataP is shared with the local sockets
+   //
+   QCanSocketList<QTcpSocket>    clTcpSockListP;
+   mutable QMutex          clTcpSockMutexP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Bridge links: clBridgeListP holds the links to remote servers. clBridgeLinkP holds the link
+   // identifier of each TCP socket which is the bridge link of a remote server, clBridgeSequenceP
+   // holds the next expected sequence number of each link identifier. The sequence number is kept
+   // after a connection loss, so CAN frames sent again by the remote server are dropped.
+   //
+   QVector<QPointer<QCanBridge>>       clBridgeListP;
+   QHash<const QObject *, QByteArray>  clBridgeLinkP;
+   QCanBridgeSequence                  clBridgeSequenceP;
+
+   //---------------------------------------------------------------------------------------------------
+   // multiplexed connections, the QCanMuxSocket objects are owned by the QCanServer
+   //
+   QCanSocketList<QCanMuxSocket>       clMuxSockListP;
+   mutable QMutex                      clMuxSockMutexP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Multicast publication: clMulticastDatagramP holds the pending datagram, clMulticastTimerP
+   // sends the pending datagram when control returns to the event loop
+   //
+   QUdpSocket *            pclMulticastSocketP;
+   QHostAddress            clMulticastGroupP;
+   uint16_t                uwMulticastPortP;
+   QString                 clMulticastInterfaceP;
+   QCanMulticastDatagram   clMulticastDatagramP;
+   QTimer                  clMulticastTimerP;
+
    QTimer                  clRefreshTimerP;
 
+   //---------------------------------------------------------------------------------------------------
+   // Cyclic transmit table: the table is processed by clCyclicTimerP with a period of 1 ms, the time
+   // base is clCyclicTimeP
+   //
+   QCanCyclicTable         clCyclicTableP;
+   QMutex                  clCyclicMutexP;
+   QTimer                  clCyclicTimerP;
+   QElapsedTimer           clCyclicTimeP;
+   QVector<QCanFrame>      clCyclicFrameListP;
+
    //---------------------------------------------------------------------------------------------------
    // bit-rate settings: the variables hold the bit-rate in bit/s, if no bit-rate is configured the 
    // value is eCAN_BITRATE_NONE
@@ -590,6 +1297,68 @@ private:
 
    QCanFrame               clCanFrameOutP;
 
+   //---------------------------------------------------------------------------------------------------
+   // Transmit queue for the CAN interface: frames which are not accepted by the CAN interface are
+   // stored in priority order, clTrmQueueTimerP retries the transmission with a period of 1 ms
+   //
+   QCanTransmitQueue       clTrmQueueP;
+   QTimer                  clTrmQueueTimerP;
+   QElapsedTimer           clTrmQueueTimeP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Routing rules: CAN frames matching a rule are forwarded to the target network, clRouteTimeP is
+   // the time base for the rate limit
+   //
+   typedef struct Route_s {
+      QCanRoute               clRoute;
+      QPointer<QCanNetwork>   pclTarget;
+   } Route_ts;
+
+   QVector<Route_ts>       atsRouteP;
+   QCanFrame               clCanFrameRouteP;
+   QElapsedTimer           clRouteTimeP;
+
+   //---------------------------------------------------------------------------------------------------
+   // statistic per CAN identifier, clFrameTimeP is the time base for the reception of CAN frames
+   //
+   QCanIdStatistic         clIdStatisticP;
+   QElapsedTimer           clFrameTimeP;
+
+   //---------------------------------------------------------------------------------------------------
+   // latency histograms: ingress to dispatch per source type, ingress to egress per destination type
+   //
+   QCanLatencyHistogram    aclLatencyDispatchP[eLATENCY_PATH_MAX];
+   QCanLatencyHistogram    aclLatencyEgressP[eLATENCY_PATH_MAX];
+
+   //---------------------------------------------------------------------------------------------------
+   // Sockets which only receive changed CAN frames (see #QCAN_CONTROL_FORWARD_MODE), the key is the
+   // QLocalSocket, QWebSocket or QTcpSocket
+   //
+   QHash<const QObject *, QCanChangeFilter *>   clChangeFilterP;
+
+   //---------------------------------------------------------------------------------------------------
+   // most recent CAN frame per CAN identifier
+   //
+   QCanFrameCache          clFrameCacheP;
+
+   //---------------------------------------------------------------------------------------------------
+   // delivery stamp mode (QCAN_DELIVERY_STAMP_xxx) and sequence number per socket
+   //
+   uint8_t                 ubDeliveryStampP;
+   QCanDeliveryStamp       clDeliveryStampP;
+
+   //---------------------------------------------------------------------------------------------------
+   // coalescing of error frames, clErrorCoalesceTimerP dispatches the merged frames once per window
+   //
+   QCanErrorCoalescing     clErrorCoalescingP;
+   QTimer                  clErrorCoalesceTimerP;
+
+   //---------------------------------------------------------------------------------------------------
+   // number of CAN frames which could not be written per socket, the key is the QLocalSocket,
+   // QWebSocket or QTcpSocket
+   //
+   QHash<const QObject *, uint32_t>    clSocketDropP;
+
    //---------------------------------------------------------------------------------------------------
    // statistic frame counter
    //
@@ -597,9 +1366,10 @@ private:
    uint32_t                ulCntFrameErrP;
 
    //---------------------------------------------------------------------------------------------------
-   // statistic bit counter
+   // statistic bit counter, bits of arbitration phase and data phase (bit rate switch)
    //
-   uint32_t                ulCntBitCurP;
+   uint64_t                uqCntBitNomP;
+   uint64_t                uqCntBitDatP;
 
    //---------------------------------------------------------------------------------------------------
    // statistic timing
@@ -608,6 +1378,7 @@ private:
 
    uint32_t                ulStatisticTimeP;
    uint32_t                ulFramePerSecMaxP;
+   uint32_t                ulFramePerSecP;
    uint32_t                ulFrameCntSaveP;
    uint8_t                 ubBusLoadP;
 
@@ -34,6 +34,7 @@
 \*--------------------------------------------------------------------------------------------------------------------*/
 
 #include <QtCore/QDebug>
+#include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 
@@ -88,6 +89,30 @@ QCanNetworkSettings::~QCanNetworkSettings()
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::addCyclicFrame()                                                                              //
+// add CAN frame to cyclic transmit table                                                                             //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetworkSettings::addCyclicFrame(const uint32_t ulHandleV, const QCanFrame & clFrameR,
+                                         const uint32_t ulPeriodV, const int32_t slCounterPosV)
+{
+   QJsonArray  clJsonArrayT;
+   QJsonObject clJsonEntryT;
+
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server, the frame is transferred Base64 encoded
+   //
+   clJsonEntryT["handle"]                 = static_cast< int32_t >(ulHandleV);
+   clJsonEntryT["period"]                 = static_cast< int32_t >(ulPeriodV);
+   clJsonEntryT["counter"]                = static_cast< int32_t >(slCounterPosV);
+   clJsonEntryT["frame"]                  = QString::fromLatin1(clFrameR.toByteArray().toBase64());
+
+   clJsonArrayT = clJsonCommandP.value("cyclicStart").toArray();
+   clJsonArrayT.append(clJsonEntryT);
+   clJsonCommandP["cyclicStart"]          = clJsonArrayT;
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetworkSettings::connectToServer()                                                                             //
 // connect to CANpie FD server                                                                                        //
@@ -142,6 +167,83 @@ void QCanNetworkSettings::closeConnection(void)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::clearCyclicFrames()                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetworkSettings::clearCyclicFrames(void)
+{
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server, pending start / update commands are obsolete
+   //
+   clJsonCommandP.remove("cyclicStart");
+   clJsonCommandP.remove("cyclicUpdate");
+   clJsonCommandP["cyclicClear"]          = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::clearFrameCache()                                                                             //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetworkSettings::clearFrameCache(void)
+{
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server
+   //
+   clJsonCommandP["frameCacheClear"]      = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::clearIdStatistic()                                                                            //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetworkSettings::clearIdStatistic(void)
+{
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server
+   //
+   clJsonCommandP["idStatisticClear"]     = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::clearLatency()                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetworkSettings::clearLatency(void)
+{
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server
+   //
+   clJsonCommandP["latencyClear"]         = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::cyclicFrameCount()                                                                            //
+// return number of CAN frames in cyclic transmit table                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanNetworkSettings::cyclicFrameCount(void)
+{
+   uint32_t ulResultT = 0;
+
+   if (teServerStateP == QCanNetworkSettings::eSTATE_ACTIVE)
+   {
+      if (clJsonNetworkP.isEmpty() == false)
+      {
+         if (clJsonNetworkP.contains("cyclicCount"))
+         {
+            ulResultT = static_cast< uint32_t >(clJsonNetworkP.value("cyclicCount").toInt());
+         }
+      }
+   }
+
+   return (ulResultT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetworkSettings::dataBitrate()                                                                                 //
 // return the data bit-rate of the current CAN interface                                                              //
@@ -205,6 +307,29 @@ QString QCanNetworkSettings::dataBitrateString(void)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::deliveryStamp()                                                                               //
+// return delivery stamp mode                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+uint8_t QCanNetworkSettings::deliveryStamp(void)
+{
+   uint8_t  ubResultT = QCAN_DELIVERY_STAMP_NONE;
+
+   if (teServerStateP == QCanNetworkSettings::eSTATE_ACTIVE)
+   {
+      if (clJsonNetworkP.isEmpty() == false)
+      {
+         if (clJsonNetworkP.contains("deliveryStamp"))
+         {
+            ubResultT = static_cast< uint8_t >(clJsonNetworkP.value("deliveryStamp").toInt());
+         }
+      }
+   }
+
+   return (ubResultT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetworkSettings::errorCount()                                                                                  //
 //                                                                                                                    //
@@ -232,6 +357,52 @@ uint32_t QCanNetworkSettings::errorCount(void)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::errorFrameCoalescing()                                                                        //
+// return coalescing window for error frames                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanNetworkSettings::errorFrameCoalescing(void)
+{
+   uint32_t ulResultT = 0;
+
+   if (teServerStateP == QCanNetworkSettings::eSTATE_ACTIVE)
+   {
+      if (clJsonNetworkP.isEmpty() == false)
+      {
+         if (clJsonNetworkP.contains("errorFrameCoalescing"))
+         {
+            ulResultT = static_cast< uint32_t >(clJsonNetworkP.value("errorFrameCoalescing").toInt());
+         }
+      }
+   }
+
+   return (ulResultT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::frameCacheCount()                                                                             //
+// return number of CAN frames in frame cache                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanNetworkSettings::frameCacheCount(void)
+{
+   uint32_t ulResultT = 0;
+
+   if (teServerStateP == QCanNetworkSettings::eSTATE_ACTIVE)
+   {
+      if (clJsonNetworkP.isEmpty() == false)
+      {
+         if (clJsonNetworkP.contains("frameCacheCount"))
+         {
+            ulResultT = static_cast< uint32_t >(clJsonNetworkP.value("frameCacheCount").toInt());
+         }
+      }
+   }
+
+   return (ulResultT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetworkSettings::frameCount()                                                                                  //
 //                                                                                                                    //
@@ -259,6 +430,29 @@ uint32_t QCanNetworkSettings::frameCount(void)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::idStatisticCount()                                                                            //
+// return number of CAN identifiers in statistic                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanNetworkSettings::idStatisticCount(void)
+{
+   uint32_t ulResultT = 0;
+
+   if (teServerStateP == QCanNetworkSettings::eSTATE_ACTIVE)
+   {
+      if (clJsonNetworkP.isEmpty() == false)
+      {
+         if (clJsonNetworkP.contains("idStatisticCount"))
+         {
+            ulResultT = static_cast< uint32_t >(clJsonNetworkP.value("idStatisticCount").toInt());
+         }
+      }
+   }
+
+   return (ulResultT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetworkSettings::isValid()                                                                                     //
 //                                                                                                                    //
@@ -282,6 +476,29 @@ bool QCanNetworkSettings::isValid(void)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::latency()                                                                                     //
+// return summary of latency histograms                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+QJsonObject QCanNetworkSettings::latency(void)
+{
+   QJsonObject clResultT;
+
+   if (teServerStateP == QCanNetworkSettings::eSTATE_ACTIVE)
+   {
+      if (clJsonNetworkP.isEmpty() == false)
+      {
+         if (clJsonNetworkP.contains("latency"))
+         {
+            clResultT = clJsonNetworkP.value("latency").toObject();
+         }
+      }
+   }
+
+   return (clResultT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetworkSettings::name()                                                                                        //
 // return the name of the current CAN interface                                                                       //
@@ -505,11 +722,55 @@ void QCanNetworkSettings::onSocketMessageReceived(const QString & clMessageR)
          clJsonNetworkP = clJsonDocumentT.object();
          emit objectReceived(teChannelP ,clJsonNetworkP);
       }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for content of frame cache, the CAN frames are Base64 encoded
+      //
+      if (clJsonDocumentT.object().contains("frameCache"))
+      {
+         QJsonArray           clJsonArrayT = clJsonDocumentT.object().value("frameCache").toArray();
+         QVector<QCanFrame>   clFrameListT;
+         QCanFrame            clFrameT;
+
+         for (int32_t slIndexT = 0; slIndexT < clJsonArrayT.size(); slIndexT++)
+         {
+            if (clFrameT.fromByteArray(QByteArray::fromBase64(clJsonArrayT.at(slIndexT).toString().toLatin1())))
+            {
+               clFrameListT.append(clFrameT);
+            }
+         }
+         emit frameCacheReceived(teChannelP, clFrameListT);
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Check for snapshot of identifier statistic
+      //
+      if (clJsonDocumentT.object().contains("idStatistic"))
+      {
+         emit idStatisticReceived(teChannelP, clJsonDocumentT.object().value("idStatistic").toArray());
+      }
    }
 
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::removeCyclicFrame()                                                                           //
+// remove CAN frame from cyclic transmit table                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetworkSettings::removeCyclicFrame(const uint32_t ulHandleV)
+{
+   QJsonArray  clJsonArrayT;
+
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server
+   //
+   clJsonArrayT = clJsonCommandP.value("cyclicStop").toArray();
+   clJsonArrayT.append(static_cast< int32_t >(ulHandleV));
+   clJsonCommandP["cyclicStop"]           = clJsonArrayT;
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetworkSettings::reset()                                                                                       //
 //                                                                                                                    //
@@ -524,6 +785,32 @@ void QCanNetworkSettings::reset(void)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::requestFrameCache()                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetworkSettings::requestFrameCache(void)
+{
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server
+   //
+   clJsonCommandP["frameCache"]           = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::requestIdStatistic()                                                                          //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetworkSettings::requestIdStatistic(void)
+{
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server
+   //
+   clJsonCommandP["idStatistic"]          = true;
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetworkSettings::requestUpdate()                                                                               //
 //                                                                                                                    //
@@ -560,8 +847,20 @@ bool QCanNetworkSettings::send(void)
       //
       clJsonCommandP.remove("bitrateData");
       clJsonCommandP.remove("bitrateNominal");
+      clJsonCommandP.remove("cyclicClear");
+      clJsonCommandP.remove("cyclicStart");
+      clJsonCommandP.remove("cyclicStop");
+      clJsonCommandP.remove("cyclicUpdate");
+      clJsonCommandP.remove("deliveryStamp");
+      clJsonCommandP.remove("errorFrameCoalescing");
+      clJsonCommandP.remove("frameCache");
+      clJsonCommandP.remove("frameCacheClear");
+      clJsonCommandP.remove("idStatistic");
+      clJsonCommandP.remove("idStatisticClear");
+      clJsonCommandP.remove("latencyClear");
       clJsonCommandP.remove("mode");
       clJsonCommandP.remove("reset");
+      clJsonCommandP.remove("transmitDeadline");
 
 
    }
@@ -601,6 +900,32 @@ void QCanNetworkSettings::setChannel(const QCan::CAN_Channel_e teChannelV)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::setDeliveryStamp()                                                                            //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetworkSettings::setDeliveryStamp(const uint8_t ubModeV)
+{
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server
+   //
+   clJsonCommandP["deliveryStamp"]        = static_cast< int32_t >(ubModeV);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::setErrorFrameCoalescing()                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetworkSettings::setErrorFrameCoalescing(const uint32_t ulWindowV)
+{
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server
+   //
+   clJsonCommandP["errorFrameCoalescing"] = static_cast< int32_t >(ulWindowV);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetworkSettings::setMode()                                                                                     //
 //                                                                                                                    //
@@ -614,6 +939,19 @@ void QCanNetworkSettings::setMode(const QCan::CAN_Mode_e teModeV)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::setTransmitDeadline()                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetworkSettings::setTransmitDeadline(const uint32_t ulDeadlineV)
+{
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server
+   //
+   clJsonCommandP["transmitDeadline"]     = static_cast< int32_t >(ulDeadlineV);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanNetworkSettings::state()                                                                                       //
 // return CAN network state                                                                                           //
@@ -675,3 +1013,47 @@ QString QCanNetworkSettings::stateString(void)
    return (clResultT);
 }
 
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::transmitDropCount()                                                                           //
+// return number of discarded CAN frames                                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanNetworkSettings::transmitDropCount(void)
+{
+   uint32_t ulResultT = 0;
+
+   if (teServerStateP == QCanNetworkSettings::eSTATE_ACTIVE)
+   {
+      if (clJsonNetworkP.isEmpty() == false)
+      {
+         if (clJsonNetworkP.contains("transmitDropCount"))
+         {
+            ulResultT = static_cast< uint32_t >(clJsonNetworkP.value("transmitDropCount").toInt());
+         }
+      }
+   }
+
+   return (ulResultT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanNetworkSettings::updateCyclicFrame()                                                                           //
+// update payload of CAN frame in cyclic transmit table                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanNetworkSettings::updateCyclicFrame(const uint32_t ulHandleV, const QCanFrame & clFrameR)
+{
+   QJsonArray  clJsonArrayT;
+   QJsonObject clJsonEntryT;
+
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server
+   //
+   clJsonEntryT["handle"]                 = static_cast< int32_t >(ulHandleV);
+   clJsonEntryT["frame"]                  = QString::fromLatin1(clFrameR.toByteArray().toBase64());
+
+   clJsonArrayT = clJsonCommandP.value("cyclicUpdate").toArray();
+   clJsonArrayT.append(clJsonEntryT);
+   clJsonCommandP["cyclicUpdate"]         = clJsonArrayT;
+}
+
@@ -38,12 +38,15 @@
 \*--------------------------------------------------------------------------------------------------------------------*/
 
 
+#include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 #include <QtCore/QPointer>
+#include <QtCore/QVector>
 
 #include <QtWebSockets/QWebSocket>
 
 #include "qcan_defs.hpp"
+#include "qcan_frame.hpp"
 #include "qcan_namespace.hpp"
 
 
@@ -75,6 +78,20 @@ public:
    QCanNetworkSettings(QCanNetworkSettings&&) = delete;                       // no move constructor
    QCanNetworkSettings& operator=(QCanNetworkSettings&&) = delete;            // no move operator
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV     - Handle of cyclic entry
+   ** \param[in]  clFrameR      - CAN frame
+   ** \param[in]  ulPeriodV     - Transmission period in [ms]
+   ** \param[in]  slCounterPosV - Position of rolling counter byte, -1 for none
+   ** \see        removeCyclicFrame(), updateCyclicFrame()
+   **
+   ** Add the CAN frame \a clFrameR to the cyclic transmit table of the QCanNetwork. The command is
+   ** transferred with the next call of send(), see QCanNetwork::addCyclicFrame() for details.
+   */
+   void                 addCyclicFrame(const uint32_t ulHandleV, const QCanFrame & clFrameR,
+                                       const uint32_t ulPeriodV, const int32_t slCounterPosV = -1);
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  clServerAddressV - IPv4 or IPv6 address of QCanNetwork class
@@ -102,6 +119,47 @@ public:
    ** The method closes a WebSocket connection to a QCanNetwork class.
    */
    void                 closeConnection(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        addCyclicFrame()
+   **
+   ** Remove all CAN frames from the cyclic transmit table of the QCanNetwork.
+   */
+   void                 clearCyclicFrames(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        requestFrameCache()
+   **
+   ** Remove all CAN frames from the frame cache of the QCanNetwork.
+   */
+   void                 clearFrameCache(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of cyclic CAN frames
+   ** \see        addCyclicFrame()
+   **
+   ** Return the number of CAN frames inside the cyclic transmit table of the selected network.
+   */
+   uint32_t             cyclicFrameCount(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        requestIdStatistic()
+   **
+   ** Remove all entries from the identifier statistic of the QCanNetwork.
+   */
+   void                 clearIdStatistic(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        latency()
+   **
+   ** Remove all values from the latency histograms of the QCanNetwork.
+   */
+   void                 clearLatency(void);
    
    //---------------------------------------------------------------------------------------------------
    /*!
@@ -124,6 +182,15 @@ public:
    */
    QString              dataBitrateString(void);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return  Delivery stamp mode
+   ** \see     setDeliveryStamp()
+   **
+   ** Return the delivery stamp mode (QCAN_DELIVERY_STAMP_xxx) of the selected network.
+   */
+   uint8_t              deliveryStamp(void);
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return  Error counter value
@@ -133,6 +200,16 @@ public:
    */
    uint32_t             errorCount(void);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return  Coalescing window for error frames in milliseconds
+   ** \see     setErrorFrameCoalescing()
+   **
+   ** Return the coalescing window for error frames of the selected network, the value 0 denotes
+   ** that error frames are not coalesced.
+   */
+   uint32_t             errorFrameCoalescing(void);
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return  Frame counter value
@@ -142,6 +219,25 @@ public:
    */
    uint32_t             frameCount(void);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return  Number of CAN frames
+   ** \see     requestFrameCache()
+   **
+   ** Return the number of CAN frames inside the frame cache of the selected network.
+   */
+   uint32_t             frameCacheCount(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return  Number of CAN identifiers
+   ** \see     requestIdStatistic()
+   **
+   ** Return the number of different CAN identifiers inside the identifier statistic of the selected
+   ** network.
+   */
+   uint32_t             idStatisticCount(void);
+
    //---------------------------------------------------------------------------------------------------
    /*!
    **
@@ -152,6 +248,16 @@ public:
    */
    bool                 isValid(void);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return  JSON object
+   ** \see     clearLatency()
+   **
+   ** Return the summary of the latency histograms of the selected network, the format is described
+   ** in QCanNetwork::latency(). The function returns an empty object if no data is available.
+   */
+   QJsonObject          latency(void);
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return  Network name
@@ -181,6 +287,15 @@ public:
    */
    QString              nominalBitrateString(void);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV     - Handle of cyclic entry
+   ** \see        addCyclicFrame()
+   **
+   ** Remove the CAN frame with the handle \a ulHandleV from the cyclic transmit table of the QCanNetwork.
+   */
+   void                 removeCyclicFrame(const uint32_t ulHandleV);
+
    //---------------------------------------------------------------------------------------------------
    /*!
    **
@@ -188,6 +303,26 @@ public:
    */
    void                 reset(void);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see     frameCacheReceived()
+   **
+   ** Request the most recent CAN frame of each CAN identifier from the QCanNetwork. The command is
+   ** transferred with the next call of send(), the CAN frames are signalled by frameCacheReceived().
+   ** This allows clients with a low update rate to poll the CAN frames instead of receiving the
+   ** complete stream via a QCanSocket.
+   */
+   void                 requestFrameCache(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see     idStatisticReceived()
+   **
+   ** Request a snapshot of the statistic per CAN identifier from the QCanNetwork. The command is
+   ** transferred with the next call of send(), the snapshot is signalled by idStatisticReceived().
+   */
+   void                 requestIdStatistic(void);
+
    void                 requestUpdate(void);
 
    bool                 send(void);
@@ -203,6 +338,25 @@ public:
 
    void                 setChannel(const QCan::CAN_Channel_e teChannelV);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ubModeV     Delivery stamp mode
+   ** \see        deliveryStamp()
+   **
+   ** Set the delivery stamp mode of the network, see QCanNetwork::setDeliveryStamp() for details.
+   */
+   void                 setDeliveryStamp(const uint8_t ubModeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulWindowV   Coalescing window in milliseconds
+   ** \see        errorFrameCoalescing()
+   **
+   ** Set the coalescing window for error frames, see QCanNetwork::setErrorFrameCoalescing() for
+   ** details.
+   */
+   void                 setErrorFrameCoalescing(const uint32_t ulWindowV);
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  teModeV     Requested CAN mode
@@ -229,8 +383,61 @@ public:
    */
    QString              stateString(void);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulDeadlineV   - Deadline in milliseconds
+   ** \see        transmitDropCount()
+   **
+   ** Set the maximum time a CAN frame is kept inside the transmit queue of the QCanNetwork, see
+   ** QCanNetwork::setTransmitDeadline() for details.
+   */
+   void                 setTransmitDeadline(const uint32_t ulDeadlineV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of discarded CAN frames
+   ** \see        setTransmitDeadline()
+   **
+   ** Return the number of CAN frames which have been discarded by the transmit queue of the selected
+   ** network.
+   */
+   uint32_t             transmitDropCount(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV     - Handle of cyclic entry
+   ** \param[in]  clFrameR      - CAN frame
+   ** \see        addCyclicFrame()
+   **
+   ** Update the payload of the cyclic CAN frame with the handle \a ulHandleV, the transmission period
+   ** is not changed.
+   */
+   void                 updateCyclicFrame(const uint32_t ulHandleV, const QCanFrame & clFrameR);
+
 signals:
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  teChannelV - CAN channel
+   ** \param[in]  clFrameListV - List of CAN frames
+   ** \see        requestFrameCache()
+   **
+   ** This signal is emitted after the content of the frame cache was received from a QCanNetwork
+   ** instance.
+   */
+   void           frameCacheReceived(const QCan::CAN_Channel_e teChannelV, QVector<QCanFrame> clFrameListV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  teChannelV - CAN channel
+   ** \param[in]  clStatisticV - Array of JSON objects
+   ** \see        requestIdStatistic()
+   **
+   ** This signal is emitted after a snapshot of the identifier statistic was received from a
+   ** QCanNetwork instance. The format of the entries is described in QCanIdStatistic::toJson().
+   */
+   void           idStatisticReceived(const QCan::CAN_Channel_e teChannelV, QJsonArray clStatisticV);
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  teChannelV - CAN channel
@@ -244,17 +451,25 @@ signals:
    **    "bitrateData": 1000000,
    **    "bitrateNominal": 500000,
    **    "channel": 8,
+   **    "cyclicCount": 0,
+   **    "deliveryStamp": 0,
    **    "enabled": true,
+   **    "errorFrameCoalescing": 0,
    **    "errorFrameEnabled": false,
    **    "errorFrameSupport": true,
    **    "flexibleDataEnabled": true,
    **    "flexibleDataSupport": true,
+   **    "frameCacheCount": 0,
    **    "frameCount": 0,
    **    "frameCountError": 0,
+   **    "idStatisticCount": 0,
+   **    "latency": { "dispatch": { ... }, "egress": { ... } },
    **    "listenOnlyEnabled": false,
    **    "listenOnlySupport": false,
    **    "name": "CAN 8",
-   **    "state": 2
+   **    "state": 2,
+   **    "transmitDeadline": 100,
+   **    "transmitDropCount": 0
    ** }
    ** \endcode
    */
@@ -41,7 +41,10 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QFile>
 #include <QtCore/QObject>
+
+#ifndef QCAN_NO_QT_GUI
 #include <QtGui/QIcon>
+#endif
 
 
 #include "qcan_interface.hpp"
@@ -90,9 +93,17 @@ public:
    /*!
    ** \return     Icon of plug-in
    **
-   ** The function returns the icon of the plug-in.
+   ** The function returns the icon of the plug-in. In case an application is compiled without Qt GUI
+   ** support, the definition QCAN_NO_QT_GUI must be set.
    */
+   #ifndef QCAN_NO_QT_GUI
    virtual QIcon           icon(void) = 0;
+   #else
+   //---------------------------------------------------------------------------------------------------
+   // placeholder for icon() which keeps the layout of the virtual table, see QCanInterface
+   //
+   virtual void            iconReserved(void) { }
+   #endif
 
 
    //---------------------------------------------------------------------------------------------------
@@ -0,0 +1,486 @@
+//====================================================================================================================//
+// File:          qcan_plugin_registry.cpp                                                                            //
+// Description:   QCAN classes - Registry of CAN interface plug-ins                                                   //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonObject>
+#include <QtCore/QLibrary>
+#include <QtCore/QSettings>
+
+#include "qcan_plugin_registry.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Static variables                                                                                                   **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+QCanPluginRegistry * QCanPluginRegistry::pclInstanceS = nullptr;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanPluginRegistry()                                                                                               //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanPluginRegistry::QCanPluginRegistry()
+{
+   //---------------------------------------------------------------------------------------------------
+   // default plug-in directory
+   //
+   QDir clPluginsDirT(QCoreApplication::applicationDirPath());
+   #if defined(Q_OS_MAC)
+   if (clPluginsDirT.dirName() == "MacOS")
+   {
+      clPluginsDirT.cdUp();
+      clPluginsDirT.setPath(clPluginsDirT.path() + "/Plugins");
+   }
+   #else
+   clPluginsDirT.setPath(clPluginsDirT.path() + "/plugins");
+   #endif
+   clPluginPathP = clPluginsDirT;
+
+   //---------------------------------------------------------------------------------------------------
+   // the plug-in directory is scanned only here, in setPluginPath() and in refresh()
+   //
+   readCache();
+   scanDirectory();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanPluginRegistry::findInterface()                                                                                //
+// plug-ins which provided the interface the last time are searched first                                             //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanInterface * QCanPluginRegistry::findInterface(const QString & clNameR)
+{
+   QCanInterface *   pclInterfaceT = nullptr;
+   QCanPlugin *      pclPluginT;
+   QList<int32_t>    aslSearchT;
+   bool              btLoadedT = false;
+
+   //---------------------------------------------------------------------------------------------------
+   // search order: first the plug-ins with a matching cache entry, then the remaining plug-ins
+   //
+   for (int32_t slEntryT = 0; slEntryT < atsEntryP.size(); slEntryT++)
+   {
+      if (atsEntryP.at(slEntryT).clInterfaceList.contains(clNameR))
+      {
+         aslSearchT.prepend(slEntryT);
+      }
+      else
+      {
+         aslSearchT.append(slEntryT);
+      }
+   }
+
+   foreach (int32_t slEntryT, aslSearchT)
+   {
+      if (atsEntryP[slEntryT].pclPlugin == nullptr)
+      {
+         btLoadedT = true;
+      }
+
+      pclPluginT = loadPlugin(atsEntryP[slEntryT]);
+      if (pclPluginT == nullptr)
+      {
+         continue;
+      }
+
+      for (uint8_t ubIfCntT = 0; ubIfCntT < pclPluginT->interfaceCount(); ubIfCntT++)
+      {
+         QCanInterface * pclCanIfT = pclPluginT->getInterface(ubIfCntT);
+         if ((pclCanIfT != nullptr) && (pclCanIfT->name() == clNameR))
+         {
+            pclInterfaceT = pclCanIfT;
+            break;
+         }
+      }
+
+      if (pclInterfaceT != nullptr)
+      {
+         break;
+      }
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the cache file is only written if a plug-in has been instantiated
+   //
+   if (btLoadedT)
+   {
+      writeCache();
+   }
+
+   return (pclInterfaceT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanPluginRegistry::instance()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanPluginRegistry & QCanPluginRegistry::instance(void)
+{
+   if (pclInstanceS == nullptr)
+   {
+      pclInstanceS = new QCanPluginRegistry();
+   }
+
+   return (*pclInstanceS);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanPluginRegistry::interfaceNames()                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QStringList QCanPluginRegistry::interfaceNames(const int32_t slPluginV) const
+{
+   QStringList clInterfaceListT;
+
+   if ((slPluginV >= 0) && (slPluginV < atsEntryP.size()))
+   {
+      clInterfaceListT = atsEntryP.at(slPluginV).clInterfaceList;
+   }
+
+   return (clInterfaceListT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanPluginRegistry::isCacheComplete()                                                                              //
+// a plug-in which could not be instantiated is not taken into account                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanPluginRegistry::isCacheComplete(void) const
+{
+   foreach (const PluginEntry_ts & tsEntryR, atsEntryP)
+   {
+      if ((tsEntryR.clName.isEmpty()) && (tsEntryR.btFailed == false))
+      {
+         return (false);
+      }
+   }
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanPluginRegistry::loadPlugin()                                                                                   //
+// instantiate the plug-in of an entry and update the interface lists                                                 //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanPlugin * QCanPluginRegistry::loadPlugin(PluginEntry_ts & tsEntryR)
+{
+   QCanInterface *   pclCanIfT;
+
+   if (tsEntryR.pclPlugin != nullptr)
+   {
+      return (tsEntryR.pclPlugin);
+   }
+
+   if (tsEntryR.pclLoader == nullptr)
+   {
+      tsEntryR.pclLoader = new QPluginLoader(tsEntryR.clFilePath);
+   }
+
+   tsEntryR.pclPlugin = qobject_cast<QCanPlugin *>(tsEntryR.pclLoader->instance());
+   tsEntryR.btFailed  = (tsEntryR.pclPlugin == nullptr);
+   if (tsEntryR.pclPlugin == nullptr)
+   {
+      #ifndef QT_NO_DEBUG_OUTPUT
+      qDebug() << "QCanPluginRegistry::loadPlugin() WARNING: plugin" << tsEntryR.clFilePath
+               << "could NOT be loaded:" << tsEntryR.pclLoader->errorString();
+      #endif
+      return (nullptr);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // update the entry, it is stored in the cache file
+   //
+   tsEntryR.clName = tsEntryR.pclPlugin->name();
+   tsEntryR.clInterfaceList.clear();
+   tsEntryR.clFeatureList.clear();
+   for (uint8_t ubIfCntT = 0; ubIfCntT < tsEntryR.pclPlugin->interfaceCount(); ubIfCntT++)
+   {
+      pclCanIfT = tsEntryR.pclPlugin->getInterface(ubIfCntT);
+      if (pclCanIfT != nullptr)
+      {
+         tsEntryR.clInterfaceList.append(pclCanIfT->name());
+         tsEntryR.clFeatureList.append(pclCanIfT->supportedFeatures());
+      }
+   }
+
+   qInfo() << "QCanPluginRegistry::loadPlugin() INFO: found" << tsEntryR.clFilePath << "plugin, which contains"
+           << tsEntryR.clInterfaceList.size() << "interfaces.";
+
+   return (tsEntryR.pclPlugin);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanPluginRegistry::pluginName()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QString QCanPluginRegistry::pluginName(const int32_t slPluginV) const
+{
+   QString  clNameT;
+
+   if ((slPluginV >= 0) && (slPluginV < atsEntryP.size()))
+   {
+      clNameT = atsEntryP.at(slPluginV).clName;
+   }
+
+   return (clNameT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanPluginRegistry::readCache()                                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanPluginRegistry::readCache(void)
+{
+   QSettings         clCacheT(QSettings::IniFormat, QSettings::UserScope, "microcontrol.net", "CANpiePluginCache");
+   PluginEntry_ts    tsEntryT;
+   int32_t           slSizeT;
+
+   tsEntryT.pclLoader = nullptr;
+   tsEntryT.pclPlugin = nullptr;
+   tsEntryT.btFailed  = false;
+
+   slSizeT = clCacheT.beginReadArray("Plugin");
+   for (int32_t slEntryT = 0; slEntryT < slSizeT; slEntryT++)
+   {
+      clCacheT.setArrayIndex(slEntryT);
+      tsEntryT.clFilePath      = clCacheT.value("file").toString();
+      tsEntryT.sqModified      = clCacheT.value("modified", 0).toLongLong();
+      tsEntryT.clName          = clCacheT.value("name").toString();
+      tsEntryT.clInterfaceList = clCacheT.value("interfaces").toStringList();
+
+      tsEntryT.clFeatureList.clear();
+      foreach (QVariant clFeatureT, clCacheT.value("features").toList())
+      {
+         tsEntryT.clFeatureList.append(clFeatureT.toUInt());
+      }
+
+      atsEntryP.append(tsEntryT);
+   }
+   clCacheT.endArray();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanPluginRegistry::refresh()                                                                                      //
+// rescan the directory and instantiate the plug-ins which are not in the cache file                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+int32_t QCanPluginRegistry::refresh(void)
+{
+   bool  btLoadedT = false;
+
+   scanDirectory();
+
+   for (int32_t slEntryT = 0; slEntryT < atsEntryP.size(); slEntryT++)
+   {
+      if (atsEntryP.at(slEntryT).clName.isEmpty())
+      {
+         loadPlugin(atsEntryP[slEntryT]);
+         btLoadedT = true;
+      }
+   }
+
+   if (btLoadedT)
+   {
+      writeCache();
+   }
+
+   return (atsEntryP.size());
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanPluginRegistry::scanDirectory()                                                                                //
+// entries with unchanged file path and modification time are kept                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanPluginRegistry::scanDirectory(void)
+{
+   QList<PluginEntry_ts>   atsScanT;
+   PluginEntry_ts          tsEntryT;
+   QString                 clFilePathT;
+   int64_t                 sqModifiedT;
+   int32_t                 slEntryT;
+
+   if (clPluginPathP.exists() == false)
+   {
+      #ifndef QT_NO_DEBUG_OUTPUT
+      qDebug() << "QCanPluginRegistry::scanDirectory() WARNING: plugin path" << clPluginPathP.absolutePath()
+               << "does not exist!";
+      #endif
+   }
+   else
+   {
+      foreach (QString clFileNameT, clPluginPathP.entryList(QDir::Files, QDir::Name))
+      {
+         clFilePathT = clPluginPathP.absoluteFilePath(clFileNameT);
+         if (QLibrary::isLibrary(clFilePathT) == false)
+         {
+            continue;
+         }
+         sqModifiedT = QFileInfo(clFilePathT).lastModified().toMSecsSinceEpoch();
+
+         //-------------------------------------------------------------------------------------------
+         // keep a known entry if the file is unchanged, a loaded library is never replaced
+         //
+         for (slEntryT = 0; slEntryT < atsEntryP.size(); slEntryT++)
+         {
+            if (atsEntryP.at(slEntryT).clFilePath == clFilePathT)
+            {
+               break;
+            }
+         }
+
+         if (slEntryT < atsEntryP.size())
+         {
+            tsEntryT = atsEntryP.takeAt(slEntryT);
+            if ((tsEntryT.sqModified == sqModifiedT) || (tsEntryT.pclPlugin != nullptr))
+            {
+               atsScanT.append(tsEntryT);
+               continue;
+            }
+            delete (tsEntryT.pclLoader);
+         }
+
+         //-------------------------------------------------------------------------------------------
+         // new or modified file: check the meta data, this does not load the library
+         //
+         tsEntryT.clFilePath = clFilePathT;
+         tsEntryT.sqModified = sqModifiedT;
+         tsEntryT.clName.clear();
+         tsEntryT.clInterfaceList.clear();
+         tsEntryT.clFeatureList.clear();
+         tsEntryT.pclLoader  = new QPluginLoader(clFilePathT);
+         tsEntryT.pclPlugin  = nullptr;
+         tsEntryT.btFailed   = false;
+
+         if (tsEntryT.pclLoader->metaData().value("IID").toString() != QString(QCanPlugin_iid))
+         {
+            #ifndef QT_NO_DEBUG_OUTPUT
+            qDebug() << "QCanPluginRegistry::scanDirectory() WARNING:" << clFilePathT << "is NOT a CANpie plugin!";
+            #endif
+            delete (tsEntryT.pclLoader);
+            continue;
+         }
+
+         atsScanT.append(tsEntryT);
+      }
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // remaining entries belong to removed files: drop them unless the library is loaded
+   //
+   foreach (tsEntryT, atsEntryP)
+   {
+      if (tsEntryT.pclPlugin != nullptr)
+      {
+         atsScanT.append(tsEntryT);
+      }
+      else
+      {
+         delete (tsEntryT.pclLoader);
+      }
+   }
+
+   atsEntryP = atsScanT;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanPluginRegistry::setPluginPath()                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanPluginRegistry::setPluginPath(const QDir & clPathR)
+{
+   clPluginPathP = clPathR;
+   scanDirectory();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanPluginRegistry::writeCache()                                                                                   //
+// only entries of instantiated plug-ins carry interface information                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanPluginRegistry::writeCache(void)
+{
+   QSettings         clCacheT(QSettings::IniFormat, QSettings::UserScope, "microcontrol.net", "CANpiePluginCache");
+   QVariantList      clFeatureListT;
+   int32_t           slIndexT = 0;
+
+   clCacheT.remove("Plugin");
+   clCacheT.beginWriteArray("Plugin");
+   foreach (PluginEntry_ts tsEntryT, atsEntryP)
+   {
+      if (tsEntryT.clName.isEmpty())
+      {
+         continue;
+      }
+
+      clFeatureListT.clear();
+      foreach (uint32_t ulFeatureT, tsEntryT.clFeatureList)
+      {
+         clFeatureListT.append(ulFeatureT);
+      }
+
+      clCacheT.setArrayIndex(slIndexT);
+      clCacheT.setValue("file",       tsEntryT.clFilePath);
+      clCacheT.setValue("modified",   static_cast< qlonglong >(tsEntryT.sqModified));
+      clCacheT.setValue("name",       tsEntryT.clName);
+      clCacheT.setValue("interfaces", tsEntryT.clInterfaceList);
+      clCacheT.setValue("features",   clFeatureListT);
+      slIndexT++;
+   }
+   clCacheT.endArray();
+}
@@ -0,0 +1,197 @@
+//====================================================================================================================//
+// File:          qcan_plugin_registry.hpp                                                                            //
+// Description:   QCAN classes - Registry of CAN interface plug-ins                                                   //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_PLUGIN_REGISTRY_HPP_
+#define QCAN_PLUGIN_REGISTRY_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QDir>
+#include <QtCore/QList>
+#include <QtCore/QPluginLoader>
+#include <QtCore/QStringList>
+
+#include "qcan_plugin.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanPluginRegistry
+** \brief   Process-wide registry of CAN interface plug-ins
+**
+** The QCanPluginRegistry class scans the plug-in directory and keeps one entry for each CANpie plug-in
+** (class QCanPlugin), identified by the file path and the modification time of the library. The
+** plug-in type is checked with the meta data of the library, the library is not loaded for this
+** test. The directory is scanned when the registry is created, by setPluginPath() and by refresh().
+** A plug-in is instantiated only when one of its CAN interfaces is requested.
+** <p>
+** The name of the plug-in and the names and features of its CAN interfaces are only known after the
+** plug-in has been instantiated. They are stored in a cache file, so a selection menu can be built
+** by pluginName() and interfaceNames() without loading a library. findInterface() loads only the
+** plug-in which provided the requested interface the last time. If the interface is not found there,
+** all remaining plug-ins are instantiated. A library which has been loaded is never unloaded, a
+** modified file is picked up after the next start of the application.
+** <p>
+** The class is not thread-safe, it must only be used from the main thread of the application.
+*/
+class QCanPluginRegistry
+{
+public:
+
+   QCanPluginRegistry(const QCanPluginRegistry&) = delete;                 // no copy constructor
+   QCanPluginRegistry& operator=(const QCanPluginRegistry&) = delete;      // no assignment operator
+   QCanPluginRegistry(QCanPluginRegistry&&) = delete;                      // no move constructor
+   QCanPluginRegistry& operator=(QCanPluginRegistry&&) = delete;           // no move operator
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Reference to the registry
+   **
+   ** The function returns the registry of the application, the registry is created on the first call.
+   */
+   static QCanPluginRegistry &   instance(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clNameR        Name of CAN interface
+   ** \return     Pointer to CAN interface or \c nullptr
+   **
+   ** The function searches the CAN interface with the name \a clNameR and returns a pointer to it. Only
+   ** the plug-ins which are required for the search are instantiated. If the interface is not found,
+   ** the function returns \c nullptr.
+   */
+   QCanInterface *               findInterface(const QString & clNameR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  slPluginV      Index of plug-in
+   ** \return     Names of the CAN interfaces
+   **
+   ** The function returns the names of the CAN interfaces of the plug-in with the index \a slPluginV
+   ** from the cache. The plug-in is not instantiated by this function.
+   */
+   QStringList                   interfaceNames(const int32_t slPluginV) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if the names of all plug-ins are known
+   ** \see        refresh()
+   **
+   ** The function returns \c false if the plug-in directory contains a plug-in which has not been
+   ** instantiated yet and which is not part of the cache file.
+   */
+   bool                          isCacheComplete(void) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of plug-ins
+   */
+   inline int32_t                pluginCount(void) const    { return (atsEntryP.size()); }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  slPluginV      Index of plug-in
+   ** \return     Name of the plug-in
+   **
+   ** The function returns the name of the plug-in with the index \a slPluginV from the cache. The name
+   ** is empty if the plug-in has never been instantiated. The plug-in is not instantiated by this
+   ** function.
+   */
+   QString                       pluginName(const int32_t slPluginV) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Plug-in directory
+   ** \see        setPluginPath()
+   */
+   inline QDir                   pluginPath(void) const     { return (clPluginPathP);  }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of plug-ins
+   **
+   ** The function scans the plug-in directory again and instantiates the plug-ins which are not part
+   ** of the cache file, so their names are known afterwards. The cache file is updated.
+   */
+   int32_t                       refresh(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clPathR        Plug-in directory
+   ** \see        pluginPath()
+   **
+   ** The function sets the directory of the CAN interface plug-ins and scans it. The default directory
+   ** is the directory \c plugins next to the application binary (\c Plugins inside a macOS bundle).
+   */
+   void                          setPluginPath(const QDir & clPathR);
+
+private:
+
+   QCanPluginRegistry();
+
+   ~QCanPluginRegistry() = default;
+
+   //---------------------------------------------------------------------------------------------------
+   // an entry of the registry, the plug-in name and the interface lists are empty until the plug-in
+   // has been instantiated or read from the cache file
+   //
+   typedef struct PluginEntry_s {
+      QString           clFilePath;
+      int64_t           sqModified;
+      QString           clName;
+      QStringList       clInterfaceList;
+      QList<uint32_t>   clFeatureList;
+      QPluginLoader *   pclLoader;
+      QCanPlugin *      pclPlugin;
+      bool              btFailed;
+   } PluginEntry_ts;
+
+   QCanPlugin *         loadPlugin(PluginEntry_ts & tsEntryR);
+   void                 readCache(void);
+   void                 scanDirectory(void);
+   void                 writeCache(void);
+
+   static QCanPluginRegistry *   pclInstanceS;
+
+   QDir                          clPluginPathP;
+   QList<PluginEntry_ts>         atsEntryP;
+};
+
+#endif   // QCAN_PLUGIN_REGISTRY_HPP_
@@ -0,0 +1,317 @@
+//====================================================================================================================//
+// File:          qcan_route.cpp                                                                                      //
+// Description:   QCAN classes - Routing rule between CAN networks                                                    //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include "qcan_route.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------------------------------
+// Number of credits of the token bucket which are required to forward one CAN frame
+//
+constexpr uint64_t   ROUTE_CREDIT_FRAME   = 1000;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanRoute()                                                                                                        //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanRoute::QCanRoute()
+{
+   ulHandleP     = 0;
+   teSourceP     = QCan::eCAN_CHANNEL_NONE;
+   teTargetP     = QCan::eCAN_CHANNEL_NONE;
+
+   teFormatP     = eFORMAT_ANY;
+   ulIdLowP      = 0;
+   ulIdHighP     = QCAN_FRAME_ID_MASK_EXT;
+   ulIdMaskP     = 0;
+   ulIdCodeP     = 0;
+
+   ulTrnMaskP    = 0;
+   ulTrnValueP   = 0;
+
+   ulRateLimitP  = 0;
+   ulRateBurstP  = 1;
+   uqCreditP     = ROUTE_CREDIT_FRAME;
+   uqCreditTimeP = 0;
+
+   resetCounter();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanRoute::fromJson()                                                                                              //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanRoute::fromJson(const QJsonObject & clJsonR)
+{
+   //---------------------------------------------------------------------------------------------------
+   // the keys "handle", "source" and "target" are mandatory
+   //
+   if ( (clJsonR.contains("handle") == false) || (clJsonR.contains("source") == false) ||
+        (clJsonR.contains("target") == false) )
+   {
+      return (false);
+   }
+
+   setHandle(static_cast< uint32_t >(clJsonR.value("handle").toInt()));
+   setChannels(static_cast< QCan::CAN_Channel_e >(clJsonR.value("source").toInt()),
+               static_cast< QCan::CAN_Channel_e >(clJsonR.value("target").toInt()));
+
+   setIdentifierRange(static_cast< Format_e >(clJsonR.value("format").toInt(eFORMAT_ANY)),
+                      static_cast< uint32_t >(clJsonR.value("idLow").toInt(0)),
+                      static_cast< uint32_t >(clJsonR.value("idHigh").toInt(QCAN_FRAME_ID_MASK_EXT)));
+
+   setIdentifierMask(static_cast< uint32_t >(clJsonR.value("idMask").toInt(0)),
+                     static_cast< uint32_t >(clJsonR.value("idCode").toInt(0)));
+
+   setTranslation(static_cast< uint32_t >(clJsonR.value("translateMask").toInt(0)),
+                  static_cast< uint32_t >(clJsonR.value("translateValue").toInt(0)));
+
+   setRateLimit(static_cast< uint32_t >(clJsonR.value("rateLimit").toInt(0)),
+                static_cast< uint32_t >(clJsonR.value("rateBurst").toInt(1)));
+
+   //---------------------------------------------------------------------------------------------------
+   // the counters are only present if the object has been created by toJson()
+   //
+   ulForwardCountP = static_cast< uint32_t >(clJsonR.value("forwardCount").toInt(0));
+   ulDropCountP    = static_cast< uint32_t >(clJsonR.value("dropCount").toInt(0));
+
+   return (isValid());
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanRoute::isValid()                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanRoute::isValid(void) const
+{
+   bool  btResultT = false;
+
+   if ( (teSourceP > QCan::eCAN_CHANNEL_NONE) && (teSourceP <= QCAN_NETWORK_LIMIT) &&
+        (teTargetP > QCan::eCAN_CHANNEL_NONE) && (teTargetP <= QCAN_NETWORK_LIMIT) &&
+        (teSourceP != teTargetP) )
+   {
+      btResultT = true;
+   }
+
+   return (btResultT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanRoute::process()                                                                                               //
+// test, limit and translate CAN frame                                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanRoute::process(QCanFrame & clFrameR, const uint64_t uqTimeV)
+{
+   uint32_t ulIdentifierT;
+
+   //---------------------------------------------------------------------------------------------------
+   // only data frames are forwarded
+   //
+   if (clFrameR.frameType() != QCanFrame::eFRAME_TYPE_DATA)
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // test frame format and identifier
+   //
+   if ( ((teFormatP == eFORMAT_STD) && (clFrameR.isExtended() == true)) ||
+        ((teFormatP == eFORMAT_EXT) && (clFrameR.isExtended() == false)) )
+   {
+      return (false);
+   }
+
+   ulIdentifierT = clFrameR.identifier();
+   if ((ulIdentifierT < ulIdLowP) || (ulIdentifierT > ulIdHighP))
+   {
+      return (false);
+   }
+
+   if ((ulIdentifierT & ulIdMaskP) != (ulIdCodeP & ulIdMaskP))
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // Rate limit: the token bucket is refilled with ulRateLimitP credits per millisecond, so one CAN
+   // frame per second is equivalent to ROUTE_CREDIT_FRAME credits per second.
+   //
+   if (ulRateLimitP > 0)
+   {
+      uqCreditP = uqCreditP + ((uqTimeV - uqCreditTimeP) * ulRateLimitP);
+      if (uqCreditP > (ulRateBurstP * ROUTE_CREDIT_FRAME))
+      {
+         uqCreditP = ulRateBurstP * ROUTE_CREDIT_FRAME;
+      }
+      uqCreditTimeP = uqTimeV;
+
+      if (uqCreditP < ROUTE_CREDIT_FRAME)
+      {
+         ulDropCountP++;
+         return (false);
+      }
+      uqCreditP = uqCreditP - ROUTE_CREDIT_FRAME;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // translate identifier
+   //
+   if (ulTrnMaskP != 0)
+   {
+      clFrameR.setIdentifier((ulIdentifierT & ~ulTrnMaskP) | (ulTrnValueP & ulTrnMaskP));
+   }
+
+   ulForwardCountP++;
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanRoute::resetCounter()                                                                                          //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanRoute::resetCounter(void)
+{
+   ulForwardCountP = 0;
+   ulDropCountP    = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanRoute::setChannels()                                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanRoute::setChannels(const QCan::CAN_Channel_e teSourceV, const QCan::CAN_Channel_e teTargetV)
+{
+   teSourceP = teSourceV;
+   teTargetP = teTargetV;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanRoute::setIdentifierMask()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanRoute::setIdentifierMask(const uint32_t ulMaskV, const uint32_t ulCodeV)
+{
+   ulIdMaskP = ulMaskV & QCAN_FRAME_ID_MASK_EXT;
+   ulIdCodeP = ulCodeV & QCAN_FRAME_ID_MASK_EXT;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanRoute::setIdentifierRange()                                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanRoute::setIdentifierRange(const Format_e teFormatV, const uint32_t ulIdLowV, const uint32_t ulIdHighV)
+{
+   teFormatP = teFormatV;
+   ulIdLowP  = ulIdLowV;
+   ulIdHighP = ulIdHighV;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanRoute::setRateLimit()                                                                                          //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanRoute::setRateLimit(const uint32_t ulRateV, const uint32_t ulBurstV)
+{
+   ulRateLimitP  = ulRateV;
+   ulRateBurstP  = ulBurstV;
+   if (ulRateBurstP == 0)
+   {
+      ulRateBurstP = 1;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the token bucket is filled completely, the time base is set by the first call of process()
+   //
+   uqCreditP     = ulRateBurstP * ROUTE_CREDIT_FRAME;
+   uqCreditTimeP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanRoute::setTranslation()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanRoute::setTranslation(const uint32_t ulMaskV, const uint32_t ulValueV)
+{
+   ulTrnMaskP  = ulMaskV & QCAN_FRAME_ID_MASK_EXT;
+   ulTrnValueP = ulValueV & QCAN_FRAME_ID_MASK_EXT;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanRoute::toJson()                                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QJsonObject QCanRoute::toJson(void) const
+{
+   QJsonObject clJsonT;
+
+   clJsonT["handle"]          = static_cast< int32_t >(ulHandleP);
+   clJsonT["source"]          = static_cast< int32_t >(teSourceP);
+   clJsonT["target"]          = static_cast< int32_t >(teTargetP);
+   clJsonT["format"]          = static_cast< int32_t >(teFormatP);
+   clJsonT["idLow"]           = static_cast< int32_t >(ulIdLowP);
+   clJsonT["idHigh"]          = static_cast< int32_t >(ulIdHighP);
+   clJsonT["idMask"]          = static_cast< int32_t >(ulIdMaskP);
+   clJsonT["idCode"]          = static_cast< int32_t >(ulIdCodeP);
+   clJsonT["translateMask"]   = static_cast< int32_t >(ulTrnMaskP);
+   clJsonT["translateValue"]  = static_cast< int32_t >(ulTrnValueP);
+   clJsonT["rateLimit"]       = static_cast< int32_t >(ulRateLimitP);
+   clJsonT["rateBurst"]       = static_cast< int32_t >(ulRateBurstP);
+   clJsonT["forwardCount"]    = static_cast< int32_t >(ulForwardCountP);
+   clJsonT["dropCount"]       = static_cast< int32_t >(ulDropCountP);
+
+   return (clJsonT);
+}
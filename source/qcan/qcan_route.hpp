@@ -0,0 +1,276 @@
+//====================================================================================================================//
+// File:          qcan_route.hpp                                                                                      //
+// Description:   QCAN classes - Routing rule between CAN networks                                                    //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_ROUTE_HPP_
+#define QCAN_ROUTE_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QJsonObject>
+
+#include "qcan_frame.hpp"
+#include "qcan_namespace.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanRoute
+** \brief   Routing rule between two CAN networks
+**
+** The QCanRoute class defines which CAN frames of a source network are forwarded by the QCanServer to a
+** target network. A CAN frame is forwarded if
+** <ul>
+** <li>the frame format matches the configured format (standard, extended or both),
+** <li>the identifier is within the range set by setIdentifierRange() and
+** <li>the identifier matches the condition (identifier & mask) == code set by setIdentifierMask().
+** </ul>
+** The identifier of a forwarded CAN frame can be translated by setTranslation(), the number of
+** forwarded CAN frames can be limited by setRateLimit().
+** <p>
+** A route is identified by a handle value, the JSON representation of a route (see fromJson()) is
+** used by the settings WebSocket of the QCanServer.
+*/
+class QCanRoute
+{
+public:
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \enum    Format_e
+   **
+   ** This enumeration defines which frame formats are forwarded by a route.
+   */
+   enum Format_e {
+
+      /*! Standard and extended frames                      */
+      eFORMAT_ANY = 0,
+
+      /*! Standard frames only (11 bit identifier)          */
+      eFORMAT_STD,
+
+      /*! Extended frames only (29 bit identifier)          */
+      eFORMAT_EXT
+   };
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Constructs an invalid route which forwards all CAN data frames without modification.
+   */
+   QCanRoute();
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of CAN frames dropped by the rate limit
+   ** \see        setRateLimit()
+   */
+   inline uint32_t      dropCount(void) const      { return (ulDropCountP);                             }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of forwarded CAN frames
+   */
+   inline uint32_t      forwardCount(void) const   { return (ulForwardCountP);                          }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clJsonR        JSON object
+   ** \return     \c true if the JSON object describes a valid route
+   ** \see        toJson()
+   **
+   ** Configure the route from a JSON object which has the following format, all keys except
+   ** "handle", "source" and "target" are optional:
+   ** \code
+   ** {
+   **    "handle": 1,
+   **    "source": 1,
+   **    "target": 2,
+   **    "format": 0,
+   **    "idLow": 256,
+   **    "idHigh": 511,
+   **    "idMask": 0,
+   **    "idCode": 0,
+   **    "translateMask": 3840,
+   **    "translateValue": 1536,
+   **    "rateLimit": 100,
+   **    "rateBurst": 1
+   ** }
+   ** \endcode
+   ** The counter values "forwardCount" and "dropCount" written by toJson() are also evaluated.
+   */
+   bool                 fromJson(const QJsonObject & clJsonR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Handle of route
+   */
+   inline uint32_t      handle(void) const         { return (ulHandleP);                                }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if source and target channel are valid
+   */
+   bool                 isValid(void) const;
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in,out] clFrameR    CAN frame
+   ** \param[in]     uqTimeV     Actual time in milliseconds
+   ** \return        \c true if the CAN frame shall be forwarded
+   **
+   ** The function tests if the CAN frame \a clFrameR matches the route and if the rate limit permits
+   ** the forwarding. If both conditions are met, the identifier of \a clFrameR is translated and the
+   ** function returns \c true.
+   */
+   bool                 process(QCanFrame & clFrameR, const uint64_t uqTimeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Set the counters for forwarded and dropped CAN frames to 0.
+   */
+   void                 resetCounter(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  teSourceV      Source channel
+   ** \param[in]  teTargetV      Target channel
+   **
+   ** Define the source and target network of the route.
+   */
+   void                 setChannels(const QCan::CAN_Channel_e teSourceV, const QCan::CAN_Channel_e teTargetV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV      Handle of route
+   */
+   inline void          setHandle(const uint32_t ulHandleV)  { ulHandleP = ulHandleV;                   }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulMaskV        Identifier mask
+   ** \param[in]  ulCodeV        Identifier code
+   **
+   ** A CAN frame matches if the condition (identifier & \a ulMaskV) == (\a ulCodeV & \a ulMaskV) is
+   ** met. A mask value of 0 matches all identifiers.
+   */
+   void                 setIdentifierMask(const uint32_t ulMaskV, const uint32_t ulCodeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  teFormatV      Frame format
+   ** \param[in]  ulIdLowV       Lower bound of identifier range (inclusive)
+   ** \param[in]  ulIdHighV      Upper bound of identifier range (inclusive)
+   **
+   ** Define the frame format and the identifier range of the route.
+   */
+   void                 setIdentifierRange(const Format_e teFormatV, const uint32_t ulIdLowV,
+                                           const uint32_t ulIdHighV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulRateV        Maximum number of CAN frames per second, 0 disables the limit
+   ** \param[in]  ulBurstV       Number of CAN frames which may be forwarded without delay
+   **
+   ** Limit the number of forwarded CAN frames. Frames above the limit are dropped and counted,
+   ** see dropCount().
+   */
+   void                 setRateLimit(const uint32_t ulRateV, const uint32_t ulBurstV = 1);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulMaskV        Mask of identifier bits which are replaced
+   ** \param[in]  ulValueV       Value of replaced identifier bits
+   **
+   ** The identifier of a forwarded CAN frame is calculated by
+   ** (identifier & ~\a ulMaskV) | (\a ulValueV & \a ulMaskV). A mask value of 0 forwards the CAN
+   ** frame with the original identifier.
+   */
+   void                 setTranslation(const uint32_t ulMaskV, const uint32_t ulValueV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Source channel
+   */
+   inline QCan::CAN_Channel_e sourceChannel(void) const    { return (teSourceP);                        }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Target channel
+   */
+   inline QCan::CAN_Channel_e targetChannel(void) const    { return (teTargetP);                        }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     JSON object
+   ** \see        fromJson()
+   **
+   ** The function returns the configuration of the route as JSON object, the object also contains
+   ** the values of forwardCount() ("forwardCount") and dropCount() ("dropCount").
+   */
+   QJsonObject          toJson(void) const;
+
+private:
+
+   uint32_t             ulHandleP;
+   QCan::CAN_Channel_e  teSourceP;
+   QCan::CAN_Channel_e  teTargetP;
+
+   Format_e             teFormatP;
+   uint32_t             ulIdLowP;
+   uint32_t             ulIdHighP;
+   uint32_t             ulIdMaskP;
+   uint32_t             ulIdCodeP;
+
+   uint32_t             ulTrnMaskP;
+   uint32_t             ulTrnValueP;
+
+   //---------------------------------------------------------------------------------------------------
+   // token bucket for the rate limit, one CAN frame is equivalent to 1000 credits
+   //
+   uint32_t             ulRateLimitP;
+   uint32_t             ulRateBurstP;
+   uint64_t             uqCreditP;
+   uint64_t             uqCreditTimeP;
+
+   uint32_t             ulForwardCountP;
+   uint32_t             ulDropCountP;
+};
+
+#endif   // QCAN_ROUTE_HPP_
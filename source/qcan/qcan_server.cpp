@@ -36,8 +36,11 @@
 #include <QtCore/QDebug>
 
 #include "qcan_server.hpp"
+#include "qcan_server_memory.hpp"
 
+#include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QThread>
 
 
 /*--------------------------------------------------------------------------------------------------------------------*\
@@ -45,8 +48,6 @@
 **                                                                                                                    **
 \*--------------------------------------------------------------------------------------------------------------------*/
 
-#define           QCAN_MEMORY_KEY                  "QCAN_SERVER_SHARED_KEY"
-
 constexpr int64_t MAXIMUM_SERVER_TIME_DIFFERENCE   = 2000;
 
 //------------------------------------------------------------------------------------------------------
@@ -66,51 +67,12 @@ constexpr int64_t MAXIMUM_SERVER_TIME_DIFFERENCE   = 2000;
 #endif
 
 
-/*--------------------------------------------------------------------------------------------------------------------*\
-** Structures                                                                                                         **
-**                                                                                                                    **
-\*--------------------------------------------------------------------------------------------------------------------*/
-
-
-//-----------------------------------------------------------------------------------------------------
-// Server signature inside shared memory
-//
-typedef struct CanServerSharedMemory_s {
-
-   //--------------------------------------------------------------------------
-   // Server version: major
-   //
-   int32_t  slVersionMajor;
+static_assert(QCAN_MEMORY_LATENCY_PATH_MAX == QCanNetwork::eLATENCY_PATH_MAX,
+              "QCAN_MEMORY_LATENCY_PATH_MAX does not match QCanNetwork::eLATENCY_PATH_MAX");
 
-   //--------------------------------------------------------------------------
-   // Server version: minor
-   //
-   int32_t  slVersionMinor;
-
-   //--------------------------------------------------------------------------
-   // Server version: build
-   //
-   int32_t  slVersionBuild;
-
-   //--------------------------------------------------------------------------
-   // Number of CAN networks supported by the server
-   //
-   int32_t  slNetworkCount;
-
-   //--------------------------------------------------------------------------
-   // Stores the start date / time of the server in milliseconds that have
-   // passed since 1970-01-01T00:00:00.000
-   //
-   int64_t  sqDateTimeStart;
-
-   //--------------------------------------------------------------------------
-   // Stores the actual date / time of the server in milliseconds that have
-   // passed since 1970-01-01T00:00:00.000
-   //
-   int64_t  sqDateTimeActual;
-
-
-} CanServerSharedMemory_ts;
+static_assert((QCAN_LOCAL_SOCKET_MAX <= QCAN_SOCKET_LIMIT_MAX) && (QCAN_WEB_SOCKET_MAX <= QCAN_SOCKET_LIMIT_MAX) &&
+              (QCAN_TCP_SOCKET_MAX <= QCAN_SOCKET_LIMIT_MAX),
+              "QCAN_SOCKET_LIMIT_MAX is lower than the default number of sockets");
 
 
 /*--------------------------------------------------------------------------------------------------------------------*\
@@ -132,11 +94,12 @@ QCanServer::QCanServer( QObject * pclParentV, uint16_t uwPortNumberV, uint8_t ub
    this->setParent(pclParentV);
 
    //---------------------------------------------------------------------------------------------------
-   // limit the number of possible networks to QCAN_NETWORK_MAX
+   // the number of possible networks is limited to QCAN_NETWORK_LIMIT by the
+   // data type, a server has at least one network
    //
-   if (ubNetworkNumV > QCAN_NETWORK_MAX)
+   if (ubNetworkNumV == 0)
    {
-      ubNetworkNumV = QCAN_NETWORK_MAX;
+      ubNetworkNumV = 1;
    }
 
    //---------------------------------------------------------------------------------------------------
@@ -156,6 +119,13 @@ QCanServer::QCanServer( QObject * pclParentV, uint16_t uwPortNumberV, uint8_t ub
    //
    pclServerConfigurationP = nullptr;
    pclTimerP               = nullptr;
+   pclStatisticTimerP      = nullptr;
+   pclMetricsServerP       = nullptr;
+
+   //---------------------------------------------------------------------------------------------------
+   // the raw TCP server is created by setTcpPort(), TCP_NODELAY is enabled by default
+   //
+   btTcpNoDelayP           = true;
    
    //---------------------------------------------------------------------------------------------------
    // store the supplied parameters of the constructor 
@@ -217,6 +187,18 @@ QCanServer::QCanServer( QObject * pclParentV, uint16_t uwPortNumberV, uint8_t ub
       pclTimerP = new QTimer();
       connect(pclTimerP, &QTimer::timeout, this, &QCanServer::onTimerEvent);
       pclTimerP->start(1000);
+
+      //-------------------------------------------------------------------------------------------
+      // start timer that publishes the network statistic inside the shared memory
+      //
+      pclStatisticTimerP = new QTimer();
+      connect(pclStatisticTimerP, &QTimer::timeout, this, &QCanServer::onStatisticTimerEvent);
+      pclStatisticTimerP->start(QCAN_MEMORY_STATISTIC_PERIOD);
+
+      //-------------------------------------------------------------------------------------------
+      // the OpenMetrics endpoint is disabled until setMetricsPort() is called
+      //
+      pclMetricsServerP = new QCanMetricsServer();
    }
 }
 
@@ -240,6 +222,11 @@ QCanServer::~QCanServer()
    }
    
 
+   //---------------------------------------------------------------------------------------------------
+   // close bridge links before the networks are removed
+   //
+   clearBridges();
+
    //---------------------------------------------------------------------------------------------------
    // remove all networks
    //
@@ -249,6 +236,15 @@ QCanServer::~QCanServer()
    }
    clNetworkListP.clear();
 
+   //---------------------------------------------------------------------------------------------------
+   // close raw TCP server, the accepted sockets are deleted together with the server
+   //
+   if (pclTcpServerP != nullptr)
+   {
+      pclTcpServerP->close();
+      delete (pclTcpServerP);
+   }
+
    //---------------------------------------------------------------------------------------------------
    // stop timer
    //
@@ -258,6 +254,20 @@ QCanServer::~QCanServer()
       delete (pclTimerP);
    }
 
+   if (pclStatisticTimerP != nullptr)
+   {
+      pclStatisticTimerP->stop();
+      delete (pclStatisticTimerP);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // stop OpenMetrics endpoint
+   //
+   if (pclMetricsServerP != nullptr)
+   {
+      delete (pclMetricsServerP);
+   }
+
    //---------------------------------------------------------------------------------------------------
    // Detaches the process from the shared memory segment
    //
@@ -280,7 +290,8 @@ void QCanServer::checkServerSettings(bool btClearServerV)
    // Check if the shared memory could be attached, if not test the flag btClearServerV and try to
    // attach it again.
    //
-   if (pclServerConfigurationP->create(sizeof(CanServerSharedMemory_ts), QSharedMemory::ReadWrite) == false)
+   const int slMemorySizeT = static_cast< int >(QCanServerMemory::size(ubNetworkMaxP));
+   if (pclServerConfigurationP->create(slMemorySizeT, QSharedMemory::ReadWrite) == false)
    {
       if (pclServerConfigurationP->error() == QSharedMemory::AlreadyExists)
       {
@@ -306,9 +317,9 @@ void QCanServer::checkServerSettings(bool btClearServerV)
       if (pclServerConfigurationP->lock() == true)
       {
          //-----------------------------------------------------------------------------------
-         // clear all memory initially
+         // clear all memory initially, the shared memory of a crashed server may be smaller
          //
-         memset(pclServerConfigurationP->data(), 0, sizeof(CanServerSharedMemory_ts));
+         memset(pclServerConfigurationP->data(), 0, static_cast< size_t >(pclServerConfigurationP->size()));
 
          //-----------------------------------------------------------------------------------
          // setup the shared memory
@@ -320,6 +331,13 @@ void QCanServer::checkServerSettings(bool btClearServerV)
          ptsConfigurationT->slVersionBuild = VERSION_BUILD;
          ptsConfigurationT->slNetworkCount = ubNetworkMaxP;
 
+         //-----------------------------------------------------------------------------------
+         // the statistic of all networks is published, unless the shared memory of a crashed
+         // server has been attached which is too small
+         //
+         ptsConfigurationT->slStatisticCount = qMin(static_cast< int32_t >(ubNetworkMaxP),
+                                                    QCanServerMemory::statisticCount(pclServerConfigurationP->size()));
+
          sqDateTimeStartP = QDateTime::currentMSecsSinceEpoch();
          ptsConfigurationT->sqDateTimeStart  = sqDateTimeStartP;
          ptsConfigurationT->sqDateTimeActual = sqDateTimeStartP;
@@ -375,6 +393,138 @@ void QCanServer::allowModeChange(bool btEnabledV)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::addBridge()                                                                                            //
+// add bridge link to remote server                                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanServer::addBridge(QCanBridge * pclBridgeV)
+{
+   QCanNetwork * pclNetworkT;
+
+   if ((pclBridgeV == nullptr) || (pclBridgeV->isValid() == false))
+   {
+      return (false);
+   }
+
+   pclNetworkT = network(static_cast< uint8_t >(pclBridgeV->localChannel() - 1));
+   if (pclNetworkT == nullptr)
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the handle is unique for all networks
+   //
+   removeBridge(pclBridgeV->handle());
+
+   pclBridgeV->setParent(this);
+   clBridgeListP.append(pclBridgeV);
+   pclNetworkT->addBridge(pclBridgeV);
+   pclBridgeV->start();
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::addRoute()                                                                                             //
+// add routing rule between two networks                                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanServer::addRoute(const QCanRoute & clRouteR)
+{
+   QCanNetwork * pclSourceT;
+   QCanNetwork * pclTargetT;
+
+   if (clRouteR.isValid() == false)
+   {
+      return (false);
+   }
+
+   pclSourceT = network(static_cast< uint8_t >(clRouteR.sourceChannel() - 1));
+   pclTargetT = network(static_cast< uint8_t >(clRouteR.targetChannel() - 1));
+   if ((pclSourceT == nullptr) || (pclTargetT == nullptr))
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the handle is unique for all networks, the source network of the route may have changed
+   //
+   removeRoute(clRouteR.handle());
+
+   return (pclSourceT->addRoute(clRouteR, pclTargetT));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::attachMuxSocket()                                                                                      //
+// attach multiplexed raw TCP connection to CAN networks                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServer::attachMuxSocket(QTcpSocket * pclSocketV, const QList<QByteArray> & clChannelListR)
+{
+   QCanMuxSocket *   pclMuxSocketT;
+   QByteArray        clReplyT = "OK";
+   int32_t           slNetNumberT;
+   bool              btValidT;
+
+   //---------------------------------------------------------------------------------------------------
+   // the multiplexed connection takes over the socket
+   //
+   clTcpPendingListP.removeOne(pclSocketV);
+   pclSocketV->disconnect(this);
+   pclMuxSocketT = new QCanMuxSocket(pclSocketV, this);
+
+   for (int32_t slNetIdxT = 0; slNetIdxT < clNetworkListP.size(); slNetIdxT++)
+   {
+      slNetNumberT = slNetIdxT + 1;
+      btValidT = clChannelListR.contains("*") || clChannelListR.contains(QByteArray::number(slNetNumberT));
+      if (btValidT && pclMuxSocketT->addNetwork(clNetworkListP.at(slNetIdxT)))
+      {
+         clReplyT += " " + QByteArray::number(slNetNumberT);
+      }
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the connection is rejected if no network could be attached, the QCanMuxSocket object deletes
+   // itself after the socket has been closed
+   //
+   if (clReplyT.size() == 2)
+   {
+      pclSocketV->write("ERR unknown channel\n");
+      pclSocketV->disconnectFromHost();
+      return;
+   }
+
+   pclSocketV->write(clReplyT + "\n");
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::clearBridges()                                                                                         //
+// remove all bridge links                                                                                            //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServer::clearBridges(void)
+{
+   while (clBridgeListP.isEmpty() == false)
+   {
+      removeBridge(clBridgeListP.first()->handle());
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::clearRoutes()                                                                                          //
+// remove all routing rules                                                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServer::clearRoutes(void)
+{
+   for (int32_t slNetIdxT = 0; slNetIdxT < clNetworkListP.size(); slNetIdxT++)
+   {
+      clNetworkListP.at(slNetIdxT)->clearRoutes();
+   }
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanServer::maximumNetwork()                                                                                       //
 //                                                                                                                    //
@@ -385,6 +535,21 @@ uint8_t QCanServer::maximumNetwork(void) const
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::metricsPort()                                                                                          //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint16_t QCanServer::metricsPort(void) const
+{
+   if (pclMetricsServerP != nullptr)
+   {
+      return (pclMetricsServerP->port());
+   }
+
+   return (0);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanServer::network()                                                                                              //
 //                                                                                                                    //
@@ -402,6 +567,101 @@ QCanNetwork * QCanServer::network(uint8_t ubNetworkIdxV)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::onStatisticTimerEvent()                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServer::onStatisticTimerEvent(void)
+{
+   CanServerNetworkStatistic_ts     tsStatisticT;
+   QCanNetwork::SocketStatistic_ts  atsSocketT[QCAN_MEMORY_SOCKET_MAX];
+
+   if (teErrorP != QCanServer::eERROR_NONE)
+   {
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the statistic is protected by a sequence lock, so the lock of the shared memory is not taken
+   //
+   CanServerSharedMemory_ts * ptsConfigurationT = static_cast< CanServerSharedMemory_ts * >(pclServerConfigurationP->data());
+   if (ptsConfigurationT == nullptr)
+   {
+      return;
+   }
+
+   for (int32_t slNetIdxT = 0; slNetIdxT < clNetworkListP.size(); slNetIdxT++)
+   {
+      QCanNetwork * pclNetworkT = clNetworkListP.at(slNetIdxT);
+
+      memset(&tsStatisticT, 0, sizeof(CanServerNetworkStatistic_ts));
+
+      tsStatisticT.ulFrameCount         = pclNetworkT->frameCount();
+      tsStatisticT.ulErrorCount         = pclNetworkT->frameCountError();
+      tsStatisticT.ulFramesPerSecond    = pclNetworkT->framesPerSecond();
+      tsStatisticT.ubBusLoad            = pclNetworkT->busLoad();
+      tsStatisticT.ulTransmitQueueDepth = pclNetworkT->transmitQueueCount();
+      tsStatisticT.ulTransmitDropCount  = pclNetworkT->transmitDropCount();
+
+      //-------------------------------------------------------------------------------------------
+      // latency summary per path
+      //
+      for (int32_t slPathT = 0; slPathT < QCanNetwork::eLATENCY_PATH_MAX; slPathT++)
+      {
+         const QCanNetwork::LatencyPath_e teLatencyPathT = static_cast< QCanNetwork::LatencyPath_e >(slPathT);
+         const QCanLatencyHistogram & clDispatchR = pclNetworkT->dispatchLatency(teLatencyPathT);
+         const QCanLatencyHistogram & clEgressR   = pclNetworkT->egressLatency(teLatencyPathT);
+         CanServerLatency_ts & tsDispatchR = tsStatisticT.atsLatencyDispatch[slPathT];
+         CanServerLatency_ts & tsEgressR   = tsStatisticT.atsLatencyEgress[slPathT];
+
+         tsDispatchR.uqCount = clDispatchR.count();
+         tsDispatchR.uqP50   = clDispatchR.percentile(50);
+         tsDispatchR.uqP99   = clDispatchR.percentile(99);
+         tsDispatchR.uqMax   = clDispatchR.maximum();
+
+         tsEgressR.uqCount   = clEgressR.count();
+         tsEgressR.uqP50     = clEgressR.percentile(50);
+         tsEgressR.uqP99     = clEgressR.percentile(99);
+         tsEgressR.uqMax     = clEgressR.maximum();
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // statistic of the connected sockets
+      //
+      tsStatisticT.ulSocketCount = pclNetworkT->socketStatistic(atsSocketT, QCAN_MEMORY_SOCKET_MAX);
+      for (uint32_t ulSockIdxT = 0; ulSockIdxT < tsStatisticT.ulSocketCount; ulSockIdxT++)
+      {
+         tsStatisticT.atsSocket[ulSockIdxT].ulDropCount  = atsSocketT[ulSockIdxT].ulDropCount;
+         tsStatisticT.atsSocket[ulSockIdxT].ulQueueDepth = atsSocketT[ulSockIdxT].ulQueueDepth;
+         switch (atsSocketT[ulSockIdxT].teTransport)
+         {
+            case QCanNetwork::eSOCKET_TRANSPORT_LOCAL:
+               tsStatisticT.atsSocket[ulSockIdxT].ubType = QCAN_MEMORY_SOCKET_LOCAL;
+               break;
+
+            case QCanNetwork::eSOCKET_TRANSPORT_TCP:
+               tsStatisticT.atsSocket[ulSockIdxT].ubType = QCAN_MEMORY_SOCKET_TCP;
+               break;
+
+            default:
+               tsStatisticT.atsSocket[ulSockIdxT].ubType = QCAN_MEMORY_SOCKET_WEB;
+               break;
+         }
+      }
+
+      QCanServerMemory::writeStatistic(ptsConfigurationT, slNetIdxT, tsStatisticT);
+
+      //-------------------------------------------------------------------------------------------
+      // the OpenMetrics endpoint renders a copy of the statistic on request
+      //
+      if ((pclMetricsServerP != nullptr) && (pclMetricsServerP->isActive()))
+      {
+         pclMetricsServerP->setStatistic(slNetIdxT, tsStatisticT);
+      }
+   }
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanServer::onTimerEvent()                                                                                         //
 //                                                                                                                    //
@@ -470,6 +730,133 @@ void QCanServer::onSocketDisconnect(void)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::onTcpServerConnect()                                                                                   //
+// new raw TCP connection                                                                                             //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServer::onTcpServerConnect(void)
+{
+   QTcpSocket * pclSocketT;
+
+   //---------------------------------------------------------------------------------------------------
+   // The connection is kept in the pending list until the handshake line has been received, the
+   // socket is passed to the network afterwards.
+   //
+   while (pclTcpServerP->hasPendingConnections())
+   {
+      pclSocketT = pclTcpServerP->nextPendingConnection();
+
+      #ifndef QT_NO_DEBUG_OUTPUT
+      qDebug() << "QCanServer::onTcpServerConnect() -" << pclSocketT->peerAddress();
+      #endif
+
+      pclSocketT->setSocketOption(QAbstractSocket::LowDelayOption, btTcpNoDelayP ? 1 : 0);
+      clTcpPendingListP.append(pclSocketT);
+
+      connect( pclSocketT, &QTcpSocket::readyRead,
+               this,       &QCanServer::onTcpSocketHandshake);
+
+      connect( pclSocketT, &QTcpSocket::disconnected,
+               this,       &QCanServer::onTcpSocketDisconnect);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::onTcpSocketDisconnect()                                                                                //
+// raw TCP socket closed before the handshake was completed                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServer::onTcpSocketDisconnect(void)
+{
+   QTcpSocket * pclSocketT = qobject_cast<QTcpSocket *>(sender());
+
+   if (clTcpPendingListP.removeOne(pclSocketT))
+   {
+      pclSocketT->disconnect();
+      pclSocketT->deleteLater();
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::onTcpSocketHandshake()                                                                                 //
+// evaluate handshake line of raw TCP socket                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServer::onTcpSocketHandshake(void)
+{
+   QTcpSocket *         pclSocketT = qobject_cast<QTcpSocket *>(sender());
+   QCanNetwork *        pclNetworkT = nullptr;
+   QByteArray           clLineT;
+   QList<QByteArray>    clTokenListT;
+   QByteArray           clBridgeIdT;
+   int32_t              slNetNumberT = 0;
+   bool                 btValidT = false;
+
+   //---------------------------------------------------------------------------------------------------
+   // wait for a complete line, a client sending more data without line feed is rejected
+   //
+   if (pclSocketT->canReadLine() == false)
+   {
+      if (pclSocketT->bytesAvailable() >= QCAN_TCP_HANDSHAKE_SIZE)
+      {
+         rejectTcpSocket(pclSocketT, "invalid handshake");
+      }
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // The handshake line is "CAN <channel>", the first channel has the value 1. A bridge link of a
+   // remote server appends "BRIDGE <link-id>" (see QCanBridge). A multiplexed connection sends
+   // "MUX <channel> <channel> ..." or "MUX *" instead. Data following the line feed remains inside
+   // the socket and is read by the network.
+   //
+   clLineT = pclSocketT->readLine(QCAN_TCP_HANDSHAKE_SIZE).trimmed();
+   clTokenListT = clLineT.simplified().split(' ');
+   if (clTokenListT.first() == "MUX")
+   {
+      attachMuxSocket(pclSocketT, clTokenListT.mid(1));
+      return;
+   }
+
+   if ((clTokenListT.size() == 4) && (clTokenListT.at(2) == "BRIDGE"))
+   {
+      clBridgeIdT = clTokenListT.at(3);
+   }
+
+   if ((clTokenListT.first() == "CAN") && ((clTokenListT.size() == 2) || (clBridgeIdT.isEmpty() == false)))
+   {
+      slNetNumberT = clTokenListT.at(1).toInt(&btValidT);
+      if (btValidT && (slNetNumberT > 0) && (slNetNumberT <= clNetworkListP.size()))
+      {
+         pclNetworkT = network(static_cast< uint8_t >(slNetNumberT - 1));
+      }
+   }
+
+   if (pclNetworkT == nullptr)
+   {
+      rejectTcpSocket(pclSocketT, "unknown channel");
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the network takes over the socket
+   //
+   clTcpPendingListP.removeOne(pclSocketT);
+   pclSocketT->disconnect(this);
+
+   if (pclNetworkT->attachTcpSocket(pclSocketT, clBridgeIdT) == false)
+   {
+      clTcpPendingListP.append(pclSocketT);
+      connect( pclSocketT, &QTcpSocket::disconnected,
+               this,       &QCanServer::onTcpSocketDisconnect);
+      rejectTcpSocket(pclSocketT, "too many sockets");
+      return;
+   }
+
+   pclSocketT->write("OK " + QByteArray::number(slNetNumberT) + "\n");
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanServer::onWebSocketConnect()                                                                                   //
 // slot that manages a new local server connection                                                                    //
@@ -515,6 +902,9 @@ void QCanServer::onWebSocketServerConnect(void)
          connect( pclSocketT, &QWebSocket::disconnected,
                   this,       &QCanServer::onSocketDisconnect);
 
+         connect( pclSocketT, &QWebSocket::textMessageReceived,
+                  this,       &QCanServer::onWebSocketTextData);
+
          sendServerSettings(pclSocketT);
 
       }
@@ -541,8 +931,10 @@ void QCanServer::onWebSocketServerConnect(void)
             {
                if (pclNetworkT != nullptr)
                {
-                  pclNetworkT->attachWebSocket(pclSocketT, QCanNetwork::eSOCKET_TYPE_CAN_FRAME);
-                  btCloseSocketT = false;
+                  if (pclNetworkT->attachWebSocket(pclSocketT, QCanNetwork::eSOCKET_TYPE_CAN_FRAME))
+                  {
+                     btCloseSocketT = false;
+                  }
                }
             }
          }
@@ -592,6 +984,175 @@ void QCanServer::onWebSocketServerError(QWebSocketProtocol::CloseCode teCloseCod
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::onWebSocketTextData()                                                                                  //
+// handle settings message (JSON)                                                                                     //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServer::onWebSocketTextData(const QString & clMessageR)
+{
+   QWebSocket * pclSocketT = qobject_cast<QWebSocket *>(sender());
+
+   //---------------------------------------------------------------------------------------------------
+   // debug information
+   //
+   #ifndef QT_NO_DEBUG_OUTPUT
+   qDebug() << "QCanServer::onWebSocketTextData()" << clMessageR;
+   #endif
+
+   QJsonParseError clJsonErrorT;
+   QJsonDocument clJsonDocumentT = QJsonDocument::fromJson(clMessageR.toUtf8(), &clJsonErrorT);
+   if ( (clJsonErrorT.error != QJsonParseError::NoError) || (clJsonDocumentT.isObject() == false))
+   {
+      return;
+   }
+
+   QJsonObject clJsonObjectT = clJsonDocumentT.object();
+
+   //---------------------------------------------------------------------------------------------------
+   // Check for "routeClear" inside JSON object, this is evaluated before new routes are added
+   //
+   if (clJsonObjectT.value("routeClear").toBool())
+   {
+      clearRoutes();
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // Check for "routeRemove" inside JSON object: array of handles
+   //
+   if (clJsonObjectT.contains("routeRemove"))
+   {
+      QJsonArray clJsonArrayT = clJsonObjectT.value("routeRemove").toArray();
+
+      for (int32_t slIndexT = 0; slIndexT < clJsonArrayT.size(); slIndexT++)
+      {
+         removeRoute(static_cast< uint32_t >(clJsonArrayT.at(slIndexT).toInt()));
+      }
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // Check for "routeAdd" inside JSON object: array of routes, see QCanRoute::fromJson()
+   //
+   if (clJsonObjectT.contains("routeAdd"))
+   {
+      QJsonArray clJsonArrayT = clJsonObjectT.value("routeAdd").toArray();
+      QCanRoute  clRouteT;
+
+      for (int32_t slIndexT = 0; slIndexT < clJsonArrayT.size(); slIndexT++)
+      {
+         if (clRouteT.fromJson(clJsonArrayT.at(slIndexT).toObject()))
+         {
+            addRoute(clRouteT);
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // Check for "bridgeClear", "bridgeRemove" and "bridgeAdd" inside JSON object, the bridge links
+   // are evaluated in the same order as the routes (see QCanBridge::fromJson())
+   //
+   if (clJsonObjectT.value("bridgeClear").toBool())
+   {
+      clearBridges();
+   }
+
+   if (clJsonObjectT.contains("bridgeRemove"))
+   {
+      QJsonArray clJsonArrayT = clJsonObjectT.value("bridgeRemove").toArray();
+
+      for (int32_t slIndexT = 0; slIndexT < clJsonArrayT.size(); slIndexT++)
+      {
+         removeBridge(static_cast< uint32_t >(clJsonArrayT.at(slIndexT).toInt()));
+      }
+   }
+
+   if (clJsonObjectT.contains("bridgeAdd"))
+   {
+      QJsonArray clJsonArrayT = clJsonObjectT.value("bridgeAdd").toArray();
+
+      for (int32_t slIndexT = 0; slIndexT < clJsonArrayT.size(); slIndexT++)
+      {
+         QCanBridge * pclBridgeT = new QCanBridge();
+         if ((pclBridgeT->fromJson(clJsonArrayT.at(slIndexT).toObject()) == false) ||
+             (addBridge(pclBridgeT) == false))
+         {
+            delete (pclBridgeT);
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the client receives the updated settings as acknowledge
+   //
+   sendServerSettings(pclSocketT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::rejectTcpSocket()                                                                                      //
+// close raw TCP socket after failed handshake                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServer::rejectTcpSocket(QTcpSocket * pclSocketV, const QByteArray & clReasonR)
+{
+   #ifndef QT_NO_DEBUG_OUTPUT
+   qDebug() << "QCanServer::rejectTcpSocket() -" << clReasonR;
+   #endif
+
+   //---------------------------------------------------------------------------------------------------
+   // the socket is deleted by onTcpSocketDisconnect() when the connection has been closed
+   //
+   disconnect(pclSocketV, &QTcpSocket::readyRead, this, &QCanServer::onTcpSocketHandshake);
+   pclSocketV->write("ERR " + clReasonR + "\n");
+   pclSocketV->disconnectFromHost();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::removeBridge()                                                                                         //
+// remove bridge link to remote server                                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanServer::removeBridge(const uint32_t ulHandleV)
+{
+   QCanBridge *   pclBridgeT;
+
+   for (int32_t slBridgeIdxT = 0; slBridgeIdxT < clBridgeListP.size(); slBridgeIdxT++)
+   {
+      pclBridgeT = clBridgeListP.at(slBridgeIdxT);
+      if (pclBridgeT->handle() == ulHandleV)
+      {
+         for (int32_t slNetIdxT = 0; slNetIdxT < clNetworkListP.size(); slNetIdxT++)
+         {
+            clNetworkListP.at(slNetIdxT)->removeBridge(pclBridgeT);
+         }
+         clBridgeListP.remove(slBridgeIdxT);
+         delete (pclBridgeT);
+         return (true);
+      }
+   }
+
+   return (false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::removeRoute()                                                                                          //
+// remove routing rule                                                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanServer::removeRoute(const uint32_t ulHandleV)
+{
+   bool  btResultT = false;
+
+   for (int32_t slNetIdxT = 0; slNetIdxT < clNetworkListP.size(); slNetIdxT++)
+   {
+      if (clNetworkListP.at(slNetIdxT)->removeRoute(ulHandleV))
+      {
+         btResultT = true;
+      }
+   }
+
+   return (btResultT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanServer::sendServerSettings()                                                                                   //
 // send information about server via WebSocket                                                                        //
@@ -614,7 +1175,32 @@ void QCanServer::sendServerSettings(QWebSocket * pclSocketV, uint32_t flags)
    clJsonServerP["allowModeChange"]     = btAllowCanModeChangeP;
    clJsonServerP["allowBusOffRecovery"] = btAllowBusOffRecoverP;
 
+   //---------------------------------------------------------------------------------------------------
+   // bridge links to remote servers with their counters
+   //
+   QJsonArray clJsonBridgeListT;
+   for (int32_t slBridgeIdxT = 0; slBridgeIdxT < clBridgeListP.size(); slBridgeIdxT++)
+   {
+      clJsonBridgeListT.append(clBridgeListP.at(slBridgeIdxT)->toJson());
+   }
+   clJsonServerP["bridges"]             = clJsonBridgeListT;
+
    clJsonServerP["networkCount"]        = static_cast< int32_t >(ubNetworkMaxP);
+
+   //---------------------------------------------------------------------------------------------------
+   // routing rules of all networks
+   //
+   QJsonArray clJsonRouteListT;
+   for (int32_t slNetIdxT = 0; slNetIdxT < clNetworkListP.size(); slNetIdxT++)
+   {
+      QVector<QCanRoute> clRouteListT = clNetworkListP.at(slNetIdxT)->routes();
+      for (int32_t slRouteIdxT = 0; slRouteIdxT < clRouteListT.size(); slRouteIdxT++)
+      {
+         clJsonRouteListT.append(clRouteListT.at(slRouteIdxT).toJson());
+      }
+   }
+   clJsonServerP["routes"]              = clJsonRouteListT;
+
    clJsonServerP["serverLocalTime"]     = QDateTime::currentDateTime().toString(Qt::ISODate);
 
    #if QT_VERSION > QT_VERSION_CHECK(6, 4, 0)
@@ -640,6 +1226,75 @@ void QCanServer::sendServerSettings(QWebSocket * pclSocketV, uint32_t flags)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::setDispatchScheduling()                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanServer::setDispatchScheduling(const QCanThreadScheduling & clSchedulingR)
+{
+   bool  btResultT = true;
+
+   //---------------------------------------------------------------------------------------------------
+   // the scheduling is applied to the calling thread, which must be the thread of the server
+   //
+   if (QThread::currentThread() != thread())
+   {
+      qWarning() << "QCanServer::setDispatchScheduling() WARNING: not called from the dispatch thread";
+      return (false);
+   }
+
+   clDispatchSchedulingP = clSchedulingR;
+
+   //---------------------------------------------------------------------------------------------------
+   // with Qt GUI support the server runs in the GUI thread, a real-time policy would also apply to
+   // the user interface, so the thread keeps the default policy
+   //
+   #ifndef QCAN_NO_QT_GUI
+   if (clDispatchSchedulingP.policy() != QCanThreadScheduling::ePOLICY_OTHER)
+   {
+      qWarning() << "QCanServer::setDispatchScheduling() WARNING: real-time policy refused for the GUI thread";
+      clDispatchSchedulingP.setPolicy(QCanThreadScheduling::ePOLICY_OTHER);
+      btResultT = false;
+   }
+   #endif
+
+   if (clDispatchSchedulingP.apply() == false)
+   {
+      btResultT = false;
+   }
+
+   return (btResultT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::setMetricsPort()                                                                                       //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanServer::setMetricsPort(const uint16_t uwPortV)
+{
+   if (pclMetricsServerP == nullptr)
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // debug information
+   //
+   #ifndef QT_NO_DEBUG_OUTPUT
+   qDebug() << "QCanServer::setMetricsPort(" << uwPortV << ")";
+   #endif
+
+   if (uwPortV == 0)
+   {
+      pclMetricsServerP->stop();
+      return (true);
+   }
+
+   return (pclMetricsServerP->start(clServerAddressP, uwPortV));
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanServer::setServerAddress()                                                                                     //
 //                                                                                                                    //
@@ -665,4 +1320,78 @@ void QCanServer::setServerAddress(const QHostAddress clHostAddressV, const uint1
          pclWebSocketServerP->listen(clServerAddressP, uwServerPortP);
       }
    }
+
+   //---------------------------------------------------------------------------------------------------
+   // the OpenMetrics endpoint follows the host address of the server
+   //
+   if ((pclMetricsServerP != nullptr) && (pclMetricsServerP->isActive()))
+   {
+      pclMetricsServerP->start(clServerAddressP, pclMetricsServerP->port());
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the raw TCP server follows the host address of the server
+   //
+   if ((pclTcpServerP != nullptr) && (pclTcpServerP->isListening()))
+   {
+      setTcpPort(pclTcpServerP->serverPort());
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::setTcpPort()                                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanServer::setTcpPort(const uint16_t uwPortV)
+{
+   //---------------------------------------------------------------------------------------------------
+   // debug information
+   //
+   #ifndef QT_NO_DEBUG_OUTPUT
+   qDebug() << "QCanServer::setTcpPort(" << uwPortV << ")";
+   #endif
+
+   if (pclTcpServerP.isNull())
+   {
+      if (uwPortV == 0)
+      {
+         return (true);
+      }
+
+      pclTcpServerP = new QTcpServer();
+      pclTcpServerP->setMaxPendingConnections(QCAN_TCP_SOCKET_MAX);
+      connect( pclTcpServerP, &QTcpServer::newConnection,
+               this,          &QCanServer::onTcpServerConnect);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // sockets which are already connected are not affected
+   //
+   if (pclTcpServerP->isListening())
+   {
+      pclTcpServerP->close();
+   }
+
+   if (uwPortV == 0)
+   {
+      return (true);
+   }
+
+   return (pclTcpServerP->listen(clServerAddressP, uwPortV));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServer::tcpPort()                                                                                              //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint16_t QCanServer::tcpPort(void) const
+{
+   if ((pclTcpServerP != nullptr) && (pclTcpServerP->isListening()))
+   {
+      return (pclTcpServerP->serverPort());
+   }
+
+   return (0);
 }
@@ -41,18 +41,24 @@
 #include <QtCore/QObject>
 #include <QtCore/QSharedMemory>
 
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
 #include <QtWebSockets/QWebSocket>
 #include <QtWebSockets/QWebSocketServer>
 
 
+#include "qcan_bridge.hpp"
+#include "qcan_metrics_server.hpp"
 #include "qcan_network.hpp"
+#include "qcan_thread_scheduling.hpp"
 
 
 //----------------------------------------------------------------------------------------------------------------
 /*!
 ** \class QCanServer
 **
-** This class represents a CAN server, which incorporates up to #QCAN_NETWORK_MAX number of CAN networks
+** This class represents a CAN server, which incorporates up to #QCAN_NETWORK_LIMIT number of CAN networks
 ** (QCanNetwork). It is only possible to run one instance of a QCanServer on a machine. In order to avoid
 ** multiple instances, the QCanServer class initialises a shared memory region.
 ** <p>
@@ -60,6 +66,18 @@
 ** Access to the CAN server is granted via a WebSocket interface running on the default port
 ** #QCAN_WEB_SOCKET_DEFAULT_PORT. By default, access is granted only to processes running
 ** on the local machine. Remote access can be granted by calling setServerAddress(QHostAddress::AnyIPv4).
+** <p>
+** CAN frames can also be exchanged via a raw TCP connection, which avoids the framing of the WebSocket
+** protocol and streams CAN frames back-to-back. The TCP server is enabled by setTcpPort(), the channel
+** is selected by a handshake line (see #QCAN_TCP_SOCKET_DEFAULT_PORT).
+** <p>
+** <h2>Monitoring</h2>
+** The statistic of all CAN networks can be served in the OpenMetrics text format via HTTP, the
+** endpoint is enabled by setMetricsPort(). It uses the same host address as the WebSocket server.
+** <p>
+** <h2>Federation</h2>
+** CAN networks can be mirrored into the CAN network of another server by bridge links (see addBridge()),
+** the remote server must have enabled its raw TCP server.
 **
 */
 class QCanServer : public QObject
@@ -76,7 +94,8 @@ public:
    ** \param[in]  btClearServerV Clear process memory
    **
    ** Create new QCanServer object. The parameter \a ubNetworkNumV defines the maximum number of
-   ** CAN networks (class QCanNetwork).
+   ** CAN networks (class QCanNetwork), the value is limited to #QCAN_NETWORK_LIMIT. The resources
+   ** of a network are allocated when the network is enabled.
    */
    QCanServer( QObject * pclParentV = nullptr, uint16_t  uwPortNumberV = QCAN_WEB_SOCKET_DEFAULT_PORT,
                uint8_t   ubNetworkNumV = QCAN_NETWORK_MAX, bool btClearServerV = false);
@@ -120,6 +139,68 @@ public:
 
    void           allowModeChange(bool btEnabledV = true);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclBridgeV - Bridge link
+   ** \return     \c true if the bridge link has been added
+   ** \see        removeBridge(), clearBridges()
+   **
+   ** The function adds a bridge link from a local CAN network to the CAN network of a remote server,
+   ** see QCanBridge for details. The server takes over the ownership of \a pclBridgeV and starts the
+   ** connection. The function returns \c false if the bridge is not valid or the local network does
+   ** not exist, the ownership remains at the caller in this case. The handle of a bridge is unique
+   ** for the server, an existing bridge with the same handle is removed. Bridges can also be
+   ** configured via the settings WebSocket of the server ("bridgeAdd", "bridgeRemove" and
+   ** "bridgeClear").
+   */
+   bool           addBridge(QCanBridge * pclBridgeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clRouteR - Routing rule
+   ** \return     \c true if the route has been added
+   ** \see        removeRoute(), clearRoutes()
+   **
+   ** The function adds a routing rule between two CAN networks, see QCanRoute for details. The
+   ** handle of a route is unique for the server, an existing route with the same handle is replaced.
+   ** Routes can also be configured via the settings WebSocket of the server (see
+   ** QCanServerSettings::addRoute()).
+   */
+   bool           addRoute(const QCanRoute & clRouteR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     List of bridge links
+   ** \see        addBridge()
+   */
+   inline QVector<QCanBridge *> bridges(void) const  { return (clBridgeListP); }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        addBridge()
+   **
+   ** The function removes all bridge links.
+   */
+   void           clearBridges(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        addRoute()
+   **
+   ** The function removes all routing rules.
+   */
+   void           clearRoutes(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Scheduling of the dispatch thread
+   ** \see        setDispatchScheduling()
+   **
+   ** The function returns the requested scheduling of the dispatch thread, the settings which took
+   ** effect are returned by QCanThreadScheduling::report().
+   */
+   inline QCanThreadScheduling dispatchScheduling(void) const  { return (clDispatchSchedulingP); }
+
    bool           isBitrateChangeAllowed(void)     { return (btAllowBitrateChangeP);   }
 
    bool           isBusOffRecoveryAllowed(void)    { return (btAllowBusOffRecoverP);   }
@@ -137,6 +218,26 @@ public:
    */
    QCanNetwork *  network(uint8_t ubNetworkIndexV);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV - Handle of bridge
+   ** \return     \c true if the bridge link has been removed
+   ** \see        addBridge()
+   **
+   ** The function closes and deletes the bridge link \a ulHandleV.
+   */
+   bool           removeBridge(const uint32_t ulHandleV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulHandleV - Handle of route
+   ** \return     \c true if the route has been removed
+   ** \see        addRoute()
+   **
+   ** The function removes the routing rule \a ulHandleV.
+   */
+   bool           removeRoute(const uint32_t ulHandleV);
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return Maximum number of networks
@@ -145,6 +246,16 @@ public:
    */
    uint8_t        maximumNetwork(void) const;
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Port number of the OpenMetrics endpoint
+   ** \see        setMetricsPort()
+   **
+   ** The function returns the port number of the OpenMetrics endpoint, the value is 0 if the
+   ** endpoint is disabled.
+   */
+   uint16_t       metricsPort(void) const;
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return Host address of server
@@ -164,14 +275,84 @@ public:
    void           setServerAddress(const QHostAddress clHostAddressV, 
                                    const uint16_t uwPortV = QCAN_WEB_SOCKET_DEFAULT_PORT);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clSchedulingR  CPU affinity and scheduling policy
+   ** \return     \c true if the requested scheduling took effect
+   ** \see        dispatchScheduling()
+   **
+   ** The function sets the CPU affinity and the scheduling policy of the dispatch thread, i.e. the
+   ** thread of the server which runs the event loop of all CAN networks. It must be called from this
+   ** thread. If a setting is not permitted the thread falls back to the default scheduling, the
+   ** settings which took effect are available through dispatchScheduling().
+   ** <p>
+   ** Without the definition QCAN_NO_QT_GUI the server runs in the GUI thread of the application, so
+   ** the settings also apply to the user interface. In this case a real-time policy is refused and
+   ** only the CPU affinity is set.
+   */
+   bool           setDispatchScheduling(const QCanThreadScheduling & clSchedulingR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  uwPortV        Port number of the OpenMetrics endpoint
+   ** \return     \c true if the endpoint has been configured
+   ** \see        metricsPort()
+   **
+   ** The function starts the OpenMetrics endpoint (see QCanMetricsServer) on the port \a uwPortV,
+   ** the value 0 disables the endpoint. The endpoint is disabled by default.
+   */
+   bool           setMetricsPort(const uint16_t uwPortV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  btEnabledV     Enable / disable TCP_NODELAY
+   ** \see        tcpNoDelay()
+   **
+   ** The function controls the option TCP_NODELAY (Nagle's algorithm disabled) of raw TCP sockets
+   ** which are accepted afterwards. The option is enabled by default, disabling it trades latency for
+   ** fewer segments on the network.
+   */
+   void           setTcpNoDelay(const bool btEnabledV)   { btTcpNoDelayP = btEnabledV;    }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  uwPortV        Port number of the raw TCP server
+   ** \return     \c true if the TCP server has been configured
+   ** \see        tcpPort()
+   **
+   ** The function starts the raw TCP server on the port \a uwPortV using the host address of the
+   ** server, the value 0 disables the TCP server. The TCP server is disabled by default.
+   */
+   bool           setTcpPort(const uint16_t uwPortV);
+
    Error_e        state(void)    { return (teErrorP); }
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if TCP_NODELAY is enabled
+   ** \see        setTcpNoDelay()
+   **
+   ** The function returns \c true if the option TCP_NODELAY is set for raw TCP sockets.
+   */
+   bool           tcpNoDelay(void) const                 { return (btTcpNoDelayP);        }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Port number of the raw TCP server
+   ** \see        setTcpPort()
+   **
+   ** The function returns the port number of the raw TCP server, the value is 0 if the TCP server
+   ** is disabled.
+   */
+   uint16_t       tcpPort(void) const;
+
 signals:
 
    void           error(enum QCanServer::Error_e teErrorV);
 
 private slots:
 
+   void           onStatisticTimerEvent(void);
    void           onTimerEvent(void);
 
 private:
@@ -183,7 +364,15 @@ private:
    uint16_t                   uwServerPortP;
    QVector<QCanNetwork *>     clNetworkListP;
    QTimer *                   pclTimerP;
+   QTimer *                   pclStatisticTimerP;
+   QCanMetricsServer *        pclMetricsServerP;
    uint8_t                    ubNetworkMaxP;
+   QCanThreadScheduling       clDispatchSchedulingP;
+
+   //---------------------------------------------------------------------------------------------------
+   // bridge links to remote servers, the server is the owner of the QCanBridge objects
+   //
+   QVector<QCanBridge *>      clBridgeListP;
 
 
    //---------------------------------------------------------------------------------------------------
@@ -194,6 +383,18 @@ private:
    QVector<QWebSocket*>       clWebSocketListP;
    QMutex                     clWebSocketMutexP;
 
+   //---------------------------------------------------------------------------------------------------
+   // Management of raw TCP sockets: a QTcpServer (pclTcpServerP) accepts the connections, a socket is
+   // kept inside clTcpPendingListP until the handshake is completed and then passed to the network,
+   // a multiplexed connection is passed to a QCanMuxSocket which is a child of the server
+   //
+   QPointer<QTcpServer>       pclTcpServerP;
+   QVector<QTcpSocket*>       clTcpPendingListP;
+   bool                       btTcpNoDelayP;
+
+   void           attachMuxSocket(QTcpSocket * pclSocketV, const QList<QByteArray> & clChannelListR);
+   void           rejectTcpSocket(QTcpSocket * pclSocketV, const QByteArray & clReasonR);
+
    //---------------------------------------------------------------------------------------------------
    // The QCanServer allocates shared memory to make sure it is initialised only once
    //
@@ -229,6 +430,21 @@ private slots:
 
    void           onSocketDisconnect(void);
 
+   /*!
+   ** This slot is called upon a new raw TCP connection.
+   */
+   void           onTcpServerConnect(void);
+
+   /*!
+   ** This slot is called upon disconnection of a raw TCP socket before the handshake is completed.
+   */
+   void           onTcpSocketDisconnect(void);
+
+   /*!
+   ** This slot is called when the handshake line is received on a raw TCP socket.
+   */
+   void           onTcpSocketHandshake(void);
+
    /*!
    ** This slot is called upon WebSocket disconnection.
    */
@@ -244,6 +460,11 @@ private slots:
    */
    void           onWebSocketServerError(QWebSocketProtocol::CloseCode teCloseCodeV);
 
+   /*!
+   ** This slot is called when a command (JSON) is received on a settings WebSocket.
+   */
+   void           onWebSocketTextData(const QString & clMessageR);
+
 };
 
 #endif // QCAN_SERVER_HPP_
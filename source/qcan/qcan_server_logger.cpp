@@ -66,11 +66,9 @@
 //--------------------------------------------------------------------------------------------------------------------//
 QCanServerLogger::QCanServerLogger(QCanServer * pclServerV)
 {
-   for (uint8_t ubLogNumT = 0; ubLogNumT < QCAN_NETWORK_MAX; ubLogNumT++)
-   {
-      ateLogLevelP[ubLogNumT] = QCan::eLOG_LEVEL_INFO;
-      apclLogFileP[ubLogNumT] = nullptr;
-   }
+   clLogLevelListP.fill(QCan::eLOG_LEVEL_INFO, QCAN_NETWORK_MAX);
+
+   clLogWriterP.start(QThread::LowPriority);
 
    if (pclServerV != nullptr)
    {
@@ -86,14 +84,10 @@ QCanServerLogger::QCanServerLogger(QCanServer * pclServerV)
 //--------------------------------------------------------------------------------------------------------------------//
 QCanServerLogger::~QCanServerLogger()
 {
-   for (uint8_t ubLogNumT = 0; ubLogNumT < QCAN_NETWORK_MAX; ubLogNumT++)
-   {
-      if (apclLogFileP[ubLogNumT] != nullptr)
-      {
-         apclLogFileP[ubLogNumT]->flush();
-         apclLogFileP[ubLogNumT]->close();
-      }
-   }
+   //---------------------------------------------------------------------------------------------------
+   // write all pending log messages, the log files are closed by the writer
+   //
+   clLogWriterP.stop();
 }
 
 
@@ -105,6 +99,15 @@ void  QCanServerLogger::attachServer(QCanServer * pclServerV)
 {
    QString  clFileT;
 
+   //---------------------------------------------------------------------------------------------------
+   // the server may run more networks than the default number
+   //
+   if (pclServerV->maximumNetwork() > clLogLevelListP.size())
+   {
+      clLogLevelListP.resize(pclServerV->maximumNetwork());
+      clLogLevelListP.fill(QCan::eLOG_LEVEL_INFO);
+   }
+
    for (uint8_t ubChannelNumT = QCan::eCAN_CHANNEL_1; ubChannelNumT <= pclServerV->maximumNetwork(); ubChannelNumT++)
    {
       clFileT = QString(QCAN_LOG_PATH);
@@ -136,21 +139,17 @@ void QCanServerLogger::addLoggingSource(QObject * pclSenderV)
 void QCanServerLogger::appendMessage(const QCan::CAN_Channel_e ubChannelV, const QString & clLogMessageV,
                                      QCan::LogLevel_e teLogLevelV)
 {
-   if ((ubChannelV >= QCan::eCAN_CHANNEL_1) && (ubChannelV <= QCAN_NETWORK_MAX))
+   if ((ubChannelV >= QCan::eCAN_CHANNEL_1) && (ubChannelV <= clLogLevelListP.size()))
    {
       clLogMessageP.clear();
 
-      if (teLogLevelV <= ateLogLevelP[ubChannelV - 1])
+      if (teLogLevelV <= clLogLevelListP.at(ubChannelV - 1))
       {
          clTimeP = QDateTime::currentDateTime();
          clLogMessageP  = clTimeP.toString("hh:mm:ss.zzz - ");
          clLogMessageP += clLogMessageV;
 
-         if ((apclLogFileP[ubChannelV - 1]) != nullptr)
-         {
-            apclLogFileP[ubChannelV - 1]->write(clLogMessageP.toLatin1() + "\n");
-            apclLogFileP[ubChannelV - 1]->flush();
-         }
+         clLogWriterP.append(static_cast< uint8_t >(ubChannelV - 1), clLogMessageP.toLatin1() + "\n");
       }
    }
 }
@@ -164,9 +163,9 @@ QCan::LogLevel_e QCanServerLogger::logLevel(const QCan::CAN_Channel_e teChannelV
 {
    QCan::LogLevel_e teLevelT = QCan::eLOG_LEVEL_INFO;
 
-   if ((teChannelV >= QCan::eCAN_CHANNEL_1) && (teChannelV <= QCAN_NETWORK_MAX))
+   if ((teChannelV >= QCan::eCAN_CHANNEL_1) && (teChannelV <= clLogLevelListP.size()))
    {
-      teLevelT = ateLogLevelP[teChannelV - 1];
+      teLevelT = clLogLevelListP.at(teChannelV - 1);
    }
 
    return teLevelT;
@@ -179,42 +178,11 @@ QCan::LogLevel_e QCanServerLogger::logLevel(const QCan::CAN_Channel_e teChannelV
 //--------------------------------------------------------------------------------------------------------------------//
 bool QCanServerLogger::setFileName(const QCan::CAN_Channel_e teChannelV, QString clFileNameV)
 {
-   QFile *  pclLogFileT;
    bool     btResultT = false;
 
-   if ((teChannelV >= QCan::eCAN_CHANNEL_1) && (teChannelV <= QCAN_NETWORK_MAX))
+   if ((teChannelV >= QCan::eCAN_CHANNEL_1) && (teChannelV <= clLogLevelListP.size()))
    {
-      if ((apclLogFileP[teChannelV - 1]) == nullptr)
-      {
-         apclLogFileP[teChannelV - 1] = new QFile();
-      }
-      else
-      {
-         //-----------------------------------------------------
-         // make sure the file is closed in case it was used
-         // before
-         //
-         apclLogFileP[teChannelV - 1]->close();
-      }
-
-      pclLogFileT = apclLogFileP[teChannelV - 1];
-
-
-      //-------------------------------------------------------------------------------------------
-      // open the new file in rw mode for text files, existing contents is truncated
-      //
-      pclLogFileT->setFileName(clFileNameV);
-      if (pclLogFileT->open(QIODevice::ReadWrite | QIODevice::Truncate | QIODevice::Text) == true)
-      {
-         btResultT = true;
-      }
-      else
-      {
-         delete (pclLogFileT);
-         apclLogFileP[teChannelV - 1] = nullptr;
-         btResultT = false;
-      }
-
+      btResultT = clLogWriterP.setFileName(static_cast< uint8_t >(teChannelV - 1), clFileNameV);
    }
 
    return btResultT;
@@ -228,9 +196,9 @@ bool QCanServerLogger::setFileName(const QCan::CAN_Channel_e teChannelV, QString
 void QCanServerLogger::setLogLevel(const QCan::CAN_Channel_e ubChannelV, QCan::LogLevel_e teLogLevelV)
 {
 
-   if ((ubChannelV >= QCan::eCAN_CHANNEL_1) && (ubChannelV <= QCAN_NETWORK_MAX))
+   if ((ubChannelV >= QCan::eCAN_CHANNEL_1) && (ubChannelV <= clLogLevelListP.size()))
    {
-      ateLogLevelP[ubChannelV - 1] = teLogLevelV;
+      clLogLevelListP[ubChannelV - 1] = teLogLevelV;
 
       QString  clLogTextP;
 
@@ -274,3 +242,12 @@ void QCanServerLogger::setLogLevel(const QCan::CAN_Channel_e ubChannelV, QCan::L
    }
 }
 
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerLogger::setRotation()                                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServerLogger::setRotation(const uint32_t ulSizeV, const uint32_t ulIntervalV, const uint8_t ubBackupV)
+{
+   clLogWriterP.setRotation(ulSizeV, ulIntervalV, ubBackupV);
+}
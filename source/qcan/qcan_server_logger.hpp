@@ -40,8 +40,10 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QFile>
 #include <QtCore/QObject>
+#include <QtCore/QVector>
 
 #include "qcan_defs.hpp"
+#include "qcan_log_writer.hpp"
 #include "qcan_namespace.hpp"
 #include "qcan_server.hpp"
 
@@ -52,6 +54,9 @@
 **
 ** This class add a logging capability for a QCanServer.
 ** <p>
+** The log messages are formatted by the calling thread and written to the log files by a
+** QCanLogWriter in the background, so logging does not delay the dispatching of CAN frames.
+** <p>
 ** \todo - Description of file names, default log level
 **
 */
@@ -85,6 +90,15 @@ public:
    */
    void                 attachServer(QCanServer * pclServerV);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of dropped log messages
+   **
+   ** The function returns the number of log messages which have been dropped because the
+   ** writer could not keep up with the message rate.
+   */
+   inline uint32_t      dropCount(void) const   { return (clLogWriterP.dropCount()); }
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  teChannelV      - CAN channel
@@ -131,6 +145,17 @@ public:
    void                 setLogLevel(const QCan::CAN_Channel_e teChannelV, const QCan::LogLevel_e teLogLevelV);
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulSizeV         - Maximum file size in bytes, 0 disables the size based rotation
+   ** \param[in]  ulIntervalV     - Rotation interval in seconds, 0 disables the time based rotation
+   ** \param[in]  ubBackupV       - Number of backup files
+   **
+   ** The function configures the rotation of the log files, see QCanLogWriter::setRotation().
+   */
+   void                 setRotation(const uint32_t ulSizeV, const uint32_t ulIntervalV, const uint8_t ubBackupV);
+
+
 public slots:
 
    //---------------------------------------------------------------------------------------------------
@@ -163,8 +188,8 @@ private:
 
    QDateTime            clTimeP;
    QString              clLogMessageP;
-   QFile *              apclLogFileP[QCAN_NETWORK_MAX];
-   QCan::LogLevel_e     ateLogLevelP[QCAN_NETWORK_MAX];
+   QCanLogWriter        clLogWriterP;
+   QVector<QCan::LogLevel_e>  clLogLevelListP;
 };
 
 #endif // QCAN_SERVER_LOGGER_HPP_
@@ -68,19 +68,29 @@ QCanServerLoggerView::QCanServerLoggerView(QCanServer * pclServerV)
    QString clFontFamilyT = QFontDatabase::applicationFontFamilies(slFontIdT).at(0);
    QFont clFontT = QFont(clFontFamilyT, 12, 50);
 
+   //---------------------------------------------------------------------------------------------------
+   // create one log widget for each network of the server
+   //
+   uint8_t  ubLogCountT = QCAN_NETWORK_MAX;
+   if (pclServerV != nullptr)
+   {
+      ubLogCountT = pclServerV->maximumNetwork();
+   }
+   clLogTextListP.resize(ubLogCountT);
+
    QString  clTabLabelT;
-   for (uint8_t ubLogNumT = 0; ubLogNumT < QCAN_NETWORK_MAX; ubLogNumT++)
+   for (uint8_t ubLogNumT = 0; ubLogNumT < ubLogCountT; ubLogNumT++)
    {
-      apclLogTextP[ubLogNumT] = new QTextBrowser();
-      apclLogTextP[ubLogNumT]->setFont(clFontT);
+      clLogTextListP[ubLogNumT] = new QTextBrowser();
+      clLogTextListP[ubLogNumT]->setFont(clFontT);
       clTabLabelT = QString(" CAN &%1 ").arg(ubLogNumT + 1);
 
-      apclLogTextP[ubLogNumT]->setContextMenuPolicy(Qt::CustomContextMenu);
-      connect( apclLogTextP[ubLogNumT],
+      clLogTextListP[ubLogNumT]->setContextMenuPolicy(Qt::CustomContextMenu);
+      connect( clLogTextListP[ubLogNumT],
                SIGNAL(customContextMenuRequested(const QPoint &)),
                this, SLOT(onShowLogMenu(const QPoint &)));
 
-      pclLogTabP->addTab(apclLogTextP[ubLogNumT], clTabLabelT);
+      pclLogTabP->addTab(clLogTextListP[ubLogNumT], clTabLabelT);
    }
 
 
@@ -113,12 +123,12 @@ void QCanServerLoggerView::appendMessage(const QCan::CAN_Channel_e teChannelV, c
 {
    QCanServerLogger::appendMessage(teChannelV, clLogMessageV, teLogLevelV);
 
-   if ((teChannelV >= QCan::eCAN_CHANNEL_1) && (teChannelV <= QCAN_NETWORK_MAX))
+   if ((teChannelV >= QCan::eCAN_CHANNEL_1) && (teChannelV <= clLogTextListP.size()))
    {
 
       if (teLogLevelV <= logLevel(teChannelV))
       {
-         apclLogTextP[teChannelV - 1]->append(message());
+         clLogTextListP[teChannelV - 1]->append(message());
       }
    }
 }
@@ -159,7 +169,7 @@ void QCanServerLoggerView::onChangeLogLevel(QAction * pclActionV)
 //--------------------------------------------------------------------------------------------------------------------//
 void QCanServerLoggerView::onClearLog(void)
 {
-   apclLogTextP[teCanChannelP - 1]->clear();
+   clLogTextListP[teCanChannelP - 1]->clear();
 }
 
 
@@ -204,7 +214,7 @@ void QCanServerLoggerView::onShowLogMenu(const QPoint &pos)
       //-------------------------------------------------------
       // create default menu and add additional entries
       //
-      pclMenuT  = apclLogTextP[slTabIndexT]->createStandardContextMenu();
+      pclMenuT  = clLogTextListP[slTabIndexT]->createStandardContextMenu();
 
 
       //-------------------------------------------------------
@@ -212,7 +222,7 @@ void QCanServerLoggerView::onShowLogMenu(const QPoint &pos)
       //
       pclClearT = pclMenuT->addAction(tr("Clear all"),
                                        this, SLOT(onClearLog()));
-      if(apclLogTextP[slTabIndexT]->toPlainText().size() == 0)
+      if(clLogTextListP[slTabIndexT]->toPlainText().size() == 0)
       {
           pclClearT->setDisabled(true);
       }
@@ -287,7 +297,7 @@ void QCanServerLoggerView::onShowLogMenu(const QPoint &pos)
                this, SLOT(onChangeLogLevel(QAction*)));
       pclMenuT->addMenu(pclSubMenuT);
 
-      pclMenuT->exec(apclLogTextP[slTabIndexT]->mapToGlobal(pos));
+      pclMenuT->exec(clLogTextListP[slTabIndexT]->mapToGlobal(pos));
 
       delete pclMenuT;
     }
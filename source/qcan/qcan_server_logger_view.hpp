@@ -37,6 +37,8 @@
 **                                                                                                                    **
 \*--------------------------------------------------------------------------------------------------------------------*/
 
+#include <QtCore/QVector>
+
 #include <QtWidgets/QMainWindow>
 #include <QtWidgets/QTextBrowser>
 
@@ -93,7 +95,7 @@ private slots:
 private:
    QMainWindow          *pclLogWindowP;
    QTabWidget           *pclLogTabP;
-   QTextBrowser         *apclLogTextP[QCAN_NETWORK_MAX];
+   QVector<QTextBrowser *> clLogTextListP;
 
    QCan::CAN_Channel_e  teCanChannelP;
 
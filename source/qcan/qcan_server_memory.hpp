@@ -0,0 +1,402 @@
+//====================================================================================================================//
+// File:          qcan_server_memory.hpp                                                                              //
+// Description:   QCAN classes - Server shared memory                                                                 //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_SERVER_MEMORY_HPP_
+#define QCAN_SERVER_MEMORY_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "qcan_defs.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_MEMORY_KEY
+**
+** Key of the shared memory segment of the CANpie server.
+*/
+#define  QCAN_MEMORY_KEY                     "QCAN_SERVER_SHARED_KEY"
+
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_MEMORY_LATENCY_PATH_MAX
+**
+** Number of latency paths per CAN network, this value must match QCanNetwork::eLATENCY_PATH_MAX.
+*/
+#define  QCAN_MEMORY_LATENCY_PATH_MAX        5
+
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_MEMORY_SOCKET_MAX
+**
+** Number of socket entries per CAN network inside the shared memory: local sockets, WebSockets and raw
+** TCP sockets up to the limit #QCAN_SOCKET_LIMIT_MAX of QCanNetwork::setSocketLimit().
+*/
+#define  QCAN_MEMORY_SOCKET_MAX              (3 * QCAN_SOCKET_LIMIT_MAX)
+
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_MEMORY_STATISTIC_PERIOD
+**
+** Update period of the network statistic inside the shared memory in milliseconds.
+*/
+#define  QCAN_MEMORY_STATISTIC_PERIOD        100
+
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_MEMORY_SOCKET_LOCAL
+**
+** Type of a socket entry: local socket
+*/
+#define  QCAN_MEMORY_SOCKET_LOCAL            1
+
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_MEMORY_SOCKET_WEB
+**
+** Type of a socket entry: WebSocket
+*/
+#define  QCAN_MEMORY_SOCKET_WEB              2
+
+
+//-----------------------------------------------------------------------------------------------------
+/*!
+** \def     QCAN_MEMORY_SOCKET_TCP
+**
+** Type of a socket entry: raw TCP socket
+*/
+#define  QCAN_MEMORY_SOCKET_TCP              3
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Structures                                                                                                         **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------------------------------
+// Latency summary of a CAN network inside shared memory, all values are given in nanoseconds
+//
+typedef struct CanServerLatency_s {
+   uint64_t uqCount;
+   uint64_t uqP50;
+   uint64_t uqP99;
+   uint64_t uqMax;
+} CanServerLatency_ts;
+
+
+//-----------------------------------------------------------------------------------------------------
+// Statistic of a socket connected to a CAN network
+//
+typedef struct CanServerSocketStatistic_s {
+
+   //--------------------------------------------------------------------------
+   // Number of CAN frames which could not be written to the socket
+   //
+   uint32_t ulDropCount;
+
+   //--------------------------------------------------------------------------
+   // Number of CAN frames pending inside the write buffer of the socket
+   //
+   uint32_t ulQueueDepth;
+
+   //--------------------------------------------------------------------------
+   // Type of socket: QCAN_MEMORY_SOCKET_LOCAL, QCAN_MEMORY_SOCKET_WEB or
+   // QCAN_MEMORY_SOCKET_TCP
+   //
+   uint8_t  ubType;
+   uint8_t  aubReserved[3];
+
+} CanServerSocketStatistic_ts;
+
+
+//-----------------------------------------------------------------------------------------------------
+// Statistic of a CAN network
+//
+typedef struct CanServerNetworkStatistic_s {
+
+   //--------------------------------------------------------------------------
+   // Number of CAN frames and error frames
+   //
+   uint32_t ulFrameCount;
+   uint32_t ulErrorCount;
+
+   //--------------------------------------------------------------------------
+   // Number of CAN frames per second and bus load in percent, both values
+   // are updated once per second
+   //
+   uint32_t ulFramesPerSecond;
+   uint8_t  ubBusLoad;
+   uint8_t  aubReserved[3];
+
+   //--------------------------------------------------------------------------
+   // Number of CAN frames inside the transmit queue and number of CAN frames
+   // dropped by the transmit queue
+   //
+   uint32_t ulTransmitQueueDepth;
+   uint32_t ulTransmitDropCount;
+
+   //--------------------------------------------------------------------------
+   // Number of valid entries inside atsSocket, local sockets are followed
+   // by WebSockets and raw TCP sockets
+   //
+   uint32_t ulSocketCount;
+   uint32_t ulReserved;
+
+   //--------------------------------------------------------------------------
+   // Dispatch latency per source type and egress latency per destination
+   // type, see QCanNetwork::LatencyPath_e
+   //
+   CanServerLatency_ts  atsLatencyDispatch[QCAN_MEMORY_LATENCY_PATH_MAX];
+   CanServerLatency_ts  atsLatencyEgress[QCAN_MEMORY_LATENCY_PATH_MAX];
+
+   //--------------------------------------------------------------------------
+   // Statistic of the connected sockets
+   //
+   CanServerSocketStatistic_ts   atsSocket[QCAN_MEMORY_SOCKET_MAX];
+
+} CanServerNetworkStatistic_ts;
+
+
+//-----------------------------------------------------------------------------------------------------
+// Statistic of a CAN network protected by a sequence lock: the value of ulSequence is odd while
+// the server updates tsData
+//
+typedef struct CanServerStatisticSlot_s {
+   std::atomic<uint32_t>         ulSequence;
+   uint32_t                      ulReserved;
+   CanServerNetworkStatistic_ts  tsData;
+} CanServerStatisticSlot_ts;
+
+
+//-----------------------------------------------------------------------------------------------------
+// Server signature inside shared memory
+//
+typedef struct CanServerSharedMemory_s {
+
+   //--------------------------------------------------------------------------
+   // Server version: major
+   //
+   int32_t  slVersionMajor;
+
+   //--------------------------------------------------------------------------
+   // Server version: minor
+   //
+   int32_t  slVersionMinor;
+
+   //--------------------------------------------------------------------------
+   // Server version: build
+   //
+   int32_t  slVersionBuild;
+
+   //--------------------------------------------------------------------------
+   // Number of CAN networks supported by the server
+   //
+   int32_t  slNetworkCount;
+
+   //--------------------------------------------------------------------------
+   // Stores the start date / time of the server in milliseconds that have
+   // passed since 1970-01-01T00:00:00.000
+   //
+   int64_t  sqDateTimeStart;
+
+   //--------------------------------------------------------------------------
+   // Stores the actual date / time of the server in milliseconds that have
+   // passed since 1970-01-01T00:00:00.000
+   //
+   int64_t  sqDateTimeActual;
+
+   //--------------------------------------------------------------------------
+   // Number of entries inside atsStatistic, this is the number of CAN
+   // networks unless an existing shared memory of a crashed server is
+   // too small
+   //
+   int32_t  slStatisticCount;
+   int32_t  slReserved;
+
+   //--------------------------------------------------------------------------
+   // Statistic per CAN network (index 0 is the first network), updated every
+   // QCAN_MEMORY_STATISTIC_PERIOD milliseconds without taking the lock of
+   // the shared memory, see QCanServerMemory::readStatistic(). The array
+   // holds slStatisticCount entries, the size of the shared memory is
+   // calculated by QCanServerMemory::size().
+   //
+   CanServerStatisticSlot_ts  atsStatistic[1];
+
+} CanServerSharedMemory_ts;
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanServerMemory
+** \brief   Access to the server shared memory
+**
+** The QCanServerMemory class provides lock-free access to the network statistic inside the shared
+** memory of the CANpie server. The server is the only writer, any number of monitoring processes
+** may sample the statistic at high frequency without taking the lock of the QSharedMemory object.
+** <p>
+** The class is implemented inside this header only, so a monitoring process does not need to link
+** against the QCAN library.
+*/
+class QCanServerMemory
+{
+public:
+
+   QCanServerMemory() = delete;                                                  // no constructor
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  slNetworkCountV   Number of CAN networks
+   ** \return     Size of the shared memory in bytes
+   **
+   ** The function returns the size of the shared memory which holds the statistic of
+   ** \a slNetworkCountV CAN networks.
+   */
+   static int64_t size(const int32_t slNetworkCountV)
+   {
+      int64_t sqCountT = (slNetworkCountV > 1) ? slNetworkCountV : 1;
+
+      return (static_cast< int64_t >(sizeof(CanServerSharedMemory_ts)) +
+              ((sqCountT - 1) * static_cast< int64_t >(sizeof(CanServerStatisticSlot_ts))));
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  sqSizeV        Size of the shared memory in bytes
+   ** \return     Number of statistic entries
+   **
+   ** The function returns the number of CAN networks whose statistic fits into a shared memory of
+   ** \a sqSizeV bytes, it is the inverse function of size().
+   */
+   static int32_t statisticCount(const int64_t sqSizeV)
+   {
+      if (sqSizeV < static_cast< int64_t >(sizeof(CanServerSharedMemory_ts)))
+      {
+         return (0);
+      }
+
+      return (static_cast< int32_t >(1 + ((sqSizeV - static_cast< int64_t >(sizeof(CanServerSharedMemory_ts))) /
+                                          static_cast< int64_t >(sizeof(CanServerStatisticSlot_ts)))));
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ptsMemoryV     Pointer to shared memory
+   ** \param[in]  slNetworkV     Network index, starting with 0
+   ** \param[out] tsDataR        Network statistic
+   ** \param[in]  slRetryV       Maximum number of retries
+   ** \return     \c true if a consistent copy has been read
+   **
+   ** The function copies the statistic of the CAN network \a slNetworkV to \a tsDataR. The copy is
+   ** repeated if the server updated the statistic in the meantime, the function returns \c false
+   ** if no consistent copy was possible within \a slRetryV retries.
+   ** <p>
+   ** The function returns \c false if \a slNetworkV is not below
+   ** CanServerSharedMemory_ts::slStatisticCount.
+   */
+   static bool readStatistic(const CanServerSharedMemory_ts * ptsMemoryV, const int32_t slNetworkV,
+                             CanServerNetworkStatistic_ts & tsDataR, int32_t slRetryV = 16)
+   {
+      if ((ptsMemoryV == nullptr) || (slNetworkV < 0) || (slNetworkV >= ptsMemoryV->slStatisticCount))
+      {
+         return (false);
+      }
+
+      const CanServerStatisticSlot_ts & tsSlotR = ptsMemoryV->atsStatistic[slNetworkV];
+
+      do
+      {
+         uint32_t ulSequenceT = tsSlotR.ulSequence.load(std::memory_order_acquire);
+         if ((ulSequenceT & 1) == 0)
+         {
+            memcpy(&tsDataR, &tsSlotR.tsData, sizeof(CanServerNetworkStatistic_ts));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (tsSlotR.ulSequence.load(std::memory_order_relaxed) == ulSequenceT)
+            {
+               return (true);
+            }
+         }
+      } while (slRetryV-- > 0);
+
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ptsMemoryV     Pointer to shared memory
+   ** \param[in]  slNetworkV     Network index, starting with 0
+   ** \param[in]  tsDataR        Network statistic
+   **
+   ** The function copies \a tsDataR to the statistic of the CAN network \a slNetworkV. The function
+   ** must only be called by the server.
+   */
+   static void writeStatistic(CanServerSharedMemory_ts * ptsMemoryV, const int32_t slNetworkV,
+                              const CanServerNetworkStatistic_ts & tsDataR)
+   {
+      if ((ptsMemoryV == nullptr) || (slNetworkV < 0) || (slNetworkV >= ptsMemoryV->slStatisticCount))
+      {
+         return;
+      }
+
+      CanServerStatisticSlot_ts & tsSlotR = ptsMemoryV->atsStatistic[slNetworkV];
+      uint32_t ulSequenceT = tsSlotR.ulSequence.load(std::memory_order_relaxed);
+
+      tsSlotR.ulSequence.store(ulSequenceT + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      memcpy(&tsSlotR.tsData, &tsDataR, sizeof(CanServerNetworkStatistic_ts));
+      tsSlotR.ulSequence.store(ulSequenceT + 2, std::memory_order_release);
+   }
+};
+
+
+//-----------------------------------------------------------------------------------------------------
+// the sequence counter is shared between processes, this requires a lock-free implementation
+//
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "std::atomic<uint32_t> is not lock-free");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "unexpected size of std::atomic<uint32_t>");
+
+#endif   // QCAN_SERVER_MEMORY_HPP_
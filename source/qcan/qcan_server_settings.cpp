@@ -39,6 +39,7 @@
 
 #include "qcan_server_settings.hpp"
 
+#include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 
@@ -84,6 +85,38 @@ QCanServerSettings::~QCanServerSettings()
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerSettings::addRoute()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServerSettings::addRoute(const QCanRoute & clRouteR)
+{
+   QJsonArray  clJsonArrayT;
+
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server
+   //
+   clJsonArrayT = clJsonCommandP.value("routeAdd").toArray();
+   clJsonArrayT.append(clRouteR.toJson());
+   clJsonCommandP["routeAdd"]             = clJsonArrayT;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerSettings::clearRoutes()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServerSettings::clearRoutes(void)
+{
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server, pending routes are obsolete
+   //
+   clJsonCommandP.remove("routeAdd");
+   clJsonCommandP.remove("routeRemove");
+   clJsonCommandP["routeClear"]           = true;
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanServerSettings::closeConnection()                                                                              //
 // disconnect from CANpie FD server                                                                                   //
@@ -313,6 +346,80 @@ void QCanServerSettings::onSocketMessageReceived(const QString & clMessageR)
 
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerSettings::removeRoute()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanServerSettings::removeRoute(const uint32_t ulHandleV)
+{
+   QJsonArray  clJsonArrayT;
+
+   //---------------------------------------------------------------------------------------------------
+   // Update JSON object for commands to server
+   //
+   clJsonArrayT = clJsonCommandP.value("routeRemove").toArray();
+   clJsonArrayT.append(static_cast< int32_t >(ulHandleV));
+   clJsonCommandP["routeRemove"]          = clJsonArrayT;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerSettings::routes()                                                                                       //
+// return routing rules of server                                                                                     //
+//--------------------------------------------------------------------------------------------------------------------//
+QVector<QCanRoute> QCanServerSettings::routes(void)
+{
+   QVector<QCanRoute>   clRouteListT;
+   QJsonArray           clJsonArrayT;
+   QCanRoute            clRouteT;
+
+   if (clJsonServerP.isEmpty() == false)
+   {
+      clJsonArrayT = clJsonServerP.value("routes").toArray();
+      for (int32_t slIndexT = 0; slIndexT < clJsonArrayT.size(); slIndexT++)
+      {
+         if (clRouteT.fromJson(clJsonArrayT.at(slIndexT).toObject()))
+         {
+            clRouteListT.append(clRouteT);
+         }
+      }
+   }
+
+   return (clRouteListT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanServerSettings::send()                                                                                         //
+// send command as JSON object to connected QCanServer class                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanServerSettings::send(void)
+{
+   bool btResultT = false;
+
+   if ((teServerStateP == QCanServerSettings::eSTATE_ACTIVE) && (clJsonCommandP.isEmpty() == false))
+   {
+      //-------------------------------------------------------------------------------------------
+      // create JSON document in text format and send it
+      //
+      QJsonDocument clJsonDocumentT(clJsonCommandP);
+
+      if (pclWebSocketP.isNull() == false)
+      {
+         pclWebSocketP->sendTextMessage(clJsonDocumentT.toJson());
+         btResultT = true;
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // all commands are executed only once
+      //
+      clJsonCommandP = QJsonObject();
+   }
+
+   return (btResultT);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanServerSettings::state()                                                                                        //
 // return the current state of the QCan server                                                                        //
@@ -44,6 +44,7 @@
 
 #include "qcan_defs.hpp"
 #include "qcan_namespace.hpp"
+#include "qcan_route.hpp"
 
 
 /*--------------------------------------------------------------------------------------------------------------------*\
@@ -132,6 +133,25 @@ public:
    ** required for non-web browser clients (see RFC 6455). The origin may not contain new line 
    ** characters, otherwise the connection will be aborted immediately during the handshake phase.
    */
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in] clRouteR         - Routing rule
+   ** \see       removeRoute(), clearRoutes()
+   **
+   ** Add a routing rule between two CAN networks of the QCanServer. The command is transferred with
+   ** the next call of send(), see QCanServer::addRoute() for details.
+   */
+   void           addRoute(const QCanRoute & clRouteR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see       addRoute()
+   **
+   ** Remove all routing rules of the QCanServer. The command is transferred with the next call of
+   ** send().
+   */
+   void           clearRoutes(void);
+
    void           connectToServer(const QHostAddress clServerAddressV = QHostAddress::LocalHost, 
                                   const uint16_t uwPortV = QCAN_WEB_SOCKET_DEFAULT_PORT, 
                                   const QString & clOriginR = "", const uint32_t flags = 0);
@@ -157,6 +177,34 @@ public:
    */
    int32_t        networkCount(void);
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in] ulHandleV        - Handle of route
+   ** \see       addRoute()
+   **
+   ** Remove the routing rule \a ulHandleV from the QCanServer. The command is transferred with the
+   ** next call of send().
+   */
+   void           removeRoute(const uint32_t ulHandleV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return  List of routes
+   ** \see     addRoute()
+   **
+   ** Return the routing rules of the QCanServer, including the values of the frame counters.
+   */
+   QVector<QCanRoute>   routes(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return  \c true if the commands have been sent
+   **
+   ** Send all pending commands to the QCanServer. The QCanServer answers with an updated JSON
+   ** object, see objectReceived().
+   */
+   bool           send(void);
+
 
    //---------------------------------------------------------------------------------------------------
    /*!
@@ -230,6 +278,7 @@ signals:
    **    "allowModeChange": true,
    **    "apiVersion": "1.0",
    **    "networkCount": 8,
+   **    "routes": [ ],
    **    "serverLocalTime": "2020-01-21T16:30:36",
    **    "serverUptime": 15010,
    **    "versionBuild": 0,
@@ -248,6 +297,9 @@ private:
 
    QJsonObject             clJsonServerP;
 
+   /* Stores commands send to the QCanServer class    */
+   QJsonObject             clJsonCommandP;
+
 private slots:
    void           onSocketConnect(void);
    void           onSocketDisconnect(void);
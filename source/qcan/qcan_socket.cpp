@@ -36,16 +36,26 @@
 #include "qcan_socket.hpp"
 
 
+#include <QtCore/QDeadlineTimer>
 #include <QtCore/QDebug>
 #include <QtCore/QThread>
+#include <QtCore/QtEndian>
 
 #include <QtNetwork/QNetworkInterface>
 
+#include <algorithm>
+
+#include "qcan_multicast_datagram.hpp"
+
 /*--------------------------------------------------------------------------------------------------------------------*\
 ** Definitions                                                                                                        **
 **                                                                                                                    **
 \*--------------------------------------------------------------------------------------------------------------------*/
 
+//------------------------------------------------------------------------------------------------------
+// Number of CAN frames which are read from a local socket with a single call
+//
+constexpr int32_t    RCV_BUFFER_FRAMES = 256;
 
 
 /*--------------------------------------------------------------------------------------------------------------------*\
@@ -76,13 +86,37 @@ QCanSocket::QCanSocket(QObject * pclParentV)
    //
    pclLocalSocketP.clear();
    pclWebSocketP.clear();
+   pclTcpSocketP.clear();
+   pclUdpSocketP.clear();
 
    //---------------------------------------------------------------------------------------------------
    // the socket is not connected yet and the default connection method is "local"
    //
-   btIsLocalConnectionP = true;
+   teTransportP         = eTRANSPORT_LOCAL;
    btIsConnectedP       = false;
 
+   btTcpNoDelayP        = true;
+   btTcpHandshakeP      = false;
+
+   btMulticastSyncP     = false;
+   ulMulticastSequenceP = 0;
+   ulMulticastLostP     = 0;
+   teChannelP           = QCan::eCAN_CHANNEL_NONE;
+
+   btMuxP               = false;
+   ubRcvChannelP        = 0;
+   ubTrmChannelP        = 0;
+
+   //---------------------------------------------------------------------------------------------------
+   // the merge of CAN frames in time stamp order is disabled by default
+   //
+   ulMergeWindowP       = 0;
+   ulMergeOrderP        = 0;
+   uqMergeNewestP       = 0;
+   pclMergeTimerP       = new QTimer(this);
+   pclMergeTimerP->setSingleShot(true);
+   connect(pclMergeTimerP, &QTimer::timeout, this, &QCanSocket::onMergeTimeout);
+
    //---------------------------------------------------------------------------------------------------
    // No socket errors available yet
    //
@@ -92,6 +126,36 @@ QCanSocket::QCanSocket(QObject * pclParentV)
 
    teCanStateP = QCan::eCAN_STATE_BUS_ACTIVE;
 
+   btSnapshotOnConnectP = false;
+   btSnapshotPendingP   = false;
+   btSnapshotActiveP    = false;
+   ulSnapshotCountP     = 0;
+
+   btDeliveryMonitorP   = false;
+   btDeliverySyncP      = false;
+   ulDeliverySequenceP  = 0;
+   ulDeliveryLostP      = 0;
+
+   btForwardOnChangeP   = false;
+   ulMaxSilenceP        = 0;
+
+   //---------------------------------------------------------------------------------------------------
+   // setup receive FIFO
+   //
+   ulRcvFifoSizeP     = 0;
+   ulRcvFifoMaskP     = 0;
+   ulRcvFifoHeadP     = 0;
+   ulRcvFifoTailP     = 0;
+   ulRcvFifoDropP     = 0;
+   ulRcvFifoMaxLevelP = 0;
+   teRcvFifoOverflowP = eFIFO_OVERFLOW_DROP_NEWEST;
+   setReceiveFifoSize(QCAN_SOCKET_RCV_FIFO_SIZE);
+
+   //---------------------------------------------------------------------------------------------------
+   // the receive buffer for local sockets is allocated only once
+   //
+   clReceiveDataP.resize(static_cast< int32_t >(RCV_BUFFER_FRAMES * QCAN_FRAME_ARRAY_SIZE));
+
    qRegisterMetaType<QAbstractSocket::SocketState>("QAbstractSocket::SocketState");
 }
 
@@ -104,6 +168,8 @@ QCanSocket::~QCanSocket()
 {
    delete (pclLocalSocketP);
    delete (pclWebSocketP);
+   delete (pclTcpSocketP);
+   delete (pclUdpSocketP);
 }
 
 
@@ -120,8 +186,17 @@ bool QCanSocket::connectNetwork(const QCan::CAN_Channel_e & teChannelR)
    //
    if (btIsConnectedP == false)
    {
+      //-------------------------------------------------------------------------------------------
+      // all CAN frames are tagged with the selected channel, connectNetworks() enables the
+      // multiplexed mode after this function has returned
+      //
+      teChannelP    = teChannelR;
+      ubRcvChannelP = static_cast< uint8_t >(teChannelR);
+      ubTrmChannelP = ubRcvChannelP;
+      btMuxP        = false;
+      clMuxChannelListP.clear();
 
-      if (btIsLocalConnectionP == false)
+      if (teTransportP == eTRANSPORT_WEB_SOCKET)
       {
          //-----------------------------------------------------------------------------------
          // debug information
@@ -166,6 +241,106 @@ bool QCanSocket::connectNetwork(const QCan::CAN_Channel_e & teChannelR)
             btResultT = true;
          }
       }
+      else if (teTransportP == eTRANSPORT_TCP)
+      {
+         //-----------------------------------------------------------------------------------
+         // create new raw TCP socket, the connection is established after the handshake
+         //
+         #ifndef QT_NO_DEBUG_OUTPUT
+         qDebug() << "QCanSocket::connectNetwork(" << teChannelR << ") - TcpSocket";
+         #endif
+
+         pclTcpSocketP = new QTcpSocket(this);
+
+         if (pclTcpSocketP.isNull() == false)
+         {
+            pclTcpSocketP->abort();
+            btTcpHandshakeP = true;
+
+            //---------------------------------------------------------------------------
+            // make signal / slot connection for TCP socket
+            //
+            connect( pclTcpSocketP, &QTcpSocket::connected,          this, &QCanSocket::onSocketConnectTcp);
+
+            connect( pclTcpSocketP, &QTcpSocket::disconnected,       this, &QCanSocket::onSocketDisconnect);
+
+            #if QT_VERSION > QT_VERSION_CHECK(5, 15, 0)
+            connect( pclTcpSocketP, &QTcpSocket::errorOccurred,      this, &QCanSocket::onSocketErrorTcp);
+            #else
+            connect( pclTcpSocketP, QOverload<QAbstractSocket::SocketError>::of(&QTcpSocket::error),
+                     this, &QCanSocket::onSocketErrorTcp);
+            #endif
+            connect( pclTcpSocketP, &QTcpSocket::readyRead,          this, &QCanSocket::onSocketReceiveTcp);
+
+            pclTcpSocketP->connectToHost(clServerHostAddrP, uwServerPortP);
+
+            btResultT = true;
+         }
+      }
+      else if (teTransportP == eTRANSPORT_MULTICAST)
+      {
+         //-----------------------------------------------------------------------------------
+         // create new UDP socket and join the multicast group, the port may be shared with
+         // other applications receiving the same group
+         //
+         #ifndef QT_NO_DEBUG_OUTPUT
+         qDebug() << "QCanSocket::connectNetwork(" << teChannelR << ") - UdpSocket";
+         #endif
+
+         pclUdpSocketP = new QUdpSocket(this);
+
+         if (pclUdpSocketP.isNull() == false)
+         {
+            QHostAddress      clBindAddrT;
+            QNetworkInterface clInterfaceT;
+
+            if (clServerHostAddrP.protocol() == QAbstractSocket::IPv6Protocol)
+            {
+               clBindAddrT = QHostAddress(QHostAddress::AnyIPv6);
+            }
+            else
+            {
+               clBindAddrT = QHostAddress(QHostAddress::AnyIPv4);
+            }
+
+            if (clMulticastInterfaceP.isEmpty() == false)
+            {
+               clInterfaceT = QNetworkInterface::interfaceFromName(clMulticastInterfaceP);
+            }
+
+            if (pclUdpSocketP->bind(clBindAddrT, uwServerPortP,
+                                    QAbstractSocket::ShareAddress | QAbstractSocket::ReuseAddressHint))
+            {
+               if (clInterfaceT.isValid())
+               {
+                  btResultT = pclUdpSocketP->joinMulticastGroup(clServerHostAddrP, clInterfaceT);
+               }
+               else if (clMulticastInterfaceP.isEmpty())
+               {
+                  btResultT = pclUdpSocketP->joinMulticastGroup(clServerHostAddrP);
+               }
+            }
+
+            if (btResultT == false)
+            {
+               slSocketErrorP = pclUdpSocketP->error();
+               delete (pclUdpSocketP);
+            }
+            else
+            {
+               btMulticastSyncP = false;
+               ulMulticastLostP = 0;
+
+               connect( pclUdpSocketP, &QUdpSocket::readyRead,       this, &QCanSocket::onSocketReceiveMulticast);
+
+               //---------------------------------------------------------------------------
+               // there is no connection to establish, signal connected() is emitted from
+               // the event loop like for the other socket types
+               //
+               QMetaObject::invokeMethod(this, "onSocketConnect", Qt::QueuedConnection);
+            }
+         }
+      }
       else
       {
          //-----------------------------------------------------------------------------------
@@ -216,6 +391,36 @@ bool QCanSocket::connectNetwork(const QCan::CAN_Channel_e & teChannelR)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::connectNetworks()                                                                                      //
+// connect to several CAN networks over one raw TCP connection                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanSocket::connectNetworks(const QVector<QCan::CAN_Channel_e> & clChannelListR)
+{
+   //---------------------------------------------------------------------------------------------------
+   // only the raw TCP transport supports the multiplexed connection
+   //
+   if ((btIsConnectedP == true) || (teTransportP != eTRANSPORT_TCP))
+   {
+      return (false);
+   }
+
+   if (connectNetwork(QCan::eCAN_CHANNEL_NONE) == false)
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the handshake is sent by onSocketConnectTcp() when control returns to the event loop
+   //
+   btMuxP            = true;
+   clMuxChannelListP = clChannelListR;
+   uqMergeNewestP    = 0;
+
+   return (true);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanSocket::disconnectNetwork()                                                                                    //
 //                                                                                                                    //
@@ -229,7 +434,7 @@ void QCanSocket::disconnectNetwork(void)
    qDebug() << "QCanSocket::disconnectNetwork() ";
    #endif
 
-   if (btIsLocalConnectionP == false)
+   if (teTransportP == eTRANSPORT_WEB_SOCKET)
    {
       if (pclWebSocketP.isNull() == false)
       {
@@ -237,6 +442,25 @@ void QCanSocket::disconnectNetwork(void)
          delete (pclWebSocketP);
       }
    }
+   else if (teTransportP == eTRANSPORT_TCP)
+   {
+      if (pclTcpSocketP.isNull() == false)
+      {
+         disconnect(pclTcpSocketP, nullptr, nullptr, nullptr);
+         pclTcpSocketP->disconnectFromHost();
+         delete (pclTcpSocketP);
+      }
+   }
+   else if (teTransportP == eTRANSPORT_MULTICAST)
+   {
+      if (pclUdpSocketP.isNull() == false)
+      {
+         disconnect(pclUdpSocketP, nullptr, nullptr, nullptr);
+         pclUdpSocketP->leaveMulticastGroup(clServerHostAddrP);
+         delete (pclUdpSocketP);
+      }
+      btMulticastSyncP = false;
+   }
    else
    {
       if (pclLocalSocketP.isNull() == false)
@@ -318,7 +542,116 @@ QString QCanSocket::errorString() const
 //--------------------------------------------------------------------------------------------------------------------//
 uint32_t QCanSocket::framesAvailable(void) const
 {
-   return (static_cast< uint32_t>(clReceiveFifoP.size()));
+   return (ulRcvFifoHeadP.load(std::memory_order_acquire) - ulRcvFifoTailP.load(std::memory_order_acquire));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::evaluateDeliveryStamp()                                                                                //
+// update delivery statistic                                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::evaluateDeliveryStamp(const uint8_t * pubDataV)
+{
+   uint32_t ulStampTimeT;
+   uint32_t ulSequenceT;
+   uint32_t ulGapT;
+
+   //---------------------------------------------------------------------------------------------------
+   // The CAN frames of a snapshot are taken from the frame cache of the network, their stamp refers
+   // to the original transmission. CAN frames without stamp are not evaluated.
+   //
+   if (btSnapshotActiveP)
+   {
+      return;
+   }
+
+   ulStampTimeT = qFromBigEndian<uint32_t>(pubDataV + QCAN_FRAME_DELIVERY_STAMP_POS);
+   ulSequenceT  = qFromBigEndian<uint32_t>(pubDataV + QCAN_FRAME_DELIVERY_STAMP_POS + 4);
+   if ((ulStampTimeT == 0) && (ulSequenceT == 0))
+   {
+      return;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the lower 32 bits of the monotonic clock are compared, the difference is valid up to 4.29 s
+   //
+   clDeliveryLatencyP.record(static_cast< uint32_t >(QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs()) -
+                             ulStampTimeT);
+
+   //---------------------------------------------------------------------------------------------------
+   // A gap in the sequence numbers denotes lost CAN frames. A step backwards is caused by a restart
+   // of the sequence (mode change) or by a stamp without sequence number, the sequence is
+   // synchronised again in this case.
+   //
+   if (btDeliverySyncP)
+   {
+      ulGapT = ulSequenceT - (ulDeliverySequenceP + 1);
+      if (ulGapT < 0x80000000UL)
+      {
+         ulDeliveryLostP = ulDeliveryLostP + ulGapT;
+      }
+   }
+   ulDeliverySequenceP = ulSequenceT;
+   btDeliverySyncP     = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::handleControl()                                                                                        //
+// handle control message from network                                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::handleControl(const uint8_t * pubDataV)
+{
+   uint32_t ulParamT;
+
+   switch (pubDataV[0])
+   {
+      //-------------------------------------------------------------------------------------------
+      // the snapshot starts, the following CAN frames are stored in the receive FIFO
+      //
+      case QCAN_CONTROL_SNAPSHOT_BEGIN:
+         btSnapshotPendingP = false;
+         btSnapshotActiveP  = true;
+         ulSnapshotCountP   = qFromBigEndian<uint32_t>(pubDataV + 4);
+         break;
+
+      case QCAN_CONTROL_SNAPSHOT_END:
+         btSnapshotActiveP  = false;
+         emit snapshotReceived(ulSnapshotCountP);
+         break;
+
+      //-------------------------------------------------------------------------------------------
+      // the following CAN frames of a multiplexed connection belong to the selected channel
+      //
+      case QCAN_CONTROL_CHANNEL_SELECT:
+         if (btMuxP)
+         {
+            ulParamT      = qFromBigEndian<uint32_t>(pubDataV + 4);
+            ubRcvChannelP = (ulParamT <= QCAN_NETWORK_LIMIT) ? static_cast< uint8_t >(ulParamT) : 0;
+         }
+         break;
+
+      default:
+
+         break;
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::isMergeEntryLater()                                                                                    //
+// compare entries of the merge heap                                                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanSocket::isMergeEntryLater(const MergeEntry_ts & tsEntryR, const MergeEntry_ts & tsOtherR)
+{
+   //---------------------------------------------------------------------------------------------------
+   // CAN frames with equal time stamp keep the order of arrival
+   //
+   if (tsEntryR.uqTime != tsOtherR.uqTime)
+   {
+      return (tsEntryR.uqTime > tsOtherR.uqTime);
+   }
+   return (tsEntryR.ulOrder > tsOtherR.ulOrder);
 }
 
 
@@ -342,6 +675,19 @@ void QCanSocket::onDisconnectNetwork(void)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::onMergeTimeout()                                                                                       //
+// no CAN frame received within merge window                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::onMergeTimeout(void)
+{
+   if (releaseMergeFrames(true) == true)
+   {
+      emit readyRead();
+   }
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanSocket::onSocketConnect()                                                                                      //
 //                                                                                                                    //
@@ -359,10 +705,66 @@ void QCanSocket::onSocketConnect(void)
    // send signal about connection state and keep it in local variable
    //
    btIsConnectedP = true;
+
+   //---------------------------------------------------------------------------------------------------
+   // The forwarding mode must be selected before a snapshot is requested, so the snapshot is
+   // taken as last forwarded values. A multicast connection can't send control messages, a
+   // multiplexed connection only evaluates the channel selection.
+   //
+   if ((teTransportP != eTRANSPORT_MULTICAST) && (btMuxP == false))
+   {
+      if (btForwardOnChangeP)
+      {
+         writeControl(QCAN_CONTROL_FORWARD_MODE, 1, ulMaxSilenceP);
+      }
+      if (btSnapshotOnConnectP)
+      {
+         requestSnapshot();
+      }
+   }
    emit connected();
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::onSocketConnectTcp()                                                                                   //
+// send handshake on raw TCP socket                                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::onSocketConnectTcp(void)
+{
+   //---------------------------------------------------------------------------------------------------
+   // debug information
+   //
+   #ifndef QT_NO_DEBUG_OUTPUT
+   qDebug() << "QCanSocket::onSocketConnectTcp() ";
+   #endif
+
+   //---------------------------------------------------------------------------------------------------
+   // select the CAN channel, the connection is established when the server confirms the channel
+   // inside onSocketReceiveTcp()
+   //
+   pclTcpSocketP->setSocketOption(QAbstractSocket::LowDelayOption, btTcpNoDelayP ? 1 : 0);
+   if (btMuxP)
+   {
+      QByteArray  clLineT = "MUX";
+
+      if (clMuxChannelListP.isEmpty())
+      {
+         clLineT += " *";
+      }
+      for (int32_t slIdxT = 0; slIdxT < clMuxChannelListP.size(); slIdxT++)
+      {
+         clLineT += " " + QByteArray::number(static_cast< int32_t >(clMuxChannelListP.at(slIdxT)));
+      }
+      pclTcpSocketP->write(clLineT + "\n");
+   }
+   else
+   {
+      pclTcpSocketP->write("CAN " + QByteArray::number(static_cast< int32_t >(teChannelP)) + "\n");
+   }
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanSocket::onSocketDisconnect()                                                                                   //
 //                                                                                                                    //
@@ -379,7 +781,16 @@ void QCanSocket::onSocketDisconnect(void)
    //---------------------------------------------------------------------------------------------------
    // send signal about connection state and keep it in local variable
    //
-   btIsConnectedP = false;
+   btIsConnectedP     = false;
+   btSnapshotPendingP = false;
+   btSnapshotActiveP  = false;
+   btDeliverySyncP    = false;
+
+   //---------------------------------------------------------------------------------------------------
+   // CAN frames held back for the merge are passed to the receive FIFO
+   //
+   pclMergeTimerP->stop();
+   releaseMergeFrames(true);
    emit disconnected();
 }
 
@@ -471,125 +882,605 @@ void QCanSocket::onSocketErrorWeb(QAbstractSocket::SocketError teSocketErrorV)
 
 
 //--------------------------------------------------------------------------------------------------------------------//
-// QCanSocket::onSocketReceiveLocal()                                                                                 //
-//                                                                                                                    //
+// QCanSocket::onSocketErrorTcp()                                                                                     //
+// handle error conditions of raw TCP socket                                                                          //
 //--------------------------------------------------------------------------------------------------------------------//
-void QCanSocket::onSocketReceiveLocal(void)
+void QCanSocket::onSocketErrorTcp(QAbstractSocket::SocketError teSocketErrorV)
 {
-   uint32_t    ulFrameCountT;
-   bool        btValidFrameT     = false;
-   bool        btSignalNewFrameT = false;
+   //---------------------------------------------------------------------------------------------------
+   // debug information
+   //
+   #ifndef QT_NO_DEBUG_OUTPUT
+   qDebug() << "QCanSocket::onSocketErrorTcp()   -" << teSocketErrorV;
+   #endif
 
-   ulFrameCountT = static_cast< uint32_t >(pclLocalSocketP->bytesAvailable()) / QCAN_FRAME_ARRAY_SIZE;
-   while (ulFrameCountT)
+   switch(teSocketErrorV)
    {
-      clReceiveDataP = pclLocalSocketP->read(QCAN_FRAME_ARRAY_SIZE);
-      btValidFrameT  = clReceiveFrameP.fromByteArray(clReceiveDataP);
-      if (btValidFrameT)
-      {
-         //-----------------------------------------------------------------------------------
-         // Store frame in FIFO
-         //
-         clReceiveMutexP.lock();
-         clReceiveFifoP.enqueue(clReceiveFrameP);
-         btSignalNewFrameT = true;
-         clReceiveMutexP.unlock();
+      //-------------------------------------------------------------------------------------------
+      // abort all operations, the signal disconnected() is emitted by onSocketDisconnect()
+      //
+      case QAbstractSocket::RemoteHostClosedError:
+      case QAbstractSocket::NetworkError:
+      case QAbstractSocket::ConnectionRefusedError:
+      case QAbstractSocket::UnknownSocketError:
+         pclTcpSocketP->abort();
+         btIsConnectedP = false;
+         break;
 
-         //-----------------------------------------------------------------------------------
-         // If the frame type is an error frame, store the for the actual CAN state
-         //
-         if (clReceiveFrameP.frameType() == QCanFrame::eFRAME_TYPE_ERROR)
-         {
-            teCanStateP = clReceiveFrameP.errorState();
-         }
-      }
+      default:
 
-      ulFrameCountT--;
+         break;
    }
 
-
    //---------------------------------------------------------------------------------------------------
-   // Emit signal only once when new data arrived. The flag 'btReceiveSignalSendP' is cleared inside
-   // the read() method.
+   // store socket error and send signal
    //
-   if (btSignalNewFrameT == true)
-   {
-      emit readyRead();
-   }
+   slSocketErrorP = teSocketErrorV;
+   emit errorOccurred(teSocketErrorV);
 }
 
 
 //--------------------------------------------------------------------------------------------------------------------//
-// QCanSocket::onSocketReceiveWeb()                                                                                   //
+// QCanSocket::onSocketReceiveLocal()                                                                                 //
 //                                                                                                                    //
 //--------------------------------------------------------------------------------------------------------------------//
-void QCanSocket::onSocketReceiveWeb(const QByteArray &clMessageR)
+void QCanSocket::onSocketReceiveLocal(void)
 {
-   bool        btValidFrameT     = false;
-   bool        btSignalNewFrameT = false;
+   receiveStream(pclLocalSocketP);
+}
 
-   btValidFrameT  = clReceiveFrameP.fromByteArray(clMessageR);
-   if (btValidFrameT)
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::onSocketReceiveMulticast()                                                                             //
+// read CAN frames from multicast group                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::onSocketReceiveMulticast(void)
+{
+   int64_t           sqSizeT;
+   uint32_t          ulCountT;
+   uint32_t          ulSequenceT;
+   const uint8_t *   pubDataT;
+   bool              btSignalNewFrameT = false;
+
+   while ((pclUdpSocketP.isNull() == false) && (pclUdpSocketP->hasPendingDatagrams()))
    {
-      //-----------------------------------------------------------------------------------
-      // Store frame in FIFO
+      sqSizeT  = pclUdpSocketP->readDatagram(clReceiveDataP.data(), clReceiveDataP.size());
+      pubDataT = reinterpret_cast< const uint8_t * >(clReceiveDataP.constData());
+
+      //-------------------------------------------------------------------------------------------
+      // check the datagram header, datagrams of other CAN channels sharing the same multicast
+      // group are silently dropped
       //
-      clReceiveMutexP.lock();
-      clReceiveFifoP.enqueue(clReceiveFrameP);
-      btSignalNewFrameT = true;
-      clReceiveMutexP.unlock();
+      if (QCanMulticastDatagram::parse(pubDataT, sqSizeT, static_cast< uint8_t >(teChannelP),
+                                       ulCountT, ulSequenceT) == false)
+      {
+         continue;
+      }
 
-      //-----------------------------------------------------------------------------------
-      // If the frame type is an error frame, store the for the actual CAN state
+      //-------------------------------------------------------------------------------------------
+      // The sequence number is counted per CAN frame, so a gap is the number of CAN frames lost
+      // inside the network (including datagrams which have been reordered).
       //
-      if (clReceiveFrameP.frameType() == QCanFrame::eFRAME_TYPE_ERROR)
+      if (btMulticastSyncP && (ulSequenceT != ulMulticastSequenceP))
       {
-         teCanStateP = clReceiveFrameP.errorState();
+         ulMulticastLostP += (ulSequenceT - ulMulticastSequenceP);
+      }
+      btMulticastSyncP     = true;
+      ulMulticastSequenceP = ulSequenceT + ulCountT;
+
+      for (pubDataT += QCAN_MULTICAST_HEADER_SIZE; ulCountT > 0; ulCountT--)
+      {
+         if (receiveFrame(pubDataT) == true)
+         {
+            btSignalNewFrameT = true;
+         }
+         pubDataT += QCAN_FRAME_ARRAY_SIZE;
       }
    }
 
-   //---------------------------------------------------------------------------------------------------
-   // Emit signal only once when new data arrived. The flag 'btReceiveSignalSendP' is cleared inside
-   // the read() method.
-   //
-   if (btSignalNewFrameT == true) 
+   if (btSignalNewFrameT == true)
    {
       emit readyRead();
    }
-
 }
 
 
 //--------------------------------------------------------------------------------------------------------------------//
-// QCanSocket::onWriteFrame()                                                                                         //
+// QCanSocket::onSocketReceiveTcp()                                                                                   //
 //                                                                                                                    //
 //--------------------------------------------------------------------------------------------------------------------//
-void QCanSocket::onWriteFrame(QCanFrame clFrameV)
+void QCanSocket::onSocketReceiveTcp(void)
+{
+   QByteArray  clLineT;
+
+   //---------------------------------------------------------------------------------------------------
+   // The server answers the handshake with "OK <channel>", the CAN frames may directly follow
+   // the line feed. On a multiplexed connection the line holds all channels which have been
+   // attached by the server.
+   //
+   if (btTcpHandshakeP)
+   {
+      if (pclTcpSocketP->canReadLine() == false)
+      {
+         if (pclTcpSocketP->bytesAvailable() >= QCAN_TCP_HANDSHAKE_SIZE)
+         {
+            onSocketErrorTcp(QAbstractSocket::UnknownSocketError);
+         }
+         return;
+      }
+
+      clLineT = pclTcpSocketP->readLine(QCAN_TCP_HANDSHAKE_SIZE).trimmed();
+      if (clLineT.startsWith("OK") == false)
+      {
+         #ifndef QT_NO_DEBUG_OUTPUT
+         qDebug() << "QCanSocket::onSocketReceiveTcp() -" << clLineT;
+         #endif
+
+         onSocketErrorTcp(QAbstractSocket::ConnectionRefusedError);
+         return;
+      }
+
+      if (btMuxP)
+      {
+         QList<QByteArray> clTokenListT = clLineT.simplified().split(' ');
+
+         clMuxChannelListP.clear();
+         for (int32_t slIdxT = 1; slIdxT < clTokenListT.size(); slIdxT++)
+         {
+            clMuxChannelListP.append(static_cast< QCan::CAN_Channel_e >(clTokenListT.at(slIdxT).toInt()));
+         }
+         ubRcvChannelP = 0;
+         ubTrmChannelP = 0;
+      }
+
+      btTcpHandshakeP = false;
+      onSocketConnect();
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the socket may have been closed by a slot connected to the signal connected()
+   //
+   if (pclTcpSocketP.isNull() == false)
+   {
+      receiveStream(pclTcpSocketP);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::onSocketReceiveWeb()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::onSocketReceiveWeb(const QByteArray &clMessageR)
+{
+   bool        btValidFrameT     = false;
+   bool        btSignalNewFrameT = false;
+
+   //---------------------------------------------------------------------------------------------------
+   // check for control message first
+   //
+   if ((clMessageR.size() == QCAN_FRAME_ARRAY_SIZE) &&
+       (static_cast< uint8_t >(clMessageR.at(QCAN_FRAME_ARRAY_SIZE - 1)) == QCAN_CONTROL_MARKER))
+   {
+      handleControl(reinterpret_cast< const uint8_t * >(clMessageR.constData()));
+      return;
+   }
+
+   btValidFrameT  = clReceiveFrameP.fromByteArray(clMessageR);
+   if (btValidFrameT)
+   {
+      if (btDeliveryMonitorP)
+      {
+         evaluateDeliveryStamp(reinterpret_cast< const uint8_t * >(clMessageR.constData()));
+      }
+
+      //-----------------------------------------------------------------------------------
+      // Store frame in FIFO, data frames are part of a pending snapshot
+      //
+      if ((btSnapshotPendingP == false) || (clReceiveFrameP.frameType() != QCanFrame::eFRAME_TYPE_DATA))
+      {
+         if (pushReceiveFifo(clReceiveFrameP, ubRcvChannelP) == true)
+         {
+            btSignalNewFrameT = true;
+         }
+      }
+
+      //-----------------------------------------------------------------------------------
+      // If the frame type is an error frame, store the for the actual CAN state
+      //
+      if (clReceiveFrameP.frameType() == QCanFrame::eFRAME_TYPE_ERROR)
+      {
+         teCanStateP = clReceiveFrameP.errorState();
+      }
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // Emit signal only once when new data arrived. The flag 'btReceiveSignalSendP' is cleared inside
+   // the read() method.
+   //
+   if (btSignalNewFrameT == true) 
+   {
+      emit readyRead();
+   }
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::onWriteFrame()                                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::onWriteFrame(QCanFrame clFrameV)
 {
    this->write(clFrameV);
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::pushReceiveFifo()                                                                                      //
+// store a CAN frame in the receive FIFO, this method is only called by the thread owning the socket                  //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanSocket::pushReceiveFifo(const QCanFrame & clFrameR, const uint8_t ubChannelV)
+{
+   uint32_t ulHeadT  = ulRcvFifoHeadP.load(std::memory_order_relaxed);
+   uint32_t ulTailT  = ulRcvFifoTailP.load(std::memory_order_acquire);
+   uint32_t ulSlotT  = ulHeadT & ulRcvFifoMaskP;
+   uint32_t ulLevelT;
+
+   if ((ulHeadT - ulTailT) >= ulRcvFifoSizeP)
+   {
+      if (teRcvFifoOverflowP == eFIFO_OVERFLOW_DROP_NEWEST)
+      {
+         ulRcvFifoDropP.fetch_add(1, std::memory_order_relaxed);
+         return (false);
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Discard the oldest frame by advancing the tail index, the oldest frame is stored in the
+      // slot of the head index. If the exchange succeeds the slot is owned by the writer, if it
+      // fails the reader has claimed the slot.
+      //
+      if (ulRcvFifoTailP.compare_exchange_strong(ulTailT, ulTailT + 1, std::memory_order_acq_rel))
+      {
+         ulRcvFifoDropP.fetch_add(1, std::memory_order_relaxed);
+         aulRcvFifoSeqP[ulSlotT].store(ulHeadT, std::memory_order_relaxed);
+      }
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // The slot may still be copied by the reader: the new frame is discarded then, the slot must
+   // not be written.
+   //
+   if (aulRcvFifoSeqP[ulSlotT].load(std::memory_order_acquire) != ulHeadT)
+   {
+      ulRcvFifoDropP.fetch_add(1, std::memory_order_relaxed);
+      return (false);
+   }
+
+   clRcvFifoP[static_cast< int32_t >(ulSlotT)] = clFrameR;
+   clRcvFifoChannelP[static_cast< int32_t >(ulSlotT)] = ubChannelV;
+   aulRcvFifoSeqP[ulSlotT].store(ulHeadT + 1, std::memory_order_relaxed);
+   ulRcvFifoHeadP.store(ulHeadT + 1, std::memory_order_release);
+
+   //---------------------------------------------------------------------------------------------------
+   // update high-watermark
+   //
+   ulLevelT = ulHeadT + 1 - ulRcvFifoTailP.load(std::memory_order_relaxed);
+   if (ulLevelT > ulRcvFifoMaxLevelP.load(std::memory_order_relaxed))
+   {
+      ulRcvFifoMaxLevelP.store(ulLevelT, std::memory_order_relaxed);
+   }
+
+   return (true);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanSocket::read()                                                                                                 //
 //                                                                                                                    //
 //--------------------------------------------------------------------------------------------------------------------//
 bool QCanSocket::read(QCanFrame & clFrameR)
 {
-   bool btResultT = false;
+   return (readFrames(&clFrameR, 1) == 1);
+}
 
-   clReceiveMutexP.lock();
-   if (clReceiveFifoP.size() > 0)
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::read()                                                                                                 //
+// read CAN frame together with its CAN channel                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanSocket::read(QCanFrame & clFrameR, QCan::CAN_Channel_e & teChannelR)
+{
+   return (readFrames(&clFrameR, 1, &teChannelR) == 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::readFrames()                                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanSocket::readFrames(QCanFrame * pclBufferV, const uint32_t ulMaxV, QCan::CAN_Channel_e * pteChannelV)
+{
+   uint32_t ulCountT = 0;
+   uint32_t ulHeadT;
+   uint32_t ulTailT;
+   uint32_t ulBatchT;
+   uint32_t ulIdxT;
+   uint32_t ulSlotT;
+
+   if (pclBufferV == nullptr)
    {
-      clFrameR = clReceiveFifoP.dequeue();         // read message from queue
-      btResultT = true;                            // message has been updated
+      return (0);
+   }
+
+   while (ulCountT < ulMaxV)
+   {
+      ulTailT  = ulRcvFifoTailP.load(std::memory_order_acquire);
+      ulHeadT  = ulRcvFifoHeadP.load(std::memory_order_acquire);
+      ulBatchT = qMin(ulHeadT - ulTailT, ulMaxV - ulCountT);
+      if (ulBatchT == 0)
+      {
+         break;
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Claim the slots of the batch before they are copied. The exchange can only fail in mode
+      // eFIFO_OVERFLOW_DROP_OLDEST when the writer discarded a frame meanwhile, the batch is
+      // evaluated again then.
+      //
+      if (ulRcvFifoTailP.compare_exchange_strong(ulTailT, ulTailT + ulBatchT, std::memory_order_acq_rel) == false)
+      {
+         continue;
+      }
+
+      for (ulIdxT = 0; ulIdxT < ulBatchT; ulIdxT++)
+      {
+         ulSlotT = (ulTailT + ulIdxT) & ulRcvFifoMaskP;
+         pclBufferV[ulCountT + ulIdxT] = clRcvFifoP.at(static_cast< int32_t >(ulSlotT));
+         if (pteChannelV != nullptr)
+         {
+            pteChannelV[ulCountT + ulIdxT] = static_cast< QCan::CAN_Channel_e >(
+                                                      clRcvFifoChannelP.at(static_cast< int32_t >(ulSlotT)));
+         }
+
+         //-----------------------------------------------------------------------------------
+         // hand the slot back to the writer
+         //
+         aulRcvFifoSeqP[ulSlotT].store(ulTailT + ulIdxT + ulRcvFifoSizeP, std::memory_order_release);
+      }
+
+      ulCountT += ulBatchT;
+   }
+
+   return (ulCountT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::receiveFrame()                                                                                         //
+// evaluate one CAN frame or control message                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanSocket::receiveFrame(const uint8_t * pubDataV)
+{
+   bool  btResultT = false;
+
+   if (pubDataV[QCAN_FRAME_ARRAY_SIZE - 1] == QCAN_CONTROL_MARKER)
+   {
+      handleControl(pubDataV);
+   }
+   else if (clReceiveFrameP.fromRawData(pubDataV))
+   {
+      //-------------------------------------------------------------------------------------------
+      // the delivery stamp of a multicast datagram or a multiplexed connection carries no sequence
+      // number for this socket
+      //
+      if (btDeliveryMonitorP && (teTransportP != eTRANSPORT_MULTICAST) && (btMuxP == false))
+      {
+         evaluateDeliveryStamp(pubDataV);
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // Store frame in FIFO, data frames are part of a pending snapshot
+      //
+      if ((btSnapshotPendingP == false) || (clReceiveFrameP.frameType() != QCanFrame::eFRAME_TYPE_DATA))
+      {
+         if (btMuxP && (ulMergeWindowP > 0))
+         {
+            stageMergeFrame(clReceiveFrameP, ubRcvChannelP);
+         }
+         else
+         {
+            btResultT = pushReceiveFifo(clReceiveFrameP, ubRcvChannelP);
+         }
+      }
+
+      //-------------------------------------------------------------------------------------------
+      // If the frame type is an error frame, store the for the actual CAN state
+      //
+      if (clReceiveFrameP.frameType() == QCanFrame::eFRAME_TYPE_ERROR)
+      {
+         teCanStateP = clReceiveFrameP.errorState();
+      }
    }
-   clReceiveMutexP.unlock();
 
    return (btResultT);
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::receiveStream()                                                                                        //
+// read CAN frames from local socket or raw TCP socket                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::receiveStream(QIODevice * pclSocketV)
+{
+   int64_t           sqSizeT;
+   int64_t           sqPosT;
+   const uint8_t *   pubDataT;
+   bool              btSignalNewFrameT = false;
+
+   //---------------------------------------------------------------------------------------------------
+   // Read all complete frames in blocks of RCV_BUFFER_FRAMES into the receive buffer, which has been
+   // allocated in the constructor. A partial frame remains inside the socket until the next
+   // readyRead() signal.
+   //
+   sqSizeT = (pclSocketV->bytesAvailable() / QCAN_FRAME_ARRAY_SIZE) * QCAN_FRAME_ARRAY_SIZE;
+   while (sqSizeT > 0)
+   {
+      sqSizeT  = qMin(sqSizeT, static_cast< int64_t >(clReceiveDataP.size()));
+      sqSizeT  = pclSocketV->read(clReceiveDataP.data(), sqSizeT);
+      if (sqSizeT <= 0)
+      {
+         break;
+      }
+      pubDataT = reinterpret_cast< const uint8_t * >(clReceiveDataP.constData());
+
+      for (sqPosT = 0; (sqPosT + QCAN_FRAME_ARRAY_SIZE) <= sqSizeT; sqPosT += QCAN_FRAME_ARRAY_SIZE)
+      {
+         if (receiveFrame(pubDataT + sqPosT) == true)
+         {
+            btSignalNewFrameT = true;
+         }
+      }
+
+      sqSizeT = (pclSocketV->bytesAvailable() / QCAN_FRAME_ARRAY_SIZE) * QCAN_FRAME_ARRAY_SIZE;
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // Release the CAN frames which are older than the merge window, the remaining CAN frames are
+   // released by onMergeTimeout() if no further CAN frame is received.
+   //
+   if (clMergeHeapP.isEmpty() == false)
+   {
+      if (releaseMergeFrames(false) == true)
+      {
+         btSignalNewFrameT = true;
+      }
+      if (clMergeHeapP.isEmpty() == false)
+      {
+         pclMergeTimerP->start(static_cast< int32_t >(ulMergeWindowP));
+      }
+   }
+
+
+   //---------------------------------------------------------------------------------------------------
+   // Emit signal only once when new data arrived. The flag 'btReceiveSignalSendP' is cleared inside
+   // the read() method.
+   //
+   if (btSignalNewFrameT == true)
+   {
+      emit readyRead();
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::releaseMergeFrames()                                                                                   //
+// pass CAN frames from merge heap to receive FIFO                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanSocket::releaseMergeFrames(const bool btFlushV)
+{
+   bool  btResultT = false;
+
+   //---------------------------------------------------------------------------------------------------
+   // the heap is ordered by time stamp, so the oldest CAN frame is always at the front
+   //
+   while (clMergeHeapP.isEmpty() == false)
+   {
+      const MergeEntry_ts & tsEntryT = clMergeHeapP.first();
+
+      if ((btFlushV == false) &&
+          ((tsEntryT.uqTime + (static_cast< uint64_t >(ulMergeWindowP) * 1000000)) > uqMergeNewestP))
+      {
+         break;
+      }
+
+      if (pushReceiveFifo(tsEntryT.clFrame, tsEntryT.ubChannel) == true)
+      {
+         btResultT = true;
+      }
+      std::pop_heap(clMergeHeapP.begin(), clMergeHeapP.end(), isMergeEntryLater);
+      clMergeHeapP.removeLast();
+   }
+
+   return (btResultT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::requestSnapshot()                                                                                      //
+// request snapshot of frame cache from network                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanSocket::requestSnapshot(void)
+{
+   //---------------------------------------------------------------------------------------------------
+   // the flag must be set before the request is sent
+   //
+   btSnapshotPendingP = true;
+   if (writeControl(QCAN_CONTROL_SNAPSHOT_REQUEST, 0, 0) == false)
+   {
+      btSnapshotPendingP = false;
+      return (false);
+   }
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::resetDeliveryStatistic()                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::resetDeliveryStatistic(void)
+{
+   clDeliveryLatencyP.clear();
+   ulDeliveryLostP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::resetFifoStatistic()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::resetFifoStatistic(void)
+{
+   ulRcvFifoDropP.store(0);
+   ulRcvFifoMaxLevelP.store(framesAvailable());
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::setDeliveryMonitor()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::setDeliveryMonitor(const bool btEnableV)
+{
+   if (btEnableV && (btDeliveryMonitorP == false))
+   {
+      resetDeliveryStatistic();
+      btDeliverySyncP = false;
+   }
+   btDeliveryMonitorP = btEnableV;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::setForwardOnChange()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanSocket::setForwardOnChange(const bool btEnableV, const uint32_t ulMaxSilenceV)
+{
+   btForwardOnChangeP = btEnableV;
+   ulMaxSilenceP      = ulMaxSilenceV;
+
+   if (btIsConnectedP == false)
+   {
+      return (true);
+   }
+
+   return (writeControl(QCAN_CONTROL_FORWARD_MODE, btEnableV ? 1 : 0, ulMaxSilenceV));
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanSocket::setHostAddress()                                                                                       //
 //                                                                                                                    //
@@ -603,16 +1494,128 @@ void QCanSocket::setHostAddress(QHostAddress clHostAddressV, uint16_t uwPortV)
 
       if (clHostAddressV == QHostAddress::LocalHost)
       {
-         btIsLocalConnectionP = true;
+         teTransportP = eTRANSPORT_LOCAL;
       }
       else
       {
-         btIsLocalConnectionP = false;
+         teTransportP = eTRANSPORT_WEB_SOCKET;
       }
    }
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::setMergeWindow()                                                                                       //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanSocket::setMergeWindow(const uint32_t ulWindowV)
+{
+   if (btIsConnectedP == true)
+   {
+      return (false);
+   }
+
+   ulMergeWindowP = ulWindowV;
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::setMulticastGroup()                                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::setMulticastGroup(const QHostAddress clGroupV, const uint16_t uwPortV,
+                                   const QString & clInterfaceR)
+{
+   if (btIsConnectedP == false)
+   {
+      clServerHostAddrP     = clGroupV;
+      uwServerPortP         = uwPortV;
+      clMulticastInterfaceP = clInterfaceR;
+      teTransportP          = eTRANSPORT_MULTICAST;
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::setReceiveFifoSize()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanSocket::setReceiveFifoSize(const uint32_t ulSizeV)
+{
+   uint32_t ulSizeT = 1;
+
+   if ((btIsConnectedP == true) || (ulSizeV == 0) || (ulSizeV > 0x00100000))
+   {
+      return (false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // round up to next power of 2, so the FIFO index can be masked
+   //
+   while (ulSizeT < ulSizeV)
+   {
+      ulSizeT = ulSizeT << 1;
+   }
+
+   clRcvFifoP.clear();
+   clRcvFifoP.resize(static_cast< int32_t >(ulSizeT));
+   clRcvFifoChannelP.fill(0, static_cast< int32_t >(ulSizeT));
+   aulRcvFifoSeqP.reset(new std::atomic<uint32_t>[ulSizeT]);
+   for (uint32_t ulSlotT = 0; ulSlotT < ulSizeT; ulSlotT++)
+   {
+      aulRcvFifoSeqP[ulSlotT].store(ulSlotT);
+   }
+   ulRcvFifoSizeP = ulSizeT;
+   ulRcvFifoMaskP = ulSizeT - 1;
+   ulRcvFifoHeadP.store(0);
+   ulRcvFifoTailP.store(0);
+   ulRcvFifoMaxLevelP.store(0);
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::setTcpHostAddress()                                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::setTcpHostAddress(QHostAddress clHostAddressV, uint16_t uwPortV)
+{
+   if (btIsConnectedP == false)
+   {
+      clServerHostAddrP = clHostAddressV;
+      uwServerPortP     = uwPortV;
+      teTransportP      = eTRANSPORT_TCP;
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::stageMergeFrame()                                                                                      //
+// hold back CAN frame for the merge in time stamp order                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanSocket::stageMergeFrame(const QCanFrame & clFrameR, const uint8_t ubChannelV)
+{
+   MergeEntry_ts  tsEntryT;
+
+   tsEntryT.clFrame   = clFrameR;
+   tsEntryT.uqTime    = (static_cast< uint64_t >(clFrameR.timeStamp().seconds()) * 1000000000) +
+                        clFrameR.timeStamp().nanoSeconds();
+   tsEntryT.ulOrder   = ulMergeOrderP++;
+   tsEntryT.ubChannel = ubChannelV;
+
+   clMergeHeapP.append(tsEntryT);
+   std::push_heap(clMergeHeapP.begin(), clMergeHeapP.end(), isMergeEntryLater);
+
+   if (tsEntryT.uqTime > uqMergeNewestP)
+   {
+      uqMergeNewestP = tsEntryT.uqTime;
+   }
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // QCanSocket::write()                                                                                                //
 //                                                                                                                    //
@@ -621,11 +1624,14 @@ bool QCanSocket::write(const QCanFrame & clFrameR)
 {
    bool  btResultT = false;
 
-   if (btIsConnectedP == true)
+   //---------------------------------------------------------------------------------------------------
+   // a multicast connection is receive only
+   //
+   if ((btIsConnectedP == true) && (teTransportP != eTRANSPORT_MULTICAST))
    {
       QByteArray  clDatagramT = clFrameR.toByteArray();
 
-      if (btIsLocalConnectionP == false)
+      if (teTransportP == eTRANSPORT_WEB_SOCKET)
       {
          if (pclWebSocketP->sendBinaryMessage(clDatagramT) == QCAN_FRAME_ARRAY_SIZE)
          {
@@ -633,6 +1639,16 @@ bool QCanSocket::write(const QCanFrame & clFrameR)
             btResultT = true;
          }
       }
+      else if (teTransportP == eTRANSPORT_TCP)
+      {
+         //-----------------------------------------------------------------------------------
+         // the TCP socket is not flushed, so consecutive CAN frames are sent in one segment
+         //
+         if (pclTcpSocketP->write(clDatagramT) == QCAN_FRAME_ARRAY_SIZE)
+         {
+            btResultT = true;
+         }
+      }
       else
       {
          if (pclLocalSocketP->write(clDatagramT) == QCAN_FRAME_ARRAY_SIZE)
@@ -647,3 +1663,89 @@ bool QCanSocket::write(const QCanFrame & clFrameR)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::write()                                                                                                //
+// write CAN frame to selected CAN channel                                                                            //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanSocket::write(const QCanFrame & clFrameR, const QCan::CAN_Channel_e teChannelV)
+{
+   if (btMuxP == false)
+   {
+      return ((teChannelV == teChannelP) && write(clFrameR));
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the channel select message is only required if the channel changes
+   //
+   if (static_cast< uint8_t >(teChannelV) != ubTrmChannelP)
+   {
+      if (writeControl(QCAN_CONTROL_CHANNEL_SELECT, 0, static_cast< uint32_t >(teChannelV)) == false)
+      {
+         return (false);
+      }
+      ubTrmChannelP = static_cast< uint8_t >(teChannelV);
+   }
+
+   return (write(clFrameR));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanSocket::writeControl()                                                                                         //
+// write control message to network                                                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanSocket::writeControl(const uint8_t ubCommandV, const uint8_t ubModeV, const uint32_t ulParamV)
+{
+   bool  btResultT = false;
+
+   //---------------------------------------------------------------------------------------------------
+   // a multicast connection is receive only, a multiplexed connection only evaluates the channel
+   // selection
+   //
+   if ((btMuxP == true) && (ubCommandV != QCAN_CONTROL_CHANNEL_SELECT))
+   {
+      return (false);
+   }
+
+   if ((btIsConnectedP == true) && (teTransportP != eTRANSPORT_MULTICAST))
+   {
+      QByteArray  clDatagramT(QCAN_FRAME_ARRAY_SIZE, 0);
+
+      clDatagramT[0]  = static_cast< char >(ubCommandV);
+      clDatagramT[1]  = static_cast< char >(ubModeV);
+      qToBigEndian<uint32_t>(ulParamV, reinterpret_cast< uint8_t * >(clDatagramT.data()) + 4);
+      clDatagramT[94] = static_cast< char >(0xCA);
+      clDatagramT[95] = static_cast< char >(QCAN_CONTROL_MARKER);
+
+      if (teTransportP == eTRANSPORT_WEB_SOCKET)
+      {
+         if (pclWebSocketP->sendBinaryMessage(clDatagramT) == QCAN_FRAME_ARRAY_SIZE)
+         {
+            pclWebSocketP->flush();
+            btResultT = true;
+         }
+      }
+      else if (teTransportP == eTRANSPORT_TCP)
+      {
+         //-----------------------------------------------------------------------------------
+         // the TCP socket is not flushed, so consecutive CAN frames are sent in one segment
+         //
+         if (pclTcpSocketP->write(clDatagramT) == QCAN_FRAME_ARRAY_SIZE)
+         {
+            btResultT = true;
+         }
+      }
+      else
+      {
+         if (pclLocalSocketP->write(clDatagramT) == QCAN_FRAME_ARRAY_SIZE)
+         {
+            pclLocalSocketP->flush();
+            btResultT = true;
+         }
+      }
+   }
+
+   return (btResultT);
+}
+
+
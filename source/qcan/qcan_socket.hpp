@@ -31,21 +31,26 @@
 #ifndef QCAN_SOCKET_HPP_
 #define QCAN_SOCKET_HPP_
 
-#include <QtCore/QMutex>
 #include <QtCore/QPointer>
-#include <QtCore/QQueue>
 #include <QtCore/QString>
+#include <QtCore/QTimer>
 #include <QtCore/QUuid>
 #include <QtCore/QVector>
 
 #include <QtNetwork/QHostAddress>
 #include <QtNetwork/QLocalSocket>
+#include <QtNetwork/QTcpSocket>
+#include <QtNetwork/QUdpSocket>
 
 #include <QtWebSockets/QWebSocket>
 
 #include "qcan_defs.hpp"
 #include "qcan_filter_list.hpp"
 #include "qcan_frame.hpp"
+#include "qcan_latency_histogram.hpp"
+
+#include <atomic>
+#include <memory> // needed by std::unique_ptr<std::atomic<uint32_t>[]>
 
 
 
@@ -54,13 +59,19 @@
 ** \class QCanSocket
 ** \brief CAN socket
 ** 
-** A QCanSocket is used for connection to an existing QCanNetwork. Connection can be made eiter via LocalSockets
-** or WebSockets. The number of either socket type that can be connected to a QCanNetwork is limited by the 
-** symbols #QCAN_LOCAL_SOCKET_MAX and #QCAN_WEB_SOCKET_MAX during compile time.
+** A QCanSocket is used for connection to an existing QCanNetwork. Connection can be made eiter via LocalSockets,
+** WebSockets or raw TCP sockets (see transport()). The number of each socket type that can be connected to a
+** QCanNetwork is limited by the symbols #QCAN_LOCAL_SOCKET_MAX, #QCAN_WEB_SOCKET_MAX and #QCAN_TCP_SOCKET_MAX
+** during compile time. A socket may also receive the CAN frames a QCanNetwork publishes to a UDP multicast
+** group (see setMulticastGroup()), this connection is receive only. A raw TCP socket may subscribe to several
+** CAN networks at once (see connectNetworks()), each received CAN frame is tagged with its CAN channel then.
 **
 ** Upon creation, the socket is in an unconnected state. The current socket state can be evaluated with
 ** isConnected() and error(). Each CAN socket has an unique identifier for socket management (uuidString()).
 **
+** Received CAN frames are stored in a bounded receive FIFO (see setReceiveFifoSize()). The FIFO is
+** written by the thread owning the socket and may be read by one other thread without locking.
+**
 */
 
 class QCanSocket : public QObject
@@ -68,6 +79,45 @@ class QCanSocket : public QObject
    Q_OBJECT
 
 public:
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \enum    FifoOverflow_e
+   **
+   ** This enumeration defines how the receive FIFO behaves when a CAN frame is received and the
+   ** FIFO is full.
+   */
+   enum FifoOverflow_e {
+
+      /*! The received CAN frame is discarded               */
+      eFIFO_OVERFLOW_DROP_NEWEST = 0,
+
+      /*! The oldest CAN frame inside the FIFO is discarded */
+      eFIFO_OVERFLOW_DROP_OLDEST
+   };
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \enum    Transport_e
+   **
+   ** This enumeration defines the connection to the CAN server.
+   */
+   enum Transport_e {
+
+      /*! Local socket, the server runs on the same host    */
+      eTRANSPORT_LOCAL = 0,
+
+      /*! WebSocket                                         */
+      eTRANSPORT_WEB_SOCKET,
+
+      /*! Raw TCP socket, see QCanServer::setTcpPort()      */
+      eTRANSPORT_TCP,
+
+      /*! UDP multicast, see QCanNetwork::setMulticast()    */
+      eTRANSPORT_MULTICAST
+   };
+
    
    //---------------------------------------------------------------------------------------------------
    /*!
@@ -97,11 +147,39 @@ public:
    ** the method returns \c false. 
    ** <p>
    ** The connection is made to QHostAddress::LocalHost, using the port #QCAN_WEB_SOCKET_DEFAULT_PORT. 
-   ** The host address can be changed with setHostAddress().
+   ** The host address can be changed with setHostAddress() or setTcpHostAddress().
    */
    bool                       connectNetwork(const QCan::CAN_Channel_e & teChannelR);
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clChannelListR CAN channels, an empty list selects all CAN networks of the server
+   ** \return     \c true if connection is possible
+   ** \see        channels(), read(), write(), setMergeWindow()
+   **
+   ** Connect the CAN socket to several CAN networks over a single multiplexed connection. The
+   ** function requires a raw TCP connection (see setTcpHostAddress()), otherwise it returns
+   ** \c false. The signal connected() is emitted as soon as the server has attached at least one of
+   ** the requested CAN networks, the attached CAN networks are returned by channels().
+   ** <p>
+   ** All received CAN frames share one receive FIFO, the CAN channel of each frame is returned by
+   ** read(QCanFrame &, QCan::CAN_Channel_e &) or readFrames(). Snapshots, forwarding of changed
+   ** CAN frames and delivery stamps are not available on a multiplexed connection.
+   */
+   bool                       connectNetworks(const QVector<QCan::CAN_Channel_e> & clChannelListR);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     List of CAN channels
+   ** \see        connectNetworks()
+   **
+   ** Returns the CAN channels which have been attached by the server to a multiplexed connection.
+   */
+   inline QVector<QCan::CAN_Channel_e> channels(void) const    { return (clMuxChannelListP);        }
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \see  connectNetwork()
@@ -111,6 +189,39 @@ public:
    */
    void                       disconnectNetwork(void);
 
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Histogram of delivery latency
+   ** \see        setDeliveryMonitor(), resetDeliveryStatistic()
+   **
+   ** Returns the histogram of the time between the dispatching of a CAN frame by the CAN network and
+   ** its reception by this socket. The values are only meaningful if the server runs on the same
+   ** host, because the monotonic clock is compared. The histogram must only be accessed by the
+   ** thread which owns the socket.
+   */
+   inline const QCanLatencyHistogram & deliveryLatency(void) const
+                                                               { return (clDeliveryLatencyP);       }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of lost CAN frames
+   ** \see        setDeliveryMonitor(), resetDeliveryStatistic()
+   **
+   ** Returns the number of CAN frames which have been lost on the connection to the CAN network,
+   ** evaluated by the sequence number of the delivery stamp (#QCAN_DELIVERY_STAMP_SEQUENCE).
+   */
+   inline uint32_t            deliveryLostCount(void) const    { return (ulDeliveryLostP);          }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if delivery stamps are evaluated
+   ** \see        setDeliveryMonitor()
+   */
+   inline bool                deliveryMonitor(void) const      { return (btDeliveryMonitorP);       }
+
    
    //---------------------------------------------------------------------------------------------------
    /*!
@@ -138,6 +249,34 @@ public:
    */
    uint32_t                   framesAvailable(void) const;
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of dropped CAN frames
+   ** \see        setFifoOverflow(), resetFifoStatistic()
+   **
+   ** Returns the number of CAN frames which have been dropped because the receive FIFO was full.
+   */
+   inline uint32_t            framesDropped(void) const        { return (ulRcvFifoDropP.load());    }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Overflow policy of receive FIFO
+   ** \see        setFifoOverflow()
+   **
+   ** Returns the behaviour of the receive FIFO when it is full.
+   */
+   inline FifoOverflow_e      fifoOverflow(void) const         { return (teRcvFifoOverflowP);       }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if only changed CAN frames are received
+   ** \see        setForwardOnChange()
+   **
+   ** Returns \c true if the CAN network forwards only changed CAN frames to this socket.
+   */
+   inline bool                forwardOnChange(void) const      { return (btForwardOnChangeP);       }
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return     \c true if socket is connected
@@ -148,6 +287,33 @@ public:
    inline bool                isConnected(void) const          { return (btIsConnectedP);       }
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true for a multiplexed connection
+   ** \see        connectNetworks()
+   */
+   inline bool                isMultiplexed(void) const        { return (btMuxP);                   }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Merge window in milliseconds
+   ** \see        setMergeWindow()
+   */
+   inline uint32_t            mergeWindow(void) const          { return (ulMergeWindowP);           }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of lost CAN frames
+   ** \see        setMulticastGroup()
+   **
+   ** Returns the number of CAN frames which have been lost on a multicast connection, evaluated by
+   ** the sequence number of the datagrams. The value is cleared by connectNetwork().
+   */
+   inline uint32_t            multicastLostCount(void) const   { return (ulMulticastLostP);         }
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[out]    clFrameR   Reference to CAN frame
@@ -160,6 +326,148 @@ public:
    bool                       read(QCanFrame & clFrameR);
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[out]    clFrameR   Reference to CAN frame
+   ** \param[out]    teChannelR CAN channel of the CAN frame
+   ** \return        \c true if CAN frame was read
+   ** \see           connectNetworks()
+   **
+   ** The function reads a CAN frame from the socket like read(QCanFrame &) and returns the CAN
+   ** channel it has been received from in \a teChannelR.
+   */
+   bool                       read(QCanFrame & clFrameR, QCan::CAN_Channel_e & teChannelR);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[out]    pclBufferV  Pointer to array of CAN frames
+   ** \param[in]     ulMaxV      Maximum number of CAN frames to read
+   ** \param[out]    pteChannelV Pointer to array of CAN channels, may be \c nullptr
+   ** \return        Number of CAN frames read
+   ** \see           read()
+   **
+   ** The function reads up to \a ulMaxV CAN frames from the socket and places them in the array
+   ** \a pclBufferV. The array must provide space for at least \a ulMaxV elements. If \a pteChannelV
+   ** is not \c nullptr, the CAN channel of each frame is stored at the same index of this array.
+   ** If no CAN frame is available, the function returns 0.
+   */
+   uint32_t                   readFrames(QCanFrame * pclBufferV, const uint32_t ulMaxV,
+                                         QCan::CAN_Channel_e * pteChannelV = nullptr);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Size of receive FIFO
+   ** \see        setReceiveFifoSize()
+   **
+   ** Returns the maximum number of CAN frames the receive FIFO can hold.
+   */
+   inline uint32_t            receiveFifoSize(void) const      { return (ulRcvFifoSizeP);           }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Maximum fill level of receive FIFO
+   ** \see        resetFifoStatistic()
+   **
+   ** Returns the highest number of CAN frames which have been stored in the receive FIFO at the same
+   ** time (high-watermark).
+   */
+   inline uint32_t            receiveFifoWatermark(void) const { return (ulRcvFifoMaxLevelP.load()); }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        framesDropped(), receiveFifoWatermark()
+   **
+   ** Clear the counter of dropped CAN frames and the high-watermark of the receive FIFO.
+   */
+   void                       resetFifoStatistic(void);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        deliveryLatency(), deliveryLostCount()
+   **
+   ** Clear the delivery latency histogram and the counter of lost CAN frames.
+   */
+   void                       resetDeliveryStatistic(void);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if request has been sent
+   ** \see        setSnapshotOnConnect(), snapshotReceived()
+   **
+   ** Request the most recent CAN frame of each CAN identifier from the CAN network (see
+   ** QCanNetwork::frameCache()). The CAN frames of the snapshot are placed in the receive FIFO,
+   ** followed by the live stream of CAN frames without gap or duplicate: CAN data frames which are
+   ** received between the request and the begin of the snapshot are discarded, because they are
+   ** part of the snapshot. The signal snapshotReceived() is emitted after the last CAN frame of the
+   ** snapshot.
+   ** <p>
+   ** The function returns \c false if the socket is not connected.
+   */
+   bool                       requestSnapshot(void);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  teOverflowV    Overflow policy
+   ** \see        fifoOverflow()
+   **
+   ** Define how the receive FIFO behaves when a CAN frame is received and the FIFO is full. The
+   ** default value is #eFIFO_OVERFLOW_DROP_NEWEST.
+   */
+   inline void                setFifoOverflow(const FifoOverflow_e teOverflowV)
+                                                               { teRcvFifoOverflowP = teOverflowV;  }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  btEnableV      \c true to receive only changed CAN frames
+   ** \param[in]  ulMaxSilenceV  Maximum silence time in milliseconds, 0 for no refresh
+   ** \return     \c true if the setting has been transferred or is stored for the connection
+   ** \see        forwardOnChange()
+   **
+   ** If enabled, the CAN network forwards a CAN data frame to this socket only if its DLC or payload
+   ** differs from the last CAN frame with the same identifier forwarded to this socket. If
+   ** \a ulMaxSilenceV is not 0, an unchanged CAN frame is forwarded again after this time, provided
+   ** that it is still transmitted on the bus. Error frames are always forwarded.
+   ** <p>
+   ** The setting can be changed in connected and unconnected state, it is transferred to the
+   ** CAN network on each connection. The function returns \c false if the transfer fails.
+   */
+   bool                       setForwardOnChange(const bool btEnableV, const uint32_t ulMaxSilenceV = 0);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  btEnableV      \c true to evaluate delivery stamps
+   ** \see        deliveryMonitor(), deliveryLatency(), deliveryLostCount()
+   **
+   ** If enabled, the socket evaluates the delivery stamp of each received CAN frame. The delivery
+   ** stamp is written by the CAN network, it must be enabled by QCanNetwork::setDeliveryStamp()
+   ** (or QCanNetworkSettings::setDeliveryStamp()). CAN frames without stamp and the CAN frames of a
+   ** snapshot are not evaluated. Enabling the monitor clears the statistic.
+   */
+   void                       setDeliveryMonitor(const bool btEnableV);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulSizeV        Number of CAN frames
+   ** \return     \c true if size was changed
+   ** \see        receiveFifoSize()
+   **
+   ** Set the size of the receive FIFO. The value \a ulSizeV is rounded up to the next power of 2,
+   ** valid values are in the range from 1 to 1048576. The size can only be modified in unconnected
+   ** state, all CAN frames inside the FIFO are discarded. The default value is defined by #QCAN_SOCKET_RCV_FIFO_SIZE.
+   */
+   bool                       setReceiveFifoSize(const uint32_t ulSizeV);
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \param[in]  clHostAddressV    Host address
@@ -173,6 +481,89 @@ public:
                                              const uint16_t uwPortV = QCAN_WEB_SOCKET_DEFAULT_PORT);
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulWindowV      Merge window in milliseconds, 0 for arrival order
+   ** \return     \c true if the merge window was changed
+   ** \see        mergeWindow(), connectNetworks()
+   **
+   ** On a multiplexed connection the CAN frames of the different CAN networks are stored in the
+   ** order of arrival. If a merge window is set, the received CAN frames are held back and stored
+   ** in the order of their time stamp instead: a CAN frame is released as soon as a CAN frame which
+   ** is \a ulWindowV milliseconds newer has been received, or if no further CAN frame has been
+   ** received for \a ulWindowV milliseconds. The merge window can only be modified in unconnected
+   ** state, the default value is 0.
+   */
+   bool                       setMergeWindow(const uint32_t ulWindowV);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clGroupV          Multicast group
+   ** \param[in]  uwPortV           UDP port
+   ** \param[in]  clInterfaceR      Name of network interface, e.g. "lo"
+   ** \see        connectNetwork(), multicastLostCount()
+   **
+   ** Select the reception of CAN frames from the multicast group \a clGroupV (see
+   ** QCanNetwork::setMulticast()). The connection is receive only: connected() is emitted as soon
+   ** as the socket has joined the group, write() and requestSnapshot() fail. If \a clInterfaceR is
+   ** empty, the operating system selects the network interface. The multicast group can only be
+   ** modified in unconnected state.
+   */
+   void                       setMulticastGroup(const QHostAddress clGroupV,
+                                                const uint16_t uwPortV = QCAN_MULTICAST_DEFAULT_PORT,
+                                                const QString & clInterfaceR = QString());
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clHostAddressV    Host address
+   ** \param[in]  uwPortV           Port number of raw TCP server
+   ** \see        connectNetwork(), setHostAddress()
+   **
+   ** Set the host address of the CAN server and select a raw TCP connection (see
+   ** QCanServer::setTcpPort()). The connection carries the CAN frames without WebSocket framing,
+   ** CAN frames written by write() are sent when control returns to the event loop. The host address
+   ** can only be modified in unconnected state.
+   */
+   void                       setTcpHostAddress(const QHostAddress clHostAddressV,
+                                                const uint16_t uwPortV = QCAN_TCP_SOCKET_DEFAULT_PORT);
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  btEnableV      \c true to enable TCP_NODELAY
+   ** \see        setTcpHostAddress()
+   **
+   ** Controls the option TCP_NODELAY of a raw TCP connection, the value is applied on the next
+   ** connection. The default value is \c true.
+   */
+   inline void                setTcpNoDelay(const bool btEnableV)
+                                                               { btTcpNoDelayP = btEnableV;         }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  btEnableV      \c true to request a snapshot on connection
+   ** \see        requestSnapshot()
+   **
+   ** If enabled, the socket calls requestSnapshot() as soon as the connection to the CAN network
+   ** is established, before the signal connected() is emitted. The default value is \c false.
+   */
+   inline void                setSnapshotOnConnect(const bool btEnableV)
+                                                               { btSnapshotOnConnectP = btEnableV;  }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if a snapshot is requested on connection
+   ** \see        setSnapshotOnConnect()
+   **
+   ** Returns \c true if a snapshot of the frame cache is requested on connection.
+   */
+   inline bool                snapshotOnConnect(void) const    { return (btSnapshotOnConnectP);     }
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return  CAN error state
@@ -182,6 +573,26 @@ public:
    inline QCan::CAN_State_e   state(void) const                { return teCanStateP;            }
 
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if TCP_NODELAY is enabled
+   ** \see        setTcpNoDelay()
+   **
+   ** Returns \c true if the option TCP_NODELAY is used for a raw TCP connection.
+   */
+   inline bool                tcpNoDelay(void) const           { return (btTcpNoDelayP);            }
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Connection type
+   ** \see        setHostAddress(), setTcpHostAddress()
+   **
+   ** Returns the connection type which is used by connectNetwork().
+   */
+   inline Transport_e         transport(void) const            { return (teTransportP);             }
+
+
    //---------------------------------------------------------------------------------------------------
    /*!
    ** \return     UUID
@@ -210,6 +621,21 @@ public:
    */
    bool                       write(const QCanFrame & clFrameR);
 
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clFrameR       Reference to CAN frame
+   ** \param[in]  teChannelV     CAN channel
+   ** \return     \c true if CAN frame was written
+   ** \see        connectNetworks()
+   **
+   ** The function writes the CAN frame \a clFrameR to the CAN network \a teChannelV of a
+   ** multiplexed connection, write(const QCanFrame &) uses the CAN channel of the last call of
+   ** this function. On a connection to a single CAN network \a teChannelV must match the
+   ** connected CAN channel.
+   */
+   bool                       write(const QCanFrame & clFrameR, const QCan::CAN_Channel_e teChannelV);
+
 public slots:
    void                       onConnectNetwork(const QCan::CAN_Channel_e & teChannelR);
    void                       onDisconnectNetwork();
@@ -249,24 +675,148 @@ signals:
    */
    void                       readyRead(void);
 
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulCountV       Number of CAN frames
+   ** \see        requestSnapshot()
+   **
+   ** This signal is emitted when a snapshot requested by requestSnapshot() has been received
+   ** completely. The \a ulCountV CAN frames of the snapshot are available in the receive FIFO.
+   */
+   void                       snapshotReceived(uint32_t ulCountV);
+
 protected:
 
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clFrameR       CAN frame
+   ** \param[in]  ubChannelV     CAN channel of the frame
+   ** \return     \c true if the CAN frame has been stored
+   **
+   ** Store a CAN frame in the receive FIFO, the function must only be called by the thread owning
+   ** the socket. If the FIFO is full, the CAN frame is handled as defined by setFifoOverflow(). In
+   ** mode #eFIFO_OVERFLOW_DROP_OLDEST the received CAN frame is discarded instead if the reader is
+   ** just copying the oldest CAN frame.
+   */
+   bool                       pushReceiveFifo(const QCanFrame & clFrameR, const uint8_t ubChannelV);
+
 private:
 
    QPointer<QLocalSocket>  pclLocalSocketP;
    QPointer<QWebSocket>    pclWebSocketP;
+   QPointer<QTcpSocket>    pclTcpSocketP;
+   QPointer<QUdpSocket>    pclUdpSocketP;
    QHostAddress            clServerHostAddrP;
    uint16_t                uwServerPortP;
    bool                    btIsConnectedP;
-   bool                    btIsLocalConnectionP;
+   Transport_e             teTransportP;
    int32_t                 slSocketErrorP;
    QCan::CAN_State_e       teCanStateP;
    QUuid                   clUuidP;
 
    QByteArray              clReceiveDataP;
    QCanFrame               clReceiveFrameP;
-   QMutex                  clReceiveMutexP;
-   QQueue<QCanFrame>       clReceiveFifoP;
+
+   //---------------------------------------------------------------------------------------------------
+   // reception of CAN frames from a stream socket (local socket or raw TCP socket), receiveFrame()
+   // returns true if the CAN frame has been stored inside the receive FIFO
+   //
+   void                    receiveStream(QIODevice * pclSocketV);
+   bool                    receiveFrame(const uint8_t * pubDataV);
+
+   //---------------------------------------------------------------------------------------------------
+   // channel selected by connectNetwork(), it is evaluated for raw TCP and multicast connections
+   //
+   QCan::CAN_Channel_e     teChannelP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Multiplexed connection: the CAN channel of the received and transmitted CAN frames is switched
+   // by #QCAN_CONTROL_CHANNEL_SELECT, clMuxChannelListP holds the channels confirmed by the server
+   //
+   bool                    btMuxP;
+   uint8_t                 ubRcvChannelP;
+   uint8_t                 ubTrmChannelP;
+   QVector<QCan::CAN_Channel_e>  clMuxChannelListP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Merge of CAN frames in time stamp order: the CAN frames are held in a min-heap, ordered by time
+   // stamp and arrival, until they are older than the merge window (see setMergeWindow())
+   //
+   typedef struct MergeEntry_s {
+      QCanFrame   clFrame;
+      uint64_t    uqTime;
+      uint32_t    ulOrder;
+      uint8_t     ubChannel;
+   } MergeEntry_ts;
+
+   static bool             isMergeEntryLater(const MergeEntry_ts & tsEntryR, const MergeEntry_ts & tsOtherR);
+   void                    stageMergeFrame(const QCanFrame & clFrameR, const uint8_t ubChannelV);
+   bool                    releaseMergeFrames(const bool btFlushV);
+   uint32_t                ulMergeWindowP;
+   uint32_t                ulMergeOrderP;
+   uint64_t                uqMergeNewestP;
+   QVector<MergeEntry_ts>  clMergeHeapP;
+   QTimer *                pclMergeTimerP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Raw TCP connection: btTcpHandshakeP is set until the server has confirmed the channel
+   //
+   bool                    btTcpNoDelayP;
+   bool                    btTcpHandshakeP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Multicast connection: ulMulticastSequenceP is the expected sequence number of the next CAN
+   // frame, it is valid after btMulticastSyncP has been set
+   //
+   QString                 clMulticastInterfaceP;
+   bool                    btMulticastSyncP;
+   uint32_t                ulMulticastSequenceP;
+   uint32_t                ulMulticastLostP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Snapshot of the frame cache: CAN data frames are discarded while btSnapshotPendingP is set
+   //
+   void                    handleControl(const uint8_t * pubDataV);
+   bool                    writeControl(const uint8_t ubCommandV, const uint8_t ubModeV, const uint32_t ulParamV);
+   bool                    btSnapshotOnConnectP;
+   bool                    btSnapshotPendingP;
+   bool                    btSnapshotActiveP;
+   uint32_t                ulSnapshotCountP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Evaluation of delivery stamps (see #QCAN_DELIVERY_STAMP_TIME), btDeliverySyncP is set after
+   // the first sequence number has been received
+   //
+   void                    evaluateDeliveryStamp(const uint8_t * pubDataV);
+   bool                    btDeliveryMonitorP;
+   bool                    btDeliverySyncP;
+   uint32_t                ulDeliverySequenceP;
+   uint32_t                ulDeliveryLostP;
+   QCanLatencyHistogram    clDeliveryLatencyP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Forwarding of changed CAN frames only (see #QCAN_CONTROL_FORWARD_MODE)
+   //
+   bool                    btForwardOnChangeP;
+   uint32_t                ulMaxSilenceP;
+
+   //---------------------------------------------------------------------------------------------------
+   // Receive FIFO: single producer (socket thread) / single consumer ring buffer, the indices are
+   // free running and masked by ulRcvFifoMaskP. The sequence number of a slot is equal to the index
+   // when the slot is free, equal to index + 1 when it holds a CAN frame, a slot is handed back to
+   // the writer by the reader after the CAN frame has been copied.
+   //
+   QVector<QCanFrame>      clRcvFifoP;
+   QVector<uint8_t>        clRcvFifoChannelP;
+   std::unique_ptr<std::atomic<uint32_t>[]>  aulRcvFifoSeqP;
+   uint32_t                ulRcvFifoSizeP;
+   uint32_t                ulRcvFifoMaskP;
+   std::atomic<uint32_t>   ulRcvFifoHeadP;
+   std::atomic<uint32_t>   ulRcvFifoTailP;
+   std::atomic<uint32_t>   ulRcvFifoDropP;
+   std::atomic<uint32_t>   ulRcvFifoMaxLevelP;
+   FifoOverflow_e          teRcvFifoOverflowP;
    
 
 private slots:
@@ -276,6 +826,11 @@ private slots:
    void                    onSocketErrorWeb(QAbstractSocket::SocketError teSocketErrorV);
    void                    onSocketReceiveLocal(void);
    void                    onSocketReceiveWeb(const QByteArray &clMessageR);
+   void                    onSocketConnectTcp(void);
+   void                    onSocketErrorTcp(QAbstractSocket::SocketError teSocketErrorV);
+   void                    onSocketReceiveTcp(void);
+   void                    onSocketReceiveMulticast(void);
+   void                    onMergeTimeout(void);
 };
 
 #endif   // QCAN_SOCKET_HPP_
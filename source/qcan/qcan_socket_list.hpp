@@ -0,0 +1,183 @@
+//====================================================================================================================//
+// File:          qcan_socket_list.hpp                                                                                //
+// Description:   QCAN classes - List of client sockets with index                                                    //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_SOCKET_LIST_HPP_
+#define QCAN_SOCKET_LIST_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanSocketList
+** \brief   List of client sockets with index
+**
+** The QCanSocketList class holds the client sockets of one type (QLocalSocket, QWebSocket,
+** QTcpSocket or QCanMuxSocket) which are connected to a QCanNetwork. An index (socket -> list
+** position) is used for the lookup of the sender of a signal. A socket is removed by moving the
+** last socket of the list to its position, so only a single index entry has to be updated. The
+** order of the sockets inside the list is therefore not the order of connection.
+** <p>
+** The CAN frames are dispatched to a copy of the list (see list()), which is implicitly shared and
+** not affected by a socket that connects or disconnects during the dispatch.
+** <p>
+** The class is not thread-safe, the owner must serialise the access.
+*/
+template <class T> class QCanSocketList
+{
+public:
+
+   QCanSocketList() = default;
+
+   ~QCanSocketList() = default;
+
+   QCanSocketList(const QCanSocketList&) = delete;                          // no copy constructor
+   QCanSocketList& operator=(const QCanSocketList&) = delete;               // no assignment operator
+   QCanSocketList(QCanSocketList&&) = delete;                               // no move constructor
+   QCanSocketList& operator=(QCanSocketList&&) = delete;                    // no move operator
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclSocketV     Pointer to socket
+   ** \param[in]  ulMaxV         Maximum number of sockets
+   ** \return     \c true if the socket has been appended
+   **
+   ** The function appends the socket \a pclSocketV to the list. It returns \c false if the list
+   ** already holds \a ulMaxV sockets or if the socket is already part of the list.
+   */
+   bool append(T * pclSocketV, const uint32_t ulMaxV)
+   {
+      if ((pclSocketV == nullptr) || (static_cast< uint32_t >(clListP.size()) >= ulMaxV) ||
+          (clIndexP.contains(pclSocketV)))
+      {
+         return (false);
+      }
+
+      clListP.append(pclSocketV);
+      clIndexP.insert(pclSocketV, clListP.size() - 1);
+
+      return (true);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Remove all sockets from the list.
+   */
+   void clear(void)
+   {
+      clListP.clear();
+      clIndexP.clear();
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclSocketV     Pointer to socket
+   ** \return     Position of the socket inside the list, -1 if the socket is not part of the list
+   */
+   inline int32_t indexOf(const QObject * pclSocketV) const   { return (clIndexP.value(pclSocketV, -1)); }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     List of sockets
+   **
+   ** The returned list is implicitly shared, a copy of it is not affected by later changes.
+   */
+   inline const QVector<T *> & list(void) const               { return (clListP);                       }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclSocketV     Pointer to socket
+   ** \return     \c true if the socket has been removed
+   **
+   ** The function removes the socket \a pclSocketV from the list, the last socket of the list takes
+   ** its position.
+   */
+   bool remove(const QObject * pclSocketV)
+   {
+      const int32_t  slSockIdxT = clIndexP.value(pclSocketV, -1);
+      int32_t        slLastIdxT;
+
+      if (slSockIdxT < 0)
+      {
+         return (false);
+      }
+
+      clIndexP.remove(pclSocketV);
+      slLastIdxT = clListP.size() - 1;
+      if (slSockIdxT != slLastIdxT)
+      {
+         clListP[slSockIdxT] = clListP.at(slLastIdxT);
+         clIndexP.insert(clListP.at(slSockIdxT), slSockIdxT);
+      }
+      clListP.removeLast();
+
+      return (true);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  slSizeV        Number of sockets
+   **
+   ** Reserve memory for \a slSizeV sockets.
+   */
+   void reserve(const int32_t slSizeV)
+   {
+      clListP.reserve(slSizeV);
+      clIndexP.reserve(slSizeV);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of sockets inside the list
+   */
+   inline int32_t size(void) const                             { return (clListP.size());                }
+
+private:
+
+   QVector<T *>                        clListP;
+   QHash<const QObject *, int32_t>     clIndexP;
+};
+
+
+#endif   // QCAN_SOCKET_LIST_HPP_
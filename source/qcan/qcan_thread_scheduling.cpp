@@ -0,0 +1,267 @@
+//====================================================================================================================//
+// File:          qcan_thread_scheduling.cpp                                                                          //
+// Description:   QCAN classes - CPU affinity and scheduling policy of threads                                        //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QDebug>
+#include <QtCore/QStringList>
+
+#include "qcan_thread_scheduling.hpp"
+
+#ifdef   Q_OS_LINUX
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------------------------------
+// highest CPU number accepted by parseCpuList()
+//
+#define  QCAN_THREAD_CPU_MAX                 1023
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanThreadScheduling()                                                                                             //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanThreadScheduling::QCanThreadScheduling()
+{
+   tePolicyP   = ePOLICY_OTHER;
+   slPriorityP = 1;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanThreadScheduling::apply()                                                                                      //
+// set CPU affinity and scheduling policy of the calling thread                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanThreadScheduling::apply(void)
+{
+   bool  btResultT = true;
+
+   #ifdef Q_OS_LINUX
+   pthread_t            tsThreadT = pthread_self();
+   cpu_set_t            tsCpuSetT;
+   struct sched_param   tsParamT;
+   int                  slPolicyT;
+   int                  slErrorT;
+   QStringList          clCpuListT;
+
+   //---------------------------------------------------------------------------------------------------
+   // CPU affinity
+   //
+   if (aslCpuListP.isEmpty() == false)
+   {
+      CPU_ZERO(&tsCpuSetT);
+      foreach (int32_t slCpuT, aslCpuListP)
+      {
+         if ((slCpuT >= 0) && (slCpuT < CPU_SETSIZE))
+         {
+            CPU_SET(slCpuT, &tsCpuSetT);
+         }
+      }
+
+      slErrorT = pthread_setaffinity_np(tsThreadT, sizeof(tsCpuSetT), &tsCpuSetT);
+      if (slErrorT != 0)
+      {
+         qWarning() << "QCanThreadScheduling::apply() WARNING: CPU affinity not set:" << strerror(slErrorT);
+         btResultT = false;
+      }
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // real-time policy, the thread keeps the default policy if this is not permitted
+   //
+   if (tePolicyP != ePOLICY_OTHER)
+   {
+      slPolicyT = (tePolicyP == ePOLICY_FIFO) ? SCHED_FIFO : SCHED_RR;
+      tsParamT.sched_priority = qBound(sched_get_priority_min(slPolicyT), slPriorityP,
+                                       sched_get_priority_max(slPolicyT));
+
+      slErrorT = pthread_setschedparam(tsThreadT, slPolicyT, &tsParamT);
+      if (slErrorT != 0)
+      {
+         qWarning() << "QCanThreadScheduling::apply() WARNING: real-time scheduling not permitted, use default:"
+                    << strerror(slErrorT);
+         btResultT = false;
+      }
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // report the settings in effect
+   //
+   clReportP.clear();
+   if (pthread_getschedparam(tsThreadT, &slPolicyT, &tsParamT) == 0)
+   {
+      switch (slPolicyT)
+      {
+         case SCHED_FIFO:
+            clReportP = QString("policy SCHED_FIFO, priority %1").arg(tsParamT.sched_priority);
+            break;
+
+         case SCHED_RR:
+            clReportP = QString("policy SCHED_RR, priority %1").arg(tsParamT.sched_priority);
+            break;
+
+         default:
+            clReportP = QString("policy SCHED_OTHER");
+            break;
+      }
+   }
+
+   if (pthread_getaffinity_np(tsThreadT, sizeof(tsCpuSetT), &tsCpuSetT) == 0)
+   {
+      for (int32_t slCpuT = 0; slCpuT < CPU_SETSIZE; slCpuT++)
+      {
+         if (CPU_ISSET(slCpuT, &tsCpuSetT))
+         {
+            clCpuListT.append(QString::number(slCpuT));
+         }
+      }
+      clReportP += ", CPUs " + clCpuListT.join(",");
+   }
+
+   #else
+   //---------------------------------------------------------------------------------------------------
+   // not supported on this platform
+   //
+   if (isDefault() == false)
+   {
+      qWarning() << "QCanThreadScheduling::apply() WARNING: CPU affinity and real-time scheduling not supported";
+      btResultT = false;
+   }
+   clReportP = QString("default scheduling");
+   #endif
+
+   return (btResultT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanThreadScheduling::parseCpuList()                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanThreadScheduling::parseCpuList(const QString & clTextR, QList<int32_t> & aslCpuListR)
+{
+   QStringList    clRangeT;
+   int32_t        slFirstT;
+   int32_t        slLastT;
+   bool           btFirstOkT;
+   bool           btLastOkT;
+
+   aslCpuListR.clear();
+
+   foreach (QString clItemT, clTextR.split(','))
+   {
+      if (clItemT.trimmed().isEmpty())
+      {
+         continue;
+      }
+
+      clRangeT = clItemT.trimmed().split('-');
+      if (clRangeT.size() > 2)
+      {
+         return (false);
+      }
+
+      slFirstT = clRangeT.first().toInt(&btFirstOkT);
+      slLastT  = clRangeT.last().toInt(&btLastOkT);
+      if ((btFirstOkT == false) || (btLastOkT == false) ||
+          (slFirstT < 0) || (slLastT < slFirstT) || (slLastT > QCAN_THREAD_CPU_MAX))
+      {
+         return (false);
+      }
+
+      for (int32_t slCpuT = slFirstT; slCpuT <= slLastT; slCpuT++)
+      {
+         if (aslCpuListR.contains(slCpuT) == false)
+         {
+            aslCpuListR.append(slCpuT);
+         }
+      }
+   }
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanThreadScheduling::parsePolicy()                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanThreadScheduling::parsePolicy(const QString & clTextR, Policy_e & tePolicyR)
+{
+   QString  clPolicyT = clTextR.trimmed().toLower();
+
+   if ((clPolicyT.isEmpty()) || (clPolicyT == "other"))
+   {
+      tePolicyR = ePOLICY_OTHER;
+   }
+   else if (clPolicyT == "fifo")
+   {
+      tePolicyR = ePOLICY_FIFO;
+   }
+   else if (clPolicyT == "rr")
+   {
+      tePolicyR = ePOLICY_RR;
+   }
+   else
+   {
+      return (false);
+   }
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanThreadScheduling::setPolicy()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanThreadScheduling::setPolicy(const Policy_e tePolicyV, const int32_t slPriorityV)
+{
+   tePolicyP   = tePolicyV;
+   slPriorityP = slPriorityV;
+}
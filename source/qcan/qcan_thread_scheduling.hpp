@@ -0,0 +1,186 @@
+//====================================================================================================================//
+// File:          qcan_thread_scheduling.hpp                                                                          //
+// Description:   QCAN classes - CPU affinity and scheduling policy of threads                                        //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_THREAD_SCHEDULING_HPP_
+#define QCAN_THREAD_SCHEDULING_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanThreadScheduling
+** \brief   CPU affinity and scheduling policy of a thread
+**
+** The QCanThreadScheduling class holds the CPU set and the scheduling policy requested for a thread
+** of the CANpie FD Server. The function apply() sets both for the calling thread. A real-time policy
+** (\c SCHED_FIFO or \c SCHED_RR) requires the privilege of the process (e.g. \c CAP_SYS_NICE or an
+** \c rtprio limit), if it is not permitted the thread keeps the default policy and a warning is
+** written. The settings which actually took effect are returned by report().
+** <p>
+** The CPU affinity and the real-time policies are supported on Linux only, on other platforms apply()
+** leaves the thread unchanged.
+*/
+class QCanThreadScheduling
+{
+public:
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \enum    Policy_e
+   **
+   ** This enumeration defines the scheduling policy of a thread.
+   */
+   enum Policy_e {
+
+      /*! Default time-sharing policy (\c SCHED_OTHER)    */
+      ePOLICY_OTHER = 0,
+
+      /*! Real-time first-in first-out (\c SCHED_FIFO)    */
+      ePOLICY_FIFO,
+
+      /*! Real-time round-robin (\c SCHED_RR)             */
+      ePOLICY_RR
+   };
+
+   QCanThreadScheduling();
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if the requested settings took effect
+   ** \see        report()
+   **
+   ** The function sets the CPU affinity and the scheduling policy of the calling thread. Settings
+   ** which are not permitted or not supported are skipped, in this case the function returns
+   ** \c false.
+   */
+   bool                 apply(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     List of CPU numbers
+   ** \see        setCpuList()
+   */
+   inline QList<int32_t> cpuList(void) const       { return (aslCpuListP);    }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if neither a CPU set nor a real-time policy has been requested
+   */
+   inline bool          isDefault(void) const      { return (aslCpuListP.isEmpty() && (tePolicyP == ePOLICY_OTHER)); }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clTextR        CPU list, e.g. "1,3-5"
+   ** \param[out] aslCpuListR    List of CPU numbers
+   ** \return     \c true if the text is valid
+   **
+   ** The function converts a CPU list in the format of \c taskset(1) to a list of CPU numbers. An
+   ** empty text results in an empty list, i.e. no affinity.
+   */
+   static bool          parseCpuList(const QString & clTextR, QList<int32_t> & aslCpuListR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clTextR        Policy name: "other", "fifo" or "rr"
+   ** \param[out] tePolicyR      Scheduling policy
+   ** \return     \c true if the text is valid
+   **
+   ** The function converts a policy name to the scheduling policy, an empty text selects
+   ** QCanThreadScheduling::ePOLICY_OTHER.
+   */
+   static bool          parsePolicy(const QString & clTextR, Policy_e & tePolicyR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Scheduling policy
+   ** \see        setPolicy()
+   */
+   inline Policy_e      policy(void) const         { return (tePolicyP);      }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Priority of a real-time policy
+   ** \see        setPolicy()
+   */
+   inline int32_t       priority(void) const       { return (slPriorityP);    }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Description of the scheduling in effect
+   **
+   ** The function returns the CPU set, the policy and the priority which took effect at the last call
+   ** of apply(), e.g. "policy SCHED_FIFO, priority 50, CPUs 2,3". Before apply() has been called
+   ** the string is empty.
+   */
+   inline QString       report(void) const         { return (clReportP);      }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  aslCpuListR    List of CPU numbers
+   ** \see        cpuList()
+   **
+   ** The function selects the CPUs the thread may run on, an empty list does not change the affinity.
+   */
+   inline void          setCpuList(const QList<int32_t> & aslCpuListR)  { aslCpuListP = aslCpuListR;   }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  tePolicyV      Scheduling policy
+   ** \param[in]  slPriorityV    Priority of a real-time policy
+   ** \see        policy(), priority()
+   **
+   ** The function selects the scheduling policy. The priority is limited to the range of the
+   ** real-time policy (1 .. 99 on Linux) and it is not used for QCanThreadScheduling::ePOLICY_OTHER.
+   */
+   void                 setPolicy(const Policy_e tePolicyV, const int32_t slPriorityV = 1);
+
+private:
+
+   QList<int32_t>       aslCpuListP;
+   Policy_e             tePolicyP;
+   int32_t              slPriorityP;
+   QString              clReportP;
+};
+
+#endif   // QCAN_THREAD_SCHEDULING_HPP_
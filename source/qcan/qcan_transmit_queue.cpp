@@ -0,0 +1,400 @@
+//====================================================================================================================//
+// File:          qcan_transmit_queue.cpp                                                                             //
+// Description:   QCAN classes - Priority transmit queue                                                              //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include "qcan_transmit_queue.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Class methods                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue()                                                                                                //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanTransmitQueue::QCanTransmitQueue()
+{
+   //---------------------------------------------------------------------------------------------------
+   // all entries are allocated here, they are put into the free list by clear()
+   //
+   atsEntryP.resize(QCAN_TRANSMIT_QUEUE_SIZE);
+   aslHeapP.resize(QCAN_TRANSMIT_QUEUE_SIZE);
+   aslFreeP.resize(QCAN_TRANSMIT_QUEUE_SIZE);
+
+   clear();
+
+   uqSequenceP  = 0;
+   ulDeadlineP  = QCAN_TRANSMIT_DEADLINE_DEFAULT;
+   ulDropCountP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue::arbitrationValue()                                                                              //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanTransmitQueue::arbitrationValue(const QCanFrame & clFrameR)
+{
+   uint32_t ulIdentifierT = clFrameR.identifier();
+   uint32_t ulValueT;
+
+   //---------------------------------------------------------------------------------------------------
+   // The bits are arranged in the order of transmission on the bus:
+   // bit 31..21: base identifier
+   // bit 20    : RTR (standard frame) or SRR (extended frame, always recessive)
+   // bit 19    : IDE
+   // bit 18..1 : identifier extension
+   // bit 0     : RTR (extended frame)
+   //
+   if (clFrameR.isExtended())
+   {
+      ulValueT = ((ulIdentifierT & 0x1FFC0000) << 3) | 0x00180000 | ((ulIdentifierT & 0x0003FFFF) << 1);
+      if (clFrameR.isRemote())
+      {
+         ulValueT |= 0x00000001;
+      }
+   }
+   else
+   {
+      ulValueT = (ulIdentifierT & 0x000007FF) << 21;
+      if (clFrameR.isRemote())
+      {
+         ulValueT |= 0x00100000;
+      }
+   }
+
+   return (ulValueT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue::clear()                                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanTransmitQueue::clear(void)
+{
+   int32_t  slEntryT;
+
+   for (slEntryT = 0; slEntryT < QCAN_TRANSMIT_QUEUE_SIZE; slEntryT++)
+   {
+      aslFreeP[slEntryT] = slEntryT;
+   }
+   slFreeSizeP = QCAN_TRANSMIT_QUEUE_SIZE;
+   slHeapSizeP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue::enqueue()                                                                                       //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanTransmitQueue::enqueue(const QCanFrame & clFrameR, const uint64_t uqTimeV, const Origin_ts & tsOriginR)
+{
+   int32_t  slEntryT;
+   int32_t  slHeapPosT;
+   int32_t  slLowestPosT;
+   uint32_t ulArbitrationT;
+
+   ulArbitrationT = arbitrationValue(clFrameR);
+
+   if (slFreeSizeP == 0)
+   {
+      //-------------------------------------------------------------------------------------------
+      // the queue is full: remove expired frames first
+      //
+      purge(uqTimeV);
+   }
+
+   if (slFreeSizeP == 0)
+   {
+      //-------------------------------------------------------------------------------------------
+      // The frame with the lowest priority is one of the leaves of the heap. The new frame is
+      // only accepted if it has a higher priority, within the same arbitration value the older
+      // frame wins.
+      //
+      slLowestPosT = slHeapSizeP / 2;
+      for (slHeapPosT = slLowestPosT + 1; slHeapPosT < slHeapSizeP; slHeapPosT++)
+      {
+         if (isHigher(aslHeapP[slLowestPosT], aslHeapP[slHeapPosT]))
+         {
+            slLowestPosT = slHeapPosT;
+         }
+      }
+
+      ulDropCountP++;
+      if (ulArbitrationT >= atsEntryP[aslHeapP[slLowestPosT]].ulArbitration)
+      {
+         return (false);
+      }
+      removeAt(slLowestPosT);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // take an entry from the free list and insert it into the heap
+   //
+   slFreeSizeP--;
+   slEntryT = aslFreeP[slFreeSizeP];
+
+   QueueEntry_ts & tsEntryR = atsEntryP[slEntryT];
+   tsEntryR.clFrame       = clFrameR;
+   tsEntryR.tsOrigin      = tsOriginR;
+   tsEntryR.uqSequence    = uqSequenceP++;
+   tsEntryR.uqTime        = uqTimeV;
+   tsEntryR.ulArbitration = ulArbitrationT;
+
+   aslHeapP[slHeapSizeP] = slEntryT;
+   slHeapSizeP++;
+   siftUp(slHeapSizeP - 1);
+
+   return (true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue::head()                                                                                          //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+const QCanFrame * QCanTransmitQueue::head(const uint64_t uqTimeV, Origin_ts * ptsOriginV)
+{
+   //---------------------------------------------------------------------------------------------------
+   // discard expired frames on top of the heap
+   //
+   while (slHeapSizeP > 0)
+   {
+      if (isExpired(aslHeapP[0], uqTimeV) == false)
+      {
+         if (ptsOriginV != nullptr)
+         {
+            *ptsOriginV = atsEntryP[aslHeapP[0]].tsOrigin;
+         }
+         return (&atsEntryP[aslHeapP[0]].clFrame);
+      }
+      ulDropCountP++;
+      removeAt(0);
+   }
+
+   return (nullptr);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue::isExpired()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanTransmitQueue::isExpired(const int32_t slEntryV, const uint64_t uqTimeV) const
+{
+   if (ulDeadlineP == 0)
+   {
+      return (false);
+   }
+
+   return ((uqTimeV - atsEntryP[slEntryV].uqTime) > ulDeadlineP);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue::isHigher()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool QCanTransmitQueue::isHigher(const int32_t slEntryAV, const int32_t slEntryBV) const
+{
+   const QueueEntry_ts & tsEntryAR = atsEntryP[slEntryAV];
+   const QueueEntry_ts & tsEntryBR = atsEntryP[slEntryBV];
+
+   if (tsEntryAR.ulArbitration != tsEntryBR.ulArbitration)
+   {
+      return (tsEntryAR.ulArbitration < tsEntryBR.ulArbitration);
+   }
+
+   return (tsEntryAR.uqSequence < tsEntryBR.uqSequence);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue::pop()                                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanTransmitQueue::pop(void)
+{
+   if (slHeapSizeP > 0)
+   {
+      removeAt(0);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue::purge()                                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanTransmitQueue::purge(const uint64_t uqTimeV)
+{
+   int32_t  slHeapPosT;
+   uint32_t ulCountT = 0;
+
+   //---------------------------------------------------------------------------------------------------
+   // walk backwards through the heap, so removeAt() only moves entries which have been checked
+   // already
+   //
+   slHeapPosT = slHeapSizeP - 1;
+   while (slHeapPosT >= 0)
+   {
+      if ((slHeapPosT < slHeapSizeP) && isExpired(aslHeapP[slHeapPosT], uqTimeV))
+      {
+         removeAt(slHeapPosT);
+         ulCountT++;
+      }
+      else
+      {
+         slHeapPosT--;
+      }
+   }
+
+   ulDropCountP += ulCountT;
+
+   return (ulCountT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue::removeOrigin()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t QCanTransmitQueue::removeOrigin(const QObject * pclSocketV)
+{
+   int32_t  slHeapPosT;
+   uint32_t ulCountT = 0;
+
+   if (pclSocketV == nullptr)
+   {
+      return (0);
+   }
+
+   for (slHeapPosT = 0; slHeapPosT < slHeapSizeP; slHeapPosT++)
+   {
+      QueueEntry_ts & tsEntryR = atsEntryP[aslHeapP[slHeapPosT]];
+      if (tsEntryR.tsOrigin.pclSocket == pclSocketV)
+      {
+         tsEntryR.tsOrigin.pclSocket = nullptr;
+         ulCountT++;
+      }
+   }
+
+   return (ulCountT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue::removeAt()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanTransmitQueue::removeAt(const int32_t slHeapPosV)
+{
+   //---------------------------------------------------------------------------------------------------
+   // return the entry to the free list and fill the gap with the last element of the heap
+   //
+   aslFreeP[slFreeSizeP] = aslHeapP[slHeapPosV];
+   slFreeSizeP++;
+
+   slHeapSizeP--;
+   if (slHeapPosV < slHeapSizeP)
+   {
+      aslHeapP[slHeapPosV] = aslHeapP[slHeapSizeP];
+      siftUp(slHeapPosV);
+      siftDown(slHeapPosV);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue::siftDown()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanTransmitQueue::siftDown(int32_t slHeapPosV)
+{
+   int32_t  slChildT;
+   int32_t  slEntryT;
+
+   slEntryT = aslHeapP[slHeapPosV];
+   while (true)
+   {
+      slChildT = (2 * slHeapPosV) + 1;
+      if (slChildT >= slHeapSizeP)
+      {
+         break;
+      }
+
+      if ((slChildT + 1 < slHeapSizeP) && isHigher(aslHeapP[slChildT + 1], aslHeapP[slChildT]))
+      {
+         slChildT++;
+      }
+
+      if (isHigher(aslHeapP[slChildT], slEntryT) == false)
+      {
+         break;
+      }
+
+      aslHeapP[slHeapPosV] = aslHeapP[slChildT];
+      slHeapPosV = slChildT;
+   }
+   aslHeapP[slHeapPosV] = slEntryT;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// QCanTransmitQueue::siftUp()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void QCanTransmitQueue::siftUp(int32_t slHeapPosV)
+{
+   int32_t  slParentT;
+   int32_t  slEntryT;
+
+   slEntryT = aslHeapP[slHeapPosV];
+   while (slHeapPosV > 0)
+   {
+      slParentT = (slHeapPosV - 1) / 2;
+      if (isHigher(slEntryT, aslHeapP[slParentT]) == false)
+      {
+         break;
+      }
+
+      aslHeapP[slHeapPosV] = aslHeapP[slParentT];
+      slHeapPosV = slParentT;
+   }
+   aslHeapP[slHeapPosV] = slEntryT;
+}
@@ -0,0 +1,262 @@
+//====================================================================================================================//
+// File:          qcan_transmit_queue.hpp                                                                             //
+// Description:   QCAN classes - Priority transmit queue                                                              //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+#ifndef QCAN_TRANSMIT_QUEUE_HPP_
+#define QCAN_TRANSMIT_QUEUE_HPP_
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Include files                                                                                                      **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+
+#include "qcan_frame.hpp"
+
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+** Definitions                                                                                                        **
+**                                                                                                                    **
+\*--------------------------------------------------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanTransmitQueue
+** \brief   Priority queue for CAN frames
+**
+** The QCanTransmitQueue class holds CAN frames which could not be written to a CAN interface yet. The
+** frames are sorted by their priority during bus arbitration, i.e. the frame with the lowest
+** identifier value is returned first by head(). Frames with the same arbitration value keep the order
+** in which they have been added.
+** <p>
+** The maximum number of frames is limited by #QCAN_TRANSMIT_QUEUE_SIZE. If the queue is full, a new
+** frame replaces the frame with the lowest priority, provided that the new frame has a higher
+** priority. Frames which stay longer than deadline() milliseconds in the queue are discarded. All
+** discarded frames are counted, see dropCount().
+** <p>
+** The class is not thread-safe, the owner of the queue must serialise the access.
+*/
+class QCanTransmitQueue
+{
+public:
+
+   QCanTransmitQueue();
+
+   ~QCanTransmitQueue() = default;
+
+   QCanTransmitQueue(const QCanTransmitQueue&) = delete;                  // no copy constructor
+   QCanTransmitQueue& operator=(const QCanTransmitQueue&) = delete;       // no assignment operator
+   QCanTransmitQueue(QCanTransmitQueue&&) = delete;                       // no move constructor
+   QCanTransmitQueue& operator=(QCanTransmitQueue&&) = delete;            // no move operator
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \struct  Origin_ts
+   **
+   ** The origin of a CAN frame is stored together with the frame, so the owner of the queue is able
+   ** to process the frame when it has been transmitted. The values are not evaluated by the queue.
+   */
+   typedef struct Origin_s {
+      /*! Source socket of the frame, \c nullptr if the source is no socket  */
+      const QObject *   pclSocket;
+
+      /*! Time of reception in nanoseconds                                  */
+      uint64_t          uqIngressTime;
+
+      /*! Type of source                                                    */
+      int32_t           slSource;
+   } Origin_ts;
+
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clFrameR       CAN frame
+   ** \return     Arbitration value
+   **
+   ** The function returns a value which reflects the priority of the CAN frame \a clFrameR during
+   ** bus arbitration: the lower the value, the higher the priority. The value is built from the
+   ** identifier, the RTR / SRR bit and the IDE bit in the order of transmission on the bus. Hence a
+   ** standard frame wins against an extended frame with the same base identifier.
+   */
+   static uint32_t arbitrationValue(const QCanFrame & clFrameR);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** Remove all frames from the queue, the drop counter is not changed.
+   */
+   void           clear(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of frames
+   **
+   ** Returns the number of frames in the queue.
+   */
+   inline uint32_t count(void) const         { return (static_cast< uint32_t >(slHeapSizeP));          }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Deadline in milliseconds
+   ** \see        setDeadline()
+   **
+   ** Returns the maximum time a frame is kept inside the queue, a value of 0 means no limit.
+   */
+   inline uint32_t deadline(void) const      { return (ulDeadlineP);                                   }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     Number of discarded frames
+   ** \see        resetDropCount()
+   **
+   ** Returns the number of frames which have been discarded because the queue was full or because
+   ** the deadline was exceeded.
+   */
+   inline uint32_t dropCount(void) const     { return (ulDropCountP);                                  }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  clFrameR       CAN frame
+   ** \param[in]  uqTimeV        Actual time in milliseconds
+   ** \param[in]  tsOriginR      Origin of the CAN frame
+   ** \return     \c true if the frame has been added
+   **
+   ** Add the CAN frame \a clFrameR to the queue. If the queue is full, expired frames are removed
+   ** first. If there is still no space left, the frame with the lowest priority is discarded in
+   ** favour of \a clFrameR. The function returns \c false if \a clFrameR itself has the lowest
+   ** priority, the frame is counted as dropped in that case.
+   */
+   bool           enqueue(const QCanFrame & clFrameR, const uint64_t uqTimeV,
+                          const Origin_ts & tsOriginR = Origin_ts());
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  uqTimeV        Actual time in milliseconds
+   ** \param[out] ptsOriginV     Pointer to origin of CAN frame, may be \c nullptr
+   ** \return     Pointer to CAN frame or \c nullptr
+   ** \see        pop()
+   **
+   ** The function returns a pointer to the CAN frame with the highest priority. Frames which have
+   ** exceeded the deadline at time \a uqTimeV are discarded before. If the queue is empty, the
+   ** function returns \c nullptr. The frame remains in the queue until pop() is called. If
+   ** \a ptsOriginV is not \c nullptr, the origin of the CAN frame is copied to this structure.
+   */
+   const QCanFrame * head(const uint64_t uqTimeV, Origin_ts * ptsOriginV = nullptr);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \return     \c true if the queue is empty
+   */
+   inline bool    isEmpty(void) const        { return (slHeapSizeP == 0);                              }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        head()
+   **
+   ** Remove the CAN frame with the highest priority from the queue.
+   */
+   void           pop(void);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  uqTimeV        Actual time in milliseconds
+   ** \return     Number of discarded frames
+   **
+   ** Remove all frames which have exceeded the deadline at time \a uqTimeV.
+   */
+   uint32_t       purge(const uint64_t uqTimeV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  pclSocketV     Source socket
+   ** \return     Number of frames
+   **
+   ** Clear the source socket \a pclSocketV in the origin of all queued frames. The function must be
+   ** called before the socket is deleted: a new socket may be allocated at the same address and the
+   ** stored pointer would identify it as the source of the frame. The frames remain in the queue.
+   */
+   uint32_t       removeOrigin(const QObject * pclSocketV);
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \see        dropCount()
+   **
+   ** Set the counter of discarded frames to 0.
+   */
+   inline void    resetDropCount(void)       { ulDropCountP = 0;                                       }
+
+   //---------------------------------------------------------------------------------------------------
+   /*!
+   ** \param[in]  ulDeadlineV    Deadline in milliseconds
+   ** \see        deadline()
+   **
+   ** Set the maximum time a frame is kept inside the queue, a value of 0 disables the deadline.
+   */
+   inline void    setDeadline(const uint32_t ulDeadlineV)   { ulDeadlineP = ulDeadlineV;               }
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // an entry of the queue, the sequence number keeps the FIFO order of frames with the same
+   // arbitration value
+   //
+   typedef struct QueueEntry_s {
+      QCanFrame   clFrame;
+      Origin_ts   tsOrigin;
+      uint64_t    uqSequence;
+      uint64_t    uqTime;
+      uint32_t    ulArbitration;
+   } QueueEntry_ts;
+
+   bool           isHigher(const int32_t slEntryAV, const int32_t slEntryBV) const;
+   bool           isExpired(const int32_t slEntryV, const uint64_t uqTimeV) const;
+   void           removeAt(const int32_t slHeapPosV);
+   void           siftDown(int32_t slHeapPosV);
+   void           siftUp(int32_t slHeapPosV);
+
+   //---------------------------------------------------------------------------------------------------
+   // the entries are allocated once, the binary heap aslHeapP holds indices to atsEntryP and
+   // aslFreeP holds the indices of unused entries
+   //
+   QVector<QueueEntry_ts>     atsEntryP;
+   QVector<int32_t>           aslHeapP;
+   QVector<int32_t>           aslFreeP;
+   int32_t                    slHeapSizeP;
+   int32_t                    slFreeSizeP;
+
+   uint64_t                   uqSequenceP;
+   uint32_t                   ulDeadlineP;
+   uint32_t                   ulDropCountP;
+};
+
+#endif   // QCAN_TRANSMIT_QUEUE_HPP_
@@ -1,4 +1,3 @@
-
 #include <iostream>
 
 using namespace std;
@@ -9,10 +8,31 @@ using namespace std;
 
 
 #include "test_qcan_timestamp.hpp"
-#include "test_qcan_filter.hpp"
 #include "test_qcan_frame.hpp"
+#include "test_qcan_filter.hpp"
 #include "test_qcan_socket.hpp"
 #include "test_qcan_socket_canpie.hpp"
+#include "test_qcan_cyclic_table.hpp"
+#include "test_qcan_transmit_queue.hpp"
+#include "test_qcan_route.hpp"
+#include "test_qcan_frame_bits.hpp"
+#include "test_qcan_id_statistic.hpp"
+#include "test_qcan_id_index.hpp"
+#include "test_qcan_frame_cache.hpp"
+#include "test_qcan_change_filter.hpp"
+#include "test_qcan_latency_histogram.hpp"
+#include "test_qcan_log_writer.hpp"
+#include "test_qcan_multicast_datagram.hpp"
+#include "test_qcan_bridge_sequence.hpp"
+#include "test_qcan_mux_channel.hpp"
+#include "test_qcan_delivery_stamp.hpp"
+#include "test_qcan_server_memory.hpp"
+#include "test_qcan_metrics_server.hpp"
+#include "test_qcan_error_coalescing.hpp"
+#include "test_qcan_server_tcp.hpp"
+#include "test_qcan_socket_list.hpp"
+#include "test_qcan_server_network.hpp"
+#include "test_qcan_thread_scheduling.hpp"
 
 
 //--------------------------------------------------------------------------------------------------------------------//
@@ -23,57 +43,59 @@ int main(int argc, char *argv[])
 {
    int32_t  slResultT = 0;
 
-   cout << "#===============================================================================\n";
-   cout << "# Run test cases for QCan classes                                               \n";
-   cout << "#                                                                               \n";
-   cout << "#===============================================================================\n";
-   cout << "\n";
-
-
    //---------------------------------------------------------------------------------------------------
-   // test QCanTimestamp
+   // the network tests require an event loop
    //
-   TestQCanTimeStamp  clTestQCanTimeStampT;
-   slResultT += QTest::qExec(&clTestQCanTimeStampT, argc, &argv[0]);
-   cout << "\n";
-   cout << "#===============================================================================\n";
-   cout << "\n";
+   QCoreApplication clAppT(argc, argv);
 
    //---------------------------------------------------------------------------------------------------
-   // test QCanFrame
+   // test cases, executed in order of the table
    //
-   TestQCanFrame  clTestQCanFrameT;
-   slResultT += QTest::qExec(&clTestQCanFrameT, argc, &argv[0]);
-   cout << "\n";
-   cout << "#===============================================================================\n";
-   cout << "\n";
+   QObject * apclTestCaseT[] = {
+      new TestQCanTimeStamp(),
+      new TestQCanFrame(),
+      new TestQCanFilter(),
+      //new TestQCanSocket(),
+      new TestQCanSocketCpFD(),
+      new TestQCanSocketFifo(),
+      new TestQCanCyclicTable(),
+      new TestQCanTransmitQueue(),
+      new TestQCanRoute(),
+      new TestQCanFrameBits(),
+      new TestQCanIdStatistic(),
+      new TestQCanIdIndex(),
+      new TestQCanFrameCache(),
+      new TestQCanChangeFilter(),
+      new TestQCanLatencyHistogram(),
+      new TestQCanLogWriter(),
+      new TestQCanMulticastDatagram(),
+      new TestQCanBridgeSequence(),
+      new TestQCanMuxChannel(),
+      new TestQCanDeliveryStamp(),
+      new TestQCanServerMemory(),
+      new TestQCanMetricsServer(),
+      new TestQCanErrorCoalescing(),
+      new TestQCanServerTcp(),
+      new TestQCanSocketList(),
+      new TestQCanServerNetwork(),
+      new TestQCanThreadScheduling(),
+   };
 
-   //---------------------------------------------------------------------------------------------------
-   // test QCanFilter & QCanFilterList
-   //
-   TestQCanFilter  clTestQCanFilterT;
-   slResultT += QTest::qExec(&clTestQCanFilterT, argc, &argv[0]);
-   cout << "\n";
    cout << "#===============================================================================\n";
-   cout << "\n";
-
-   //---------------------------------------------------------------------------------------------------
-   // test QCanSocket
-   //
-   //TestQCanSocket  clTestQCanSockT;
-   //slResultT += QTest::qExec(&clTestQCanSockT, argc, &argv[0]);
-   cout << "\n";
+   cout << "# Run test cases for QCan classes                                               \n";
+   cout << "#                                                                               \n";
    cout << "#===============================================================================\n";
    cout << "\n";
 
-   //---------------------------------------------------------------------------------------------------
-   // test QCanSocketCpFD
-   //
-   TestQCanSocketCpFD  clTestQCanSocketCANpieT;
-   slResultT += QTest::qExec(&clTestQCanSocketCANpieT, argc, &argv[0]);
-   cout << "\n";
-   cout << "#===============================================================================\n";
-   cout << "\n";
+   for (QObject * pclTestCaseT : apclTestCaseT)
+   {
+      slResultT += QTest::qExec(pclTestCaseT, argc, &argv[0]);
+      cout << "\n";
+      cout << "#===============================================================================\n";
+      cout << "\n";
+
+      delete pclTestCaseT;
+   }
 
    cout << "\n";
    cout << "#===============================================================================\n";
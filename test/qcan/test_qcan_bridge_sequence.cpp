@@ -0,0 +1,261 @@
+//====================================================================================================================//
+// File:          test_qcan_bridge_sequence.cpp                                                                       //
+// Description:   QCAN classes - Bridge sequence tests                                                                //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_bridge_sequence.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanBridgeSequence::TestQCanBridgeSequence()                                                                   //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanBridgeSequence::TestQCanBridgeSequence()
+{
+   pclSequenceP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanBridgeSequence::~TestQCanBridgeSequence()                                                                  //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanBridgeSequence::~TestQCanBridgeSequence()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanBridgeSequence::isDuplicate()                                                                              //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool TestQCanBridgeSequence::isDuplicate(const QByteArray & clLinkIdR, const uint32_t ulSequenceV)
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 8);
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   clFrameT.toRawData(&aubDataT[0]);
+   QCanBridgeSequence::setSequence(&aubDataT[0], ulSequenceV);
+
+   return (pclSequenceP->isDuplicate(clLinkIdR, &aubDataT[0]));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanBridgeSequence::init()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanBridgeSequence::init()
+{
+   pclSequenceP = new QCanBridgeSequence();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanBridgeSequence::checkSequence()                                                                            //
+// the sequence number is stored in the sequence part of the delivery stamp                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanBridgeSequence::checkSequence()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_FD_EXT, 0x12345678, 15);
+   QCanFrame   clResultT;
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   for (uint8_t ubPosT = 0; ubPosT < 64; ubPosT++)
+   {
+      clFrameT.setData(ubPosT, static_cast< uint8_t >(ubPosT + 1));
+   }
+   clFrameT.setMarker(0xCAFE0001);
+   clFrameT.toRawData(&aubDataT[0]);
+
+   QCanBridgeSequence::setSequence(&aubDataT[0], 0x89ABCDEF);
+   QVERIFY(QCanBridgeSequence::sequence(&aubDataT[0]) == 0x89ABCDEF);
+   QVERIFY(qFromBigEndian<uint32_t>(&aubDataT[QCAN_FRAME_DELIVERY_STAMP_POS + 4]) == 0x89ABCDEF);
+
+   //---------------------------------------------------------------------------------------------------
+   // the CAN frame itself is not modified
+   //
+   clResultT.fromRawData(&aubDataT[0]);
+   QVERIFY(clResultT == clFrameT);
+   QVERIFY(clResultT.marker() == 0xCAFE0001);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanBridgeSequence::checkDuplicate()                                                                           //
+// CAN frames sent again after a connection loss are dropped                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanBridgeSequence::checkDuplicate()
+{
+   QByteArray  clLinkAT("{link-a}");
+   QByteArray  clLinkBT("{link-b}");
+
+   //---------------------------------------------------------------------------------------------------
+   // the first CAN frame of a link is accepted with any sequence number
+   //
+   QVERIFY(isDuplicate(clLinkAT, 100) == false);
+   QVERIFY(isDuplicate(clLinkAT, 101) == false);
+   QVERIFY(isDuplicate(clLinkAT, 102) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // the unacknowledged CAN frames are sent again after a reconnect
+   //
+   QVERIFY(isDuplicate(clLinkAT, 101) == true);
+   QVERIFY(isDuplicate(clLinkAT, 102) == true);
+   QVERIFY(isDuplicate(clLinkAT, 103) == false);
+   QVERIFY(isDuplicate(clLinkAT, 100) == true);
+
+   //---------------------------------------------------------------------------------------------------
+   // a gap is accepted, older CAN frames are still dropped
+   //
+   QVERIFY(isDuplicate(clLinkAT, 110) == false);
+   QVERIFY(isDuplicate(clLinkAT, 105) == true);
+   QVERIFY(isDuplicate(clLinkAT, 110) == true);
+   QVERIFY(isDuplicate(clLinkAT, 111) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // each link identifier has its own sequence number, a restarted bridge uses a new identifier
+   //
+   QVERIFY(isDuplicate(clLinkBT, 0) == false);
+   QVERIFY(isDuplicate(clLinkBT, 1) == false);
+   QVERIFY(isDuplicate(clLinkBT, 0) == true);
+   QVERIFY(isDuplicate(clLinkAT, 111) == true);
+   QVERIFY(isDuplicate(clLinkAT, 112) == false);
+
+   pclSequenceP->clear();
+   QVERIFY(isDuplicate(clLinkAT, 0) == false);
+   QVERIFY(isDuplicate(clLinkBT, 0) == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanBridgeSequence::checkWrapAround()                                                                          //
+// the comparison is valid when the sequence number wraps                                                             //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanBridgeSequence::checkWrapAround()
+{
+   QByteArray  clLinkT("{link}");
+
+   QVERIFY(isDuplicate(clLinkT, 0xFFFFFFFE) == false);
+   QVERIFY(isDuplicate(clLinkT, 0xFFFFFFFF) == false);
+   QVERIFY(isDuplicate(clLinkT, 0x00000000) == false);
+   QVERIFY(isDuplicate(clLinkT, 0x00000001) == false);
+
+   QVERIFY(isDuplicate(clLinkT, 0xFFFFFFFF) == true);
+   QVERIFY(isDuplicate(clLinkT, 0x00000001) == true);
+   QVERIFY(isDuplicate(clLinkT, 0x00000002) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // a sequence number more than 2^31 ahead is treated as old
+   //
+   QVERIFY(isDuplicate(clLinkT, 0x80000003) == true);
+   QVERIFY(isDuplicate(clLinkT, 0x80000002) == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanBridgeSequence::checkSync()                                                                                //
+// layout of the sync message                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanBridgeSequence::checkSync()
+{
+   QByteArray        clSyncT;
+   const uint8_t *   pubDataT;
+
+   clSyncT  = QCanBridgeSequence::sync(0x01020304, 0x1122334455667788ULL);
+   pubDataT = reinterpret_cast< const uint8_t * >(clSyncT.constData());
+
+   QVERIFY(clSyncT.size() == static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE));
+   QVERIFY(pubDataT[0] == QCAN_CONTROL_BRIDGE_SYNC);
+   QVERIFY(qFromBigEndian<uint32_t>(pubDataT + 4) == 0x01020304);
+   QVERIFY(qFromBigEndian<uint64_t>(pubDataT + 8) == 0x1122334455667788ULL);
+   QVERIFY(pubDataT[94] == 0xCA);
+   QVERIFY(pubDataT[QCAN_FRAME_ARRAY_SIZE - 1] == QCAN_CONTROL_MARKER);
+
+   for (uint32_t ulPosT = 16; ulPosT < 94; ulPosT++)
+   {
+      QVERIFY(pubDataT[ulPosT] == 0);
+   }
+   for (uint32_t ulPosT = 1; ulPosT < 4; ulPosT++)
+   {
+      QVERIFY(pubDataT[ulPosT] == 0);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanBridgeSequence::checkAcknowledge()                                                                         //
+// the sync message is returned as acknowledge                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanBridgeSequence::checkAcknowledge()
+{
+   QByteArray  clSyncT;
+   QByteArray  clAckT;
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 8);
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+   uint32_t    ulSequenceT = 0;
+   uint64_t    uqTimeT     = 0;
+
+   clSyncT = QCanBridgeSequence::sync(4711, 123456789);
+   clAckT  = QCanBridgeSequence::acknowledge(reinterpret_cast< const uint8_t * >(clSyncT.constData()));
+
+   QVERIFY(clAckT.size() == static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE));
+   QVERIFY(static_cast< uint8_t >(clAckT.at(0)) == QCAN_CONTROL_BRIDGE_ACK);
+   QVERIFY(clAckT.mid(1) == clSyncT.mid(1));
+
+   QVERIFY(QCanBridgeSequence::parseAcknowledge(reinterpret_cast< const uint8_t * >(clAckT.constData()),
+                                                ulSequenceT, uqTimeT) == true);
+   QVERIFY(ulSequenceT == 4711);
+   QVERIFY(uqTimeT == 123456789);
+
+   //---------------------------------------------------------------------------------------------------
+   // the sync message itself and CAN frames are not taken as acknowledge
+   //
+   QVERIFY(QCanBridgeSequence::parseAcknowledge(reinterpret_cast< const uint8_t * >(clSyncT.constData()),
+                                                ulSequenceT, uqTimeT) == false);
+
+   clFrameT.setData(0, QCAN_CONTROL_BRIDGE_ACK);
+   clFrameT.toRawData(&aubDataT[0]);
+   aubDataT[0] = QCAN_CONTROL_BRIDGE_ACK;
+   QVERIFY(aubDataT[QCAN_FRAME_ARRAY_SIZE - 1] != QCAN_CONTROL_MARKER);
+   QVERIFY(QCanBridgeSequence::parseAcknowledge(&aubDataT[0], ulSequenceT, uqTimeT) == false);
+   QVERIFY(ulSequenceT == 4711);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanBridgeSequence::cleanup()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanBridgeSequence::cleanup()
+{
+   delete pclSequenceP;
+   pclSequenceP = nullptr;
+}
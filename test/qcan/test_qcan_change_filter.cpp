@@ -0,0 +1,312 @@
+//====================================================================================================================//
+// File:          test_qcan_change_filter.cpp                                                                         //
+// Description:   QCAN classes - Change filter tests                                                                  //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_change_filter.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanChangeFilter::TestQCanChangeFilter()                                                                       //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanChangeFilter::TestQCanChangeFilter()
+{
+   pclFilterP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanChangeFilter::~TestQCanChangeFilter()                                                                      //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanChangeFilter::~TestQCanChangeFilter()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanChangeFilter::accept()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool TestQCanChangeFilter::accept(const QCanFrame & clFrameR, const uint64_t uqTimeV)
+{
+   uint8_t  aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   clFrameR.toRawData(&aubDataT[0]);
+
+   return (pclFilterP->accept(&aubDataT[0], uqTimeV));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanChangeFilter::init()                                                                                       //
+// each test case starts with a filter without refresh                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanChangeFilter::init()
+{
+   pclFilterP = new QCanChangeFilter();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanChangeFilter::checkSuppress()                                                                              //
+// unchanged CAN frames are not forwarded                                                                             //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanChangeFilter::checkSuppress()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 8);
+   uint8_t     ubPosT;
+
+   QVERIFY(pclFilterP->maxSilence() == 0);
+
+   QVERIFY(accept(clFrameT, 0) == true);
+   QVERIFY(accept(clFrameT, 1) == false);
+   QVERIFY(accept(clFrameT, 1000000) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // each data byte is evaluated, the new value is stored
+   //
+   for (ubPosT = 0; ubPosT < 8; ubPosT++)
+   {
+      clFrameT.setData(ubPosT, 0xA5);
+      QVERIFY(accept(clFrameT, 2) == true);
+      QVERIFY(accept(clFrameT, 3) == false);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // a change of the DLC is forwarded, also if the payload does not change
+   //
+   clFrameT.setDlc(4);
+   QVERIFY(accept(clFrameT, 4) == true);
+   QVERIFY(accept(clFrameT, 5) == false);
+   clFrameT.setDlc(8);
+   QVERIFY(accept(clFrameT, 6) == true);
+
+   //---------------------------------------------------------------------------------------------------
+   // the old value is forwarded again after a change
+   //
+   clFrameT.setData(0, 0x00);
+   QVERIFY(accept(clFrameT, 7) == true);
+   clFrameT.setData(0, 0xA5);
+   QVERIFY(accept(clFrameT, 8) == true);
+
+   //---------------------------------------------------------------------------------------------------
+   // other identifiers are independent
+   //
+   clFrameT.setIdentifier(0x124);
+   QVERIFY(accept(clFrameT, 9) == true);
+   QVERIFY(accept(clFrameT, 10) == false);
+   clFrameT.setIdentifier(0x123);
+   QVERIFY(accept(clFrameT, 11) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // after clear() the next CAN frame of each identifier is forwarded
+   //
+   pclFilterP->clear();
+   QVERIFY(accept(clFrameT, 12) == true);
+   QVERIFY(accept(clFrameT, 13) == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanChangeFilter::checkFormat()                                                                                //
+// standard, extended and CAN FD frames with the same identifier value                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanChangeFilter::checkFormat()
+{
+   QCanFrame   clStdT(QCanFrame::eFORMAT_CAN_STD, 0x100, 2);
+   QCanFrame   clExtT(QCanFrame::eFORMAT_CAN_EXT, 0x100, 2);
+   QCanFrame   clFdT(QCanFrame::eFORMAT_FD_STD, 0x100, 2);
+
+   QVERIFY(accept(clStdT, 0) == true);
+   QVERIFY(accept(clExtT, 0) == true);
+   QVERIFY(accept(clStdT, 1) == false);
+   QVERIFY(accept(clExtT, 1) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // a change of the frame format or the bit rate switch is forwarded
+   //
+   QVERIFY(accept(clFdT, 2) == true);
+   QVERIFY(accept(clFdT, 3) == false);
+   clFdT.setBitrateSwitch(true);
+   QVERIFY(accept(clFdT, 4) == true);
+   QVERIFY(accept(clFdT, 5) == false);
+   QVERIFY(accept(clStdT, 6) == true);
+   QVERIFY(accept(clExtT, 7) == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanChangeFilter::checkRemote()                                                                                //
+// the data field of a remote frame is not evaluated                                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanChangeFilter::checkRemote()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x200, 8);
+
+   clFrameT.setRemote(true);
+   QVERIFY(accept(clFrameT, 0) == true);
+   clFrameT.setData(0, 0x11);
+   clFrameT.setData(7, 0x22);
+   QVERIFY(accept(clFrameT, 1) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // a data frame with the same DLC is a change
+   //
+   clFrameT.setRemote(false);
+   QVERIFY(accept(clFrameT, 2) == true);
+   QVERIFY(accept(clFrameT, 3) == false);
+   clFrameT.setRemote(true);
+   QVERIFY(accept(clFrameT, 4) == true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanChangeFilter::checkFdPayload()                                                                             //
+// all 64 data bytes of a CAN FD frame are evaluated                                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanChangeFilter::checkFdPayload()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_FD_EXT, 0x18FEF100, 15);
+   uint8_t     ubPosT;
+
+   QVERIFY(accept(clFrameT, 0) == true);
+   QVERIFY(accept(clFrameT, 1) == false);
+
+   for (ubPosT = 0; ubPosT < 64; ubPosT++)
+   {
+      clFrameT.setData(ubPosT, static_cast< uint8_t >(ubPosT + 1));
+      QVERIFY(accept(clFrameT, 2) == true);
+      QVERIFY(accept(clFrameT, 3) == false);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanChangeFilter::checkResend()                                                                                //
+// unchanged CAN frames are forwarded after the maximum silence time                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanChangeFilter::checkResend()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x300, 1);
+   QCanFrame   clOtherT(QCanFrame::eFORMAT_CAN_STD, 0x301, 1);
+   uint64_t    uqTimeT;
+   uint32_t    ulCountT = 0;
+
+   pclFilterP->setMaxSilence(100);
+   QVERIFY(pclFilterP->maxSilence() == 100);
+
+   QVERIFY(accept(clFrameT, 1000) == true);
+   QVERIFY(accept(clOtherT, 1050) == true);
+   QVERIFY(accept(clFrameT, 1099) == false);
+   QVERIFY(accept(clFrameT, 1100) == true);
+   QVERIFY(accept(clOtherT, 1100) == false);
+   QVERIFY(accept(clOtherT, 1150) == true);
+
+   //---------------------------------------------------------------------------------------------------
+   // a changed value restarts the silence time
+   //
+   clFrameT.setData(0, 0x01);
+   QVERIFY(accept(clFrameT, 1150) == true);
+   QVERIFY(accept(clFrameT, 1249) == false);
+   QVERIFY(accept(clFrameT, 1250) == true);
+
+   //---------------------------------------------------------------------------------------------------
+   // a CAN frame every millisecond is forwarded every 100 ms
+   //
+   for (uqTimeT = 1251; uqTimeT <= 2250; uqTimeT++)
+   {
+      if (accept(clFrameT, uqTimeT) == true)
+      {
+         ulCountT++;
+      }
+   }
+   QVERIFY(ulCountT == 10);
+
+   //---------------------------------------------------------------------------------------------------
+   // without maximum silence time unchanged frames are never forwarded
+   //
+   pclFilterP->setMaxSilence(0);
+   QVERIFY(accept(clFrameT, 100000) == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanChangeFilter::checkErrorFrame()                                                                            //
+// error frames are always forwarded                                                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanChangeFilter::checkErrorFrame()
+{
+   QCanFrame   clFrameT(QCanFrame::eFRAME_TYPE_ERROR);
+
+   QVERIFY(accept(clFrameT, 0) == true);
+   QVERIFY(accept(clFrameT, 0) == true);
+   QVERIFY(accept(clFrameT, 1) == true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanChangeFilter::checkLimit()                                                                                 //
+// CAN frames of new identifiers are forwarded if the table is full                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanChangeFilter::checkLimit()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_EXT, 0, 0);
+   uint32_t    ulExtMaxT = QCanIdIndex::size() - 2048;
+   uint32_t    ulIdentifierT;
+
+   for (ulIdentifierT = 0; ulIdentifierT < ulExtMaxT; ulIdentifierT++)
+   {
+      clFrameT.setIdentifier(0x10000000 + ulIdentifierT);
+      QVERIFY(accept(clFrameT, 0) == true);
+   }
+
+   clFrameT.setIdentifier(0x00000001);
+   QVERIFY(accept(clFrameT, 1) == true);
+   QVERIFY(accept(clFrameT, 2) == true);
+
+   //---------------------------------------------------------------------------------------------------
+   // known identifiers are still filtered
+   //
+   clFrameT.setIdentifier(0x10000000);
+   QVERIFY(accept(clFrameT, 3) == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanChangeFilter::cleanup()                                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanChangeFilter::cleanup()
+{
+   delete pclFilterP;
+   pclFilterP = nullptr;
+}
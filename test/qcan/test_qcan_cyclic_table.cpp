@@ -0,0 +1,330 @@
+//====================================================================================================================//
+// File:          test_qcan_cyclic_table.cpp                                                                          //
+// Description:   QCAN classes - Cyclic transmit table tests                                                          //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_cyclic_table.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanCyclicTable::TestQCanCyclicTable()                                                                         //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanCyclicTable::TestQCanCyclicTable()
+{
+   pclTableP = nullptr;
+   uqTimeP   = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanCyclicTable::~TestQCanCyclicTable()                                                                        //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanCyclicTable::~TestQCanCyclicTable()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanCyclicTable::advance()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t TestQCanCyclicTable::advance(const uint64_t uqTimeV)
+{
+   uint32_t ulCountT = 0;
+
+   while (uqTimeP < uqTimeV)
+   {
+      uqTimeP++;
+      ulCountT += pclTableP->process(uqTimeP, clFrameListP);
+   }
+
+   return (ulCountT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanCyclicTable::lastFrame()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+int32_t TestQCanCyclicTable::lastFrame(const uint32_t ulIdentifierV)
+{
+   int32_t  slIdxT = clFrameListP.size() - 1;
+
+   while ((slIdxT >= 0) && (clFrameListP.at(slIdxT).identifier() != ulIdentifierV))
+   {
+      slIdxT--;
+   }
+
+   return (slIdxT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanCyclicTable::init()                                                                                        //
+// each test case starts with an empty table                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanCyclicTable::init()
+{
+   pclTableP = new QCanCyclicTable();
+   clFrameListP.clear();
+   uqTimeP = 1000;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanCyclicTable::checkDueTime()                                                                                //
+// check transmission times and rolling counter                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanCyclicTable::checkDueTime()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x100, 8);
+   uint32_t    ulCycleT;
+   int32_t     slIdxT;
+
+   //---------------------------------------------------------------------------------------------------
+   // a cycle time of 0 is rejected
+   //
+   QVERIFY(pclTableP->addFrame(1, clFrameT, 0, -1, uqTimeP) == false);
+   QVERIFY(pclTableP->count() == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // entry 1 uses a cycle time of 10 ms and a rolling counter in byte 2, entry 2 uses 3 ms
+   //
+   QVERIFY(pclTableP->addFrame(1, clFrameT, 10, 2, uqTimeP) == true);
+   clFrameT.setIdentifier(0x200);
+   QVERIFY(pclTableP->addFrame(2, clFrameT, 3, -1, uqTimeP) == true);
+   QVERIFY(pclTableP->count() == 2);
+
+   //---------------------------------------------------------------------------------------------------
+   // no transmission at the actual time, the first transmission takes place 1 ms later
+   //
+   QVERIFY(pclTableP->process(uqTimeP, clFrameListP) == 0);
+   QVERIFY(advance(1001) == 2);
+
+   //---------------------------------------------------------------------------------------------------
+   // entry 1 is transmitted at 1001 + n * 10
+   //
+   for (ulCycleT = 1; ulCycleT <= 20; ulCycleT++)
+   {
+      clFrameListP.clear();
+      advance(1000 + (ulCycleT * 10));
+      QVERIFY(pclTableP->transmitCount(1) == ulCycleT);
+
+      clFrameListP.clear();
+      advance(1001 + (ulCycleT * 10));
+      QVERIFY(pclTableP->transmitCount(1) == ulCycleT + 1);
+      slIdxT = lastFrame(0x100);
+      QVERIFY(slIdxT >= 0);
+      QVERIFY(clFrameListP.at(slIdxT).data(2) == static_cast< uint8_t >(ulCycleT));
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // entry 2 is transmitted at 1001 + n * 3 up to time 1201
+   //
+   QVERIFY(pclTableP->transmitCount(2) == 67);
+   QVERIFY(pclTableP->transmitCount(3) == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // an update of the frame keeps the cycle time and the counter
+   //
+   clFrameT.setIdentifier(0x101);
+   QVERIFY(pclTableP->updateFrame(1, clFrameT) == true);
+   QVERIFY(pclTableP->updateFrame(3, clFrameT) == false);
+   clFrameListP.clear();
+   advance(1210);
+   QVERIFY(pclTableP->transmitCount(1) == 21);
+   clFrameListP.clear();
+   advance(1211);
+   QVERIFY(pclTableP->transmitCount(1) == 22);
+   slIdxT = lastFrame(0x101);
+   QVERIFY(slIdxT >= 0);
+   QVERIFY(clFrameListP.at(slIdxT).data(2) == 21);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanCyclicTable::checkLongPeriod()                                                                             //
+// cycle times longer than one revolution of the timer wheel                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanCyclicTable::checkLongPeriod()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_EXT, 0x1000, 4);
+
+   QVERIFY(pclTableP->addFrame(1, clFrameT, 1000, -1, uqTimeP) == true);
+   QVERIFY(pclTableP->addFrame(2, clFrameT, 256, -1, uqTimeP) == true);
+   QVERIFY(pclTableP->addFrame(3, clFrameT, 257, -1, uqTimeP) == true);
+
+   QVERIFY(advance(1001) == 3);
+
+   //---------------------------------------------------------------------------------------------------
+   // entry 1 is not transmitted when its slot is visited before the due time
+   //
+   advance(2000);
+   QVERIFY(pclTableP->transmitCount(1) == 1);
+   advance(2001);
+   QVERIFY(pclTableP->transmitCount(1) == 2);
+   advance(3000);
+   QVERIFY(pclTableP->transmitCount(1) == 2);
+   advance(3001);
+   QVERIFY(pclTableP->transmitCount(1) == 3);
+
+   //---------------------------------------------------------------------------------------------------
+   // entry 2: 1001 + n * 256, entry 3: 1001 + n * 257 up to time 3001
+   //
+   QVERIFY(pclTableP->transmitCount(2) == 8);
+   QVERIFY(pclTableP->transmitCount(3) == 8);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanCyclicTable::checkRemove()                                                                                 //
+// remove and add entries through the free list                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanCyclicTable::checkRemove()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x001, 1);
+   uint32_t    ulHandleT;
+
+   //---------------------------------------------------------------------------------------------------
+   // fill the table, all entries use a different identifier
+   //
+   for (ulHandleT = 0; ulHandleT < QCAN_CYCLIC_FRAME_MAX; ulHandleT++)
+   {
+      clFrameT.setIdentifier(ulHandleT);
+      QVERIFY(pclTableP->addFrame(ulHandleT, clFrameT, 5 + (ulHandleT % 7), -1, uqTimeP) == true);
+   }
+   QVERIFY(pclTableP->count() == QCAN_CYCLIC_FRAME_MAX);
+   QVERIFY(pclTableP->addFrame(1000, clFrameT, 10, -1, uqTimeP) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // an existing handle is replaced, the number of entries does not change
+   //
+   clFrameT.setIdentifier(0x7FF);
+   QVERIFY(pclTableP->addFrame(10, clFrameT, 10, -1, uqTimeP) == true);
+   QVERIFY(pclTableP->count() == QCAN_CYCLIC_FRAME_MAX);
+
+   QVERIFY(advance(1001) == QCAN_CYCLIC_FRAME_MAX);
+
+   //---------------------------------------------------------------------------------------------------
+   // remove two entries, the free entries are used again
+   //
+   QVERIFY(pclTableP->removeFrame(20) == true);
+   QVERIFY(pclTableP->removeFrame(20) == false);
+   QVERIFY(pclTableP->removeFrame(30) == true);
+   QVERIFY(pclTableP->count() == QCAN_CYCLIC_FRAME_MAX - 2);
+   QVERIFY(pclTableP->transmitCount(20) == 0);
+
+   clFrameT.setIdentifier(0x555);
+   QVERIFY(pclTableP->addFrame(1000, clFrameT, 10, -1, uqTimeP) == true);
+   QVERIFY(pclTableP->addFrame(1001, clFrameT, 10, -1, uqTimeP) == true);
+   QVERIFY(pclTableP->addFrame(1002, clFrameT, 10, -1, uqTimeP) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // the removed entries are not transmitted anymore
+   //
+   clFrameListP.clear();
+   advance(1100);
+   for (int32_t slIdxT = 0; slIdxT < clFrameListP.size(); slIdxT++)
+   {
+      QVERIFY(clFrameListP.at(slIdxT).identifier() != 20);
+      QVERIFY(clFrameListP.at(slIdxT).identifier() != 30);
+   }
+   QVERIFY(pclTableP->transmitCount(10) == 10);
+   QVERIFY(pclTableP->transmitCount(1000) == 10);
+
+   //---------------------------------------------------------------------------------------------------
+   // clear() returns all entries to the free list
+   //
+   pclTableP->clear();
+   QVERIFY(pclTableP->count() == 0);
+   clFrameListP.clear();
+   QVERIFY(advance(1200) == 0);
+   for (ulHandleT = 0; ulHandleT < QCAN_CYCLIC_FRAME_MAX; ulHandleT++)
+   {
+      QVERIFY(pclTableP->addFrame(ulHandleT, clFrameT, 10, -1, uqTimeP) == true);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanCyclicTable::checkStall()                                                                                  //
+// catch up after a stall of more than one revolution of the timer wheel                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanCyclicTable::checkStall()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 0);
+
+   QVERIFY(pclTableP->addFrame(1, clFrameT, 10, -1, uqTimeP) == true);
+   QVERIFY(pclTableP->addFrame(2, clFrameT, 1000, -1, uqTimeP) == true);
+   QVERIFY(advance(1001) == 2);
+
+   //---------------------------------------------------------------------------------------------------
+   // a stall shorter than one revolution: the missed transmissions are skipped
+   //
+   uqTimeP = 1100;
+   QVERIFY(pclTableP->process(uqTimeP, clFrameListP) == 1);
+   QVERIFY(pclTableP->transmitCount(1) == 2);
+
+   //---------------------------------------------------------------------------------------------------
+   // the phase is kept: next transmission of entry 1 at 1101
+   //
+   uqTimeP = 1101;
+   QVERIFY(pclTableP->process(uqTimeP, clFrameListP) == 1);
+
+   //---------------------------------------------------------------------------------------------------
+   // a stall of several revolutions: each entry is transmitted only once
+   //
+   uqTimeP = 6000;
+   QVERIFY(pclTableP->process(uqTimeP, clFrameListP) == 2);
+   QVERIFY(pclTableP->transmitCount(1) == 4);
+   QVERIFY(pclTableP->transmitCount(2) == 2);
+
+   //---------------------------------------------------------------------------------------------------
+   // the phase is kept: entry 1 is due at 6001, entry 2 at 6001
+   //
+   QVERIFY(advance(6001) == 2);
+   QVERIFY(advance(6010) == 0);
+   QVERIFY(advance(6011) == 1);
+   QVERIFY(advance(7000) == 98);
+   QVERIFY(advance(7001) == 2);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanCyclicTable::cleanup()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanCyclicTable::cleanup()
+{
+   delete pclTableP;
+   pclTableP = nullptr;
+}
@@ -0,0 +1,88 @@
+//====================================================================================================================//
+// File:          test_qcan_cyclic_table.hpp                                                                          //
+// Description:   QCAN classes - Cyclic transmit table tests                                                          //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#ifndef TEST_QCAN_CYCLIC_TABLE_HPP_
+#define TEST_QCAN_CYCLIC_TABLE_HPP_
+
+
+#include <QtTest/QTest>
+
+#include "qcan_cyclic_table.hpp"
+
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \class   TestQCanCyclicTable
+** \brief   Test cyclic transmit table
+**
+** The time base of the table is supplied by the caller, the test cases advance a simulated clock
+** with a resolution of 1 ms.
+*/
+class TestQCanCyclicTable : public QObject
+{
+   Q_OBJECT
+
+public:
+
+   TestQCanCyclicTable();
+
+   ~TestQCanCyclicTable();
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // advance the simulated clock in steps of 1 ms up to uqTimeV, return number of transmitted frames
+   //
+   uint32_t             advance(const uint64_t uqTimeV);
+
+   //---------------------------------------------------------------------------------------------------
+   // return index of the last transmitted frame with the identifier ulIdentifierV, -1 if not found
+   //
+   int32_t              lastFrame(const uint32_t ulIdentifierV);
+
+   QCanCyclicTable *    pclTableP;
+   QVector<QCanFrame>   clFrameListP;
+   uint64_t             uqTimeP;
+
+private slots:
+
+   void init();
+
+   void checkDueTime();
+   void checkLongPeriod();
+   void checkRemove();
+   void checkStall();
+
+   void cleanup();
+};
+
+
+#endif   // TEST_QCAN_CYCLIC_TABLE_HPP_
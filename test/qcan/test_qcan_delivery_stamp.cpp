@@ -0,0 +1,191 @@
+//====================================================================================================================//
+// File:          test_qcan_delivery_stamp.cpp                                                                        //
+// Description:   QCAN classes - Delivery stamp tests                                                                 //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_delivery_stamp.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanDeliveryStamp::TestQCanDeliveryStamp()                                                                     //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanDeliveryStamp::TestQCanDeliveryStamp()
+{
+   pclStampP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanDeliveryStamp::~TestQCanDeliveryStamp()                                                                    //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanDeliveryStamp::~TestQCanDeliveryStamp()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanDeliveryStamp::init()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanDeliveryStamp::init()
+{
+   pclStampP = new QCanDeliveryStamp();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanDeliveryStamp::checkLayout()                                                                               //
+// time and sequence number are stored big-endian in the delivery stamp                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanDeliveryStamp::checkLayout()
+{
+   QCanFrame         clFrameT(QCanFrame::eFORMAT_FD_EXT, 0x12345678, 15);
+   QCanFrame         clResultT;
+   QObject           clSocketT;
+   uint8_t           aubDataT[QCAN_FRAME_ARRAY_SIZE];
+   uint8_t           aubCopyT[QCAN_FRAME_ARRAY_SIZE];
+   const uint8_t *   pubStampT;
+
+   for (uint8_t ubPosT = 0; ubPosT < 64; ubPosT++)
+   {
+      clFrameT.setData(ubPosT, static_cast< uint8_t >(ubPosT + 1));
+   }
+   clFrameT.setMarker(0xCAFE0001);
+   clFrameT.toRawData(&aubDataT[0]);
+
+   //---------------------------------------------------------------------------------------------------
+   // the time is written at the start of the delivery stamp, the sequence number is cleared
+   //
+   aubDataT[QCAN_FRAME_DELIVERY_STAMP_POS + 4] = 0xFF;
+   QCanDeliveryStamp::setTime(&aubDataT[0], 0x01020304);
+   QVERIFY(aubDataT[QCAN_FRAME_DELIVERY_STAMP_POS + 0] == 0x01);
+   QVERIFY(aubDataT[QCAN_FRAME_DELIVERY_STAMP_POS + 1] == 0x02);
+   QVERIFY(aubDataT[QCAN_FRAME_DELIVERY_STAMP_POS + 2] == 0x03);
+   QVERIFY(aubDataT[QCAN_FRAME_DELIVERY_STAMP_POS + 3] == 0x04);
+   QVERIFY(QCanDeliveryStamp::time(&aubDataT[0]) == 0x01020304);
+   QVERIFY(QCanDeliveryStamp::sequence(&aubDataT[0]) == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // the stamped copy differs from the CAN frame in the sequence part only
+   //
+   memcpy(&aubCopyT[0], &aubDataT[0], QCAN_FRAME_ARRAY_SIZE);
+   pclStampP->stamp(&clSocketT, &aubDataT[0]);
+   pubStampT = pclStampP->stamp(&clSocketT, &aubDataT[0]);
+   QVERIFY(pubStampT != &aubDataT[0]);
+   QVERIFY(qFromBigEndian<uint32_t>(pubStampT + QCAN_FRAME_DELIVERY_STAMP_POS + 4) == 1);
+   for (uint32_t ulPosT = 0; ulPosT < QCAN_FRAME_ARRAY_SIZE; ulPosT++)
+   {
+      if ((ulPosT < QCAN_FRAME_DELIVERY_STAMP_POS + 4) || (ulPosT >= QCAN_FRAME_DELIVERY_STAMP_POS + 8))
+      {
+         QVERIFY(pubStampT[ulPosT] == aubDataT[ulPosT]);
+      }
+   }
+   QVERIFY(memcmp(&aubCopyT[0], &aubDataT[0], QCAN_FRAME_ARRAY_SIZE) == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // the CAN frame itself is not modified
+   //
+   clResultT.fromRawData(pubStampT);
+   QVERIFY(clResultT == clFrameT);
+   QVERIFY(clResultT.marker() == 0xCAFE0001);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanDeliveryStamp::checkSequence()                                                                             //
+// each socket counts its own sequence number                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanDeliveryStamp::checkSequence()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 8);
+   QObject     clSocketAT;
+   QObject     clSocketBT;
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+   uint32_t    ulCountT;
+
+   clFrameT.toRawData(&aubDataT[0]);
+   QCanDeliveryStamp::setTime(&aubDataT[0], 4711);
+
+   //---------------------------------------------------------------------------------------------------
+   // socket B only receives every second CAN frame, the sequence numbers of both sockets are
+   // consecutive and the shared CAN frame keeps the sequence number 0
+   //
+   for (ulCountT = 0; ulCountT < 100; ulCountT++)
+   {
+      QVERIFY(QCanDeliveryStamp::sequence(pclStampP->stamp(&clSocketAT, &aubDataT[0])) == ulCountT);
+      if ((ulCountT % 2) == 0)
+      {
+         QVERIFY(QCanDeliveryStamp::sequence(pclStampP->stamp(&clSocketBT, &aubDataT[0])) == ulCountT / 2);
+      }
+      QVERIFY(QCanDeliveryStamp::sequence(&aubDataT[0]) == 0);
+      QVERIFY(QCanDeliveryStamp::time(&aubDataT[0]) == 4711);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanDeliveryStamp::checkRemove()                                                                               //
+// removed sockets start again with sequence number 0                                                                 //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanDeliveryStamp::checkRemove()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 8);
+   QObject     clSocketAT;
+   QObject     clSocketBT;
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   clFrameT.toRawData(&aubDataT[0]);
+   QCanDeliveryStamp::setTime(&aubDataT[0], 4711);
+
+   pclStampP->stamp(&clSocketAT, &aubDataT[0]);
+   pclStampP->stamp(&clSocketAT, &aubDataT[0]);
+   pclStampP->stamp(&clSocketBT, &aubDataT[0]);
+
+   pclStampP->remove(&clSocketAT);
+   QVERIFY(QCanDeliveryStamp::sequence(pclStampP->stamp(&clSocketAT, &aubDataT[0])) == 0);
+   QVERIFY(QCanDeliveryStamp::sequence(pclStampP->stamp(&clSocketBT, &aubDataT[0])) == 1);
+
+   pclStampP->clear();
+   QVERIFY(QCanDeliveryStamp::sequence(pclStampP->stamp(&clSocketAT, &aubDataT[0])) == 0);
+   QVERIFY(QCanDeliveryStamp::sequence(pclStampP->stamp(&clSocketBT, &aubDataT[0])) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanDeliveryStamp::cleanup()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanDeliveryStamp::cleanup()
+{
+   delete pclStampP;
+   pclStampP = nullptr;
+}
@@ -0,0 +1,252 @@
+//====================================================================================================================//
+// File:          test_qcan_error_coalescing.cpp                                                                      //
+// Description:   QCAN classes - Error frame coalescing tests                                                         //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_error_coalescing.hpp"
+
+
+//------------------------------------------------------------------------------------------------------
+// coalescing window in milliseconds and the conversion of milliseconds to nanoseconds
+//
+constexpr uint32_t   TEST_WINDOW       = 100;
+constexpr uint64_t   TEST_NSEC_PER_MS  = 1000000;
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanErrorCoalescing::TestQCanErrorCoalescing()                                                                 //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanErrorCoalescing::TestQCanErrorCoalescing()
+{
+   pclCoalescingP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanErrorCoalescing::~TestQCanErrorCoalescing()                                                                //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanErrorCoalescing::~TestQCanErrorCoalescing()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanErrorCoalescing::errorFrame()                                                                              //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanFrame TestQCanErrorCoalescing::errorFrame(const QCan::CAN_State_e teStateV, const uint8_t ubCounterV,
+                                              const uint32_t ulTimeV)
+{
+   QCanFrame   clErrorFrameT;
+
+   clErrorFrameT.setFrameType(QCanFrame::eFRAME_TYPE_ERROR);
+   clErrorFrameT.setErrorState(teStateV);
+   clErrorFrameT.setErrorType(QCanFrame::eERROR_TYPE_ACK);
+   clErrorFrameT.setErrorCounterReceive(0);
+   clErrorFrameT.setErrorCounterTransmit(ubCounterV);
+   clErrorFrameT.setTimeStamp(QCanTimeStamp(ulTimeV / 1000, (ulTimeV % 1000) * 1000000));
+
+   return (clErrorFrameT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanErrorCoalescing::init()                                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanErrorCoalescing::init()
+{
+   pclCoalescingP = new QCanErrorCoalescing();
+   pclCoalescingP->setWindow(TEST_WINDOW);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanErrorCoalescing::checkMerge()                                                                              //
+// identical error frames are merged into a single error frame                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanErrorCoalescing::checkMerge()
+{
+   QCanFrame   clMergedT;
+   uint64_t    uqIngressT = 0;
+   uint32_t    ulTimeT;
+
+   QVERIFY(pclCoalescingP->isRunning() == false);
+   QVERIFY(pclCoalescingP->merge(errorFrame(QCan::eCAN_STATE_BUS_WARN, 96, 0), 0) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // the first error frame is dispatched by the caller and starts the run
+   //
+   pclCoalescingP->start(errorFrame(QCan::eCAN_STATE_BUS_WARN, 96, 0), 0);
+   QVERIFY(pclCoalescingP->isRunning());
+   QVERIFY(pclCoalescingP->takeMerged(clMergedT, uqIngressT) == false);
+
+   for (ulTimeT = 1; ulTimeT <= 50; ulTimeT++)
+   {
+      QVERIFY(pclCoalescingP->merge(errorFrame(QCan::eCAN_STATE_BUS_WARN, 96, ulTimeT), ulTimeT * TEST_NSEC_PER_MS));
+   }
+   QVERIFY(pclCoalescingP->pendingCount() == 50);
+
+   //---------------------------------------------------------------------------------------------------
+   // the merged error frame is the last one, it carries the number of merged frames and the time
+   // stamp of the first merged frame
+   //
+   QVERIFY(pclCoalescingP->takeMerged(clMergedT, uqIngressT));
+   QVERIFY(uqIngressT == 50 * TEST_NSEC_PER_MS);
+   QVERIFY(clMergedT.errorRepeatCount() == 50);
+   QVERIFY(clMergedT.errorTimeStampFirst() == QCanTimeStamp(0, 1000000));
+   QVERIFY(clMergedT.timeStamp() == QCanTimeStamp(0, 50000000));
+   QVERIFY(clMergedT.errorState() == QCan::eCAN_STATE_BUS_WARN);
+   QVERIFY(clMergedT.errorCounterTransmit() == 96);
+
+   //---------------------------------------------------------------------------------------------------
+   // the run continues with the next window
+   //
+   QVERIFY(pclCoalescingP->pendingCount() == 0);
+   QVERIFY(pclCoalescingP->takeMerged(clMergedT, uqIngressT) == false);
+   QVERIFY(pclCoalescingP->isRunning());
+   QVERIFY(pclCoalescingP->merge(errorFrame(QCan::eCAN_STATE_BUS_WARN, 96, 60), 60 * TEST_NSEC_PER_MS));
+   QVERIFY(pclCoalescingP->takeMerged(clMergedT, uqIngressT));
+   QVERIFY(clMergedT.errorRepeatCount() == 1);
+   QVERIFY(clMergedT.errorTimeStampFirst() == QCanTimeStamp(0, 60000000));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanErrorCoalescing::checkStateTransition()                                                                    //
+// a state transition is dispatched inside the window                                                                 //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanErrorCoalescing::checkStateTransition()
+{
+   QCanFrame   clBusOffT = errorFrame(QCan::eCAN_STATE_BUS_OFF, 255, 20);
+   QCanFrame   clMergedT;
+   uint64_t    uqIngressT = 0;
+
+   pclCoalescingP->start(errorFrame(QCan::eCAN_STATE_BUS_PASSIVE, 200, 0), 0);
+   QVERIFY(pclCoalescingP->merge(errorFrame(QCan::eCAN_STATE_BUS_PASSIVE, 200, 10), 10 * TEST_NSEC_PER_MS));
+   QVERIFY(pclCoalescingP->merge(errorFrame(QCan::eCAN_STATE_BUS_PASSIVE, 200, 15), 15 * TEST_NSEC_PER_MS));
+
+   //---------------------------------------------------------------------------------------------------
+   // the bus-off frame arrives long before the window has elapsed: it is not merged and the run is
+   // not modified
+   //
+   QVERIFY(pclCoalescingP->isWindowElapsed(20 * TEST_NSEC_PER_MS) == false);
+   QVERIFY(pclCoalescingP->merge(clBusOffT, 20 * TEST_NSEC_PER_MS) == false);
+   QVERIFY(pclCoalescingP->pendingCount() == 2);
+
+   //---------------------------------------------------------------------------------------------------
+   // like QCanNetwork: the merged frames are dispatched first, the bus-off frame starts a new run
+   // and is dispatched immediately
+   //
+   QVERIFY(pclCoalescingP->takeMerged(clMergedT, uqIngressT));
+   QVERIFY(clMergedT.errorState() == QCan::eCAN_STATE_BUS_PASSIVE);
+   QVERIFY(clMergedT.errorRepeatCount() == 2);
+   QVERIFY(uqIngressT == 15 * TEST_NSEC_PER_MS);
+   pclCoalescingP->stop();
+   pclCoalescingP->start(clBusOffT, 20 * TEST_NSEC_PER_MS);
+
+   QVERIFY(pclCoalescingP->merge(errorFrame(QCan::eCAN_STATE_BUS_PASSIVE, 200, 25), 25 * TEST_NSEC_PER_MS) == false);
+   QVERIFY(pclCoalescingP->merge(errorFrame(QCan::eCAN_STATE_BUS_OFF, 255, 25), 25 * TEST_NSEC_PER_MS));
+   QVERIFY(pclCoalescingP->isWindowElapsed(119 * TEST_NSEC_PER_MS) == false);
+   QVERIFY(pclCoalescingP->isWindowElapsed(120 * TEST_NSEC_PER_MS));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanErrorCoalescing::checkCounterChange()                                                                      //
+// error frames with different error type or counters are not merged                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanErrorCoalescing::checkCounterChange()
+{
+   QCanFrame   clErrorFrameT = errorFrame(QCan::eCAN_STATE_BUS_WARN, 96, 1);
+
+   pclCoalescingP->start(errorFrame(QCan::eCAN_STATE_BUS_WARN, 96, 0), 0);
+
+   QVERIFY(pclCoalescingP->merge(errorFrame(QCan::eCAN_STATE_BUS_WARN, 104, 1), TEST_NSEC_PER_MS) == false);
+
+   clErrorFrameT.setErrorCounterReceive(1);
+   QVERIFY(pclCoalescingP->merge(clErrorFrameT, TEST_NSEC_PER_MS) == false);
+
+   clErrorFrameT = errorFrame(QCan::eCAN_STATE_BUS_WARN, 96, 1);
+   clErrorFrameT.setErrorType(QCanFrame::eERROR_TYPE_CRC);
+   QVERIFY(pclCoalescingP->merge(clErrorFrameT, TEST_NSEC_PER_MS) == false);
+
+   QVERIFY(pclCoalescingP->pendingCount() == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanErrorCoalescing::checkWindow()                                                                             //
+// the window starts with the run and is restarted after each dispatch                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanErrorCoalescing::checkWindow()
+{
+   pclCoalescingP->start(errorFrame(QCan::eCAN_STATE_BUS_WARN, 96, 0), 1000 * TEST_NSEC_PER_MS);
+
+   QVERIFY(pclCoalescingP->isWindowElapsed(1099 * TEST_NSEC_PER_MS) == false);
+   QVERIFY(pclCoalescingP->isWindowElapsed(1100 * TEST_NSEC_PER_MS));
+
+   pclCoalescingP->restartWindow(1150 * TEST_NSEC_PER_MS);
+   QVERIFY(pclCoalescingP->isWindowElapsed(1249 * TEST_NSEC_PER_MS) == false);
+   QVERIFY(pclCoalescingP->isWindowElapsed(1250 * TEST_NSEC_PER_MS));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanErrorCoalescing::checkDisable()                                                                            //
+// the window 0 stops the active run                                                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanErrorCoalescing::checkDisable()
+{
+   QCanFrame   clMergedT;
+   uint64_t    uqIngressT = 0;
+
+   pclCoalescingP->start(errorFrame(QCan::eCAN_STATE_BUS_WARN, 96, 0), 0);
+   QVERIFY(pclCoalescingP->merge(errorFrame(QCan::eCAN_STATE_BUS_WARN, 96, 1), TEST_NSEC_PER_MS));
+
+   pclCoalescingP->setWindow(0);
+   QVERIFY(pclCoalescingP->window() == 0);
+   QVERIFY(pclCoalescingP->isRunning() == false);
+   QVERIFY(pclCoalescingP->takeMerged(clMergedT, uqIngressT) == false);
+   QVERIFY(pclCoalescingP->merge(errorFrame(QCan::eCAN_STATE_BUS_WARN, 96, 2), 2 * TEST_NSEC_PER_MS) == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanErrorCoalescing::cleanup()                                                                                 //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanErrorCoalescing::cleanup()
+{
+   delete pclCoalescingP;
+   pclCoalescingP = nullptr;
+}
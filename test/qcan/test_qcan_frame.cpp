@@ -218,7 +218,51 @@ void TestQCanFrame::checkConversion()
 //--------------------------------------------------------------------------------------------------------------------//
 void TestQCanFrame::checkErrorFrame()
 {
+   QCanFrame   clErrorFrameT;
+   QCanFrame   clRawFrameT;
+   uint8_t     aubRawDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   clErrorFrameT.setFrameType(QCanFrame::eFRAME_TYPE_ERROR);
+   clErrorFrameT.setErrorState(QCan::eCAN_STATE_BUS_WARN);
+   clErrorFrameT.setErrorCounterReceive(32);
+   clErrorFrameT.setErrorCounterTransmit(96);
+   QVERIFY(clErrorFrameT.errorState()           == QCan::eCAN_STATE_BUS_WARN);
+   QVERIFY(clErrorFrameT.errorCounterReceive()  == 32);
+   QVERIFY(clErrorFrameT.errorCounterTransmit() == 96);
+   QVERIFY(clErrorFrameT.errorRepeatCount()     == 0);
 
+   //---------------------------------------------------------------------------------------------------
+   // coalesced error frame: repeat count and first time stamp survive the conversion to raw data
+   //
+   clErrorFrameT.setErrorRepeatCount(1000);
+   clErrorFrameT.setErrorTimeStampFirst(QCanTimeStamp(12, 500000));
+   clErrorFrameT.setTimeStamp(QCanTimeStamp(13, 250000));
+   clErrorFrameT.toRawData(&aubRawDataT[0]);
+   QVERIFY(clRawFrameT.fromRawData(&aubRawDataT[0]) == true);
+   QVERIFY(clRawFrameT.errorRepeatCount()     == 1000);
+   QVERIFY(clRawFrameT.errorTimeStampFirst()  == QCanTimeStamp(12, 500000));
+   QVERIFY(clRawFrameT.timeStamp()            == QCanTimeStamp(13, 250000));
+   QVERIFY(clRawFrameT.errorCounterTransmit() == 96);
+   QVERIFY((aubRawDataT[5] & QCAN_FRAME_ERROR_REPEAT_FLAG) > 0);
+   QVERIFY(clRawFrameT.frameType() == QCanFrame::eFRAME_TYPE_ERROR);
+
+   //---------------------------------------------------------------------------------------------------
+   // data bytes 4 .. 15 of an error frame which has not been coalesced are not evaluated
+   //
+   clErrorFrameT.setFrameType(QCanFrame::eFRAME_TYPE_ERROR);
+   QVERIFY(clErrorFrameT.errorRepeatCount() == 0);
+   clErrorFrameT.toRawData(&aubRawDataT[0]);
+   QVERIFY((aubRawDataT[5] & QCAN_FRAME_ERROR_REPEAT_FLAG) == 0);
+   memset(&aubRawDataT[QCAN_FRAME_ERROR_REPEAT_POS], 0xA5, 12);
+   QVERIFY(clRawFrameT.fromRawData(&aubRawDataT[0]) == true);
+   QVERIFY(clRawFrameT.errorRepeatCount()    == 0);
+   QVERIFY(clRawFrameT.errorTimeStampFirst() == QCanTimeStamp());
+
+   //---------------------------------------------------------------------------------------------------
+   // the repeat count has no impact on a data frame
+   //
+   pclCanStdP->setErrorRepeatCount(1000);
+   QVERIFY(pclCanStdP->errorRepeatCount() == 0);
 }
 
 
@@ -631,6 +675,63 @@ void TestQCanFrame::checkOutput()
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrame::checkRawData()                                                                                      //
+// test conversion from / to raw data at an unaligned address                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrame::checkRawData()
+{
+   uint8_t     aubBufferT[QCAN_FRAME_ARRAY_SIZE + 1];
+   uint8_t *   pubDataT = &aubBufferT[1];
+   QByteArray  clByteArrayT;
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_FD_EXT, TEST_VALUE_ID_EXT, 15);
+
+   clFrameT.setData(0, TEST_VALUE_DATA);
+   clFrameT.setData(63, 0x5A);
+   clFrameT.setMarker(TEST_VALUE_MARKER);
+   clFrameT.setUser(TEST_VALUE_USER);
+
+   //---------------------------------------------------------------------------------------------------
+   // the raw data has the same layout as the byte array, multi-byte fields are stored MSB first
+   //
+   clFrameT.toRawData(pubDataT);
+   clByteArrayT = clFrameT.toByteArray();
+   QVERIFY(memcmp(pubDataT, clByteArrayT.constData(), QCAN_FRAME_ARRAY_SIZE) == 0);
+
+   QVERIFY(pubDataT[0]  == 0x01);
+   QVERIFY(pubDataT[1]  == 0xB2);
+   QVERIFY(pubDataT[2]  == 0xF4);
+   QVERIFY(pubDataT[3]  == 0x05);
+   QVERIFY(pubDataT[4]  == 15);
+   QVERIFY(pubDataT[6]  == TEST_VALUE_DATA);
+   QVERIFY(pubDataT[69] == 0x5A);
+   QVERIFY(pubDataT[78] == 0xAB);
+   QVERIFY(pubDataT[82] == 0x98);
+   QVERIFY(pubDataT[85] == 0x32);
+   QVERIFY(pubDataT[94] == 0xCA);
+   QVERIFY(pubDataT[95] == 0x01);
+
+   //---------------------------------------------------------------------------------------------------
+   // convert back
+   //
+   QVERIFY(pclFrameP->fromRawData(pubDataT) == true);
+   QVERIFY(pclFrameP->frameFormat() == QCanFrame::eFORMAT_FD_EXT);
+   QVERIFY(pclFrameP->identifier()  == TEST_VALUE_ID_EXT);
+   QVERIFY(pclFrameP->dlc()         == 15);
+   QVERIFY(pclFrameP->data(0)       == TEST_VALUE_DATA);
+   QVERIFY(pclFrameP->data(63)      == 0x5A);
+   QVERIFY(pclFrameP->marker()      == TEST_VALUE_MARKER);
+   QVERIFY(pclFrameP->user()        == TEST_VALUE_USER);
+
+   //---------------------------------------------------------------------------------------------------
+   // invalid pointer and invalid marker at the end are rejected
+   //
+   QVERIFY(pclFrameP->fromRawData(nullptr) == false);
+   pubDataT[95] = 0x00;
+   QVERIFY(pclFrameP->fromRawData(pubDataT) == false);
+}
+
+
 //--------------------------------------------------------------------------------------------------------------------//
 // TestQCanFrame::cleanupTestCase()                                                                                   //
 //                                                                                                                    //
@@ -88,6 +88,8 @@ private slots:
 
    void checkOutput();
 
+   void checkRawData();
+
    void cleanupTestCase();
 };
 
@@ -0,0 +1,257 @@
+//====================================================================================================================//
+// File:          test_qcan_frame_bits.cpp                                                                            //
+// Description:   QCAN classes - CAN frame bit length tests                                                           //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_frame_bits.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameBits::TestQCanFrameBits()                                                                             //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanFrameBits::TestQCanFrameBits()
+{
+   ulNomBitsP = 0;
+   ulDatBitsP = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameBits::~TestQCanFrameBits()                                                                            //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanFrameBits::~TestQCanFrameBits()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameBits::count()                                                                                         //
+// btOptionV selects a remote frame for Classic CAN and the bit rate switch for CAN FD                                //
+//--------------------------------------------------------------------------------------------------------------------//
+uint32_t TestQCanFrameBits::count(const QCanFrame::FrameFormat_e teFormatV, const uint32_t ulIdentifierV,
+                                  const uint8_t ubDlcV, const uint8_t ubDataV, const bool btOptionV)
+{
+   QCanFrame   clFrameT(teFormatV, ulIdentifierV, ubDlcV);
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   for (uint8_t ubPosT = 0; ubPosT < clFrameT.dataSize(); ubPosT++)
+   {
+      clFrameT.setData(ubPosT, ubDataV);
+   }
+
+   if (teFormatV < QCanFrame::eFORMAT_FD_STD)
+   {
+      clFrameT.setRemote(btOptionV);
+   }
+   else
+   {
+      clFrameT.setBitrateSwitch(btOptionV);
+   }
+
+   clFrameT.toRawData(&aubDataT[0]);
+
+   return (QCanFrameBits::count(&aubDataT[0], ulNomBitsP, ulDatBitsP));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameBits::checkClassicStd()                                                                               //
+// Classic CAN standard frames: 19 header bits, CRC-15 and 13 trailer bits                                            //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrameBits::checkClassicStd()
+{
+   //---------------------------------------------------------------------------------------------------
+   // 47 bits without data, the identifier 123h causes one stuff bit
+   //
+   QVERIFY(count(QCanFrame::eFORMAT_CAN_STD, 0x123, 0, 0x55) == 48);
+   QVERIFY(ulNomBitsP == 48);
+   QVERIFY(ulDatBitsP == 0);
+
+   QVERIFY(count(QCanFrame::eFORMAT_CAN_STD, 0x123, 8, 0x55) == 112);
+   QVERIFY(ulNomBitsP == 112);
+   QVERIFY(ulDatBitsP == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // a remote frame has no data field, the DLC value is part of the CRC
+   //
+   QVERIFY(count(QCanFrame::eFORMAT_CAN_STD, 0x123, 0, 0x55, true) == 48);
+   QVERIFY(count(QCanFrame::eFORMAT_CAN_STD, 0x123, 8, 0x55, true) == 48);
+   QVERIFY(ulDatBitsP == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameBits::checkClassicExt()                                                                               //
+// Classic CAN extended frames: 39 header bits, CRC-15 and 13 trailer bits                                            //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrameBits::checkClassicExt()
+{
+   QVERIFY(count(QCanFrame::eFORMAT_CAN_EXT, 0x12345678, 0, 0x55) == 69);
+   QVERIFY(ulNomBitsP == 69);
+   QVERIFY(ulDatBitsP == 0);
+
+   QVERIFY(count(QCanFrame::eFORMAT_CAN_EXT, 0x12345678, 8, 0x55) == 132);
+   QVERIFY(ulNomBitsP == 132);
+   QVERIFY(ulDatBitsP == 0);
+
+   QVERIFY(count(QCanFrame::eFORMAT_CAN_EXT, 0x12345678, 0, 0x55, true) == 69);
+   QVERIFY(count(QCanFrame::eFORMAT_CAN_EXT, 0x12345678, 8, 0x55, true) == 67);
+   QVERIFY(ulDatBitsP == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameBits::checkFdCrc17()                                                                                  //
+// CAN FD frames with up to 16 data bytes                                                                             //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrameBits::checkFdCrc17()
+{
+   //---------------------------------------------------------------------------------------------------
+   // The data value 55h causes no dynamic stuff bits, so the data phase consists of ESI and DLC (5),
+   // the data field, the stuff count (4), the CRC-17 and 6 fixed stuff bits. The arbitration phase
+   // (17 bits, no stuff bits for identifier 123h) and the trailer (13 bits) take 30 bits.
+   //
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x123,  9, 0x55, true) == 158);
+   QVERIFY(ulNomBitsP == 30);
+   QVERIFY(ulDatBitsP == 5 + (12 * 8) + 4 + 17 + 6);
+
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x123, 10, 0x55, true) == 190);
+   QVERIFY(ulNomBitsP == 30);
+   QVERIFY(ulDatBitsP == 5 + (16 * 8) + 4 + 17 + 6);
+
+   //---------------------------------------------------------------------------------------------------
+   // without bit rate switch all bits are counted in the arbitration phase
+   //
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x123,  9, 0x55, false) == 158);
+   QVERIFY(ulNomBitsP == 158);
+   QVERIFY(ulDatBitsP == 0);
+
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x123, 10, 0x55, false) == 190);
+   QVERIFY(ulNomBitsP == 190);
+   QVERIFY(ulDatBitsP == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameBits::checkFdCrc21()                                                                                  //
+// CAN FD frames with more than 16 data bytes                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrameBits::checkFdCrc21()
+{
+   //---------------------------------------------------------------------------------------------------
+   // 20 data bytes already use the CRC-21 with 7 fixed stuff bits
+   //
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x123, 11, 0x55, true) == 227);
+   QVERIFY(ulNomBitsP == 30);
+   QVERIFY(ulDatBitsP == 5 + (20 * 8) + 4 + 21 + 7);
+
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x123, 12, 0x55, true) == 259);
+   QVERIFY(ulNomBitsP == 30);
+   QVERIFY(ulDatBitsP == 5 + (24 * 8) + 4 + 21 + 7);
+
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x123, 15, 0x55, true) == 579);
+   QVERIFY(ulNomBitsP == 30);
+   QVERIFY(ulDatBitsP == 5 + (64 * 8) + 4 + 21 + 7);
+
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x123, 11, 0x55, false) == 227);
+   QVERIFY(ulDatBitsP == 0);
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x123, 12, 0x55, false) == 259);
+   QVERIFY(ulDatBitsP == 0);
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x123, 15, 0x55, false) == 579);
+   QVERIFY(ulNomBitsP == 579);
+   QVERIFY(ulDatBitsP == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // extended frame: 36 bits in the arbitration phase
+   //
+   QVERIFY(count(QCanFrame::eFORMAT_FD_EXT, 0x12345678, 15, 0x55, true) == 598);
+   QVERIFY(ulNomBitsP == 49);
+   QVERIFY(ulDatBitsP == 549);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameBits::checkWorstCase()                                                                                //
+// all bits of identifier and data have the same value                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrameBits::checkWorstCase()
+{
+   //---------------------------------------------------------------------------------------------------
+   // Classic CAN: 111 / 131 bits without stuff bits
+   //
+   QVERIFY(count(QCanFrame::eFORMAT_CAN_STD, 0x000, 8, 0x00) == 127);
+   QVERIFY(count(QCanFrame::eFORMAT_CAN_STD, 0x7FF, 8, 0xFF) == 126);
+   QVERIFY(count(QCanFrame::eFORMAT_CAN_EXT, 0x00000000, 8, 0x00) == 150);
+   QVERIFY(count(QCanFrame::eFORMAT_CAN_EXT, 0x1FFFFFFF, 8, 0xFF) == 149);
+
+   //---------------------------------------------------------------------------------------------------
+   // CAN FD with 64 data bytes: 579 bits without dynamic stuff bits
+   //
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x000, 15, 0x00, true) == 683);
+   QVERIFY(ulNomBitsP == 32);
+   QVERIFY(ulDatBitsP == 651);
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x7FF, 15, 0xFF, true) == 684);
+   QVERIFY(ulNomBitsP == 32);
+   QVERIFY(ulDatBitsP == 652);
+
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x000, 15, 0x00, false) == 683);
+   QVERIFY(ulDatBitsP == 0);
+   QVERIFY(count(QCanFrame::eFORMAT_FD_STD, 0x7FF, 15, 0xFF, false) == 684);
+   QVERIFY(ulDatBitsP == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameBits::checkBusTime()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrameBits::checkBusTime()
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_FD_STD, 0x123, 15);
+
+   for (uint8_t ubPosT = 0; ubPosT < 64; ubPosT++)
+   {
+      clFrameT.setData(ubPosT, 0x55);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // 30 bits with 500 kBit/s, 549 bits with 2 MBit/s
+   //
+   clFrameT.setBitrateSwitch(true);
+   QVERIFY(QCanFrameBits::busTime(clFrameT, 500000, 2000000) == 60000 + 274500);
+
+   //---------------------------------------------------------------------------------------------------
+   // without a valid data bit rate the nominal bit rate is used
+   //
+   QVERIFY(QCanFrameBits::busTime(clFrameT, 500000, 0) == 1158000);
+   QVERIFY(QCanFrameBits::busTime(clFrameT, 0, 2000000) == 0);
+}
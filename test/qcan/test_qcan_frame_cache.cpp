@@ -0,0 +1,254 @@
+//====================================================================================================================//
+// File:          test_qcan_frame_cache.cpp                                                                           //
+// Description:   QCAN classes - CAN frame cache tests                                                                //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_frame_cache.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameCache::TestQCanFrameCache()                                                                           //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanFrameCache::TestQCanFrameCache()
+{
+   pclCacheP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameCache::~TestQCanFrameCache()                                                                          //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanFrameCache::~TestQCanFrameCache()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameCache::snapshotFrame()                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanFrame TestQCanFrameCache::snapshotFrame(const QByteArray & clSnapshotR, const int32_t slIndexV)
+{
+   QCanFrame   clFrameT;
+
+   clFrameT.fromRawData(reinterpret_cast< const uint8_t * >(clSnapshotR.constData()) +
+                        (slIndexV * static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE)));
+
+   return (clFrameT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameCache::update()                                                                                       //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool TestQCanFrameCache::update(const QCanFrame::FrameFormat_e teFormatV, const uint32_t ulIdentifierV,
+                                const uint32_t ulMarkerV)
+{
+   QCanFrame   clFrameT(teFormatV, ulIdentifierV, 8);
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   clFrameT.setData(0, static_cast< uint8_t >(ulMarkerV));
+   clFrameT.setMarker(ulMarkerV);
+   clFrameT.toRawData(&aubDataT[0]);
+
+   return (pclCacheP->update(&aubDataT[0]));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameCache::init()                                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrameCache::init()
+{
+   pclCacheP = new QCanFrameCache();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameCache::checkUpdate()                                                                                  //
+// the cache holds the most recent frame of each identifier                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrameCache::checkUpdate()
+{
+   QCanFrame   clFrameT;
+
+   QVERIFY(pclCacheP->count() == 0);
+   QVERIFY(pclCacheP->data().isEmpty() == true);
+   QVERIFY(pclCacheP->frame(0x123, false, clFrameT) == false);
+
+   QVERIFY(update(QCanFrame::eFORMAT_CAN_STD, 0x123, 1) == true);
+   QVERIFY(update(QCanFrame::eFORMAT_CAN_EXT, 0x123, 2) == true);
+   QVERIFY(update(QCanFrame::eFORMAT_FD_STD,  0x456, 3) == true);
+   QVERIFY(update(QCanFrame::eFORMAT_CAN_STD, 0x123, 4) == true);
+   QVERIFY(pclCacheP->count() == 3);
+   QVERIFY(pclCacheP->data().size() == 3 * static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE));
+
+   QVERIFY(pclCacheP->frame(0x123, false, clFrameT) == true);
+   QVERIFY(clFrameT.frameFormat() == QCanFrame::eFORMAT_CAN_STD);
+   QVERIFY(clFrameT.marker() == 4);
+   QVERIFY(clFrameT.data(0) == 4);
+
+   QVERIFY(pclCacheP->frame(0x123, true, clFrameT) == true);
+   QVERIFY(clFrameT.frameFormat() == QCanFrame::eFORMAT_CAN_EXT);
+   QVERIFY(clFrameT.identifier() == 0x123);
+   QVERIFY(clFrameT.marker() == 2);
+
+   QVERIFY(pclCacheP->frame(0x456, false, clFrameT) == true);
+   QVERIFY(clFrameT.frameFormat() == QCanFrame::eFORMAT_FD_STD);
+   QVERIFY(clFrameT.marker() == 3);
+   QVERIFY(pclCacheP->frame(0x456, true, clFrameT) == false);
+
+   pclCacheP->clear();
+   QVERIFY(pclCacheP->count() == 0);
+   QVERIFY(pclCacheP->data().isEmpty() == true);
+   QVERIFY(pclCacheP->frame(0x123, false, clFrameT) == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameCache::checkSnapshot()                                                                                //
+// a snapshot is not changed by following updates                                                                     //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrameCache::checkSnapshot()
+{
+   QByteArray  clSnapshotT;
+   uint32_t    ulIdentifierT;
+
+   for (ulIdentifierT = 0; ulIdentifierT < 100; ulIdentifierT++)
+   {
+      QVERIFY(update(QCanFrame::eFORMAT_CAN_STD, 0x700 - ulIdentifierT, ulIdentifierT) == true);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the snapshot holds the frames in order of the first reception
+   //
+   clSnapshotT = pclCacheP->data();
+   QVERIFY(clSnapshotT.size() == 100 * static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE));
+   for (ulIdentifierT = 0; ulIdentifierT < 100; ulIdentifierT++)
+   {
+      QVERIFY(snapshotFrame(clSnapshotT, static_cast< int32_t >(ulIdentifierT)).identifier() == 0x700 - ulIdentifierT);
+      QVERIFY(snapshotFrame(clSnapshotT, static_cast< int32_t >(ulIdentifierT)).marker() == ulIdentifierT);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // replace all frames and add a new one
+   //
+   for (ulIdentifierT = 0; ulIdentifierT < 100; ulIdentifierT++)
+   {
+      QVERIFY(update(QCanFrame::eFORMAT_CAN_STD, 0x700 - ulIdentifierT, 1000 + ulIdentifierT) == true);
+   }
+   QVERIFY(update(QCanFrame::eFORMAT_CAN_EXT, 0x1FFFFFFF, 2000) == true);
+
+   QVERIFY(clSnapshotT.size() == 100 * static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE));
+   for (ulIdentifierT = 0; ulIdentifierT < 100; ulIdentifierT++)
+   {
+      QVERIFY(snapshotFrame(clSnapshotT, static_cast< int32_t >(ulIdentifierT)).marker() == ulIdentifierT);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // a new snapshot has the actual values, the position of an identifier does not change
+   //
+   clSnapshotT = pclCacheP->data();
+   QVERIFY(clSnapshotT.size() == 101 * static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE));
+   for (ulIdentifierT = 0; ulIdentifierT < 100; ulIdentifierT++)
+   {
+      QVERIFY(snapshotFrame(clSnapshotT, static_cast< int32_t >(ulIdentifierT)).identifier() == 0x700 - ulIdentifierT);
+      QVERIFY(snapshotFrame(clSnapshotT, static_cast< int32_t >(ulIdentifierT)).marker() == 1000 + ulIdentifierT);
+   }
+   QVERIFY(snapshotFrame(clSnapshotT, 100).identifier() == 0x1FFFFFFF);
+   QVERIFY(snapshotFrame(clSnapshotT, 100).isExtended() == true);
+   QVERIFY(snapshotFrame(clSnapshotT, 100).marker() == 2000);
+
+   //---------------------------------------------------------------------------------------------------
+   // clear() does not change the snapshot
+   //
+   pclCacheP->clear();
+   QVERIFY(clSnapshotT.size() == 101 * static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE));
+   QVERIFY(snapshotFrame(clSnapshotT, 0).marker() == 1000);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameCache::checkErrorFrame()                                                                              //
+// error frames are not stored                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrameCache::checkErrorFrame()
+{
+   QCanFrame   clFrameT(QCanFrame::eFRAME_TYPE_ERROR);
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   clFrameT.toRawData(&aubDataT[0]);
+   QVERIFY(pclCacheP->update(&aubDataT[0]) == false);
+   QVERIFY(pclCacheP->count() == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameCache::checkLimit()                                                                                   //
+// the number of extended identifiers is limited                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrameCache::checkLimit()
+{
+   QCanFrame   clFrameT;
+   uint32_t    ulExtMaxT = QCanIdIndex::size() - 2048;
+   uint32_t    ulIdentifierT;
+
+   for (ulIdentifierT = 0; ulIdentifierT < ulExtMaxT; ulIdentifierT++)
+   {
+      QVERIFY(update(QCanFrame::eFORMAT_CAN_EXT, 0x18000000 + ulIdentifierT, ulIdentifierT) == true);
+   }
+   QVERIFY(update(QCanFrame::eFORMAT_CAN_EXT, 0x00000001, 0) == false);
+   QVERIFY(pclCacheP->frame(0x00000001, true, clFrameT) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // known extended identifiers and standard identifiers are still stored
+   //
+   QVERIFY(update(QCanFrame::eFORMAT_CAN_EXT, 0x18000000, 42) == true);
+   QVERIFY(update(QCanFrame::eFORMAT_CAN_STD, 0x001, 43) == true);
+   QVERIFY(pclCacheP->count() == ulExtMaxT + 1);
+   QVERIFY(pclCacheP->data().size() == static_cast< int32_t >((ulExtMaxT + 1) * QCAN_FRAME_ARRAY_SIZE));
+   QVERIFY(pclCacheP->frame(0x18000000, true, clFrameT) == true);
+   QVERIFY(clFrameT.marker() == 42);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanFrameCache::cleanup()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanFrameCache::cleanup()
+{
+   delete pclCacheP;
+   pclCacheP = nullptr;
+}
@@ -0,0 +1,264 @@
+//====================================================================================================================//
+// File:          test_qcan_id_index.cpp                                                                              //
+// Description:   QCAN classes - CAN identifier index tests                                                           //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_id_index.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdIndex::TestQCanIdIndex()                                                                                 //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanIdIndex::TestQCanIdIndex()
+{
+   pclIndexP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdIndex::~TestQCanIdIndex()                                                                                //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanIdIndex::~TestQCanIdIndex()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdIndex::init()                                                                                            //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanIdIndex::init()
+{
+   pclIndexP = new QCanIdIndex();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdIndex::checkStandard()                                                                                   //
+// index values are assigned in order of insertion                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanIdIndex::checkStandard()
+{
+   uint32_t ulIdentifierT;
+
+   QVERIFY(pclIndexP->count() == 0);
+   QVERIFY(pclIndexP->find(0x000, false) == -1);
+   QVERIFY(pclIndexP->find(0x7FF, false) == -1);
+
+   //---------------------------------------------------------------------------------------------------
+   // insert all standard identifiers in descending order
+   //
+   for (ulIdentifierT = 0; ulIdentifierT <= QCAN_FRAME_ID_MASK_STD; ulIdentifierT++)
+   {
+      QVERIFY(pclIndexP->insert(QCAN_FRAME_ID_MASK_STD - ulIdentifierT, false) ==
+              static_cast< int32_t >(ulIdentifierT));
+   }
+   QVERIFY(pclIndexP->count() == 2048);
+
+   //---------------------------------------------------------------------------------------------------
+   // a second insert returns the existing index value
+   //
+   for (ulIdentifierT = 0; ulIdentifierT <= QCAN_FRAME_ID_MASK_STD; ulIdentifierT++)
+   {
+      QVERIFY(pclIndexP->find(ulIdentifierT, false) == static_cast< int32_t >(QCAN_FRAME_ID_MASK_STD - ulIdentifierT));
+      QVERIFY(pclIndexP->insert(ulIdentifierT, false) ==
+              static_cast< int32_t >(QCAN_FRAME_ID_MASK_STD - ulIdentifierT));
+   }
+   QVERIFY(pclIndexP->count() == 2048);
+
+   //---------------------------------------------------------------------------------------------------
+   // standard and extended identifiers with the same value are different entries
+   //
+   QVERIFY(pclIndexP->find(0x123, true) == -1);
+   QVERIFY(pclIndexP->insert(0x123, true) == 2048);
+   QVERIFY(pclIndexP->find(0x123, false) == static_cast< int32_t >(QCAN_FRAME_ID_MASK_STD - 0x123));
+
+   pclIndexP->clear();
+   QVERIFY(pclIndexP->count() == 0);
+   QVERIFY(pclIndexP->find(0x123, false) == -1);
+   QVERIFY(pclIndexP->find(0x123, true) == -1);
+   QVERIFY(pclIndexP->insert(0x123, true) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdIndex::checkExtended()                                                                                   //
+// 29 bit identifiers over the whole value range                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanIdIndex::checkExtended()
+{
+   uint32_t ulIdentifierT;
+   uint32_t ulSeedT = 4711;
+   int32_t  slIndexT;
+
+   QVERIFY(pclIndexP->insert(0x00000000, true) == 0);
+   QVERIFY(pclIndexP->insert(QCAN_FRAME_ID_MASK_EXT, true) == 1);
+   QVERIFY(pclIndexP->insert(0x18FEF100, true) == 2);
+   QVERIFY(pclIndexP->insert(0x18FEF101, true) == 3);
+
+   //---------------------------------------------------------------------------------------------------
+   // the bits above the 29 bit identifier are ignored
+   //
+   QVERIFY(pclIndexP->find(0xE0000000 | 0x18FEF100, true) == 2);
+   QVERIFY(pclIndexP->insert(0xFFFFFFFF, true) == 1);
+   QVERIFY(pclIndexP->count() == 4);
+
+   //---------------------------------------------------------------------------------------------------
+   // identifiers which differ in a single bit
+   //
+   for (slIndexT = 4; slIndexT < 4 + 28; slIndexT++)
+   {
+      QVERIFY(pclIndexP->insert(0x00000001 | (1 << (slIndexT - 3)), true) == slIndexT);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // pseudo random identifiers
+   //
+   for (slIndexT = 32; slIndexT < 1032; slIndexT++)
+   {
+      ulSeedT = (ulSeedT * 1103515245) + 12345;
+      ulIdentifierT = ((ulSeedT & 0x7FFFFFFF) << 1) | 0x01;
+      pclIndexP->insert(ulIdentifierT, true);
+   }
+   ulSeedT = 4711;
+   for (slIndexT = 32; slIndexT < 1032; slIndexT++)
+   {
+      ulSeedT = (ulSeedT * 1103515245) + 12345;
+      ulIdentifierT = ((ulSeedT & 0x7FFFFFFF) << 1) | 0x01;
+      QVERIFY(pclIndexP->find(ulIdentifierT, true) >= 32);
+      QVERIFY(pclIndexP->find(ulIdentifierT, true) < static_cast< int32_t >(pclIndexP->count()));
+   }
+
+   for (slIndexT = 4; slIndexT < 4 + 28; slIndexT++)
+   {
+      QVERIFY(pclIndexP->find(0x00000001 | (1 << (slIndexT - 3)), true) == slIndexT);
+   }
+   QVERIFY(pclIndexP->find(0x00000001, true) == -1);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdIndex::checkCollision()                                                                                  //
+// identifiers with the same hash value                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanIdIndex::checkCollision()
+{
+   uint32_t ulIdentifierT;
+   uint32_t aulCollisionT[8];
+   uint32_t ulShiftT = 32;
+   uint32_t ulSizeT;
+   int32_t  slCountT = 0;
+
+   //---------------------------------------------------------------------------------------------------
+   // search identifiers which map to the same slot of the hash table, the hash value is calculated
+   // by multiplication with the golden ratio
+   //
+   for (ulSizeT = QCAN_ID_TABLE_EXT_MAX; ulSizeT > 1; ulSizeT = ulSizeT >> 1)
+   {
+      ulShiftT--;
+   }
+   for (ulIdentifierT = 1; (ulIdentifierT <= QCAN_FRAME_ID_MASK_EXT) && (slCountT < 8); ulIdentifierT++)
+   {
+      if (((ulIdentifierT * 0x9E3779B1) >> ulShiftT) == ((0x9E3779B1) >> ulShiftT))
+      {
+         aulCollisionT[slCountT] = ulIdentifierT;
+         slCountT++;
+      }
+   }
+   QVERIFY(slCountT == 8);
+
+   //---------------------------------------------------------------------------------------------------
+   // also occupy the slots behind, so the probe sequences overlap
+   //
+   for (slCountT = 0; slCountT < 8; slCountT++)
+   {
+      QVERIFY(pclIndexP->insert(aulCollisionT[slCountT], true) == slCountT);
+   }
+   for (slCountT = 0; slCountT < 8; slCountT++)
+   {
+      QVERIFY(pclIndexP->insert(aulCollisionT[slCountT] + 1, true) == 8 + slCountT);
+   }
+
+   for (slCountT = 0; slCountT < 8; slCountT++)
+   {
+      QVERIFY(pclIndexP->find(aulCollisionT[slCountT], true) == slCountT);
+      QVERIFY(pclIndexP->find(aulCollisionT[slCountT] + 1, true) == 8 + slCountT);
+      QVERIFY(pclIndexP->find(aulCollisionT[slCountT] + 2, true) == -1);
+      QVERIFY(pclIndexP->find(aulCollisionT[slCountT], false) == -1);
+   }
+   QVERIFY(pclIndexP->count() == 16);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdIndex::checkLimit()                                                                                      //
+// the hash table is filled up to 75 %                                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanIdIndex::checkLimit()
+{
+   uint32_t ulExtMaxT = QCanIdIndex::size() - 2048;
+   uint32_t ulIdentifierT;
+
+   QVERIFY(ulExtMaxT == (QCAN_ID_TABLE_EXT_MAX / 4) * 3);
+
+   //---------------------------------------------------------------------------------------------------
+   // identifiers with a distance of QCAN_ID_TABLE_EXT_MAX cause many collisions
+   //
+   for (ulIdentifierT = 0; ulIdentifierT < ulExtMaxT; ulIdentifierT++)
+   {
+      QVERIFY(pclIndexP->insert(ulIdentifierT * QCAN_ID_TABLE_EXT_MAX, true) == static_cast< int32_t >(ulIdentifierT));
+   }
+   QVERIFY(pclIndexP->insert(ulExtMaxT * QCAN_ID_TABLE_EXT_MAX, true) == -1);
+   QVERIFY(pclIndexP->find(ulExtMaxT * QCAN_ID_TABLE_EXT_MAX, true) == -1);
+   QVERIFY(pclIndexP->count() == ulExtMaxT);
+
+   //---------------------------------------------------------------------------------------------------
+   // known identifiers are still found, standard identifiers can still be inserted
+   //
+   for (ulIdentifierT = 0; ulIdentifierT < ulExtMaxT; ulIdentifierT++)
+   {
+      QVERIFY(pclIndexP->insert(ulIdentifierT * QCAN_ID_TABLE_EXT_MAX, true) == static_cast< int32_t >(ulIdentifierT));
+   }
+   QVERIFY(pclIndexP->insert(0x7FF, false) == static_cast< int32_t >(ulExtMaxT));
+   QVERIFY(pclIndexP->count() == ulExtMaxT + 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdIndex::cleanup()                                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanIdIndex::cleanup()
+{
+   delete pclIndexP;
+   pclIndexP = nullptr;
+}
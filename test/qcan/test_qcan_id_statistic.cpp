@@ -0,0 +1,182 @@
+//====================================================================================================================//
+// File:          test_qcan_id_statistic.cpp                                                                          //
+// Description:   QCAN classes - CAN identifier statistic tests                                                       //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_id_statistic.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdStatistic::TestQCanIdStatistic()                                                                         //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanIdStatistic::TestQCanIdStatistic()
+{
+   pclStatisticP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdStatistic::~TestQCanIdStatistic()                                                                        //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanIdStatistic::~TestQCanIdStatistic()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdStatistic::update()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanIdStatistic::update(const uint32_t ulIdentifierV, const bool btExtendedV, const uint8_t ubDlcV,
+                                 const uint64_t uqTimeV)
+{
+   QCanFrame   clFrameT(btExtendedV ? QCanFrame::eFORMAT_CAN_EXT : QCanFrame::eFORMAT_CAN_STD, ulIdentifierV, ubDlcV);
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   clFrameT.toRawData(&aubDataT[0]);
+   pclStatisticP->update(&aubDataT[0], uqTimeV);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdStatistic::init()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanIdStatistic::init()
+{
+   pclStatisticP = new QCanIdStatistic();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdStatistic::checkStatistic()                                                                              //
+// snapshot of the statistic                                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanIdStatistic::checkStatistic()
+{
+   QJsonArray  clArrayT;
+   QJsonObject clEntryT;
+
+   //---------------------------------------------------------------------------------------------------
+   // identifier 100h with periods of 9 ms and 11 ms, the other identifiers are received once
+   //
+   update(0x100, true,  1,        0);
+   update(0x7FF, false, 2,        0);
+   update(0x100, false, 8,        0);
+   update(0x100, false, 8,  9000000);
+   update(0x001, true,  3, 10000000);
+   update(0x100, false, 8, 20000000);
+   update(0x100, false, 8, 29000000);
+   update(0x001, false, 4, 30000000);
+   update(0x100, false, 6, 40000000);
+   QVERIFY(pclStatisticP->count() == 5);
+   QVERIFY(pclStatisticP->overflowCount() == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // standard identifiers first, sorted by value
+   //
+   clArrayT = pclStatisticP->toJson(50000000);
+   QVERIFY(clArrayT.size() == 5);
+   QVERIFY(clArrayT.at(0).toObject().value("id").toInt() == 0x001);
+   QVERIFY(clArrayT.at(0).toObject().value("extended").toBool() == false);
+   QVERIFY(clArrayT.at(1).toObject().value("id").toInt() == 0x100);
+   QVERIFY(clArrayT.at(2).toObject().value("id").toInt() == 0x7FF);
+   QVERIFY(clArrayT.at(3).toObject().value("id").toInt() == 0x001);
+   QVERIFY(clArrayT.at(3).toObject().value("extended").toBool() == true);
+   QVERIFY(clArrayT.at(4).toObject().value("id").toInt() == 0x100);
+   QVERIFY(clArrayT.at(4).toObject().value("extended").toBool() == true);
+
+   //---------------------------------------------------------------------------------------------------
+   // periods in microseconds, age in milliseconds, the jitter is the standard deviation of the
+   // periods: sqrt(4 * (1000 us)^2 / 3)
+   //
+   clEntryT = clArrayT.at(1).toObject();
+   QVERIFY(clEntryT.value("count").toDouble() == 5.0);
+   QVERIFY(clEntryT.value("dlc").toInt() == 6);
+   QVERIFY(clEntryT.value("age").toDouble() == 10.0);
+   QVERIFY(qAbs(clEntryT.value("periodMean").toDouble() - 10000.0) < 0.001);
+   QVERIFY(clEntryT.value("periodMin").toDouble() == 9000.0);
+   QVERIFY(clEntryT.value("periodMax").toDouble() == 11000.0);
+   QVERIFY(qAbs(clEntryT.value("jitter").toDouble() - 1154.7005) < 0.001);
+
+   clEntryT = clArrayT.at(3).toObject();
+   QVERIFY(clEntryT.value("count").toDouble() == 1.0);
+   QVERIFY(clEntryT.value("dlc").toInt() == 3);
+   QVERIFY(clEntryT.value("age").toDouble() == 40.0);
+   QVERIFY(clEntryT.value("jitter").toDouble() == 0.0);
+
+   pclStatisticP->clear();
+   QVERIFY(pclStatisticP->count() == 0);
+   QVERIFY(pclStatisticP->toJson(0).isEmpty() == true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdStatistic::checkOverflow()                                                                               //
+// frames are not recorded if the table is full                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanIdStatistic::checkOverflow()
+{
+   uint32_t ulExtMaxT = (QCAN_ID_TABLE_EXT_MAX / 4) * 3;
+   uint32_t ulIdentifierT;
+
+   for (ulIdentifierT = 0; ulIdentifierT < ulExtMaxT; ulIdentifierT++)
+   {
+      update(0x10000000 + ulIdentifierT, true, 8, 0);
+   }
+   QVERIFY(pclStatisticP->count() == ulExtMaxT);
+   QVERIFY(pclStatisticP->overflowCount() == 0);
+
+   update(0x00000001, true, 8, 1000);
+   update(0x00000002, true, 8, 1000);
+   QVERIFY(pclStatisticP->overflowCount() == 2);
+
+   //---------------------------------------------------------------------------------------------------
+   // known identifiers and standard identifiers are still recorded
+   //
+   update(0x10000000, true,  8, 1000);
+   update(0x00000001, false, 8, 1000);
+   QVERIFY(pclStatisticP->count() == ulExtMaxT + 1);
+   QVERIFY(pclStatisticP->overflowCount() == 2);
+   QVERIFY(pclStatisticP->toJson(1000).at(1).toObject().value("count").toDouble() == 2.0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanIdStatistic::cleanup()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanIdStatistic::cleanup()
+{
+   delete pclStatisticP;
+   pclStatisticP = nullptr;
+}
@@ -0,0 +1,275 @@
+//====================================================================================================================//
+// File:          test_qcan_latency_histogram.cpp                                                                     //
+// Description:   QCAN classes - Latency histogram tests                                                              //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_latency_histogram.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLatencyHistogram::TestQCanLatencyHistogram()                                                               //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanLatencyHistogram::TestQCanLatencyHistogram()
+{
+   pclHistogramP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLatencyHistogram::~TestQCanLatencyHistogram()                                                              //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanLatencyHistogram::~TestQCanLatencyHistogram()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLatencyHistogram::upperBound()                                                                             //
+// the bucket width is 2^(exponent - QCAN_LATENCY_SUB_BITS)                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+uint64_t TestQCanLatencyHistogram::upperBound(const uint64_t uqLatencyV)
+{
+   uint64_t uqValueT = qMin(uqLatencyV, static_cast< uint64_t >((1ULL << QCAN_LATENCY_VALUE_BITS) - 1));
+   int32_t  slExponentT = 0;
+
+   if (uqValueT < (2ULL << QCAN_LATENCY_SUB_BITS))
+   {
+      return (uqValueT);
+   }
+
+   while ((uqValueT >> (slExponentT + 1)) > 0)
+   {
+      slExponentT++;
+   }
+
+   return (uqValueT | ((1ULL << (slExponentT - QCAN_LATENCY_SUB_BITS)) - 1));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLatencyHistogram::init()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLatencyHistogram::init()
+{
+   pclHistogramP = new QCanLatencyHistogram();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLatencyHistogram::checkEmpty()                                                                             //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLatencyHistogram::checkEmpty()
+{
+   QVERIFY(pclHistogramP->count() == 0);
+   QVERIFY(pclHistogramP->maximum() == 0);
+   QVERIFY(pclHistogramP->percentile(1) == 0);
+   QVERIFY(pclHistogramP->percentile(50) == 0);
+   QVERIFY(pclHistogramP->percentile(100) == 0);
+
+   pclHistogramP->record(1000);
+   pclHistogramP->clear();
+   QVERIFY(pclHistogramP->count() == 0);
+   QVERIFY(pclHistogramP->maximum() == 0);
+   QVERIFY(pclHistogramP->percentile(100) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLatencyHistogram::checkSmallValues()                                                                       //
+// values below 2^(QCAN_LATENCY_SUB_BITS + 1) have a bucket of their own                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLatencyHistogram::checkSmallValues()
+{
+   uint64_t uqValueT;
+
+   for (uqValueT = 0; uqValueT < (2ULL << QCAN_LATENCY_SUB_BITS); uqValueT++)
+   {
+      pclHistogramP->clear();
+      pclHistogramP->record(uqValueT);
+      pclHistogramP->record(1000000);
+      QVERIFY(pclHistogramP->percentile(50) == uqValueT);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLatencyHistogram::checkBucketBoundary()                                                                    //
+// values at the bounds of the buckets of each power of two                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLatencyHistogram::checkBucketBoundary()
+{
+   uint64_t uqBaseT;
+   uint64_t uqWidthT;
+   uint64_t uqValueT;
+   int32_t  slExponentT;
+   int32_t  slSubT;
+
+   //---------------------------------------------------------------------------------------------------
+   // A second, larger value is recorded, so percentile(50) returns the upper bound of the bucket of
+   // the first value and is not limited by the maximum.
+   //
+   for (slExponentT = QCAN_LATENCY_SUB_BITS + 1; slExponentT < QCAN_LATENCY_VALUE_BITS; slExponentT++)
+   {
+      uqBaseT  = 1ULL << slExponentT;
+      uqWidthT = 1ULL << (slExponentT - QCAN_LATENCY_SUB_BITS);
+      for (slSubT = 0; slSubT < (1 << QCAN_LATENCY_SUB_BITS); slSubT++)
+      {
+         uqValueT = uqBaseT + (static_cast< uint64_t >(slSubT) * uqWidthT);
+
+         //-------------------------------------------------------------------------------------------
+         // first and last value of the bucket
+         //
+         pclHistogramP->clear();
+         pclHistogramP->record(uqValueT);
+         pclHistogramP->record(1ULL << 40);
+         QVERIFY(pclHistogramP->percentile(50) == uqValueT + uqWidthT - 1);
+         QVERIFY(pclHistogramP->percentile(50) == upperBound(uqValueT));
+
+         pclHistogramP->clear();
+         pclHistogramP->record(uqValueT + uqWidthT - 1);
+         pclHistogramP->record(1ULL << 40);
+         QVERIFY(pclHistogramP->percentile(50) == uqValueT + uqWidthT - 1);
+
+         //-------------------------------------------------------------------------------------------
+         // the relative error is limited to 1 / 2^QCAN_LATENCY_SUB_BITS
+         //
+         QVERIFY((uqWidthT - 1) * (1ULL << QCAN_LATENCY_SUB_BITS) < uqValueT);
+      }
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLatencyHistogram::checkRange()                                                                             //
+// values beyond 2^QCAN_LATENCY_VALUE_BITS are recorded in the last bucket                                            //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLatencyHistogram::checkRange()
+{
+   uint64_t uqLastT = (1ULL << QCAN_LATENCY_VALUE_BITS) - 1;
+
+   pclHistogramP->record(5000000000ULL);
+   QVERIFY(pclHistogramP->count() == 1);
+   QVERIFY(pclHistogramP->maximum() == 5000000000ULL);
+   QVERIFY(pclHistogramP->percentile(100) == uqLastT);
+
+   pclHistogramP->record(UINT64_MAX);
+   QVERIFY(pclHistogramP->maximum() == UINT64_MAX);
+   QVERIFY(pclHistogramP->percentile(1) == uqLastT);
+   QVERIFY(pclHistogramP->percentile(100) == uqLastT);
+
+   //---------------------------------------------------------------------------------------------------
+   // the largest value inside the range shares the last bucket
+   //
+   pclHistogramP->clear();
+   pclHistogramP->record(uqLastT - 1);
+   pclHistogramP->record(UINT64_MAX);
+   QVERIFY(pclHistogramP->percentile(50) == uqLastT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLatencyHistogram::checkPercentile()                                                                        //
+// the rank of a percentile is rounded up                                                                             //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLatencyHistogram::checkPercentile()
+{
+   uint64_t uqValueT;
+
+   //---------------------------------------------------------------------------------------------------
+   // three values in different buckets: 10, 20 .. 21, 30 .. 31
+   //
+   pclHistogramP->record(30);
+   pclHistogramP->record(10);
+   pclHistogramP->record(20);
+   QVERIFY(pclHistogramP->count() == 3);
+   QVERIFY(pclHistogramP->percentile(33) == 10);
+   QVERIFY(pclHistogramP->percentile(34) == 21);
+   QVERIFY(pclHistogramP->percentile(50) == 21);
+   QVERIFY(pclHistogramP->percentile(67) == 30);
+   QVERIFY(pclHistogramP->percentile(100) == 30);
+
+   //---------------------------------------------------------------------------------------------------
+   // 100 values from 1 us to 100 us, the result is limited to the maximum
+   //
+   pclHistogramP->clear();
+   for (uqValueT = 1000; uqValueT <= 100000; uqValueT += 1000)
+   {
+      pclHistogramP->record(uqValueT);
+   }
+   QVERIFY(pclHistogramP->count() == 100);
+   QVERIFY(pclHistogramP->maximum() == 100000);
+   QVERIFY(pclHistogramP->percentile(0) == upperBound(1000));
+   QVERIFY(pclHistogramP->percentile(1) == upperBound(1000));
+   QVERIFY(pclHistogramP->percentile(50) == upperBound(50000));
+   QVERIFY(pclHistogramP->percentile(90) == upperBound(90000));
+   QVERIFY(pclHistogramP->percentile(99) == 100000);
+   QVERIFY(pclHistogramP->percentile(100) == 100000);
+   QVERIFY(pclHistogramP->percentile(200) == 100000);
+
+   QVERIFY(upperBound(1000)  == 1023);
+   QVERIFY(upperBound(50000) == 53247);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLatencyHistogram::checkJson()                                                                              //
+// the summary is given in microseconds                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLatencyHistogram::checkJson()
+{
+   QJsonObject clJsonT;
+   uint64_t    uqValueT;
+
+   for (uqValueT = 1000; uqValueT <= 100000; uqValueT += 1000)
+   {
+      pclHistogramP->record(uqValueT);
+   }
+
+   clJsonT = pclHistogramP->toJson();
+   QVERIFY(clJsonT.value("count").toDouble() == 100.0);
+   QVERIFY(qAbs(clJsonT.value("p50").toDouble() - 53.247) < 0.0001);
+   QVERIFY(qAbs(clJsonT.value("p99").toDouble() - 100.0) < 0.0001);
+   QVERIFY(qAbs(clJsonT.value("max").toDouble() - 100.0) < 0.0001);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLatencyHistogram::cleanup()                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLatencyHistogram::cleanup()
+{
+   delete pclHistogramP;
+   pclHistogramP = nullptr;
+}
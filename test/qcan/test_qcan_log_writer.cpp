@@ -0,0 +1,290 @@
+//====================================================================================================================//
+// File:          test_qcan_log_writer.cpp                                                                            //
+// Description:   QCAN classes - Asynchronous log writer tests                                                        //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_log_writer.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLogWriter::TestQCanLogWriter()                                                                             //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanLogWriter::TestQCanLogWriter()
+{
+   pclDirP    = nullptr;
+   pclWriterP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLogWriter::~TestQCanLogWriter()                                                                            //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanLogWriter::~TestQCanLogWriter()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLogWriter::fileContents()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QByteArray TestQCanLogWriter::fileContents(const QString & clFileNameR)
+{
+   QFile       clFileT(filePath(clFileNameR));
+   QByteArray  clContentsT;
+
+   if (clFileT.open(QIODevice::ReadOnly) == true)
+   {
+      clContentsT = clFileT.readAll();
+      clFileT.close();
+   }
+
+   return (clContentsT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLogWriter::filePath()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QString TestQCanLogWriter::filePath(const QString & clFileNameR)
+{
+   return (pclDirP->path() + "/" + clFileNameR);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLogWriter::init()                                                                                          //
+// the writer thread is not running, so the records stay in the ring until start() is called                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLogWriter::init()
+{
+   pclDirP    = new QTemporaryDir();
+   pclWriterP = new QCanLogWriter();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLogWriter::checkFileIndex()                                                                                //
+// records are only accepted for configured files                                                                     //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLogWriter::checkFileIndex()
+{
+   QVERIFY(pclDirP->isValid() == true);
+   QVERIFY(pclWriterP->append(0, "record\n") == false);
+   QVERIFY(pclWriterP->dropCount() == 0);
+
+   QVERIFY(pclWriterP->setFileName(1, filePath("can2.log")) == true);
+   QVERIFY(pclWriterP->append(0, "record 0\n") == true);
+   QVERIFY(pclWriterP->append(1, "record 1\n") == true);
+   QVERIFY(pclWriterP->append(2, "record 2\n") == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // the record for file index 0 is discarded because the file is not open
+   //
+   pclWriterP->start();
+   pclWriterP->stop();
+   QVERIFY(fileContents("can2.log") == "record 1\n");
+   QVERIFY(QFile::exists(filePath("can1.log")) == false);
+
+   QVERIFY(pclWriterP->setFileName(QCAN_NETWORK_LIMIT, filePath("can0.log")) == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLogWriter::checkBatch()                                                                                    //
+// records of several files are written in the order of append()                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLogWriter::checkBatch()
+{
+   QByteArray  aclExpectedT[3];
+   QByteArray  clContentsT;
+   QByteArray  clRecordT;
+   uint32_t    ulCountT;
+
+   QVERIFY(pclWriterP->setFileName(0, filePath("can1.log")) == true);
+   QVERIFY(pclWriterP->setFileName(1, filePath("can2.log")) == true);
+   QVERIFY(pclWriterP->setFileName(2, filePath("can3.log")) == true);
+
+   for (ulCountT = 0; ulCountT < 3000; ulCountT++)
+   {
+      clRecordT = "record " + QByteArray::number(ulCountT) + "\n";
+      QVERIFY(pclWriterP->append(static_cast< uint8_t >(ulCountT % 3), clRecordT) == true);
+      aclExpectedT[ulCountT % 3].append(clRecordT);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // nothing is written before the writer thread runs
+   //
+   QVERIFY(fileContents("can1.log").isEmpty() == true);
+
+   pclWriterP->start();
+   pclWriterP->stop();
+   QVERIFY(pclWriterP->dropCount() == 0);
+   QVERIFY(fileContents("can1.log") == aclExpectedT[0]);
+   QVERIFY(fileContents("can2.log") == aclExpectedT[1]);
+   QVERIFY(fileContents("can3.log") == aclExpectedT[2]);
+
+   //---------------------------------------------------------------------------------------------------
+   // records appended while the writer thread is running: a record which is rejected because the
+   // ring is full is appended again, the notice about dropped records is removed before the
+   // contents is compared
+   //
+   pclWriterP->start();
+   for (ulCountT = 3000; ulCountT < 20000; ulCountT++)
+   {
+      clRecordT = "record " + QByteArray::number(ulCountT) + "\n";
+      while (pclWriterP->append(static_cast< uint8_t >(ulCountT % 3), clRecordT) == false)
+      {
+         QThread::msleep(1);
+      }
+      aclExpectedT[ulCountT % 3].append(clRecordT);
+   }
+   pclWriterP->stop();
+
+   for (ulCountT = 0; ulCountT < 3; ulCountT++)
+   {
+      clContentsT.clear();
+      for (const QByteArray & clLineR : fileContents(QString("can%1.log").arg(ulCountT + 1)).split('\n'))
+      {
+         if ((clLineR.isEmpty() == false) && (clLineR.endsWith("log records dropped") == false))
+         {
+            clContentsT.append(clLineR + "\n");
+         }
+      }
+      QVERIFY(clContentsT == aclExpectedT[ulCountT]);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLogWriter::checkOverflow()                                                                                 //
+// records are dropped if the ring is full, the log file gets a notice                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLogWriter::checkOverflow()
+{
+   QByteArray  clExpectedT;
+   QByteArray  clContentsT;
+   QByteArray  clRecordT;
+   uint32_t    ulCountT;
+
+   QVERIFY(pclWriterP->setFileName(0, filePath("can1.log")) == true);
+   QVERIFY(pclWriterP->setFileName(1, filePath("can2.log")) == true);
+
+   for (ulCountT = 0; ulCountT < QCAN_LOG_RING_SIZE; ulCountT++)
+   {
+      clRecordT = QByteArray::number(ulCountT) + "\n";
+      QVERIFY(pclWriterP->append(0, clRecordT) == true);
+      clExpectedT.append(clRecordT);
+   }
+
+   QVERIFY(pclWriterP->append(0, "lost\n") == false);
+   QVERIFY(pclWriterP->append(1, "lost\n") == false);
+   QVERIFY(pclWriterP->append(1, "lost\n") == false);
+   QVERIFY(pclWriterP->dropCount() == 3);
+
+   pclWriterP->start();
+   pclWriterP->stop();
+
+   //---------------------------------------------------------------------------------------------------
+   // the notice follows the records of the batch
+   //
+   clContentsT = fileContents("can1.log");
+   QVERIFY(clContentsT.startsWith(clExpectedT) == true);
+   QVERIFY(clContentsT.endsWith(" - 1 log records dropped\n") == true);
+   QVERIFY(clContentsT.contains("lost") == false);
+   QVERIFY(fileContents("can2.log").endsWith(" - 2 log records dropped\n") == true);
+
+   //---------------------------------------------------------------------------------------------------
+   // the ring accepts records again, the notice is not repeated
+   //
+   QVERIFY(pclWriterP->append(1, "next\n") == true);
+   pclWriterP->start();
+   pclWriterP->stop();
+   QVERIFY(fileContents("can2.log").endsWith(" - 2 log records dropped\nnext\n") == true);
+   QVERIFY(pclWriterP->dropCount() == 3);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLogWriter::checkRotation()                                                                                 //
+// size based rotation with two backup files                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLogWriter::checkRotation()
+{
+   QVERIFY(pclWriterP->setFileName(0, filePath("can1.log")) == true);
+   pclWriterP->setRotation(16, 0, 2);
+
+   //---------------------------------------------------------------------------------------------------
+   // the size is checked after each batch, so a batch is never split
+   //
+   QVERIFY(pclWriterP->append(0, "first batch 1\n") == true);
+   QVERIFY(pclWriterP->append(0, "first batch 2\n") == true);
+   pclWriterP->start();
+   pclWriterP->stop();
+   QVERIFY(fileContents("can1.log").isEmpty() == true);
+   QVERIFY(fileContents("can1.log.1") == "first batch 1\nfirst batch 2\n");
+
+   QVERIFY(pclWriterP->append(0, "second\n") == true);
+   pclWriterP->start();
+   pclWriterP->stop();
+   QVERIFY(fileContents("can1.log") == "second\n");
+
+   QVERIFY(pclWriterP->append(0, "third batch\n") == true);
+   pclWriterP->start();
+   pclWriterP->stop();
+   QVERIFY(fileContents("can1.log").isEmpty() == true);
+   QVERIFY(fileContents("can1.log.1") == "second\nthird batch\n");
+   QVERIFY(fileContents("can1.log.2") == "first batch 1\nfirst batch 2\n");
+
+   QVERIFY(pclWriterP->append(0, "fourth batch\n") == true);
+   QVERIFY(pclWriterP->append(0, "fourth batch\n") == true);
+   pclWriterP->start();
+   pclWriterP->stop();
+   QVERIFY(fileContents("can1.log.1") == "fourth batch\nfourth batch\n");
+   QVERIFY(fileContents("can1.log.2") == "second\nthird batch\n");
+   QVERIFY(QFile::exists(filePath("can1.log.3")) == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanLogWriter::cleanup()                                                                                       //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanLogWriter::cleanup()
+{
+   delete pclWriterP;
+   pclWriterP = nullptr;
+
+   delete pclDirP;
+   pclDirP = nullptr;
+}
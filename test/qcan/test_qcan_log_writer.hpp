@@ -0,0 +1,86 @@
+//====================================================================================================================//
+// File:          test_qcan_log_writer.hpp                                                                            //
+// Description:   QCAN classes - Asynchronous log writer tests                                                        //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#ifndef TEST_QCAN_LOG_WRITER_HPP_
+#define TEST_QCAN_LOG_WRITER_HPP_
+
+
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+#include "qcan_log_writer.hpp"
+
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \class   TestQCanLogWriter
+** \brief   Test asynchronous log writer
+**
+*/
+class TestQCanLogWriter : public QObject
+{
+   Q_OBJECT
+
+public:
+
+   TestQCanLogWriter();
+
+   ~TestQCanLogWriter();
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // contents of a file inside the temporary directory
+   //
+   QByteArray           fileContents(const QString & clFileNameR);
+
+   //---------------------------------------------------------------------------------------------------
+   // path of a file inside the temporary directory
+   //
+   QString              filePath(const QString & clFileNameR);
+
+   QTemporaryDir *      pclDirP;
+   QCanLogWriter *      pclWriterP;
+
+private slots:
+
+   void init();
+
+   void checkFileIndex();
+   void checkBatch();
+   void checkOverflow();
+   void checkRotation();
+
+   void cleanup();
+};
+
+
+#endif   // TEST_QCAN_LOG_WRITER_HPP_
@@ -0,0 +1,294 @@
+//====================================================================================================================//
+// File:          test_qcan_metrics_server.cpp                                                                        //
+// Description:   QCAN classes - OpenMetrics endpoint tests                                                           //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include <QtCore/QElapsedTimer>
+#include <QtNetwork/QTcpSocket>
+
+#include "test_qcan_metrics_server.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMetricsServer::TestQCanMetricsServer()                                                                     //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanMetricsServer::TestQCanMetricsServer()
+{
+   pclMetricsP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMetricsServer::~TestQCanMetricsServer()                                                                    //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanMetricsServer::~TestQCanMetricsServer()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMetricsServer::request()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QByteArray TestQCanMetricsServer::request(const QByteArray & clRequestR)
+{
+   QTcpSocket     clSocketT;
+   QByteArray     clResponseT;
+   QElapsedTimer  clTimerT;
+
+   clSocketT.connectToHost(QHostAddress::LocalHost, pclMetricsP->port());
+   clSocketT.write(clRequestR);
+
+   //---------------------------------------------------------------------------------------------------
+   // the endpoint closes the connection after the response
+   //
+   clTimerT.start();
+   while ((clTimerT.elapsed() < 5000) && (clSocketT.state() != QAbstractSocket::UnconnectedState))
+   {
+      QTest::qWait(5);
+      clResponseT.append(clSocketT.readAll());
+   }
+   clResponseT.append(clSocketT.readAll());
+
+   return (clResponseT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMetricsServer::status()                                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QByteArray TestQCanMetricsServer::status(const QByteArray & clResponseR)
+{
+   return (clResponseR.left(clResponseR.indexOf("\r\n")));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMetricsServer::init()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMetricsServer::init()
+{
+   CanServerNetworkStatistic_ts  tsStatisticT;
+
+   pclMetricsP = new QCanMetricsServer();
+
+   memset(&tsStatisticT, 0, sizeof(CanServerNetworkStatistic_ts));
+   tsStatisticT.ulFrameCount        = 4711;
+   tsStatisticT.ulErrorCount        = 12;
+   tsStatisticT.ubBusLoad           = 35;
+   tsStatisticT.ulTransmitDropCount = 3;
+   tsStatisticT.ulSocketCount       = 3;
+   tsStatisticT.atsSocket[0].ubType = QCAN_MEMORY_SOCKET_LOCAL;
+   tsStatisticT.atsSocket[0].ulDropCount = 5;
+   tsStatisticT.atsSocket[1].ubType = QCAN_MEMORY_SOCKET_TCP;
+   tsStatisticT.atsSocket[1].ulDropCount = 7;
+   tsStatisticT.atsSocket[2].ubType = QCAN_MEMORY_SOCKET_TCP;
+   tsStatisticT.atsLatencyDispatch[0].uqCount = 100;
+   tsStatisticT.atsLatencyDispatch[0].uqP50   = 1500000;
+   tsStatisticT.atsLatencyDispatch[0].uqP99   = 2000000000;
+   tsStatisticT.atsLatencyDispatch[0].uqMax   = 2500000000;
+   pclMetricsP->setStatistic(0, tsStatisticT);
+
+   tsStatisticT.ulFrameCount        = 815;
+   pclMetricsP->setStatistic(1, tsStatisticT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMetricsServer::checkCounter()                                                                              //
+// counters use the suffix _total for every sample                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMetricsServer::checkCounter()
+{
+   QByteArray        clTextT = pclMetricsP->render();
+   QList<QByteArray> clLineListT = clTextT.split('\n');
+   QByteArray        clCounterT;
+   int32_t           slCounterCountT = 0;
+
+   for (const QByteArray & clLineR : clLineListT)
+   {
+      if (clLineR.startsWith("# TYPE ") && clLineR.endsWith(" counter"))
+      {
+         clCounterT = clLineR.split(' ').at(2);
+         QVERIFY(clCounterT.endsWith("_total") == false);
+         slCounterCountT++;
+      }
+      else if (clLineR.startsWith("# TYPE "))
+      {
+         clCounterT.clear();
+      }
+      else if ((clCounterT.isEmpty() == false) && (clLineR.startsWith("#") == false))
+      {
+         QVERIFY(clLineR.startsWith(clCounterT + "_total{"));
+      }
+   }
+   QVERIFY(slCounterCountT == 3);
+
+   QVERIFY(clTextT.contains("canpie_frames_total{network=\"1\"} 4711\n"));
+   QVERIFY(clTextT.contains("canpie_frames_total{network=\"2\"} 815\n"));
+   QVERIFY(clTextT.contains("canpie_error_frames_total{network=\"1\"} 12\n"));
+   QVERIFY(clTextT.contains("canpie_transmit_dropped_frames_total{network=\"1\"} 3\n"));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMetricsServer::checkGauge()                                                                                //
+// gauges do not use the counter suffix                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMetricsServer::checkGauge()
+{
+   QByteArray  clTextT = pclMetricsP->render();
+
+   QVERIFY(clTextT.contains("# TYPE canpie_bus_load_percent gauge\n"));
+   QVERIFY(clTextT.contains("canpie_bus_load_percent{network=\"1\"} 35\n"));
+
+   QVERIFY(clTextT.contains("canpie_clients{network=\"1\",type=\"local\"} 1\n"));
+   QVERIFY(clTextT.contains("canpie_clients{network=\"1\",type=\"web\"} 0\n"));
+   QVERIFY(clTextT.contains("canpie_clients{network=\"1\",type=\"tcp\"} 2\n"));
+
+   //---------------------------------------------------------------------------------------------------
+   // the dropped frames of the sockets are summed up
+   //
+   QVERIFY(clTextT.contains("# TYPE canpie_client_dropped_frames_current gauge\n"));
+   QVERIFY(clTextT.contains("canpie_client_dropped_frames_current{network=\"1\"} 12\n"));
+   QVERIFY(clTextT.contains("canpie_client_dropped_frames_current_total") == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMetricsServer::checkSummary()                                                                              //
+// latency summaries carry quantile labels and a count                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMetricsServer::checkSummary()
+{
+   QByteArray  clTextT = pclMetricsP->render();
+   QByteArray  clLabelT = "network=\"1\",path=\"canInterface\"";
+
+   QVERIFY(clTextT.contains("# TYPE canpie_dispatch_latency_seconds summary\n"));
+   QVERIFY(clTextT.contains("# TYPE canpie_egress_latency_seconds summary\n"));
+
+   QVERIFY(clTextT.contains("canpie_dispatch_latency_seconds{" + clLabelT + ",quantile=\"0.5\"} 0.0015\n"));
+   QVERIFY(clTextT.contains("canpie_dispatch_latency_seconds{" + clLabelT + ",quantile=\"0.99\"} 2\n"));
+   QVERIFY(clTextT.contains("canpie_dispatch_latency_seconds_count{" + clLabelT + "} 100\n"));
+   QVERIFY(clTextT.contains("canpie_dispatch_latency_max_seconds{" + clLabelT + "} 2.5\n"));
+
+   //---------------------------------------------------------------------------------------------------
+   // two quantiles for each network and path of both summaries
+   //
+   QVERIFY(clTextT.count("quantile=\"0.5\"") == 2 * 2 * QCAN_MEMORY_LATENCY_PATH_MAX);
+   QVERIFY(clTextT.count("quantile=\"0.99\"") == 2 * 2 * QCAN_MEMORY_LATENCY_PATH_MAX);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMetricsServer::checkEof()                                                                                  //
+// the text is terminated by # EOF                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMetricsServer::checkEof()
+{
+   QCanMetricsServer clEmptyT;
+
+   QVERIFY(pclMetricsP->render().endsWith("\n# EOF\n"));
+   QVERIFY(pclMetricsP->render().count("# EOF") == 1);
+   QVERIFY(clEmptyT.render().endsWith("# EOF\n"));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMetricsServer::checkRequestGet()                                                                           //
+// the endpoint serves /metrics via GET and HEAD                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMetricsServer::checkRequestGet()
+{
+   QByteArray  clResponseT;
+   QByteArray  clBodyT;
+
+   QVERIFY(pclMetricsP->start(QHostAddress::LocalHost, 0));
+   QVERIFY(pclMetricsP->port() != 0);
+
+   clResponseT = request("GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+   QVERIFY(status(clResponseT) == "HTTP/1.1 200 OK");
+   QVERIFY(clResponseT.contains("Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"));
+   clBodyT = clResponseT.mid(clResponseT.indexOf("\r\n\r\n") + 4);
+   QVERIFY(clBodyT == pclMetricsP->render());
+   QVERIFY(clResponseT.contains("Content-Length: " + QByteArray::number(clBodyT.size()) + "\r\n"));
+
+   //---------------------------------------------------------------------------------------------------
+   // the query part is ignored, HEAD returns the header only
+   //
+   clResponseT = request("GET /metrics?format=text HTTP/1.1\r\n\r\n");
+   QVERIFY(status(clResponseT) == "HTTP/1.1 200 OK");
+
+   clResponseT = request("HEAD /metrics HTTP/1.1\r\n\r\n");
+   QVERIFY(status(clResponseT) == "HTTP/1.1 200 OK");
+   QVERIFY(clResponseT.endsWith("\r\n\r\n"));
+
+   pclMetricsP->stop();
+   QVERIFY(pclMetricsP->port() == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMetricsServer::checkRequestError()                                                                         //
+// invalid requests are answered with 400, 404 and 405                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMetricsServer::checkRequestError()
+{
+   QVERIFY(pclMetricsP->start(QHostAddress::LocalHost, 0));
+
+   QVERIFY(status(request("GET /metrics\r\n\r\n")) == "HTTP/1.1 400 Bad Request");
+   QVERIFY(status(request("GARBAGE\r\n\r\n")) == "HTTP/1.1 400 Bad Request");
+   QVERIFY(status(request("GET /status HTTP/1.1\r\n\r\n")) == "HTTP/1.1 404 Not Found");
+   QVERIFY(status(request("GET /metrics/ HTTP/1.1\r\n\r\n")) == "HTTP/1.1 404 Not Found");
+   QVERIFY(status(request("POST /metrics HTTP/1.1\r\n\r\n")) == "HTTP/1.1 405 Method Not Allowed");
+   QVERIFY(status(request("DELETE /status HTTP/1.1\r\n\r\n")) == "HTTP/1.1 405 Method Not Allowed");
+
+   //---------------------------------------------------------------------------------------------------
+   // a client sending an oversized request header is disconnected without response
+   //
+   QVERIFY(request(QByteArray(QCAN_METRICS_REQUEST_MAX + 1, 'A')).isEmpty());
+
+   pclMetricsP->stop();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMetricsServer::cleanup()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMetricsServer::cleanup()
+{
+   delete pclMetricsP;
+   pclMetricsP = nullptr;
+}
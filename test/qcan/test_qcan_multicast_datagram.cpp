@@ -0,0 +1,288 @@
+//====================================================================================================================//
+// File:          test_qcan_multicast_datagram.cpp                                                                    //
+// Description:   QCAN classes - Multicast datagram tests                                                             //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_multicast_datagram.hpp"
+
+
+//------------------------------------------------------------------------------------------------------
+// CAN channel used for the test
+//
+constexpr uint8_t    TEST_CHANNEL   = 3;
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMulticastDatagram::TestQCanMulticastDatagram()                                                             //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanMulticastDatagram::TestQCanMulticastDatagram()
+{
+   pclDatagramP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMulticastDatagram::~TestQCanMulticastDatagram()                                                            //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanMulticastDatagram::~TestQCanMulticastDatagram()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMulticastDatagram::append()                                                                                //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+uint8_t * TestQCanMulticastDatagram::append(const uint32_t ulMarkerV)
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x100 + ulMarkerV, 8);
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   clFrameT.setData(0, static_cast< uint8_t >(ulMarkerV));
+   clFrameT.setMarker(ulMarkerV);
+   clFrameT.toRawData(&aubDataT[0]);
+
+   return (pclDatagramP->append(TEST_CHANNEL, &aubDataT[0]));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMulticastDatagram::datagramFrame()                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanFrame TestQCanMulticastDatagram::datagramFrame(const QByteArray & clDatagramR, const int32_t slIndexV)
+{
+   QCanFrame   clFrameT;
+
+   clFrameT.fromRawData(reinterpret_cast< const uint8_t * >(clDatagramR.constData()) + QCAN_MULTICAST_HEADER_SIZE +
+                        (slIndexV * static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE)));
+
+   return (clFrameT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMulticastDatagram::init()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMulticastDatagram::init()
+{
+   pclDatagramP = new QCanMulticastDatagram();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMulticastDatagram::checkHeader()                                                                           //
+// the header of 8 bytes is written with the first CAN frame                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMulticastDatagram::checkHeader()
+{
+   const uint8_t *   pubDataT;
+   uint8_t *         pubFrameT;
+
+   QVERIFY(QCAN_MULTICAST_HEADER_SIZE == 8);
+   QVERIFY(pclDatagramP->count() == 0);
+   QVERIFY(pclDatagramP->sequence() == 0);
+   QVERIFY(pclDatagramP->data().isEmpty() == true);
+
+   pubFrameT = append(0);
+   pubDataT  = reinterpret_cast< const uint8_t * >(pclDatagramP->data().constData());
+   QVERIFY(pclDatagramP->count() == 1);
+   QVERIFY(pclDatagramP->sequence() == 1);
+   QVERIFY(pclDatagramP->data().size() == static_cast< int32_t >(QCAN_MULTICAST_HEADER_SIZE + QCAN_FRAME_ARRAY_SIZE));
+
+   QVERIFY(pubDataT[0] == 0xCA);
+   QVERIFY(pubDataT[1] == 1);
+   QVERIFY(pubDataT[2] == TEST_CHANNEL);
+   QVERIFY(pubDataT[3] == 1);
+   QVERIFY(qFromBigEndian<uint32_t>(pubDataT + 4) == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // the returned pointer addresses the copy inside the datagram, the sender may modify it
+   //
+   QVERIFY(pubFrameT == pubDataT + QCAN_MULTICAST_HEADER_SIZE);
+   pubFrameT[QCAN_FRAME_DELIVERY_STAMP_POS] = 0x5A;
+   QVERIFY(pubDataT[QCAN_MULTICAST_HEADER_SIZE + QCAN_FRAME_DELIVERY_STAMP_POS] == 0x5A);
+   QVERIFY(datagramFrame(pclDatagramP->data(), 0).identifier() == 0x100);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMulticastDatagram::checkPacking()                                                                          //
+// a datagram holds up to 14 CAN frames, which are restored in order                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMulticastDatagram::checkPacking()
+{
+   QCanFrame   clFrameT;
+   uint32_t    ulCountT    = 0;
+   uint32_t    ulSequenceT = 0xFFFFFFFF;
+
+   QVERIFY(QCAN_MULTICAST_FRAME_MAX == 14);
+
+   for (uint32_t ulMarkerT = 0; ulMarkerT < QCAN_MULTICAST_FRAME_MAX; ulMarkerT++)
+   {
+      QVERIFY(pclDatagramP->isFull() == false);
+      append(ulMarkerT);
+   }
+   QVERIFY(pclDatagramP->isFull() == true);
+   QVERIFY(pclDatagramP->count() == QCAN_MULTICAST_FRAME_MAX);
+   QVERIFY(pclDatagramP->data().size() ==
+           static_cast< int32_t >(QCAN_MULTICAST_HEADER_SIZE + (QCAN_MULTICAST_FRAME_MAX * QCAN_FRAME_ARRAY_SIZE)));
+
+   //---------------------------------------------------------------------------------------------------
+   // the complete datagram fits into a single Ethernet frame
+   //
+   QVERIFY(pclDatagramP->data().size() <= 1472);
+
+   QVERIFY(QCanMulticastDatagram::parse(reinterpret_cast< const uint8_t * >(pclDatagramP->data().constData()),
+                                        pclDatagramP->data().size(), TEST_CHANNEL, ulCountT, ulSequenceT) == true);
+   QVERIFY(ulCountT == QCAN_MULTICAST_FRAME_MAX);
+   QVERIFY(ulSequenceT == 0);
+
+   for (int32_t slIndexT = 0; slIndexT < static_cast< int32_t >(ulCountT); slIndexT++)
+   {
+      clFrameT = datagramFrame(pclDatagramP->data(), slIndexT);
+      QVERIFY(clFrameT.frameFormat() == QCanFrame::eFORMAT_CAN_STD);
+      QVERIFY(clFrameT.identifier() == 0x100 + static_cast< uint32_t >(slIndexT));
+      QVERIFY(clFrameT.dlc() == 8);
+      QVERIFY(clFrameT.data(0) == slIndexT);
+      QVERIFY(clFrameT.marker() == static_cast< uint32_t >(slIndexT));
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMulticastDatagram::checkSequence()                                                                         //
+// the sequence number is counted per CAN frame and continues over datagrams                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMulticastDatagram::checkSequence()
+{
+   uint32_t ulCountT    = 0;
+   uint32_t ulSequenceT = 0;
+
+   for (uint32_t ulMarkerT = 0; ulMarkerT < 5; ulMarkerT++)
+   {
+      append(ulMarkerT);
+   }
+   QVERIFY(pclDatagramP->sequence() == 5);
+
+   //---------------------------------------------------------------------------------------------------
+   // the next datagram starts with the sequence number of its first CAN frame
+   //
+   pclDatagramP->clear();
+   QVERIFY(pclDatagramP->count() == 0);
+   QVERIFY(pclDatagramP->data().isEmpty() == true);
+   QVERIFY(pclDatagramP->sequence() == 5);
+
+   append(5);
+   append(6);
+   QVERIFY(QCanMulticastDatagram::parse(reinterpret_cast< const uint8_t * >(pclDatagramP->data().constData()),
+                                        pclDatagramP->data().size(), TEST_CHANNEL, ulCountT, ulSequenceT) == true);
+   QVERIFY(ulCountT == 2);
+   QVERIFY(ulSequenceT == 5);
+   QVERIFY(datagramFrame(pclDatagramP->data(), 1).marker() == 6);
+
+   //---------------------------------------------------------------------------------------------------
+   // reset() restarts the sequence number
+   //
+   pclDatagramP->reset();
+   QVERIFY(pclDatagramP->count() == 0);
+   QVERIFY(pclDatagramP->sequence() == 0);
+   append(7);
+   QVERIFY(QCanMulticastDatagram::parse(reinterpret_cast< const uint8_t * >(pclDatagramP->data().constData()),
+                                        pclDatagramP->data().size(), TEST_CHANNEL, ulCountT, ulSequenceT) == true);
+   QVERIFY(ulCountT == 1);
+   QVERIFY(ulSequenceT == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMulticastDatagram::checkParse()                                                                            //
+// invalid datagrams are rejected                                                                                     //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMulticastDatagram::checkParse()
+{
+   QByteArray  clDatagramT;
+   uint8_t *   pubDataT;
+   int64_t     sqSizeT;
+   uint32_t    ulCountT    = 0;
+   uint32_t    ulSequenceT = 0;
+
+   append(0);
+   append(1);
+   clDatagramT = pclDatagramP->data();
+   pubDataT    = reinterpret_cast< uint8_t * >(clDatagramT.data());
+   sqSizeT     = clDatagramT.size();
+
+   QVERIFY(QCanMulticastDatagram::parse(pubDataT, sqSizeT, TEST_CHANNEL, ulCountT, ulSequenceT) == true);
+   QVERIFY(ulCountT == 2);
+
+   //---------------------------------------------------------------------------------------------------
+   // size of the datagram
+   //
+   QVERIFY(QCanMulticastDatagram::parse(nullptr, sqSizeT, TEST_CHANNEL, ulCountT, ulSequenceT) == false);
+   QVERIFY(QCanMulticastDatagram::parse(pubDataT, QCAN_MULTICAST_HEADER_SIZE - 1, TEST_CHANNEL,
+                                        ulCountT, ulSequenceT) == false);
+   QVERIFY(QCanMulticastDatagram::parse(pubDataT, sqSizeT - 1, TEST_CHANNEL, ulCountT, ulSequenceT) == false);
+   QVERIFY(QCanMulticastDatagram::parse(pubDataT, sqSizeT - QCAN_FRAME_ARRAY_SIZE, TEST_CHANNEL,
+                                        ulCountT, ulSequenceT) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // datagrams of other CAN channels sharing the same multicast group
+   //
+   QVERIFY(QCanMulticastDatagram::parse(pubDataT, sqSizeT, TEST_CHANNEL + 1, ulCountT, ulSequenceT) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // marker, version and number of CAN frames
+   //
+   pubDataT[0] = 0xCB;
+   QVERIFY(QCanMulticastDatagram::parse(pubDataT, sqSizeT, TEST_CHANNEL, ulCountT, ulSequenceT) == false);
+   pubDataT[0] = 0xCA;
+   pubDataT[1] = 2;
+   QVERIFY(QCanMulticastDatagram::parse(pubDataT, sqSizeT, TEST_CHANNEL, ulCountT, ulSequenceT) == false);
+   pubDataT[1] = 1;
+   pubDataT[3] = 3;
+   QVERIFY(QCanMulticastDatagram::parse(pubDataT, sqSizeT, TEST_CHANNEL, ulCountT, ulSequenceT) == false);
+   pubDataT[3] = 2;
+   QVERIFY(QCanMulticastDatagram::parse(pubDataT, sqSizeT, TEST_CHANNEL, ulCountT, ulSequenceT) == true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMulticastDatagram::cleanup()                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMulticastDatagram::cleanup()
+{
+   delete pclDatagramP;
+   pclDatagramP = nullptr;
+}
@@ -0,0 +1,254 @@
+//====================================================================================================================//
+// File:          test_qcan_mux_channel.cpp                                                                           //
+// Description:   QCAN classes - Multiplexed channel selection tests                                                  //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_mux_channel.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMuxChannel::TestQCanMuxChannel()                                                                           //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanMuxChannel::TestQCanMuxChannel()
+{
+   pclTransmitP = nullptr;
+   pclReceiveP  = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMuxChannel::~TestQCanMuxChannel()                                                                          //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanMuxChannel::~TestQCanMuxChannel()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMuxChannel::write()                                                                                        //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMuxChannel::write(QByteArray & clStreamR, const uint8_t ubChannelV, const uint32_t ulIdentifierV)
+{
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, ulIdentifierV, 1);
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   if (pclTransmitP->transmitSelect(ubChannelV, &aubDataT[0]))
+   {
+      clStreamR.append(reinterpret_cast< const char * >(&aubDataT[0]), QCAN_FRAME_ARRAY_SIZE);
+   }
+
+   clFrameT.setData(0, ubChannelV);
+   clFrameT.toRawData(&aubDataT[0]);
+   clStreamR.append(reinterpret_cast< const char * >(&aubDataT[0]), QCAN_FRAME_ARRAY_SIZE);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMuxChannel::init()                                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMuxChannel::init()
+{
+   pclTransmitP = new QCanMuxChannel();
+   pclReceiveP  = new QCanMuxChannel();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMuxChannel::checkSelectMessage()                                                                           //
+// layout of the channel select message                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMuxChannel::checkSelectMessage()
+{
+   uint8_t  aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   memset(&aubDataT[0], 0x55, QCAN_FRAME_ARRAY_SIZE);
+   QCanMuxChannel::selectMessage(5, &aubDataT[0]);
+
+   QVERIFY(aubDataT[0] == QCAN_CONTROL_CHANNEL_SELECT);
+   QVERIFY(qFromBigEndian<uint32_t>(&aubDataT[4]) == 5);
+   QVERIFY(aubDataT[94] == 0xCA);
+   QVERIFY(aubDataT[QCAN_FRAME_ARRAY_SIZE - 1] == QCAN_CONTROL_MARKER);
+
+   //---------------------------------------------------------------------------------------------------
+   // all other bytes are cleared
+   //
+   for (uint32_t ulPosT = 1; ulPosT < 4; ulPosT++)
+   {
+      QVERIFY(aubDataT[ulPosT] == 0);
+   }
+   for (uint32_t ulPosT = 8; ulPosT < 94; ulPosT++)
+   {
+      QVERIFY(aubDataT[ulPosT] == 0);
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMuxChannel::checkTransmit()                                                                                //
+// the channel select message is only sent when the channel changes                                                   //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMuxChannel::checkTransmit()
+{
+   uint8_t  aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   QVERIFY(pclTransmitP->transmitChannel() == 0);
+
+   QVERIFY(pclTransmitP->transmitSelect(1, &aubDataT[0]) == true);
+   QVERIFY(qFromBigEndian<uint32_t>(&aubDataT[4]) == 1);
+   QVERIFY(pclTransmitP->transmitChannel() == 1);
+   QVERIFY(pclTransmitP->transmitSelect(1, &aubDataT[0]) == false);
+   QVERIFY(pclTransmitP->transmitSelect(1, &aubDataT[0]) == false);
+
+   QVERIFY(pclTransmitP->transmitSelect(2, &aubDataT[0]) == true);
+   QVERIFY(qFromBigEndian<uint32_t>(&aubDataT[4]) == 2);
+   QVERIFY(pclTransmitP->transmitSelect(1, &aubDataT[0]) == true);
+   QVERIFY(qFromBigEndian<uint32_t>(&aubDataT[4]) == 1);
+
+   //---------------------------------------------------------------------------------------------------
+   // after clear() the channel is selected again, e.g. for a new connection
+   //
+   pclTransmitP->clear();
+   QVERIFY(pclTransmitP->transmitChannel() == 0);
+   QVERIFY(pclTransmitP->transmitSelect(1, &aubDataT[0]) == true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMuxChannel::checkReceive()                                                                                 //
+// evaluation of received control messages                                                                            //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMuxChannel::checkReceive()
+{
+   uint8_t  aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   QVERIFY(pclReceiveP->receiveChannel() == 0);
+
+   QCanMuxChannel::selectMessage(3, &aubDataT[0]);
+   QVERIFY(pclReceiveP->receiveControl(&aubDataT[0], 4) == true);
+   QVERIFY(pclReceiveP->receiveChannel() == 3);
+
+   QCanMuxChannel::selectMessage(4, &aubDataT[0]);
+   QVERIFY(pclReceiveP->receiveControl(&aubDataT[0], 4) == true);
+   QVERIFY(pclReceiveP->receiveChannel() == 4);
+
+   //---------------------------------------------------------------------------------------------------
+   // a channel above the highest valid channel selects no channel
+   //
+   QCanMuxChannel::selectMessage(5, &aubDataT[0]);
+   QVERIFY(pclReceiveP->receiveControl(&aubDataT[0], 4) == true);
+   QVERIFY(pclReceiveP->receiveChannel() == 0);
+
+   QCanMuxChannel::selectMessage(2, &aubDataT[0]);
+   QVERIFY(pclReceiveP->receiveControl(&aubDataT[0], 4) == true);
+   QVERIFY(pclReceiveP->receiveChannel() == 2);
+   QCanMuxChannel::selectMessage(0, &aubDataT[0]);
+   QVERIFY(pclReceiveP->receiveControl(&aubDataT[0], 4) == true);
+   QVERIFY(pclReceiveP->receiveChannel() == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // other control messages and CAN frames do not change the channel
+   //
+   QCanMuxChannel::selectMessage(1, &aubDataT[0]);
+   QVERIFY(pclReceiveP->receiveControl(&aubDataT[0], 4) == true);
+
+   aubDataT[0] = QCAN_CONTROL_SNAPSHOT_BEGIN;
+   QVERIFY(pclReceiveP->receiveControl(&aubDataT[0], 4) == false);
+   QVERIFY(pclReceiveP->receiveChannel() == 1);
+
+   QCanMuxChannel::selectMessage(2, &aubDataT[0]);
+   aubDataT[QCAN_FRAME_ARRAY_SIZE - 1] = 0x01;
+   QVERIFY(pclReceiveP->receiveControl(&aubDataT[0], 4) == false);
+   QVERIFY(pclReceiveP->receiveChannel() == 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMuxChannel::checkStream()                                                                                  //
+// CAN frames of several channels are restored from a multiplexed stream                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMuxChannel::checkStream()
+{
+   const uint8_t     aubChannelT[] = { 1, 1, 2, 2, 2, 1, 3, 3, 1 };
+   const uint32_t    ulFrameCntT   = sizeof(aubChannelT);
+   QByteArray        clStreamT;
+   QCanFrame         clFrameT;
+   const uint8_t *   pubDataT;
+   uint32_t          ulSelectCntT  = 0;
+   uint32_t          ulFrameIdxT   = 0;
+
+   for (uint32_t ulIdxT = 0; ulIdxT < ulFrameCntT; ulIdxT++)
+   {
+      write(clStreamT, aubChannelT[ulIdxT], 0x100 + ulIdxT);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the channel changes 5 times
+   //
+   QVERIFY(clStreamT.size() == static_cast< int32_t >((ulFrameCntT + 5) * QCAN_FRAME_ARRAY_SIZE));
+
+   pubDataT = reinterpret_cast< const uint8_t * >(clStreamT.constData());
+   for (int32_t slPosT = 0; slPosT < clStreamT.size(); slPosT += static_cast< int32_t >(QCAN_FRAME_ARRAY_SIZE))
+   {
+      if (pubDataT[slPosT + QCAN_FRAME_ARRAY_SIZE - 1] == QCAN_CONTROL_MARKER)
+      {
+         QVERIFY(pclReceiveP->receiveControl(pubDataT + slPosT, 3) == true);
+         ulSelectCntT++;
+      }
+      else
+      {
+         clFrameT.fromRawData(pubDataT + slPosT);
+         QVERIFY(ulFrameIdxT < ulFrameCntT);
+         QVERIFY(clFrameT.identifier() == 0x100 + ulFrameIdxT);
+         QVERIFY(pclReceiveP->receiveChannel() == aubChannelT[ulFrameIdxT]);
+         QVERIFY(clFrameT.data(0) == aubChannelT[ulFrameIdxT]);
+         ulFrameIdxT++;
+      }
+   }
+
+   QVERIFY(ulSelectCntT == 5);
+   QVERIFY(ulFrameIdxT == ulFrameCntT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanMuxChannel::cleanup()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanMuxChannel::cleanup()
+{
+   delete pclTransmitP;
+   pclTransmitP = nullptr;
+   delete pclReceiveP;
+   pclReceiveP = nullptr;
+}
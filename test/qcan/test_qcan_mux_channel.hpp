@@ -0,0 +1,85 @@
+//====================================================================================================================//
+// File:          test_qcan_mux_channel.hpp                                                                           //
+// Description:   QCAN classes - Multiplexed channel selection tests                                                  //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#ifndef TEST_QCAN_MUX_CHANNEL_HPP_
+#define TEST_QCAN_MUX_CHANNEL_HPP_
+
+
+#include <QtCore/QByteArray>
+#include <QtCore/QtEndian>
+#include <QtTest/QTest>
+
+#include <cstring>
+
+#include "qcan_mux_channel.hpp"
+
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \class   TestQCanMuxChannel
+** \brief   Test channel selection of a multiplexed connection
+**
+*/
+class TestQCanMuxChannel : public QObject
+{
+   Q_OBJECT
+
+public:
+
+   TestQCanMuxChannel();
+
+   ~TestQCanMuxChannel();
+
+private:
+
+   //---------------------------------------------------------------------------------------------------
+   // append a CAN frame of channel ubChannelV with identifier ulIdentifierV to the stream
+   // clStreamR, the channel select message is appended if required
+   //
+   void                 write(QByteArray & clStreamR, const uint8_t ubChannelV, const uint32_t ulIdentifierV);
+
+   QCanMuxChannel *     pclTransmitP;
+   QCanMuxChannel *     pclReceiveP;
+
+private slots:
+
+   void init();
+
+   void checkSelectMessage();
+   void checkTransmit();
+   void checkReceive();
+   void checkStream();
+
+   void cleanup();
+};
+
+
+#endif   // TEST_QCAN_MUX_CHANNEL_HPP_
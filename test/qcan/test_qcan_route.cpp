@@ -0,0 +1,333 @@
+//====================================================================================================================//
+// File:          test_qcan_route.cpp                                                                                 //
+// Description:   QCAN classes - CAN routing rule tests                                                               //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_route.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanRoute::TestQCanRoute()                                                                                     //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanRoute::TestQCanRoute()
+{
+   pclRouteP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanRoute::~TestQCanRoute()                                                                                    //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanRoute::~TestQCanRoute()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanRoute::process()                                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool TestQCanRoute::process(const uint32_t ulIdentifierV, const bool btExtendedV, const uint64_t uqTimeV,
+                            uint32_t * pulIdentifierV)
+{
+   QCanFrame   clFrameT(btExtendedV ? QCanFrame::eFORMAT_CAN_EXT : QCanFrame::eFORMAT_CAN_STD, ulIdentifierV, 0);
+   bool        btResultT;
+
+   btResultT = pclRouteP->process(clFrameT, uqTimeV);
+   if (pulIdentifierV != nullptr)
+   {
+      *pulIdentifierV = clFrameT.identifier();
+   }
+
+   return (btResultT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanRoute::init()                                                                                              //
+// each test case starts with a route from CAN 1 to CAN 2                                                             //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanRoute::init()
+{
+   pclRouteP = new QCanRoute();
+   pclRouteP->setChannels(QCan::eCAN_CHANNEL_1, QCan::eCAN_CHANNEL_2);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanRoute::checkDefault()                                                                                      //
+// a new route forwards all data frames without modification                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanRoute::checkDefault()
+{
+   QCanRoute   clRouteT;
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 0);
+   uint32_t    ulIdentifierT;
+
+   //---------------------------------------------------------------------------------------------------
+   // a route needs two different channels
+   //
+   QVERIFY(clRouteT.isValid() == false);
+   clRouteT.setChannels(QCan::eCAN_CHANNEL_1, QCan::eCAN_CHANNEL_1);
+   QVERIFY(clRouteT.isValid() == false);
+   QVERIFY(pclRouteP->isValid() == true);
+   QVERIFY(pclRouteP->sourceChannel() == QCan::eCAN_CHANNEL_1);
+   QVERIFY(pclRouteP->targetChannel() == QCan::eCAN_CHANNEL_2);
+
+   QVERIFY(process(0x000, false, 0, &ulIdentifierT) == true);
+   QVERIFY(ulIdentifierT == 0x000);
+   QVERIFY(process(QCAN_FRAME_ID_MASK_STD, false, 0, &ulIdentifierT) == true);
+   QVERIFY(ulIdentifierT == QCAN_FRAME_ID_MASK_STD);
+   QVERIFY(process(QCAN_FRAME_ID_MASK_EXT, true, 0, &ulIdentifierT) == true);
+   QVERIFY(ulIdentifierT == QCAN_FRAME_ID_MASK_EXT);
+
+   //---------------------------------------------------------------------------------------------------
+   // remote frames are forwarded, error frames are not
+   //
+   clFrameT.setRemote(true);
+   QVERIFY(pclRouteP->process(clFrameT, 0) == true);
+   clFrameT.setFrameType(QCanFrame::eFRAME_TYPE_ERROR);
+   QVERIFY(pclRouteP->process(clFrameT, 0) == false);
+
+   QVERIFY(pclRouteP->forwardCount() == 4);
+   QVERIFY(pclRouteP->dropCount() == 0);
+
+   pclRouteP->resetCounter();
+   QVERIFY(pclRouteP->forwardCount() == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanRoute::checkFormat()                                                                                       //
+// frame format and identifier range                                                                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanRoute::checkFormat()
+{
+   //---------------------------------------------------------------------------------------------------
+   // standard frames 100h .. 1FFh, the bounds are inclusive
+   //
+   pclRouteP->setIdentifierRange(QCanRoute::eFORMAT_STD, 0x100, 0x1FF);
+   QVERIFY(process(0x0FF, false, 0) == false);
+   QVERIFY(process(0x100, false, 0) == true);
+   QVERIFY(process(0x1FF, false, 0) == true);
+   QVERIFY(process(0x200, false, 0) == false);
+   QVERIFY(process(0x150, true,  0) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // extended frames only
+   //
+   pclRouteP->setIdentifierRange(QCanRoute::eFORMAT_EXT, 0x18FF0000, 0x18FFFFFF);
+   QVERIFY(process(0x18FEFFFF, true,  0) == false);
+   QVERIFY(process(0x18FF0000, true,  0) == true);
+   QVERIFY(process(0x18FFFFFF, true,  0) == true);
+   QVERIFY(process(0x19000000, true,  0) == false);
+   QVERIFY(process(0x000,      false, 0) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // both formats share the identifier range
+   //
+   pclRouteP->setIdentifierRange(QCanRoute::eFORMAT_ANY, 0x700, 0x7FF);
+   QVERIFY(process(0x700, false, 0) == true);
+   QVERIFY(process(0x700, true,  0) == true);
+   QVERIFY(process(0x6FF, true,  0) == false);
+   QVERIFY(process(0x800, true,  0) == false);
+
+   QVERIFY(pclRouteP->forwardCount() == 6);
+   QVERIFY(pclRouteP->dropCount() == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanRoute::checkMask()                                                                                         //
+// identifier mask and code                                                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanRoute::checkMask()
+{
+   uint32_t ulIdentifierT;
+
+   //---------------------------------------------------------------------------------------------------
+   // bits of the code outside the mask are ignored
+   //
+   pclRouteP->setIdentifierMask(0x00F, 0xFF3);
+   for (ulIdentifierT = 0; ulIdentifierT <= QCAN_FRAME_ID_MASK_STD; ulIdentifierT++)
+   {
+      QVERIFY(process(ulIdentifierT, false, 0) == ((ulIdentifierT & 0x00F) == 0x003));
+   }
+   QVERIFY(pclRouteP->forwardCount() == 128);
+
+   //---------------------------------------------------------------------------------------------------
+   // mask and identifier range are combined
+   //
+   pclRouteP->setIdentifierRange(QCanRoute::eFORMAT_ANY, 0x100, 0x1FF);
+   QVERIFY(process(0x003, false, 0) == false);
+   QVERIFY(process(0x103, false, 0) == true);
+   QVERIFY(process(0x104, false, 0) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // 29 bit identifier
+   //
+   pclRouteP->setIdentifierRange(QCanRoute::eFORMAT_EXT, 0, QCAN_FRAME_ID_MASK_EXT);
+   pclRouteP->setIdentifierMask(0x1F000000, 0x12000000);
+   QVERIFY(process(0x12345678, true, 0) == true);
+   QVERIFY(process(0x13345678, true, 0) == false);
+   QVERIFY(process(0x02345678, true, 0) == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanRoute::checkTranslation()                                                                                  //
+// only the masked identifier bits are replaced                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanRoute::checkTranslation()
+{
+   uint32_t ulIdentifierT;
+
+   pclRouteP->setIdentifierRange(QCanRoute::eFORMAT_STD, 0x100, 0x1FF);
+   pclRouteP->setTranslation(0xF00, 0x6A5);
+   QVERIFY(process(0x123, false, 0, &ulIdentifierT) == true);
+   QVERIFY(ulIdentifierT == 0x623);
+
+   //---------------------------------------------------------------------------------------------------
+   // frames which are not forwarded keep the identifier
+   //
+   QVERIFY(process(0x223, false, 0, &ulIdentifierT) == false);
+   QVERIFY(ulIdentifierT == 0x223);
+
+   pclRouteP->setIdentifierRange(QCanRoute::eFORMAT_EXT, 0, QCAN_FRAME_ID_MASK_EXT);
+   pclRouteP->setTranslation(0x000000FF, 0x00000042);
+   QVERIFY(process(0x18FEF100, true, 0, &ulIdentifierT) == true);
+   QVERIFY(ulIdentifierT == 0x18FEF142);
+
+   pclRouteP->setTranslation(0, 0x00000042);
+   QVERIFY(process(0x18FEF100, true, 0, &ulIdentifierT) == true);
+   QVERIFY(ulIdentifierT == 0x18FEF100);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanRoute::checkRateLimit()                                                                                    //
+// token bucket with burst                                                                                            //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanRoute::checkRateLimit()
+{
+   uint64_t uqTimeT;
+   uint32_t ulCountT;
+
+   //---------------------------------------------------------------------------------------------------
+   // 100 frames per second: one frame each 10 ms, a burst of 5 frames
+   //
+   pclRouteP->setIdentifierRange(QCanRoute::eFORMAT_STD, 0x100, 0x1FF);
+   pclRouteP->setRateLimit(100, 5);
+
+   for (ulCountT = 0; ulCountT < 5; ulCountT++)
+   {
+      QVERIFY(process(0x100, false, 1000) == true);
+   }
+   QVERIFY(process(0x100, false, 1000) == false);
+   QVERIFY(pclRouteP->dropCount() == 1);
+
+   //---------------------------------------------------------------------------------------------------
+   // frames which do not match the route do not consume credit and are not counted as dropped
+   //
+   QVERIFY(process(0x200, false, 1005) == false);
+   QVERIFY(pclRouteP->dropCount() == 1);
+
+   //---------------------------------------------------------------------------------------------------
+   // the bucket holds one frame after 10 ms
+   //
+   QVERIFY(process(0x100, false, 1009) == false);
+   QVERIFY(process(0x100, false, 1010) == true);
+   QVERIFY(process(0x100, false, 1010) == false);
+   QVERIFY(pclRouteP->dropCount() == 3);
+
+   //---------------------------------------------------------------------------------------------------
+   // a constant frame rate of 1 kHz is limited to 100 frames per second
+   //
+   for (uqTimeT = 1011; uqTimeT < 2011; uqTimeT++)
+   {
+      process(0x100, false, uqTimeT);
+   }
+   QVERIFY(pclRouteP->forwardCount() == 106);
+   QVERIFY(pclRouteP->dropCount() == 3 + 900);
+
+   //---------------------------------------------------------------------------------------------------
+   // after a pause the bucket is filled up to the burst value
+   //
+   ulCountT = 0;
+   while (process(0x100, false, 60000) == true)
+   {
+      ulCountT++;
+   }
+   QVERIFY(ulCountT == 5);
+
+   pclRouteP->resetCounter();
+   QVERIFY(pclRouteP->forwardCount() == 0);
+   QVERIFY(pclRouteP->dropCount() == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // a burst value of 0 is treated as 1
+   //
+   pclRouteP->setRateLimit(1, 0);
+   QVERIFY(process(0x100, false, 70000) == true);
+   QVERIFY(process(0x100, false, 70999) == false);
+   QVERIFY(process(0x100, false, 71000) == true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanRoute::checkRateDisabled()                                                                                 //
+// a rate of 0 forwards all frames                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanRoute::checkRateDisabled()
+{
+   uint32_t ulCountT;
+
+   pclRouteP->setRateLimit(1, 1);
+   pclRouteP->setRateLimit(0);
+   for (ulCountT = 0; ulCountT < 10000; ulCountT++)
+   {
+      QVERIFY(process(0x100, false, 0) == true);
+   }
+   QVERIFY(pclRouteP->forwardCount() == 10000);
+   QVERIFY(pclRouteP->dropCount() == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanRoute::cleanup()                                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanRoute::cleanup()
+{
+   delete pclRouteP;
+   pclRouteP = nullptr;
+}
@@ -0,0 +1,241 @@
+//====================================================================================================================//
+// File:          test_qcan_server_memory.cpp                                                                         //
+// Description:   QCAN classes - Server shared memory tests                                                           //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_server_memory.hpp"
+
+
+//------------------------------------------------------------------------------------------------------
+// number of CAN networks used for the test, more than QCAN_NETWORK_MAX
+//
+constexpr int32_t    TEST_NETWORK_COUNT   = QCAN_NETWORK_MAX + 12;
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerMemory::TestQCanServerMemory()                                                                       //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanServerMemory::TestQCanServerMemory()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerMemory::~TestQCanServerMemory()                                                                      //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanServerMemory::~TestQCanServerMemory()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerMemory::allocate()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+CanServerSharedMemory_ts * TestQCanServerMemory::allocate(const int32_t slNetworkCountV)
+{
+   CanServerSharedMemory_ts * ptsMemoryT;
+
+   //---------------------------------------------------------------------------------------------------
+   // the memory is allocated in 64 bit words to meet the alignment of the structure
+   //
+   clMemoryP.fill(0, static_cast< int >((QCanServerMemory::size(slNetworkCountV) + 7) / 8));
+   ptsMemoryT = reinterpret_cast< CanServerSharedMemory_ts * >(clMemoryP.data());
+   ptsMemoryT->slNetworkCount   = slNetworkCountV;
+   ptsMemoryT->slStatisticCount = slNetworkCountV;
+
+   return (ptsMemoryT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerMemory::init()                                                                                       //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerMemory::init()
+{
+   clMemoryP.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerMemory::checkSize()                                                                                  //
+// the size of the shared memory depends on the number of CAN networks                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerMemory::checkSize()
+{
+   int32_t  slCountT;
+
+   QVERIFY(QCanServerMemory::size(0) == static_cast< int64_t >(sizeof(CanServerSharedMemory_ts)));
+   QVERIFY(QCanServerMemory::size(1) == static_cast< int64_t >(sizeof(CanServerSharedMemory_ts)));
+
+   for (slCountT = 1; slCountT <= 255; slCountT++)
+   {
+      QVERIFY(QCanServerMemory::size(slCountT + 1) - QCanServerMemory::size(slCountT) ==
+              static_cast< int64_t >(sizeof(CanServerStatisticSlot_ts)));
+      QVERIFY(QCanServerMemory::statisticCount(QCanServerMemory::size(slCountT)) == slCountT);
+      QVERIFY(QCanServerMemory::statisticCount(QCanServerMemory::size(slCountT) + 1) == slCountT);
+      QVERIFY(QCanServerMemory::statisticCount(QCanServerMemory::size(slCountT + 1) - 1) == slCountT);
+   }
+
+   QVERIFY(QCanServerMemory::statisticCount(0) == 0);
+   QVERIFY(QCanServerMemory::statisticCount(sizeof(CanServerSharedMemory_ts) - 1) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerMemory::checkReadWrite()                                                                             //
+// the statistic of every CAN network is published                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerMemory::checkReadWrite()
+{
+   CanServerSharedMemory_ts *    ptsMemoryT;
+   CanServerNetworkStatistic_ts  tsWriteT;
+   CanServerNetworkStatistic_ts  tsReadT;
+   int32_t                       slNetIdxT;
+
+   ptsMemoryT = allocate(TEST_NETWORK_COUNT);
+
+   for (slNetIdxT = 0; slNetIdxT < TEST_NETWORK_COUNT; slNetIdxT++)
+   {
+      memset(&tsWriteT, 0, sizeof(CanServerNetworkStatistic_ts));
+      tsWriteT.ulFrameCount  = static_cast< uint32_t >(1000 + slNetIdxT);
+      tsWriteT.ulErrorCount  = static_cast< uint32_t >(slNetIdxT);
+      tsWriteT.ubBusLoad     = static_cast< uint8_t >(slNetIdxT);
+      tsWriteT.ulSocketCount = 1;
+      tsWriteT.atsSocket[0].ulDropCount = static_cast< uint32_t >(2000 + slNetIdxT);
+      tsWriteT.atsSocket[0].ubType      = QCAN_MEMORY_SOCKET_TCP;
+      tsWriteT.atsLatencyEgress[QCAN_MEMORY_LATENCY_PATH_MAX - 1].uqMax = 3000 + slNetIdxT;
+      QCanServerMemory::writeStatistic(ptsMemoryT, slNetIdxT, tsWriteT);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // all entries are read back unchanged, the last entry is located at the end of the memory
+   //
+   for (slNetIdxT = 0; slNetIdxT < TEST_NETWORK_COUNT; slNetIdxT++)
+   {
+      memset(&tsReadT, 0xFF, sizeof(CanServerNetworkStatistic_ts));
+      QVERIFY(QCanServerMemory::readStatistic(ptsMemoryT, slNetIdxT, tsReadT));
+      QVERIFY(tsReadT.ulFrameCount == static_cast< uint32_t >(1000 + slNetIdxT));
+      QVERIFY(tsReadT.ulErrorCount == static_cast< uint32_t >(slNetIdxT));
+      QVERIFY(tsReadT.ubBusLoad == static_cast< uint8_t >(slNetIdxT));
+      QVERIFY(tsReadT.ulSocketCount == 1);
+      QVERIFY(tsReadT.atsSocket[0].ulDropCount == static_cast< uint32_t >(2000 + slNetIdxT));
+      QVERIFY(tsReadT.atsSocket[0].ubType == QCAN_MEMORY_SOCKET_TCP);
+      QVERIFY(tsReadT.atsLatencyEgress[QCAN_MEMORY_LATENCY_PATH_MAX - 1].uqMax ==
+              static_cast< uint64_t >(3000 + slNetIdxT));
+   }
+
+   QVERIFY(reinterpret_cast< uint8_t * >(&ptsMemoryT->atsStatistic[TEST_NETWORK_COUNT]) <=
+           reinterpret_cast< uint8_t * >(clMemoryP.data()) + (clMemoryP.size() * 8));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerMemory::checkRange()                                                                                 //
+// network indices outside the published entries are rejected                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerMemory::checkRange()
+{
+   CanServerSharedMemory_ts *    ptsMemoryT;
+   CanServerNetworkStatistic_ts  tsWriteT;
+   CanServerNetworkStatistic_ts  tsReadT;
+
+   ptsMemoryT = allocate(4);
+   ptsMemoryT->slStatisticCount = 3;
+
+   memset(&tsWriteT, 0, sizeof(CanServerNetworkStatistic_ts));
+   tsWriteT.ulFrameCount = 4711;
+
+   QCanServerMemory::writeStatistic(ptsMemoryT, 3, tsWriteT);
+   QCanServerMemory::writeStatistic(ptsMemoryT, -1, tsWriteT);
+   QCanServerMemory::writeStatistic(nullptr, 0, tsWriteT);
+   QVERIFY(ptsMemoryT->atsStatistic[3].ulSequence.load() == 0);
+   QVERIFY(ptsMemoryT->atsStatistic[3].tsData.ulFrameCount == 0);
+
+   QVERIFY(QCanServerMemory::readStatistic(ptsMemoryT, 3, tsReadT) == false);
+   QVERIFY(QCanServerMemory::readStatistic(ptsMemoryT, -1, tsReadT) == false);
+   QVERIFY(QCanServerMemory::readStatistic(nullptr, 0, tsReadT) == false);
+
+   QCanServerMemory::writeStatistic(ptsMemoryT, 2, tsWriteT);
+   QVERIFY(QCanServerMemory::readStatistic(ptsMemoryT, 2, tsReadT));
+   QVERIFY(tsReadT.ulFrameCount == 4711);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerMemory::checkSequence()                                                                              //
+// the sequence number is odd while the statistic is updated                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerMemory::checkSequence()
+{
+   CanServerSharedMemory_ts *    ptsMemoryT;
+   CanServerNetworkStatistic_ts  tsWriteT;
+   CanServerNetworkStatistic_ts  tsReadT;
+   uint32_t                      ulCountT;
+
+   ptsMemoryT = allocate(2);
+   memset(&tsWriteT, 0, sizeof(CanServerNetworkStatistic_ts));
+
+   //---------------------------------------------------------------------------------------------------
+   // each update increments the sequence number by 2, the other entry is not modified
+   //
+   for (ulCountT = 1; ulCountT <= 10; ulCountT++)
+   {
+      tsWriteT.ulFrameCount = ulCountT;
+      QCanServerMemory::writeStatistic(ptsMemoryT, 1, tsWriteT);
+      QVERIFY(ptsMemoryT->atsStatistic[1].ulSequence.load() == (ulCountT * 2));
+      QVERIFY(ptsMemoryT->atsStatistic[0].ulSequence.load() == 0);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // a reader does not return a copy while the server updates the entry
+   //
+   ptsMemoryT->atsStatistic[1].ulSequence.store(21);
+   QVERIFY(QCanServerMemory::readStatistic(ptsMemoryT, 1, tsReadT, 0) == false);
+   QVERIFY(QCanServerMemory::readStatistic(ptsMemoryT, 1, tsReadT, 4) == false);
+
+   ptsMemoryT->atsStatistic[1].ulSequence.store(22);
+   QVERIFY(QCanServerMemory::readStatistic(ptsMemoryT, 1, tsReadT, 0));
+   QVERIFY(tsReadT.ulFrameCount == 10);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerMemory::cleanup()                                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerMemory::cleanup()
+{
+   clMemoryP.clear();
+}
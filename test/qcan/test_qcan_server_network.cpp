@@ -0,0 +1,216 @@
+//====================================================================================================================//
+// File:          test_qcan_server_network.cpp                                                                        //
+// Description:   QCAN classes - Server with more than QCAN_NETWORK_MAX networks                                      //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include <QtCore/QElapsedTimer>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+#include "test_qcan_server_network.hpp"
+
+
+//------------------------------------------------------------------------------------------------------
+// number of CAN networks of the server, the last network is used by the test
+//
+constexpr uint8_t    TEST_NETWORK_NUM = QCAN_NETWORK_MAX + 2;
+
+//------------------------------------------------------------------------------------------------------
+// timeout for all operations on the loopback interface in milliseconds
+//
+constexpr int32_t    TEST_TIMEOUT = 5000;
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerNetwork::TestQCanServerNetwork()                                                                     //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanServerNetwork::TestQCanServerNetwork()
+{
+   pclServerP = nullptr;
+   memset(&tsCanPortP, 0, sizeof(CpPort_ts));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerNetwork::~TestQCanServerNetwork()                                                                    //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanServerNetwork::~TestQCanServerNetwork()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerNetwork::initTestCase()                                                                              //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerNetwork::initTestCase()
+{
+   QTcpServer  clProbeT;
+   uint16_t    uwPortT;
+
+   pclServerP = new QCanServer(nullptr, 0, TEST_NETWORK_NUM, true);
+   if (pclServerP->state() != QCanServer::eERROR_NONE)
+   {
+      QSKIP("CANpie server is already active");
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // search a free port for the raw TCP server
+   //
+   QVERIFY(clProbeT.listen(QHostAddress::LocalHost, 0));
+   uwPortT = clProbeT.serverPort();
+   clProbeT.close();
+
+   QVERIFY(pclServerP->setTcpPort(uwPortT));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerNetwork::checkNetworkList()                                                                          //
+// every network is created and addressed by its channel number                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerNetwork::checkNetworkList()
+{
+   uint8_t  ubNetIdxT;
+
+   QVERIFY(pclServerP->maximumNetwork() == TEST_NETWORK_NUM);
+   for (ubNetIdxT = 0; ubNetIdxT < TEST_NETWORK_NUM; ubNetIdxT++)
+   {
+      QVERIFY(pclServerP->network(ubNetIdxT) != nullptr);
+      QVERIFY(pclServerP->network(ubNetIdxT)->channel() == (ubNetIdxT + 1));
+   }
+   QVERIFY(pclServerP->network(TEST_NETWORK_NUM) == nullptr);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerNetwork::checkHandshake()                                                                            //
+// the raw TCP server accepts the channels above QCAN_NETWORK_MAX                                                     //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerNetwork::checkHandshake()
+{
+   QTcpSocket     clSocketT;
+   QElapsedTimer  clTimerT;
+
+   clSocketT.connectToHost(QHostAddress::LocalHost, pclServerP->tcpPort());
+   clSocketT.write(QString("CAN %1\n").arg(TEST_NETWORK_NUM).toLatin1());
+
+   clTimerT.start();
+   while ((clTimerT.elapsed() < TEST_TIMEOUT) && (clSocketT.canReadLine() == false))
+   {
+      QTest::qWait(5);
+   }
+
+   QVERIFY(clSocketT.readLine(QCAN_TCP_HANDSHAKE_SIZE).trimmed() == QString("OK %1").arg(TEST_NETWORK_NUM));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerNetwork::checkFrameExchange()                                                                        //
+// CAN frames are exchanged on the last network                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerNetwork::checkFrameExchange()
+{
+   QCanSocket  clSenderT;
+   QCanSocket  clReceiverT;
+   QCanFrame   clFrameT;
+   uint32_t    ulFrameCountT;
+
+   clSenderT.setTcpHostAddress(QHostAddress::LocalHost, pclServerP->tcpPort());
+   clReceiverT.setTcpHostAddress(QHostAddress::LocalHost, pclServerP->tcpPort());
+   QVERIFY(clReceiverT.connectNetwork(static_cast< QCan::CAN_Channel_e >(TEST_NETWORK_NUM)));
+   QTRY_VERIFY_WITH_TIMEOUT(clReceiverT.isConnected(), TEST_TIMEOUT);
+   QVERIFY(clSenderT.connectNetwork(static_cast< QCan::CAN_Channel_e >(TEST_NETWORK_NUM)));
+   QTRY_VERIFY_WITH_TIMEOUT(clSenderT.isConnected(), TEST_TIMEOUT);
+
+   for (ulFrameCountT = 0; ulFrameCountT < 10; ulFrameCountT++)
+   {
+      clFrameT.setIdentifier(0x200 + ulFrameCountT);
+      clFrameT.setDlc(2);
+      QVERIFY(clSenderT.write(clFrameT));
+   }
+
+   QTRY_VERIFY_WITH_TIMEOUT(clReceiverT.framesAvailable() == 10, TEST_TIMEOUT);
+   for (ulFrameCountT = 0; ulFrameCountT < 10; ulFrameCountT++)
+   {
+      QVERIFY(clReceiverT.read(clFrameT));
+      QVERIFY(clFrameT.identifier() == (0x200 + ulFrameCountT));
+   }
+
+   clSenderT.disconnectNetwork();
+   clReceiverT.disconnectNetwork();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerNetwork::checkDriver()                                                                               //
+// the CANpie FD driver creates its socket only by CpCoreDriverInit()                                                 //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerNetwork::checkDriver()
+{
+   CpStatus_tv tvResultT;
+
+   //---------------------------------------------------------------------------------------------------
+   // the accessor functions do not create a socket for a channel which is not initialised
+   //
+   tsCanPortP.ubPhyIf = TEST_NETWORK_NUM;
+   QVERIFY(CpCoreBitrate(&tsCanPortP, eCP_BITRATE_500K, eCP_BITRATE_NONE) == eCP_ERR_CHANNEL);
+   QVERIFY(CpSocketConnectSlots(TEST_NETWORK_NUM, this, nullptr, nullptr, nullptr) == eCP_ERR_INIT_MISSING);
+   QVERIFY(CpSocketInstance(TEST_NETWORK_NUM) == nullptr);
+
+   //---------------------------------------------------------------------------------------------------
+   // the local server of the network is opened when the network is enabled
+   //
+   pclServerP->network(TEST_NETWORK_NUM - 1)->setNetworkEnabled(true);
+
+   memset(&tsCanPortP, 0, sizeof(CpPort_ts));
+   tvResultT = CpCoreDriverInit(TEST_NETWORK_NUM, &tsCanPortP, 0);
+   QVERIFY(tvResultT == eCP_ERR_NONE);
+   QVERIFY(tsCanPortP.ubPhyIf == TEST_NETWORK_NUM);
+   QVERIFY(CpSocketInstance(TEST_NETWORK_NUM) != nullptr);
+   QVERIFY(CpSocketInstance(TEST_NETWORK_NUM)->isConnected());
+
+   tvResultT = CpCoreDriverRelease(&tsCanPortP);
+   QVERIFY(tvResultT == eCP_ERR_NONE);
+   pclServerP->network(TEST_NETWORK_NUM - 1)->setNetworkEnabled(false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerNetwork::cleanupTestCase()                                                                           //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerNetwork::cleanupTestCase()
+{
+   delete pclServerP;
+   pclServerP = nullptr;
+}
@@ -0,0 +1,80 @@
+//====================================================================================================================//
+// File:          test_qcan_server_network.hpp                                                                        //
+// Description:   QCAN classes - Server with more than QCAN_NETWORK_MAX networks                                      //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#ifndef TEST_QCAN_SERVER_NETWORK_HPP_
+#define TEST_QCAN_SERVER_NETWORK_HPP_
+
+
+#include <QtTest/QTest>
+
+#include <QCanSocket>
+
+#include "qcan_server.hpp"
+#include "qcan_socket_canpie_fd.hpp"
+
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \class   TestQCanServerNetwork
+** \brief   Test a server with more CAN networks than #QCAN_NETWORK_MAX
+**
+** The test case creates a QCanServer with two CAN networks more than the default number and
+** connects to the last network by raw TCP and by the CANpie FD driver. It is skipped if another
+** CANpie server is active on this host.
+*/
+class TestQCanServerNetwork : public QObject
+{
+   Q_OBJECT
+
+public:
+
+   TestQCanServerNetwork();
+
+   ~TestQCanServerNetwork();
+
+private:
+
+   QCanServer *            pclServerP;
+   CpPort_ts               tsCanPortP;
+
+private slots:
+
+   void initTestCase();
+
+   void checkNetworkList();
+   void checkHandshake();
+   void checkFrameExchange();
+   void checkDriver();
+
+   void cleanupTestCase();
+};
+
+#endif   // TEST_QCAN_SERVER_NETWORK_HPP_
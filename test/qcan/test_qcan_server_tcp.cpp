@@ -0,0 +1,307 @@
+//====================================================================================================================//
+// File:          test_qcan_server_tcp.cpp                                                                            //
+// Description:   QCAN classes - Raw TCP handshake tests                                                              //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include <QtCore/QElapsedTimer>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+#include <QtTest/QSignalSpy>
+
+#include "test_qcan_server_tcp.hpp"
+
+
+//------------------------------------------------------------------------------------------------------
+// timeout for all operations on the loopback interface in milliseconds
+//
+constexpr int32_t    TEST_TIMEOUT = 5000;
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::TestQCanServerTcp()                                                                             //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanServerTcp::TestQCanServerTcp()
+{
+   pclServerP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::~TestQCanServerTcp()                                                                            //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanServerTcp::~TestQCanServerTcp()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::handshake()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QByteArray TestQCanServerTcp::handshake(const QByteArray & clLineR)
+{
+   QTcpSocket     clSocketT;
+   QElapsedTimer  clTimerT;
+
+   clSocketT.connectToHost(QHostAddress::LocalHost, pclServerP->tcpPort());
+   clSocketT.write(clLineR);
+
+   //---------------------------------------------------------------------------------------------------
+   // the server answers with a single line, a rejected connection is closed afterwards
+   //
+   clTimerT.start();
+   while ((clTimerT.elapsed() < TEST_TIMEOUT) && (clSocketT.canReadLine() == false))
+   {
+      QTest::qWait(5);
+   }
+
+   return (clSocketT.readLine(QCAN_TCP_HANDSHAKE_SIZE).trimmed());
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::initTestCase()                                                                                  //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerTcp::initTestCase()
+{
+   QTcpServer  clProbeT;
+   uint16_t    uwPortT;
+
+   qRegisterMetaType<QAbstractSocket::SocketError>();
+
+   //---------------------------------------------------------------------------------------------------
+   // the WebSocket server uses a free port, the shared memory of the server is unique on this host
+   //
+   pclServerP = new QCanServer(nullptr, 0, 2, true);
+   if (pclServerP->state() != QCanServer::eERROR_NONE)
+   {
+      QSKIP("CANpie server is already active");
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // search a free port for the raw TCP server
+   //
+   QVERIFY(clProbeT.listen(QHostAddress::LocalHost, 0));
+   uwPortT = clProbeT.serverPort();
+   clProbeT.close();
+
+   QVERIFY(pclServerP->setTcpPort(uwPortT));
+   QVERIFY(pclServerP->tcpPort() == uwPortT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::checkHandshakeCan()                                                                             //
+// "CAN n" attaches the connection to a single CAN network                                                            //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerTcp::checkHandshakeCan()
+{
+   QVERIFY(handshake("CAN 1\n") == "OK 1");
+   QVERIFY(handshake("CAN 2\n") == "OK 2");
+   QVERIFY(handshake("  CAN   2  \r\n") == "OK 2");
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::checkHandshakeBridge()                                                                          //
+// "CAN n BRIDGE id" attaches the bridge link of a remote server                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerTcp::checkHandshakeBridge()
+{
+   QVERIFY(handshake("CAN 1 BRIDGE 4711\n") == "OK 1");
+   QVERIFY(handshake("CAN 2 BRIDGE {a5a5}\n") == "OK 2");
+
+   //---------------------------------------------------------------------------------------------------
+   // the bridge identifier is mandatory
+   //
+   QVERIFY(handshake("CAN 1 BRIDGE\n") == "ERR unknown channel");
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::checkHandshakeMux()                                                                             //
+// "MUX" attaches the connection to several CAN networks                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerTcp::checkHandshakeMux()
+{
+   QVERIFY(handshake("MUX 1 2\n") == "OK 1 2");
+   QVERIFY(handshake("MUX 2\n") == "OK 2");
+   QVERIFY(handshake("MUX *\n") == "OK 1 2");
+
+   //---------------------------------------------------------------------------------------------------
+   // channels which do not exist are ignored as long as one channel can be attached
+   //
+   QVERIFY(handshake("MUX 2 9\n") == "OK 2");
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::checkHandshakeOversize()                                                                        //
+// a line which exceeds QCAN_TCP_HANDSHAKE_SIZE is rejected                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerTcp::checkHandshakeOversize()
+{
+   QVERIFY(handshake(QByteArray(QCAN_TCP_HANDSHAKE_SIZE + 16, 'C')) == "ERR invalid handshake");
+   QVERIFY(handshake("CAN 1" + QByteArray(QCAN_TCP_HANDSHAKE_SIZE, ' ')) == "ERR invalid handshake");
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::checkHandshakeUnknown()                                                                         //
+// handshake with unknown CAN channel or keyword                                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerTcp::checkHandshakeUnknown()
+{
+   QVERIFY(handshake("CAN 0\n") == "ERR unknown channel");
+   QVERIFY(handshake("CAN 3\n") == "ERR unknown channel");
+   QVERIFY(handshake("CAN x\n") == "ERR unknown channel");
+   QVERIFY(handshake("CAN 1 2\n") == "ERR unknown channel");
+   QVERIFY(handshake("MUX 3 4\n") == "ERR unknown channel");
+   QVERIFY(handshake("FOO 1\n") == "ERR unknown channel");
+   QVERIFY(handshake("\n") == "ERR unknown channel");
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::checkSocketTcp()                                                                                //
+// QCanSocket connects to a single CAN network                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerTcp::checkSocketTcp()
+{
+   QCanSocket  clSocketT;
+
+   clSocketT.setTcpHostAddress(QHostAddress::LocalHost, pclServerP->tcpPort());
+   QVERIFY(clSocketT.transport() == QCanSocket::eTRANSPORT_TCP);
+   QVERIFY(clSocketT.connectNetwork(QCan::eCAN_CHANNEL_2));
+   QTRY_VERIFY_WITH_TIMEOUT(clSocketT.isConnected(), TEST_TIMEOUT);
+   QVERIFY(clSocketT.isMultiplexed() == false);
+
+   clSocketT.disconnectNetwork();
+   QVERIFY(clSocketT.isConnected() == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::checkSocketMux()                                                                                //
+// QCanSocket connects to several CAN networks                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerTcp::checkSocketMux()
+{
+   QCanSocket                    clSocketT;
+   QVector<QCan::CAN_Channel_e>  clChannelListT;
+
+   clSocketT.setTcpHostAddress(QHostAddress::LocalHost, pclServerP->tcpPort());
+   clChannelListT << QCan::eCAN_CHANNEL_1 << QCan::eCAN_CHANNEL_2;
+   QVERIFY(clSocketT.connectNetworks(clChannelListT));
+   QTRY_VERIFY_WITH_TIMEOUT(clSocketT.isConnected(), TEST_TIMEOUT);
+   QVERIFY(clSocketT.isMultiplexed());
+   QVERIFY(clSocketT.channels() == clChannelListT);
+   clSocketT.disconnectNetwork();
+
+   //---------------------------------------------------------------------------------------------------
+   // an empty list selects all CAN networks of the server
+   //
+   clChannelListT.clear();
+   QVERIFY(clSocketT.connectNetworks(clChannelListT));
+   QTRY_VERIFY_WITH_TIMEOUT(clSocketT.isConnected(), TEST_TIMEOUT);
+   QVERIFY(clSocketT.channels().size() == 2);
+   clSocketT.disconnectNetwork();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::checkSocketReject()                                                                             //
+// QCanSocket reports the rejected handshake                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerTcp::checkSocketReject()
+{
+   QCanSocket  clSocketT;
+   QSignalSpy  clErrorSpyT(&clSocketT, &QCanSocket::errorOccurred);
+
+   clSocketT.setTcpHostAddress(QHostAddress::LocalHost, pclServerP->tcpPort());
+   QVERIFY(clSocketT.connectNetwork(QCan::eCAN_CHANNEL_5));
+   QTRY_VERIFY_WITH_TIMEOUT(clErrorSpyT.count() > 0, TEST_TIMEOUT);
+
+   QVERIFY(clErrorSpyT.first().at(0).value<QAbstractSocket::SocketError>() ==
+           QAbstractSocket::ConnectionRefusedError);
+   QVERIFY(clSocketT.isConnected() == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::checkFrameExchange()                                                                            //
+// CAN frames are exchanged between two raw TCP connections                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerTcp::checkFrameExchange()
+{
+   QCanSocket  clSenderT;
+   QCanSocket  clReceiverT;
+   QCanFrame   clFrameT;
+   uint32_t    ulFrameCountT;
+
+   clSenderT.setTcpHostAddress(QHostAddress::LocalHost, pclServerP->tcpPort());
+   clReceiverT.setTcpHostAddress(QHostAddress::LocalHost, pclServerP->tcpPort());
+   QVERIFY(clReceiverT.connectNetwork(QCan::eCAN_CHANNEL_1));
+   QTRY_VERIFY_WITH_TIMEOUT(clReceiverT.isConnected(), TEST_TIMEOUT);
+   QVERIFY(clSenderT.connectNetwork(QCan::eCAN_CHANNEL_1));
+   QTRY_VERIFY_WITH_TIMEOUT(clSenderT.isConnected(), TEST_TIMEOUT);
+
+   for (ulFrameCountT = 0; ulFrameCountT < 10; ulFrameCountT++)
+   {
+      clFrameT.setIdentifier(0x100 + ulFrameCountT);
+      clFrameT.setDlc(4);
+      QVERIFY(clSenderT.write(clFrameT));
+   }
+
+   QTRY_VERIFY_WITH_TIMEOUT(clReceiverT.framesAvailable() == 10, TEST_TIMEOUT);
+   for (ulFrameCountT = 0; ulFrameCountT < 10; ulFrameCountT++)
+   {
+      QVERIFY(clReceiverT.read(clFrameT));
+      QVERIFY(clFrameT.identifier() == (0x100 + ulFrameCountT));
+      QVERIFY(clFrameT.dlc() == 4);
+   }
+
+   clSenderT.disconnectNetwork();
+   clReceiverT.disconnectNetwork();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanServerTcp::cleanupTestCase()                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanServerTcp::cleanupTestCase()
+{
+   delete pclServerP;
+   pclServerP = nullptr;
+}
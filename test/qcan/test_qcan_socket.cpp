@@ -172,3 +172,223 @@ void TestQCanSocket::cleanupTestCase()
 }
 
 
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketFifo::TestQCanSocketFifo()                                                                           //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanSocketFifo::TestQCanSocketFifo()
+{
+   pclSocketP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketFifo::~TestQCanSocketFifo()                                                                          //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanSocketFifo::~TestQCanSocketFifo()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketFifo::initTestCase()                                                                                 //
+// the socket is never connected, the frames are placed in the receive FIFO directly                                  //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanSocketFifo::initTestCase()
+{
+   pclSocketP = new QCanSocketFifo();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketFifo::checkFifoSize()                                                                                //
+// check rounding of the FIFO size                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanSocketFifo::checkFifoSize()
+{
+   QVERIFY(pclSocketP->receiveFifoSize() == QCAN_SOCKET_RCV_FIFO_SIZE);
+
+   //---------------------------------------------------------------------------------------------------
+   // invalid values do not change the size
+   //
+   QVERIFY(pclSocketP->setReceiveFifoSize(0) == false);
+   QVERIFY(pclSocketP->setReceiveFifoSize(0x00100001) == false);
+   QVERIFY(pclSocketP->receiveFifoSize() == QCAN_SOCKET_RCV_FIFO_SIZE);
+
+   //---------------------------------------------------------------------------------------------------
+   // the size is rounded up to the next power of 2
+   //
+   QVERIFY(pclSocketP->setReceiveFifoSize(1) == true);
+   QVERIFY(pclSocketP->receiveFifoSize() == 1);
+   QVERIFY(pclSocketP->setReceiveFifoSize(3) == true);
+   QVERIFY(pclSocketP->receiveFifoSize() == 4);
+   QVERIFY(pclSocketP->setReceiveFifoSize(4) == true);
+   QVERIFY(pclSocketP->receiveFifoSize() == 4);
+   QVERIFY(pclSocketP->setReceiveFifoSize(5) == true);
+   QVERIFY(pclSocketP->receiveFifoSize() == 8);
+   QVERIFY(pclSocketP->setReceiveFifoSize(1000) == true);
+   QVERIFY(pclSocketP->receiveFifoSize() == 1024);
+
+   //---------------------------------------------------------------------------------------------------
+   // changing the size discards all frames
+   //
+   QVERIFY(pclSocketP->pushReceiveFifo(QCanFrame(QCanFrame::eFORMAT_CAN_STD, 0x123), 1) == true);
+   QVERIFY(pclSocketP->framesAvailable() == 1);
+   QVERIFY(pclSocketP->setReceiveFifoSize(16) == true);
+   QVERIFY(pclSocketP->framesAvailable() == 0);
+   QVERIFY(pclSocketP->receiveFifoWatermark() == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketFifo::checkDropNewest()                                                                              //
+// a full FIFO discards the received frame                                                                            //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanSocketFifo::checkDropNewest()
+{
+   QCanFrame   clFrameT;
+   uint32_t    ulIdT;
+
+   QVERIFY(pclSocketP->setReceiveFifoSize(4) == true);
+   pclSocketP->setFifoOverflow(QCanSocket::eFIFO_OVERFLOW_DROP_NEWEST);
+   pclSocketP->resetFifoStatistic();
+
+   for (ulIdT = 1; ulIdT <= 4; ulIdT++)
+   {
+      QVERIFY(pclSocketP->pushReceiveFifo(QCanFrame(QCanFrame::eFORMAT_CAN_STD, ulIdT), 1) == true);
+   }
+   QVERIFY(pclSocketP->pushReceiveFifo(QCanFrame(QCanFrame::eFORMAT_CAN_STD, 5), 1) == false);
+   QVERIFY(pclSocketP->pushReceiveFifo(QCanFrame(QCanFrame::eFORMAT_CAN_STD, 6), 1) == false);
+
+   QVERIFY(pclSocketP->framesAvailable() == 4);
+   QVERIFY(pclSocketP->framesDropped() == 2);
+   QVERIFY(pclSocketP->receiveFifoWatermark() == 4);
+
+   //---------------------------------------------------------------------------------------------------
+   // the first four frames are kept
+   //
+   for (ulIdT = 1; ulIdT <= 4; ulIdT++)
+   {
+      QVERIFY(pclSocketP->read(clFrameT) == true);
+      QVERIFY(clFrameT.identifier() == ulIdT);
+   }
+   QVERIFY(pclSocketP->read(clFrameT) == false);
+
+   //---------------------------------------------------------------------------------------------------
+   // frames are accepted again after reading
+   //
+   QVERIFY(pclSocketP->pushReceiveFifo(QCanFrame(QCanFrame::eFORMAT_CAN_STD, 7), 1) == true);
+   QVERIFY(pclSocketP->read(clFrameT) == true);
+   QVERIFY(clFrameT.identifier() == 7);
+   QVERIFY(pclSocketP->framesDropped() == 2);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketFifo::checkDropOldest()                                                                              //
+// a full FIFO discards the oldest frame                                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanSocketFifo::checkDropOldest()
+{
+   QCanFrame   clFrameT;
+   uint32_t    ulIdT;
+
+   QVERIFY(pclSocketP->setReceiveFifoSize(4) == true);
+   pclSocketP->setFifoOverflow(QCanSocket::eFIFO_OVERFLOW_DROP_OLDEST);
+   pclSocketP->resetFifoStatistic();
+
+   for (ulIdT = 1; ulIdT <= 10; ulIdT++)
+   {
+      QVERIFY(pclSocketP->pushReceiveFifo(QCanFrame(QCanFrame::eFORMAT_CAN_STD, ulIdT), 1) == true);
+   }
+
+   QVERIFY(pclSocketP->framesAvailable() == 4);
+   QVERIFY(pclSocketP->framesDropped() == 6);
+   QVERIFY(pclSocketP->receiveFifoWatermark() == 4);
+
+   //---------------------------------------------------------------------------------------------------
+   // the last four frames are kept in order of reception
+   //
+   for (ulIdT = 7; ulIdT <= 10; ulIdT++)
+   {
+      QVERIFY(pclSocketP->read(clFrameT) == true);
+      QVERIFY(clFrameT.identifier() == ulIdT);
+   }
+   QVERIFY(pclSocketP->read(clFrameT) == false);
+
+   pclSocketP->setFifoOverflow(QCanSocket::eFIFO_OVERFLOW_DROP_NEWEST);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketFifo::checkReadFrames()                                                                              //
+// read several frames at once, also across the end of the ring buffer                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanSocketFifo::checkReadFrames()
+{
+   QCanFrame            aclFrameT[16];
+   QCan::CAN_Channel_e  ateChannelT[16];
+   uint32_t             ulIdT;
+
+   QVERIFY(pclSocketP->setReceiveFifoSize(8) == true);
+   pclSocketP->resetFifoStatistic();
+
+   QVERIFY(pclSocketP->readFrames(aclFrameT, 16) == 0);
+   QVERIFY(pclSocketP->readFrames(nullptr, 16) == 0);
+
+   for (ulIdT = 1; ulIdT <= 5; ulIdT++)
+   {
+      QVERIFY(pclSocketP->pushReceiveFifo(QCanFrame(QCanFrame::eFORMAT_CAN_EXT, ulIdT),
+                                          static_cast< uint8_t >(ulIdT)) == true);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // the number of frames is limited by the buffer size
+   //
+   QVERIFY(pclSocketP->readFrames(aclFrameT, 3, ateChannelT) == 3);
+   for (ulIdT = 0; ulIdT < 3; ulIdT++)
+   {
+      QVERIFY(aclFrameT[ulIdT].identifier() == ulIdT + 1);
+      QVERIFY(aclFrameT[ulIdT].frameFormat() == QCanFrame::eFORMAT_CAN_EXT);
+      QVERIFY(ateChannelT[ulIdT] == static_cast< QCan::CAN_Channel_e >(ulIdT + 1));
+   }
+   QVERIFY(pclSocketP->framesAvailable() == 2);
+
+   //---------------------------------------------------------------------------------------------------
+   // the number of frames is limited by the fill level
+   //
+   QVERIFY(pclSocketP->readFrames(aclFrameT, 16) == 2);
+   QVERIFY(aclFrameT[0].identifier() == 4);
+   QVERIFY(aclFrameT[1].identifier() == 5);
+   QVERIFY(pclSocketP->framesAvailable() == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // the next 8 frames wrap around the end of the ring buffer
+   //
+   for (ulIdT = 10; ulIdT < 18; ulIdT++)
+   {
+      QVERIFY(pclSocketP->pushReceiveFifo(QCanFrame(QCanFrame::eFORMAT_CAN_STD, ulIdT), 2) == true);
+   }
+   QVERIFY(pclSocketP->pushReceiveFifo(QCanFrame(QCanFrame::eFORMAT_CAN_STD, 18), 2) == false);
+
+   QVERIFY(pclSocketP->readFrames(aclFrameT, 16, ateChannelT) == 8);
+   for (ulIdT = 0; ulIdT < 8; ulIdT++)
+   {
+      QVERIFY(aclFrameT[ulIdT].identifier() == ulIdT + 10);
+      QVERIFY(ateChannelT[ulIdT] == QCan::eCAN_CHANNEL_2);
+   }
+   QVERIFY(pclSocketP->framesAvailable() == 0);
+   QVERIFY(pclSocketP->receiveFifoWatermark() == 8);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketFifo::cleanupTestCase()                                                                              //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanSocketFifo::cleanupTestCase()
+{
+   delete pclSocketP;
+}
@@ -74,6 +74,52 @@ private slots:
 };
 
 
+//------------------------------------------------------------------------------------------------------
+/*!
+** \class   QCanSocketFifo
+** \brief   CAN socket with access to the receive FIFO
+**
+** The class makes the function QCanSocket::pushReceiveFifo() accessible, so the receive FIFO can be
+** tested without connection to a CAN network.
+*/
+class QCanSocketFifo : public QCanSocket
+{
+public:
+   using QCanSocket::pushReceiveFifo;
+};
+
+
+//------------------------------------------------------------------------------------------------------
+/*!
+** \class   TestQCanSocketFifo
+** \brief   Test receive FIFO of CAN socket
+**
+*/
+class TestQCanSocketFifo : public QObject
+{
+   Q_OBJECT
+
+public:
+
+   TestQCanSocketFifo();
+
+   ~TestQCanSocketFifo();
+
+private:
+
+   QCanSocketFifo *  pclSocketP;
+
+private slots:
+
+   void initTestCase();
+
+   void checkFifoSize();
+   void checkDropNewest();
+   void checkDropOldest();
+   void checkReadFrames();
+
+   void cleanupTestCase();
+};
 
 
 #endif   // TEST_QCAN_SOCKET_HPP_
@@ -0,0 +1,235 @@
+//====================================================================================================================//
+// File:          test_qcan_socket_list.cpp                                                                           //
+// Description:   QCAN classes - Socket list tests                                                                    //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_socket_list.hpp"
+
+
+//------------------------------------------------------------------------------------------------------
+// number of sockets used by the test
+//
+constexpr int32_t    TEST_SOCKET_MAX = 16;
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketList::TestQCanSocketList()                                                                           //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanSocketList::TestQCanSocketList()
+{
+   pclListP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketList::~TestQCanSocketList()                                                                          //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanSocketList::~TestQCanSocketList()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketList::isIndexValid()                                                                                 //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+bool TestQCanSocketList::isIndexValid(void) const
+{
+   int32_t  slSockIdxT;
+
+   for (slSockIdxT = 0; slSockIdxT < pclListP->size(); slSockIdxT++)
+   {
+      if (pclListP->indexOf(pclListP->list().at(slSockIdxT)) != slSockIdxT)
+      {
+         return (false);
+      }
+   }
+
+   return (pclListP->list().size() == pclListP->size());
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketList::init()                                                                                         //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanSocketList::init()
+{
+   int32_t  slSockIdxT;
+
+   pclListP = new QCanSocketList<QObject>();
+   for (slSockIdxT = 0; slSockIdxT < TEST_SOCKET_MAX; slSockIdxT++)
+   {
+      clSocketP.append(new QObject());
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketList::checkAppend()                                                                                  //
+// the number of sockets is limited, a socket is only added once                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanSocketList::checkAppend()
+{
+   QVERIFY(pclListP->size() == 0);
+   QVERIFY(pclListP->indexOf(clSocketP.at(0)) == -1);
+
+   QVERIFY(pclListP->append(clSocketP.at(0), 3));
+   QVERIFY(pclListP->append(clSocketP.at(1), 3));
+   QVERIFY(pclListP->append(clSocketP.at(1), 3) == false);
+   QVERIFY(pclListP->append(nullptr, 3) == false);
+   QVERIFY(pclListP->append(clSocketP.at(2), 3));
+   QVERIFY(pclListP->append(clSocketP.at(3), 3) == false);
+
+   QVERIFY(pclListP->size() == 3);
+   QVERIFY(pclListP->indexOf(clSocketP.at(0)) == 0);
+   QVERIFY(pclListP->indexOf(clSocketP.at(1)) == 1);
+   QVERIFY(pclListP->indexOf(clSocketP.at(2)) == 2);
+   QVERIFY(pclListP->indexOf(clSocketP.at(3)) == -1);
+
+   pclListP->clear();
+   QVERIFY(pclListP->size() == 0);
+   QVERIFY(pclListP->indexOf(clSocketP.at(0)) == -1);
+   QVERIFY(pclListP->append(clSocketP.at(3), 3));
+   QVERIFY(pclListP->indexOf(clSocketP.at(3)) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketList::checkRemove()                                                                                  //
+// the last socket takes the position of the removed socket                                                           //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanSocketList::checkRemove()
+{
+   int32_t  slSockIdxT;
+
+   for (slSockIdxT = 0; slSockIdxT < 5; slSockIdxT++)
+   {
+      QVERIFY(pclListP->append(clSocketP.at(slSockIdxT), TEST_SOCKET_MAX));
+   }
+
+   QVERIFY(pclListP->remove(clSocketP.at(1)));
+   QVERIFY(pclListP->size() == 4);
+   QVERIFY(pclListP->indexOf(clSocketP.at(1)) == -1);
+   QVERIFY(pclListP->list().at(1) == clSocketP.at(4));
+   QVERIFY(pclListP->indexOf(clSocketP.at(4)) == 1);
+   QVERIFY(isIndexValid());
+
+   //---------------------------------------------------------------------------------------------------
+   // remove the last socket and a socket which is not part of the list
+   //
+   QVERIFY(pclListP->remove(clSocketP.at(3)));
+   QVERIFY(pclListP->size() == 3);
+   QVERIFY(isIndexValid());
+   QVERIFY(pclListP->remove(clSocketP.at(3)) == false);
+   QVERIFY(pclListP->remove(clSocketP.at(8)) == false);
+   QVERIFY(pclListP->remove(nullptr) == false);
+   QVERIFY(pclListP->size() == 3);
+
+   QVERIFY(pclListP->remove(clSocketP.at(0)));
+   QVERIFY(pclListP->remove(clSocketP.at(2)));
+   QVERIFY(pclListP->remove(clSocketP.at(4)));
+   QVERIFY(pclListP->size() == 0);
+   QVERIFY(isIndexValid());
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketList::checkSnapshot()                                                                                //
+// a copy of the list is not affected by later changes                                                                //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanSocketList::checkSnapshot()
+{
+   int32_t  slSockIdxT;
+
+   for (slSockIdxT = 0; slSockIdxT < 4; slSockIdxT++)
+   {
+      QVERIFY(pclListP->append(clSocketP.at(slSockIdxT), TEST_SOCKET_MAX));
+   }
+
+   const QVector<QObject *> clSnapshotT = pclListP->list();
+
+   QVERIFY(pclListP->remove(clSocketP.at(0)));
+   QVERIFY(pclListP->append(clSocketP.at(5), TEST_SOCKET_MAX));
+
+   QVERIFY(clSnapshotT.size() == 4);
+   for (slSockIdxT = 0; slSockIdxT < 4; slSockIdxT++)
+   {
+      QVERIFY(clSnapshotT.at(slSockIdxT) == clSocketP.at(slSockIdxT));
+   }
+
+   QVERIFY(pclListP->list().at(0) == clSocketP.at(3));
+   QVERIFY(pclListP->list().at(3) == clSocketP.at(5));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketList::checkSequence()                                                                                //
+// the index is valid after every connect and disconnect                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanSocketList::checkSequence()
+{
+   int32_t  slStepT;
+   int32_t  slSockIdxT;
+   uint32_t ulRandomT = 4711;
+
+   for (slStepT = 0; slStepT < 2000; slStepT++)
+   {
+      ulRandomT  = (ulRandomT * 1103515245) + 12345;
+      slSockIdxT = static_cast< int32_t >((ulRandomT >> 16) % TEST_SOCKET_MAX);
+
+      if (pclListP->indexOf(clSocketP.at(slSockIdxT)) < 0)
+      {
+         QVERIFY(pclListP->append(clSocketP.at(slSockIdxT), TEST_SOCKET_MAX));
+      }
+      else
+      {
+         QVERIFY(pclListP->remove(clSocketP.at(slSockIdxT)));
+         QVERIFY(pclListP->indexOf(clSocketP.at(slSockIdxT)) == -1);
+      }
+      QVERIFY(isIndexValid());
+   }
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanSocketList::cleanup()                                                                                      //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanSocketList::cleanup()
+{
+   delete pclListP;
+   pclListP = nullptr;
+
+   qDeleteAll(clSocketP);
+   clSocketP.clear();
+}
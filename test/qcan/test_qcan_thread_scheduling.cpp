@@ -0,0 +1,161 @@
+//====================================================================================================================//
+// File:          test_qcan_thread_scheduling.cpp                                                                     //
+// Description:   QCAN classes - Thread scheduling tests                                                              //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_thread_scheduling.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanThreadScheduling::TestQCanThreadScheduling()                                                               //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanThreadScheduling::TestQCanThreadScheduling()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanThreadScheduling::~TestQCanThreadScheduling()                                                              //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanThreadScheduling::~TestQCanThreadScheduling()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanThreadScheduling::checkCpuList()                                                                           //
+// CPU list in the format of taskset(1)                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanThreadScheduling::checkCpuList()
+{
+   QList<int32_t> aslCpuListT;
+
+   QVERIFY(QCanThreadScheduling::parseCpuList("", aslCpuListT));
+   QVERIFY(aslCpuListT.isEmpty());
+
+   QVERIFY(QCanThreadScheduling::parseCpuList("2", aslCpuListT));
+   QVERIFY(aslCpuListT == (QList<int32_t>() << 2));
+
+   QVERIFY(QCanThreadScheduling::parseCpuList("1,3-5", aslCpuListT));
+   QVERIFY(aslCpuListT == (QList<int32_t>() << 1 << 3 << 4 << 5));
+
+   //---------------------------------------------------------------------------------------------------
+   // blanks and empty items are ignored, a CPU is listed only once
+   //
+   QVERIFY(QCanThreadScheduling::parseCpuList(" 0 , 2-3 ,, 2", aslCpuListT));
+   QVERIFY(aslCpuListT == (QList<int32_t>() << 0 << 2 << 3));
+
+   QVERIFY(QCanThreadScheduling::parseCpuList("0-1023", aslCpuListT));
+   QVERIFY(aslCpuListT.size() == 1024);
+   QVERIFY(aslCpuListT.last() == 1023);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanThreadScheduling::checkCpuListInvalid()                                                                    //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanThreadScheduling::checkCpuListInvalid()
+{
+   QList<int32_t> aslCpuListT;
+
+   QVERIFY(QCanThreadScheduling::parseCpuList("x", aslCpuListT) == false);
+   QVERIFY(QCanThreadScheduling::parseCpuList("1.5", aslCpuListT) == false);
+   QVERIFY(QCanThreadScheduling::parseCpuList("-1", aslCpuListT) == false);
+   QVERIFY(QCanThreadScheduling::parseCpuList("1-", aslCpuListT) == false);
+   QVERIFY(QCanThreadScheduling::parseCpuList("3-1", aslCpuListT) == false);
+   QVERIFY(QCanThreadScheduling::parseCpuList("1-2-3", aslCpuListT) == false);
+   QVERIFY(QCanThreadScheduling::parseCpuList("1024", aslCpuListT) == false);
+   QVERIFY(QCanThreadScheduling::parseCpuList("0-1024", aslCpuListT) == false);
+   QVERIFY(QCanThreadScheduling::parseCpuList("1,x", aslCpuListT) == false);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanThreadScheduling::checkPolicy()                                                                            //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanThreadScheduling::checkPolicy()
+{
+   QCanThreadScheduling::Policy_e   tePolicyT = QCanThreadScheduling::ePOLICY_RR;
+
+   QVERIFY(QCanThreadScheduling::parsePolicy("", tePolicyT));
+   QVERIFY(tePolicyT == QCanThreadScheduling::ePOLICY_OTHER);
+
+   QVERIFY(QCanThreadScheduling::parsePolicy(" fifo ", tePolicyT));
+   QVERIFY(tePolicyT == QCanThreadScheduling::ePOLICY_FIFO);
+
+   QVERIFY(QCanThreadScheduling::parsePolicy("other", tePolicyT));
+   QVERIFY(tePolicyT == QCanThreadScheduling::ePOLICY_OTHER);
+
+   QVERIFY(QCanThreadScheduling::parsePolicy("RR", tePolicyT));
+   QVERIFY(tePolicyT == QCanThreadScheduling::ePOLICY_RR);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanThreadScheduling::checkPolicyInvalid()                                                                     //
+// an unknown policy does not change the result                                                                       //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanThreadScheduling::checkPolicyInvalid()
+{
+   QCanThreadScheduling::Policy_e   tePolicyT = QCanThreadScheduling::ePOLICY_FIFO;
+
+   QVERIFY(QCanThreadScheduling::parsePolicy("idle", tePolicyT) == false);
+   QVERIFY(QCanThreadScheduling::parsePolicy("fifo rr", tePolicyT) == false);
+   QVERIFY(QCanThreadScheduling::parsePolicy("SCHED_FIFO", tePolicyT) == false);
+   QVERIFY(tePolicyT == QCanThreadScheduling::ePOLICY_FIFO);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanThreadScheduling::checkDefault()                                                                           //
+// the default scheduling is neither a CPU set nor a real-time policy                                                 //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanThreadScheduling::checkDefault()
+{
+   QCanThreadScheduling clSchedulingT;
+
+   QVERIFY(clSchedulingT.isDefault());
+   QVERIFY(clSchedulingT.policy() == QCanThreadScheduling::ePOLICY_OTHER);
+   QVERIFY(clSchedulingT.report().isEmpty());
+
+   clSchedulingT.setCpuList(QList<int32_t>() << 1);
+   QVERIFY(clSchedulingT.isDefault() == false);
+   clSchedulingT.setCpuList(QList<int32_t>());
+   QVERIFY(clSchedulingT.isDefault());
+
+   clSchedulingT.setPolicy(QCanThreadScheduling::ePOLICY_FIFO, 50);
+   QVERIFY(clSchedulingT.isDefault() == false);
+   QVERIFY(clSchedulingT.priority() == 50);
+}
@@ -0,0 +1,419 @@
+//====================================================================================================================//
+// File:          test_qcan_transmit_queue.cpp                                                                        //
+// Description:   QCAN classes - Priority transmit queue tests                                                        //
+//                                                                                                                    //
+// Copyright (C) MicroControl GmbH & Co. KG                                                                           //
+// 53844 Troisdorf - Germany                                                                                          //
+// www.microcontrol.net                                                                                               //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the   //
+// following conditions are met:                                                                                      //
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions, the following   //
+//    disclaimer and the referenced file 'LICENSE'.                                                                   //
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the       //
+//    following disclaimer in the documentation and/or other materials provided with the distribution.                //
+// 3. Neither the name of MicroControl nor the names of its contributors may be used to endorse or promote products   //
+//    derived from this software without specific prior written permission.                                           //
+//                                                                                                                    //
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance     //
+// with the License. You may obtain a copy of the License at                                                          //
+//                                                                                                                    //
+//    http://www.apache.org/licenses/LICENSE-2.0                                                                      //
+//                                                                                                                    //
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   //
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for  //
+// the specific language governing permissions and limitations under the License.                                     //
+//                                                                                                                    //
+//====================================================================================================================//
+
+
+
+#include "test_qcan_transmit_queue.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanTransmitQueue::TestQCanTransmitQueue()                                                                     //
+// constructor                                                                                                        //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanTransmitQueue::TestQCanTransmitQueue()
+{
+   pclQueueP = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanTransmitQueue::~TestQCanTransmitQueue()                                                                    //
+// destructor                                                                                                         //
+//--------------------------------------------------------------------------------------------------------------------//
+TestQCanTransmitQueue::~TestQCanTransmitQueue()
+{
+
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanTransmitQueue::frame()                                                                                     //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+QCanFrame TestQCanTransmitQueue::frame(const uint32_t ulIdentifierV, const bool btExtendedV, const uint8_t ubTagV)
+{
+   QCanFrame   clFrameT(btExtendedV ? QCanFrame::eFORMAT_CAN_EXT : QCanFrame::eFORMAT_CAN_STD, ulIdentifierV, 1);
+
+   clFrameT.setData(0, ubTagV);
+
+   return (clFrameT);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanTransmitQueue::init()                                                                                      //
+// each test case starts with an empty queue                                                                          //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanTransmitQueue::init()
+{
+   pclQueueP = new QCanTransmitQueue();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanTransmitQueue::checkArbitration()                                                                          //
+// check the arbitration value against the bus arbitration rules                                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanTransmitQueue::checkArbitration()
+{
+   QCanFrame   clStdT    = frame(0x100, false);
+   QCanFrame   clStdRtrT = frame(0x100, false);
+   QCanFrame   clExtT    = frame(0x100 << 18, true);
+   QCanFrame   clExtRtrT = frame(0x100 << 18, true);
+
+   clStdRtrT.setRemote(true);
+   clExtRtrT.setRemote(true);
+
+   //---------------------------------------------------------------------------------------------------
+   // with the same base identifier: data frame before remote frame, standard frame before extended
+   // frame
+   //
+   QVERIFY(QCanTransmitQueue::arbitrationValue(clStdT)    < QCanTransmitQueue::arbitrationValue(clStdRtrT));
+   QVERIFY(QCanTransmitQueue::arbitrationValue(clStdRtrT) < QCanTransmitQueue::arbitrationValue(clExtT));
+   QVERIFY(QCanTransmitQueue::arbitrationValue(clExtT)    < QCanTransmitQueue::arbitrationValue(clExtRtrT));
+
+   //---------------------------------------------------------------------------------------------------
+   // the base identifier is evaluated first
+   //
+   QVERIFY(QCanTransmitQueue::arbitrationValue(frame(0x0FF, false)) <
+           QCanTransmitQueue::arbitrationValue(frame(0x100, false)));
+   QVERIFY(QCanTransmitQueue::arbitrationValue(frame((0x0FF << 18) | 0x3FFFF, true)) <
+           QCanTransmitQueue::arbitrationValue(clStdT));
+   QVERIFY(QCanTransmitQueue::arbitrationValue(clExtRtrT) <
+           QCanTransmitQueue::arbitrationValue(frame(0x101, false)));
+   QVERIFY(QCanTransmitQueue::arbitrationValue(frame((0x100 << 18) | 0x00001, true)) >
+           QCanTransmitQueue::arbitrationValue(clExtRtrT));
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanTransmitQueue::checkOrder()                                                                                //
+// lower arbitration values come first, equal values keep the FIFO order                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanTransmitQueue::checkOrder()
+{
+   const QCanFrame * pclFrameT;
+   uint32_t          ulValueT;
+   uint32_t          ulLastValueT;
+   uint32_t          ulIdentifierT;
+   uint32_t          ulSeedT = 12345;
+   uint8_t           aubTagT[8] = { 0 };
+   uint8_t           ubTagT = 0;
+   int32_t           slCountT;
+
+   pclQueueP->setDeadline(0);
+   QVERIFY(pclQueueP->isEmpty() == true);
+   QVERIFY(pclQueueP->head(0) == nullptr);
+
+   //---------------------------------------------------------------------------------------------------
+   // add 512 frames with pseudo random identifiers from a small range, so identical values occur
+   // several times: the tag counts the frames of each identifier
+   //
+   for (slCountT = 0; slCountT < 512; slCountT++)
+   {
+      ulSeedT = (ulSeedT * 1103515245) + 12345;
+      ulIdentifierT = (ulSeedT >> 16) & 0x07;
+      QVERIFY(pclQueueP->enqueue(frame(ulIdentifierT, (slCountT & 1) == 1, aubTagT[ulIdentifierT]), 0) == true);
+      aubTagT[ulIdentifierT]++;
+   }
+   QVERIFY(pclQueueP->count() == 512);
+
+   //---------------------------------------------------------------------------------------------------
+   // the frames must come out with increasing arbitration value, frames with the same identifier
+   // and format in order of the tag
+   //
+   ulLastValueT = 0;
+   slCountT     = 0;
+   while ((pclFrameT = pclQueueP->head(0)) != nullptr)
+   {
+      ulValueT = QCanTransmitQueue::arbitrationValue(*pclFrameT);
+      QVERIFY(ulValueT >= ulLastValueT);
+      if ((slCountT > 0) && (ulValueT == ulLastValueT))
+      {
+         QVERIFY(pclFrameT->data(0) > ubTagT);
+      }
+      ubTagT       = pclFrameT->data(0);
+      ulLastValueT = ulValueT;
+      pclQueueP->pop();
+      slCountT++;
+   }
+   QVERIFY(slCountT == 512);
+   QVERIFY(pclQueueP->isEmpty() == true);
+   QVERIFY(pclQueueP->dropCount() == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // frames with identical arbitration value in FIFO order
+   //
+   for (ubTagT = 0; ubTagT < 100; ubTagT++)
+   {
+      QVERIFY(pclQueueP->enqueue(frame(0x123, false, ubTagT), 0) == true);
+   }
+   for (ubTagT = 0; ubTagT < 100; ubTagT++)
+   {
+      pclFrameT = pclQueueP->head(0);
+      QVERIFY(pclFrameT != nullptr);
+      QVERIFY(pclFrameT->data(0) == ubTagT);
+      pclQueueP->pop();
+   }
+   QVERIFY(pclQueueP->isEmpty() == true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanTransmitQueue::checkEviction()                                                                             //
+// a full queue drops the frame with the lowest priority                                                              //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanTransmitQueue::checkEviction()
+{
+   const QCanFrame * pclFrameT;
+   uint32_t          ulIdentifierT;
+
+   pclQueueP->setDeadline(0);
+
+   //---------------------------------------------------------------------------------------------------
+   // fill the queue with the identifiers 1 .. QCAN_TRANSMIT_QUEUE_SIZE
+   //
+   for (ulIdentifierT = 1; ulIdentifierT <= QCAN_TRANSMIT_QUEUE_SIZE; ulIdentifierT++)
+   {
+      QVERIFY(pclQueueP->enqueue(frame(ulIdentifierT, false), 0) == true);
+   }
+   QVERIFY(pclQueueP->count() == QCAN_TRANSMIT_QUEUE_SIZE);
+   QVERIFY(pclQueueP->dropCount() == 0);
+
+   //---------------------------------------------------------------------------------------------------
+   // a frame with lower priority than all queued frames is rejected
+   //
+   QVERIFY(pclQueueP->enqueue(frame(0x7FF, false), 0) == false);
+   QVERIFY(pclQueueP->count() == QCAN_TRANSMIT_QUEUE_SIZE);
+   QVERIFY(pclQueueP->dropCount() == 1);
+
+   //---------------------------------------------------------------------------------------------------
+   // a frame with higher priority replaces the frame with the highest identifier
+   //
+   QVERIFY(pclQueueP->enqueue(frame(0, false), 0) == true);
+   QVERIFY(pclQueueP->count() == QCAN_TRANSMIT_QUEUE_SIZE);
+   QVERIFY(pclQueueP->dropCount() == 2);
+
+   //---------------------------------------------------------------------------------------------------
+   // a second frame with an identifier which is already queued replaces the frame with the
+   // identifier QCAN_TRANSMIT_QUEUE_SIZE - 1, it is placed behind the frame queued before
+   //
+   QVERIFY(pclQueueP->enqueue(frame(100, false, 1), 0) == true);
+   QVERIFY(pclQueueP->dropCount() == 3);
+
+   //---------------------------------------------------------------------------------------------------
+   // the same arbitration value as the frame with the lowest priority: the older frame wins
+   //
+   QVERIFY(pclQueueP->enqueue(frame(QCAN_TRANSMIT_QUEUE_SIZE - 2, false, 1), 0) == false);
+   QVERIFY(pclQueueP->dropCount() == 4);
+
+   //---------------------------------------------------------------------------------------------------
+   // check the contents of the queue: 0 .. 100, 100 (tag 1), 101 .. QCAN_TRANSMIT_QUEUE_SIZE - 2
+   //
+   for (ulIdentifierT = 0; ulIdentifierT <= QCAN_TRANSMIT_QUEUE_SIZE - 2; ulIdentifierT++)
+   {
+      pclFrameT = pclQueueP->head(0);
+      QVERIFY(pclFrameT != nullptr);
+      QVERIFY(pclFrameT->identifier() == ulIdentifierT);
+      QVERIFY(pclFrameT->data(0) == 0);
+      pclQueueP->pop();
+
+      if (ulIdentifierT == 100)
+      {
+         pclFrameT = pclQueueP->head(0);
+         QVERIFY(pclFrameT != nullptr);
+         QVERIFY(pclFrameT->identifier() == 100);
+         QVERIFY(pclFrameT->data(0) == 1);
+         pclQueueP->pop();
+      }
+   }
+   QVERIFY(pclQueueP->isEmpty() == true);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanTransmitQueue::checkPurge()                                                                                //
+// only expired frames are removed                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanTransmitQueue::checkPurge()
+{
+   const QCanFrame * pclFrameT;
+   uint32_t          ulIdentifierT;
+   uint32_t          ulLastValueT;
+   uint32_t          ulTimeT;
+
+   pclQueueP->setDeadline(100);
+   QVERIFY(pclQueueP->deadline() == 100);
+
+   //---------------------------------------------------------------------------------------------------
+   // a frame is added each millisecond, the insertion order differs from the priority: the frame
+   // added at time t has the identifier (t * 7) % 300, so t = (identifier * 43) % 300
+   //
+   for (ulTimeT = 0; ulTimeT < 300; ulTimeT++)
+   {
+      QVERIFY(pclQueueP->enqueue(frame((ulTimeT * 7) % 300, false), ulTimeT) == true);
+   }
+
+   //---------------------------------------------------------------------------------------------------
+   // a frame expires if it stays longer than the deadline
+   //
+   QVERIFY(pclQueueP->purge(299) == 199);
+   QVERIFY(pclQueueP->purge(299) == 0);
+   QVERIFY(pclQueueP->purge(300) == 1);
+   QVERIFY(pclQueueP->count() == 100);
+   QVERIFY(pclQueueP->dropCount() == 200);
+
+   //---------------------------------------------------------------------------------------------------
+   // the remaining frames have not expired and keep the priority order
+   //
+   ulLastValueT = 0;
+   for (ulTimeT = 0; ulTimeT < 100; ulTimeT++)
+   {
+      pclFrameT = pclQueueP->head(300);
+      QVERIFY(pclFrameT != nullptr);
+      QVERIFY(((pclFrameT->identifier() * 43) % 300) >= 200);
+      QVERIFY(QCanTransmitQueue::arbitrationValue(*pclFrameT) >= ulLastValueT);
+      ulLastValueT = QCanTransmitQueue::arbitrationValue(*pclFrameT);
+      pclQueueP->pop();
+   }
+   QVERIFY(pclQueueP->isEmpty() == true);
+
+   //---------------------------------------------------------------------------------------------------
+   // head() discards expired frames on top of the queue
+   //
+   QVERIFY(pclQueueP->enqueue(frame(5, false), 1000) == true);
+   QVERIFY(pclQueueP->enqueue(frame(1, false), 1050) == true);
+   pclFrameT = pclQueueP->head(1120);
+   QVERIFY(pclFrameT != nullptr);
+   QVERIFY(pclFrameT->identifier() == 1);
+   pclQueueP->pop();
+   QVERIFY(pclQueueP->head(1120) == nullptr);
+   QVERIFY(pclQueueP->dropCount() == 201);
+
+   //---------------------------------------------------------------------------------------------------
+   // a full queue removes expired frames before a frame is evicted
+   //
+   pclQueueP->clear();
+   pclQueueP->resetDropCount();
+   for (ulIdentifierT = 0; ulIdentifierT < QCAN_TRANSMIT_QUEUE_SIZE; ulIdentifierT++)
+   {
+      QVERIFY(pclQueueP->enqueue(frame(ulIdentifierT, false), (ulIdentifierT < 10) ? 0 : 1000) == true);
+   }
+   QVERIFY(pclQueueP->enqueue(frame(0x7FF, false), 1050) == true);
+   QVERIFY(pclQueueP->count() == QCAN_TRANSMIT_QUEUE_SIZE - 9);
+   QVERIFY(pclQueueP->dropCount() == 10);
+
+   //---------------------------------------------------------------------------------------------------
+   // a deadline of 0 disables the purge
+   //
+   pclQueueP->setDeadline(0);
+   QVERIFY(pclQueueP->purge(1000000) == 0);
+   QVERIFY(pclQueueP->count() == QCAN_TRANSMIT_QUEUE_SIZE - 9);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanTransmitQueue::checkOrigin()                                                                               //
+// the origin is returned together with the frame                                                                     //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanTransmitQueue::checkOrigin()
+{
+   QCanTransmitQueue::Origin_ts  tsOriginT;
+
+   tsOriginT.pclSocket     = this;
+   tsOriginT.uqIngressTime = 123456789;
+   tsOriginT.slSource      = 3;
+   QVERIFY(pclQueueP->enqueue(frame(0x200, false), 0, tsOriginT) == true);
+
+   tsOriginT.pclSocket     = nullptr;
+   tsOriginT.uqIngressTime = 42;
+   tsOriginT.slSource      = 1;
+   QVERIFY(pclQueueP->enqueue(frame(0x100, false), 0, tsOriginT) == true);
+
+   tsOriginT.slSource      = 0;
+   QVERIFY(pclQueueP->head(0, &tsOriginT) != nullptr);
+   QVERIFY(tsOriginT.pclSocket == nullptr);
+   QVERIFY(tsOriginT.uqIngressTime == 42);
+   QVERIFY(tsOriginT.slSource == 1);
+   pclQueueP->pop();
+
+   QVERIFY(pclQueueP->head(0, &tsOriginT) != nullptr);
+   QVERIFY(tsOriginT.pclSocket == this);
+   QVERIFY(tsOriginT.uqIngressTime == 123456789);
+   QVERIFY(tsOriginT.slSource == 3);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanTransmitQueue::checkRemoveOrigin()                                                                         //
+// the source socket of queued frames is cleared, the frames remain in the queue                                      //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanTransmitQueue::checkRemoveOrigin()
+{
+   QCanTransmitQueue::Origin_ts  tsOriginT;
+   QObject                       clOtherT;
+
+   tsOriginT.uqIngressTime = 0;
+   tsOriginT.slSource      = 3;
+
+   tsOriginT.pclSocket     = this;
+   QVERIFY(pclQueueP->enqueue(frame(0x100, false), 0, tsOriginT) == true);
+   tsOriginT.pclSocket     = &clOtherT;
+   QVERIFY(pclQueueP->enqueue(frame(0x200, false), 0, tsOriginT) == true);
+   tsOriginT.pclSocket     = this;
+   QVERIFY(pclQueueP->enqueue(frame(0x300, false), 0, tsOriginT) == true);
+
+   QVERIFY(pclQueueP->removeOrigin(nullptr) == 0);
+   QVERIFY(pclQueueP->removeOrigin(this) == 2);
+   QVERIFY(pclQueueP->removeOrigin(this) == 0);
+   QVERIFY(pclQueueP->count() == 3);
+
+   QVERIFY(pclQueueP->head(0, &tsOriginT) != nullptr);
+   QVERIFY(tsOriginT.pclSocket == nullptr);
+   QVERIFY(tsOriginT.slSource == 3);
+   pclQueueP->pop();
+
+   QVERIFY(pclQueueP->head(0, &tsOriginT) != nullptr);
+   QVERIFY(tsOriginT.pclSocket == &clOtherT);
+   pclQueueP->pop();
+
+   QVERIFY(pclQueueP->head(0, &tsOriginT) != nullptr);
+   QVERIFY(tsOriginT.pclSocket == nullptr);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------------//
+// TestQCanTransmitQueue::cleanup()                                                                                   //
+//                                                                                                                    //
+//--------------------------------------------------------------------------------------------------------------------//
+void TestQCanTransmitQueue::cleanup()
+{
+   delete pclQueueP;
+   pclQueueP = nullptr;
+}